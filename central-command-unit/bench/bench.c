@@ -0,0 +1,147 @@
+/**
+ * @file bench.c
+ * @brief Utilitaires communs aux benchmarks (chronométrage, allocations, statistiques).
+ * @date 2026-10-19
+ */
+#include "bench/bench.h"
+
+static uint64_t g_allocCount = 0;
+static uint64_t g_allocBytes = 0;
+
+// Fonctions réelles fournies par l'éditeur de liens (--wrap)
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t nmemb, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size);
+void *__wrap_calloc(size_t nmemb, size_t size);
+void *__wrap_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size) {
+	__atomic_fetch_add(&g_allocCount, 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&g_allocBytes, size, __ATOMIC_RELAXED);
+	return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t nmemb, size_t size) {
+	__atomic_fetch_add(&g_allocCount, 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&g_allocBytes, nmemb * size, __ATOMIC_RELAXED);
+	return __real_calloc(nmemb, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+	__atomic_fetch_add(&g_allocCount, 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&g_allocBytes, size, __ATOMIC_RELAXED);
+	return __real_realloc(ptr, size);
+}
+
+/**
+ * @brief Retourne un instantané des compteurs d'allocations.
+ */
+bench_alloc_stats_t bench_alloc_snapshot(void) {
+	return (bench_alloc_stats_t) {
+		.count = __atomic_load_n(&g_allocCount, __ATOMIC_RELAXED),
+		.bytes = __atomic_load_n(&g_allocBytes, __ATOMIC_RELAXED)
+	};
+}
+
+/**
+ * @brief Initialise le générateur avec une graine (0 est remplacée par une constante).
+ */
+void bench_rng_seed(bench_rng_t *rng, uint64_t seed) {
+	rng->state = seed ? seed : 0x9E3779B97F4A7C15ULL;
+}
+
+/**
+ * @brief Tire un entier pseudo-aléatoire sur 64 bits.
+ */
+uint64_t bench_rng_next(bench_rng_t *rng) {
+	uint64_t x = rng->state;
+	x ^= x >> 12;
+	x ^= x << 25;
+	x ^= x >> 27;
+	rng->state = x;
+	return x * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+ * @brief Tire un entier dans [0, bound).
+ */
+int bench_rng_int(bench_rng_t *rng, int bound) {
+	if (bound <= 0) return 0;
+	return (int) (bench_rng_next(rng) % (uint64_t) bound);
+}
+
+/**
+ * @brief Tire un réel dans [0, 1).
+ */
+double bench_rng_double(bench_rng_t *rng) {
+	return (double) (bench_rng_next(rng) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * @brief Retourne l'horloge monotone en nanosecondes.
+ */
+uint64_t bench_now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+static int compare_doubles(const void *a, const void *b) {
+	double da = *(const double *) a;
+	double db = *(const double *) b;
+	return (da > db) - (da < db);
+}
+
+/**
+ * @brief Calcule un percentile sur un tableau de mesures.
+ * @param values Les mesures (triées en place)
+ * @param count Nombre de mesures
+ * @param percentile Percentile voulu, dans [0, 100]
+ * @return La valeur du percentile, 0 si le tableau est vide
+ */
+double bench_percentile(double *values, int count, double percentile) {
+	if (values == NULL || count <= 0) return 0.0;
+
+	qsort(values, count, sizeof(double), compare_doubles);
+
+	// Méthode du rang le plus proche
+	int rank = (int) ceil(percentile / 100.0 * count) - 1;
+	if (rank < 0) rank = 0;
+	if (rank >= count) rank = count - 1;
+	return values[rank];
+}
+
+/**
+ * @brief Ajoute une mesure à une série.
+ * @return 0 en cas de succès, -1 si l'allocation échoue (la mesure est perdue)
+ */
+int bench_samples_add(bench_samples_t *samples, double value) {
+	if (samples->count == samples->capacity) {
+		int capacity = samples->capacity > 0 ? samples->capacity * 2 : 1024;
+		double *values = realloc(samples->values, (size_t) capacity * sizeof(double));
+		if (!values) return -1;
+		samples->values = values;
+		samples->capacity = capacity;
+	}
+	samples->values[samples->count++] = value;
+	return 0;
+}
+
+/**
+ * @brief Vide une série en conservant sa mémoire.
+ */
+void bench_samples_clear(bench_samples_t *samples) {
+	samples->count = 0;
+}
+
+/**
+ * @brief Libère la mémoire d'une série.
+ */
+void bench_samples_free(bench_samples_t *samples) {
+	free(samples->values);
+	samples->values = NULL;
+	samples->count = 0;
+	samples->capacity = 0;
+}
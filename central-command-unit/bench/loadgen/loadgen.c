@@ -0,0 +1,440 @@
+/**
+ * @file loadgen.c
+ * @brief Générateur de charge multi-véhicules et mesure des latences de bout en bout.
+ * @details
+ * Fait monter en charge une flotte de véhicules simulés (voir sim_fleet.h) par paliers et, pour
+ * chaque palier, mesure :
+ * - route planner : délai entre PLAN_ROUTE_REQUEST et la réception de SET_WAYPOINTS_REQUEST ;
+ * - heartbeat : délai entre la perte de connexion d'un véhicule (LWT) et le
+ *   CANCEL_VEHICLE_ROUTE_REQUEST envoyé au route planner ;
+ * - conflict manager : latence des verrouillages / déverrouillages de voies. Le conflict manager
+ *   n'expose pas encore ses verrous en MQTT : les véhicules du palier parcourent un anneau de voies
+ *   directement sur sa table de verrous (conflict.h), dans le processus.
+ * Chaque service est saturé au premier palier où moins de 95 % des demandes aboutissent ou dont le
+ * p99 dépasse son objectif (-S, -C, -U). Le rapport est écrit en JSON.
+ * Les services (route planner avec sa carte, heartbeat) doivent tourner sur le broker visé ;
+ * -L démarre un broker embarqué (loopback_broker.h) sur lequel les lancer.
+ *
+ * Usage : ccu_loadgen [-b host:port | -L port] [-v 10,50,100] [-d seconds] [-r state_hz] [-p plans_per_min]
+ *                     [-f offline_per_min] [-D offline_ms] [-t timeout_ms] [-n max_node_id] [-k stops]
+ *                     [-l lane_steps] [-S plan_slo_ms] [-C cancel_slo_ms] [-U lane_slo_us] [-i first_id]
+ *                     [-s seed] [-o output.json]
+ * @date 2026-10-19
+ */
+#include "bench/bench.h"
+#include "bench/sim_fleet.h"
+#include "conflict-manager/conflict.h"
+#include "tests/loopback_broker.h"
+
+#include <getopt.h>
+#include <signal.h>
+#include <sys/resource.h>
+
+#define LOADGEN_DEFAULT_HOST "localhost"
+#define LOADGEN_DEFAULT_PORT 1883
+#define LOADGEN_DEFAULT_STAGES "10,50,100,200,500"
+#define LOADGEN_MAX_STAGES 32
+#define LOADGEN_DEFAULT_STAGE_SECONDS 30
+#define LOADGEN_DEFAULT_SEED 42
+#define LOADGEN_DEFAULT_LANE_STEPS 1000
+#define LOADGEN_MIN_COMPLETION 0.95 //!< Part minimale des demandes abouties avant saturation
+#define LOADGEN_LANE_DECAY_MS 3600000 //!< Les verrous n'expirent pas pendant la mesure
+
+#ifndef BENCH_REVISION
+#define BENCH_REVISION "unknown"
+#endif
+
+/**
+ * @brief Résumé d'une série de latences.
+ */
+typedef struct {
+	int count;
+	double p50, p99, p999, max;
+} latency_summary_t;
+
+/**
+ * @brief Mesures du parcours des voies par le conflict manager.
+ */
+typedef struct {
+	long ops; //!< Verrouillages et déverrouillages
+	long granted;
+	long waiting;
+	long errors;
+	double opsPerSec;
+	latency_summary_t latencyUs;
+} lane_result_t;
+
+/**
+ * @brief Véhicule du parcours des voies : il possède la voie (position, position + 1).
+ */
+typedef struct {
+	int position;
+	bool waiting; //!< En file d'attente de la voie suivante
+} lane_vehicle_t;
+
+static void summarize(bench_samples_t *samples, latency_summary_t *summary) {
+	summary->count = samples->count;
+	summary->p50 = bench_percentile(samples->values, samples->count, 50.0);
+	summary->p99 = bench_percentile(samples->values, samples->count, 99.0);
+	summary->p999 = bench_percentile(samples->values, samples->count, 99.9);
+	summary->max = samples->count > 0 ? samples->values[samples->count - 1] : 0.0; // Trié par bench_percentile()
+}
+
+/**
+ * @brief Indique si un service est saturé.
+ * @param handled Demandes abouties (ou refusées par le service)
+ * @param lost Demandes restées sans réponse
+ * @param p99 Latence p99 mesurée
+ * @param slo Objectif de latence p99
+ */
+static bool is_saturated(uint64_t handled, uint64_t lost, double p99, double slo) {
+	if (handled + lost == 0) return false;
+	return (double) handled / (double) (handled + lost) < LOADGEN_MIN_COMPLETION || p99 > slo;
+}
+
+/**
+ * @brief Chronomètre un appel au conflict manager.
+ */
+static conflict_lock_status_t timed_lane_call(bool lock, int origin, int target, int vehicleId, int *promotedId, bench_samples_t *latencyUs) {
+	int ignored;
+	if (!promotedId) promotedId = &ignored;
+	uint64_t begin = bench_now_ns();
+	conflict_lock_status_t status = lock
+		? conflict_lock_lane(origin, target, LANE_RULE_ONE_WAY, CONFLICT_PRIORITY_LOW, vehicleId, promotedId)
+		: conflict_unlock_lane(origin, target, LANE_RULE_ONE_WAY, vehicleId, promotedId);
+	bench_samples_add(latencyUs, (bench_now_ns() - begin) / 1e3);
+	return status;
+}
+
+/**
+ * @brief Libère la voie précédente d'un véhicule qui vient d'avancer, puis fait avancer en cascade
+ * les véhicules promus sur les voies libérées.
+ */
+static void release_previous_lane(lane_vehicle_t *vehicles, int vehicleIndex, int previous, int ringSize, int firstId, bench_samples_t *latencyUs, lane_result_t *result) {
+	while (vehicleIndex >= 0) {
+		int promotedId = -1;
+		timed_lane_call(false, previous, (previous + 1) % ringSize, firstId + vehicleIndex, &promotedId, latencyUs);
+		result->ops++;
+
+		vehicleIndex = promotedId >= 0 ? promotedId - firstId : -1;
+		if (vehicleIndex >= 0) {
+			// Le véhicule promu attendait la voie libérée : il avance et libère la sienne
+			lane_vehicle_t *promoted = &vehicles[vehicleIndex];
+			promoted->waiting = false;
+			previous = promoted->position;
+			promoted->position = (promoted->position + 1) % ringSize;
+			result->granted++;
+		}
+	}
+}
+
+/**
+ * @brief Fait parcourir un anneau de voies à des véhicules, sur la table de verrous du conflict manager.
+ * @details L'anneau compte deux voies par véhicule : les véhicules se rattrapent et attendent en
+ * file la voie occupée devant eux, sans interblocage possible (la moitié des voies est libre).
+ * @param vehicleCount Nombre de véhicules
+ * @param steps Tentatives d'avancer par véhicule
+ * @param firstId Identifiant du premier véhicule
+ * @param seed Graine du tirage des véhicules
+ * @param result Mesures à remplir
+ * @return 0 en cas de succès, -1 en cas d'erreur d'allocation
+ */
+static int run_lanes(int vehicleCount, int steps, int firstId, uint64_t seed, lane_result_t *result) {
+	memset(result, 0, sizeof(*result));
+	int ringSize = vehicleCount * 2 < 3 ? 3 : vehicleCount * 2;
+	lane_vehicle_t *vehicles = calloc((size_t) vehicleCount, sizeof(lane_vehicle_t));
+	if (!vehicles) return -1;
+	bench_samples_t latencyUs = {0};
+	bench_rng_t rng;
+	bench_rng_seed(&rng, seed);
+
+	conflict_init(LOADGEN_LANE_DECAY_MS);
+	uint64_t begin = bench_now_ns();
+	for (int i = 0; i < vehicleCount; i++) {
+		vehicles[i].position = (i * 2) % ringSize;
+		timed_lane_call(true, vehicles[i].position, (vehicles[i].position + 1) % ringSize, firstId + i, NULL, &latencyUs);
+		result->ops++;
+		result->granted++;
+	}
+
+	for (long attempt = 0; attempt < (long) vehicleCount * steps; attempt++) {
+		int index = bench_rng_int(&rng, vehicleCount);
+		lane_vehicle_t *vehicle = &vehicles[index];
+		if (vehicle->waiting) continue;
+
+		int next = (vehicle->position + 1) % ringSize;
+		conflict_lock_status_t status = timed_lane_call(true, next, (next + 1) % ringSize, firstId + index, NULL, &latencyUs);
+		result->ops++;
+		if (status == CONFLICT_GRANTED) {
+			result->granted++;
+			int previous = vehicle->position;
+			vehicle->position = next;
+			release_previous_lane(vehicles, index, previous, ringSize, firstId, &latencyUs, result);
+		} else if (status == CONFLICT_WAITING) {
+			vehicle->waiting = true;
+			result->waiting++;
+		} else {
+			result->errors++;
+		}
+	}
+
+	// Libération de toutes les voies (les véhicules en attente sont promus puis libérés à leur tour)
+	bool holding = true;
+	while (holding) {
+		holding = false;
+		for (int i = 0; i < vehicleCount; i++) {
+			if (vehicles[i].waiting || vehicles[i].position < 0) continue;
+			int position = vehicles[i].position;
+			vehicles[i].position = -1;
+			release_previous_lane(vehicles, i, position, ringSize, firstId, &latencyUs, result);
+			holding = true;
+		}
+	}
+	double seconds = (bench_now_ns() - begin) / 1e9;
+	result->opsPerSec = seconds > 0 ? result->ops / seconds : 0.0;
+	summarize(&latencyUs, &result->latencyUs);
+
+	bench_samples_free(&latencyUs);
+	free(vehicles);
+	return 0;
+}
+
+static int parse_stages(const char *text, int *stages) {
+	int count = 0;
+	const char *cursor = text;
+	while (*cursor && count < LOADGEN_MAX_STAGES) {
+		char *end;
+		long value = strtol(cursor, &end, 10);
+		if (end == cursor || value < 1 || value > 100000) return -1;
+		if (count > 0 && value <= stages[count - 1]) return -1;
+		stages[count++] = (int) value;
+		cursor = *end == ',' ? end + 1 : end;
+		if (*end != ',' && *end != '\0') return -1;
+	}
+	return count;
+}
+
+static int parse_broker(char *text, const char **host, int *port) {
+	char *colon = strrchr(text, ':');
+	if (colon) {
+		*colon = '\0';
+		*port = atoi(colon + 1);
+		if (*port <= 0 || *port > 65535) return -1;
+	}
+	*host = text;
+	return 0;
+}
+
+/**
+ * @brief Relève la limite de descripteurs : chaque véhicule occupe une socket.
+ */
+static void raise_fd_limit(void) {
+	struct rlimit limit;
+	if (getrlimit(RLIMIT_NOFILE, &limit) != 0 || limit.rlim_cur == limit.rlim_max) return;
+	limit.rlim_cur = limit.rlim_max;
+	setrlimit(RLIMIT_NOFILE, &limit);
+}
+
+static void print_json_latency(FILE *json, const char *unit, const latency_summary_t *summary) {
+	fprintf(json, "\"p50%s\": %.3f, \"p99%s\": %.3f, \"p999%s\": %.3f, \"max%s\": %.3f",
+		unit, summary->p50, unit, summary->p99, unit, summary->p999, unit, summary->max);
+}
+
+static void print_json_saturation(FILE *json, const char *service, int vehicles, bool last) {
+	if (vehicles > 0) fprintf(json, "\"%s\": %d%s", service, vehicles, last ? "" : ", ");
+	else fprintf(json, "\"%s\": null%s", service, last ? "" : ", ");
+}
+
+static void print_usage(const char *program) {
+	fprintf(stderr, "Usage: %s [-b host:port | -L port] [-v 10,50,100] [-d seconds] [-r state_hz] [-p plans_per_min]\n"
+		"          [-f offline_per_min] [-D offline_ms] [-t timeout_ms] [-n max_node_id] [-k stops] [-l lane_steps]\n"
+		"          [-S plan_slo_ms] [-C cancel_slo_ms] [-U lane_slo_us] [-i first_id] [-s seed] [-o output.json]\n", program);
+}
+
+int main(int argc, char *argv[]) {
+	sim_fleet_config_t config = {
+		.host = LOADGEN_DEFAULT_HOST,
+		.port = LOADGEN_DEFAULT_PORT,
+		.firstVehicleId = 1000,
+		.stateHz = 10.0,
+		.plansPerMin = 6.0,
+		.offlinePerMin = 0.5,
+		.offlineMs = 3000,
+		.timeoutMs = 5000,
+		.maxNodeId = 10,
+		.stopsPerPlan = 2,
+		.seed = LOADGEN_DEFAULT_SEED
+	};
+	const char *stagesText = LOADGEN_DEFAULT_STAGES;
+	int stageSeconds = LOADGEN_DEFAULT_STAGE_SECONDS;
+	int laneSteps = LOADGEN_DEFAULT_LANE_STEPS;
+	double planSloMs = 500.0, cancelSloMs = 1000.0, laneSloUs = 1000.0;
+	int embeddedPort = -1;
+	const char *outputPath = NULL;
+
+	int opt;
+	while ((opt = getopt(argc, argv, "b:L:v:d:r:p:f:D:t:n:k:l:S:C:U:i:s:o:h")) != -1) {
+		switch (opt) {
+			case 'b':
+				if (parse_broker(optarg, &config.host, &config.port) != 0) {
+					print_usage(argv[0]);
+					return 1;
+				}
+				break;
+			case 'L': embeddedPort = atoi(optarg); break;
+			case 'v': stagesText = optarg; break;
+			case 'd': stageSeconds = atoi(optarg); break;
+			case 'r': config.stateHz = atof(optarg); break;
+			case 'p': config.plansPerMin = atof(optarg); break;
+			case 'f': config.offlinePerMin = atof(optarg); break;
+			case 'D': config.offlineMs = atoi(optarg); break;
+			case 't': config.timeoutMs = atoi(optarg); break;
+			case 'n': config.maxNodeId = atoi(optarg); break;
+			case 'k': config.stopsPerPlan = atoi(optarg); break;
+			case 'l': laneSteps = atoi(optarg); break;
+			case 'S': planSloMs = atof(optarg); break;
+			case 'C': cancelSloMs = atof(optarg); break;
+			case 'U': laneSloUs = atof(optarg); break;
+			case 'i': config.firstVehicleId = atoi(optarg); break;
+			case 's': config.seed = strtoull(optarg, NULL, 10); break;
+			case 'o': outputPath = optarg; break;
+			default:
+				print_usage(argv[0]);
+				return opt == 'h' ? 0 : 1;
+		}
+	}
+	int stages[LOADGEN_MAX_STAGES];
+	int stageCount = parse_stages(stagesText, stages);
+	if (stageCount <= 0 || stageSeconds < 1 || config.offlineMs < 0 || config.timeoutMs < 1 || laneSteps < 0 || embeddedPort > 65535) {
+		print_usage(argv[0]);
+		return 1;
+	}
+
+	// Une socket coupée pendant un envoi ne doit pas arrêter le générateur
+	signal(SIGPIPE, SIG_IGN);
+	raise_fd_limit();
+
+	loopback_broker_t *broker = NULL;
+	if (embeddedPort >= 0) {
+		broker = loopback_broker_start((uint16_t) embeddedPort);
+		if (!broker) {
+			fprintf(stderr, "Unable to start the embedded broker on port %d\n", embeddedPort);
+			return 1;
+		}
+		config.host = LOOPBACK_BROKER_HOST;
+		config.port = loopback_broker_port(broker);
+		fprintf(stderr, "Embedded broker listening on %s:%d\n", config.host, config.port);
+	}
+
+	sim_fleet_t *fleet = sim_fleet_create(&config);
+	if (!fleet) {
+		loopback_broker_stop(broker);
+		return 1;
+	}
+
+	FILE *json = stdout;
+	if (outputPath) {
+		json = fopen(outputPath, "w");
+		if (!json) {
+			perror("fopen");
+			sim_fleet_destroy(fleet);
+			loopback_broker_stop(broker);
+			return 1;
+		}
+	}
+
+	fprintf(json, "{\n  \"benchmark\": \"loadgen\",\n  \"revision\": \"%s\",\n  \"seed\": %llu,\n", BENCH_REVISION, (unsigned long long) config.seed);
+	fprintf(json, "  \"config\": {\"stageSeconds\": %d, \"stateHz\": %.2f, \"plansPerMin\": %.2f, \"offlinePerMin\": %.2f, "
+		"\"offlineMs\": %d, \"timeoutMs\": %d, \"planSloMs\": %.1f, \"cancelSloMs\": %.1f, \"laneSloUs\": %.1f},\n  \"stages\": [",
+		stageSeconds, config.stateHz, config.plansPerMin, config.offlinePerMin, config.offlineMs, config.timeoutMs, planSloMs, cancelSloMs, laneSloUs);
+	fprintf(stderr, "%8s %9s | %7s %7s %6s %9s %9s %9s | %6s %6s %9s %9s | %9s %9s %9s\n",
+		"vehicles", "states/s", "plans", "done", "lost", "p50(ms)", "p99(ms)", "p999(ms)",
+		"drops", "cancel", "p50(ms)", "p99(ms)", "lanes/s", "p99(us)", "p999(us)");
+
+	int plannerSaturation = 0, heartbeatSaturation = 0, conflictSaturation = 0;
+	loopback_broker_stats_t brokerBefore = {0};
+	for (int stage = 0; stage < stageCount; stage++) {
+		int vehicles = sim_fleet_grow(fleet, stages[stage]);
+		if (vehicles < stages[stage]) {
+			fprintf(stderr, "Only %d of %d vehicles connected, stopping the ramp\n", vehicles, stages[stage]);
+			if (vehicles == 0 || (stage > 0 && vehicles <= stages[stage - 1])) break;
+		}
+
+		// Les mesures de la montée en charge (connexions) ne sont pas attribuées au palier
+		sim_fleet_metrics_t metrics;
+		sim_fleet_take_metrics(fleet, &metrics);
+		sim_fleet_metrics_free(&metrics);
+		if (broker) loopback_broker_get_stats(broker, &brokerBefore);
+
+		if (sim_fleet_run(fleet, stageSeconds * 1000) != 0) {
+			fprintf(stderr, "Event loop failure during stage %d\n", stage);
+			break;
+		}
+		sim_fleet_take_metrics(fleet, &metrics);
+
+		latency_summary_t planLatency, cancelLatency;
+		summarize(&metrics.planLatencyMs, &planLatency);
+		summarize(&metrics.cancelLatencyMs, &cancelLatency);
+		bool plannerSaturated = is_saturated(metrics.plansCompleted + metrics.plansFailed, metrics.plansTimedOut, planLatency.p99, planSloMs);
+		bool heartbeatSaturated = is_saturated(metrics.cancelsObserved, metrics.cancelsTimedOut, cancelLatency.p99, cancelSloMs);
+		if (plannerSaturated && plannerSaturation == 0) plannerSaturation = vehicles;
+		if (heartbeatSaturated && heartbeatSaturation == 0) heartbeatSaturation = vehicles;
+
+		lane_result_t lanes = {0};
+		bool conflictSaturated = false;
+		if (laneSteps > 0 && run_lanes(vehicles, laneSteps, config.firstVehicleId, config.seed + (uint64_t) stage, &lanes) == 0) {
+			conflictSaturated = is_saturated((uint64_t) (lanes.ops - lanes.errors), (uint64_t) lanes.errors, lanes.latencyUs.p99, laneSloUs);
+			if (conflictSaturated && conflictSaturation == 0) conflictSaturation = vehicles;
+		}
+
+		double statesPerSec = metrics.statesPublished / (double) stageSeconds;
+		fprintf(stderr, "%8d %9.0f | %7llu %7llu %6llu %9.1f %9.1f %9.1f | %6llu %6llu %9.1f %9.1f | %9.0f %9.1f %9.1f%s\n",
+			vehicles, statesPerSec, (unsigned long long) metrics.plansSent, (unsigned long long) metrics.plansCompleted,
+			(unsigned long long) metrics.plansTimedOut, planLatency.p50, planLatency.p99, planLatency.p999,
+			(unsigned long long) metrics.offlineEvents, (unsigned long long) metrics.cancelsObserved, cancelLatency.p50, cancelLatency.p99,
+			lanes.opsPerSec, lanes.latencyUs.p99, lanes.latencyUs.p999,
+			plannerSaturated || heartbeatSaturated || conflictSaturated ? "  (saturated)" : "");
+
+		fprintf(json, "%s\n    {\"vehicles\": %d, \"seconds\": %d, \"connectionLosses\": %llu,\n", stage == 0 ? "" : ",",
+			vehicles, stageSeconds, (unsigned long long) metrics.connectionLosses);
+		fprintf(json, "     \"state\": {\"published\": %llu, \"perSec\": %.1f},\n", (unsigned long long) metrics.statesPublished, statesPerSec);
+		if (broker) {
+			loopback_broker_stats_t brokerAfter;
+			loopback_broker_get_stats(broker, &brokerAfter);
+			fprintf(json, "     \"broker\": {\"receivedPerSec\": %.1f, \"deliveredPerSec\": %.1f, \"wills\": %llu, \"clients\": %u},\n",
+				(brokerAfter.received - brokerBefore.received) / (double) stageSeconds,
+				(brokerAfter.delivered - brokerBefore.delivered) / (double) stageSeconds,
+				(unsigned long long) (brokerAfter.wills - brokerBefore.wills), brokerAfter.clients);
+		}
+		fprintf(json, "     \"routePlanner\": {\"sent\": %llu, \"completed\": %llu, \"failed\": %llu, \"timedOut\": %llu, \"skipped\": %llu, "
+			"\"offeredPerSec\": %.2f, \"completedPerSec\": %.2f, ",
+			(unsigned long long) metrics.plansSent, (unsigned long long) metrics.plansCompleted, (unsigned long long) metrics.plansFailed,
+			(unsigned long long) metrics.plansTimedOut, (unsigned long long) metrics.plansSkipped,
+			metrics.plansSent / (double) stageSeconds, metrics.plansCompleted / (double) stageSeconds);
+		print_json_latency(json, "Ms", &planLatency);
+		fprintf(json, ", \"saturated\": %s},\n", plannerSaturated ? "true" : "false");
+		fprintf(json, "     \"heartbeat\": {\"offlineEvents\": %llu, \"cancelsObserved\": %llu, \"timedOut\": %llu, ",
+			(unsigned long long) metrics.offlineEvents, (unsigned long long) metrics.cancelsObserved, (unsigned long long) metrics.cancelsTimedOut);
+		print_json_latency(json, "Ms", &cancelLatency);
+		fprintf(json, ", \"saturated\": %s},\n", heartbeatSaturated ? "true" : "false");
+		fprintf(json, "     \"conflictManager\": {\"ops\": %ld, \"granted\": %ld, \"waiting\": %ld, \"errors\": %ld, \"opsPerSec\": %.1f, ",
+			lanes.ops, lanes.granted, lanes.waiting, lanes.errors, lanes.opsPerSec);
+		print_json_latency(json, "Us", &lanes.latencyUs);
+		fprintf(json, ", \"saturated\": %s}}", conflictSaturated ? "true" : "false");
+
+		sim_fleet_metrics_free(&metrics);
+		if (vehicles < stages[stage]) break;
+	}
+
+	// Premier palier saturé de chaque service (null : aucun palier saturé)
+	fprintf(json, "\n  ],\n  \"saturation\": {");
+	print_json_saturation(json, "routePlanner", plannerSaturation, false);
+	print_json_saturation(json, "heartbeat", heartbeatSaturation, false);
+	print_json_saturation(json, "conflictManager", conflictSaturation, true);
+	fprintf(json, "}\n}\n");
+	if (json != stdout) fclose(json);
+
+	sim_fleet_destroy(fleet);
+	loopback_broker_stop(broker);
+	return 0;
+}
@@ -0,0 +1,544 @@
+/**
+ * @file sim_fleet.c
+ * @brief Flotte de véhicules simulés pour le générateur de charge (bench/loadgen).
+ * @details
+ * Les clients libmosquitto sont servis comme dans le mode boucle d'événements de core/mqtt.c :
+ * mosquitto_loop_read() / mosquitto_loop_write() sur événement de la socket, une fonction de
+ * préparation qui surveille l'écriture quand des données sont en attente, et un timer pour
+ * mosquitto_loop_misc() (keep-alive). Les timers des véhicules sont dans une roue attachée à la boucle.
+ * @date 2026-10-19
+ */
+#include "bench/sim_fleet.h"
+#include "core/event_loop.h"
+#include "core/timer_wheel.h"
+#include "core/action_codes.h"
+#include "core/mqtt_messages/command_header.h"
+#include "core/mqtt_messages/plan_route_request.h"
+#include "core/mqtt_messages/vehicle_state_message.h"
+#include "route-planner/route_planner_message_callback.h"
+
+#include <mosquitto.h>
+#include <sys/socket.h>
+
+#define SIM_FLEET_TOPIC_LENGTH 64
+#define SIM_FLEET_MISC_INTERVAL_MS 1000
+#define SIM_FLEET_MAX_STOPS 16
+
+typedef struct sim_vehicle sim_vehicle_t;
+
+/**
+ * @brief Véhicule simulé (client MQTT et timers de ses activités).
+ */
+struct sim_vehicle {
+	sim_fleet_t *fleet;
+	int id;
+	struct mosquitto *mosq;
+	int fd; //!< Socket surveillée par la boucle (-1 : déconnecté)
+	bool connectedOnce; //!< mosquitto_connect() déjà réussi : les connexions suivantes utilisent mosquitto_reconnect()
+	bool watchWrite; //!< Écriture surveillée sur fd
+	bool online; //!< CONNACK reçu
+	bool goingOffline; //!< Perte de connexion simulée en cours
+	char stateTopic[SIM_FLEET_TOPIC_LENGTH];
+	char statusTopic[SIM_FLEET_TOPIC_LENGTH];
+	char requestTopic[SIM_FLEET_TOPIC_LENGTH];
+	char responseTopic[SIM_FLEET_TOPIC_LENGTH];
+	timer_wheel_timer_t stateTimer;
+	timer_wheel_timer_t planTimer;
+	timer_wheel_timer_t planTimeoutTimer;
+	timer_wheel_timer_t offlineTimer;
+	timer_wheel_timer_t reconnectTimer;
+	timer_wheel_timer_t cancelTimeoutTimer;
+	// Demande de trajet en attente du SET_WAYPOINTS_REQUEST
+	bool planPending;
+	char planCommandId[COMMAND_ID_LENGTH];
+	uint64_t planSentNs;
+	// Perte de connexion en attente du CANCEL_VEHICLE_ROUTE_REQUEST
+	bool cancelPending;
+	uint64_t offlineNs;
+	int16_t x, y;
+};
+
+struct sim_fleet {
+	sim_fleet_config_t config;
+	event_loop_t *loop;
+	timer_wheel_t wheel;
+	bool wheelReady;
+	event_loop_timer_t *miscTimer;
+	event_loop_timer_t *stopTimer;
+	bench_rng_t rng;
+	sim_vehicle_t monitor; //!< Client abonné au topic de requête du route planner
+	sim_vehicle_t **vehicles;
+	int vehicleCount;
+	int vehicleCapacity;
+	sim_fleet_metrics_t metrics;
+};
+
+static int connect_client(sim_vehicle_t *client);
+
+static int period_ms(double perSecond) {
+	if (perSecond <= 0) return 0;
+	int period = (int) (1000.0 / perSecond);
+	return period > 0 ? period : 1;
+}
+
+static sim_vehicle_t *find_vehicle(sim_fleet_t *fleet, int carId) {
+	int index = carId - fleet->config.firstVehicleId;
+	if (index < 0 || index >= fleet->vehicleCount) return NULL;
+	return fleet->vehicles[index];
+}
+
+/**
+ * @brief Retire la socket d'un client de la boucle.
+ */
+static void detach_socket(sim_vehicle_t *client) {
+	if (client->fd < 0) return;
+	event_loop_remove_fd(client->fleet->loop, client->fd);
+	client->fd = -1;
+	client->online = false;
+}
+
+static void on_socket_event(event_loop_t *loop, int fd, uint32_t events, void *context) {
+	UNUSED(loop);
+	sim_vehicle_t *client = (sim_vehicle_t *) context;
+	int rc = MOSQ_ERR_SUCCESS;
+	if (events & (EVENT_LOOP_READ | EVENT_LOOP_ERROR)) rc = mosquitto_loop_read(client->mosq, 1);
+	if (rc == MOSQ_ERR_SUCCESS && (events & EVENT_LOOP_WRITE)) rc = mosquitto_loop_write(client->mosq, 1);
+
+	if (rc != MOSQ_ERR_SUCCESS || mosquitto_socket(client->mosq) != fd) {
+		detach_socket(client);
+		// Perte imprévue : le véhicule se reconnecte comme après une perte simulée
+		if (!client->goingOffline) {
+			client->fleet->metrics.connectionLosses++;
+			timer_wheel_schedule(&client->fleet->wheel, &client->reconnectTimer, SIM_FLEET_RECONNECT_DELAY_MS, 0);
+		}
+	}
+}
+
+static void update_write_interest(sim_vehicle_t *client) {
+	if (client->fd < 0) return;
+	bool wantWrite = mosquitto_want_write(client->mosq);
+	if (wantWrite == client->watchWrite) return;
+	event_loop_modify_fd(client->fleet->loop, client->fd, EVENT_LOOP_READ | (wantWrite ? EVENT_LOOP_WRITE : 0));
+	client->watchWrite = wantWrite;
+}
+
+/**
+ * @brief Surveille l'écriture des sockets qui ont des données en attente (avant chaque attente de la boucle).
+ */
+static void prepare_sockets(event_loop_t *loop, void *context) {
+	UNUSED(loop);
+	sim_fleet_t *fleet = (sim_fleet_t *) context;
+	update_write_interest(&fleet->monitor);
+	for (int i = 0; i < fleet->vehicleCount; i++) {
+		update_write_interest(fleet->vehicles[i]);
+	}
+}
+
+static void on_misc_timer(event_loop_t *loop, event_loop_timer_t *timer, void *context) {
+	UNUSED(loop);
+	UNUSED(timer);
+	sim_fleet_t *fleet = (sim_fleet_t *) context;
+	if (fleet->monitor.fd >= 0) mosquitto_loop_misc(fleet->monitor.mosq);
+	for (int i = 0; i < fleet->vehicleCount; i++) {
+		if (fleet->vehicles[i]->fd >= 0) mosquitto_loop_misc(fleet->vehicles[i]->mosq);
+	}
+}
+
+static void on_stop_timer(event_loop_t *loop, event_loop_timer_t *timer, void *context) {
+	UNUSED(timer);
+	UNUSED(context);
+	event_loop_stop(loop);
+}
+
+static void on_state_timer(timer_wheel_timer_t *timer, void *context) {
+	UNUSED(timer);
+	sim_vehicle_t *vehicle = (sim_vehicle_t *) context;
+	if (!vehicle->online) return;
+
+	// Marche aléatoire : seule la taille et la fréquence des messages comptent
+	vehicle->x += (int16_t) (bench_rng_int(&vehicle->fleet->rng, 21) - 10);
+	vehicle->y += (int16_t) (bench_rng_int(&vehicle->fleet->rng, 21) - 10);
+	vehicle_state_message_t state = {
+		.carId = vehicle->id,
+		.timestamp = timer_wheel_now_ms(),
+		.x = vehicle->x,
+		.y = vehicle->y,
+		.angle = 0.0f,
+		.speed = 100,
+		.isNavigating = vehicle->planPending,
+		.obstacleDetected = false
+	};
+	char *payload = vehicle_state_message_serialize_json(&state);
+	if (!payload) return;
+	if (mosquitto_publish(vehicle->mosq, NULL, vehicle->stateTopic, (int) strlen(payload), payload, 0, false) == MOSQ_ERR_SUCCESS) {
+		vehicle->fleet->metrics.statesPublished++;
+	}
+	free(payload);
+}
+
+static void on_plan_timer(timer_wheel_timer_t *timer, void *context) {
+	UNUSED(timer);
+	sim_vehicle_t *vehicle = (sim_vehicle_t *) context;
+	sim_fleet_t *fleet = vehicle->fleet;
+	if (!vehicle->online) return;
+	if (vehicle->planPending) {
+		fleet->metrics.plansSkipped++;
+		return;
+	}
+
+	int stops[SIM_FLEET_MAX_STOPS];
+	int stopCount = fleet->config.stopsPerPlan;
+	for (int i = 0; i < stopCount; i++) {
+		stops[i] = 1 + bench_rng_int(&fleet->rng, fleet->config.maxNodeId);
+	}
+	plan_route_request_t request = {
+		.header = create_command_header(ACTION_PLAN_ROUTE_REQUEST, vehicle->responseTopic),
+		.carId = vehicle->id,
+		.nodeIds = stops,
+		.nodeCount = stopCount,
+		.optimizeOrder = false,
+		.keepLastStop = false
+	};
+	char *payload = plan_route_request_serialize(&request);
+	if (!payload) return;
+
+	vehicle->planSentNs = bench_now_ns();
+	if (mosquitto_publish(vehicle->mosq, NULL, ROUTE_PLANNER_REQUEST_TOPIC, (int) strlen(payload), payload, 1, false) == MOSQ_ERR_SUCCESS) {
+		memcpy(vehicle->planCommandId, request.header.commandId, sizeof(vehicle->planCommandId));
+		vehicle->planPending = true;
+		fleet->metrics.plansSent++;
+		timer_wheel_schedule(&fleet->wheel, &vehicle->planTimeoutTimer, fleet->config.timeoutMs, 0);
+	}
+	free(payload);
+}
+
+static void on_plan_timeout(timer_wheel_timer_t *timer, void *context) {
+	UNUSED(timer);
+	sim_vehicle_t *vehicle = (sim_vehicle_t *) context;
+	if (!vehicle->planPending) return;
+	vehicle->planPending = false;
+	vehicle->fleet->metrics.plansTimedOut++;
+}
+
+/**
+ * @brief Coupe la socket sans DISCONNECT : le broker publie le LWT du véhicule.
+ */
+static void on_offline_timer(timer_wheel_timer_t *timer, void *context) {
+	UNUSED(timer);
+	sim_vehicle_t *vehicle = (sim_vehicle_t *) context;
+	sim_fleet_t *fleet = vehicle->fleet;
+	if (!vehicle->online || vehicle->cancelPending) return;
+
+	int fd = vehicle->fd;
+	vehicle->goingOffline = true;
+	detach_socket(vehicle);
+	vehicle->offlineNs = bench_now_ns();
+	shutdown(fd, SHUT_RDWR);
+
+	vehicle->cancelPending = true;
+	fleet->metrics.offlineEvents++;
+	timer_wheel_schedule(&fleet->wheel, &vehicle->cancelTimeoutTimer, fleet->config.timeoutMs, 0);
+	timer_wheel_schedule(&fleet->wheel, &vehicle->reconnectTimer, fleet->config.offlineMs, 0);
+}
+
+static void on_reconnect_timer(timer_wheel_timer_t *timer, void *context) {
+	UNUSED(timer);
+	sim_vehicle_t *vehicle = (sim_vehicle_t *) context;
+	vehicle->goingOffline = false;
+	if (connect_client(vehicle) != 0) {
+		timer_wheel_schedule(&vehicle->fleet->wheel, &vehicle->reconnectTimer, SIM_FLEET_RECONNECT_DELAY_MS, 0);
+	}
+}
+
+static void on_cancel_timeout(timer_wheel_timer_t *timer, void *context) {
+	UNUSED(timer);
+	sim_vehicle_t *vehicle = (sim_vehicle_t *) context;
+	if (!vehicle->cancelPending) return;
+	vehicle->cancelPending = false;
+	vehicle->fleet->metrics.cancelsTimedOut++;
+}
+
+static void on_vehicle_connect(struct mosquitto *mosq, void *data, int rc) {
+	sim_vehicle_t *vehicle = (sim_vehicle_t *) data;
+	if (rc != 0) return;
+	vehicle->online = true;
+
+	char status[64];
+	snprintf(status, sizeof(status), "{\"vehicle_id\":%d,\"status\":\"online\"}", vehicle->id);
+	mosquitto_subscribe(mosq, NULL, vehicle->requestTopic, 2);
+	mosquitto_subscribe(mosq, NULL, vehicle->responseTopic, 1);
+	mosquitto_publish(mosq, NULL, vehicle->statusTopic, (int) strlen(status), status, 1, true);
+}
+
+static void on_vehicle_message(struct mosquitto *mosq, void *data, const struct mosquitto_message *message) {
+	UNUSED(mosq);
+	sim_vehicle_t *vehicle = (sim_vehicle_t *) data;
+	sim_fleet_t *fleet = vehicle->fleet;
+	if (!vehicle->planPending || !message->payload) return;
+	size_t length = (size_t) message->payloadlen;
+
+	if (strcmp(message->topic, vehicle->requestTopic) == 0) {
+		// Les waypoints ne sont pas relus : seule l'arrivée de la commande est mesurée
+		if (!memmem(message->payload, length, ACTION_SET_WAYPOINTS_REQUEST, strlen(ACTION_SET_WAYPOINTS_REQUEST))) return;
+		vehicle->planPending = false;
+		timer_wheel_cancel(&fleet->wheel, &vehicle->planTimeoutTimer);
+		fleet->metrics.plansCompleted++;
+		bench_samples_add(&fleet->metrics.planLatencyMs, (bench_now_ns() - vehicle->planSentNs) / 1e6);
+		return;
+	}
+
+	// Réponse du route planner : seul un échec termine la demande (le succès précède ou suit SET_WAYPOINTS)
+	cJSON *root = cJSON_ParseWithLength(message->payload, length);
+	if (!root) return;
+	const cJSON *commandId = cJSON_GetObjectItemCaseSensitive(root, "commandId");
+	const cJSON *success = cJSON_GetObjectItemCaseSensitive(root, "success");
+	if (cJSON_IsString(commandId) && strcmp(commandId->valuestring, vehicle->planCommandId) == 0 && cJSON_IsFalse(success)) {
+		vehicle->planPending = false;
+		timer_wheel_cancel(&fleet->wheel, &vehicle->planTimeoutTimer);
+		fleet->metrics.plansFailed++;
+	}
+	cJSON_Delete(root);
+}
+
+static void on_monitor_connect(struct mosquitto *mosq, void *data, int rc) {
+	sim_vehicle_t *monitor = (sim_vehicle_t *) data;
+	if (rc != 0) return;
+	monitor->online = true;
+	mosquitto_subscribe(mosq, NULL, ROUTE_PLANNER_REQUEST_TOPIC, 0);
+}
+
+/**
+ * @brief Relève les CANCEL_VEHICLE_ROUTE_REQUEST envoyés par le heartbeat au route planner.
+ */
+static void on_monitor_message(struct mosquitto *mosq, void *data, const struct mosquitto_message *message) {
+	UNUSED(mosq);
+	sim_fleet_t *fleet = ((sim_vehicle_t *) data)->fleet;
+	if (!message->payload) return;
+	size_t length = (size_t) message->payloadlen;
+	// Le topic transporte aussi les demandes de trajet des véhicules : filtrage avant décodage
+	if (!memmem(message->payload, length, ACTION_CANCEL_VEHICLE_ROUTE, strlen(ACTION_CANCEL_VEHICLE_ROUTE))) return;
+
+	cJSON *root = cJSON_ParseWithLength(message->payload, length);
+	if (!root) return;
+	const cJSON *carId = cJSON_GetObjectItemCaseSensitive(root, "carId");
+	sim_vehicle_t *vehicle = cJSON_IsNumber(carId) ? find_vehicle(fleet, carId->valueint) : NULL;
+	if (vehicle && vehicle->cancelPending) {
+		vehicle->cancelPending = false;
+		timer_wheel_cancel(&fleet->wheel, &vehicle->cancelTimeoutTimer);
+		fleet->metrics.cancelsObserved++;
+		bench_samples_add(&fleet->metrics.cancelLatencyMs, (bench_now_ns() - vehicle->offlineNs) / 1e6);
+	}
+	cJSON_Delete(root);
+}
+
+/**
+ * @brief Connecte (ou reconnecte) un client et attache sa socket à la boucle.
+ * @details La connexion TCP est bloquante ; CONNACK est traité par la boucle.
+ */
+static int connect_client(sim_vehicle_t *client) {
+	sim_fleet_t *fleet = client->fleet;
+	int rc = client->connectedOnce
+		? mosquitto_reconnect(client->mosq)
+		: mosquitto_connect(client->mosq, fleet->config.host, fleet->config.port, SIM_FLEET_KEEPALIVE_SEC);
+	if (rc != MOSQ_ERR_SUCCESS) return -1;
+	client->connectedOnce = true;
+
+	int fd = mosquitto_socket(client->mosq);
+	if (fd < 0 || event_loop_add_fd(fleet->loop, fd, EVENT_LOOP_READ | EVENT_LOOP_WRITE, on_socket_event, client) != 0) return -1;
+	client->fd = fd;
+	client->watchWrite = true;
+	return 0;
+}
+
+static int init_monitor(sim_fleet_t *fleet) {
+	sim_vehicle_t *monitor = &fleet->monitor;
+	monitor->fleet = fleet;
+	monitor->id = -1;
+	monitor->fd = -1;
+
+	char clientId[64];
+	snprintf(clientId, sizeof(clientId), "loadgen-monitor-%d", (int) getpid());
+	monitor->mosq = mosquitto_new(clientId, true, monitor);
+	if (!monitor->mosq) return -1;
+	mosquitto_connect_callback_set(monitor->mosq, on_monitor_connect);
+	mosquitto_message_callback_set(monitor->mosq, on_monitor_message);
+	return connect_client(monitor);
+}
+
+/**
+ * @brief Crée une flotte vide et connecte son client de surveillance.
+ * @param config Paramètres (copiés, host doit rester valide)
+ * @return La flotte, ou NULL en cas d'erreur (broker injoignable, ...)
+ */
+sim_fleet_t *sim_fleet_create(const sim_fleet_config_t *config) {
+	if (!config || !config->host || config->stopsPerPlan < 2 || config->stopsPerPlan > SIM_FLEET_MAX_STOPS || config->maxNodeId < 1) return NULL;
+
+	sim_fleet_t *fleet = calloc(1, sizeof(sim_fleet_t));
+	if (!fleet) return NULL;
+	fleet->config = *config;
+	fleet->monitor.fd = -1;
+	bench_rng_seed(&fleet->rng, config->seed);
+
+	mosquitto_lib_init();
+	fleet->loop = event_loop_create();
+	if (!fleet->loop) goto error;
+	if (timer_wheel_init(&fleet->wheel, 0, NULL) != 0) goto error;
+	fleet->wheelReady = true;
+	if (timer_wheel_attach(&fleet->wheel, fleet->loop) != 0) goto error;
+
+	fleet->miscTimer = event_loop_add_timer(fleet->loop, SIM_FLEET_MISC_INTERVAL_MS, SIM_FLEET_MISC_INTERVAL_MS, on_misc_timer, fleet);
+	fleet->stopTimer = event_loop_add_timer(fleet->loop, 0, 0, on_stop_timer, fleet);
+	if (!fleet->miscTimer || !fleet->stopTimer || event_loop_add_prepare(fleet->loop, prepare_sockets, fleet) != 0) goto error;
+
+	if (init_monitor(fleet) != 0) {
+		fprintf(stderr, "Unable to connect to the broker at %s:%d\n", config->host, config->port);
+		goto error;
+	}
+	return fleet;
+
+error:
+	sim_fleet_destroy(fleet);
+	return NULL;
+}
+
+static sim_vehicle_t *create_vehicle(sim_fleet_t *fleet, int id) {
+	sim_vehicle_t *vehicle = calloc(1, sizeof(sim_vehicle_t));
+	if (!vehicle) return NULL;
+	vehicle->fleet = fleet;
+	vehicle->id = id;
+	vehicle->fd = -1;
+	snprintf(vehicle->stateTopic, sizeof(vehicle->stateTopic), "vehicles/%d/state", id);
+	snprintf(vehicle->statusTopic, sizeof(vehicle->statusTopic), "vehicles/%d/status", id);
+	snprintf(vehicle->requestTopic, sizeof(vehicle->requestTopic), "vehicles/%d/request", id);
+	snprintf(vehicle->responseTopic, sizeof(vehicle->responseTopic), "vehicles/%d/response", id);
+	timer_wheel_timer_init(&vehicle->stateTimer, on_state_timer, vehicle);
+	timer_wheel_timer_init(&vehicle->planTimer, on_plan_timer, vehicle);
+	timer_wheel_timer_init(&vehicle->planTimeoutTimer, on_plan_timeout, vehicle);
+	timer_wheel_timer_init(&vehicle->offlineTimer, on_offline_timer, vehicle);
+	timer_wheel_timer_init(&vehicle->reconnectTimer, on_reconnect_timer, vehicle);
+	timer_wheel_timer_init(&vehicle->cancelTimeoutTimer, on_cancel_timeout, vehicle);
+
+	char clientId[64];
+	snprintf(clientId, sizeof(clientId), "loadgen-vehicle-%d", id);
+	char offline[64];
+	snprintf(offline, sizeof(offline), "{\"vehicle_id\":%d,\"status\":\"offline\"}", id);
+	vehicle->mosq = mosquitto_new(clientId, true, vehicle);
+	if (!vehicle->mosq || mosquitto_will_set(vehicle->mosq, vehicle->statusTopic, (int) strlen(offline), offline, 2, true) != MOSQ_ERR_SUCCESS) {
+		if (vehicle->mosq) mosquitto_destroy(vehicle->mosq);
+		free(vehicle);
+		return NULL;
+	}
+	mosquitto_connect_callback_set(vehicle->mosq, on_vehicle_connect);
+	mosquitto_message_callback_set(vehicle->mosq, on_vehicle_message);
+	return vehicle;
+}
+
+/**
+ * @brief Programme les activités périodiques d'un véhicule, avec une phase aléatoire.
+ * @details La phase évite que tous les véhicules d'une période publient au même instant.
+ */
+static void start_vehicle(sim_fleet_t *fleet, sim_vehicle_t *vehicle) {
+	int statePeriod = period_ms(fleet->config.stateHz);
+	int planPeriod = period_ms(fleet->config.plansPerMin / 60.0);
+	int offlinePeriod = period_ms(fleet->config.offlinePerMin / 60.0);
+	if (statePeriod > 0) timer_wheel_schedule(&fleet->wheel, &vehicle->stateTimer, 1 + bench_rng_int(&fleet->rng, statePeriod), statePeriod);
+	if (planPeriod > 0) timer_wheel_schedule(&fleet->wheel, &vehicle->planTimer, 1 + bench_rng_int(&fleet->rng, planPeriod), planPeriod);
+	if (offlinePeriod > 0) timer_wheel_schedule(&fleet->wheel, &vehicle->offlineTimer, 1 + bench_rng_int(&fleet->rng, offlinePeriod), offlinePeriod);
+}
+
+/**
+ * @brief Connecte des véhicules jusqu'à atteindre un effectif.
+ * @param fleet La flotte
+ * @param vehicleCount Effectif voulu (les véhicules existants sont conservés)
+ * @return Le nombre de véhicules de la flotte (inférieur à vehicleCount si des connexions échouent)
+ */
+int sim_fleet_grow(sim_fleet_t *fleet, int vehicleCount) {
+	if (!fleet) return 0;
+	if (vehicleCount > fleet->vehicleCapacity) {
+		sim_vehicle_t **vehicles = realloc(fleet->vehicles, (size_t) vehicleCount * sizeof(sim_vehicle_t *));
+		if (!vehicles) return fleet->vehicleCount;
+		fleet->vehicles = vehicles;
+		fleet->vehicleCapacity = vehicleCount;
+	}
+
+	while (fleet->vehicleCount < vehicleCount) {
+		sim_vehicle_t *vehicle = create_vehicle(fleet, fleet->config.firstVehicleId + fleet->vehicleCount);
+		if (!vehicle) break;
+		if (connect_client(vehicle) != 0) {
+			fprintf(stderr, "Vehicle %d: connection failed after %d vehicles\n", vehicle->id, fleet->vehicleCount);
+			mosquitto_destroy(vehicle->mosq);
+			free(vehicle);
+			break;
+		}
+		fleet->vehicles[fleet->vehicleCount++] = vehicle;
+		start_vehicle(fleet, vehicle);
+	}
+	return fleet->vehicleCount;
+}
+
+/**
+ * @brief Fait tourner la flotte pendant une durée.
+ * @param fleet La flotte
+ * @param durationMs Durée en millisecondes
+ * @return 0 en cas de succès, -1 si la boucle d'événements échoue
+ */
+int sim_fleet_run(sim_fleet_t *fleet, int durationMs) {
+	if (!fleet || durationMs <= 0) return -1;
+	if (event_loop_timer_set(fleet->stopTimer, durationMs, 0) != 0) return -1;
+	return event_loop_run(fleet->loop);
+}
+
+/**
+ * @brief Transfère les mesures de la période écoulée et remet les compteurs de la flotte à zéro.
+ * @param fleet La flotte
+ * @param metrics Mesures à remplir (libérées avec sim_fleet_metrics_free())
+ */
+void sim_fleet_take_metrics(sim_fleet_t *fleet, sim_fleet_metrics_t *metrics) {
+	*metrics = fleet->metrics;
+	memset(&fleet->metrics, 0, sizeof(fleet->metrics));
+}
+
+/**
+ * @brief Libère les séries de mesures.
+ */
+void sim_fleet_metrics_free(sim_fleet_metrics_t *metrics) {
+	if (!metrics) return;
+	bench_samples_free(&metrics->planLatencyMs);
+	bench_samples_free(&metrics->cancelLatencyMs);
+}
+
+static void destroy_client(sim_vehicle_t *client) {
+	if (!client->mosq) return;
+	if (client->fd >= 0) {
+		mosquitto_disconnect(client->mosq);
+		mosquitto_loop_write(client->mosq, 1);
+		detach_socket(client);
+	}
+	mosquitto_destroy(client->mosq);
+	client->mosq = NULL;
+}
+
+/**
+ * @brief Déconnecte les véhicules (DISCONNECT : aucun LWT) et libère la flotte.
+ * @param fleet La flotte (NULL accepté)
+ */
+void sim_fleet_destroy(sim_fleet_t *fleet) {
+	if (!fleet) return;
+	// La roue est détruite d'abord : les timers des véhicules n'ont pas à être annulés un par un
+	if (fleet->wheelReady) timer_wheel_destroy(&fleet->wheel);
+	for (int i = 0; i < fleet->vehicleCount; i++) {
+		destroy_client(fleet->vehicles[i]);
+		free(fleet->vehicles[i]);
+	}
+	free(fleet->vehicles);
+	destroy_client(&fleet->monitor);
+	if (fleet->loop) {
+		event_loop_remove_prepare(fleet->loop, prepare_sockets, fleet);
+		event_loop_cancel_timer(fleet->loop, fleet->miscTimer);
+		event_loop_cancel_timer(fleet->loop, fleet->stopTimer);
+		event_loop_destroy(fleet->loop);
+	}
+	sim_fleet_metrics_free(&fleet->metrics);
+	free(fleet);
+	mosquitto_lib_cleanup();
+}
@@ -0,0 +1,217 @@
+/**
+ * @file map_generators.c
+ * @brief Générateurs de cartes synthétiques pour les benchmarks du route-planner.
+ * @date 2026-10-19
+ */
+#include "bench/map_generators.h"
+
+/**
+ * @brief Ajoute un arc dont le poids est la distance euclidienne majorée d'un bruit.
+ * @internal
+ */
+static bool add_noisy_edge(graph_t *graph, int from, int to, bench_rng_t *rng, double maxNoise) {
+	node_t *a = &graph->nodes[from];
+	node_t *b = &graph->nodes[to];
+	double distance = hypot(a->x - b->x, a->y - b->y);
+	double weight = distance * (1.0 + maxNoise * bench_rng_double(rng));
+	return graph_add_edge(graph, from, to, weight, LANE_RULE_DRIVE_RIGHT);
+}
+
+/**
+ * @brief Grille side x side, chaque noeud relié à ses 4 voisins dans les deux sens.
+ * @internal
+ */
+static graph_t *generate_grid(int numNodes, bench_rng_t *rng) {
+	int side = (int) ceil(sqrt((double) numNodes));
+	if (side < 2) side = 2;
+
+	graph_t *graph = graph_create(side * side);
+	if (!graph) return NULL;
+
+	for (int row = 0; row < side; row++) {
+		for (int col = 0; col < side; col++) {
+			graph_init_node(graph, row * side + col, col * BENCH_GRID_SPACING, row * BENCH_GRID_SPACING, NODE_TYPE_INTERSECTION);
+		}
+	}
+
+	for (int row = 0; row < side; row++) {
+		for (int col = 0; col < side; col++) {
+			int id = row * side + col;
+			bool ok = true;
+			if (col + 1 < side) {
+				ok &= add_noisy_edge(graph, id, id + 1, rng, 0.5);
+				ok &= add_noisy_edge(graph, id + 1, id, rng, 0.5);
+			}
+			if (row + 1 < side) {
+				ok &= add_noisy_edge(graph, id, id + side, rng, 0.5);
+				ok &= add_noisy_edge(graph, id + side, id, rng, 0.5);
+			}
+			if (!ok) {
+				graph_destroy(graph);
+				return NULL;
+			}
+		}
+	}
+	return graph;
+}
+
+/**
+ * @brief Anneaux concentriques à sens unique (sens alterné) reliés par des radiales à double sens.
+ * @internal
+ */
+static graph_t *generate_ring_road(int numNodes, bench_rng_t *rng) {
+	int rings = (int) round(sqrt((double) numNodes) / 4.0);
+	if (rings < 2) rings = 2;
+	int perRing = numNodes / rings;
+	if (perRing < 8) perRing = 8;
+	int spokeSpacing = perRing / 16 > 0 ? perRing / 16 : 1;
+
+	graph_t *graph = graph_create(rings * perRing);
+	if (!graph) return NULL;
+
+	for (int r = 0; r < rings; r++) {
+		double radius = 100.0 * (r + 1);
+		for (int k = 0; k < perRing; k++) {
+			double angle = 2.0 * M_PI * k / perRing;
+			node_type_t type = (k % spokeSpacing == 0) ? NODE_TYPE_ROUNDABOUT : NODE_TYPE_WAYPOINT;
+			graph_init_node(graph, r * perRing + k, radius * cos(angle), radius * sin(angle), type);
+		}
+	}
+
+	for (int r = 0; r < rings; r++) {
+		for (int k = 0; k < perRing; k++) {
+			int id = r * perRing + k;
+			int next = r * perRing + (k + 1) % perRing;
+			bool ok = (r % 2 == 0) ? add_noisy_edge(graph, id, next, rng, 0.2) : add_noisy_edge(graph, next, id, rng, 0.2);
+
+			if (r + 1 < rings && k % spokeSpacing == 0) {
+				ok &= add_noisy_edge(graph, id, id + perRing, rng, 0.2);
+				ok &= add_noisy_edge(graph, id + perRing, id, rng, 0.2);
+			}
+			if (!ok) {
+				graph_destroy(graph);
+				return NULL;
+			}
+		}
+	}
+	return graph;
+}
+
+/**
+ * @brief Points uniformes dans un carré, reliés (double sens) lorsqu'ils sont à moins d'un rayon.
+ * @details Les voisins sont recherchés par un découpage en cellules de la taille du rayon,
+ * ce qui garde la génération en O(n) même pour un million de noeuds.
+ * @internal
+ */
+static graph_t *generate_random_geometric(int numNodes, bench_rng_t *rng) {
+	if (numNodes < 2) numNodes = 2;
+
+	// Densité de 1 noeud pour 100 unités² : le rayon donne le degré moyen visé
+	double side = sqrt((double) numNodes) * 10.0;
+	double radius = sqrt(BENCH_GEOMETRIC_AVG_DEGREE * 100.0 / M_PI);
+	int cellsPerSide = (int) ceil(side / radius);
+	int cellCount = cellsPerSide * cellsPerSide;
+
+	graph_t *graph = graph_create(numNodes);
+	int *cellOf = malloc(sizeof(int) * numNodes);
+	int *cellStart = calloc(cellCount + 1, sizeof(int));
+	int *cellNodes = malloc(sizeof(int) * numNodes);
+	if (!graph || !cellOf || !cellStart || !cellNodes) goto error;
+
+	for (int i = 0; i < numNodes; i++) {
+		double x = bench_rng_double(rng) * side;
+		double y = bench_rng_double(rng) * side;
+		graph_init_node(graph, i, x, y, NODE_TYPE_WAYPOINT);
+
+		int cx = (int) (x / radius);
+		int cy = (int) (y / radius);
+		if (cx >= cellsPerSide) cx = cellsPerSide - 1;
+		if (cy >= cellsPerSide) cy = cellsPerSide - 1;
+		cellOf[i] = cy * cellsPerSide + cx;
+		cellStart[cellOf[i] + 1]++;
+	}
+
+	// Tri par comptage des noeuds par cellule
+	for (int c = 0; c < cellCount; c++) cellStart[c + 1] += cellStart[c];
+	int *fill = malloc(sizeof(int) * cellCount);
+	if (!fill) goto error;
+	memcpy(fill, cellStart, sizeof(int) * cellCount);
+	for (int i = 0; i < numNodes; i++) cellNodes[fill[cellOf[i]]++] = i;
+	free(fill);
+
+	for (int i = 0; i < numNodes; i++) {
+		int cx = cellOf[i] % cellsPerSide;
+		int cy = cellOf[i] / cellsPerSide;
+		for (int dy = -1; dy <= 1; dy++) {
+			for (int dx = -1; dx <= 1; dx++) {
+				int nx = cx + dx, ny = cy + dy;
+				if (nx < 0 || ny < 0 || nx >= cellsPerSide || ny >= cellsPerSide) continue;
+
+				int cell = ny * cellsPerSide + nx;
+				for (int p = cellStart[cell]; p < cellStart[cell + 1]; p++) {
+					int j = cellNodes[p];
+					if (j == i) continue;
+					double distance = hypot(graph->nodes[i].x - graph->nodes[j].x, graph->nodes[i].y - graph->nodes[j].y);
+					if (distance <= radius && !add_noisy_edge(graph, i, j, rng, 0.1)) goto error;
+				}
+			}
+		}
+	}
+
+	free(cellOf);
+	free(cellStart);
+	free(cellNodes);
+	return graph;
+
+	error:
+		graph_destroy(graph);
+		free(cellOf);
+		free(cellStart);
+		free(cellNodes);
+		return NULL;
+}
+
+/**
+ * @brief Retourne le nom d'un type de carte (utilisé dans le rapport JSON).
+ */
+const char *bench_map_name(bench_map_type_t type) {
+	switch (type) {
+		case BENCH_MAP_GRID: return "grid";
+		case BENCH_MAP_RING_ROAD: return "ring_road";
+		case BENCH_MAP_RANDOM_GEOMETRIC: return "random_geometric";
+		default: return "unknown";
+	}
+}
+
+/**
+ * @brief Génère une carte d'environ numNodes noeuds.
+ * @details La taille réelle peut être légèrement différente (arrondi de la grille, des anneaux).
+ * @param type Le type de carte
+ * @param numNodes Nombre de noeuds visé
+ * @param seed Graine du générateur pseudo-aléatoire
+ * @return Le graphe généré, ou NULL en cas d'erreur (à libérer avec graph_destroy())
+ */
+graph_t *bench_generate_map(bench_map_type_t type, int numNodes, uint64_t seed) {
+	bench_rng_t rng;
+	bench_rng_seed(&rng, seed);
+
+	switch (type) {
+		case BENCH_MAP_GRID: return generate_grid(numNodes, &rng);
+		case BENCH_MAP_RING_ROAD: return generate_ring_road(numNodes, &rng);
+		case BENCH_MAP_RANDOM_GEOMETRIC: return generate_random_geometric(numNodes, &rng);
+		default: return NULL;
+	}
+}
+
+/**
+ * @brief Compte le nombre d'arcs d'un graphe.
+ */
+long bench_count_edges(const graph_t *graph) {
+	long count = 0;
+	for (int i = 0; i < graph->numNodes; i++) {
+		for (const edge_t *edge = graph->nodes[i].edges; edge; edge = edge->nextEdge) {
+			count++;
+		}
+	}
+	return count;
+}
@@ -0,0 +1,269 @@
+/**
+ * @file bench_route_planner.c
+ * @brief Benchmark des recherches de chemin du route-planner sur des cartes synthétiques.
+ * @details
+ * Pour chaque type de carte et chaque taille (100 à 1M noeuds), exécute des requêtes
+ * à graine fixe et mesure :
+ * - la latence par requête (p50, p99, moyenne),
+ * - le nombre de noeuds visités (settled),
+ * - le nombre d'allocations et d'octets alloués par requête.
+ * Mesure également le débit des requêtes par lot (route_batch) avec 1 puis N workers.
+ * Le rapport est écrit en JSON pour suivre les régressions entre versions de libcore.
+ *
+ * Usage : route_planner_bench [-n max_nodes] [-q queries] [-s seed] [-m map] [-t threads] [-o output.json]
+ * @date 2026-10-19
+ */
+#include "bench/bench.h"
+#include "bench/map_generators.h"
+#include "route-planner/dijkstra.h"
+#include "route-planner/route_batch.h"
+
+#include <getopt.h>
+
+#define BENCH_DEFAULT_MAX_NODES 1000000
+#define BENCH_DEFAULT_QUERIES 200
+#define BENCH_DEFAULT_SEED 42
+#define BENCH_MIN_QUERIES 20
+#define BENCH_NODE_BUDGET 50000000L //!< Limite (requêtes x noeuds) pour garder les grandes cartes raisonnables
+#define BENCH_ONE_TO_MANY_TARGETS 8
+
+#ifndef BENCH_REVISION
+#define BENCH_REVISION "unknown"
+#endif
+
+/**
+ * @brief Type de requête mesurée.
+ */
+typedef enum {
+	QUERY_DIJKSTRA, //!< Plus court chemin point à point
+	QUERY_ONE_TO_MANY, //!< Coûts d'un noeud vers BENCH_ONE_TO_MANY_TARGETS cibles
+	QUERY_KIND_COUNT
+} query_kind_t;
+
+static const char *g_queryNames[QUERY_KIND_COUNT] = { "dijkstra", "one_to_many" };
+
+/**
+ * @brief Résultat agrégé d'une série de requêtes.
+ */
+typedef struct {
+	int queries;
+	int unreachable;
+	double p50Us, p99Us, meanUs;
+	double settledP50, settledMean; //!< -1 si la requête ne fournit pas de compteurs
+	double allocsPerQuery, bytesPerQuery;
+} query_result_t;
+
+/**
+ * @brief Exécute une série de requêtes d'un type donné et agrège les mesures.
+ * @internal
+ */
+static int run_queries(graph_t *graph, query_kind_t kind, int queries, uint64_t seed, query_result_t *result) {
+	double *latencies = malloc(sizeof(double) * queries);
+	double *settled = malloc(sizeof(double) * queries);
+	if (!latencies || !settled) {
+		free(latencies);
+		free(settled);
+		return -1;
+	}
+
+	bench_rng_t rng;
+	bench_rng_seed(&rng, seed);
+	*result = (query_result_t) { .queries = queries };
+
+	uint64_t allocCount = 0, allocBytes = 0;
+	double settledSum = 0.0, latencySum = 0.0;
+
+	for (int q = 0; q < queries; q++) {
+		node_t *start = &graph->nodes[bench_rng_int(&rng, graph->numNodes)];
+		node_t *targets[BENCH_ONE_TO_MANY_TARGETS];
+		for (int t = 0; t < BENCH_ONE_TO_MANY_TARGETS; t++) {
+			targets[t] = &graph->nodes[bench_rng_int(&rng, graph->numNodes)];
+		}
+
+		bench_alloc_stats_t allocBefore = bench_alloc_snapshot();
+		uint64_t begin = bench_now_ns();
+
+		if (kind == QUERY_DIJKSTRA) {
+			dijkstra_stats_t stats;
+			path_t path = dijkstra_find_path_ex(graph, start, targets[0], NULL, &stats);
+			latencies[q] = (bench_now_ns() - begin) / 1000.0;
+			settled[q] = stats.settledNodes;
+			if (path.length <= 0) result->unreachable++;
+			path_destroy(&path);
+		} else {
+			double costs[BENCH_ONE_TO_MANY_TARGETS];
+			dijkstra_compute_costs(graph, start, targets, BENCH_ONE_TO_MANY_TARGETS, costs);
+			latencies[q] = (bench_now_ns() - begin) / 1000.0;
+			settled[q] = -1.0;
+			for (int t = 0; t < BENCH_ONE_TO_MANY_TARGETS; t++) {
+				if (isinf(costs[t])) result->unreachable++;
+			}
+		}
+
+		bench_alloc_stats_t allocAfter = bench_alloc_snapshot();
+		allocCount += allocAfter.count - allocBefore.count;
+		allocBytes += allocAfter.bytes - allocBefore.bytes;
+		latencySum += latencies[q];
+		settledSum += settled[q];
+	}
+
+	result->meanUs = latencySum / queries;
+	result->p50Us = bench_percentile(latencies, queries, 50.0);
+	result->p99Us = bench_percentile(latencies, queries, 99.0);
+	result->settledMean = settledSum / queries;
+	result->settledP50 = bench_percentile(settled, queries, 50.0);
+	result->allocsPerQuery = (double) allocCount / queries;
+	result->bytesPerQuery = (double) allocBytes / queries;
+
+	free(latencies);
+	free(settled);
+	return 0;
+}
+
+/**
+ * @brief Mesure le temps de calcul d'un lot de requêtes point à point (coûts seuls).
+ * @return La durée en secondes, ou -1 en cas d'erreur.
+ * @internal
+ */
+static double run_batch(graph_t *graph, int workers, int entryCount, uint64_t seed, int *workerCount) {
+	route_batch_planner_t *planner = route_batch_planner_create(workers);
+	plan_route_batch_entry_t *entries = calloc(entryCount, sizeof(plan_route_batch_entry_t));
+	int *stops = malloc(sizeof(int) * entryCount * 2);
+	plan_route_batch_result_t *results = calloc(entryCount, sizeof(plan_route_batch_result_t));
+	double seconds = -1.0;
+
+	if (planner && entries && stops && results) {
+		bench_rng_t rng;
+		bench_rng_seed(&rng, seed);
+		for (int i = 0; i < entryCount; i++) {
+			stops[2 * i] = graph->nodes[bench_rng_int(&rng, graph->numNodes)].id;
+			stops[2 * i + 1] = graph->nodes[bench_rng_int(&rng, graph->numNodes)].id;
+			entries[i] = (plan_route_batch_entry_t) { .carId = i, .nodeIds = &stops[2 * i], .nodeCount = 2 };
+		}
+		plan_route_batch_request_t request = { .entries = entries, .entryCount = entryCount, .includePath = false };
+
+		// Un premier lot dimensionne les espaces de travail des workers
+		route_batch_planner_run(planner, graph, &request, results);
+		uint64_t begin = bench_now_ns();
+		route_batch_planner_run(planner, graph, &request, results);
+		seconds = (bench_now_ns() - begin) / 1e9;
+		*workerCount = planner->workerCount;
+	}
+
+	route_batch_planner_destroy(planner);
+	free(entries);
+	free(stops);
+	free(results);
+	return seconds;
+}
+
+static void print_usage(const char *program) {
+	fprintf(stderr, "Usage: %s [-n max_nodes] [-q queries] [-s seed] [-m grid|ring_road|random_geometric] [-t threads] [-o output.json]\n", program);
+}
+
+int main(int argc, char *argv[]) {
+	int maxNodes = BENCH_DEFAULT_MAX_NODES;
+	int maxQueries = BENCH_DEFAULT_QUERIES;
+	uint64_t seed = BENCH_DEFAULT_SEED;
+	const char *mapFilter = NULL;
+	const char *outputPath = NULL;
+	int batchThreads = 0;
+
+	int opt;
+	while ((opt = getopt(argc, argv, "n:q:s:m:t:o:h")) != -1) {
+		switch (opt) {
+			case 'n': maxNodes = atoi(optarg); break;
+			case 'q': maxQueries = atoi(optarg); break;
+			case 's': seed = strtoull(optarg, NULL, 10); break;
+			case 'm': mapFilter = optarg; break;
+			case 't': batchThreads = atoi(optarg); break;
+			case 'o': outputPath = optarg; break;
+			default:
+				print_usage(argv[0]);
+				return opt == 'h' ? 0 : 1;
+		}
+	}
+	if (maxNodes < 100 || maxQueries < 1) {
+		print_usage(argv[0]);
+		return 1;
+	}
+
+	FILE *json = stdout;
+	if (outputPath) {
+		json = fopen(outputPath, "w");
+		if (!json) {
+			perror("fopen");
+			return 1;
+		}
+	}
+
+	fprintf(json, "{\n  \"benchmark\": \"route-planner\",\n  \"revision\": \"%s\",\n  \"seed\": %llu,\n  \"results\": [", BENCH_REVISION, (unsigned long long) seed);
+	fprintf(stderr, "%-17s %8s %9s %-12s %7s %10s %10s %10s %9s %9s\n", "map", "nodes", "edges", "query", "queries", "p50(us)", "p99(us)", "settled", "allocs/q", "KiB/q");
+
+	bool first = true;
+	for (int type = BENCH_MAP_GRID; type <= BENCH_MAP_RANDOM_GEOMETRIC; type++) {
+		if (mapFilter && strcmp(mapFilter, bench_map_name(type)) != 0) continue;
+
+		for (long size = 100; size <= maxNodes; size *= 10) {
+			uint64_t buildBegin = bench_now_ns();
+			graph_t *graph = bench_generate_map(type, (int) size, seed);
+			double buildMs = (bench_now_ns() - buildBegin) / 1e6;
+			if (!graph) {
+				fprintf(stderr, "Failed to generate %s map with %ld nodes\n", bench_map_name(type), size);
+				continue;
+			}
+			long edges = bench_count_edges(graph);
+
+			int queries = (int) (BENCH_NODE_BUDGET / graph->numNodes);
+			if (queries > maxQueries) queries = maxQueries;
+			if (queries < BENCH_MIN_QUERIES) queries = BENCH_MIN_QUERIES;
+
+			for (int kind = 0; kind < QUERY_KIND_COUNT; kind++) {
+				query_result_t result;
+				if (run_queries(graph, kind, queries, seed + kind, &result) != 0) {
+					fprintf(stderr, "Out of memory while running %s queries\n", g_queryNames[kind]);
+					continue;
+				}
+
+				char settledText[16] = "-";
+				if (result.settledMean >= 0) snprintf(settledText, sizeof(settledText), "%.0f", result.settledP50);
+				fprintf(stderr, "%-17s %8d %9ld %-12s %7d %10.1f %10.1f %10s %9.1f %9.1f\n",
+					bench_map_name(type), graph->numNodes, edges, g_queryNames[kind], result.queries,
+					result.p50Us, result.p99Us, settledText, result.allocsPerQuery, result.bytesPerQuery / 1024.0);
+
+				fprintf(json, "%s\n    {\"map\": \"%s\", \"nodes\": %d, \"edges\": %ld, \"buildMs\": %.3f, \"query\": \"%s\", "
+					"\"queries\": %d, \"unreachable\": %d, \"p50Us\": %.3f, \"p99Us\": %.3f, \"meanUs\": %.3f, ",
+					first ? "" : ",", bench_map_name(type), graph->numNodes, edges, buildMs, g_queryNames[kind],
+					result.queries, result.unreachable, result.p50Us, result.p99Us, result.meanUs);
+				if (result.settledMean >= 0) {
+					fprintf(json, "\"settledP50\": %.0f, \"settledMean\": %.1f, ", result.settledP50, result.settledMean);
+				} else {
+					fprintf(json, "\"settledP50\": null, \"settledMean\": null, ");
+				}
+				fprintf(json, "\"allocsPerQuery\": %.2f, \"bytesPerQuery\": %.1f}", result.allocsPerQuery, result.bytesPerQuery);
+				first = false;
+			}
+
+			// Débit des lots : 1 worker puis batchThreads workers (0 : nombre de coeurs)
+			int serialWorkers = 0, parallelWorkers = 0;
+			double serialSeconds = run_batch(graph, 1, queries, seed, &serialWorkers);
+			double parallelSeconds = run_batch(graph, batchThreads, queries, seed, &parallelWorkers);
+			if (serialSeconds > 0 && parallelSeconds > 0) {
+				double entriesPerSec = queries / parallelSeconds;
+				double speedup = serialSeconds / parallelSeconds;
+				fprintf(stderr, "%-17s %8d %9ld %-12s %7d %10.0f entries/s, %d workers (x%.2f vs 1 worker)\n",
+					bench_map_name(type), graph->numNodes, edges, "batch", queries, entriesPerSec, parallelWorkers, speedup);
+				fprintf(json, "%s\n    {\"map\": \"%s\", \"nodes\": %d, \"edges\": %ld, \"query\": \"batch\", \"queries\": %d, "
+					"\"workers\": %d, \"entriesPerSec\": %.1f, \"serialEntriesPerSec\": %.1f, \"speedup\": %.3f}",
+					first ? "" : ",", bench_map_name(type), graph->numNodes, edges, queries, parallelWorkers, entriesPerSec, queries / serialSeconds, speedup);
+				first = false;
+			}
+
+			graph_destroy(graph);
+		}
+	}
+
+	fprintf(json, "\n  ]\n}\n");
+	if (json != stdout) fclose(json);
+	return 0;
+}
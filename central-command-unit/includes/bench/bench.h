@@ -0,0 +1,95 @@
+/**
+ * @file bench.h
+ * @brief Utilitaires communs aux benchmarks (chronométrage, allocations, statistiques).
+ * @details
+ * Les compteurs d'allocations reposent sur l'option d'édition de liens
+ * -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc (voir la cible `bench` du Makefile).
+ * @date 2026-10-19
+ */
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "core/common.h"
+
+/**
+ * @brief Générateur pseudo-aléatoire déterministe (xorshift64*).
+ * @details Indépendant de la libc pour que les graines donnent les mêmes cartes sur toutes les cibles.
+ */
+typedef struct {
+	uint64_t state;
+} bench_rng_t;
+
+/**
+ * @brief Compteurs d'allocations depuis le démarrage du programme.
+ */
+typedef struct {
+	uint64_t count; //!< Nombre d'appels à malloc/calloc/realloc
+	uint64_t bytes; //!< Nombre d'octets demandés
+} bench_alloc_stats_t;
+
+/**
+ * @brief Série de mesures de taille variable (latences, ...).
+ * @details Initialisée à zéro ({0}) ; le tableau grandit par doublement.
+ */
+typedef struct {
+	double *values;
+	int count;
+	int capacity;
+} bench_samples_t;
+
+/**
+ * @brief Initialise le générateur avec une graine (0 est remplacée par une constante).
+ */
+void bench_rng_seed(bench_rng_t *rng, uint64_t seed);
+
+/**
+ * @brief Tire un entier pseudo-aléatoire sur 64 bits.
+ */
+uint64_t bench_rng_next(bench_rng_t *rng);
+
+/**
+ * @brief Tire un entier dans [0, bound).
+ */
+int bench_rng_int(bench_rng_t *rng, int bound);
+
+/**
+ * @brief Tire un réel dans [0, 1).
+ */
+double bench_rng_double(bench_rng_t *rng);
+
+/**
+ * @brief Retourne l'horloge monotone en nanosecondes.
+ */
+uint64_t bench_now_ns(void);
+
+/**
+ * @brief Retourne un instantané des compteurs d'allocations.
+ */
+bench_alloc_stats_t bench_alloc_snapshot(void);
+
+/**
+ * @brief Calcule un percentile sur un tableau de mesures.
+ * @param values Les mesures (triées en place)
+ * @param count Nombre de mesures
+ * @param percentile Percentile voulu, dans [0, 100]
+ * @return La valeur du percentile, 0 si le tableau est vide
+ */
+double bench_percentile(double *values, int count, double percentile);
+
+/**
+ * @brief Ajoute une mesure à une série.
+ * @return 0 en cas de succès, -1 si l'allocation échoue (la mesure est perdue)
+ */
+int bench_samples_add(bench_samples_t *samples, double value);
+
+/**
+ * @brief Vide une série en conservant sa mémoire.
+ */
+void bench_samples_clear(bench_samples_t *samples);
+
+/**
+ * @brief Libère la mémoire d'une série.
+ */
+void bench_samples_free(bench_samples_t *samples);
+
+#endif // BENCH_H
@@ -0,0 +1,51 @@
+/**
+ * @file map_generators.h
+ * @brief Générateurs de cartes synthétiques pour les benchmarks du route-planner.
+ * @details
+ * Toutes les cartes sont déterministes pour une graine donnée. Les IDs des noeuds
+ * correspondent à leur index et les poids ne sont jamais inférieurs à la distance
+ * euclidienne entre les noeuds (heuristiques géométriques admissibles).
+ * @date 2026-10-19
+ */
+#ifndef MAP_GENERATORS_H
+#define MAP_GENERATORS_H
+
+#include "core/graph.h"
+#include "bench/bench.h"
+
+/** Distance entre deux noeuds voisins de la grille */
+#define BENCH_GRID_SPACING 10.0
+
+/** Degré moyen visé pour les graphes géométriques aléatoires */
+#define BENCH_GEOMETRIC_AVG_DEGREE 6.0
+
+/**
+ * @brief Type de carte synthétique.
+ */
+typedef enum {
+	BENCH_MAP_GRID, //!< Grille à double sens (quartier en damier)
+	BENCH_MAP_RING_ROAD, //!< Anneaux concentriques à sens unique reliés par des radiales
+	BENCH_MAP_RANDOM_GEOMETRIC, //!< Points uniformes reliés sous un rayon donné
+} bench_map_type_t;
+
+/**
+ * @brief Retourne le nom d'un type de carte (utilisé dans le rapport JSON).
+ */
+const char *bench_map_name(bench_map_type_t type);
+
+/**
+ * @brief Génère une carte d'environ numNodes noeuds.
+ * @details La taille réelle peut être légèrement différente (arrondi de la grille, des anneaux).
+ * @param type Le type de carte
+ * @param numNodes Nombre de noeuds visé
+ * @param seed Graine du générateur pseudo-aléatoire
+ * @return Le graphe généré, ou NULL en cas d'erreur (à libérer avec graph_destroy())
+ */
+graph_t *bench_generate_map(bench_map_type_t type, int numNodes, uint64_t seed);
+
+/**
+ * @brief Compte le nombre d'arcs d'un graphe.
+ */
+long bench_count_edges(const graph_t *graph);
+
+#endif // MAP_GENERATORS_H
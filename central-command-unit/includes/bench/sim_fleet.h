@@ -0,0 +1,103 @@
+/**
+ * @file sim_fleet.h
+ * @brief Flotte de véhicules simulés pour le générateur de charge (bench/loadgen).
+ * @details
+ * Chaque véhicule est un client MQTT (libmosquitto) avec ses propres topics vehicles/<id>/... :
+ * - il publie son état (vehicles/<id>/state) à fréquence fixe ;
+ * - il demande des trajets au route planner (PLAN_ROUTE_REQUEST, réponse sur vehicles/<id>/response)
+ *   et mesure le délai jusqu'à la réception du SET_WAYPOINTS_REQUEST sur vehicles/<id>/request ;
+ * - il perd sa connexion (fermeture de la socket, sans DISCONNECT) pour déclencher son LWT, puis
+ *   se reconnecte après un délai : un client de surveillance abonné au topic de requête du route
+ *   planner mesure le délai jusqu'au CANCEL_VEHICLE_ROUTE_REQUEST envoyé par le heartbeat.
+ * Tous les clients sont servis par une seule boucle d'événements du core (une socket par client,
+ * timers dans une roue) : le nombre de véhicules n'est limité que par les descripteurs disponibles.
+ * Les mesures sont attribuées à la période pendant laquelle elles se terminent.
+ * @date 2026-10-19
+ */
+#ifndef SIM_FLEET_H
+#define SIM_FLEET_H
+
+#include "bench/bench.h"
+
+#define SIM_FLEET_KEEPALIVE_SEC 30
+#define SIM_FLEET_RECONNECT_DELAY_MS 1000 //!< Délai avant reconnexion après une perte de connexion imprévue
+
+typedef struct sim_fleet sim_fleet_t;
+
+/**
+ * @brief Paramètres de la flotte.
+ */
+typedef struct {
+	const char *host;      //!< Adresse du broker
+	int port;              //!< Port du broker
+	int firstVehicleId;    //!< Identifiant du premier véhicule (les suivants sont consécutifs)
+	double stateHz;        //!< Publications d'état par seconde et par véhicule (0 : aucune)
+	double plansPerMin;    //!< Demandes de trajet par minute et par véhicule (0 : aucune)
+	double offlinePerMin;  //!< Pertes de connexion par minute et par véhicule (0 : aucune)
+	int offlineMs;         //!< Durée hors ligne avant reconnexion
+	int timeoutMs;         //!< Délai au-delà duquel un trajet ou une annulation est compté perdu
+	int maxNodeId;         //!< Les arrêts sont tirés dans [1, maxNodeId]
+	int stopsPerPlan;      //!< Nombre d'arrêts par demande de trajet (au moins 2)
+	uint64_t seed;
+} sim_fleet_config_t;
+
+/**
+ * @brief Compteurs et latences d'une période.
+ */
+typedef struct {
+	uint64_t statesPublished;
+	uint64_t plansSent;
+	uint64_t plansSkipped;   //!< Demandes non envoyées : la précédente était toujours en attente
+	uint64_t plansCompleted; //!< SET_WAYPOINTS_REQUEST reçus
+	uint64_t plansFailed;    //!< Réponses en échec du route planner
+	uint64_t plansTimedOut;
+	uint64_t offlineEvents;
+	uint64_t cancelsObserved;
+	uint64_t cancelsTimedOut;
+	uint64_t connectionLosses; //!< Pertes de connexion imprévues (hors pertes simulées)
+	bench_samples_t planLatencyMs;
+	bench_samples_t cancelLatencyMs;
+} sim_fleet_metrics_t;
+
+/**
+ * @brief Crée une flotte vide et connecte son client de surveillance.
+ * @param config Paramètres (copiés, host doit rester valide)
+ * @return La flotte, ou NULL en cas d'erreur (broker injoignable, ...)
+ */
+sim_fleet_t *sim_fleet_create(const sim_fleet_config_t *config);
+
+/**
+ * @brief Connecte des véhicules jusqu'à atteindre un effectif.
+ * @param fleet La flotte
+ * @param vehicleCount Effectif voulu (les véhicules existants sont conservés)
+ * @return Le nombre de véhicules de la flotte (inférieur à vehicleCount si des connexions échouent)
+ */
+int sim_fleet_grow(sim_fleet_t *fleet, int vehicleCount);
+
+/**
+ * @brief Fait tourner la flotte pendant une durée.
+ * @param fleet La flotte
+ * @param durationMs Durée en millisecondes
+ * @return 0 en cas de succès, -1 si la boucle d'événements échoue
+ */
+int sim_fleet_run(sim_fleet_t *fleet, int durationMs);
+
+/**
+ * @brief Transfère les mesures de la période écoulée et remet les compteurs de la flotte à zéro.
+ * @param fleet La flotte
+ * @param metrics Mesures à remplir (libérées avec sim_fleet_metrics_free())
+ */
+void sim_fleet_take_metrics(sim_fleet_t *fleet, sim_fleet_metrics_t *metrics);
+
+/**
+ * @brief Libère les séries de mesures.
+ */
+void sim_fleet_metrics_free(sim_fleet_metrics_t *metrics);
+
+/**
+ * @brief Déconnecte les véhicules (DISCONNECT : aucun LWT) et libère la flotte.
+ * @param fleet La flotte (NULL accepté)
+ */
+void sim_fleet_destroy(sim_fleet_t *fleet);
+
+#endif // SIM_FLEET_H
@@ -12,4 +12,5 @@
 #include "conflict-manager/conflict.h"
 
 #define CONFLICT_MANAGER_SERVICE_VERSION "Conflict Manager v1.0.0"
+#define CONFLICT_CLEANUP_INTERVAL_MS 1000 //!< Période de suppression des verrous expirés (conflict_cleanup())
 #endif // HEARTBEAT_H
\ No newline at end of file
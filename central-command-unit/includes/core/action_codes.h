@@ -17,7 +17,9 @@
 #define ACTION_SET_RAILWAY_MODE       "SET_RAILWAY_MODE"
 #define ACTION_GET_MAP_REQUEST 	      "GET_MAP_REQUEST"
 #define ACTION_PLAN_ROUTE_REQUEST     "PLAN_ROUTE_REQUEST"
+#define ACTION_PLAN_ROUTE_BATCH_REQUEST "PLAN_ROUTE_BATCH_REQUEST"
 #define ACTION_SET_WAYPOINTS_REQUEST  "SET_WAYPOINTS_REQUEST"
 #define ACTION_START_ROUTE 		 	  "START_ROUTE"
+#define ACTION_SET_LOG_LEVEL          "SET_LOG_LEVEL"
 
 #endif // ACTION_CODES_H
\ No newline at end of file
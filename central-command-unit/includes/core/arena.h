@@ -0,0 +1,89 @@
+/**
+ * @file arena.h
+ * @brief Allocateur par arène (bump allocator).
+ * @details
+ * Module fournissant un allocateur "arène" : les allocations sont découpées
+ * séquentiellement dans de grands blocs et libérées toutes ensemble par
+ * arena_destroy(), ou recyclées par arena_reset() sans rendre la mémoire au système.
+ * La taille des blocs double à chaque nouveau bloc (jusqu'à ARENA_MAX_BLOCK_SIZE),
+ * si bien qu'un graphe d'un million de noeuds ne coûte que quelques dizaines d'allocations.
+ * @warning Une arène n'est pas thread-safe : chaque thread doit utiliser la sienne.
+ * @date 2026-10-19
+ */
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "core/common.h"
+#include <stddef.h>
+
+/** Taille du premier bloc lorsque 0 est passé à arena_create() */
+#define ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+
+/** Taille maximale d'un bloc obtenu par croissance (les grosses demandes ont leur propre bloc) */
+#define ARENA_MAX_BLOCK_SIZE (16 * 1024 * 1024)
+
+/** Alignement garanti pour toutes les allocations */
+#define ARENA_ALIGNMENT (_Alignof(max_align_t))
+
+typedef struct _ArenaBlock {
+	struct _ArenaBlock *next; //!< Bloc suivant dans la chaîne
+	size_t size; //!< Capacité utile du bloc en octets
+	size_t used; //!< Nombre d'octets déjà distribués
+	_Alignas(max_align_t) unsigned char data[]; //!< Zone distribuée aux appelants
+} arena_block_t;
+
+typedef struct {
+	arena_block_t *head; //!< Premier bloc (conservé lors d'un reset)
+	arena_block_t *current; //!< Bloc dans lequel les allocations sont servies
+	size_t nextBlockSize; //!< Taille du prochain bloc à allouer
+	size_t blockCount; //!< Nombre de blocs alloués
+	size_t reserved; //!< Mémoire totale réservée (octets)
+} arena_t;
+
+/**
+ * @brief Crée une arène.
+ * @param initialBlockSize Taille du premier bloc en octets (0 pour ARENA_DEFAULT_BLOCK_SIZE)
+ * @return L'arène créée, ou NULL en cas d'erreur d'allocation
+ * @warning L'arène doit être libérée avec arena_destroy()
+ */
+arena_t *arena_create(size_t initialBlockSize);
+
+/**
+ * @brief Alloue une zone mémoire alignée dans l'arène.
+ * @param arena L'arène
+ * @param size Taille demandée en octets
+ * @return Pointeur vers la zone, ou NULL en cas d'erreur
+ * @note La zone n'est pas initialisée. Elle ne doit pas être libérée individuellement.
+ */
+void *arena_alloc(arena_t *arena, size_t size);
+
+/**
+ * @brief Alloue une zone mémoire initialisée à zéro dans l'arène.
+ * @param arena L'arène
+ * @param count Nombre d'éléments
+ * @param size Taille d'un élément
+ * @return Pointeur vers la zone, ou NULL en cas d'erreur (ou de dépassement)
+ */
+void *arena_calloc(arena_t *arena, size_t count, size_t size);
+
+/**
+ * @brief Invalide toutes les allocations de l'arène en conservant ses blocs.
+ * @details Les blocs sont réutilisés par les allocations suivantes : une arène
+ * réinitialisée à chaque requête n'appelle plus malloc une fois sa taille stabilisée.
+ * @param arena L'arène
+ */
+void arena_reset(arena_t *arena);
+
+/**
+ * @brief Libère l'arène et tous ses blocs en une fois.
+ * @param arena L'arène (NULL accepté)
+ */
+void arena_destroy(arena_t *arena);
+
+/**
+ * @brief Retourne le nombre d'octets actuellement distribués par l'arène.
+ * @param arena L'arène
+ */
+size_t arena_used(const arena_t *arena);
+
+#endif // ARENA_H
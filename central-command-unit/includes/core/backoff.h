@@ -0,0 +1,44 @@
+/**
+ * @file backoff.h
+ * @brief Délais de nouvelle tentative exponentiels avec gigue.
+ * @details
+ * Le délai de la tentative n vaut minMs * 2^n, plafonné à maxMs, dont seule la moitié est fixe :
+ * l'autre moitié est tirée aléatoirement ("equal jitter"). Les clients relancés en même temps
+ * (ex : redémarrage du broker) étalent ainsi leurs tentatives au lieu de se synchroniser.
+ * @note Non thread-safe : chaque état est propre à un appelant.
+ * @date 2026-10-19
+ */
+#ifndef CORE_BACKOFF_H
+#define CORE_BACKOFF_H
+
+#include "core/common.h"
+
+typedef struct {
+	uint32_t minMs;   //!< Délai de la première tentative
+	uint32_t maxMs;   //!< Plafond du délai
+	uint32_t attempt; //!< Tentatives depuis le dernier succès
+	uint32_t seed;    //!< État du générateur de gigue
+} backoff_t;
+
+/**
+ * @brief Initialise un état de backoff.
+ * @param backoff L'état
+ * @param minMs Délai de la première tentative (au moins 1 ms)
+ * @param maxMs Plafond du délai (ramené à minMs s'il est inférieur)
+ */
+void backoff_init(backoff_t *backoff, uint32_t minMs, uint32_t maxMs);
+
+/**
+ * @brief Retourne le délai avant la prochaine tentative et passe à la suivante.
+ * @param backoff L'état
+ * @return Un délai dans [d / 2, d], d = min(maxMs, minMs * 2^attempt)
+ */
+uint32_t backoff_next(backoff_t *backoff);
+
+/**
+ * @brief Revient au délai minimal après un succès.
+ * @param backoff L'état
+ */
+void backoff_reset(backoff_t *backoff);
+
+#endif // CORE_BACKOFF_H
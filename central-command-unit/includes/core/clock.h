@@ -0,0 +1,17 @@
+/**
+ * @file clock.h
+ * @brief Horloge monotone partagée par les modules du core (échéances, fenêtres, délais).
+ * @date 2026-10-19
+ */
+#ifndef CORE_CLOCK_H
+#define CORE_CLOCK_H
+
+#include "core/common.h"
+
+/**
+ * @brief Horloge monotone en millisecondes (CLOCK_MONOTONIC).
+ * @return Millisecondes depuis une origine arbitraire, insensible aux changements d'heure
+ */
+long clock_monotonic_ms(void);
+
+#endif // CORE_CLOCK_H
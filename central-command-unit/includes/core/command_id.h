@@ -0,0 +1,52 @@
+/**
+ * @file command_id.h
+ * @brief Générateur d'identifiants de commande uniques sur 64 bits.
+ * @details
+ * Un identifiant combine, de poids fort à poids faible :
+ * - COMMAND_ID_NODE_BITS bits d'identifiant de processus, tirés aléatoirement au premier appel ;
+ * - COMMAND_ID_TIME_BITS bits d'horodatage grossier (secondes, CLOCK_REALTIME_COARSE) ;
+ * - COMMAND_ID_COUNTER_BITS bits d'un compteur atomique du processus.
+ * Deux threads ne peuvent donc pas obtenir le même identifiant, et deux processus seulement si
+ * leurs tirages coïncident. La génération est sans verrou (un fetch-and-add).
+ * Sous forme texte, l'identifiant est encodé sur COMMAND_ID_HEX_DIGITS chiffres hexadécimaux
+ * derrière l'action ("<ACTION>-<16 hex>") : le champ commandId reste une chaîne lisible pour
+ * l'API, et la valeur de 64 bits se relit sans conversion coûteuse (command_id_parse()).
+ * @date 2026-10-19
+ */
+#ifndef COMMAND_ID_H
+#define COMMAND_ID_H
+
+#include "core/common.h"
+
+#define COMMAND_ID_NODE_BITS 20    //!< Identifiant aléatoire du processus
+#define COMMAND_ID_TIME_BITS 20    //!< Secondes (le champ reboucle après ~12 jours)
+#define COMMAND_ID_COUNTER_BITS 24 //!< Identifiants par processus avant rebouclage du compteur
+#define COMMAND_ID_HEX_DIGITS 16   //!< Longueur de la forme hexadécimale
+
+/**
+ * @brief Génère un nouvel identifiant.
+ * @note Thread-safe et sans verrou.
+ * @return L'identifiant (jamais 0)
+ */
+uint64_t command_id_next(void);
+
+/**
+ * @brief Écrit la forme texte "<prefix>-<16 hex>" d'un identifiant.
+ * @details Le préfixe est tronqué si nécessaire pour que la partie hexadécimale tienne toujours.
+ * @param buffer Destination (terminée par '\0')
+ * @param size Taille de la destination (au moins COMMAND_ID_HEX_DIGITS + 2)
+ * @param prefix Préfixe (action de la commande, NULL : aucun)
+ * @param id L'identifiant
+ * @return La longueur écrite, ou -1 si la destination est trop petite
+ */
+int command_id_format(char *buffer, size_t size, const char *prefix, uint64_t id);
+
+/**
+ * @brief Relit l'identifiant de 64 bits d'une forme texte produite par command_id_format().
+ * @param commandId La chaîne
+ * @param id Identifiant lu
+ * @return 0 en cas de succès, -1 si la chaîne ne se termine pas par "-<16 hex>" (ID externe, ex : "REQ_PLAN_...")
+ */
+int command_id_parse(const char *commandId, uint64_t *id);
+
+#endif // COMMAND_ID_H
@@ -15,6 +15,7 @@
 #define CORE_CONFIG_H
 
 #include "core/check.h"
+#include "core/mqtt.h"
 
 
 /**
@@ -27,12 +28,23 @@ typedef struct {
 	char brokerIp[16];
 	uint16_t brokerPort;
 	char clientId[64];
+	char instanceId[32]; // Optionnel : identifiant de l'instance d'un service répliqué, ajouté au clientId (vide : instance unique)
 	int timeoutSec;
+	mqtt_queue_config_t offlineQueue; // Optionnel : publications conservées pendant une coupure (0 : défauts)
+	uint32_t reconnectMinMs; // Optionnel : délai avant la première reconnexion en ms (0 : défaut)
+	uint32_t reconnectMaxMs; // Optionnel : délai maximal entre deux reconnexions en ms (0 : défaut)
+	mqtt_version_t protocolVersion; // Optionnel : version du protocole MQTT (défaut : 3.1.1)
 } network_config_t;
 
 typedef struct {
 	log_level_t logLevel;
 	char topic[128];
+	log_overflow_policy_t overflowPolicy; // Optionnel (défaut : drop)
+	char binaryFile[256]; // Optionnel : fichier de log binaire des appels différés (vide : formatés)
+	int batchSize; // Optionnel : messages max par publication MQTT (0 : défaut)
+	int batchWindowMs; // Optionnel : attente max d'un lot MQTT en ms (-1 : défaut)
+	log_file_sink_config_t file; // Optionnel : journal local avec rotation (chemin vide : désactivé)
+	bool console; // Optionnel : affichage des messages sur la console (défaut : true)
 } logging_config_t;
 
 typedef struct {
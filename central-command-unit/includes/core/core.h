@@ -13,6 +13,8 @@
 #include "core/config.h"
 #include "core/mqtt.h"
 #include "core/signal.h"
+#include "core/event_loop.h"
+#include "core/timer_wheel.h"
 #include "core/request_manager.h"
 
 
@@ -27,15 +29,21 @@
 #endif
 
 #define DEFAULT_CONFIG_PATH "./config.ini"
+#define CORE_LWT_TOPIC_LENGTH 128   //!< Taille du topic construit par un core_lwt_builder_t
+#define CORE_LWT_PAYLOAD_LENGTH 256 //!< Taille du payload construit par un core_lwt_builder_t
 
 
 /**
  * @brief Initialise tous les sous systèmes du core
  * @details
  * - Parse la ligne de commande pour trouver le fichier de configuration
- * - Lit le fichier de configuration
+ * - Lit le fichier de configuration (avec mqtt_instance_id, le clientId devient "<clientId>-<instance>")
+ * - Crée la boucle d'événements si core_use_event_loop() a été appelée.
+ * - Crée le routeur des messages MQTT du service.
  * - Initialise le client MQTT et se connecte.
  * - Initialise le logger avec un callback qui log sur la console et sur le topic MQTT dédiéabort
+ * - Démarre la roue de timers du service (dans la boucle d'événements ou dans un thread dédié).
+ * - Initialise le gestionnaire de requêtes, dont les échéances sont portées par la roue.
  * 
  * @param argc Nombre d'arguments
  * @param argv Tableau des arguments
@@ -56,6 +64,27 @@ int core_bootstrap(
 	char *lwtTopic
 );
 
+/**
+ * @brief Construit le LWT du service d'après sa configuration.
+ * @details Appelé par core_bootstrap() après la lecture de la configuration, avant la connexion.
+ * @param commonConfig Configuration commune lue (le clientId comprend déjà l'instance)
+ * @param serviceConfig Configuration spécifique au service
+ * @param topic Topic du LWT à remplir
+ * @param topicSize Taille de topic
+ * @param payload Payload du LWT à remplir
+ * @param payloadSize Taille de payload
+ * @return 0 en cas de succès, -1 en cas d'erreur (core_bootstrap() échoue)
+ */
+typedef int (*core_lwt_builder_t)(const config_common_t *commonConfig, const void *serviceConfig, char *topic, size_t topicSize, char *payload, size_t payloadSize);
+
+/**
+ * @brief Remplace le LWT fixe passé à core_bootstrap() par un LWT construit d'après la configuration.
+ * @details Doit être appelée par main() avant core_bootstrap() (ex : topic de status propre à
+ * chaque instance d'un service répliqué).
+ * @param builder La fonction de construction (NULL : LWT passé à core_bootstrap())
+ */
+void core_set_lwt_builder(core_lwt_builder_t builder);
+
 /**
  * @brief Enregistre la chaîne de version du service.
  * @details Doit être appelée par main() avant core_bootstrap().
@@ -63,13 +92,54 @@ int core_bootstrap(
  */
 void core_set_service_version(const char* serviceVersion);
 
+/**
+ * @brief Demande au core d'exécuter le service dans une boucle d'événements.
+ * @details Doit être appelée par main() avant core_bootstrap(). Le client MQTT est alors piloté
+ * par la boucle (plus de thread réseau) et core_run() l'exécute jusqu'au signal d'arrêt :
+ * les callbacks MQTT et ceux enregistrés par le service dans core_get_event_loop() sont tous
+ * appelés dans le thread principal.
+ */
+void core_use_event_loop(void);
+
+/**
+ * @brief Retourne la boucle d'événements du service.
+ * @return La boucle, ou NULL si core_use_event_loop() n'a pas été appelée avant core_bootstrap()
+ */
+event_loop_t *core_get_event_loop(void);
+
+/**
+ * @brief Retourne la roue de timers du service.
+ * @details Les callbacks sont appelés dans la boucle d'événements si le service l'utilise,
+ * sinon dans le thread de la roue.
+ * @return La roue, ou NULL avant core_bootstrap()
+ */
+timer_wheel_t *core_get_timer_wheel(void);
+
+/**
+ * @brief Retourne le routeur des messages MQTT du service.
+ * @details Les routes doivent être enregistrées avant de s'abonner aux topics concernés.
+ * Les handlers sont appelés dans le thread MQTT, ou dans la boucle d'événements si le service l'utilise.
+ * @return Le routeur, ou NULL avant core_bootstrap()
+ */
+mqtt_router_t *core_get_router(void);
+
+/**
+ * @brief Exécute le service jusqu'au signal d'arrêt.
+ * @details Exécute la boucle d'événements si elle est utilisée, sinon attend le signal d'arrêt
+ * (signal_wait_for_shutdown()).
+ */
+void core_run(void);
+
 /**
  * @brief Arrête tous les sous systèmes du core
  * @details
- * - Déconnecte le client MQTT
- * - Libère les ressources allouées
  * - Arrête le système de logging
+ * - Déconnecte le client MQTT et libère le routeur
+ * - Arrête la roue de timers (les timers en attente sont abandonnés)
+ * - Libère les requêtes en attente de réponse
+ * - Libère la boucle d'événements
  * @note Cette fonction doit être appelée avant de quitter le programme.
+ * Les descripteurs enregistrés par le service dans la boucle doivent en être retirés avant.
  */
 void core_shutdown(void);
 
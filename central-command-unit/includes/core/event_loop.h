@@ -0,0 +1,240 @@
+/**
+ * @file event_loop.h
+ * @brief Boucle d'événements (réacteur) basée sur epoll, timerfd et eventfd.
+ * @details
+ * Module permettant à un service de traiter toutes ses entrées dans un seul thread :
+ * - descripteurs surveillés en lecture et/ou écriture (sockets, UART, client MQTT, ...) ;
+ * - timers périodiques ou ponctuels, chacun porté par un timerfd ;
+ * - tâches postées depuis d'autres threads (ex : thread d'acquisition d'une bibliothèque),
+ *   copiées dans une file MPSC préallouée puis exécutées dans le thread de la boucle ;
+ * - fonctions de préparation appelées avant chaque attente (ex : intérêt en écriture du client MQTT).
+ * Les callbacks sont tous appelés dans le thread qui exécute event_loop_run() : l'état du service
+ * qu'ils manipulent n'a pas besoin d'être protégé par un verrou.
+ * Seules event_loop_post(), event_loop_wake() et event_loop_stop() sont appelables depuis un autre
+ * thread ; event_loop_stop() est aussi appelable depuis un gestionnaire de signal.
+ * @date 2026-10-19
+ */
+#ifndef EVENT_LOOP_H
+#define EVENT_LOOP_H
+
+#include "core/common.h"
+#include "core/ring_buffer.h"
+
+#define EVENT_LOOP_READ 0x1u //!< Descripteur prêt en lecture (ou fermé par le pair)
+#define EVENT_LOOP_WRITE 0x2u //!< Descripteur prêt en écriture
+#define EVENT_LOOP_ERROR 0x4u //!< Erreur ou fermeture signalée sur le descripteur (toujours surveillée)
+
+#define EVENT_LOOP_MAX_EVENTS 64 //!< Événements traités par appel à epoll_wait()
+#define EVENT_LOOP_MAX_PREPARE 8 //!< Nombre maximal de fonctions de préparation
+#define EVENT_LOOP_POST_CAPACITY 256 //!< Capacité de la file des tâches postées
+#define EVENT_LOOP_POST_DATA_SIZE 64 //!< Taille maximale des données copiées avec une tâche postée
+
+typedef struct event_loop event_loop_t;
+typedef struct event_loop_handler event_loop_timer_t;
+
+/**
+ * @brief Callback appelé lorsqu'un descripteur surveillé est prêt.
+ * @param loop La boucle
+ * @param fd Le descripteur
+ * @param events Combinaison de EVENT_LOOP_READ, EVENT_LOOP_WRITE et EVENT_LOOP_ERROR
+ * @param context Contexte fourni à event_loop_add_fd()
+ */
+typedef void (*event_loop_fd_callback_t)(event_loop_t *loop, int fd, uint32_t events, void *context);
+
+/**
+ * @brief Callback appelé à chaque expiration d'un timer.
+ * @param loop La boucle
+ * @param timer Le timer (peut être annulé ou réarmé depuis le callback)
+ * @param context Contexte fourni à event_loop_add_timer()
+ */
+typedef void (*event_loop_timer_callback_t)(event_loop_t *loop, event_loop_timer_t *timer, void *context);
+
+/**
+ * @brief Tâche postée exécutée dans le thread de la boucle.
+ * @param loop La boucle
+ * @param data Copie des données fournies à event_loop_post() (NULL si aucune)
+ * @param context Contexte fourni à event_loop_post()
+ */
+typedef void (*event_loop_task_t)(event_loop_t *loop, void *data, void *context);
+
+/**
+ * @brief Fonction appelée avant chaque attente de la boucle.
+ * @param loop La boucle
+ * @param context Contexte fourni à event_loop_add_prepare()
+ */
+typedef void (*event_loop_prepare_t)(event_loop_t *loop, void *context);
+
+/**
+ * @brief Descripteur ou timer enregistré dans la boucle.
+ * @details Un handler retiré pendant la distribution des événements n'est libéré qu'à la fin
+ * de l'itération, afin que les événements déjà reçus pour lui soient ignorés sans risque.
+ */
+struct event_loop_handler {
+	int fd;
+	uint32_t events; //!< Intérêt courant (EVENT_LOOP_READ / EVENT_LOOP_WRITE)
+	bool isTimer; //!< fd est un timerfd possédé par la boucle
+	bool removed; //!< Retiré, en attente de libération
+	event_loop_fd_callback_t callback;
+	event_loop_timer_callback_t timerCallback;
+	void *context;
+	struct event_loop_handler *next; //!< Handlers actifs, puis handlers à libérer
+};
+
+/**
+ * @brief Tâche en attente dans la file des tâches postées.
+ */
+typedef struct {
+	event_loop_task_t task;
+	void *context;
+	size_t dataSize;
+	max_align_t data[(EVENT_LOOP_POST_DATA_SIZE + sizeof(max_align_t) - 1) / sizeof(max_align_t)];
+} event_loop_post_t;
+
+struct event_loop {
+	int epollFd;
+	ring_buffer_t posted; //!< Tâches postées (son eventfd réveille la boucle)
+	int wakePending; //!< Un réveil est déjà signalé sur l'eventfd (accès atomique)
+	int stopRequested; //!< Demande d'arrêt de event_loop_run() (accès atomique)
+	pthread_t ownerThread; //!< Thread exécutant la boucle (créateur, puis dernier appelant de event_loop_run_once())
+	struct event_loop_handler *handlers; //!< Handlers actifs
+	struct event_loop_handler *garbage; //!< Handlers retirés pendant l'itération en cours
+	event_loop_prepare_t prepare[EVENT_LOOP_MAX_PREPARE];
+	void *prepareContext[EVENT_LOOP_MAX_PREPARE];
+	int prepareCount;
+	uint64_t postDropped; //!< Tâches refusées (file pleine)
+};
+
+/**
+ * @brief Crée une boucle d'événements.
+ * @return La boucle, ou NULL en cas d'erreur
+ * @warning La boucle doit être libérée avec event_loop_destroy()
+ */
+event_loop_t *event_loop_create(void);
+
+/**
+ * @brief Libère la boucle et ses handlers (les descripteurs surveillés ne sont pas fermés).
+ * @param loop La boucle (NULL accepté)
+ * @note Les tâches postées non exécutées sont abandonnées.
+ */
+void event_loop_destroy(event_loop_t *loop);
+
+/**
+ * @brief Exécute la boucle jusqu'à l'appel de event_loop_stop().
+ * @param loop La boucle
+ * @return 0 après un arrêt demandé, -1 en cas d'erreur
+ */
+int event_loop_run(event_loop_t *loop);
+
+/**
+ * @brief Attend des événements au plus timeoutMs millisecondes et les traite.
+ * @param loop La boucle
+ * @param timeoutMs Délai maximal d'attente (-1 : infini, 0 : aucune attente)
+ * @return Le nombre d'événements traités, ou -1 en cas d'erreur
+ */
+int event_loop_run_once(event_loop_t *loop, int timeoutMs);
+
+/**
+ * @brief Demande l'arrêt de event_loop_run() (tout thread, gestionnaire de signal).
+ * @param loop La boucle
+ */
+void event_loop_stop(event_loop_t *loop);
+
+/**
+ * @brief Réveille la boucle si elle attend (tout thread).
+ * @details Les fonctions de préparation sont rappelées avant la prochaine attente.
+ * @param loop La boucle
+ */
+void event_loop_wake(event_loop_t *loop);
+
+/**
+ * @brief Indique si l'appelant est le thread qui exécute la boucle.
+ */
+bool event_loop_in_loop_thread(const event_loop_t *loop);
+
+/**
+ * @brief Surveille un descripteur.
+ * @param loop La boucle
+ * @param fd Le descripteur (de préférence non bloquant)
+ * @param events Combinaison de EVENT_LOOP_READ et EVENT_LOOP_WRITE
+ * @param callback Fonction appelée lorsque le descripteur est prêt
+ * @param context Contexte transmis au callback
+ * @return 0 en cas de succès, -1 en cas d'erreur (descripteur déjà surveillé, ...)
+ */
+int event_loop_add_fd(event_loop_t *loop, int fd, uint32_t events, event_loop_fd_callback_t callback, void *context);
+
+/**
+ * @brief Modifie les événements surveillés sur un descripteur.
+ * @param loop La boucle
+ * @param fd Le descripteur
+ * @param events Combinaison de EVENT_LOOP_READ et EVENT_LOOP_WRITE
+ * @return 0 en cas de succès, -1 si le descripteur n'est pas surveillé
+ */
+int event_loop_modify_fd(event_loop_t *loop, int fd, uint32_t events);
+
+/**
+ * @brief Arrête de surveiller un descripteur (appelable depuis un callback).
+ * @param loop La boucle
+ * @param fd Le descripteur (il n'est pas fermé)
+ * @return 0 en cas de succès, -1 si le descripteur n'est pas surveillé
+ * @warning Retirer le descripteur avant de le fermer.
+ */
+int event_loop_remove_fd(event_loop_t *loop, int fd);
+
+/**
+ * @brief Crée un timer.
+ * @param loop La boucle
+ * @param initialMs Délai avant la première expiration (0 : timer créé désarmé)
+ * @param intervalMs Période des expirations suivantes (0 : timer ponctuel)
+ * @param callback Fonction appelée à chaque expiration
+ * @param context Contexte transmis au callback
+ * @return Le timer, ou NULL en cas d'erreur
+ * @note Un timer ponctuel reste enregistré après son expiration : il peut être réarmé avec
+ * event_loop_timer_set() et doit être libéré avec event_loop_cancel_timer().
+ */
+event_loop_timer_t *event_loop_add_timer(event_loop_t *loop, int initialMs, int intervalMs, event_loop_timer_callback_t callback, void *context);
+
+/**
+ * @brief Réarme (ou désarme) un timer.
+ * @param timer Le timer
+ * @param initialMs Délai avant la prochaine expiration (0 : désarme le timer)
+ * @param intervalMs Période des expirations suivantes (0 : ponctuel)
+ * @return 0 en cas de succès, -1 en cas d'erreur
+ */
+int event_loop_timer_set(event_loop_timer_t *timer, int initialMs, int intervalMs);
+
+/**
+ * @brief Supprime un timer (appelable depuis son propre callback).
+ * @param loop La boucle
+ * @param timer Le timer (NULL accepté)
+ */
+void event_loop_cancel_timer(event_loop_t *loop, event_loop_timer_t *timer);
+
+/**
+ * @brief Poste une tâche à exécuter dans le thread de la boucle (tout thread, sans allocation).
+ * @param loop La boucle
+ * @param task La tâche
+ * @param context Contexte transmis à la tâche
+ * @param data Données copiées avec la tâche (NULL si dataSize vaut 0)
+ * @param dataSize Taille des données, au plus EVENT_LOOP_POST_DATA_SIZE
+ * @return 0 en cas de succès, -1 si la file est pleine ou les données trop grandes
+ */
+int event_loop_post(event_loop_t *loop, event_loop_task_t task, void *context, const void *data, size_t dataSize);
+
+/**
+ * @brief Enregistre une fonction appelée avant chaque attente de la boucle.
+ * @param loop La boucle
+ * @param prepare La fonction
+ * @param context Contexte transmis à la fonction
+ * @return 0 en cas de succès, -1 si EVENT_LOOP_MAX_PREPARE fonctions sont déjà enregistrées
+ */
+int event_loop_add_prepare(event_loop_t *loop, event_loop_prepare_t prepare, void *context);
+
+/**
+ * @brief Retire une fonction de préparation.
+ * @param loop La boucle
+ * @param prepare La fonction
+ * @param context Contexte fourni à event_loop_add_prepare()
+ */
+void event_loop_remove_prepare(event_loop_t *loop, event_loop_prepare_t prepare, void *context);
+
+#endif // EVENT_LOOP_H
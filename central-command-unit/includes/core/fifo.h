@@ -2,7 +2,8 @@
  * @file fifo.h
  * @brief File d'attente FIFO (First In, First Out)
  * Module fournissant une implémentation simple d'une file d'attente FIFO.
- * Implémentation basée sur le principe de liste chaînée.
+ * Implémentation basée sur le principe de liste chaînée, protégée par un verrou propre à chaque file.
+ * @note Pour les files à fort débit (logger, workers), préférer core/ring_buffer.h (bornée, sans allocation ni verrou).
  * @author Lukas Grando
  * @date 2025-10-18
  */
@@ -20,6 +21,7 @@ typedef struct {
 	fifo_node_t *head;
 	fifo_node_t *tail;
 	size_t size;
+	pthread_mutex_t lock; //!< Verrou propre à la file
 } fifo_t;
 
 /**
@@ -36,7 +38,7 @@ bool fifo_is_empty(fifo_t *fifo);
 /**
  * @brief Ajoute un élément à la fin de la file d'attente
  * @param fifo La file d'attente
- * @param data Le pointeur vers les données à ajouter
+ * @param data Le pointeur vers les données à ajouter (NULL est ignoré)
  */
 void fifo_push(fifo_t *fifo, void *data);
 
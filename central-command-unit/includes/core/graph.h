@@ -8,10 +8,18 @@
 
 #include "core/common.h"
 #include "core/check.h"
+#include "core/arena.h"
 
 
+/** Nombre moyen d'arcs par noeud utilisé pour dimensionner l'arène d'un graphe */
+#define GRAPH_EDGES_PER_NODE_HINT 4
+
+/** Capacité initiale d'un chemin lors de sa première croissance */
+#define PATH_INITIAL_CAPACITY 16
+
 #define ERROR_PATH (path_t) { .nodes = NULL, .length = -1 }
 #define EMPTY_PATH (path_t) { .nodes = NULL, .length = 0 }
+#define EMPTY_PATH_IN(a) (path_t) { .nodes = NULL, .length = 0, .arena = (a) }
 
 /**
  * @brief Type de noeud sur la carte.
@@ -63,10 +71,12 @@ struct _Node {
 /**
  * @brief Le graphe complet, représentant la carte.
  * @details Contient un tableau de tous les noeuds du graphe.
+ * Le graphe, ses noeuds et ses arcs sont alloués dans une arène qui lui est propre.
  */
 typedef struct {
     node_t* nodes; //!< Tableau des noeuds du graphe
     int numNodes; //!< Nombre total de noeuds dans le tableau
+    arena_t* arena; //!< Arène contenant le graphe, ses noeuds et ses arcs
 } graph_t;
 
 
@@ -74,16 +84,22 @@ typedef struct {
 
 /**
  * @brief Structure pour retourner le chemin trouvé.
+ * @details Le tableau de noeuds croît par doublement de sa capacité (path_push(), path_append()).
+ * Si arena est renseignée, le tableau y est alloué : il est libéré avec l'arène
+ * et path_destroy() ne fait rien.
  */
 typedef struct {
     node_t** nodes; // Tableau de pointeurs vers les noeuds, dans l'ordre
     int length;     // Nombre de noeuds dans le chemin
+    int capacity;   // Nombre de noeuds pouvant être stockés sans réallocation
+    arena_t* arena; // Arène propriétaire du tableau (NULL : tas)
 } path_t;
 
 
 /**
  * @brief Crée et alloue un nouveau graphe avec un nombre fixe de noeuds.
- * @details Alloue le graphe et le tableau de noeuds. Les noeuds sont initialisés
+ * @details Alloue le graphe et le tableau de noeuds dans une arène dédiée,
+ * dimensionnée pour accueillir aussi les arcs. Les noeuds sont initialisés
  * avec leur ID correspondant à leur index.
  * @param numNodes Le nombre total de noeuds que ce graphe contiendra.
  * @return Pointeur vers le graphe alloué, ou NULL si échec.
@@ -92,7 +108,7 @@ graph_t* graph_create(int numNodes);
 
 /**
  * @brief Détruit le graphe et libère toute la mémoire associée.
- * @details Libère le graphe, le tableau de noeuds, et toutes les arêtes.
+ * @details Libère le graphe, le tableau de noeuds, et toutes les arêtes en détruisant son arène.
  * @param graph Le graphe à détruire.
  */
 void graph_destroy(graph_t* graph);
@@ -129,7 +145,8 @@ node_t* graph_get_node(graph_t* graph, int index);
 
 /**
  * @brief Récupère un pointeur vers un noeud par son ID.
- * @details Parcourt le tableau des noeuds pour trouver celui avec l'ID donné.
+ * @details Les IDs correspondent le plus souvent à l'index du noeud (graph_create) :
+ * ce cas est vérifié en O(1) avant de parcourir le tableau des noeuds.
  * @param graph Le graphe.
  * @param nodeId L'ID du noeud à rechercher.
  * @return Pointeur vers le node_t, ou NULL si l'ID n'existe pas.
@@ -138,13 +155,14 @@ node_t *graph_get_node_by_id(graph_t *graph, int nodeId);
 
 /**
  * @brief Libère la mémoire d'un chemin retourné par Dijkstra.
- * @details (Tu avais déjà ce prototype, voici son implémentation).
+ * @details Sans effet si le chemin est alloué dans une arène.
  */
 void path_destroy(path_t* path);
 
 /**
  * @brief Concatène un chemin (src) à la fin d'un chemin (dest).
- * @details Modifie dest en place en réallouant son tableau de nœuds.
+ * @details Modifie dest en place en réallouant son tableau de nœuds
+ * (dans l'arène de dest si elle en a une).
  * Si le dernier nœud de dest est le même que le premier de src,
  * le doublon est automatiquement supprimé.
  * @param dest Le chemin à étendre (sera modifié).
@@ -153,6 +171,46 @@ void path_destroy(path_t* path);
  */
 void path_append(path_t* dest, const path_t* src);
 
+/**
+ * @brief Garantit qu'un chemin peut contenir au moins minCapacity nœuds.
+ * @details La capacité est au moins doublée à chaque croissance (coût amorti constant).
+ * @param path Le chemin.
+ * @param minCapacity Capacité minimale voulue.
+ * @return true si succès, false en cas d'erreur d'allocation (le chemin est inchangé).
+ */
+bool path_reserve(path_t* path, int minCapacity);
+
+/**
+ * @brief Ajoute un nœud à la fin d'un chemin.
+ * @param path Le chemin.
+ * @param node Le nœud à ajouter.
+ * @return true si succès, false en cas d'erreur d'allocation.
+ */
+bool path_push(path_t* path, node_t* node);
+
+/**
+ * @brief Inverse l'ordre des nœuds d'un chemin, en place.
+ * @param path Le chemin.
+ */
+void path_reverse(path_t* path);
+
+/**
+ * @brief Produit le tableau des IDs des nœuds d'un chemin.
+ * @param path Le chemin.
+ * @param arena Arène dans laquelle allouer le tableau (NULL : tas, à libérer avec free()).
+ * @return Le tableau de path->length IDs, ou NULL si le chemin est vide ou en cas d'erreur.
+ */
+int* path_emit_ids(const path_t* path, arena_t* arena);
+
+/**
+ * @brief Trouve l'arête (orientée) partant d'un nœud vers un autre nœud.
+ * @details Comparaison directe des pointeurs : indépendant des IDs et des index.
+ * @param origin Le nœud d'origine.
+ * @param target Le nœud de destination.
+ * @return Pointeur vers l'edge_t, ou NULL si non trouvée.
+ */
+edge_t* node_get_edge_to(const node_t* origin, const node_t* target);
+
 /**
  * @brief Trouve l'arête (orientée) entre deux nœuds.
  * @param graph Le graphe.
@@ -0,0 +1,88 @@
+/**
+ * @file log_batcher.h
+ * @brief Regroupement des messages de log avant publication (fenêtre temporelle + taille maximale).
+ * @details
+ * Les messages sont accumulés jusqu'à maxEntries entrées ou windowMs millisecondes après le
+ * premier message du lot, puis transmis en une fois à la fonction de publication.
+ * Un message identique (même niveau, même texte) à une entrée du lot en cours n'ajoute pas
+ * d'entrée : le compteur de l'entrée existante est incrémenté.
+ * Les messages ERROR et FATAL provoquent la publication immédiate du lot.
+ * @note Le regroupeur n'est pas protégé : l'appelant sérialise les accès.
+ * @date 2026-10-19
+ */
+#ifndef LOG_BATCHER_H
+#define LOG_BATCHER_H
+
+#include "core/common.h"
+#include "core/logger.h"
+
+#define LOG_BATCHER_MAX_ENTRIES 64 //!< Nombre maximal d'entrées d'un lot
+#define LOG_BATCHER_DEFAULT_ENTRIES 64 //!< Taille de lot par défaut
+#define LOG_BATCHER_DEFAULT_WINDOW_MS 500 //!< Fenêtre de regroupement par défaut (ms)
+
+/**
+ * @brief Entrée d'un lot (message unique ou regroupé).
+ */
+typedef struct {
+	log_level_t level;
+	uint32_t hash; //!< Empreinte du message (comparaison rapide)
+	int count; //!< Nombre d'occurrences dans la fenêtre
+	long firstTimestamp; //!< Première occurrence (secondes)
+	long lastTimestamp; //!< Dernière occurrence (secondes)
+	char message[LOG_MESSAGE_LENGTH];
+} log_batch_entry_t;
+
+/**
+ * @brief Fonction de publication d'un lot.
+ * @param entries Entrées du lot, dans l'ordre de première occurrence
+ * @param count Nombre d'entrées
+ * @param context Contexte fourni à log_batcher_init()
+ */
+typedef void (*log_batch_publish_t)(const log_batch_entry_t *entries, int count, void *context);
+
+typedef struct {
+	log_batch_entry_t entries[LOG_BATCHER_MAX_ENTRIES];
+	int count; //!< Entrées du lot en cours
+	int maxEntries;
+	int windowMs;
+	long windowStartMs; //!< Horodatage du premier message du lot en cours
+	log_batch_publish_t publish;
+	void *context;
+	uint64_t received; //!< Messages reçus
+	uint64_t published; //!< Lots publiés
+} log_batcher_t;
+
+/**
+ * @brief Initialise un regroupeur.
+ * @param batcher Le regroupeur
+ * @param maxEntries Taille maximale d'un lot (bornée à LOG_BATCHER_MAX_ENTRIES, 1 : pas de regroupement)
+ * @param windowMs Durée maximale d'attente d'un lot en millisecondes
+ * @param publish Fonction de publication
+ * @param context Contexte transmis à publish
+ */
+void log_batcher_init(log_batcher_t *batcher, int maxEntries, int windowMs, log_batch_publish_t publish, void *context);
+
+/**
+ * @brief Ajoute un message au lot (publie le lot s'il est plein ou si le message est une erreur).
+ * @param batcher Le regroupeur
+ * @param level Niveau du message
+ * @param message Texte du message
+ * @param nowMs Horodatage courant (ms, horloge monotone)
+ * @param timestamp Horodatage du message (secondes)
+ */
+void log_batcher_add(log_batcher_t *batcher, log_level_t level, const char *message, long nowMs, long timestamp);
+
+/**
+ * @brief Publie le lot en cours si sa fenêtre est écoulée.
+ * @param batcher Le regroupeur
+ * @param nowMs Horodatage courant (ms, horloge monotone)
+ */
+void log_batcher_tick(log_batcher_t *batcher, long nowMs);
+
+/**
+ * @brief Publie le lot en cours (s'il n'est pas vide).
+ * @param batcher Le regroupeur
+ */
+void log_batcher_flush(log_batcher_t *batcher);
+
+#endif // LOG_BATCHER_H
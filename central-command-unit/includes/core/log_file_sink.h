@@ -0,0 +1,137 @@
+/**
+ * @file log_file_sink.h
+ * @brief Écriture des messages de log dans un fichier local, par lots (writev), avec rotation.
+ * @details
+ * Le thread de journalisation ajoute les messages d'un lot (log_file_sink_add()) sans les copier :
+ * seules les en-têtes de ligne (horodatage, niveau) sont formatées dans le journal. Le lot est
+ * ensuite écrit en un seul appel writev() (log_file_sink_commit()).
+ * - rotation par taille (maxBytes) et/ou par durée (rotateIntervalSec) : le fichier courant
+ *   devient path.1, path.1 devient path.2, ... jusqu'à maxFiles archives ;
+ * - synchronisation disque selon fsyncPolicy (les lots contenant une erreur sont toujours
+ *   synchronisés, sauf avec LOG_FSYNC_NEVER) ;
+ * - indépendant du callback : le fichier continue d'être écrit lorsque MQTT est déconnecté.
+ * @note Le journal n'est pas protégé : l'appelant sérialise les accès.
+ * @date 2026-10-19
+ */
+#ifndef LOG_FILE_SINK_H
+#define LOG_FILE_SINK_H
+
+#include "core/common.h"
+#include "core/logger.h"
+#include <sys/uio.h>
+
+#define LOG_FILE_SINK_MAX_LINES 64 //!< Nombre maximal de lignes d'un lot (writev)
+#define LOG_FILE_SINK_PREFIX_LENGTH 48 //!< Taille de l'en-tête d'une ligne ("2026-10-19 12:00:00.123 [WARNING] ")
+#define LOG_FILE_SINK_PATH_LENGTH 256
+#define LOG_FILE_DEFAULT_MAX_FILES 5 //!< Archives conservées par défaut (configuration)
+#define LOG_FILE_DEFAULT_FSYNC_MS 1000 //!< Période de synchronisation par défaut (configuration)
+
+/**
+ * @enum log_fsync_policy_t
+ * @brief Synchronisation du fichier sur le disque.
+ */
+typedef enum {
+	LOG_FSYNC_NEVER,    /**< Laissée au noyau */
+	LOG_FSYNC_BATCH,    /**< Après chaque lot écrit */
+	LOG_FSYNC_INTERVAL, /**< Au plus toutes les fsyncIntervalMs millisecondes (défaut) */
+} log_fsync_policy_t;
+
+typedef struct {
+	char path[LOG_FILE_SINK_PATH_LENGTH]; //!< Fichier courant
+	size_t maxBytes; //!< Taille déclenchant une rotation (0 : aucune)
+	int maxFiles; //!< Nombre d'archives conservées (0 : le fichier est tronqué à la rotation)
+	int rotateIntervalSec; //!< Durée déclenchant une rotation (0 : aucune)
+	log_fsync_policy_t fsyncPolicy;
+	int fsyncIntervalMs; //!< Période de synchronisation pour LOG_FSYNC_INTERVAL
+} log_file_sink_config_t;
+
+typedef struct {
+	log_file_sink_config_t config;
+	int fd; //!< Fichier courant (-1 : fermé, réouverture au prochain lot)
+	size_t fileSize;
+	long openedAtMs; //!< Ouverture du fichier courant (ms, horloge monotone)
+	long lastSyncMs; //!< Dernière synchronisation (ms, horloge monotone)
+	bool dirty; //!< Données écrites depuis la dernière synchronisation
+	bool syncPending; //!< Le lot en cours contient une erreur
+	struct iovec iov[LOG_FILE_SINK_MAX_LINES * 3]; //!< En-tête, message et fin de ligne de chaque ligne
+	int lineCount; //!< Lignes du lot en cours
+	char prefixes[LOG_FILE_SINK_MAX_LINES][LOG_FILE_SINK_PREFIX_LENGTH];
+	time_t cachedSecond; //!< Seconde dont la date est en cache
+	char cachedDate[24]; //!< "AAAA-MM-JJ HH:MM:SS" de cachedSecond
+	uint64_t written; //!< Lignes écrites
+	uint64_t writeErrors; //!< Lots perdus (erreur d'écriture)
+	uint64_t rotations;
+} log_file_sink_t;
+
+/**
+ * @brief Ouvre (en ajout) le fichier d'un journal.
+ * @param sink Le journal
+ * @param config Configuration (copiée)
+ * @return 0 en cas de succès, -1 si le fichier ne peut pas être ouvert
+ */
+int log_file_sink_open(log_file_sink_t *sink, const log_file_sink_config_t *config);
+
+/**
+ * @brief Ajoute une ligne au lot en cours (écrit le lot s'il est plein).
+ * @param sink Le journal
+ * @param level Niveau du message
+ * @param timestampNs Horodatage du message (ns depuis l'epoch)
+ * @param message Texte du message, qui doit rester valide jusqu'à log_file_sink_commit()
+ */
+void log_file_sink_add(log_file_sink_t *sink, log_level_t level, uint64_t timestampNs, const char *message);
+
+/**
+ * @brief Écrit le lot en cours en un appel writev(), puis applique la rotation et la synchronisation.
+ * @param sink Le journal
+ * @param nowMs Horodatage courant (ms, horloge monotone)
+ * @return 0 en cas de succès, -1 si le lot n'a pas pu être écrit
+ */
+int log_file_sink_commit(log_file_sink_t *sink, long nowMs);
+
+/**
+ * @brief Applique la synchronisation périodique et la rotation par durée en l'absence de lot.
+ * @param sink Le journal
+ * @param nowMs Horodatage courant (ms, horloge monotone)
+ */
+void log_file_sink_tick(log_file_sink_t *sink, long nowMs);
+
+/**
+ * @brief Délai avant la prochaine action de log_file_sink_tick().
+ * @param sink Le journal
+ * @param nowMs Horodatage courant (ms, horloge monotone)
+ * @return Délai en millisecondes, ou -1 si aucune action n'est prévue
+ */
+int log_file_sink_next_timeout(const log_file_sink_t *sink, long nowMs);
+
+/**
+ * @brief Effectue une rotation immédiate du fichier.
+ * @param sink Le journal
+ * @param nowMs Horodatage courant (ms, horloge monotone)
+ * @return 0 en cas de succès, -1 si le nouveau fichier ne peut pas être ouvert
+ */
+int log_file_sink_rotate(log_file_sink_t *sink, long nowMs);
+
+/**
+ * @brief Écrit le lot en cours, synchronise et ferme le fichier.
+ * @param sink Le journal
+ */
+void log_file_sink_close(log_file_sink_t *sink);
+
+/**
+ * @brief Convertit un nom de politique ("never", "batch", "interval") en politique.
+ * @param policyStr Le nom
+ * @param policy Politique correspondante
+ * @return 0 en cas de succès, -1 si le nom est inconnu
+ */
+int log_fsync_policy_from_string(const char *policyStr, log_fsync_policy_t *policy);
+
+/**
+ * @brief Écrit aussi tous les messages dans un fichier local, par lots, avec rotation.
+ * @details Le fichier est alimenté par le thread de journalisation (un writev() par lot) et par
+ * les appels synchrones, indépendamment du callback : il reste écrit lorsque MQTT est déconnecté.
+ * @param config Configuration du journal local, ou NULL pour fermer le fichier courant
+ * @return 0 en cas de succès, -1 si le fichier ne peut pas être ouvert
+ */
+int logger_set_file_sink(const log_file_sink_config_t *config);
+
+#endif // LOG_FILE_SINK_H
@@ -0,0 +1,308 @@
+/**
+ * @file log_record.h
+ * @brief Enregistrements de log à formatage différé (identifiant de site + arguments bruts).
+ * @details
+ * Chaque appel LOG_*_DEFERRED déclare à la compilation un descripteur statique (log_site_t)
+ * portant le niveau, la chaîne de format et l'emplacement source. Le producteur ne copie que
+ * les valeurs brutes des arguments, typées via _Generic, sans appeler vsnprintf :
+ * - le thread de journalisation formate l'enregistrement (log_record_format()),
+ * - ou l'écrit tel quel dans un fichier binaire, décodé plus tard par l'outil log-decoder.
+ *
+ * Format du fichier binaire (ordre des octets de la machine) :
+ * - en-tête LOG_RECORD_FILE_MAGIC ;
+ * - entrée site ('S') : id (u32), niveau (u8), ligne (u32), fichier (u16 + octets), format (u16 + octets),
+ *   écrite avant le premier enregistrement du site ;
+ * - entrée enregistrement ('R') : id (u32), horodatage ns (u64), arguments (u16 + octets).
+ *
+ * Arguments : un octet de type (log_arg_type_t) suivi de 8 octets, ou pour une chaîne
+ * d'une longueur (u16) et de ses octets (tronqués à la place restante).
+ * @date 2026-10-19
+ */
+#ifndef LOG_RECORD_H
+#define LOG_RECORD_H
+
+#include "core/common.h"
+#include "core/logger.h"
+
+#define LOG_RECORD_FILE_MAGIC "VPBLOG1\n" //!< En-tête d'un fichier de log binaire (8 octets)
+#define LOG_RECORD_MAX_ARGS 12 //!< Nombre maximal d'arguments d'un appel différé
+#define LOG_RECORD_SITE_ID_MARGIN 64 //!< Écart toléré entre l'identifiant d'un site lu et le nombre de sites déjà lus
+
+/**
+ * @brief Descripteur d'un site d'appel LOG_*_DEFERRED (un par appel, statique).
+ * @note fileId et fileGeneration sont réservés au thread de journalisation.
+ */
+typedef struct {
+	log_level_t level;
+	log_module_t module; //!< Module émetteur (LOG_MODULE du fichier source)
+	uint32_t line;
+	const char *file;
+	const char *format;
+	uint32_t fileId; //!< Identifiant du site dans le fichier binaire courant
+	uint32_t fileGeneration; //!< Fichier binaire pour lequel fileId est valide (0 : aucun)
+} log_site_t;
+
+typedef enum {
+	LOG_ARG_INT = 1,
+	LOG_ARG_UINT,
+	LOG_ARG_DOUBLE,
+	LOG_ARG_STRING,
+	LOG_ARG_POINTER,
+} log_arg_type_t;
+
+/**
+ * @brief Tampon d'écriture des arguments bruts (dans une case de la file du logger).
+ */
+typedef struct {
+	unsigned char *data;
+	size_t length;
+	size_t capacity;
+	void *slot; //!< Case réservée (usage interne du logger)
+} log_args_writer_t;
+
+/**
+ * @brief Argument décodé.
+ */
+typedef struct {
+	log_arg_type_t type;
+	union {
+		int64_t i;
+		uint64_t u;
+		double d;
+	} value;
+	const char *string; //!< LOG_ARG_STRING : octets non terminés par '\0'
+	uint16_t stringLength;
+} log_arg_t;
+
+/**
+ * @brief Enregistrement lu depuis un fichier binaire et formaté.
+ */
+typedef struct {
+	log_level_t level;
+	uint64_t timestampNs;
+	const char *file;
+	uint32_t line;
+	char message[LOG_MESSAGE_LENGTH];
+} log_record_entry_t;
+
+/**
+ * @brief Lecteur de fichier de log binaire.
+ */
+typedef struct {
+	FILE *file;
+	log_site_t *sites; //!< Sites lus, indexés par identifiant
+	uint32_t siteCount;
+	char **strings; //!< Chaînes (fichiers et formats) allouées pour les sites
+	uint32_t stringCount;
+} log_record_reader_t;
+
+// Écriture des arguments (côté producteur, appelées via LOG_ARG_PUT)
+
+static inline void log_args_put_raw(log_args_writer_t *writer, log_arg_type_t type, const void *value) {
+	if(writer->length + 1 + sizeof(uint64_t) > writer->capacity) return;
+	writer->data[writer->length++] = (unsigned char) type;
+	memcpy(writer->data + writer->length, value, sizeof(uint64_t));
+	writer->length += sizeof(uint64_t);
+}
+
+static inline void log_args_put_int(log_args_writer_t *writer, long long value) {
+	int64_t raw = value;
+	log_args_put_raw(writer, LOG_ARG_INT, &raw);
+}
+
+static inline void log_args_put_uint(log_args_writer_t *writer, unsigned long long value) {
+	uint64_t raw = value;
+	log_args_put_raw(writer, LOG_ARG_UINT, &raw);
+}
+
+static inline void log_args_put_double(log_args_writer_t *writer, double value) {
+	log_args_put_raw(writer, LOG_ARG_DOUBLE, &value);
+}
+
+static inline void log_args_put_pointer(log_args_writer_t *writer, const void *value) {
+	uint64_t raw = (uint64_t) (uintptr_t) value;
+	log_args_put_raw(writer, LOG_ARG_POINTER, &raw);
+}
+
+/** @brief Place disponible pour les octets d'une chaîne (après le type et la longueur) */
+static inline size_t log_args_string_room(const log_args_writer_t *writer) {
+	if(writer->length + 1 + sizeof(uint16_t) > writer->capacity) return 0;
+	size_t available = writer->capacity - writer->length - 1 - sizeof(uint16_t);
+	return available > UINT16_MAX ? UINT16_MAX : available;
+}
+
+static inline void log_args_put_bytes(log_args_writer_t *writer, const char *value, size_t length) {
+	if(writer->length + 1 + sizeof(uint16_t) > writer->capacity) return;
+
+	size_t available = log_args_string_room(writer);
+	if(length > available) length = available;
+	uint16_t encoded = (uint16_t) length;
+	writer->data[writer->length++] = (unsigned char) LOG_ARG_STRING;
+	memcpy(writer->data + writer->length, &encoded, sizeof(encoded));
+	writer->length += sizeof(encoded);
+	memcpy(writer->data + writer->length, value, length);
+	writer->length += length;
+}
+
+static inline void log_args_put_string(log_args_writer_t *writer, const char *value) {
+	if(!value) {
+		static const char nullString[] = "(null)";
+		log_args_put_bytes(writer, nullString, sizeof(nullString) - 1);
+		return;
+	}
+	log_args_put_bytes(writer, value, strnlen(value, log_args_string_room(writer)));
+}
+
+/** @brief Copie un argument selon son type statique (les pointeurs non chaîne sont copiés comme %p) */
+#define LOG_ARG_PUT(writer, x) _Generic((x), \
+	_Bool: log_args_put_uint, \
+	char: log_args_put_int, \
+	signed char: log_args_put_int, \
+	unsigned char: log_args_put_uint, \
+	short: log_args_put_int, \
+	unsigned short: log_args_put_uint, \
+	int: log_args_put_int, \
+	unsigned int: log_args_put_uint, \
+	long: log_args_put_int, \
+	unsigned long: log_args_put_uint, \
+	long long: log_args_put_int, \
+	unsigned long long: log_args_put_uint, \
+	float: log_args_put_double, \
+	double: log_args_put_double, \
+	long double: log_args_put_double, \
+	char *: log_args_put_string, \
+	const char *: log_args_put_string, \
+	default: log_args_put_pointer)(writer, x)
+
+// Application de LOG_ARG_PUT à chaque argument (0 à LOG_RECORD_MAX_ARGS)
+#define LOG_PP_CAT_(a, b) a##b
+#define LOG_PP_CAT(a, b) LOG_PP_CAT_(a, b)
+#define LOG_PP_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, N, ...) N
+#define LOG_PP_NARGS(...) LOG_PP_NARGS_(_, ##__VA_ARGS__, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+
+#define LOG_ARGS_PUT_0(w)
+#define LOG_ARGS_PUT_1(w, a) LOG_ARG_PUT(w, a);
+#define LOG_ARGS_PUT_2(w, a, ...) LOG_ARG_PUT(w, a); LOG_ARGS_PUT_1(w, __VA_ARGS__)
+#define LOG_ARGS_PUT_3(w, a, ...) LOG_ARG_PUT(w, a); LOG_ARGS_PUT_2(w, __VA_ARGS__)
+#define LOG_ARGS_PUT_4(w, a, ...) LOG_ARG_PUT(w, a); LOG_ARGS_PUT_3(w, __VA_ARGS__)
+#define LOG_ARGS_PUT_5(w, a, ...) LOG_ARG_PUT(w, a); LOG_ARGS_PUT_4(w, __VA_ARGS__)
+#define LOG_ARGS_PUT_6(w, a, ...) LOG_ARG_PUT(w, a); LOG_ARGS_PUT_5(w, __VA_ARGS__)
+#define LOG_ARGS_PUT_7(w, a, ...) LOG_ARG_PUT(w, a); LOG_ARGS_PUT_6(w, __VA_ARGS__)
+#define LOG_ARGS_PUT_8(w, a, ...) LOG_ARG_PUT(w, a); LOG_ARGS_PUT_7(w, __VA_ARGS__)
+#define LOG_ARGS_PUT_9(w, a, ...) LOG_ARG_PUT(w, a); LOG_ARGS_PUT_8(w, __VA_ARGS__)
+#define LOG_ARGS_PUT_10(w, a, ...) LOG_ARG_PUT(w, a); LOG_ARGS_PUT_9(w, __VA_ARGS__)
+#define LOG_ARGS_PUT_11(w, a, ...) LOG_ARG_PUT(w, a); LOG_ARGS_PUT_10(w, __VA_ARGS__)
+#define LOG_ARGS_PUT_12(w, a, ...) LOG_ARG_PUT(w, a); LOG_ARGS_PUT_11(w, __VA_ARGS__)
+
+/**
+ * @brief Journalise un message à formatage différé.
+ * @details format doit être une chaîne littérale. Les chaînes (%s) sont copiées,
+ * les autres arguments sont copiés par valeur.
+ */
+#define LOG_DEFERRED(lvl, fmt, ...) do { \
+	static log_site_t logSite = { .level = (lvl), .module = LOG_MODULE, .line = __LINE__, .file = __FILE__, .format = (fmt) }; \
+	log_args_writer_t logArgs; \
+	if(logger_module_enabled(LOG_MODULE, (lvl)) && logger_deferred_begin(&logSite, &logArgs)) { \
+		LOG_PP_CAT(LOG_ARGS_PUT_, LOG_PP_NARGS(__VA_ARGS__))(&logArgs, ##__VA_ARGS__) \
+		logger_deferred_commit(&logArgs); \
+	} \
+} while(0)
+
+// Les niveaux sous LOG_COMPILE_LEVEL sont éliminés à la compilation (voir logger.h)
+#if LOG_COMPILE_LEVEL <= 0
+#define LOG_DEBUG_DEFERRED(format, ...)   LOG_DEFERRED(LOG_LEVEL_DEBUG, format, ##__VA_ARGS__)
+#else
+#define LOG_DEBUG_DEFERRED(format, ...)   LOG_DISCARD(LOG_LEVEL_DEBUG, format, ##__VA_ARGS__)
+#endif
+#if LOG_COMPILE_LEVEL <= 1
+#define LOG_INFO_DEFERRED(format, ...)    LOG_DEFERRED(LOG_LEVEL_INFO, format, ##__VA_ARGS__)
+#else
+#define LOG_INFO_DEFERRED(format, ...)    LOG_DISCARD(LOG_LEVEL_INFO, format, ##__VA_ARGS__)
+#endif
+#if LOG_COMPILE_LEVEL <= 2
+#define LOG_WARNING_DEFERRED(format, ...) LOG_DEFERRED(LOG_LEVEL_WARNING, format, ##__VA_ARGS__)
+#else
+#define LOG_WARNING_DEFERRED(format, ...) LOG_DISCARD(LOG_LEVEL_WARNING, format, ##__VA_ARGS__)
+#endif
+#if LOG_COMPILE_LEVEL <= 3
+#define LOG_ERROR_DEFERRED(format, ...)   LOG_DEFERRED(LOG_LEVEL_ERROR, format, ##__VA_ARGS__)
+#else
+#define LOG_ERROR_DEFERRED(format, ...)   LOG_DISCARD(LOG_LEVEL_ERROR, format, ##__VA_ARGS__)
+#endif
+#define LOG_FATAL_DEFERRED(format, ...)   LOG_DEFERRED(LOG_LEVEL_FATAL, format, ##__VA_ARGS__)
+
+/**
+ * @brief Réserve une case pour un appel différé (voir LOG_DEFERRED).
+ * @param site Le site d'appel
+ * @param writer Tampon d'arguments à initialiser
+ * @return true si les arguments doivent être écrits puis logger_deferred_commit() appelé
+ */
+bool logger_deferred_begin(log_site_t *site, log_args_writer_t *writer);
+
+/**
+ * @brief Publie un appel différé réservé avec logger_deferred_begin().
+ * @param writer Le tampon d'arguments rempli
+ */
+void logger_deferred_commit(log_args_writer_t *writer);
+
+/**
+ * @brief Lit l'argument suivant d'un tampon.
+ * @param data Le tampon d'arguments
+ * @param length Taille du tampon
+ * @param offset Position de lecture (avancée)
+ * @param arg Argument à remplir
+ * @return true si un argument a été lu, false à la fin du tampon ou s'il est invalide
+ */
+bool log_args_next(const unsigned char *data, size_t length, size_t *offset, log_arg_t *arg);
+
+/**
+ * @brief Formate un enregistrement comme printf l'aurait fait.
+ * @details Les modificateurs de longueur (hh, h, l, ll, z, ...) sont respectés ; un argument
+ * manquant est remplacé par "<?>". %n n'est pas supporté.
+ * @param format La chaîne de format du site
+ * @param args Tampon d'arguments
+ * @param argsLength Taille du tampon
+ * @param out Chaîne résultat (tronquée si nécessaire)
+ * @param outSize Taille de out
+ * @return La longueur écrite dans out
+ */
+size_t log_record_format(const char *format, const unsigned char *args, size_t argsLength, char *out, size_t outSize);
+
+/**
+ * @brief Écrit l'en-tête d'un fichier binaire.
+ * @return 0 en cas de succès, -1 en cas d'erreur
+ */
+int log_record_write_header(FILE *file);
+
+/**
+ * @brief Écrit l'entrée de description d'un site.
+ * @return 0 en cas de succès, -1 en cas d'erreur
+ */
+int log_record_write_site(FILE *file, uint32_t id, const log_site_t *site);
+
+/**
+ * @brief Écrit un enregistrement.
+ * @return 0 en cas de succès, -1 en cas d'erreur
+ */
+int log_record_write(FILE *file, uint32_t id, uint64_t timestampNs, const unsigned char *args, uint16_t argsLength);
+
+/**
+ * @brief Ouvre un lecteur sur un fichier binaire (vérifie l'en-tête).
+ * @return 0 en cas de succès, -1 si le fichier n'est pas un log binaire
+ */
+int log_record_reader_open(log_record_reader_t *reader, FILE *file);
+
+/**
+ * @brief Lit et formate l'enregistrement suivant.
+ * @param reader Le lecteur
+ * @param entry Enregistrement à remplir
+ * @return 1 si un enregistrement a été lu, 0 en fin de fichier, -1 si le fichier est corrompu
+ */
+int log_record_reader_next(log_record_reader_t *reader, log_record_entry_t *entry);
+
+/**
+ * @brief Libère les ressources du lecteur (ne ferme pas le fichier).
+ */
+void log_record_reader_close(log_record_reader_t *reader);
+
+#endif // LOG_RECORD_H
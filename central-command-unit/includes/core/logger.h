@@ -9,7 +9,7 @@
 #define LOGGER_H
 
 #include "core/common.h"
-#include "fifo.h"
+#include "core/ring_buffer.h"
 
 /**
  * @enum log_level_t
@@ -24,19 +24,84 @@ typedef enum {
     LOG_LEVEL_FATAL,    /**< Messages d'erreur fatale */
 } log_level_t;
 
+/** @brief Nombre de niveaux de journalisation */
+#define LOG_LEVEL_COUNT (LOG_LEVEL_FATAL + 1)
+
+/**
+ * @enum log_module_t
+ * @brief Sous-systèmes dont le niveau de journalisation peut être réglé séparément.
+ * @details Un fichier source choisit son module en définissant LOG_MODULE avant ses #include
+ * (ex : #define LOG_MODULE LOG_MODULE_MQTT), sinon ses messages relèvent de LOG_MODULE_GENERAL.
+ */
+typedef enum {
+    LOG_MODULE_GENERAL,    /**< Messages non rattachés à un sous-système */
+    LOG_MODULE_MQTT,       /**< Client MQTT */
+    LOG_MODULE_CAMERA,     /**< Caméra (socket de données) */
+    LOG_MODULE_UART,       /**< Protocole série vers le véhicule */
+    LOG_MODULE_MARVELMIND, /**< Positionnement Marvelmind */
+    LOG_MODULE_PLANNER,    /**< Planification de trajets */
+    LOG_MODULE_COUNT
+} log_module_t;
+
+/** @brief Niveau d'un module qui suit le niveau global (currentLogLevel) */
+#define LOG_MODULE_INHERIT (-1)
+
+/**
+ * @enum log_overflow_policy_t
+ * @brief Comportement des appels asynchrones lorsque toutes les cases de la file sont occupées.
+ * @note Les messages ERROR et FATAL ne sont jamais perdus : ils attendent toujours une case libre.
+ */
+typedef enum {
+    LOG_OVERFLOW_DROP,  /**< Le message est perdu et comptabilisé (défaut) */
+    LOG_OVERFLOW_BLOCK, /**< L'appelant attend qu'une case se libère */
+} log_overflow_policy_t;
+
+/**
+ * @brief Compteurs cumulés du mode asynchrone (depuis le démarrage du processus).
+ */
+typedef struct {
+    uint64_t written; /**< Messages transmis au callback */
+    uint64_t dropped[LOG_LEVEL_COUNT]; /**< Messages perdus, par niveau */
+    uint64_t blocked; /**< Appels ayant dû attendre une case libre */
+} logger_stats_t;
+
 /**
  * @typedef log_callback_t
  * @brief Fonction de rappel pour la journalisation
  * Permet de définir un traitement personnalisé pour les messages de journalisation.
+ * @note Appelée sans verrou du logger. Les messages journalisés pendant son exécution (ou celle
+ * de log_flush_callback_t), sur le même thread, sont ignorés.
  */
 typedef void (*log_callback_t)(log_level_t level, const char *message);
 
-/** @brief Niveau global de journalisation actuel */
+/**
+ * @typedef log_flush_callback_t
+ * @brief Fonction de vidage périodique, appelée depuis le thread de journalisation.
+ * @param force true à l'arrêt du logger (tout ce qui est en attente doit être publié)
+ */
+typedef void (*log_flush_callback_t)(bool force);
+
+/** @brief Niveau global de journalisation actuel (accès atomique) */
 extern log_level_t currentLogLevel;
 
+/** @brief Niveau propre à chaque module, ou LOG_MODULE_INHERIT (accès atomique) */
+extern int logModuleLevels[LOG_MODULE_COUNT];
+
 /** @brief Longueur maximale d'un message de journalisation */
 #define LOG_MESSAGE_LENGTH 1024
 
+/** @brief Nombre de cases préallouées pour les messages en attente de traitement par le thread asynchrone */
+#define LOG_QUEUE_CAPACITY 1024
+
+/** @brief Longueur maximale d'un message asynchrone (taille d'une case, les messages plus longs sont tronqués) */
+#define LOG_SLOT_MESSAGE_LENGTH 512
+
+/** @brief Pause entre deux tentatives d'un appel en attente d'une case libre (ns) */
+#define LOG_BLOCK_SLEEP_NS 50000
+
+/** @brief Nombre maximal de messages retirés de la file en une fois par le thread asynchrone */
+#define LOG_BATCH_SIZE 64
+
 
 // Mode synchrone
 // En mode synchrone, les messages sont traités immédiatement
@@ -60,10 +125,20 @@ void logger_init(log_level_t level, log_callback_t callback);
  */
 void logger_log_sync(log_level_t level, const char *format, ...);
 
+/**
+ * @brief Journalise un message d'un module en mode synchrone.
+ * @param module Module émetteur (filtré selon son propre niveau, voir logger_set_module_level()).
+ * @param level Niveau de criticité du message.
+ * @param format Chaîne de format (comme le printf).
+ * @param ... Arguments pour le format.
+ */
+void logger_log_module_sync(log_module_t module, log_level_t level, const char *format, ...);
+
 
 // Mode asynchrone
-// En mode asynchrone, les messages sont placés dans une liste FIFO
-// et traités par un thread dédié, permettant aux appels de ne pas bloquer.
+// En mode asynchrone, l'appelant réserve une case préallouée d'une file circulaire sans verrou
+// et y formate le message en place (aucune allocation). Un thread dédié traite les cases par lots.
+// Si toutes les cases sont occupées, la politique de débordement s'applique (voir log_overflow_policy_t).
 
 /**
  * @brief Journalise un message en mode asynchrone.
@@ -71,12 +146,93 @@ void logger_log_sync(log_level_t level, const char *format, ...);
  * @param format Chaîne de format (comme le printf).
  * @param ... Arguments pour le format.
  * @note Cette fonction retourne immédiatement, le message sera traité par le thread de logging.
+ * @note Ignoré si le logger n'est pas initialisé.
  */
 void logger_log_async(log_level_t level, const char *format, ...);
 
+/**
+ * @brief Journalise un message d'un module en mode asynchrone.
+ * @param module Module émetteur (filtré selon son propre niveau, voir logger_set_module_level()).
+ * @param level Niveau de criticité du message.
+ * @param format Chaîne de format (comme le printf).
+ * @param ... Arguments pour le format.
+ */
+void logger_log_module_async(log_module_t module, log_level_t level, const char *format, ...);
+
+/**
+ * @brief Indique si un message d'un module serait journalisé.
+ * @details Une lecture atomique du niveau du module (et du niveau global s'il en hérite) :
+ * utilisable sur les chemins critiques sans verrou ni appel de fonction.
+ * @param module Le module
+ * @param level Niveau du message
+ * @return true si le message passe le filtre d'exécution
+ */
+static inline bool logger_module_enabled(log_module_t module, log_level_t level) {
+    int threshold = __atomic_load_n(&logModuleLevels[module], __ATOMIC_RELAXED);
+    if (threshold == LOG_MODULE_INHERIT) threshold = (int) __atomic_load_n(&currentLogLevel, __ATOMIC_RELAXED);
+    return (int) level >= threshold;
+}
+
+/**
+ * @brief Change le niveau global de journalisation sans réinitialiser le logger.
+ * @param level Le nouveau niveau (les modules qui en héritent le suivent)
+ */
+void logger_set_level(log_level_t level);
+
+/**
+ * @brief Change le niveau de journalisation d'un module.
+ * @param module Le module
+ * @param level Le niveau (log_level_t), ou LOG_MODULE_INHERIT pour suivre le niveau global
+ * @return 0 en cas de succès, -1 si le module ou le niveau est invalide
+ */
+int logger_set_module_level(log_module_t module, int level);
+
+/**
+ * @brief Retourne le niveau effectif d'un module.
+ * @param module Le module
+ * @return Le niveau propre au module, ou le niveau global s'il en hérite
+ */
+log_level_t logger_get_module_level(log_module_t module);
+
+/**
+ * @brief Définit le comportement des appels asynchrones lorsque toutes les cases sont occupées.
+ * @param policy LOG_OVERFLOW_DROP (défaut) ou LOG_OVERFLOW_BLOCK
+ */
+void logger_set_overflow_policy(log_overflow_policy_t policy);
+
+/**
+ * @brief Définit la fonction de vidage appelée par le thread de journalisation.
+ * @details La fonction est appelée avec force = false après chaque lot traité et au moins
+ * toutes les intervalMs millisecondes, puis avec force = true à l'arrêt du logger.
+ * Elle permet à un callback qui regroupe les messages de publier un lot en attente.
+ * @param callback La fonction (NULL : aucune)
+ * @param intervalMs Période maximale entre deux appels (ms, -1 : uniquement après un lot)
+ */
+void logger_set_flush_callback(log_flush_callback_t callback, int intervalMs);
+
+/**
+ * @brief Écrit les appels LOG_*_DEFERRED dans un fichier binaire au lieu de les formater.
+ * @details Le fichier est tronqué puis décodable avec l'outil log-decoder. Les autres
+ * messages continuent d'être transmis au callback.
+ * @param path Chemin du fichier, ou NULL pour fermer le fichier courant et revenir au formatage
+ * @return 0 en cas de succès, -1 si le fichier ne peut pas être ouvert
+ */
+int logger_set_binary_file(const char *path);
+
+/**
+ * @brief Retourne le nombre total de messages asynchrones perdus car la file était pleine.
+ */
+uint64_t logger_dropped_count(void);
+
+/**
+ * @brief Copie les compteurs cumulés du mode asynchrone.
+ * @param stats Structure à remplir
+ */
+void logger_get_stats(logger_stats_t *stats);
+
 /**
  * @brief Libère les ressources du système de journalisation.
- * @note Cette fonction doit être appelée pour nettoyer le thread et les sémaphores.
+ * @note Cette fonction doit être appelée pour nettoyer le thread et la file.
  */
 void logger_destroy(void);
 
@@ -94,18 +250,95 @@ const char* logger_level_to_string(log_level_t level);
  */
 log_level_t logger_string_to_level(const char* levelStr);
 
+/**
+ * @brief Convertit un module en chaîne de caractères.
+ * @param module Le module.
+ * @return Le nom du module (ex : "MQTT").
+ */
+const char* logger_module_to_string(log_module_t module);
+
+/**
+ * @brief Convertit un nom de module (insensible à la casse) en module.
+ * @param moduleStr Le nom du module (ex : "MQTT", "camera").
+ * @param module Module correspondant.
+ * @return 0 en cas de succès, -1 si le nom est inconnu.
+ */
+int logger_string_to_module(const char* moduleStr, log_module_t *module);
+
+
+/**
+ * @def LOG_COMPILE_LEVEL
+ * @brief Niveau minimal compilé (0 : DEBUG, 1 : INFO, 2 : WARNING, 3 : ERROR, 4 : FATAL).
+ * @details Les appels LOG_* d'un niveau inférieur sont remplacés par une expression vide :
+ * ni appel ni évaluation des arguments (le format reste vérifié par le compilateur).
+ * Le filtrage à l'exécution (currentLogLevel) reste actif au-dessus de ce seuil.
+ * Fixé par les profils du Makefile : make debug (0), make release (1).
+ * Un fichier peut le redéfinir avant d'inclure logger.h : les tests du logger le fixent à 0
+ * pour couvrir tous les niveaux, quel que soit le profil de compilation.
+ */
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL 0
+#endif
+
+_Static_assert(LOG_LEVEL_DEBUG == 0 && LOG_LEVEL_INFO == 1 && LOG_LEVEL_WARNING == 2 && LOG_LEVEL_ERROR == 3 && LOG_LEVEL_FATAL == 4,
+    "LOG_COMPILE_LEVEL relies on the numeric values of log_level_t");
+
+/**
+ * @def LOG_MODULE
+ * @brief Module des appels LOG_* du fichier source courant (voir log_module_t).
+ */
+#ifndef LOG_MODULE
+#define LOG_MODULE LOG_MODULE_GENERAL
+#endif
+
+/** @brief Appel éliminé à la compilation (les arguments ne sont pas évalués) */
+#define LOG_DISCARD(level, format, ...) (0 ? logger_log_async(level, format, ##__VA_ARGS__) : (void) 0)
+
+/** @brief Appel filtré par le niveau du module courant avant l'évaluation des arguments */
+#define LOG_MODULE_CALL(function, level, format, ...) \
+    (logger_module_enabled(LOG_MODULE, level) ? function(LOG_MODULE, level, format, ##__VA_ARGS__) : (void) 0)
 
 // Macros pratiques
-#define LOG_DEBUG_SYNC(format, ...)    logger_log_sync(LOG_LEVEL_DEBUG, format, ##__VA_ARGS__)
-#define LOG_INFO_SYNC(format, ...)     logger_log_sync(LOG_LEVEL_INFO, format, ##__VA_ARGS__)
-#define LOG_WARNING_SYNC(format, ...)  logger_log_sync(LOG_LEVEL_WARNING, format, ##__VA_ARGS__)
-#define LOG_ERROR_SYNC(format, ...)    logger_log_sync(LOG_LEVEL_ERROR, format, ##__VA_ARGS__)
-#define LOG_FATAL_SYNC(format, ...)    logger_log_sync(LOG_LEVEL_FATAL, format, ##__VA_ARGS__)
-
-#define LOG_DEBUG_ASYNC(format, ...)   logger_log_async(LOG_LEVEL_DEBUG, format, ##__VA_ARGS__)
-#define LOG_INFO_ASYNC(format, ...)    logger_log_async(LOG_LEVEL_INFO, format, ##__VA_ARGS__)
-#define LOG_WARNING_ASYNC(format, ...) logger_log_async(LOG_LEVEL_WARNING, format, ##__VA_ARGS__)
-#define LOG_ERROR_ASYNC(format, ...)   logger_log_async(LOG_LEVEL_ERROR, format, ##__VA_ARGS__)
-#define LOG_FATAL_ASYNC(format, ...)   logger_log_async(LOG_LEVEL_FATAL, format, ##__VA_ARGS__)
+#if LOG_COMPILE_LEVEL <= 0
+#define LOG_DEBUG_SYNC(format, ...)    LOG_MODULE_CALL(logger_log_module_sync, LOG_LEVEL_DEBUG, format, ##__VA_ARGS__)
+#define LOG_DEBUG_ASYNC(format, ...)   LOG_MODULE_CALL(logger_log_module_async, LOG_LEVEL_DEBUG, format, ##__VA_ARGS__)
+#else
+#define LOG_DEBUG_SYNC(format, ...)    LOG_DISCARD(LOG_LEVEL_DEBUG, format, ##__VA_ARGS__)
+#define LOG_DEBUG_ASYNC(format, ...)   LOG_DISCARD(LOG_LEVEL_DEBUG, format, ##__VA_ARGS__)
+#endif
+
+#if LOG_COMPILE_LEVEL <= 1
+#define LOG_INFO_SYNC(format, ...)     LOG_MODULE_CALL(logger_log_module_sync, LOG_LEVEL_INFO, format, ##__VA_ARGS__)
+#define LOG_INFO_ASYNC(format, ...)    LOG_MODULE_CALL(logger_log_module_async, LOG_LEVEL_INFO, format, ##__VA_ARGS__)
+#else
+#define LOG_INFO_SYNC(format, ...)     LOG_DISCARD(LOG_LEVEL_INFO, format, ##__VA_ARGS__)
+#define LOG_INFO_ASYNC(format, ...)    LOG_DISCARD(LOG_LEVEL_INFO, format, ##__VA_ARGS__)
+#endif
+
+#if LOG_COMPILE_LEVEL <= 2
+#define LOG_WARNING_SYNC(format, ...)  LOG_MODULE_CALL(logger_log_module_sync, LOG_LEVEL_WARNING, format, ##__VA_ARGS__)
+#define LOG_WARNING_ASYNC(format, ...) LOG_MODULE_CALL(logger_log_module_async, LOG_LEVEL_WARNING, format, ##__VA_ARGS__)
+#else
+#define LOG_WARNING_SYNC(format, ...)  LOG_DISCARD(LOG_LEVEL_WARNING, format, ##__VA_ARGS__)
+#define LOG_WARNING_ASYNC(format, ...) LOG_DISCARD(LOG_LEVEL_WARNING, format, ##__VA_ARGS__)
+#endif
+
+#if LOG_COMPILE_LEVEL <= 3
+#define LOG_ERROR_SYNC(format, ...)    LOG_MODULE_CALL(logger_log_module_sync, LOG_LEVEL_ERROR, format, ##__VA_ARGS__)
+#define LOG_ERROR_ASYNC(format, ...)   LOG_MODULE_CALL(logger_log_module_async, LOG_LEVEL_ERROR, format, ##__VA_ARGS__)
+#else
+#define LOG_ERROR_SYNC(format, ...)    LOG_DISCARD(LOG_LEVEL_ERROR, format, ##__VA_ARGS__)
+#define LOG_ERROR_ASYNC(format, ...)   LOG_DISCARD(LOG_LEVEL_ERROR, format, ##__VA_ARGS__)
+#endif
+
+#define LOG_FATAL_SYNC(format, ...)    LOG_MODULE_CALL(logger_log_module_sync, LOG_LEVEL_FATAL, format, ##__VA_ARGS__)
+#define LOG_FATAL_ASYNC(format, ...)   LOG_MODULE_CALL(logger_log_module_async, LOG_LEVEL_FATAL, format, ##__VA_ARGS__)
+
+// Mode différé (LOG_*_DEFERRED) : seules les valeurs brutes sont copiées, le formatage est fait
+// par le thread de journalisation ou hors ligne (voir core/log_record.h)
+#include "core/log_record.h"
+
+// Journal local écrit par lots (voir core/log_file_sink.h)
+#include "core/log_file_sink.h"
 
 #endif // LOGGER_H
@@ -8,6 +8,7 @@
 
 #include "core/logger.h"
 #include "core/mqtt.h"
+#include "core/log_batcher.h"
 #include "core/mqtt_messages/telemetry_message.h"
 
 /**
@@ -19,19 +20,37 @@ void console_log_callback(log_level_t level, const char *message);
 
 /**
  * @brief Callback de log qui écrit sur la console et publie sur MQTT.
+ * @details Les messages sont regroupés (voir log_batcher.h) et publiés sous forme de tableau JSON.
  * @param level Niveau de log.
  * @param message Message à logger.
  * @warning l'appel de mqtt_log_callback_init doit être fait avant d'utiliser ce callback.
  */
 void mqtt_log_callback(log_level_t level, const char *message);
 
+/**
+ * @brief Publie le lot de logs MQTT en attente si sa fenêtre est écoulée (ou immédiatement si force).
+ * @param force Publie le lot quelle que soit sa fenêtre.
+ * @note À enregistrer avec logger_set_flush_callback().
+ */
+void mqtt_log_flush(bool force);
+
 
 /**
  * @brief Initialise les informations nécessaires pour le callback de log MQTT.
  * @param topic Topic MQTT pour les logs.
  * @param clientId ID client MQTT.
+ * @param batchSize Nombre maximal de messages par publication (0 : défaut, 1 : pas de regroupement).
+ * @param batchWindowMs Attente maximale d'un lot en millisecondes (-1 : défaut).
+ */
+void mqtt_log_callback_init(const char* topic, const char* clientId, int batchSize, int batchWindowMs);
+
+/**
+ * @brief Active ou désactive l'affichage console de mqtt_log_callback().
+ * @details Avec un journal local (log_file), la console peut être coupée pour éviter un
+ * printf par ligne (coûteux lorsque la sortie est reprise par journald).
+ * @param enabled true pour afficher les messages sur la console (défaut).
  */
-void mqtt_log_callback_init(const char* topic, const char* clientId);
+void mqtt_log_callback_set_console(bool enabled);
 
 
 #endif // LOGGER_CALLBACKS_H
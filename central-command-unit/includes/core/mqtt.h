@@ -13,9 +13,20 @@
 
 #include "core/common.h"
 #include "core/check.h"
+#include "core/event_loop.h"
+#include "core/mqtt_router.h"
+#include "core/mqtt_payload.h"
+#include "core/mqtt_queue.h"
+#include "core/mqtt_properties.h"
 
 #define MQTT_KEEP_ALIVE_INTERVAL_SEC 60 //!< Intervalle de keep-alive en secondes
 #define MQTT_DEFAULT_TIMEOUT_SEC 5        //!< Timeout par défaut pour les opérations MQTT
+#define MQTT_LOOP_MISC_INTERVAL_MS 1000  //!< Période de maintenance (keep-alive, reconnexion) en mode boucle d'événements
+#define MQTT_LOOP_FLUSH_ATTEMPTS 16      //!< Écritures tentées pour vider la file d'envoi à la déconnexion
+#define MQTT_LOOP_TIMEOUT_MS 1000        //!< Attente max d'une itération du thread réseau
+#define MQTT_RECONNECT_DEFAULT_MIN_MS 1000  //!< Délai avant la première tentative de reconnexion
+#define MQTT_RECONNECT_DEFAULT_MAX_MS 30000 //!< Délai maximal entre deux tentatives de reconnexion
+#define MQTT_TOPIC_ALIAS_MAX 32             //!< Alias de topic attribués au plus par connexion (MQTT v5)
 
 
 /**
@@ -32,16 +43,107 @@ typedef enum{
 	MQTT_QOS_EXACTLY_ONCE = 2
 } mqtt_qos_enum_t;
 
+/**
+ * @brief Versions du protocole MQTT supportées.
+ */
+typedef enum {
+	MQTT_VERSION_3_1_1 = 4, /**< MQTT 3.1.1 (défaut) */
+	MQTT_VERSION_5 = 5      /**< MQTT v5 : propriétés des messages transmises (voir mqtt_properties.h) */
+} mqtt_version_t;
+
+/**
+ * @brief Options d'une publication.
+ */
+typedef struct {
+	mqtt_priority_t priority;     //!< Priorité si le message doit attendre la reconnexion (défaut : commande)
+	mqtt_properties_t properties; //!< Propriétés MQTT v5 (ignorées en MQTT 3.1.1)
+} mqtt_publish_options_t;
+
 /** @brief Pointeur de fonction pour le callback de réception de message. */
 typedef void (*mqtt_message_callback_t)(const char* topic, const char* payload);
 
 /**
  * @brief Définit le callback à appeler lors de la réception d'un message.
- * @details Doit être appelé avant mqtt_connect().
+ * @details Doit être appelé avant mqtt_connect(). Le payload est copié pour être terminé par '\0'.
  * @param callback La fonction à appeler.
  */
 void mqtt_set_message_callback(mqtt_message_callback_t callback);
 
+/**
+ * @brief Pointeur de fonction pour le callback de réception de message, sans copie du payload.
+ * @param topic Topic du message
+ * @param payload Payload, dans le buffer de la bibliothèque MQTT : valide pendant l'appel
+ * seulement (voir mqtt_payload_retain()) et non terminé par '\0' garanti
+ * @param length Taille du payload en octets
+ */
+typedef void (*mqtt_payload_callback_t)(const char* topic, const void* payload, size_t length);
+
+/**
+ * @brief Définit le callback à appeler lors de la réception d'un message, sans copie du payload.
+ * @details Doit être appelé avant mqtt_connect(). Préférable à mqtt_set_message_callback(), qui
+ * copie chaque payload pour le terminer par '\0'.
+ * @param callback La fonction à appeler.
+ */
+void mqtt_set_payload_callback(mqtt_payload_callback_t callback);
+
+/**
+ * @brief Pointeur de fonction pour le traitement des messages de contrôle du core.
+ * @return true si le message a été traité (il n'est alors pas transmis au callback du service).
+ */
+typedef bool (*mqtt_control_handler_t)(const char* topic, const void* payload, size_t length);
+
+/**
+ * @brief Définit le gestionnaire appelé avant le callback du service pour chaque message reçu.
+ * @details Utilisé par le core pour traiter son topic de contrôle (voir service_control.h)
+ * indépendamment du callback défini par le service.
+ * @param handler La fonction à appeler (NULL : aucun).
+ */
+void mqtt_set_control_handler(mqtt_control_handler_t handler);
+
+/**
+ * @brief Définit le routeur auquel les messages reçus sont transmis.
+ * @details Les messages non traités par le gestionnaire de contrôle sont routés, puis transmis
+ * aux callbacks du service s'ils sont définis.
+ * @param router Le routeur (NULL : aucun)
+ */
+void mqtt_set_router(mqtt_router_t *router);
+
+/**
+ * @brief Fait piloter le client par une boucle d'événements au lieu d'un thread réseau dédié.
+ * @details Doit être appelé avant mqtt_connect(). La socket du client est surveillée par la boucle
+ * (mosquitto_loop_read() / mosquitto_loop_write()) et un timer appelle mosquitto_loop_misc() et
+ * gère la reconnexion : les callbacks de message sont alors appelés dans le thread de la boucle.
+ * mqtt_publish() reste appelable depuis n'importe quel thread.
+ * @param loop La boucle (NULL : thread réseau dédié, comportement par défaut)
+ */
+void mqtt_use_event_loop(event_loop_t *loop);
+
+/**
+ * @brief Choisit la version du protocole MQTT.
+ * @details Doit être appelé avant mqtt_connect(). En MQTT v5, les propriétés des publications
+ * (topic de réponse, corrélation, expiration, alias de topic) sont transmises au broker et celles
+ * des messages reçus sont accessibles avec mqtt_message_properties().
+ * @param version La version (défaut : MQTT_VERSION_3_1_1)
+ */
+void mqtt_set_protocol_version(mqtt_version_t version);
+
+/**
+ * @brief Configure la file des publications faites pendant une coupure de connexion.
+ * @details Doit être appelé avant mqtt_connect(). Sans appel, la file est créée avec les valeurs
+ * par défaut (voir mqtt_queue.h), sans fichier de débordement.
+ * @param config La configuration (copiée)
+ */
+void mqtt_set_offline_queue(const mqtt_queue_config_t *config);
+
+/**
+ * @brief Configure les délais de reconnexion après une perte de connexion.
+ * @details Doit être appelé avant mqtt_connect(). Le délai double à chaque échec, de minMs à maxMs,
+ * avec une gigue aléatoire (voir backoff.h), et revient à minMs à chaque connexion réussie.
+ * @param minMs Délai avant la première tentative (0 : MQTT_RECONNECT_DEFAULT_MIN_MS)
+ * @param maxMs Délai maximal (0 : MQTT_RECONNECT_DEFAULT_MAX_MS)
+ */
+void mqtt_set_reconnect_delay(uint32_t minMs, uint32_t maxMs);
+
 /**
  * @brief Initialise et connecte le client MQTT, avec support du LWT.
  * @details Lance la boucle réseau dans un thread séparé.
@@ -70,14 +172,71 @@ void mqtt_disconnect(void);
 
 /**
  * @brief Publie un message sur un topic.
+ * @details Message de priorité commande (voir mqtt_publish_with_options()).
  * @param topic Le topic.
  * @param payload Le message.
  * @param qos Le niveau de QoS à utiliser.
  * @param retain Flag de rétention du message.
- * @return 0 en cas de succès, -1 en cas d'échec.
+ * @return 0 si le message a été publié ou mis en file, -1 s'il est perdu.
  */
 int mqtt_publish(const char* topic, const char* payload, mqtt_qos_enum_t qos, bool retain);
 
+/**
+ * @brief Publie un message sur un topic, avec options.
+ * @details Si le client est déconnecté, ou si des messages publiés pendant une coupure attendent
+ * encore, le message est mis en file (voir mqtt_queue.h) et renvoyé dans l'ordre à la
+ * reconnexion.
+ * @param topic Le topic.
+ * @param payload Le message.
+ * @param length Taille du message en octets.
+ * @param qos Le niveau de QoS à utiliser.
+ * @param retain Flag de rétention du message.
+ * @param options Options de publication (NULL : valeurs par défaut, priorité commande, sans propriétés).
+ * @return 0 si le message a été publié ou mis en file, -1 s'il est perdu.
+ */
+int mqtt_publish_with_options(const char* topic, const void* payload, size_t length, mqtt_qos_enum_t qos, bool retain, const mqtt_publish_options_t *options);
+
+/**
+ * @brief Publie une commande.
+ * @details En MQTT v5, le topic de réponse et l'ID de la commande sont aussi transmis en
+ * propriétés (Response Topic, Correlation Data) et, en QoS 0, le topic est remplacé par un alias.
+ * @param topic Le topic de requête du service destinataire.
+ * @param header L'en-tête de la commande sérialisée dans payload.
+ * @param payload La commande.
+ * @param qos Le niveau de QoS à utiliser.
+ * @return 0 si la commande a été publiée ou mise en file, -1 sinon.
+ */
+int mqtt_publish_command(const char *topic, const command_header_t *header, const char *payload, mqtt_qos_enum_t qos);
+
+/**
+ * @brief Publie la réponse à une commande sur son topic de réponse.
+ * @details En MQTT v5, l'ID de la commande est transmis en données de corrélation.
+ * @param request L'en-tête de la commande reçue.
+ * @param payload La réponse.
+ * @param qos Le niveau de QoS à utiliser.
+ * @return 0 si la réponse a été publiée ou mise en file, -1 sinon (y compris sans topic de réponse).
+ */
+int mqtt_publish_reply(const command_header_t *request, const char *payload, mqtt_qos_enum_t qos);
+
+/**
+ * @brief Retourne les propriétés MQTT v5 du message en cours de livraison dans ce thread.
+ * @details Appelable depuis les handlers de réception (routeur, callbacks, gestionnaire de
+ * contrôle) ; les pointeurs sont valides jusqu'au retour du handler.
+ * @return Les propriétés, ou NULL hors livraison ou en MQTT 3.1.1
+ */
+const mqtt_properties_t *mqtt_message_properties(void);
+
+/**
+ * @brief Copie en chaîne les données de corrélation du message en cours de livraison.
+ * @details Utilisé par les en-têtes de commande pour retrouver l'ID d'une commande ou d'une
+ * réponse publiée en MQTT v5 sans champ commandId dans son JSON.
+ * @param buffer Destination, terminée par '\0'
+ * @param size Taille de la destination
+ * @return 0 en cas de succès, -1 si le message n'a pas de données de corrélation ou si elles ne
+ * tiennent pas dans buffer
+ */
+int mqtt_message_correlation_string(char *buffer, size_t size);
+
 /**
  * @brief S'abonne à un topic.
  * @param topic Le topic.
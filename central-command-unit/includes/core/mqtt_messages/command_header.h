@@ -14,6 +14,7 @@
  #define COMMAND_HEADER_H
 
 #include "core/check.h"
+#include "core/command_id.h"
 #include "cJSON.h"
 
 #define ACTION_LENGTH 64
@@ -33,7 +34,8 @@ typedef struct {
  * @param action Chaîne représentant l'action de la commande.
  * @param replyTopic Chaîne représentant le topic de réponse.
  * @return Structure d'en-tête de commande initialisée.
- * @note la fonction génère un UUID pour commandId et initialise le timestamp courant.
+ * @note la fonction génère un ID unique pour commandId ("<action>-<16 hex>", voir command_id.h)
+ * et initialise le timestamp courant.
  */
 command_header_t create_command_header(const char *action, const char *replyTopic);
 /**
@@ -48,6 +50,8 @@ int command_header_serialize(const command_header_t *header, cJSON *root);
 /**
  * @brief Remplit une structure d'en-tête à partir d'un objet cJSON.
  * @details Lit les clés "command_id", "action", "timestamp" depuis l'objet JSON racine.
+ * Pendant la livraison d'un message MQTT v5, "commandId" et "replyTopic" peuvent être omis :
+ * les propriétés Correlation Data et Response Topic du message sont alors utilisées.
  * @param root Pointeur vers l'objet cJSON racine contenant les données de l'en-tête.
  * @param header Pointeur vers la structure d'en-tête à remplir.
  * @return 0 en cas de succès, -1 si un champ est manquant ou du mauvais type.
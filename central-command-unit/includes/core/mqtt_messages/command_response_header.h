@@ -61,7 +61,8 @@ char *command_response_header_serialize(const command_response_header_t *header)
 /**
  * @brief Remplit une structure d'en-tête de réponse à partir d'un objet cJSON.
  * @details Lit les clés "command_id", "success", "error_message" (si échec),
- * "timestamp_s", "timestamp_ns".
+ * "timestamp_s", "timestamp_ns". Pendant la livraison d'un message MQTT v5, "commandId" peut
+ * être omis : les données de corrélation du message sont alors utilisées.
  * @param root Pointeur vers l'objet cJSON racine.
  * @param header Pointeur vers la structure d'en-tête de réponse à remplir.
  * @return 0 en cas de succès, -1 si un champ est manquant/mauvais type.
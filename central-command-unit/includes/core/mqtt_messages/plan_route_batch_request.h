@@ -0,0 +1,58 @@
+/**
+ * @file plan_route_batch_request.h
+ * @brief Définitions du modèle de données pour les requêtes de planification de trajets par lot.
+ * @details
+ * Une requête de lot regroupe plusieurs couples (véhicule, arrêts) traités en une seule commande.
+ * Le route-planner répond par une unique plan_route_batch_response_t.
+ * @date 2026-10-19
+ */
+
+#ifndef PLAN_ROUTE_BATCH_REQUEST_H
+#define PLAN_ROUTE_BATCH_REQUEST_H
+
+#include "core/check.h"
+#include "core/mqtt_messages/command_header.h"
+#include <cJSON.h>
+
+#define PLAN_ROUTE_BATCH_MAX_ENTRIES 1024 //!< Nombre maximal d'entrées acceptées dans un lot
+
+typedef struct {
+	int carId; /**< ID du véhicule concerné (repris tel quel dans le résultat) */
+	int *nodeIds; /**< Arrêts à relier, dans l'ordre de passage demandé */
+	int nodeCount; /**< Nombre d'arrêts */
+	bool optimizeOrder; /**< Réordonne les arrêts pour minimiser la distance (optionnel) */
+	bool keepLastStop; /**< Conserve le dernier arrêt en dernière position lors de l'optimisation (optionnel) */
+} plan_route_batch_entry_t;
+
+typedef struct {
+	command_header_t header;
+	plan_route_batch_entry_t *entries; /**< Entrées du lot */
+	int entryCount; /**< Nombre d'entrées */
+	bool includePath; /**< Renvoie la liste des noeuds de chaque trajet (optionnel, vrai par défaut). Faux : coûts seuls */
+} plan_route_batch_request_t;
+
+/**
+ * @brief Sérialise une requête de planification par lot en JSON.
+ * @param msg Pointeur vers la requête à sérialiser.
+ * @return Chaîne JSON représentant la requête, ou NULL en cas d'erreur.
+ * @warning La mémoire allouée pour la chaîne JSON doit être libérée par l'appelant.
+ */
+char *plan_route_batch_request_serialize(const plan_route_batch_request_t *msg);
+
+/**
+ * @brief Désérialise les données d'une requête de planification par lot.
+ * @details Alloue msg->entries et le tableau nodeIds de chaque entrée.
+ * @param root Pointeur vers l'objet cJSON racine.
+ * @param msg Pointeur vers la structure à remplir.
+ * @warning Cette fonction s'occupe uniquement de désérialiser les données. Le header doit être désérialisé séparément.
+ * @return 0 en cas de succès, -1 en cas d'erreur (rien n'est alloué dans ce cas).
+ */
+int plan_route_batch_request_data_deserialize(cJSON *root, plan_route_batch_request_t *msg);
+
+/**
+ * @brief Libère la mémoire allouée pour une requête de planification par lot.
+ * @param msg Pointeur vers la requête à libérer
+ */
+void plan_route_batch_request_destroy(plan_route_batch_request_t *msg);
+
+#endif // PLAN_ROUTE_BATCH_REQUEST_H
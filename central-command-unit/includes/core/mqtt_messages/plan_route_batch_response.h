@@ -0,0 +1,56 @@
+/**
+ * @file plan_route_batch_response.h
+ * @brief Définitions du modèle de données pour les réponses de planification de trajets par lot.
+ * @details
+ * La réponse agrège un résultat par entrée du lot, dans l'ordre de la requête.
+ * L'en-tête n'est en échec que si le lot entier n'a pas pu être traité :
+ * les échecs partiels sont reportés entrée par entrée (success / errorMessage).
+ * @date 2026-10-19
+ */
+
+#ifndef PLAN_ROUTE_BATCH_RESPONSE_H
+#define PLAN_ROUTE_BATCH_RESPONSE_H
+
+#include "core/check.h"
+#include "core/mqtt_messages/command_response_header.h"
+
+typedef struct {
+	int carId; /**< ID du véhicule de l'entrée correspondante */
+	bool success; /**< Statut du calcul de cette entrée */
+	char errorMessage[MAX_ERROR_MSG_LEN]; /**< Message d'erreur (pertinent si success == false) */
+	double cost; /**< Coût total du trajet */
+	double savedDistance; /**< Distance économisée par l'optimisation de l'ordre des arrêts (0 si non demandée) */
+	int *nodeIds; /**< Noeuds du trajet (NULL si non demandés ou en cas d'échec) */
+	int nodeCount; /**< Nombre de noeuds du trajet */
+} plan_route_batch_result_t;
+
+typedef struct {
+	command_response_header_t header; /**< En-tête de la commande de réponse */
+	plan_route_batch_result_t *results; /**< Un résultat par entrée de la requête */
+	int resultCount; /**< Nombre de résultats */
+} plan_route_batch_response_t;
+
+/**
+ * @brief Sérialise une réponse de planification par lot en JSON.
+ * @details Ajoute "failedCount", le nombre d'entrées en échec.
+ * @param msg Pointeur vers la structure à sérialiser.
+ * @return Chaîne JSON allouée (à libérer par l'appelant), ou NULL en cas d'erreur.
+ */
+char *plan_route_batch_response_serialize(const plan_route_batch_response_t *msg);
+
+/**
+ * @brief Désérialise les résultats d'une réponse de planification par lot.
+ * @details Alloue msg->results et le tableau nodeIds de chaque résultat.
+ * @param root L'objet cJSON racine (déjà parsé).
+ * @param msg Pointeur vers la structure à remplir.
+ * @return 0 en cas de succès, -1 en cas d'erreur (rien n'est alloué dans ce cas).
+ */
+int plan_route_batch_response_data_deserialize(const cJSON *root, plan_route_batch_response_t *msg);
+
+/**
+ * @brief Libère la mémoire allouée pour une réponse de planification par lot.
+ * @param msg Pointeur vers la réponse à libérer
+ */
+void plan_route_batch_response_destroy(plan_route_batch_response_t *msg);
+
+#endif // PLAN_ROUTE_BATCH_RESPONSE_H
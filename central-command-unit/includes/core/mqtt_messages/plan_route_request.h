@@ -19,6 +19,8 @@ typedef struct {
 	int carId;
 	int *nodeIds;
 	int nodeCount;
+	bool optimizeOrder; // Réordonne les arrêts pour minimiser la distance (optionnel)
+	bool keepLastStop; // Conserve le dernier arrêt en dernière position lors de l'optimisation (optionnel)
 } plan_route_request_t;
 
 /**
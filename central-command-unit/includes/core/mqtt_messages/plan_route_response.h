@@ -17,6 +17,7 @@ typedef struct {
 	int *nodeIds; /**< Liste des IDs de nœuds représentant la route planifiée */
 	int nodeCount; /**< Nombre de nœuds dans la route planifiée */
 	int carId;  /**< ID du véhicule pour lequel la route a été planifiée */
+	double savedDistance; /**< Distance économisée par l'optimisation de l'ordre des arrêts (0 si non demandée) */
 } plan_route_response_t;
 
 /**
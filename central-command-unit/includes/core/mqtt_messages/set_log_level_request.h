@@ -0,0 +1,46 @@
+/**
+ * @file set_log_level_request.h
+ * @brief Définitions du modèle de données pour la commande SET_LOG_LEVEL.
+ * @details
+ * Adressé à : tous les services (topic services/<client_id>/control)
+ * La commande est envoyée pour changer à chaud le niveau de journalisation du service,
+ * globalement ou pour un seul module (MQTT, CAMERA, UART, MARVELMIND, PLANNER, GENERAL).
+ */
+
+#ifndef SET_LOG_LEVEL_REQUEST_H
+#define SET_LOG_LEVEL_REQUEST_H
+
+#include "core/mqtt_messages/command_header.h"
+#include "core/logger.h"
+#include "core/check.h"
+#include "cJSON.h"
+
+/** @brief Valeur du champ "level" qui rend un module au niveau global */
+#define SET_LOG_LEVEL_INHERIT "INHERIT"
+
+typedef struct {
+	command_header_t header;
+	bool hasModule; //!< false : le niveau global est modifié
+	log_module_t module;
+	int level; //!< log_level_t, ou LOG_MODULE_INHERIT (uniquement avec un module)
+} set_log_level_request_t;
+
+/**
+ * @brief Sérialise un message de changement de niveau de journalisation en JSON.
+ * @param msg Pointeur vers le message à sérialiser.
+ * @return Chaîne JSON représentant le message
+ * @warning La mémoire allouée pour la chaîne JSON doit être libérée par l'appelant.
+ */
+char *set_log_level_request_serialize(const set_log_level_request_t *msg);
+
+/**
+ * @brief Désérialise un message de changement de niveau de journalisation à partir d'une chaîne JSON.
+ * @details Champs : "level" (DEBUG, INFO, WARNING, ERROR, FATAL ou INHERIT) et "module" (optionnel).
+ * @param root Pointeur vers l'objet cJSON représentant le message.
+ * @param msg Pointeur vers la structure de message à remplir.
+ * @return 0 en cas de succès, -1 en cas d'erreur (champ manquant, module ou niveau inconnu).
+ * @warning Cette fonction s'occupe uniquement de désérialiser les données. Le header doit être désérialisé séparément.
+ */
+int set_log_level_request_data_deserialize(cJSON *root, set_log_level_request_t *msg);
+
+#endif // SET_LOG_LEVEL_REQUEST_H
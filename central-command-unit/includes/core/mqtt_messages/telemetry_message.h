@@ -22,6 +22,8 @@ typedef struct
 	long timestamp; /**< Timestamp du message */
 	log_level_t level; /**< Niveau de log */
 	char *message; /**< Contenu du message */
+	int count; /**< Nombre d'occurrences regroupées (0 ou 1 : message unique) */
+	long lastTimestamp; /**< Timestamp de la dernière occurrence (si count > 1) */
 } telemetry_message_t;
 
 /**
@@ -32,6 +34,16 @@ typedef struct
  */
 char *telemetry_message_serialize_json(const telemetry_message_t *msg);
 
+/**
+ * @brief Sérialise un lot de messages de télémétrie en un tableau JSON.
+ * @details Les champs "count" et "lastTimestamp" sont ajoutés aux messages regroupés (count > 1).
+ * @param msgs Tableau des messages.
+ * @param count Nombre de messages.
+ * @return Chaîne JSON représentant le tableau
+ * @warning La mémoire allouée pour la chaîne JSON doit être libérée par l'appelant.
+ */
+char *telemetry_message_array_serialize_json(const telemetry_message_t *msgs, int count);
+
 /**
  * @brief Désérialise un message de télémétrie à partir d'une chaîne JSON.
  * @param json Chaîne JSON représentant le message de télémétrie.
@@ -0,0 +1,77 @@
+/**
+ * @file mqtt_payload.h
+ * @brief Conservation des payloads MQTT reçus au-delà de leur callback, sans copie.
+ * @details
+ * Les payloads sont transmis aux handlers directement depuis le buffer de la bibliothèque MQTT,
+ * valide uniquement pendant l'appel. Un handler qui doit confier le payload à un autre thread le
+ * retient avec mqtt_payload_retain() : pendant la livraison du message, le buffer est détaché de
+ * la bibliothèque (qui ne le libère plus) au lieu d'être copié. Le payload retenu est compté par
+ * références : chaque mqtt_payload_retain() ou mqtt_payload_ref() est équilibré par un
+ * mqtt_payload_release(), et mqtt_payload_steal() récupère le buffer lui-même quand il n'est plus
+ * partagé.
+ * @date 2026-10-19
+ */
+#ifndef CORE_MQTT_PAYLOAD_H
+#define CORE_MQTT_PAYLOAD_H
+
+#include "core/common.h"
+
+/**
+ * @brief Payload reçu, retenu par un ou plusieurs propriétaires.
+ * @note data et length sont en lecture seule.
+ */
+typedef struct mqtt_payload {
+	void *data;    //!< Contenu (non terminé par '\0' garanti)
+	size_t length; //!< Taille du contenu en octets
+	int refs;      //!< Nombre de références (atomique)
+} mqtt_payload_t;
+
+/**
+ * @brief Retient un payload reçu au-delà du retour de son handler.
+ * @details Si payload est le buffer du message en cours de livraison dans ce thread, il est
+ * détaché de la bibliothèque MQTT sans copie (les appels suivants pour le même message partagent
+ * le même mqtt_payload_t). Sinon, le contenu est copié.
+ * @param payload Le payload reçu par le handler
+ * @param length Sa taille en octets
+ * @return Le payload retenu (à libérer avec mqtt_payload_release()), ou NULL en cas d'erreur d'allocation
+ */
+mqtt_payload_t *mqtt_payload_retain(const void *payload, size_t length);
+
+/**
+ * @brief Ajoute une référence à un payload retenu (ex : avant de le confier à un second thread).
+ * @param payload Le payload
+ * @return Le payload
+ */
+mqtt_payload_t *mqtt_payload_ref(mqtt_payload_t *payload);
+
+/**
+ * @brief Libère une référence ; le payload est libéré avec la dernière.
+ * @param payload Le payload (NULL accepté)
+ */
+void mqtt_payload_release(mqtt_payload_t *payload);
+
+/**
+ * @brief Récupère le buffer d'un payload retenu et libère la référence de l'appelant.
+ * @details Sans copie si l'appelant détient la dernière référence ; sinon le contenu est copié.
+ * @param payload Le payload
+ * @param length Taille du buffer retourné (NULL accepté)
+ * @return Le buffer (à libérer avec free()), ou NULL en cas d'erreur d'allocation
+ */
+void *mqtt_payload_steal(mqtt_payload_t *payload, size_t *length);
+
+/**
+ * @brief Déclare le message dont les handlers sont en cours d'appel dans ce thread.
+ * @details Réservé au client MQTT. Le buffer pointé par slot peut être détaché (*slot passe à
+ * NULL) par un mqtt_payload_retain() avant mqtt_payload_delivery_end().
+ * @param slot Emplacement du buffer dans le message de la bibliothèque MQTT
+ * @param length Taille du buffer
+ */
+void mqtt_payload_delivery_begin(void **slot, size_t length);
+
+/**
+ * @brief Termine la livraison déclarée par mqtt_payload_delivery_begin().
+ * @details Libère la référence de la livraison si le buffer a été retenu.
+ */
+void mqtt_payload_delivery_end(void);
+
+#endif // CORE_MQTT_PAYLOAD_H
@@ -0,0 +1,28 @@
+/**
+ * @file mqtt_properties.h
+ * @brief Propriétés MQTT v5 d'un message publié ou reçu.
+ * @details
+ * Ces propriétés ne sont transmises que si le client est connecté en MQTT v5 (voir
+ * mqtt_set_protocol_version()) ; en MQTT 3.1.1 elles sont ignorées à la publication et absentes
+ * à la réception. Les messages JSON conservent donc leurs champs commandId et replyTopic.
+ * @date 2026-10-19
+ */
+#ifndef CORE_MQTT_PROPERTIES_H
+#define CORE_MQTT_PROPERTIES_H
+
+#include "core/common.h"
+
+#define MQTT_CORRELATION_DATA_MAX_LENGTH UINT16_MAX //!< Taille maximale des données de corrélation (protocole)
+
+/**
+ * @brief Propriétés MQTT v5 d'un message.
+ */
+typedef struct {
+	const char *responseTopic;   //!< Topic sur lequel répondre (NULL : aucun)
+	const void *correlationData; //!< Données reliant une réponse à sa requête (NULL : aucune)
+	size_t correlationLength;    //!< Taille des données de corrélation en octets
+	uint32_t messageExpirySec;   //!< Durée de validité du message, au-delà le broker le supprime (0 : illimitée)
+	bool topicAlias;             //!< Publication : remplacer le topic par un alias numérique (QoS 0 uniquement)
+} mqtt_properties_t;
+
+#endif // CORE_MQTT_PROPERTIES_H
@@ -0,0 +1,144 @@
+/**
+ * @file mqtt_queue.h
+ * @brief File des publications MQTT en attente pendant une coupure de connexion.
+ * @details
+ * Les messages publiés pendant que le client est déconnecté sont conservés en mémoire, dans
+ * deux files FIFO selon leur priorité, puis renvoyés dans l'ordre à la reconnexion :
+ * - les commandes et réponses (MQTT_PRIORITY_COMMAND) sont renvoyées en premier ;
+ * - la télémétrie (MQTT_PRIORITY_TELEMETRY : état des véhicules, logs) ensuite.
+ * La file est bornée en nombre de messages et en octets. Quand elle est pleine :
+ * - la télémétrie la plus ancienne est supprimée en premier (elle est remplacée par des données
+ *   plus récentes) ;
+ * - une commande QoS 0 est refusée, une commande QoS 1/2 est écrite dans le fichier de
+ *   débordement s'il est configuré, sinon elle remplace la commande QoS 0 la plus ancienne.
+ * Tant que le fichier de débordement contient des commandes, les nouvelles commandes y sont
+ * ajoutées pour conserver leur ordre. Il est vidé à la reconnexion, et tronqué à l'ouverture :
+ * il soulage la mémoire pendant une coupure mais ne survit pas à un redémarrage du service.
+ * Les propriétés MQTT v5 des messages sont conservées ; un message dont la durée de validité
+ * (messageExpirySec) est écoulée au moment du vidage est supprimé au lieu d'être renvoyé.
+ * @note Thread-safe. Le callback d'envoi est appelé verrou pris : il ne doit ni publier ni
+ * attendre le thread de journalisation (LOG_*_SYNC).
+ * @date 2026-10-19
+ */
+#ifndef CORE_MQTT_QUEUE_H
+#define CORE_MQTT_QUEUE_H
+
+#include "core/common.h"
+#include "core/mqtt_properties.h"
+
+#define MQTT_QUEUE_DEFAULT_MAX_MESSAGES 1024      //!< Messages conservés en mémoire par défaut
+#define MQTT_QUEUE_DEFAULT_MAX_BYTES (1024 * 1024) //!< Octets conservés en mémoire par défaut
+#define MQTT_QUEUE_PATH_LENGTH 256
+
+/**
+ * @enum mqtt_priority_t
+ * @brief Priorité d'un message publié, utilisée lorsqu'il doit attendre la reconnexion.
+ */
+typedef enum {
+	MQTT_PRIORITY_COMMAND,   /**< Commandes et réponses : renvoyées en premier, jamais supprimées au profit de la télémétrie */
+	MQTT_PRIORITY_TELEMETRY, /**< État, logs : renvoyés après les commandes, les plus anciens sont supprimés en premier */
+	MQTT_PRIORITY_COUNT
+} mqtt_priority_t;
+
+typedef struct {
+	size_t maxMessages; //!< Messages conservés en mémoire (0 : MQTT_QUEUE_DEFAULT_MAX_MESSAGES)
+	size_t maxBytes;    //!< Octets de payload conservés en mémoire (0 : MQTT_QUEUE_DEFAULT_MAX_BYTES)
+	char spoolPath[MQTT_QUEUE_PATH_LENGTH]; //!< Fichier de débordement des commandes QoS 1/2 (vide : aucun)
+} mqtt_queue_config_t;
+
+/**
+ * @brief Message en attente.
+ */
+typedef struct mqtt_queued_message {
+	char *topic;
+	void *payload;
+	size_t length;
+	int qos;
+	bool retain;
+	mqtt_priority_t priority;
+	mqtt_properties_t properties; //!< Propriétés v5 (au vidage, messageExpirySec est la validité restante)
+	long expiresAtMs;             //!< Échéance de validité (ms, horloge monotone ; 0 : aucune)
+	struct mqtt_queued_message *next;
+} mqtt_queued_message_t;
+
+/**
+ * @brief Résultat de mqtt_queue_push().
+ */
+typedef enum {
+	MQTT_QUEUE_QUEUED,   /**< Conservé en mémoire */
+	MQTT_QUEUE_SPOOLED,  /**< Écrit dans le fichier de débordement */
+	MQTT_QUEUE_EVICTED,  /**< Conservé, au prix d'un message plus ancien supprimé */
+	MQTT_QUEUE_DROPPED,  /**< Refusé (file pleine ou erreur) */
+} mqtt_queue_result_t;
+
+typedef struct {
+	mqtt_queue_config_t config;
+	mqtt_queued_message_t *head[MQTT_PRIORITY_COUNT];
+	mqtt_queued_message_t *tail[MQTT_PRIORITY_COUNT];
+	size_t count;       //!< Messages en mémoire
+	size_t bytes;       //!< Octets de payload en mémoire
+	int spoolFd;        //!< Fichier de débordement (-1 : aucun)
+	off_t spoolRead;    //!< Position du prochain message à relire
+	off_t spoolWrite;   //!< Fin du fichier
+	size_t spoolCount;  //!< Messages dans le fichier
+	size_t dropped;     //!< Messages supprimés ou refusés depuis l'initialisation
+	pthread_mutex_t lock;
+} mqtt_queue_t;
+
+/**
+ * @brief Callback d'envoi d'un message en attente.
+ * @return 0 si le message a été transmis, -1 pour interrompre le vidage (message conservé)
+ */
+typedef int (*mqtt_queue_send_t)(const mqtt_queued_message_t *message, void *context);
+
+/**
+ * @brief Initialise une file.
+ * @param queue La file
+ * @param config Configuration (NULL : valeurs par défaut, sans fichier de débordement)
+ * @return 0 en cas de succès, -1 si le fichier de débordement ne peut pas être ouvert (la file
+ * reste utilisable, en mémoire seulement)
+ */
+int mqtt_queue_init(mqtt_queue_t *queue, const mqtt_queue_config_t *config);
+
+/**
+ * @brief Libère les messages en attente et ferme le fichier de débordement.
+ * @param queue La file
+ */
+void mqtt_queue_destroy(mqtt_queue_t *queue);
+
+/**
+ * @brief Met un message en attente (topic, payload et propriétés sont copiés).
+ * @param queue La file
+ * @param topic Topic du message
+ * @param payload Payload du message
+ * @param length Taille du payload en octets
+ * @param qos QoS du message
+ * @param retain Flag de rétention
+ * @param priority Priorité du message
+ * @param properties Propriétés MQTT v5 (NULL : aucune)
+ * @return Le sort du message (voir mqtt_queue_result_t)
+ */
+mqtt_queue_result_t mqtt_queue_push(mqtt_queue_t *queue, const char *topic, const void *payload, size_t length, int qos, bool retain,
+	mqtt_priority_t priority, const mqtt_properties_t *properties);
+
+/**
+ * @brief Renvoie les messages en attente dans l'ordre : commandes en mémoire, commandes du fichier
+ * de débordement, puis télémétrie. Les messages expirés sont supprimés sans être transmis.
+ * @param queue La file
+ * @param send Callback d'envoi ; le vidage s'arrête au premier échec
+ * @param context Contexte transmis au callback
+ * @return Le nombre de messages transmis
+ */
+size_t mqtt_queue_drain(mqtt_queue_t *queue, mqtt_queue_send_t send, void *context);
+
+/**
+ * @brief Retourne le nombre de messages en attente (fichier de débordement compris).
+ */
+size_t mqtt_queue_count(mqtt_queue_t *queue);
+
+/**
+ * @brief Retourne le nombre de messages supprimés (file pleine ou expirés) ou refusés depuis l'initialisation.
+ */
+size_t mqtt_queue_dropped(mqtt_queue_t *queue);
+
+#endif // CORE_MQTT_QUEUE_H
@@ -0,0 +1,100 @@
+/**
+ * @file mqtt_router.h
+ * @brief Routage des messages MQTT reçus vers des handlers enregistrés au démarrage.
+ * @details
+ * Les services enregistrent des filtres de topic MQTT (niveaux exacts, jokers '+' et '#') associés :
+ * - soit à un handler de topic, appelé avec le payload brut (sans copie) ;
+ * - soit à des handlers d'action : le payload est alors parsé une seule fois, son en-tête de
+ *   commande désérialisé et le handler choisi d'après header.action.
+ * Les filtres sont compilés dans un arbre (un noeud par niveau, fils indexés par une table de
+ * hachage) : le coût d'un routage dépend du nombre de niveaux du topic, pas du nombre de routes.
+ * Les topics commençant par '$' ne sont pas captés par un joker au premier niveau (comme MQTT).
+ * @warning Les routes doivent être enregistrées avant de s'abonner aux topics concernés :
+ * l'enregistrement n'est pas protégé contre un routage simultané.
+ * @date 2026-10-19
+ */
+#ifndef CORE_MQTT_ROUTER_H
+#define CORE_MQTT_ROUTER_H
+
+#include "core/common.h"
+#include "core/mqtt_messages/command_header.h"
+
+/**
+ * @brief Handler appelé pour un message dont le topic correspond au filtre.
+ * @param topic Topic du message
+ * @param payload Payload du message, valide pendant l'appel seulement (voir mqtt_payload_retain())
+ * et non terminé par '\0' garanti
+ * @param length Taille du payload en octets
+ * @param context Contexte fourni à l'enregistrement
+ */
+typedef void (*mqtt_route_handler_t)(const char *topic, const void *payload, size_t length, void *context);
+
+/**
+ * @brief Handler appelé pour une commande dont l'action correspond.
+ * @param topic Topic du message
+ * @param header En-tête de la commande
+ * @param root JSON du message (libéré après l'appel)
+ * @param context Contexte fourni à l'enregistrement
+ */
+typedef void (*mqtt_action_handler_t)(const char *topic, const command_header_t *header, cJSON *root, void *context);
+
+typedef struct mqtt_router mqtt_router_t;
+
+/**
+ * @brief Crée un routeur vide.
+ * @return Le routeur, ou NULL en cas d'erreur d'allocation
+ */
+mqtt_router_t *mqtt_router_create(void);
+
+/**
+ * @brief Libère un routeur et ses routes.
+ * @param router Le routeur (NULL accepté)
+ */
+void mqtt_router_destroy(mqtt_router_t *router);
+
+/**
+ * @brief Associe un handler à un filtre de topic.
+ * @param router Le routeur
+ * @param filter Filtre de topic MQTT (ex : "vehicles/+/status", "services/#")
+ * @param handler Le handler
+ * @param context Contexte transmis au handler
+ * @return 0 en cas de succès, -1 si le filtre est invalide ou en cas d'erreur d'allocation
+ */
+int mqtt_router_add_topic(mqtt_router_t *router, const char *filter, mqtt_route_handler_t handler, void *context);
+
+/**
+ * @brief Associe un handler à une action reçue sur un filtre de topic.
+ * @param router Le routeur
+ * @param filter Filtre de topic MQTT
+ * @param action Action de la commande (header.action)
+ * @param handler Le handler
+ * @param context Contexte transmis au handler
+ * @return 0 en cas de succès, -1 si le filtre est invalide, si l'action est déjà enregistrée sur
+ * ce filtre ou en cas d'erreur d'allocation
+ */
+int mqtt_router_add_action(mqtt_router_t *router, const char *filter, const char *action, mqtt_action_handler_t handler, void *context);
+
+/**
+ * @brief Définit le handler appelé pour les messages qu'aucune route ne capte.
+ * @param router Le routeur
+ * @param handler Le handler (NULL : message ignoré)
+ * @param context Contexte transmis au handler
+ */
+void mqtt_router_set_default(mqtt_router_t *router, mqtt_route_handler_t handler, void *context);
+
+/**
+ * @brief Indique si le routeur n'a aucune route ni handler par défaut.
+ */
+bool mqtt_router_is_empty(const mqtt_router_t *router);
+
+/**
+ * @brief Route un message.
+ * @param router Le routeur
+ * @param topic Topic du message
+ * @param payload Payload du message (non terminé par '\0' garanti)
+ * @param length Taille du payload en octets
+ * @return Le nombre de handlers appelés (handler par défaut compris)
+ */
+int mqtt_router_dispatch(mqtt_router_t *router, const char *topic, const void *payload, size_t length);
+
+#endif // CORE_MQTT_ROUTER_H
@@ -67,4 +67,10 @@ void* pq_pop(priority_queue_t* pq);
  */
 bool pq_is_empty(priority_queue_t* pq);
 
+/**
+ * @brief Vide la file de priorité en conservant sa capacité (réutilisation sans allocation).
+ * @param pq La file de priorité.
+ */
+void pq_clear(priority_queue_t* pq);
+
 #endif // PRIORITY_QUEUE_H
\ No newline at end of file
@@ -0,0 +1,109 @@
+/**
+ * @file request_future.h
+ * @brief Requêtes/réponses MQTT sous forme de futures.
+ * @details
+ * Surcouche du gestionnaire de requêtes : request_manager_call() publie une requête et retourne
+ * une future résolue par la réponse corrélée (commandId) ou par l'expiration de la requête.
+ * La future peut être attendue (request_future_wait(), request_future_wait_all()), interrogée
+ * sans blocage (request_future_poll()) ou complétée par un callback (request_future_then()).
+ * Plusieurs requêtes vers des services différents peuvent ainsi être envoyées en parallèle puis
+ * attendues ensemble.
+ * @note Les fonctions sont thread-safe.
+ * @warning Attendre une future bloque le thread appelant : ne pas attendre depuis un callback MQTT
+ * ou depuis la boucle d'événements du service (la réponse ne pourrait plus être reçue).
+ * @date 2026-10-19
+ */
+#ifndef CORE_REQUEST_FUTURE_H
+#define CORE_REQUEST_FUTURE_H
+
+#include "core/common.h"
+#include "core/request_manager.h"
+
+#define REQUEST_FUTURE_WAIT_FOREVER -1 //!< Attente sans limite (l'échéance de la requête s'applique toujours)
+
+/**
+ * @brief État d'une future.
+ */
+typedef enum {
+	REQUEST_FUTURE_PENDING = 0, //!< Réponse non reçue
+	REQUEST_FUTURE_SUCCESS,     //!< Réponse reçue avec success == true
+	REQUEST_FUTURE_ERROR,       //!< Réponse reçue avec success == false
+	REQUEST_FUTURE_TIMEOUT      //!< Requête expirée sans réponse (renvois compris)
+} request_future_state_t;
+
+typedef struct request_future request_future_t;
+
+/**
+ * @brief Callback appelé à la résolution d'une future.
+ * @details Appelé dans le thread qui résout la future (thread MQTT, roue de timers), ou dans le
+ * thread appelant de request_future_then() si la future est déjà résolue.
+ * @param future La future résolue
+ * @param context Contexte fourni à request_future_then()
+ */
+typedef void (*request_future_callback_t)(request_future_t *future, void *context);
+
+/**
+ * @brief Publie une requête et retourne la future de sa réponse.
+ * @param topic Topic de la requête.
+ * @param requestId L'ID de la requête (command_id de son en-tête).
+ * @param payload Le payload JSON de la requête.
+ * @param qos Le niveau de QoS à utiliser.
+ * @param options Options d'attente et de renvoi (NULL : échéance par défaut, sans renvoi).
+ * @return La future, à libérer avec request_future_release(), ou NULL en cas d'erreur.
+ */
+request_future_t *request_manager_call(const char *topic, const char *requestId, const char *payload, mqtt_qos_enum_t qos,
+	const request_options_t *options);
+
+/**
+ * @brief Retourne l'état d'une future sans bloquer.
+ */
+request_future_state_t request_future_poll(request_future_t *future);
+
+/**
+ * @brief Attend la résolution d'une future.
+ * @param future La future
+ * @param timeoutMs Attente maximale en millisecondes (0 : aucune, REQUEST_FUTURE_WAIT_FOREVER : sans limite)
+ * @return L'état de la future (REQUEST_FUTURE_PENDING si l'attente a expiré avant la résolution)
+ */
+request_future_state_t request_future_wait(request_future_t *future, int timeoutMs);
+
+/**
+ * @brief Attend la résolution de plusieurs futures.
+ * @param futures Les futures (les entrées NULL sont ignorées)
+ * @param count Nombre de futures
+ * @param timeoutMs Attente maximale pour l'ensemble (0 : aucune, REQUEST_FUTURE_WAIT_FOREVER : sans limite)
+ * @return 0 si toutes les futures sont résolues, -1 si l'attente a expiré avant
+ */
+int request_future_wait_all(request_future_t **futures, size_t count, int timeoutMs);
+
+/**
+ * @brief Enregistre le callback appelé à la résolution de la future.
+ * @details Si la future est déjà résolue, le callback est appelé immédiatement.
+ * @param future La future
+ * @param callback Le callback
+ * @param context Contexte transmis au callback
+ * @return 0 en cas de succès, -1 si un callback est déjà enregistré
+ */
+int request_future_then(request_future_t *future, request_future_callback_t callback, void *context);
+
+/**
+ * @brief Retourne le JSON de la réponse.
+ * @return La réponse (propriété de la future), ou NULL si la future n'est pas résolue ou a expiré
+ */
+const cJSON *request_future_response(request_future_t *future);
+
+/**
+ * @brief Retourne l'en-tête de la réponse (errorMessage renseigné en cas d'erreur ou d'expiration).
+ * @return L'en-tête, ou NULL si la future n'est pas résolue
+ */
+const command_response_header_t *request_future_header(request_future_t *future);
+
+/**
+ * @brief Libère la future.
+ * @details Une future non résolue reste valide pour le gestionnaire de requêtes jusqu'à sa
+ * résolution ; son callback request_future_then() est alors toujours appelé.
+ * @param future La future (NULL accepté)
+ */
+void request_future_release(request_future_t *future);
+
+#endif // CORE_REQUEST_FUTURE_H
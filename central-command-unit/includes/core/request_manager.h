@@ -1,7 +1,13 @@
 /**
  * @file request_manager.h
  * @brief Gère le suivi des requêtes MQTT en attente de réponse.
- * @details Utilise une hashmap pour corréler les réponses
+ * @details Utilise une hashmap pour corréler les réponses, découpée en REQUEST_MANAGER_SHARDS
+ * partitions protégées chacune par un verrou lecteurs/rédacteur. Les entrées sont indexées par
+ * la valeur de 64 bits de l'ID de la requête (voir command_id.h).
+ * Chaque requête a une échéance : si aucune réponse n'arrive à temps, le payload est renvoyé
+ * (request_manager_send(), avec un délai doublé à chaque tentative) puis le callback est appelé
+ * avec un statut d'expiration. Les échéances sont des timers de la roue fournie à
+ * request_manager_init() ; sans roue, request_manager_sweep() doit être appelée périodiquement.
  * @note L'implémentation est thread-safe
  * @author Lukas Grando
  * @date 2025-11-11
@@ -14,23 +20,47 @@
 #include "core/mqtt_messages/command_header.h"
 #include "core/mqtt_messages/command_response_header.h"
 #include "core/logger.h"
+#include "core/mqtt.h"
+#include "core/timer_wheel.h"
 #include <uthash.h>
 
+#define REQUEST_MANAGER_DEFAULT_TIMEOUT_MS 30000 //!< Échéance des requêtes enregistrées sans options
+#define REQUEST_MANAGER_SHARDS 16                //!< Partitions de la hashmap (puissance de 2)
+#define REQUEST_MANAGER_MAX_PENDING 4096         //!< Requêtes en attente au-delà desquelles l'enregistrement est refusé
+#define REQUEST_MANAGER_TIMEOUT_MESSAGE "Request timed out" //!< errorMessage de l'en-tête transmis à l'expiration
+
 /**
  * @brief Pointeur de fonction pour un callback de réponse.
- * @param payload Le payload JSON brut de la réponse.
+ * @details À l'expiration de la requête, root vaut NULL et header->success false
+ * (errorMessage : REQUEST_MANAGER_TIMEOUT_MESSAGE).
+ * @param root Le JSON de la réponse (NULL si la requête a expiré).
+ * @param header L'en-tête de la réponse.
  * @param context Le pointeur "contexte" fourni lors de l'enregistrement.
  */
 typedef void (*response_callback_t)(const cJSON* root, const command_response_header_t* header, void* context);
 
 /**
- * @brief Initialise le gestionnaire de requêtes. Hashmap + semaphore.
+ * @brief Options d'attente d'une requête.
+ */
+typedef struct {
+	int timeoutMs;    //!< Délai d'attente de la réponse (0 : aucune échéance)
+	int maxRetries;   //!< Renvois du payload avant expiration (requêtes envoyées avec request_manager_send())
+	int maxTimeoutMs; //!< Plafond du délai, doublé à chaque renvoi (0 : pas de plafond)
+	const char *replyTopic; //!< Topic de réponse, transmis en propriété MQTT v5 par request_manager_send() (NULL : aucun)
+} request_options_t;
+
+/**
+ * @brief Initialise le gestionnaire de requêtes. Partitions de la hashmap + verrous.
  * @note Doit être appelé une fois au démarrage du service.
+ * @param wheel Roue de timers portant les échéances (NULL : appeler request_manager_sweep() périodiquement)
  */
-void request_manager_init(void);
+void request_manager_init(timer_wheel_t *wheel);
 
 /**
- * @brief Nettoie le gestionnaire de requêtes. Libère la Hashmap et le semaphore.
+ * @brief Nettoie le gestionnaire de requêtes. Libère les partitions de la hashmap et leurs verrous.
+ * @details Les requêtes en attente expirent : leur callback reçoit l'en-tête d'expiration
+ * (une future est résolue en REQUEST_FUTURE_TIMEOUT).
+ * @warning La roue de timers doit être arrêtée avant.
  */
 void request_manager_destroy(void);
 
@@ -40,9 +70,41 @@ void request_manager_destroy(void);
  * @param callback La fonction à appeler lorsque la réponse arrivera.
  * @param context le contexte à passer au callback lors de l'appel pouvant être utilisé pour stocker des données spécifiques.
  * @return 0 en cas de succès, -1 si l'ID existe déjà ou en cas d'erreur.
+ * @note La requête expire après REQUEST_MANAGER_DEFAULT_TIMEOUT_MS.
  */
 int request_manager_register(const char* requestId, response_callback_t callback, void* context);
 
+/**
+ * @brief Enregistre une requête en attente avec une échéance choisie.
+ * @param requestId L'ID de la requête qui sera envoyée.
+ * @param callback La fonction à appeler lorsque la réponse arrivera ou que la requête expirera.
+ * @param context Le contexte à passer au callback.
+ * @param options Options d'attente (NULL : échéance par défaut). maxRetries est ignoré : aucun payload n'est connu.
+ * @return 0 en cas de succès, -1 si l'ID existe déjà, si trop de requêtes sont en attente ou en cas d'erreur.
+ */
+int request_manager_register_with_options(const char* requestId, response_callback_t callback, void* context, const request_options_t *options);
+
+/**
+ * @brief Enregistre une requête puis publie son payload.
+ * @details Le topic et le payload sont copiés : à chaque échéance sans réponse, le payload est
+ * republié tant que options->maxRetries n'est pas atteint, puis le callback est appelé avec
+ * un statut d'expiration. En MQTT v5, requestId est transmis en données de corrélation et
+ * options->replyTopic en topic de réponse.
+ * @param topic Topic de la requête.
+ * @param requestId L'ID de la requête (command_id de son en-tête).
+ * @param payload Le payload JSON de la requête.
+ * @param qos Le niveau de QoS à utiliser.
+ * @param retain Flag de rétention du message.
+ * @param callback La fonction à appeler lorsque la réponse arrivera ou que la requête expirera.
+ * @param context Le contexte à passer au callback.
+ * @param options Options d'attente (NULL : échéance par défaut, sans renvoi).
+ * @return 0 en cas de succès, -1 en cas d'erreur (la requête n'est alors pas enregistrée).
+ * @note Si la première publication échoue alors que des renvois sont prévus, la requête reste
+ * enregistrée : le prochain renvoi la publiera.
+ */
+int request_manager_send(const char* topic, const char* requestId, const char* payload, mqtt_qos_enum_t qos, bool retain,
+	response_callback_t callback, void* context, const request_options_t *options);
+
 /**
  * @brief Traite un payload de réponse entrant.
  * @details Extrait l'id de la commande, et cherche le callback
@@ -52,4 +114,27 @@ int request_manager_register(const char* requestId, response_callback_t callback
  */
 int request_manager_process_response(const char* payload);
 
+/**
+ * @brief Traite un payload de réponse entrant, sans le recopier.
+ * @details Variante de request_manager_process_response() pour un payload délimité par sa taille
+ * (ex : buffer reçu par un handler du routeur MQTT).
+ * @param payload Le payload JSON brut reçu (non terminé par '\0' garanti).
+ * @param length Taille du payload en octets.
+ * @return 0 si la réponse a été trouvée et traitée, -1 si elle était inattendue ou invalide.
+ */
+int request_manager_process_payload(const void* payload, size_t length);
+
+/**
+ * @brief Traite les requêtes dont l'échéance est dépassée (renvoi ou expiration).
+ * @details Inutile si une roue de timers a été fournie à request_manager_init(), mais sans effet
+ * de bord dans ce cas.
+ * @return Le nombre de requêtes expirées.
+ */
+int request_manager_sweep(void);
+
+/**
+ * @brief Retourne le nombre de requêtes en attente de réponse.
+ */
+size_t request_manager_pending_count(void);
+
 #endif // REQUEST_MANAGER_H
\ No newline at end of file
@@ -0,0 +1,164 @@
+/**
+ * @file ring_buffer.h
+ * @brief File circulaire bornée multi-producteurs / consommateur unique (MPSC), sans verrou.
+ * @details
+ * Module fournissant une file de capacité fixe (puissance de 2) dont les cases sont préallouées :
+ * - les producteurs réservent une case par compare-and-swap sur l'indice d'écriture,
+ *   la remplissent en place puis la publient via son numéro de séquence (pas d'allocation, pas de verrou) ;
+ * - un seul thread consomme, dans l'ordre de réservation, éventuellement par lots.
+ * Deux modes d'utilisation :
+ * - file de pointeurs : ring_buffer_init(), ring_buffer_try_push(), ring_buffer_pop_batch() ;
+ * - file de cases de taille fixe : ring_buffer_init_slots(), ring_buffer_claim() / ring_buffer_publish()
+ *   côté producteur, ring_buffer_peek() / ring_buffer_release() côté consommateur
+ *   (ou ring_buffer_peek_at() / ring_buffer_release_n() pour traiter un lot avant de le libérer).
+ * Les indices de lecture et d'écriture sont sur des lignes de cache distinctes.
+ * En mode bloquant, le consommateur peut attendre des données (ring_buffer_wait()) sur un
+ * eventfd, qui n'est signalé par les producteurs que lorsque le consommateur dort.
+ * @date 2026-10-19
+ */
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include "core/common.h"
+#include <stddef.h>
+
+#define CACHE_LINE_SIZE 64 //!< Taille d'une ligne de cache (alignement des indices)
+
+/**
+ * @brief En-tête d'une case : le numéro de séquence indique si elle est libre ou publiée.
+ */
+typedef struct {
+	size_t sequence;
+	max_align_t payload[]; //!< Contenu de la case (aligné pour tout type)
+} ring_buffer_cell_t;
+
+typedef struct {
+	unsigned char *cells; //!< Tableau des cases (en-tête + contenu)
+	size_t stride; //!< Taille d'une case en octets
+	size_t mask; //!< capacité - 1
+	int eventFd; //!< eventfd de réveil du consommateur (-1 en mode non bloquant)
+	int consumerSleeping; //!< Vrai lorsque le consommateur attend sur eventFd (accès atomique)
+	size_t head __attribute__((aligned(CACHE_LINE_SIZE))); //!< Prochaine case à lire (consommateur seul)
+	size_t tail __attribute__((aligned(CACHE_LINE_SIZE))); //!< Prochaine case à réserver (producteurs, accès atomique)
+} ring_buffer_t;
+
+/**
+ * @brief Initialise une file circulaire de pointeurs.
+ * @param rb La file
+ * @param capacity Capacité minimale (arrondie à la puissance de 2 supérieure)
+ * @param blocking Crée l'eventfd permettant au consommateur d'attendre (ring_buffer_wait())
+ * @return 0 en cas de succès, -1 en cas d'erreur
+ */
+int ring_buffer_init(ring_buffer_t *rb, size_t capacity, bool blocking);
+
+/**
+ * @brief Initialise une file circulaire de cases de taille fixe.
+ * @param rb La file
+ * @param capacity Capacité minimale (arrondie à la puissance de 2 supérieure)
+ * @param slotSize Taille du contenu d'une case en octets
+ * @param blocking Crée l'eventfd permettant au consommateur d'attendre (ring_buffer_wait())
+ * @return 0 en cas de succès, -1 en cas d'erreur
+ */
+int ring_buffer_init_slots(ring_buffer_t *rb, size_t capacity, size_t slotSize, bool blocking);
+
+/**
+ * @brief Réserve une case à remplir (appelable depuis plusieurs threads).
+ * @details La case doit ensuite être publiée avec ring_buffer_publish(). Le consommateur
+ * lit dans l'ordre de réservation : une case réservée bloque la lecture des suivantes
+ * jusqu'à sa publication, elle doit donc être remplie sans attendre.
+ * @param rb La file
+ * @return Le contenu de la case réservée, ou NULL si la file est pleine
+ */
+void *ring_buffer_claim(ring_buffer_t *rb);
+
+/**
+ * @brief Publie une case réservée avec ring_buffer_claim().
+ * @param rb La file
+ * @param slot Le contenu retourné par ring_buffer_claim()
+ */
+void ring_buffer_publish(ring_buffer_t *rb, void *slot);
+
+/**
+ * @brief Retourne la prochaine case publiée sans la retirer (consommateur uniquement).
+ * @param rb La file
+ * @return Le contenu de la case, ou NULL si la file est vide
+ */
+void *ring_buffer_peek(ring_buffer_t *rb);
+
+/**
+ * @brief Libère la case retournée par ring_buffer_peek() (consommateur uniquement).
+ * @param rb La file
+ */
+void ring_buffer_release(ring_buffer_t *rb);
+
+/**
+ * @brief Retourne la case publiée située offset positions après la prochaine case à lire (consommateur uniquement).
+ * @details Permet de traiter plusieurs cases avant de les libérer ensemble avec ring_buffer_release_n().
+ * @param rb La file
+ * @param offset Décalage depuis la prochaine case à lire (0 : équivalent à ring_buffer_peek())
+ * @return Le contenu de la case, ou NULL si elle n'est pas (encore) publiée
+ */
+void *ring_buffer_peek_at(ring_buffer_t *rb, size_t offset);
+
+/**
+ * @brief Libère les count prochaines cases, lues avec ring_buffer_peek_at() (consommateur uniquement).
+ * @param rb La file
+ * @param count Nombre de cases à libérer
+ */
+void ring_buffer_release_n(ring_buffer_t *rb, size_t count);
+
+/**
+ * @brief Ajoute un pointeur sans bloquer (appelable depuis plusieurs threads).
+ * @param rb La file (initialisée avec ring_buffer_init())
+ * @param data Le pointeur à ajouter (non NULL)
+ * @return true si l'élément a été ajouté, false si la file est pleine ou data est NULL
+ */
+bool ring_buffer_try_push(ring_buffer_t *rb, void *data);
+
+/**
+ * @brief Retire un pointeur (consommateur uniquement).
+ * @param rb La file (initialisée avec ring_buffer_init())
+ * @return L'élément retiré, ou NULL si la file est vide
+ */
+void *ring_buffer_pop(ring_buffer_t *rb);
+
+/**
+ * @brief Retire jusqu'à maxCount pointeurs (consommateur uniquement).
+ * @param rb La file (initialisée avec ring_buffer_init())
+ * @param out Tableau recevant les éléments, dans l'ordre de publication
+ * @param maxCount Taille du tableau out
+ * @return Le nombre d'éléments retirés
+ */
+size_t ring_buffer_pop_batch(ring_buffer_t *rb, void **out, size_t maxCount);
+
+/**
+ * @brief Indique si la file est vide (exact du point de vue du consommateur).
+ */
+bool ring_buffer_is_empty(ring_buffer_t *rb);
+
+/**
+ * @brief Retourne la capacité de la file.
+ */
+size_t ring_buffer_capacity(const ring_buffer_t *rb);
+
+/**
+ * @brief Attend qu'un élément soit disponible (consommateur uniquement, mode bloquant).
+ * @param rb La file
+ * @param timeoutMs Délai maximal en millisecondes (-1 : infini)
+ * @return 0 si la file n'est pas vide ou si ring_buffer_wake() a été appelé, -1 en cas de délai dépassé ou d'erreur
+ */
+int ring_buffer_wait(ring_buffer_t *rb, int timeoutMs);
+
+/**
+ * @brief Réveille le consommateur en attente (ex : arrêt du thread consommateur).
+ * @param rb La file
+ */
+void ring_buffer_wake(ring_buffer_t *rb);
+
+/**
+ * @brief Libère les ressources de la file (les éléments restants ne sont pas libérés).
+ * @param rb La file
+ */
+void ring_buffer_destroy(ring_buffer_t *rb);
+
+#endif // RING_BUFFER_H
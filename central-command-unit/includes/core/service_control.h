@@ -0,0 +1,46 @@
+/**
+ * @file service_control.h
+ * @brief Topic de contrôle commun à tous les services.
+ * @details
+ * Chaque service s'abonne à services/<client_id>/control, traité par le core avant le
+ * callback du service. Actions prises en charge :
+ * - SET_LOG_LEVEL : change le niveau de journalisation, globalement ou pour un module,
+ *   sans redémarrer le service (voir set_log_level_request.h).
+ * Si le replyTopic de la commande n'est pas vide, un command_response_header_t y est publié.
+ * @date 2026-10-19
+ */
+
+#ifndef SERVICE_CONTROL_H
+#define SERVICE_CONTROL_H
+
+#include "core/common.h"
+#include "core/mqtt_messages/set_log_level_request.h"
+
+#define SERVICE_CONTROL_TOPIC_FORMAT "services/%s/control" //!< Topic de contrôle (%s : client_id)
+#define SERVICE_CONTROL_TOPIC_LENGTH 128
+
+/**
+ * @brief Installe le gestionnaire de contrôle et s'abonne au topic de contrôle du service.
+ * @param clientId Identifiant MQTT du service.
+ * @return 0 en cas de succès, -1 en cas d'erreur.
+ * @note Le client MQTT doit être connecté.
+ */
+int service_control_init(const char *clientId);
+
+/**
+ * @brief Traite un message reçu s'il est adressé au topic de contrôle.
+ * @param topic Le topic du message.
+ * @param payload Le contenu du message (non terminé par '\0' garanti).
+ * @param length Taille du contenu en octets.
+ * @return true si le message était un message de contrôle (traité ou rejeté), false sinon.
+ */
+bool service_control_handle_message(const char *topic, const void *payload, size_t length);
+
+/**
+ * @brief Applique une commande SET_LOG_LEVEL.
+ * @param request La commande désérialisée.
+ * @return 0 en cas de succès, -1 si le niveau ne peut pas être appliqué.
+ */
+int service_control_apply_log_level(const set_log_level_request_t *request);
+
+#endif // SERVICE_CONTROL_H
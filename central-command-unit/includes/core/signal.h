@@ -10,6 +10,7 @@
 
 #include "core/common.h"
 #include "core/check.h"
+#include "core/event_loop.h"
 
 
 /**
@@ -37,6 +38,15 @@ void signal_wait_for_shutdown(void);
  */
 void signal_send_shutdown(void);
 
+/**
+ * @brief Arrête aussi une boucle d'événements à la réception d'un signal d'arrêt.
+ * @details Utilisé par les services dont le thread principal exécute une boucle d'événements
+ * au lieu d'attendre sur signal_wait_for_shutdown().
+ * @param loop La boucle à arrêter (NULL : aucune)
+ * @return void
+ */
+void signal_set_event_loop(event_loop_t *loop);
+
 /**
  * @brief Nettoie les ressources liées à la gestion des signaux.
  * @details Cette fonction libère les ressources allouées pour la gestion des signaux.
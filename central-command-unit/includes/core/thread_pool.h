@@ -0,0 +1,74 @@
+/**
+ * @file thread_pool.h
+ * @brief Pool de threads de calcul (fork-join).
+ * @details
+ * Module fournissant un pool de threads persistants pour paralléliser des boucles :
+ * thread_pool_parallel_for() distribue les indices [0, count) aux workers
+ * par un compteur atomique et rend la main lorsque tous les indices ont été traités.
+ * Le thread appelant participe au calcul en tant que worker 0, ce qui permet
+ * à chaque tâche d'utiliser des ressources propres à son worker (workerIndex).
+ * @date 2026-10-19
+ */
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include "core/common.h"
+#include "core/check.h"
+
+/** Nombre maximal de workers d'un pool */
+#define THREAD_POOL_MAX_WORKERS 64
+
+/**
+ * @brief Tâche exécutée pour chaque indice d'une boucle parallèle.
+ * @param index Indice de l'itération, dans [0, count)
+ * @param workerIndex Indice du worker qui exécute la tâche, dans [0, thread_pool_size())
+ * @param context Contexte fourni à thread_pool_parallel_for()
+ */
+typedef void (*thread_pool_task_t)(int index, int workerIndex, void *context);
+
+typedef struct {
+	pthread_t threads[THREAD_POOL_MAX_WORKERS]; //!< Threads des workers 1..workerCount-1
+	int workerCount; //!< Nombre de workers, thread appelant compris
+	pthread_mutex_t lock; //!< Protège l'état du travail en cours
+	pthread_cond_t workAvailable; //!< Signalé lorsqu'une boucle est publiée (ou à l'arrêt)
+	pthread_cond_t workDone; //!< Signalé lorsque le dernier worker termine la boucle
+	unsigned long generation; //!< Incrémenté à chaque boucle publiée
+	int activeWorkers; //!< Workers n'ayant pas encore terminé la boucle en cours
+	bool stopping; //!< Demande d'arrêt des workers
+	thread_pool_task_t task; //!< Tâche de la boucle en cours
+	void *context; //!< Contexte de la boucle en cours
+	int count; //!< Nombre d'itérations de la boucle en cours
+	int nextIndex; //!< Prochain indice à distribuer (accès atomique)
+	pthread_mutex_t callLock; //!< Sérialise les appels concurrents à thread_pool_parallel_for()
+} thread_pool_t;
+
+/**
+ * @brief Crée un pool de threads.
+ * @param workerCount Nombre de workers, thread appelant compris (0 : nombre de coeurs en ligne)
+ * @return Le pool créé, ou NULL en cas d'erreur
+ * @warning Le pool doit être libéré avec thread_pool_destroy()
+ */
+thread_pool_t *thread_pool_create(int workerCount);
+
+/**
+ * @brief Retourne le nombre de workers du pool (thread appelant compris).
+ */
+int thread_pool_size(const thread_pool_t *pool);
+
+/**
+ * @brief Exécute task(i) pour chaque i de [0, count) en parallèle et attend la fin.
+ * @param pool Le pool
+ * @param count Nombre d'itérations
+ * @param task La tâche à exécuter
+ * @param context Contexte transmis à chaque appel de la tâche
+ * @return 0 en cas de succès, -1 en cas d'erreur (paramètres invalides)
+ */
+int thread_pool_parallel_for(thread_pool_t *pool, int count, thread_pool_task_t task, void *context);
+
+/**
+ * @brief Arrête les workers et libère le pool.
+ * @param pool Le pool (NULL accepté)
+ */
+void thread_pool_destroy(thread_pool_t *pool);
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,171 @@
+/**
+ * @file timer_wheel.h
+ * @brief Service de timers basé sur une roue hiérarchique (hierarchical timing wheel).
+ * @details
+ * Module permettant de gérer un grand nombre de délais (timeouts de requêtes, tâches périodiques)
+ * à coût constant :
+ * - TIMER_WHEEL_LEVELS niveaux de TIMER_WHEEL_SLOTS cases ; le niveau L couvre des délais
+ *   jusqu'à TIMER_WHEEL_SLOTS^(L+1) ticks et ses cases sont redistribuées vers les niveaux
+ *   inférieurs lorsque le temps les atteint ;
+ * - insertion et annulation en O(1) : les timers sont fournis par l'appelant (aucune allocation)
+ *   et chaînés dans leur case ;
+ * - un bitmap des cases occupées par niveau permet de calculer la prochaine échéance en
+ *   O(TIMER_WHEEL_LEVELS) : entre deux échéances, le thread qui fait avancer la roue dort,
+ *   quel que soit le nombre de timers en attente.
+ * La roue avance soit dans une boucle d'événements (timer_wheel_attach(), un seul timerfd),
+ * soit dans un thread dédié (timer_wheel_start_thread()), soit manuellement (timer_wheel_advance()).
+ * Les délais sont arrondis au tick supérieur : un timer n'expire jamais avant son délai.
+ * @note Les fonctions sont thread-safe. Les callbacks sont appelés sans verrou, dans le thread
+ * qui fait avancer la roue : timer_wheel_cancel() n'attend pas la fin d'un callback en cours.
+ * @date 2026-10-19
+ */
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include "core/common.h"
+#include "core/event_loop.h"
+
+#define TIMER_WHEEL_LEVELS 4 //!< Niveaux de la roue (64^4 ticks, soit ~46 h avec des ticks de 10 ms)
+#define TIMER_WHEEL_SLOT_BITS 6
+#define TIMER_WHEEL_SLOTS (1 << TIMER_WHEEL_SLOT_BITS) //!< Cases par niveau (une par bit du bitmap)
+#define TIMER_WHEEL_DEFAULT_TICK_MS 10 //!< Résolution par défaut
+
+typedef struct timer_wheel_timer timer_wheel_timer_t;
+
+/**
+ * @brief Callback appelé à l'expiration d'un timer.
+ * @param timer Le timer (peut être annulé ou reprogrammé depuis le callback)
+ * @param context Contexte fourni à timer_wheel_timer_init()
+ */
+typedef void (*timer_wheel_callback_t)(timer_wheel_timer_t *timer, void *context);
+
+/**
+ * @brief Horloge monotone de la roue, en millisecondes.
+ */
+typedef long (*timer_wheel_clock_t)(void);
+
+/**
+ * @brief Timer, alloué par l'appelant (ex : membre d'une structure) et initialisé avec timer_wheel_timer_init().
+ * @warning Un timer en attente ne doit pas être libéré avant d'avoir été annulé.
+ */
+struct timer_wheel_timer {
+	struct timer_wheel_timer *next;
+	struct timer_wheel_timer **pprev; //!< Lien qui pointe vers ce timer (retrait en O(1))
+	uint64_t expiresTick;
+	uint64_t intervalTicks; //!< Période (0 : ponctuel)
+	int level; //!< Niveau de la case (-1 : en cours d'expiration)
+	int slot;
+	bool pending;
+	timer_wheel_callback_t callback;
+	void *context;
+};
+
+typedef struct {
+	timer_wheel_timer_t *slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+	uint64_t occupied[TIMER_WHEEL_LEVELS]; //!< Bitmap des cases non vides
+	timer_wheel_timer_t *expiring; //!< Timers de la case en cours d'expiration
+	uint64_t currentTick; //!< Prochain tick à traiter
+	uint64_t armedTick; //!< Tick auquel le thread ou la boucle sera réveillé (UINT64_MAX : aucun)
+	size_t pendingCount;
+	int tickMs;
+	long startMs;
+	timer_wheel_clock_t clock;
+	pthread_mutex_t lock;
+	// Thread dédié
+	pthread_t thread;
+	pthread_cond_t changed;
+	bool threadRunning;
+	bool stopping;
+	// Boucle d'événements
+	event_loop_t *loop;
+	event_loop_timer_t *loopTimer;
+} timer_wheel_t;
+
+/**
+ * @brief Horloge par défaut des roues : clock_monotonic_ms().
+ */
+long timer_wheel_now_ms(void);
+
+/**
+ * @brief Initialise une roue.
+ * @param wheel La roue
+ * @param tickMs Résolution en millisecondes (0 : TIMER_WHEEL_DEFAULT_TICK_MS)
+ * @param clock Horloge en millisecondes (NULL : timer_wheel_now_ms())
+ * @return 0 en cas de succès, -1 en cas d'erreur
+ */
+int timer_wheel_init(timer_wheel_t *wheel, int tickMs, timer_wheel_clock_t clock);
+
+/**
+ * @brief Arrête le thread ou détache la roue de sa boucle, puis libère ses ressources.
+ * @details Les timers en attente sont abandonnés sans être appelés.
+ * @param wheel La roue (NULL accepté)
+ */
+void timer_wheel_destroy(timer_wheel_t *wheel);
+
+/**
+ * @brief Fait avancer la roue dans une boucle d'événements (un seul timerfd, réarmé à la prochaine échéance).
+ * @details Les callbacks sont appelés dans le thread de la boucle.
+ * @param wheel La roue
+ * @param loop La boucle
+ * @return 0 en cas de succès, -1 en cas d'erreur (roue déjà démarrée, ...)
+ */
+int timer_wheel_attach(timer_wheel_t *wheel, event_loop_t *loop);
+
+/**
+ * @brief Fait avancer la roue dans un thread dédié, endormi jusqu'à la prochaine échéance.
+ * @param wheel La roue
+ * @return 0 en cas de succès, -1 en cas d'erreur (roue déjà démarrée, ...)
+ */
+int timer_wheel_start_thread(timer_wheel_t *wheel);
+
+/**
+ * @brief Initialise un timer.
+ * @param timer Le timer
+ * @param callback Fonction appelée à l'expiration
+ * @param context Contexte transmis au callback
+ */
+void timer_wheel_timer_init(timer_wheel_timer_t *timer, timer_wheel_callback_t callback, void *context);
+
+/**
+ * @brief Programme (ou reprogramme) un timer, en O(1).
+ * @param wheel La roue
+ * @param timer Le timer, initialisé avec timer_wheel_timer_init()
+ * @param delayMs Délai avant la première expiration
+ * @param intervalMs Période des expirations suivantes (0 : ponctuel)
+ * @return 0 en cas de succès, -1 en cas de paramètres invalides
+ */
+int timer_wheel_schedule(timer_wheel_t *wheel, timer_wheel_timer_t *timer, int delayMs, int intervalMs);
+
+/**
+ * @brief Annule un timer, en O(1).
+ * @param wheel La roue
+ * @param timer Le timer (NULL accepté)
+ * @return true si le timer était en attente
+ */
+bool timer_wheel_cancel(timer_wheel_t *wheel, timer_wheel_timer_t *timer);
+
+/**
+ * @brief Indique si un timer est en attente d'expiration.
+ */
+bool timer_wheel_is_pending(timer_wheel_t *wheel, const timer_wheel_timer_t *timer);
+
+/**
+ * @brief Traite les ticks écoulés selon l'horloge de la roue et appelle les callbacks expirés.
+ * @param wheel La roue
+ * @return Le nombre de callbacks appelés
+ */
+int timer_wheel_advance(timer_wheel_t *wheel);
+
+/**
+ * @brief Délai avant la prochaine échéance de la roue (expiration ou redistribution d'une case).
+ * @param wheel La roue
+ * @return Délai en millisecondes, ou -1 si aucun timer n'est en attente
+ */
+int timer_wheel_next_timeout(timer_wheel_t *wheel);
+
+/**
+ * @brief Retourne le nombre de timers en attente.
+ */
+size_t timer_wheel_pending_count(timer_wheel_t *wheel);
+
+#endif // TIMER_WHEEL_H
@@ -11,6 +11,8 @@
 #define HEARTBEAT_MESSAGE_CALLBACK_H
 
 #define HEARTBEAT_REPLY_TOPIC "services/heartbeat/response"
+#define HEARTBEAT_ROUTE_PLANNER_BROADCAST_TOPIC "services/route-planner/broadcast" //!< Commandes reçues par toutes les instances du route planner
+#define HEARTBEAT_MAX_ROUTE_PLANNER_REPLICAS 16 //!< Instances du route planner suivies
 
 #include "core/mqtt.h"
 #include "core/action_codes.h"
@@ -20,10 +22,12 @@
 #include "core/mqtt_messages/set_railway_mode_request.h"
 
 /**
- * @brief Callback pour les messages de heartbeat reçus.
- * @param topic Topic MQTT du message reçu.
- * @param payload Payload du message reçu.
+ * @brief Enregistre les routes MQTT du heartbeat.
+ * @details Chaque topic de status surveillé a son handler ; les autres messages reçus sont
+ * signalés par le handler par défaut.
+ * @param router Le routeur du service
+ * @return 0 en cas de succès, -1 en cas d'erreur
  */
-void heartbeat_message_callback(const char* topic, const char* payload);
+int heartbeat_register_routes(mqtt_router_t* router);
 
 #endif // HEARTBEAT_MESSAGE_CALLBACK_H
\ No newline at end of file
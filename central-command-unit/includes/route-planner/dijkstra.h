@@ -20,8 +20,34 @@ typedef struct {
 	double gCost; // Cout du départ jusqu'au noeud actuel
 	node_t *previous; // Noeud précédent dans le chemin
 	bool visited; // Indique si le noeud a été visité
+	unsigned int generation; // Recherche ayant initialisé l'entrée (voir dijkstra_workspace_t)
 } dijkstra_node_t;
 
+/**
+ * @brief Espace de travail réutilisable d'une recherche.
+ * @details Conserve le tableau des données par noeud et la file de priorité d'une
+ * recherche à l'autre. Les entrées sont invalidées par un compteur de génération :
+ * une recherche ne paie que les noeuds qu'elle touche, sans remise à zéro du tableau.
+ * @warning Un espace de travail ne doit être utilisé que par un thread à la fois.
+ */
+typedef struct {
+	dijkstra_node_t *data; //!< Données par noeud (indexées par node->index)
+	int capacity; //!< Nombre d'entrées de data
+	unsigned int generation; //!< Génération de la recherche en cours
+	priority_queue_t *pq; //!< File de priorité réutilisée
+	arena_t *arena; //!< Arène libre d'usage pour les résultats de l'appelant (peut être NULL)
+} dijkstra_workspace_t;
+
+/**
+ * @brief Compteurs d'exploration d'une recherche (instrumentation, benchmarks).
+ */
+typedef struct {
+	int settledNodes; //!< Nombre de noeuds définitivement visités
+	int relaxedEdges; //!< Nombre d'arcs ayant amélioré le coût d'un voisin
+	int queuePushes; //!< Nombre d'insertions dans la file de priorité
+	double pathCost; //!< Coût du chemin trouvé (DIJKSTRA_INFINITY si aucun)
+} dijkstra_stats_t;
+
 /**
  * @brief Calcule le plus court chemin entre deux noeud dans un graphe pondéré orienté
  * 
@@ -35,5 +61,71 @@ typedef struct {
  */
 path_t dijkstra_find_path(graph_t *graph, node_t *start, node_t *end);
 
+/**
+ * @brief Variante de dijkstra_find_path() avec arène et compteurs d'exploration.
+ * @param graph Le graphe pondéré orienté
+ * @param start Le noeud de départ
+ * @param end Le noeud d'arrivée
+ * @param arena Arène dans laquelle allouer le chemin (NULL : tas, à libérer avec path_destroy())
+ * @param stats Compteurs remis à zéro puis renseignés (peut être NULL)
+ * @return Voir dijkstra_find_path()
+ */
+path_t dijkstra_find_path_ex(graph_t *graph, node_t *start, node_t *end, arena_t *arena, dijkstra_stats_t *stats);
+
+/**
+ * @brief Crée un espace de travail réutilisable.
+ * @param numNodes Nombre de noeuds anticipé (l'espace s'agrandit si nécessaire)
+ * @param withArena Crée aussi une arène à disposition de l'appelant (ws->arena)
+ * @return L'espace de travail, ou NULL en cas d'erreur
+ * @warning Doit être libéré avec dijkstra_workspace_destroy()
+ */
+dijkstra_workspace_t *dijkstra_workspace_create(int numNodes, bool withArena);
+
+/**
+ * @brief Libère un espace de travail.
+ * @param ws L'espace de travail (NULL accepté)
+ */
+void dijkstra_workspace_destroy(dijkstra_workspace_t *ws);
+
+/**
+ * @brief Variante de dijkstra_find_path_ex() sans allocation de travail.
+ * @param ws L'espace de travail (propre au thread appelant)
+ * @param graph Le graphe pondéré orienté
+ * @param start Le noeud de départ
+ * @param end Le noeud d'arrivée
+ * @param arena Arène dans laquelle allouer le chemin (NULL : tas, à libérer avec path_destroy())
+ * @param stats Compteurs remis à zéro puis renseignés (peut être NULL)
+ * @return Voir dijkstra_find_path()
+ */
+path_t dijkstra_find_path_ws(dijkstra_workspace_t *ws, graph_t *graph, node_t *start, node_t *end, arena_t *arena, dijkstra_stats_t *stats);
+
+/**
+ * @brief Calcule le coût du plus court chemin d'un noeud vers plusieurs cibles (one-to-many).
+ * @details Une seule exploration est effectuée depuis le noeud de départ. Elle s'arrête
+ * dès que toutes les cibles ont été atteintes, ou lorsque le graphe a été entièrement parcouru.
+ * @param graph Le graphe pondéré orienté
+ * @param start Le noeud de départ
+ * @param targets Tableau des noeuds cibles (les doublons sont autorisés)
+ * @param targetCount Nombre de cibles
+ * @param costs Tableau de sortie (taille targetCount) recevant le coût vers chaque cible,
+ * ou DIJKSTRA_INFINITY si la cible est inaccessible
+ * @return 0 en cas de succès, -1 en cas d'erreur
+ */
+int dijkstra_compute_costs(graph_t *graph, node_t *start, node_t **targets, int targetCount, double *costs);
+
+/**
+ * @brief Variante de dijkstra_compute_costs() sans allocation de travail.
+ * @details Le marquage des cibles est alloué dans l'arène de l'espace de travail (ws->arena),
+ * sur le tas si l'espace n'en a pas.
+ * @param ws L'espace de travail (propre au thread appelant)
+ * @param graph Le graphe pondéré orienté
+ * @param start Le noeud de départ
+ * @param targets Tableau des noeuds cibles (les doublons sont autorisés)
+ * @param targetCount Nombre de cibles
+ * @param costs Tableau de sortie (taille targetCount), voir dijkstra_compute_costs()
+ * @return 0 en cas de succès, -1 en cas d'erreur
+ */
+int dijkstra_compute_costs_ws(dijkstra_workspace_t *ws, graph_t *graph, node_t *start, node_t **targets, int targetCount, double *costs);
+
 
 #endif // DIJKSTRA_H
\ No newline at end of file
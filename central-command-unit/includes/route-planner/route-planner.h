@@ -10,8 +10,13 @@
 
 #include "core/core.h"
 #include "route-planner/route_planner_message_callback.h"
+#include "route-planner/route_planner_config.h"
 
 #define ROUTE_PLANNER_SERVICE_VERSION "Route Planner v1.1.1"
 
+#define ROUTE_PLANNER_MAP_REQUEST_TIMEOUT_MS 5000      //!< Attente de la carte avant le premier renvoi
+#define ROUTE_PLANNER_MAP_REQUEST_MAX_RETRIES 8        //!< Renvois de la demande de carte avant abandon
+#define ROUTE_PLANNER_MAP_REQUEST_MAX_TIMEOUT_MS 60000 //!< Plafond de l'attente entre deux renvois
+
 
 #endif // ROUTE_PLANNER_H
\ No newline at end of file
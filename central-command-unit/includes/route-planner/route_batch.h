@@ -0,0 +1,56 @@
+/**
+ * @file route_batch.h
+ * @brief Planification de trajets par lot, répartie sur un pool de threads.
+ * @details
+ * Chaque entrée d'une plan_route_batch_request_t est calculée indépendamment par un worker
+ * du pool. Chaque worker dispose de son propre espace de travail Dijkstra (données par noeud,
+ * file de priorité et arène), ce qui évite toute allocation ou contention entre les entrées.
+ * La carte n'est que lue pendant le calcul : elle ne doit pas être remplacée pendant un lot.
+ * @date 2026-10-19
+ */
+
+#ifndef ROUTE_BATCH_H
+#define ROUTE_BATCH_H
+
+#include "core/common.h"
+#include "core/graph.h"
+#include "core/thread_pool.h"
+#include "core/mqtt_messages/plan_route_batch_request.h"
+#include "core/mqtt_messages/plan_route_batch_response.h"
+#include "route-planner/dijkstra.h"
+#include "route-planner/tsp.h"
+
+typedef struct {
+	thread_pool_t *pool; //!< Pool de calcul
+	dijkstra_workspace_t **workspaces; //!< Un espace de travail par worker du pool
+	int workerCount; //!< Nombre de workers (et d'espaces de travail)
+} route_batch_planner_t;
+
+/**
+ * @brief Crée un planificateur de lots.
+ * @param workerThreads Nombre de workers (0 : nombre de coeurs en ligne)
+ * @return Le planificateur, ou NULL en cas d'erreur
+ * @warning Doit être libéré avec route_batch_planner_destroy()
+ */
+route_batch_planner_t *route_batch_planner_create(int workerThreads);
+
+/**
+ * @brief Arrête les workers et libère le planificateur.
+ * @param planner Le planificateur (NULL accepté)
+ */
+void route_batch_planner_destroy(route_batch_planner_t *planner);
+
+/**
+ * @brief Calcule toutes les entrées d'un lot en parallèle.
+ * @details results[i] correspond à request->entries[i]. Une entrée en échec (noeud inconnu,
+ * aucun chemin, ...) n'interrompt pas le lot : son résultat porte success = false et un message.
+ * @param planner Le planificateur
+ * @param map La carte
+ * @param request La requête de lot
+ * @param results Tableau de request->entryCount résultats à remplir (nodeIds alloués sur le tas,
+ * à libérer avec plan_route_batch_response_destroy())
+ * @return Le nombre d'entrées en échec, ou -1 en cas d'erreur (paramètres invalides)
+ */
+int route_batch_planner_run(route_batch_planner_t *planner, graph_t *map, const plan_route_batch_request_t *request, plan_route_batch_result_t *results);
+
+#endif // ROUTE_BATCH_H
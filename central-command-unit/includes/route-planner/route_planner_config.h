@@ -0,0 +1,25 @@
+/**
+ * @file route_planner_config.h
+ * @brief Définitions de la configuration spécifique au route planner.
+ * @date 2026-10-19
+ */
+#ifndef ROUTE_PLANNER_CONFIG_H
+#define ROUTE_PLANNER_CONFIG_H
+
+#include "core/config.h"
+#include <ini.h>
+
+typedef struct {
+	int workerThreads; /**< Nombre de threads de calcul des requêtes par lot (0 : nombre de coeurs) */
+	char sharedGroup[32]; /**< Groupe d'abonnement partagé aux requêtes ($share/<groupe>/...), vide : aucun */
+} route_planner_config_t;
+
+/***
+ * @brief Parse la section spécifique de la configuration du service route planner.
+ * @param key Nom du paramètre
+ * @param value Valeur du paramètre
+ * @param serviceConfig Pointeur vers la structure spécifique du service
+ */
+void route_planner_service_config_parser(const char *key, const char *value, void *serviceConfig);
+
+#endif // ROUTE_PLANNER_CONFIG_H
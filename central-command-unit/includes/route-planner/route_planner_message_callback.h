@@ -15,6 +15,8 @@
 #include "core/request_manager.h"
 #include "core/action_codes.h"
 #include "route-planner/dijkstra.h"
+#include "route-planner/tsp.h"
+#include "route-planner/route_batch.h"
 
 #include "core/mqtt_messages/command_header.h"
 #include "core/mqtt_messages/command_response_header.h"
@@ -25,9 +27,15 @@
 #include "core/mqtt_messages/set_waypoints_request.h"
 #include "core/mqtt_messages/get_map_response.h"
 #include "core/mqtt_messages/plan_route_response.h"
+#include "core/mqtt_messages/plan_route_batch_request.h"
+#include "core/mqtt_messages/plan_route_batch_response.h"
 
+#define ROUTE_PLANNER_TOPIC_PREFIX "services/route-planner/"
 #define ROUTE_PLANNER_REPLY_TOPIC "services/route-planner/response"
 #define ROUTE_PLANNER_REQUEST_TOPIC "services/route-planner/request"
+// Commandes d'état global (modes) : reçues par toutes les instances, le topic de requête peut être partagé
+#define ROUTE_PLANNER_BROADCAST_TOPIC "services/route-planner/broadcast"
+#define ROUTE_PLANNER_TOPIC_LENGTH 128
 
 #define LWT_MESSAGE_OFFLINE "{\"service\":\"route_planner\",\"status\":\"offline\"}"
 #define LWT_MESSAGE_ONLINE "{\"service\":\"route_planner\",\"status\":\"online\"}"
@@ -36,15 +44,66 @@
 
 
 /**
- * @brief Callback pour les messages de route planner reçus.
- * @param topic Topic MQTT du message reçu.
- * @param payload Payload du message reçu.
+ * @brief Construit un topic propre à une instance du route planner.
+ * @details "services/route-planner/<instance>/<suffix>", ou "services/route-planner/<suffix>" pour
+ * une instance unique (instanceId vide).
+ * @param instanceId Identifiant de l'instance (mqtt_instance_id, NULL ou vide : instance unique)
+ * @param suffix Fin du topic (ex : "status", "response")
+ * @param topic Buffer de destination
+ * @param size Taille du buffer
+ * @return 0 en cas de succès, -1 si le buffer est trop petit
  */
-void route_planner_message_callback(const char* topic, const char* payload);
+int route_planner_instance_topic(const char* instanceId, const char* suffix, char* topic, size_t size);
+
+/**
+ * @brief Construit le message de status d'une instance du route planner.
+ * @param instanceId Identifiant de l'instance (NULL ou vide : instance unique, sans champ "instance")
+ * @param online Status annoncé
+ * @param payload Buffer de destination
+ * @param size Taille du buffer
+ * @return 0 en cas de succès, -1 si le buffer est trop petit
+ */
+int route_planner_status_message(const char* instanceId, bool online, char* payload, size_t size);
+
+/**
+ * @brief Construit le topic d'abonnement aux requêtes.
+ * @details "$share/<group>/services/route-planner/request" si un groupe est configuré : le broker
+ * répartit alors chaque requête sur une seule des instances du groupe.
+ * @param sharedGroup Groupe d'abonnement partagé (NULL ou vide : abonnement classique)
+ * @param topic Buffer de destination
+ * @param size Taille du buffer
+ * @return 0 en cas de succès, -1 si le buffer est trop petit
+ */
+int route_planner_request_subscription(const char* sharedGroup, char* topic, size_t size);
+
+
+/**
+ * @brief Définit le nombre de workers utilisés pour les requêtes par lot.
+ * @details Le pool est créé à la première requête par lot reçue.
+ * @param workerThreads Nombre de workers (0 : nombre de coeurs en ligne)
+ */
+void route_planner_set_batch_workers(int workerThreads);
+
+/**
+ * @brief Nettoie les ressources utilisées par le route planner.
+ */
+void route_planner_cleanup(void);
+
+/**
+ * @brief Enregistre les routes MQTT du route planner.
+ * @details Les réponses à nos requêtes sont transmises au request_manager, les commandes reçues
+ * sont routées d'après leur action. Les commandes de mode sont acceptées sur le topic de requête
+ * et sur ROUTE_PLANNER_BROADCAST_TOPIC.
+ * @param router Le routeur du service
+ * @param replyTopic Topic de réponse de cette instance (voir route_planner_instance_topic())
+ * @return 0 en cas de succès, -1 en cas d'erreur
+ */
+int route_planner_register_routes(mqtt_router_t* router, const char* replyTopic);
 
 
 /**
  * @brief Callback pour la réponse de la carte reçu.
+ * @details Si la demande a expiré (root NULL), le service est arrêté.
  * @param payload Payload du message reçu
  * @param user_data Données utilisateur (non utilisées ici)
  */
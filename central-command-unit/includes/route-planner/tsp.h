@@ -0,0 +1,80 @@
+/**
+ * @file tsp.h
+ * @brief Optimisation de l'ordre de passage des étapes d'un trajet multi-arrêts.
+ * @details
+ * Résout une variante "chemin ouvert" du problème du voyageur de commerce :
+ * le premier arrêt est toujours le point de départ et, optionnellement, le dernier
+ * arrêt reste le point d'arrivée. Les coûts sont asymétriques (graphe orienté).
+ * - Programmation dynamique exacte (Held-Karp) pour les petits ensembles.
+ * - Plus proche voisin puis améliorations 2-opt / Or-opt au-delà.
+ * @date 2026-10-19
+ */
+
+#ifndef TSP_H
+#define TSP_H
+
+#include "core/common.h"
+#include "core/graph.h"
+#include "route-planner/dijkstra.h"
+
+/** Nombre maximal d'arrêts résolus de manière exacte (Held-Karp, O(2^n * n^2)) */
+#define TSP_EXACT_MAX_STOPS 12
+
+/** Nombre maximal de passes d'amélioration locale pour l'heuristique */
+#define TSP_MAX_IMPROVE_PASSES 50
+
+/** Longueur maximale des segments déplacés par Or-opt */
+#define TSP_OR_OPT_MAX_SEGMENT 3
+
+/**
+ * @brief Calcule le coût d'un ordre de passage dans une matrice de distances.
+ * @param costs Matrice des coûts (count x count, ligne = origine)
+ * @param count Nombre d'arrêts
+ * @param order Ordre de passage (indices dans la matrice)
+ * @return Le coût total, ou DIJKSTRA_INFINITY si un tronçon est inaccessible
+ */
+double tsp_order_cost(const double *costs, int count, const int *order);
+
+/**
+ * @brief Calcule l'ordre de passage de coût minimal à partir d'une matrice de distances.
+ * @details L'arrêt 0 reste toujours en tête. Si fixedEnd est vrai, l'arrêt count - 1 reste en queue.
+ * Exact jusqu'à TSP_EXACT_MAX_STOPS arrêts, heuristique au-delà.
+ * @param costs Matrice des coûts (count x count, ligne = origine)
+ * @param count Nombre d'arrêts
+ * @param fixedEnd Conserve le dernier arrêt en dernière position
+ * @param order Tableau de sortie (taille count) recevant l'ordre de passage
+ * @return 0 en cas de succès, -1 en cas d'erreur
+ */
+int tsp_solve_order(const double *costs, int count, bool fixedEnd, int *order);
+
+/**
+ * @brief Réordonne les arrêts d'un trajet pour minimiser la distance totale.
+ * @details Construit la matrice des distances par des recherches one-to-many puis résout l'ordre.
+ * Si aucun ordre plus court n'est trouvé (ou si un arrêt est inaccessible),
+ * l'ordre d'origine est conservé.
+ * @param graph La carte
+ * @param nodeIds Les IDs des arrêts dans l'ordre demandé
+ * @param count Nombre d'arrêts
+ * @param fixedEnd Conserve le dernier arrêt en dernière position
+ * @param orderedIds Tableau de sortie (taille count) recevant les IDs réordonnés
+ * @param savedDistance Sortie : distance économisée par rapport à l'ordre d'origine (peut être NULL)
+ * @return 0 en cas de succès, -1 en cas d'erreur (ID inconnu, allocation, etc.)
+ */
+int tsp_optimize_stops(graph_t *graph, const int *nodeIds, int count, bool fixedEnd, int *orderedIds, double *savedDistance);
+
+/**
+ * @brief Variante de tsp_optimize_stops() qui réutilise un espace de travail Dijkstra.
+ * @details Les recherches one-to-many utilisent l'espace de travail ; la matrice des distances et
+ * les tableaux intermédiaires sont alloués dans son arène (ws->arena), sur le tas si l'espace n'en a pas.
+ * @param ws L'espace de travail (propre au thread appelant)
+ * @param graph La carte
+ * @param nodeIds Les IDs des arrêts dans l'ordre demandé
+ * @param count Nombre d'arrêts
+ * @param fixedEnd Conserve le dernier arrêt en dernière position
+ * @param orderedIds Tableau de sortie (taille count) recevant les IDs réordonnés
+ * @param savedDistance Sortie : distance économisée par rapport à l'ordre d'origine (peut être NULL)
+ * @return 0 en cas de succès, -1 en cas d'erreur (ID inconnu, allocation, etc.)
+ */
+int tsp_optimize_stops_ws(dijkstra_workspace_t *ws, graph_t *graph, const int *nodeIds, int count, bool fixedEnd, int *orderedIds, double *savedDistance);
+
+#endif // TSP_H
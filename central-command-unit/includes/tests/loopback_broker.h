@@ -0,0 +1,72 @@
+/**
+ * @file loopback_broker.h
+ * @brief Broker MQTT embarqué dans le processus, pour les tests et les benchmarks.
+ * @details
+ * Broker MQTT 3.1.1 minimal qui écoute sur 127.0.0.1 (port éphémère possible) : il remplace un
+ * Mosquitto local pour exercer les services de bout en bout sans démon externe. Pris en charge :
+ * - publication / abonnement en QoS 0, 1 et 2 (sans retransmission : la boucle locale ne perd rien) ;
+ * - jokers + et #, abonnements partagés $share/<groupe>/<filtre> (répartis tour à tour) ;
+ * - messages retenus (un payload vide supprime le message retenu du topic) ;
+ * - LWT, publié si le client disparaît sans DISCONNECT, dépasse 1,5 fois son keep-alive, est
+ *   remplacé par un client de même identifiant ou est coupé par loopback_broker_drop_client().
+ * Non pris en charge : MQTT v5 (connexion refusée), sessions persistantes, authentification, TLS.
+ * Le broker tourne dans son propre thread, sur une boucle d'événements du core.
+ * @date 2026-10-19
+ */
+#ifndef TESTS_LOOPBACK_BROKER_H
+#define TESTS_LOOPBACK_BROKER_H
+
+#include "core/common.h"
+
+#define LOOPBACK_BROKER_HOST "127.0.0.1"
+#define LOOPBACK_BROKER_MAX_PACKET_SIZE (16 * 1024 * 1024) //!< Paquet reçu au-delà : client déconnecté
+#define LOOPBACK_BROKER_MAX_PENDING_BYTES (64 * 1024 * 1024) //!< Octets en attente d'envoi au-delà : client déconnecté
+#define LOOPBACK_BROKER_CONNECT_TIMEOUT_MS 10000 //!< Délai accordé à un client pour envoyer CONNECT
+
+typedef struct loopback_broker loopback_broker_t;
+
+/**
+ * @brief Compteurs du broker depuis son démarrage.
+ */
+typedef struct {
+	uint64_t received;  //!< PUBLISH reçus des clients
+	uint64_t delivered; //!< PUBLISH transmis aux abonnés (messages retenus compris)
+	uint64_t wills;     //!< LWT publiés
+	uint32_t clients;   //!< Clients actuellement connectés
+} loopback_broker_stats_t;
+
+/**
+ * @brief Démarre un broker sur 127.0.0.1.
+ * @param port Port d'écoute (0 : port éphémère choisi par le système, voir loopback_broker_port())
+ * @return Le broker, ou NULL en cas d'erreur (port occupé, ...)
+ * @warning Le broker doit être arrêté avec loopback_broker_stop()
+ */
+loopback_broker_t *loopback_broker_start(uint16_t port);
+
+/**
+ * @brief Retourne le port d'écoute du broker.
+ */
+uint16_t loopback_broker_port(const loopback_broker_t *broker);
+
+/**
+ * @brief Coupe la connexion d'un client comme une perte réseau : son LWT est publié.
+ * @param broker Le broker
+ * @param clientId Identifiant du client
+ * @return 0 si le client était connecté, -1 sinon
+ */
+int loopback_broker_drop_client(loopback_broker_t *broker, const char *clientId);
+
+/**
+ * @brief Lit les compteurs du broker (tout thread).
+ * @param broker Le broker
+ * @param stats Compteurs à remplir
+ */
+void loopback_broker_get_stats(const loopback_broker_t *broker, loopback_broker_stats_t *stats);
+
+/**
+ * @brief Arrête le broker, ferme les connexions (sans publier les LWT) et libère ses ressources.
+ * @param broker Le broker (NULL accepté)
+ */
+void loopback_broker_stop(loopback_broker_t *broker);
+
+#endif // TESTS_LOOPBACK_BROKER_H
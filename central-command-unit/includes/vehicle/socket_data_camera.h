@@ -3,6 +3,7 @@
 
 #include "core/common.h"
 #include "core/check.h"
+#include "core/event_loop.h"
 
 #include <sys/socket.h>
 #include <netinet/in.h>
@@ -58,6 +59,8 @@ typedef struct {
     on_objects_received_callback_t callback;
     void* callbackUserData;
 
+    event_loop_t *loop; //!< Boucle pilotant le serveur (NULL : thread dédié, voir camera_server_start())
+
 } camera_socket_t;
 
 /**
@@ -79,7 +82,18 @@ int camera_server_init(camera_socket_t* cameraSocket, const char* ip, int port,
 int camera_server_start(camera_socket_t* cameraSocket);
 
 /**
- * @brief Arrête le serveur socket de la caméra et attend la fin du thread.
+ * @brief Démarre le serveur socket de la caméra dans une boucle d'événements (sans thread).
+ * @details Les sockets d'écoute et du client sont non bloquantes et surveillées par la boucle :
+ * le callback de réception est appelé dans le thread de la boucle. Un nouveau client remplace
+ * le client courant (ex : reconnexion de la caméra après une coupure non détectée).
+ * @param cameraSocket Pointeur vers la structure de la socket caméra.
+ * @param loop La boucle d'événements.
+ * @return 0 en cas de succès, -1 en cas d'erreur.
+ */
+int camera_server_attach(camera_socket_t* cameraSocket, event_loop_t* loop);
+
+/**
+ * @brief Arrête le serveur socket de la caméra et attend la fin du thread (ou le retire de sa boucle).
  * @param cameraSocket Pointeur vers la structure de la socket caméra.
  */
 void camera_server_stop(camera_socket_t* cameraSocket);
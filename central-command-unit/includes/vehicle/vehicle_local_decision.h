@@ -23,6 +23,23 @@
 
 #define WAYPOINT_REACHED_THRESHOLD_MM 200  //!< Seuil pour considérer qu'un waypoint est atteint (en mm)
 #define DETECTION_CONFIDENCE_THRESHOLD 0.50f //!< Seuil de confiance pour détecter un objet
+#define VEHICLE_STATE_PUBLISH_INTERVAL_MS 3000 //!< Période maximale de publication de l'état du véhicule
+#define VEHICLE_STATE_EXPIRY_SEC 10 //!< Validité d'un état publié (MQTT v5), au-delà il est remplacé par un plus récent
+#define WAYPOINT_RESUME_DELAY_MS 500 //!< Arrêt marqué à chaque waypoint avant de reprendre la vitesse cible
+
+/**
+ * @brief Démarre les timers de la prise de décision locale.
+ * @details Les callbacks sont appelés dans le thread qui fait avancer la roue : celui de la
+ * boucle d'événements pour le service Vehicle, comme les autres traitements de l'état.
+ * @param wheel La roue de timers du service.
+ * @return 0 en cas de succès, -1 en cas d'erreur.
+ */
+int vehicle_local_decision_start(timer_wheel_t *wheel);
+
+/**
+ * @brief Arrête les timers de la prise de décision locale.
+ */
+void vehicle_local_decision_stop(void);
 
 /**
  * @brief Traite les objets détectés par la caméra pour la prise de décision locale.
@@ -22,11 +22,14 @@
 #define VEHICLE_REQUEST_TOPIC "services/vehicle/request"
 
 /**
- * @brief Callback pour les messages de vehicle reçus.
- * @param topic Topic MQTT du message reçu.
- * @param payload Payload du message reçu.
+ * @brief Enregistre les routes MQTT du véhicule.
+ * @details Les topics "vehicles/<carId>/response" et "vehicles/<carId>/request" sont construits une
+ * seule fois ici, plutôt qu'à chaque message reçu.
+ * @param router Le routeur du service
+ * @param carId L'identifiant du véhicule
+ * @return 0 en cas de succès, -1 en cas d'erreur
  */
-void vehicle_message_callback(const char* topic, const char* payload);
+int vehicle_register_routes(mqtt_router_t* router, int carId);
 
 /**
  * @brief get_vehicle_lwt_message
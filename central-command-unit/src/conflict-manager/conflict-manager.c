@@ -9,6 +9,11 @@
 
 #include "conflict-manager/conflict-manager.h"
 
+static void on_cleanup_timer(timer_wheel_timer_t *timer, void *context) {
+	UNUSED(timer); UNUSED(context);
+	conflict_cleanup();
+}
+
 int main(int argc, char **argv) {
 	config_common_t common_config;
 
@@ -24,10 +29,14 @@ int main(int argc, char **argv) {
 	mqtt_subscribe("services/conflict-manager/request", MQTT_QOS_AT_LEAST_ONCE);
 	mqtt_subscribe("services/conflict-manager/response", MQTT_QOS_AT_LEAST_ONCE);
 
-	
+	timer_wheel_timer_t cleanupTimer;
+	timer_wheel_timer_init(&cleanupTimer, on_cleanup_timer, NULL);
+	timer_wheel_schedule(core_get_timer_wheel(), &cleanupTimer, CONFLICT_CLEANUP_INTERVAL_MS, CONFLICT_CLEANUP_INTERVAL_MS);
+
 	signal_wait_for_shutdown();
 
 	LOG_INFO_ASYNC("Shutdown signal received. Stopping Heartbeat Service...");
+	timer_wheel_cancel(core_get_timer_wheel(), &cleanupTimer);
 	core_shutdown();
 	signal_cleanup();
 	
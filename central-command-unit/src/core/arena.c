@@ -0,0 +1,150 @@
+/**
+ * @file arena.c
+ * @brief Allocateur par arène (bump allocator).
+ * @date 2026-10-19
+ */
+#include "core/arena.h"
+
+/**
+ * @brief Arrondit une taille au multiple d'alignement supérieur.
+ * @internal
+ */
+static size_t align_size(size_t size) {
+	return (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+}
+
+/**
+ * @brief Alloue un nouveau bloc d'au moins minSize octets.
+ * @internal
+ */
+static arena_block_t *arena_new_block(arena_t *arena, size_t minSize) {
+	size_t size = arena->nextBlockSize;
+	if (size < minSize) size = minSize;
+
+	arena_block_t *block = (arena_block_t *) malloc(sizeof(arena_block_t) + size);
+	if (!block) return NULL;
+
+	block->next = NULL;
+	block->size = size;
+	block->used = 0;
+
+	arena->blockCount++;
+	arena->reserved += size;
+	if (arena->nextBlockSize < ARENA_MAX_BLOCK_SIZE) {
+		arena->nextBlockSize *= 2;
+	}
+	return block;
+}
+
+/**
+ * @brief Crée une arène.
+ * @param initialBlockSize Taille du premier bloc en octets (0 pour ARENA_DEFAULT_BLOCK_SIZE)
+ * @return L'arène créée, ou NULL en cas d'erreur d'allocation
+ * @warning L'arène doit être libérée avec arena_destroy()
+ */
+arena_t *arena_create(size_t initialBlockSize) {
+	arena_t *arena = (arena_t *) malloc(sizeof(arena_t));
+	if (!arena) return NULL;
+
+	arena->blockCount = 0;
+	arena->reserved = 0;
+	arena->nextBlockSize = align_size(initialBlockSize ? initialBlockSize : ARENA_DEFAULT_BLOCK_SIZE);
+	arena->head = arena_new_block(arena, 0);
+	if (!arena->head) {
+		free(arena);
+		return NULL;
+	}
+	arena->current = arena->head;
+	return arena;
+}
+
+/**
+ * @brief Alloue une zone mémoire alignée dans l'arène.
+ * @param arena L'arène
+ * @param size Taille demandée en octets
+ * @return Pointeur vers la zone, ou NULL en cas d'erreur
+ * @note La zone n'est pas initialisée. Elle ne doit pas être libérée individuellement.
+ */
+void *arena_alloc(arena_t *arena, size_t size) {
+	if (!arena) return NULL;
+	size = align_size(size ? size : 1);
+
+	// Blocs déjà réservés (après un reset, les blocs suivants sont vides)
+	arena_block_t *block = arena->current;
+	while (block->size - block->used < size) {
+		if (!block->next) break;
+		block = block->next;
+	}
+
+	if (block->size - block->used < size) {
+		arena_block_t *newBlock = arena_new_block(arena, size);
+		if (!newBlock) return NULL;
+		block->next = newBlock;
+		block = newBlock;
+	}
+
+	arena->current = block;
+	void *ptr = block->data + block->used;
+	block->used += size;
+	return ptr;
+}
+
+/**
+ * @brief Alloue une zone mémoire initialisée à zéro dans l'arène.
+ * @param arena L'arène
+ * @param count Nombre d'éléments
+ * @param size Taille d'un élément
+ * @return Pointeur vers la zone, ou NULL en cas d'erreur (ou de dépassement)
+ */
+void *arena_calloc(arena_t *arena, size_t count, size_t size) {
+	if (size != 0 && count > SIZE_MAX / size) return NULL;
+
+	void *ptr = arena_alloc(arena, count * size);
+	if (ptr) memset(ptr, 0, count * size);
+	return ptr;
+}
+
+/**
+ * @brief Invalide toutes les allocations de l'arène en conservant ses blocs.
+ * @details Les blocs sont réutilisés par les allocations suivantes : une arène
+ * réinitialisée à chaque requête n'appelle plus malloc une fois sa taille stabilisée.
+ * @param arena L'arène
+ */
+void arena_reset(arena_t *arena) {
+	if (!arena) return;
+
+	for (arena_block_t *block = arena->head; block; block = block->next) {
+		block->used = 0;
+	}
+	arena->current = arena->head;
+}
+
+/**
+ * @brief Libère l'arène et tous ses blocs en une fois.
+ * @param arena L'arène (NULL accepté)
+ */
+void arena_destroy(arena_t *arena) {
+	if (!arena) return;
+
+	arena_block_t *block = arena->head;
+	while (block) {
+		arena_block_t *next = block->next;
+		free(block);
+		block = next;
+	}
+	free(arena);
+}
+
+/**
+ * @brief Retourne le nombre d'octets actuellement distribués par l'arène.
+ * @param arena L'arène
+ */
+size_t arena_used(const arena_t *arena) {
+	size_t used = 0;
+	if (!arena) return 0;
+
+	for (const arena_block_t *block = arena->head; block; block = block->next) {
+		used += block->used;
+	}
+	return used;
+}
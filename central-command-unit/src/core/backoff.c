@@ -0,0 +1,47 @@
+/**
+ * @file backoff.c
+ * @brief Délais de nouvelle tentative exponentiels avec gigue.
+ * @date 2026-10-19
+ */
+#include "core/backoff.h"
+
+/**
+ * @brief Initialise un état de backoff.
+ * @param backoff L'état
+ * @param minMs Délai de la première tentative (au moins 1 ms)
+ * @param maxMs Plafond du délai (ramené à minMs s'il est inférieur)
+ */
+void backoff_init(backoff_t *backoff, uint32_t minMs, uint32_t maxMs) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	backoff->minMs = minMs > 0 ? minMs : 1;
+	backoff->maxMs = maxMs > backoff->minMs ? maxMs : backoff->minMs;
+	backoff->attempt = 0;
+	// Graine propre au processus : deux services relancés ensemble tirent des délais différents
+	backoff->seed = (uint32_t) ts.tv_nsec ^ ((uint32_t) getpid() << 16);
+}
+
+/**
+ * @brief Retourne le délai avant la prochaine tentative et passe à la suivante.
+ * @param backoff L'état
+ * @return Un délai dans [d / 2, d], d = min(maxMs, minMs * 2^attempt)
+ */
+uint32_t backoff_next(backoff_t *backoff) {
+	uint64_t delay = backoff->minMs;
+	for(uint32_t i = 0; i < backoff->attempt && delay < backoff->maxMs; i++) delay *= 2;
+	if(delay > backoff->maxMs) delay = backoff->maxMs;
+	if(delay < backoff->maxMs) backoff->attempt++;
+
+	uint32_t half = (uint32_t) (delay / 2);
+	uint32_t jitter = (uint32_t) rand_r(&backoff->seed) % ((uint32_t) delay - half + 1);
+	return half + jitter;
+}
+
+/**
+ * @brief Revient au délai minimal après un succès.
+ * @param backoff L'état
+ */
+void backoff_reset(backoff_t *backoff) {
+	backoff->attempt = 0;
+}
@@ -0,0 +1,16 @@
+/**
+ * @file clock.c
+ * @brief Horloge monotone partagée par les modules du core (échéances, fenêtres, délais).
+ * @date 2026-10-19
+ */
+#include "core/clock.h"
+
+/**
+ * @brief Horloge monotone en millisecondes (CLOCK_MONOTONIC).
+ * @return Millisecondes depuis une origine arbitraire, insensible aux changements d'heure
+ */
+long clock_monotonic_ms(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000L + ts.tv_nsec / 1000000L;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file command_id.c
+ * @brief Générateur d'identifiants de commande uniques sur 64 bits.
+ * @details
+ * Un identifiant combine un identifiant de processus aléatoire, un horodatage grossier et un
+ * compteur atomique. Sous forme texte, il est encodé sur 16 chiffres hexadécimaux derrière
+ * l'action de la commande.
+ * @date 2026-10-19
+ */
+#include "core/command_id.h"
+#include <sys/random.h>
+
+#define NODE_MASK ((1ULL << COMMAND_ID_NODE_BITS) - 1)
+#define TIME_MASK ((1ULL << COMMAND_ID_TIME_BITS) - 1)
+#define COUNTER_MASK ((1ULL << COMMAND_ID_COUNTER_BITS) - 1)
+#define NODE_READY (1ULL << 63) //!< Marque l'identifiant de processus comme tiré
+
+static uint64_t nodeId = 0; //!< Identifiant de processus | NODE_READY
+static uint64_t counter = 0;
+
+static const char hexDigits[] = "0123456789abcdef";
+
+/**
+ * @brief Retourne l'identifiant du processus, tiré au premier appel.
+ * @details Plusieurs threads peuvent faire le tirage simultanément : le premier publié l'emporte.
+ * @internal
+ */
+static uint64_t node_bits(void) {
+	uint64_t node = __atomic_load_n(&nodeId, __ATOMIC_ACQUIRE);
+	if(node) return node & NODE_MASK;
+
+	uint64_t random = 0;
+	if(getrandom(&random, sizeof(random), GRND_NONBLOCK) != (ssize_t) sizeof(random)) {
+		struct timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		random = ((uint64_t) getpid() << 32) ^ (uint64_t) ts.tv_nsec ^ (uint64_t) ts.tv_sec;
+	}
+
+	uint64_t expected = 0;
+	uint64_t desired = (random & NODE_MASK) | NODE_READY;
+	__atomic_compare_exchange_n(&nodeId, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+	return __atomic_load_n(&nodeId, __ATOMIC_ACQUIRE) & NODE_MASK;
+}
+
+/**
+ * @brief Génère un nouvel identifiant.
+ * @note Thread-safe et sans verrou.
+ * @return L'identifiant (jamais 0)
+ */
+uint64_t command_id_next(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+
+	uint64_t count = __atomic_add_fetch(&counter, 1, __ATOMIC_RELAXED);
+	uint64_t id = (node_bits() << (COMMAND_ID_TIME_BITS + COMMAND_ID_COUNTER_BITS))
+		| (((uint64_t) ts.tv_sec & TIME_MASK) << COMMAND_ID_COUNTER_BITS)
+		| (count & COUNTER_MASK);
+	return id ? id : command_id_next();
+}
+
+/**
+ * @brief Écrit la forme texte "<prefix>-<16 hex>" d'un identifiant.
+ * @details Le préfixe est tronqué si nécessaire pour que la partie hexadécimale tienne toujours.
+ * @param buffer Destination (terminée par '\0')
+ * @param size Taille de la destination (au moins COMMAND_ID_HEX_DIGITS + 2)
+ * @param prefix Préfixe (action de la commande, NULL : aucun)
+ * @param id L'identifiant
+ * @return La longueur écrite, ou -1 si la destination est trop petite
+ */
+int command_id_format(char *buffer, size_t size, const char *prefix, uint64_t id) {
+	if(!buffer || size < COMMAND_ID_HEX_DIGITS + 2) return -1;
+
+	size_t prefixLength = prefix ? strnlen(prefix, size) : 0;
+	if(prefixLength > size - COMMAND_ID_HEX_DIGITS - 2) prefixLength = size - COMMAND_ID_HEX_DIGITS - 2;
+	if(prefixLength > 0) memcpy(buffer, prefix, prefixLength);
+
+	char *hex = buffer + prefixLength;
+	*hex++ = '-';
+	for(int i = COMMAND_ID_HEX_DIGITS - 1; i >= 0; i--) {
+		hex[i] = hexDigits[id & 0xF];
+		id >>= 4;
+	}
+	hex[COMMAND_ID_HEX_DIGITS] = '\0';
+	return (int) (prefixLength + 1 + COMMAND_ID_HEX_DIGITS);
+}
+
+/**
+ * @brief Relit l'identifiant de 64 bits d'une forme texte produite par command_id_format().
+ * @param commandId La chaîne
+ * @param id Identifiant lu
+ * @return 0 en cas de succès, -1 si la chaîne ne se termine pas par "-<16 hex>" (ID externe, ex : "REQ_PLAN_...")
+ */
+int command_id_parse(const char *commandId, uint64_t *id) {
+	if(!commandId || !id) return -1;
+
+	size_t length = strlen(commandId);
+	if(length < COMMAND_ID_HEX_DIGITS + 1 || commandId[length - COMMAND_ID_HEX_DIGITS - 1] != '-') return -1;
+
+	uint64_t value = 0;
+	for(const char *c = commandId + length - COMMAND_ID_HEX_DIGITS; *c; c++) {
+		int digit;
+		if(*c >= '0' && *c <= '9') digit = *c - '0';
+		else if(*c >= 'a' && *c <= 'f') digit = *c - 'a' + 10;
+		else return -1;
+		value = (value << 4) | (uint64_t) digit;
+	}
+	*id = value;
+	return 0;
+}
@@ -60,9 +60,35 @@ static int config_handler(void* user, const char* section, const char* name, con
         strncpy(config->network.clientId, value, sizeof(config->network.clientId) - 1);
         config->network.clientId[sizeof(config->network.clientId) - 1] = '\0';
         payload->tracker.clientId = true;
+    } else if (MATCH("Network", "mqtt_instance_id")) {
+        // L'identifiant compose des topics (status, réponses) : pas de séparateur ni de joker MQTT
+        if (value[0] == '\0' || strpbrk(value, "/+#$") || strlen(value) >= sizeof(config->network.instanceId)) {
+            LOG_ERROR_ASYNC("CONFIG: Invalid mqtt_instance_id '%s' in configuration.", value);
+        } else {
+            strcpy(config->network.instanceId, value);
+        }
     } else if(MATCH("Network", "mqtt_timeout_sec")) {
         config->network.timeoutSec = (uint32_t)strtoul(value, NULL, 10);
         payload->tracker.timeoutSec = true;
+    } else if (MATCH("Network", "mqtt_queue_max_messages")) {
+        config->network.offlineQueue.maxMessages = (size_t) strtoul(value, NULL, 10);
+    } else if (MATCH("Network", "mqtt_queue_max_kb")) {
+        config->network.offlineQueue.maxBytes = (size_t) strtoul(value, NULL, 10) * 1024;
+    } else if (MATCH("Network", "mqtt_queue_spool_file")) {
+        strncpy(config->network.offlineQueue.spoolPath, value, sizeof(config->network.offlineQueue.spoolPath) - 1);
+        config->network.offlineQueue.spoolPath[sizeof(config->network.offlineQueue.spoolPath) - 1] = '\0';
+    } else if (MATCH("Network", "mqtt_reconnect_min_ms")) {
+        config->network.reconnectMinMs = (uint32_t)strtoul(value, NULL, 10);
+    } else if (MATCH("Network", "mqtt_reconnect_max_ms")) {
+        config->network.reconnectMaxMs = (uint32_t)strtoul(value, NULL, 10);
+    } else if (MATCH("Network", "mqtt_protocol_version")) {
+        if (strcmp(value, "5") == 0) {
+            config->network.protocolVersion = MQTT_VERSION_5;
+        } else if (strcmp(value, "3.1.1") == 0) {
+            config->network.protocolVersion = MQTT_VERSION_3_1_1;
+        } else {
+            LOG_ERROR_ASYNC("CONFIG: Invalid mqtt_protocol_version '%s' in configuration.", value);
+        }
     } else if (MATCH("Logging", "log_level")) {
         if (log_level_from_string(value, &config->logging.logLevel) == 0) {
             payload->tracker.logLevel = true;
@@ -74,6 +100,38 @@ static int config_handler(void* user, const char* section, const char* name, con
         strncpy(config->logging.topic, value, sizeof(config->logging.topic) - 1);
         config->logging.topic[sizeof(config->logging.topic) - 1] = '\0';
         payload->tracker.topic = true;
+    } else if (MATCH("Logging", "log_overflow")) {
+        if (strcasecmp(value, "block") == 0) {
+            config->logging.overflowPolicy = LOG_OVERFLOW_BLOCK;
+        } else if (strcasecmp(value, "drop") == 0) {
+            config->logging.overflowPolicy = LOG_OVERFLOW_DROP;
+        } else {
+            LOG_ERROR_ASYNC("CONFIG: Invalid log_overflow '%s' in configuration.", value);
+        }
+    } else if (MATCH("Logging", "log_binary_file")) {
+        strncpy(config->logging.binaryFile, value, sizeof(config->logging.binaryFile) - 1);
+        config->logging.binaryFile[sizeof(config->logging.binaryFile) - 1] = '\0';
+    } else if (MATCH("Logging", "log_batch_size")) {
+        config->logging.batchSize = atoi(value);
+    } else if (MATCH("Logging", "log_batch_ms")) {
+        config->logging.batchWindowMs = atoi(value);
+    } else if (MATCH("Logging", "log_file")) {
+        strncpy(config->logging.file.path, value, sizeof(config->logging.file.path) - 1);
+        config->logging.file.path[sizeof(config->logging.file.path) - 1] = '\0';
+    } else if (MATCH("Logging", "log_file_max_kb")) {
+        config->logging.file.maxBytes = (size_t) strtoul(value, NULL, 10) * 1024;
+    } else if (MATCH("Logging", "log_file_max_files")) {
+        config->logging.file.maxFiles = atoi(value);
+    } else if (MATCH("Logging", "log_file_rotate_sec")) {
+        config->logging.file.rotateIntervalSec = atoi(value);
+    } else if (MATCH("Logging", "log_fsync")) {
+        if (log_fsync_policy_from_string(value, &config->logging.file.fsyncPolicy) != 0) {
+            LOG_ERROR_ASYNC("CONFIG: Invalid log_fsync '%s' in configuration.", value);
+        }
+    } else if (MATCH("Logging", "log_fsync_ms")) {
+        config->logging.file.fsyncIntervalMs = atoi(value);
+    } else if (MATCH("Logging", "log_console")) {
+        config->logging.console = strcasecmp(value, "false") != 0 && strcmp(value, "0") != 0;
     } else if (strcasecmp(section, "Service") == 0) {
         if (payload->service_parser && payload->service_config) {
             payload->service_parser(name, value, payload->service_config);
@@ -101,6 +159,11 @@ int parse_config_file(const char* filename, config_common_t* common, void* servi
     };
 
     memset(common, 0, sizeof(config_common_t));
+    common->logging.batchWindowMs = -1; // Fenêtre par défaut si la clé est absente
+    common->logging.file.maxFiles = LOG_FILE_DEFAULT_MAX_FILES;
+    common->logging.file.fsyncPolicy = LOG_FSYNC_INTERVAL;
+    common->logging.file.fsyncIntervalMs = LOG_FILE_DEFAULT_FSYNC_MS;
+    common->logging.console = true;
     CHECK_ALLOC(common);
 
     // Appel du parser de la bibliothèque inih
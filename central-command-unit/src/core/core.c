@@ -7,8 +7,17 @@
  */
  #include "core/core.h"
  #include "core/logger_callbacks.h"
+ #include "core/service_control.h"
 
  static char registeredServiceVersion[50] = "??? Service v?.?.?";
+ static bool eventLoopRequested = false;
+ static event_loop_t *coreEventLoop = NULL;
+ static timer_wheel_t coreTimerWheel;
+ static bool coreTimerWheelStarted = false;
+static mqtt_router_t *coreRouter = NULL;
+static core_lwt_builder_t coreLwtBuilder = NULL;
+static char coreLwtTopic[CORE_LWT_TOPIC_LENGTH];
+static char coreLwtPayload[CORE_LWT_PAYLOAD_LENGTH];
 
 
  static void print_usage(const char* program_name) {
@@ -50,9 +59,14 @@
  * @brief Initialise tous les sous systèmes du core
  * @details
  * - Parse la ligne de commande pour trouver le fichier de configuration
- * - Lit le fichier de configuration
+ * - Lit le fichier de configuration (avec mqtt_instance_id, le clientId devient "<clientId>-<instance>")
+ * - Crée la boucle d'événements si core_use_event_loop() a été appelée.
+ * - Crée le routeur des messages MQTT du service.
  * - Initialise le client MQTT et se connecte.
  * - Initialise le logger avec un callback qui log sur la console et sur le topic MQTT dédié.
+ * - S'abonne au topic de contrôle du service (services/<client_id>/control).
+ * - Démarre la roue de timers du service (dans la boucle d'événements ou dans un thread dédié).
+ * - Initialise le gestionnaire de requêtes, dont les échéances sont portées par la roue.
  * @param argc Nombre d'arguments
  * @param argv Tableau des arguments
  * @param commonConfig pointeur vers la structure commune de configuration
@@ -83,6 +97,46 @@ int core_bootstrap(
     }
     LOG_INFO_SYNC("CORE: Configuration file '%s' loaded successfully.", configPath);
 
+	// Les répliques d'un service partagent leur fichier de configuration, hormis l'instance
+	if(commonConfig->network.instanceId[0] != '\0') {
+		char clientId[sizeof(commonConfig->network.clientId)];
+		int written = snprintf(clientId, sizeof(clientId), "%s-%s", commonConfig->network.clientId, commonConfig->network.instanceId);
+		if(written < 0 || (size_t) written >= sizeof(clientId)) {
+			LOG_FATAL_SYNC("CORE: Client id too long for instance '%s'.", commonConfig->network.instanceId);
+			return -1;
+		}
+		strcpy(commonConfig->network.clientId, clientId);
+	}
+
+	if(coreLwtBuilder) {
+		if(coreLwtBuilder(commonConfig, serviceConfig, coreLwtTopic, sizeof(coreLwtTopic), coreLwtPayload, sizeof(coreLwtPayload)) != 0) {
+			LOG_FATAL_SYNC("CORE: Failed to build the LWT message.");
+			return -1;
+		}
+		lwtTopic = coreLwtTopic;
+		lwtPayload = coreLwtPayload;
+	}
+
+	if(eventLoopRequested) {
+		coreEventLoop = event_loop_create();
+		if(!coreEventLoop) {
+			LOG_FATAL_SYNC("CORE: Failed to create the event loop.");
+			return -1;
+		}
+		mqtt_use_event_loop(coreEventLoop);
+		signal_set_event_loop(coreEventLoop);
+	}
+
+	coreRouter = mqtt_router_create();
+	if(!coreRouter) {
+		LOG_FATAL_SYNC("CORE: Failed to create the MQTT router.");
+		return -1;
+	}
+	mqtt_set_router(coreRouter);
+	mqtt_set_offline_queue(&commonConfig->network.offlineQueue);
+	mqtt_set_reconnect_delay(commonConfig->network.reconnectMinMs, commonConfig->network.reconnectMaxMs);
+	mqtt_set_protocol_version(commonConfig->network.protocolVersion);
+
 	result = mqtt_connect(
 		commonConfig->network.brokerIp, 
 		commonConfig->network.brokerPort, 
@@ -101,16 +155,55 @@ int core_bootstrap(
 		return -1;
 	}
 
-	mqtt_log_callback_init(commonConfig->logging.topic, commonConfig->network.clientId);
+	mqtt_log_callback_init(commonConfig->logging.topic, commonConfig->network.clientId,
+		commonConfig->logging.batchSize, commonConfig->logging.batchWindowMs);
 	logger_destroy();
 	logger_init(commonConfig->logging.logLevel, mqtt_log_callback);
+
+	// Vidage des lots MQTT en attente au moins deux fois par fenêtre de regroupement
+	int batchWindowMs = commonConfig->logging.batchWindowMs >= 0 ? commonConfig->logging.batchWindowMs : LOG_BATCHER_DEFAULT_WINDOW_MS;
+	logger_set_flush_callback(mqtt_log_flush, batchWindowMs / 2 + 1);
+	logger_set_overflow_policy(commonConfig->logging.overflowPolicy);
+	if(commonConfig->logging.binaryFile[0] != '\0' && logger_set_binary_file(commonConfig->logging.binaryFile) != 0) {
+		LOG_WARNING_SYNC("CORE: Unable to open binary log file '%s', deferred logs will be formatted.", commonConfig->logging.binaryFile);
+	}
+	if(commonConfig->logging.file.path[0] != '\0') {
+		if(logger_set_file_sink(&commonConfig->logging.file) != 0) {
+			LOG_WARNING_SYNC("CORE: Unable to open log file '%s', logs are only published on MQTT.", commonConfig->logging.file.path);
+		} else {
+			mqtt_log_callback_set_console(commonConfig->logging.console);
+		}
+	}
 	LOG_INFO_SYNC("CORE: MQTT logger initialized successfully.");
 
-	request_manager_init();
+	// Contrôle à chaud (SET_LOG_LEVEL, ...) sur services/<client_id>/control
+	if(service_control_init(commonConfig->network.clientId) != 0) {
+		LOG_WARNING_SYNC("CORE: Unable to subscribe to the control topic, runtime log level changes are disabled.");
+	}
+
+	if(timer_wheel_init(&coreTimerWheel, TIMER_WHEEL_DEFAULT_TICK_MS, NULL) != 0
+		|| (coreEventLoop ? timer_wheel_attach(&coreTimerWheel, coreEventLoop) : timer_wheel_start_thread(&coreTimerWheel)) != 0) {
+		LOG_FATAL_SYNC("CORE: Failed to start the timer wheel.");
+		return -1;
+	}
+	coreTimerWheelStarted = true;
+
+	// Échéances et renvois des requêtes portés par la roue
+	request_manager_init(&coreTimerWheel);
 
     return 0; // Succès
 }
 
+/**
+ * @brief Remplace le LWT fixe passé à core_bootstrap() par un LWT construit d'après la configuration.
+ * @details Doit être appelée par main() avant core_bootstrap() (ex : topic de status propre à
+ * chaque instance d'un service répliqué).
+ * @param builder La fonction de construction (NULL : LWT passé à core_bootstrap())
+ */
+void core_set_lwt_builder(core_lwt_builder_t builder) {
+	coreLwtBuilder = builder;
+}
+
 /**
  * @brief Enregistre la chaîne de version du service.
  * @details Doit être appelée par main() avant core_bootstrap().
@@ -123,18 +216,93 @@ void core_set_service_version(const char* serviceVersion) {
 }
 
 
+/**
+ * @brief Demande au core d'exécuter le service dans une boucle d'événements.
+ * @details Doit être appelée par main() avant core_bootstrap(). Le client MQTT est alors piloté
+ * par la boucle (plus de thread réseau) et core_run() l'exécute jusqu'au signal d'arrêt :
+ * les callbacks MQTT et ceux enregistrés par le service dans core_get_event_loop() sont tous
+ * appelés dans le thread principal.
+ */
+void core_use_event_loop(void) {
+	eventLoopRequested = true;
+}
+
+/**
+ * @brief Retourne la boucle d'événements du service.
+ * @return La boucle, ou NULL si core_use_event_loop() n'a pas été appelée avant core_bootstrap()
+ */
+event_loop_t *core_get_event_loop(void) {
+	return coreEventLoop;
+}
+
+/**
+ * @brief Retourne la roue de timers du service.
+ * @details Les callbacks sont appelés dans la boucle d'événements si le service l'utilise,
+ * sinon dans le thread de la roue.
+ * @return La roue, ou NULL avant core_bootstrap()
+ */
+timer_wheel_t *core_get_timer_wheel(void) {
+	return coreTimerWheelStarted ? &coreTimerWheel : NULL;
+}
+
+/**
+ * @brief Retourne le routeur des messages MQTT du service.
+ * @details Les routes doivent être enregistrées avant de s'abonner aux topics concernés.
+ * Les handlers sont appelés dans le thread MQTT, ou dans la boucle d'événements si le service l'utilise.
+ * @return Le routeur, ou NULL avant core_bootstrap()
+ */
+mqtt_router_t *core_get_router(void) {
+	return coreRouter;
+}
+
+/**
+ * @brief Exécute le service jusqu'au signal d'arrêt.
+ * @details Exécute la boucle d'événements si elle est utilisée, sinon attend le signal d'arrêt
+ * (signal_wait_for_shutdown()).
+ */
+void core_run(void) {
+	if(!coreEventLoop) {
+		signal_wait_for_shutdown();
+		return;
+	}
+
+	if(event_loop_run(coreEventLoop) != 0) {
+		LOG_ERROR_SYNC("CORE: Event loop failed, shutting down.");
+	}
+}
+
 /**
  * @brief Arrête tous les sous systèmes du core
  * @details
- * - Déconnecte le client MQTT
- * - Libère les ressources allouées
  * - Arrête le système de logging
+ * - Déconnecte le client MQTT et libère le routeur
+ * - Arrête la roue de timers (les timers en attente sont abandonnés)
+ * - Libère les requêtes en attente de réponse
+ * - Libère la boucle d'événements
  * @note Cette fonction doit être appelée avant de quitter le programme.
+ * Les descripteurs enregistrés par le service dans la boucle doivent en être retirés avant.
  */
 void core_shutdown(void) {
 	LOG_INFO_SYNC("CORE: Shutting down core...");
 	logger_destroy();
 	mqtt_disconnect();
+	mqtt_set_router(NULL);
+	mqtt_router_destroy(coreRouter);
+	coreRouter = NULL;
+
+	// Après la déconnexion : plus aucune réponse ne peut annuler un timer de requête
+	if(coreTimerWheelStarted) {
+		timer_wheel_destroy(&coreTimerWheel);
+		coreTimerWheelStarted = false;
+		request_manager_destroy();
+	}
+
+	if(coreEventLoop) {
+		signal_set_event_loop(NULL);
+		mqtt_use_event_loop(NULL);
+		event_loop_destroy(coreEventLoop);
+		coreEventLoop = NULL;
+	}
 }
 
 long core_get_current_timestamp_ms(void) {
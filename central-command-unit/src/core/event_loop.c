@@ -0,0 +1,442 @@
+/**
+ * @file event_loop.c
+ * @brief Boucle d'événements (réacteur) basée sur epoll, timerfd et eventfd.
+ * @details
+ * L'eventfd de la file des tâches postées est enregistré dans epoll avec un pointeur NULL :
+ * il réveille la boucle pour les tâches postées, event_loop_wake() et event_loop_stop().
+ * Les autres entrées epoll pointent vers leur handler.
+ * @date 2026-10-19
+ */
+#include "core/event_loop.h"
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+
+/**
+ * @brief Convertit les événements de la boucle en événements epoll.
+ * @internal
+ */
+static uint32_t to_epoll_events(uint32_t events) {
+	uint32_t epollEvents = 0;
+	if(events & EVENT_LOOP_READ) epollEvents |= EPOLLIN;
+	if(events & EVENT_LOOP_WRITE) epollEvents |= EPOLLOUT;
+	return epollEvents;
+}
+
+/**
+ * @brief Convertit les événements epoll reçus en événements de la boucle.
+ * @internal
+ */
+static uint32_t from_epoll_events(uint32_t epollEvents) {
+	uint32_t events = 0;
+	if(epollEvents & EPOLLIN) events |= EVENT_LOOP_READ;
+	if(epollEvents & EPOLLOUT) events |= EVENT_LOOP_WRITE;
+	if(epollEvents & (EPOLLERR | EPOLLHUP)) events |= EVENT_LOOP_ERROR;
+	return events;
+}
+
+/**
+ * @brief Retourne le handler actif d'un descripteur.
+ * @internal
+ */
+static struct event_loop_handler *find_handler(event_loop_t *loop, int fd) {
+	for(struct event_loop_handler *handler = loop->handlers; handler; handler = handler->next) {
+		if(handler->fd == fd) return handler;
+	}
+	return NULL;
+}
+
+/**
+ * @brief Enregistre un handler dans epoll et dans la liste des handlers actifs.
+ * @internal
+ */
+static int register_handler(event_loop_t *loop, struct event_loop_handler *handler) {
+	struct epoll_event event = { .events = to_epoll_events(handler->events), .data.ptr = handler };
+	if(epoll_ctl(loop->epollFd, EPOLL_CTL_ADD, handler->fd, &event) != 0) return -1;
+
+	handler->next = loop->handlers;
+	loop->handlers = handler;
+	return 0;
+}
+
+/**
+ * @brief Retire un handler de epoll ; il est libéré à la fin de l'itération en cours.
+ * @internal
+ */
+static void unregister_handler(event_loop_t *loop, struct event_loop_handler *handler) {
+	for(struct event_loop_handler **link = &loop->handlers; *link; link = &(*link)->next) {
+		if(*link == handler) {
+			*link = handler->next;
+			break;
+		}
+	}
+	epoll_ctl(loop->epollFd, EPOLL_CTL_DEL, handler->fd, NULL);
+	if(handler->isTimer) close(handler->fd);
+
+	handler->removed = true;
+	handler->next = loop->garbage;
+	loop->garbage = handler;
+}
+
+/**
+ * @brief Libère les handlers retirés.
+ * @internal
+ */
+static void free_garbage(event_loop_t *loop) {
+	while(loop->garbage) {
+		struct event_loop_handler *next = loop->garbage->next;
+		free(loop->garbage);
+		loop->garbage = next;
+	}
+}
+
+/**
+ * @brief Acquitte le réveil et exécute les tâches postées.
+ * @details Au plus une capacité de file est traitée par itération : une tâche qui en poste
+ * d'autres ne peut pas monopoliser la boucle.
+ * @internal
+ */
+static void run_posted_tasks(event_loop_t *loop) {
+	uint64_t value;
+	if(read(loop->posted.eventFd, &value, sizeof(value)) < 0) { /* déjà acquitté */ }
+
+	// L'échange synchronise avec celui du producteur : ses tâches publiées sont visibles ci-dessous
+	__atomic_exchange_n(&loop->wakePending, 0, __ATOMIC_SEQ_CST);
+
+	size_t budget = ring_buffer_capacity(&loop->posted);
+	event_loop_post_t *post;
+	while(budget-- > 0 && (post = (event_loop_post_t *) ring_buffer_peek(&loop->posted)) != NULL) {
+		post->task(loop, post->dataSize > 0 ? (void *) post->data : NULL, post->context);
+		ring_buffer_release(&loop->posted);
+	}
+	if(!ring_buffer_is_empty(&loop->posted)) event_loop_wake(loop);
+}
+
+/**
+ * @brief Crée une boucle d'événements.
+ * @return La boucle, ou NULL en cas d'erreur
+ * @warning La boucle doit être libérée avec event_loop_destroy()
+ */
+event_loop_t *event_loop_create(void) {
+	event_loop_t *loop = (event_loop_t *) calloc(1, sizeof(event_loop_t));
+	if(!loop) return NULL;
+
+	loop->epollFd = epoll_create1(EPOLL_CLOEXEC);
+	if(loop->epollFd < 0) {
+		free(loop);
+		return NULL;
+	}
+
+	if(ring_buffer_init_slots(&loop->posted, EVENT_LOOP_POST_CAPACITY, sizeof(event_loop_post_t), true) != 0) {
+		close(loop->epollFd);
+		free(loop);
+		return NULL;
+	}
+
+	struct epoll_event event = { .events = EPOLLIN, .data.ptr = NULL };
+	if(epoll_ctl(loop->epollFd, EPOLL_CTL_ADD, loop->posted.eventFd, &event) != 0) {
+		ring_buffer_destroy(&loop->posted);
+		close(loop->epollFd);
+		free(loop);
+		return NULL;
+	}
+
+	loop->ownerThread = pthread_self();
+	return loop;
+}
+
+/**
+ * @brief Libère la boucle et ses handlers (les descripteurs surveillés ne sont pas fermés).
+ * @param loop La boucle (NULL accepté)
+ * @note Les tâches postées non exécutées sont abandonnées.
+ */
+void event_loop_destroy(event_loop_t *loop) {
+	if(!loop) return;
+
+	while(loop->handlers) unregister_handler(loop, loop->handlers);
+	free_garbage(loop);
+	ring_buffer_destroy(&loop->posted);
+	close(loop->epollFd);
+	free(loop);
+}
+
+/**
+ * @brief Exécute la boucle jusqu'à l'appel de event_loop_stop().
+ * @param loop La boucle
+ * @return 0 après un arrêt demandé, -1 en cas d'erreur
+ */
+int event_loop_run(event_loop_t *loop) {
+	if(!loop) return -1;
+
+	int result = 0;
+	while(!__atomic_load_n(&loop->stopRequested, __ATOMIC_ACQUIRE)) {
+		if(event_loop_run_once(loop, -1) < 0) {
+			result = -1;
+			break;
+		}
+	}
+	__atomic_store_n(&loop->stopRequested, 0, __ATOMIC_RELAXED);
+	return result;
+}
+
+/**
+ * @brief Attend des événements au plus timeoutMs millisecondes et les traite.
+ * @param loop La boucle
+ * @param timeoutMs Délai maximal d'attente (-1 : infini, 0 : aucune attente)
+ * @return Le nombre d'événements traités, ou -1 en cas d'erreur
+ */
+int event_loop_run_once(event_loop_t *loop, int timeoutMs) {
+	if(!loop) return -1;
+	loop->ownerThread = pthread_self();
+
+	for(int i = 0; i < loop->prepareCount; i++) {
+		loop->prepare[i](loop, loop->prepareContext[i]);
+	}
+
+	struct epoll_event events[EVENT_LOOP_MAX_EVENTS];
+	int count = epoll_wait(loop->epollFd, events, EVENT_LOOP_MAX_EVENTS, timeoutMs);
+	if(count < 0) return errno == EINTR ? 0 : -1;
+
+	for(int i = 0; i < count; i++) {
+		struct event_loop_handler *handler = (struct event_loop_handler *) events[i].data.ptr;
+		if(!handler) {
+			run_posted_tasks(loop);
+			continue;
+		}
+		if(handler->removed) continue; // Retiré par un callback précédent de cette itération
+
+		if(handler->isTimer) {
+			uint64_t expirations;
+			if(read(handler->fd, &expirations, sizeof(expirations)) == sizeof(expirations)) {
+				handler->timerCallback(loop, handler, handler->context);
+			}
+		} else {
+			handler->callback(loop, handler->fd, from_epoll_events(events[i].events), handler->context);
+		}
+	}
+
+	free_garbage(loop);
+	return count;
+}
+
+/**
+ * @brief Demande l'arrêt de event_loop_run() (tout thread, gestionnaire de signal).
+ * @param loop La boucle
+ */
+void event_loop_stop(event_loop_t *loop) {
+	if(!loop) return;
+
+	// Uniquement des opérations async-signal-safe : écriture atomique et write()
+	__atomic_store_n(&loop->stopRequested, 1, __ATOMIC_RELEASE);
+	ring_buffer_wake(&loop->posted);
+}
+
+/**
+ * @brief Réveille la boucle si elle attend (tout thread).
+ * @details Les fonctions de préparation sont rappelées avant la prochaine attente.
+ * @param loop La boucle
+ */
+void event_loop_wake(event_loop_t *loop) {
+	if(!loop) return;
+
+	// Un seul write() tant que la boucle n'a pas acquitté le réveil précédent
+	if(__atomic_exchange_n(&loop->wakePending, 1, __ATOMIC_SEQ_CST) == 0) {
+		ring_buffer_wake(&loop->posted);
+	}
+}
+
+/**
+ * @brief Indique si l'appelant est le thread qui exécute la boucle.
+ */
+bool event_loop_in_loop_thread(const event_loop_t *loop) {
+	return loop && pthread_equal(loop->ownerThread, pthread_self());
+}
+
+/**
+ * @brief Surveille un descripteur.
+ * @param loop La boucle
+ * @param fd Le descripteur (de préférence non bloquant)
+ * @param events Combinaison de EVENT_LOOP_READ et EVENT_LOOP_WRITE
+ * @param callback Fonction appelée lorsque le descripteur est prêt
+ * @param context Contexte transmis au callback
+ * @return 0 en cas de succès, -1 en cas d'erreur (descripteur déjà surveillé, ...)
+ */
+int event_loop_add_fd(event_loop_t *loop, int fd, uint32_t events, event_loop_fd_callback_t callback, void *context) {
+	if(!loop || fd < 0 || !callback || find_handler(loop, fd)) return -1;
+
+	struct event_loop_handler *handler = (struct event_loop_handler *) calloc(1, sizeof(struct event_loop_handler));
+	if(!handler) return -1;
+
+	handler->fd = fd;
+	handler->events = events;
+	handler->callback = callback;
+	handler->context = context;
+	if(register_handler(loop, handler) != 0) {
+		free(handler);
+		return -1;
+	}
+	return 0;
+}
+
+/**
+ * @brief Modifie les événements surveillés sur un descripteur.
+ * @param loop La boucle
+ * @param fd Le descripteur
+ * @param events Combinaison de EVENT_LOOP_READ et EVENT_LOOP_WRITE
+ * @return 0 en cas de succès, -1 si le descripteur n'est pas surveillé
+ */
+int event_loop_modify_fd(event_loop_t *loop, int fd, uint32_t events) {
+	if(!loop) return -1;
+
+	struct event_loop_handler *handler = find_handler(loop, fd);
+	if(!handler || handler->isTimer) return -1;
+	if(handler->events == events) return 0;
+
+	struct epoll_event event = { .events = to_epoll_events(events), .data.ptr = handler };
+	if(epoll_ctl(loop->epollFd, EPOLL_CTL_MOD, fd, &event) != 0) return -1;
+	handler->events = events;
+	return 0;
+}
+
+/**
+ * @brief Arrête de surveiller un descripteur (appelable depuis un callback).
+ * @param loop La boucle
+ * @param fd Le descripteur (il n'est pas fermé)
+ * @return 0 en cas de succès, -1 si le descripteur n'est pas surveillé
+ * @warning Retirer le descripteur avant de le fermer.
+ */
+int event_loop_remove_fd(event_loop_t *loop, int fd) {
+	if(!loop) return -1;
+
+	struct event_loop_handler *handler = find_handler(loop, fd);
+	if(!handler || handler->isTimer) return -1;
+	unregister_handler(loop, handler);
+	return 0;
+}
+
+/**
+ * @brief Crée un timer.
+ * @param loop La boucle
+ * @param initialMs Délai avant la première expiration (0 : timer créé désarmé)
+ * @param intervalMs Période des expirations suivantes (0 : timer ponctuel)
+ * @param callback Fonction appelée à chaque expiration
+ * @param context Contexte transmis au callback
+ * @return Le timer, ou NULL en cas d'erreur
+ * @note Un timer ponctuel reste enregistré après son expiration : il peut être réarmé avec
+ * event_loop_timer_set() et doit être libéré avec event_loop_cancel_timer().
+ */
+event_loop_timer_t *event_loop_add_timer(event_loop_t *loop, int initialMs, int intervalMs, event_loop_timer_callback_t callback, void *context) {
+	if(!loop || !callback || initialMs < 0 || intervalMs < 0) return NULL;
+
+	struct event_loop_handler *timer = (struct event_loop_handler *) calloc(1, sizeof(struct event_loop_handler));
+	if(!timer) return NULL;
+
+	timer->fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	if(timer->fd < 0) {
+		free(timer);
+		return NULL;
+	}
+	timer->isTimer = true;
+	timer->events = EVENT_LOOP_READ;
+	timer->timerCallback = callback;
+	timer->context = context;
+
+	if(event_loop_timer_set(timer, initialMs, intervalMs) != 0 || register_handler(loop, timer) != 0) {
+		close(timer->fd);
+		free(timer);
+		return NULL;
+	}
+	return timer;
+}
+
+/**
+ * @brief Réarme (ou désarme) un timer.
+ * @param timer Le timer
+ * @param initialMs Délai avant la prochaine expiration (0 : désarme le timer)
+ * @param intervalMs Période des expirations suivantes (0 : ponctuel)
+ * @return 0 en cas de succès, -1 en cas d'erreur
+ */
+int event_loop_timer_set(event_loop_timer_t *timer, int initialMs, int intervalMs) {
+	if(!timer || !timer->isTimer || timer->removed || initialMs < 0 || intervalMs < 0) return -1;
+
+	struct itimerspec spec = {
+		.it_value = { .tv_sec = initialMs / 1000, .tv_nsec = (initialMs % 1000) * 1000000L },
+		.it_interval = { .tv_sec = intervalMs / 1000, .tv_nsec = (intervalMs % 1000) * 1000000L },
+	};
+	return timerfd_settime(timer->fd, 0, &spec, NULL) == 0 ? 0 : -1;
+}
+
+/**
+ * @brief Supprime un timer (appelable depuis son propre callback).
+ * @param loop La boucle
+ * @param timer Le timer (NULL accepté)
+ */
+void event_loop_cancel_timer(event_loop_t *loop, event_loop_timer_t *timer) {
+	if(!loop || !timer || !timer->isTimer || timer->removed) return;
+	unregister_handler(loop, timer);
+}
+
+/**
+ * @brief Poste une tâche à exécuter dans le thread de la boucle (tout thread, sans allocation).
+ * @param loop La boucle
+ * @param task La tâche
+ * @param context Contexte transmis à la tâche
+ * @param data Données copiées avec la tâche (NULL si dataSize vaut 0)
+ * @param dataSize Taille des données, au plus EVENT_LOOP_POST_DATA_SIZE
+ * @return 0 en cas de succès, -1 si la file est pleine ou les données trop grandes
+ */
+int event_loop_post(event_loop_t *loop, event_loop_task_t task, void *context, const void *data, size_t dataSize) {
+	if(!loop || !task || dataSize > EVENT_LOOP_POST_DATA_SIZE || (dataSize > 0 && !data)) return -1;
+
+	event_loop_post_t *post = (event_loop_post_t *) ring_buffer_claim(&loop->posted);
+	if(!post) {
+		__atomic_fetch_add(&loop->postDropped, 1, __ATOMIC_RELAXED);
+		return -1;
+	}
+
+	post->task = task;
+	post->context = context;
+	post->dataSize = dataSize;
+	if(dataSize > 0) memcpy(post->data, data, dataSize);
+	ring_buffer_publish(&loop->posted, post);
+
+	event_loop_wake(loop);
+	return 0;
+}
+
+/**
+ * @brief Enregistre une fonction appelée avant chaque attente de la boucle.
+ * @param loop La boucle
+ * @param prepare La fonction
+ * @param context Contexte transmis à la fonction
+ * @return 0 en cas de succès, -1 si EVENT_LOOP_MAX_PREPARE fonctions sont déjà enregistrées
+ */
+int event_loop_add_prepare(event_loop_t *loop, event_loop_prepare_t prepare, void *context) {
+	if(!loop || !prepare || loop->prepareCount >= EVENT_LOOP_MAX_PREPARE) return -1;
+
+	loop->prepare[loop->prepareCount] = prepare;
+	loop->prepareContext[loop->prepareCount] = context;
+	loop->prepareCount++;
+	return 0;
+}
+
+/**
+ * @brief Retire une fonction de préparation.
+ * @param loop La boucle
+ * @param prepare La fonction
+ * @param context Contexte fourni à event_loop_add_prepare()
+ */
+void event_loop_remove_prepare(event_loop_t *loop, event_loop_prepare_t prepare, void *context) {
+	if(!loop) return;
+
+	for(int i = 0; i < loop->prepareCount; i++) {
+		if(loop->prepare[i] == prepare && loop->prepareContext[i] == context) {
+			for(int j = i + 1; j < loop->prepareCount; j++) {
+				loop->prepare[j - 1] = loop->prepare[j];
+				loop->prepareContext[j - 1] = loop->prepareContext[j];
+			}
+			loop->prepareCount--;
+			return;
+		}
+	}
+}
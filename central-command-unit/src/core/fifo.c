@@ -2,14 +2,12 @@
  * @file fifo.c
  * @brief File d'attente FIFO (First In, First Out)
  * Module fournissant une implémentation simple d'une file d'attente FIFO.
- * Implémentation basée sur le principe de liste chaînée.
+ * Implémentation basée sur le principe de liste chaînée, protégée par un verrou propre à chaque file.
  * @author Lukas Grando
  * @date 2025-10-18
  */
 #include "core/fifo.h"
 
-sem_t lockSem;
-
 /**
  * @brief Initialise une file d'attente FIFO
  */
@@ -17,7 +15,7 @@ void fifo_init(fifo_t *fifo) {
 	fifo->head = NULL;
 	fifo->tail = NULL;
 	fifo->size = 0;
-	sem_init(&lockSem, 0, 1);
+	CHECK_PTHREAD_RAW(pthread_mutex_init(&fifo->lock, NULL));
 }
 
 /**
@@ -25,21 +23,27 @@ void fifo_init(fifo_t *fifo) {
  * @return true si la file est vide, false sinon
  */
 bool fifo_is_empty(fifo_t *fifo) {
-	return fifo->size == 0;
+	pthread_mutex_lock(&fifo->lock);
+	bool empty = fifo->size == 0;
+	pthread_mutex_unlock(&fifo->lock);
+	return empty;
 }
 
 /**
  * @brief Ajoute un élément à la fin de la file d'attente
  * @param fifo La file d'attente
- * @param data Le pointeur vers les données à ajouter
+ * @param data Le pointeur vers les données à ajouter (NULL est ignoré)
  */
 void fifo_push(fifo_t *fifo, void *data) {
-	sem_wait(&lockSem);
+	if (!data) return;
+
+	// Allocation hors section critique
 	fifo_node_t *node = malloc(sizeof(fifo_node_t));
 	CHECK_ALLOC_RAW(node);
 	node->data = data;
 	node->next = NULL;
 
+	pthread_mutex_lock(&fifo->lock);
 	if (fifo->tail) {
 		fifo->tail->next = node;
 	}
@@ -49,7 +53,7 @@ void fifo_push(fifo_t *fifo, void *data) {
 		fifo->head = node;
 	}
 	fifo->size++;
-	sem_post(&lockSem);
+	pthread_mutex_unlock(&fifo->lock);
 }
 
 /**
@@ -58,17 +62,21 @@ void fifo_push(fifo_t *fifo, void *data) {
  * @return Le pointeur vers les données de l'élément supprimé, ou NULL si la file est vide
  */
 void *fifo_pop(fifo_t *fifo) {
-	sem_wait(&lockSem);
-    if (fifo->head == NULL) return NULL;
+	pthread_mutex_lock(&fifo->lock);
+	fifo_node_t *node = fifo->head;
+	if (node == NULL) {
+		pthread_mutex_unlock(&fifo->lock);
+		return NULL;
+	}
 
-    fifo_node_t *node = fifo->head;
-    void *data = node->data;
-    fifo->head = node->next;
-    if (fifo->head == NULL) fifo->tail = NULL;
-    free(node);
+	fifo->head = node->next;
+	if (fifo->head == NULL) fifo->tail = NULL;
 	fifo->size--;
-	sem_post(&lockSem);
-    return data;
+	pthread_mutex_unlock(&fifo->lock);
+
+	void *data = node->data;
+	free(node);
+	return data;
 }
 
 /**
@@ -85,7 +93,7 @@ void fifo_destroy(fifo_t *fifo) {
 	fifo->head = NULL;
 	fifo->tail = NULL;
 	fifo->size = 0;
-	sem_destroy(&lockSem);
+	pthread_mutex_destroy(&fifo->lock);
 }
 
 
@@ -6,20 +6,34 @@
 
 /**
  * @brief Crée et alloue un nouveau graphe avec un nombre fixe de noeuds.
- * @details Alloue le graphe et le tableau de noeuds. Les noeuds sont initialisés
+ * @details Alloue le graphe et le tableau de noeuds dans une arène dédiée,
+ * dimensionnée pour accueillir aussi les arcs. Les noeuds sont initialisés
  * avec leur ID correspondant à leur index.
  * @param numNodes Le nombre total de noeuds que ce graphe contiendra.
  * @return Pointeur vers le graphe alloué, ou NULL si échec.
  */
 graph_t* graph_create(int numNodes) {
-	graph_t *graph = (graph_t *)malloc(sizeof(graph_t));
+	if (numNodes < 0) {
+		return NULL;
+	}
+
+	// Premier bloc : graphe + noeuds + GRAPH_EDGES_PER_NODE_HINT arcs par noeud
+	size_t hint = sizeof(graph_t) + (size_t)numNodes * (sizeof(node_t) + GRAPH_EDGES_PER_NODE_HINT * sizeof(edge_t));
+	arena_t *arena = arena_create(hint > ARENA_DEFAULT_BLOCK_SIZE ? hint : ARENA_DEFAULT_BLOCK_SIZE);
+	if (!arena) {
+		return NULL;
+	}
+
+	graph_t *graph = (graph_t *)arena_alloc(arena, sizeof(graph_t));
 	if (!graph) {
+		arena_destroy(arena);
 		return NULL;
 	}
-	graph->nodes = (node_t *)malloc(sizeof(node_t) * numNodes);
+	graph->arena = arena;
+	graph->nodes = (node_t *)arena_alloc(arena, sizeof(node_t) * numNodes);
 	
 	if (!graph->nodes) {
-		free(graph);
+		arena_destroy(arena);
 		return NULL;
 	}
 
@@ -40,25 +54,14 @@ graph_t* graph_create(int numNodes) {
 
 /**
  * @brief Détruit le graphe et libère toute la mémoire associée.
- * @details Libère le graphe, le tableau de noeuds, et toutes les arêtes.
+ * @details Libère le graphe, le tableau de noeuds, et toutes les arêtes en détruisant son arène.
  * @param graph Le graphe à détruire.
  */
 void graph_destroy(graph_t* graph) {
 	if (!graph) return;
 
-	// Libération des arêtes
-	for (int i = 0; i < graph->numNodes; i++) {
-		edge_t* edge = graph->nodes[i].edges;
-		while (edge) {
-			edge_t* nextEdge = edge->nextEdge;
-			free(edge);
-			edge = nextEdge;
-		}
-	}
-	
-	// Libération des noeuds et du graphe
-	free(graph->nodes);
-	free(graph);
+	// Le graphe, les noeuds et les arcs vivent tous dans l'arène
+	arena_destroy(graph->arena);
 }
 
 /**
@@ -96,7 +99,7 @@ bool graph_add_edge(graph_t* graph, int originNodeId, int targetNodeId, double w
 		return false;
 	}
 
-	edge_t* newEdge = (edge_t*)malloc(sizeof(edge_t));
+	edge_t* newEdge = (edge_t*)arena_alloc(graph->arena, sizeof(edge_t));
 	if (!newEdge) {
 		return false;
 	}
@@ -124,12 +127,17 @@ node_t* graph_get_node(graph_t* graph, int index) {
 
 /**
  * @brief Récupère un pointeur vers un noeud par son ID.
- * @details Parcourt le tableau des noeuds pour trouver celui avec l'ID donné.
+ * @details Les IDs correspondent le plus souvent à l'index du noeud (graph_create) :
+ * ce cas est vérifié en O(1) avant de parcourir le tableau des noeuds.
  * @param graph Le graphe.
  * @param nodeId L'ID du noeud à rechercher.
  * @return Pointeur vers le node_t, ou NULL si l'ID n'existe pas.
  */
 node_t *graph_get_node_by_id(graph_t *graph, int nodeId) {
+	if (nodeId >= 0 && nodeId < graph->numNodes && graph->nodes[nodeId].id == nodeId) {
+		return &graph->nodes[nodeId];
+	}
+
 	for (int i = 0; i < graph->numNodes; i++) {
 		if (graph->nodes[i].id == nodeId) {
 			return &graph->nodes[i];
@@ -142,13 +150,14 @@ node_t *graph_get_node_by_id(graph_t *graph, int nodeId) {
  * @brief Libère la mémoire d'un chemin
  */
 void path_destroy(path_t* path) {
-	if (!path) return;
+	if (!path || path->arena) return;
 	free(path->nodes);
 }
 
 /**
  * @brief Concatène un chemin (src) à la fin d'un chemin (dest).
- * @details Modifie dest en place en réallouant son tableau de nœuds.
+ * @details Modifie dest en place en réallouant son tableau de nœuds
+ * (dans l'arène de dest si elle en a une).
  * Si le dernier nœud de dest est le même que le premier de src,
  * le doublon est automatiquement supprimé.
  * @param dest Le chemin à étendre (sera modifié).
@@ -174,15 +183,127 @@ void path_append(path_t* dest, const path_t* src) {
 	}
 
 	int newLength = dest->length + nodesToAdd;
-	node_t** newNodes = (node_t**)realloc(dest->nodes, sizeof(node_t*) * newLength);
-	if(!newNodes) {
+	if(!path_reserve(dest, newLength)) {
 		return;
 	}
-	dest->nodes = newNodes;
 	memcpy(dest->nodes + dest->length, src->nodes + startIndex,sizeof(node_t*) * nodesToAdd);
 	dest->length = newLength;
 }
 
+/**
+ * @brief Garantit qu'un chemin peut contenir au moins minCapacity nœuds.
+ * @details La capacité est au moins doublée à chaque croissance (coût amorti constant).
+ * @param path Le chemin.
+ * @param minCapacity Capacité minimale voulue.
+ * @return true si succès, false en cas d'erreur d'allocation (le chemin est inchangé).
+ */
+bool path_reserve(path_t* path, int minCapacity) {
+	if(!path) {
+		return false;
+	}
+
+	// Un chemin construit à la main peut avoir un tableau sans capacité renseignée
+	int capacity = path->capacity > path->length ? path->capacity : path->length;
+	if(minCapacity <= capacity) {
+		return true;
+	}
+
+	int newCapacity = capacity > 0 ? capacity * 2 : PATH_INITIAL_CAPACITY;
+	if(newCapacity < minCapacity) {
+		newCapacity = minCapacity;
+	}
+
+	node_t** newNodes = NULL;
+	if(path->arena) {
+		// Pas de realloc dans une arène : nouvelle zone, l'ancienne est libérée avec l'arène
+		newNodes = (node_t**)arena_alloc(path->arena, sizeof(node_t*) * newCapacity);
+		if(newNodes && path->length > 0) {
+			memcpy(newNodes, path->nodes, sizeof(node_t*) * path->length);
+		}
+	} else {
+		newNodes = (node_t**)realloc(path->nodes, sizeof(node_t*) * newCapacity);
+	}
+	if(!newNodes) {
+		return false;
+	}
+
+	path->nodes = newNodes;
+	path->capacity = newCapacity;
+	return true;
+}
+
+/**
+ * @brief Ajoute un nœud à la fin d'un chemin.
+ * @param path Le chemin.
+ * @param node Le nœud à ajouter.
+ * @return true si succès, false en cas d'erreur d'allocation.
+ */
+bool path_push(path_t* path, node_t* node) {
+	if(!path || path->length < 0 || !path_reserve(path, path->length + 1)) {
+		return false;
+	}
+	path->nodes[path->length++] = node;
+	return true;
+}
+
+/**
+ * @brief Inverse l'ordre des nœuds d'un chemin, en place.
+ * @param path Le chemin.
+ */
+void path_reverse(path_t* path) {
+	if(!path || path->length <= 1) {
+		return;
+	}
+
+	for(int i = 0, j = path->length - 1; i < j; i++, j--) {
+		node_t* tmp = path->nodes[i];
+		path->nodes[i] = path->nodes[j];
+		path->nodes[j] = tmp;
+	}
+}
+
+/**
+ * @brief Produit le tableau des IDs des nœuds d'un chemin.
+ * @param path Le chemin.
+ * @param arena Arène dans laquelle allouer le tableau (NULL : tas, à libérer avec free()).
+ * @return Le tableau de path->length IDs, ou NULL si le chemin est vide ou en cas d'erreur.
+ */
+int* path_emit_ids(const path_t* path, arena_t* arena) {
+	if(!path || path->length <= 0) {
+		return NULL;
+	}
+
+	int* ids = arena ? (int*)arena_alloc(arena, sizeof(int) * path->length) : (int*)malloc(sizeof(int) * path->length);
+	if(!ids) {
+		return NULL;
+	}
+
+	for(int i = 0; i < path->length; i++) {
+		ids[i] = path->nodes[i]->id;
+	}
+	return ids;
+}
+
+/**
+ * @brief Trouve l'arête (orientée) partant d'un nœud vers un autre nœud.
+ * @details Comparaison directe des pointeurs : indépendant des IDs et des index.
+ * @param origin Le nœud d'origine.
+ * @param target Le nœud de destination.
+ * @return Pointeur vers l'edge_t, ou NULL si non trouvée.
+ */
+edge_t* node_get_edge_to(const node_t* origin, const node_t* target) {
+	if(!origin || !target) {
+		return NULL;
+	}
+
+	for(edge_t* edge = origin->edges; edge; edge = edge->nextEdge) {
+		if(edge->targetNode == target) {
+			return edge;
+		}
+	}
+	return NULL;
+}
+
 /**
  * @brief Trouve l'arête (orientée) entre deux nœuds.
  * @param graph Le graphe.
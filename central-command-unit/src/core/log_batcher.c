@@ -0,0 +1,108 @@
+/**
+ * @file log_batcher.c
+ * @brief Regroupement des messages de log avant publication (fenêtre temporelle + taille maximale).
+ * @date 2026-10-19
+ */
+#include "core/log_batcher.h"
+
+/**
+ * @brief Empreinte FNV-1a d'un message.
+ * @internal
+ */
+static uint32_t message_hash(const char *message) {
+	uint32_t hash = 2166136261u;
+	for(const unsigned char *c = (const unsigned char *) message; *c; c++) {
+		hash ^= *c;
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+/**
+ * @brief Initialise un regroupeur.
+ * @param batcher Le regroupeur
+ * @param maxEntries Taille maximale d'un lot (bornée à LOG_BATCHER_MAX_ENTRIES, 1 : pas de regroupement)
+ * @param windowMs Durée maximale d'attente d'un lot en millisecondes
+ * @param publish Fonction de publication
+ * @param context Contexte transmis à publish
+ */
+void log_batcher_init(log_batcher_t *batcher, int maxEntries, int windowMs, log_batch_publish_t publish, void *context) {
+	if(!batcher) return;
+
+	memset(batcher, 0, sizeof(*batcher));
+	batcher->maxEntries = maxEntries < 1 ? 1 : (maxEntries > LOG_BATCHER_MAX_ENTRIES ? LOG_BATCHER_MAX_ENTRIES : maxEntries);
+	batcher->windowMs = windowMs < 0 ? 0 : windowMs;
+	batcher->publish = publish;
+	batcher->context = context;
+}
+
+/**
+ * @brief Ajoute un message au lot (publie le lot s'il est plein ou si le message est une erreur).
+ * @param batcher Le regroupeur
+ * @param level Niveau du message
+ * @param message Texte du message
+ * @param nowMs Horodatage courant (ms, horloge monotone)
+ * @param timestamp Horodatage du message (secondes)
+ */
+void log_batcher_add(log_batcher_t *batcher, log_level_t level, const char *message, long nowMs, long timestamp) {
+	if(!batcher || !message) return;
+	batcher->received++;
+
+	// Un lot dont la fenêtre est écoulée part avant d'accueillir le nouveau message
+	log_batcher_tick(batcher, nowMs);
+
+	uint32_t hash = message_hash(message);
+	log_batch_entry_t *entry = NULL;
+	for(int i = 0; i < batcher->count; i++) {
+		log_batch_entry_t *candidate = &batcher->entries[i];
+		if(candidate->hash == hash && candidate->level == level && strcmp(candidate->message, message) == 0) {
+			entry = candidate;
+			break;
+		}
+	}
+
+	if(entry) {
+		entry->count++;
+		entry->lastTimestamp = timestamp;
+	} else {
+		if(batcher->count == 0) batcher->windowStartMs = nowMs;
+		entry = &batcher->entries[batcher->count++];
+		entry->level = level;
+		entry->hash = hash;
+		entry->count = 1;
+		entry->firstTimestamp = timestamp;
+		entry->lastTimestamp = timestamp;
+		strncpy(entry->message, message, LOG_MESSAGE_LENGTH - 1);
+		entry->message[LOG_MESSAGE_LENGTH - 1] = '\0';
+	}
+
+	if(level >= LOG_LEVEL_ERROR || batcher->count >= batcher->maxEntries) {
+		log_batcher_flush(batcher);
+	}
+}
+
+/**
+ * @brief Publie le lot en cours si sa fenêtre est écoulée.
+ * @param batcher Le regroupeur
+ * @param nowMs Horodatage courant (ms, horloge monotone)
+ */
+void log_batcher_tick(log_batcher_t *batcher, long nowMs) {
+	if(!batcher || batcher->count == 0) return;
+	if(nowMs - batcher->windowStartMs >= batcher->windowMs) {
+		log_batcher_flush(batcher);
+	}
+}
+
+/**
+ * @brief Publie le lot en cours (s'il n'est pas vide).
+ * @param batcher Le regroupeur
+ */
+void log_batcher_flush(log_batcher_t *batcher) {
+	if(!batcher || batcher->count == 0) return;
+
+	if(batcher->publish) {
+		batcher->publish(batcher->entries, batcher->count, batcher->context);
+	}
+	batcher->published++;
+	batcher->count = 0;
+}
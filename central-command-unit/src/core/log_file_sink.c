@@ -0,0 +1,248 @@
+/**
+ * @file log_file_sink.c
+ * @brief Écriture des messages de log dans un fichier local, par lots (writev), avec rotation.
+ * @date 2026-10-19
+ */
+#include "core/log_file_sink.h"
+#include "core/clock.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <strings.h>
+#include <sys/stat.h>
+
+static char lineEnd[] = "\n";
+
+/**
+ * @brief Ouvre le fichier courant en ajout.
+ * @internal
+ */
+static int open_current(log_file_sink_t *sink, bool truncate) {
+	int flags = O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC | (truncate ? O_TRUNC : 0);
+	sink->fd = open(sink->config.path, flags, 0644);
+	if(sink->fd < 0) return -1;
+
+	struct stat st;
+	sink->fileSize = fstat(sink->fd, &st) == 0 ? (size_t) st.st_size : 0;
+	sink->openedAtMs = clock_monotonic_ms();
+	sink->dirty = false;
+	return 0;
+}
+
+/**
+ * @brief Synchronise le fichier courant sur le disque.
+ * @internal
+ */
+static void sync_current(log_file_sink_t *sink, long nowMs) {
+	if(sink->fd >= 0 && sink->dirty) fdatasync(sink->fd);
+	sink->dirty = false;
+	sink->lastSyncMs = nowMs;
+}
+
+/**
+ * @brief Indique si la durée de vie du fichier courant est écoulée.
+ * @internal
+ */
+static bool rotation_due(const log_file_sink_t *sink, long nowMs) {
+	if(sink->fd < 0 || sink->fileSize == 0) return false;
+	if(sink->config.maxBytes > 0 && sink->fileSize >= sink->config.maxBytes) return true;
+	return sink->config.rotateIntervalSec > 0 && nowMs - sink->openedAtMs >= sink->config.rotateIntervalSec * 1000L;
+}
+
+/**
+ * @brief Ouvre (en ajout) le fichier d'un journal.
+ * @param sink Le journal
+ * @param config Configuration (copiée)
+ * @return 0 en cas de succès, -1 si le fichier ne peut pas être ouvert
+ */
+int log_file_sink_open(log_file_sink_t *sink, const log_file_sink_config_t *config) {
+	if(!sink || !config || config->path[0] == '\0') return -1;
+
+	memset(sink, 0, sizeof(*sink));
+	sink->config = *config;
+	sink->cachedSecond = (time_t) -1;
+	if(open_current(sink, false) != 0) return -1;
+	sink->lastSyncMs = sink->openedAtMs;
+	return 0;
+}
+
+/**
+ * @brief Ajoute une ligne au lot en cours (écrit le lot s'il est plein).
+ * @param sink Le journal
+ * @param level Niveau du message
+ * @param timestampNs Horodatage du message (ns depuis l'epoch)
+ * @param message Texte du message, qui doit rester valide jusqu'à log_file_sink_commit()
+ */
+void log_file_sink_add(log_file_sink_t *sink, log_level_t level, uint64_t timestampNs, const char *message) {
+	if(sink->lineCount == LOG_FILE_SINK_MAX_LINES) log_file_sink_commit(sink, clock_monotonic_ms());
+
+	// La date n'est reformatée qu'une fois par seconde
+	time_t second = (time_t) (timestampNs / 1000000000ULL);
+	if(second != sink->cachedSecond) {
+		struct tm tm;
+		localtime_r(&second, &tm);
+		strftime(sink->cachedDate, sizeof(sink->cachedDate), "%Y-%m-%d %H:%M:%S", &tm);
+		sink->cachedSecond = second;
+	}
+
+	int line = sink->lineCount++;
+	int length = snprintf(sink->prefixes[line], LOG_FILE_SINK_PREFIX_LENGTH, "%s.%03u [%s] ", sink->cachedDate,
+		(unsigned) ((timestampNs / 1000000ULL) % 1000ULL), logger_level_to_string(level));
+	if(length >= LOG_FILE_SINK_PREFIX_LENGTH) length = LOG_FILE_SINK_PREFIX_LENGTH - 1;
+
+	sink->iov[line * 3] = (struct iovec) { .iov_base = sink->prefixes[line], .iov_len = (size_t) length };
+	sink->iov[line * 3 + 1] = (struct iovec) { .iov_base = (void *) message, .iov_len = strlen(message) };
+	sink->iov[line * 3 + 2] = (struct iovec) { .iov_base = lineEnd, .iov_len = 1 };
+	if(level >= LOG_LEVEL_ERROR) sink->syncPending = true;
+}
+
+/**
+ * @brief Écrit le lot en cours en un appel writev(), puis applique la rotation et la synchronisation.
+ * @param sink Le journal
+ * @param nowMs Horodatage courant (ms, horloge monotone)
+ * @return 0 en cas de succès, -1 si le lot n'a pas pu être écrit
+ */
+int log_file_sink_commit(log_file_sink_t *sink, long nowMs) {
+	if(sink->lineCount == 0) return 0;
+
+	int lineCount = sink->lineCount;
+	bool syncNow = sink->config.fsyncPolicy == LOG_FSYNC_BATCH || (sink->syncPending && sink->config.fsyncPolicy != LOG_FSYNC_NEVER);
+	sink->lineCount = 0;
+	sink->syncPending = false;
+
+	// Réouverture après une erreur précédente (ex : support démonté puis remonté)
+	if(sink->fd < 0 && open_current(sink, false) != 0) {
+		sink->writeErrors++;
+		return -1;
+	}
+
+	struct iovec *iov = sink->iov;
+	int iovCount = lineCount * 3;
+	size_t total = 0;
+	for(int i = 0; i < iovCount; i++) total += iov[i].iov_len;
+
+	// writev peut écrire partiellement : on reprend à la première entrée incomplète
+	size_t remaining = total;
+	while(remaining > 0) {
+		ssize_t written = writev(sink->fd, iov, iovCount > IOV_MAX ? IOV_MAX : iovCount);
+		if(written < 0) {
+			if(errno == EINTR) continue;
+			sink->writeErrors++;
+			close(sink->fd);
+			sink->fd = -1;
+			return -1;
+		}
+		remaining -= (size_t) written;
+		while(iovCount > 0 && (size_t) written >= iov->iov_len) {
+			written -= (ssize_t) iov->iov_len;
+			iov++;
+			iovCount--;
+		}
+		if(iovCount > 0) {
+			iov->iov_base = (char *) iov->iov_base + written;
+			iov->iov_len -= (size_t) written;
+		}
+	}
+
+	sink->fileSize += total;
+	sink->written += (uint64_t) lineCount;
+	sink->dirty = true;
+
+	if(syncNow) sync_current(sink, nowMs);
+	log_file_sink_tick(sink, nowMs);
+	return 0;
+}
+
+/**
+ * @brief Applique la synchronisation périodique et la rotation par durée en l'absence de lot.
+ * @param sink Le journal
+ * @param nowMs Horodatage courant (ms, horloge monotone)
+ */
+void log_file_sink_tick(log_file_sink_t *sink, long nowMs) {
+	if(sink->dirty && sink->config.fsyncPolicy == LOG_FSYNC_INTERVAL && nowMs - sink->lastSyncMs >= sink->config.fsyncIntervalMs) {
+		sync_current(sink, nowMs);
+	}
+	if(rotation_due(sink, nowMs)) log_file_sink_rotate(sink, nowMs);
+}
+
+/**
+ * @brief Délai avant la prochaine action de log_file_sink_tick().
+ * @param sink Le journal
+ * @param nowMs Horodatage courant (ms, horloge monotone)
+ * @return Délai en millisecondes, ou -1 si aucune action n'est prévue
+ */
+int log_file_sink_next_timeout(const log_file_sink_t *sink, long nowMs) {
+	long timeout = -1;
+	if(sink->dirty && sink->config.fsyncPolicy == LOG_FSYNC_INTERVAL) {
+		timeout = sink->lastSyncMs + sink->config.fsyncIntervalMs - nowMs;
+	}
+	if(sink->fd >= 0 && sink->fileSize > 0 && sink->config.rotateIntervalSec > 0) {
+		long rotateIn = sink->openedAtMs + sink->config.rotateIntervalSec * 1000L - nowMs;
+		if(timeout < 0 || rotateIn < timeout) timeout = rotateIn;
+	}
+	if(timeout == -1) return -1;
+	return timeout < 0 ? 0 : (int) timeout;
+}
+
+/**
+ * @brief Effectue une rotation immédiate du fichier.
+ * @param sink Le journal
+ * @param nowMs Horodatage courant (ms, horloge monotone)
+ * @return 0 en cas de succès, -1 si le nouveau fichier ne peut pas être ouvert
+ */
+int log_file_sink_rotate(log_file_sink_t *sink, long nowMs) {
+	if(sink->fd >= 0) {
+		if(sink->config.fsyncPolicy != LOG_FSYNC_NEVER) sync_current(sink, nowMs);
+		close(sink->fd);
+		sink->fd = -1;
+	}
+
+	// path.N-1 -> path.N, ..., path -> path.1 (la plus ancienne archive est écrasée)
+	char from[LOG_FILE_SINK_PATH_LENGTH + 16];
+	char to[LOG_FILE_SINK_PATH_LENGTH + 16];
+	for(int i = sink->config.maxFiles - 1; i >= 1; i--) {
+		snprintf(from, sizeof(from), "%s.%d", sink->config.path, i);
+		snprintf(to, sizeof(to), "%s.%d", sink->config.path, i + 1);
+		rename(from, to);
+	}
+	if(sink->config.maxFiles > 0) {
+		snprintf(to, sizeof(to), "%s.1", sink->config.path);
+		rename(sink->config.path, to);
+	}
+
+	sink->rotations++;
+	sink->lastSyncMs = nowMs;
+	return open_current(sink, sink->config.maxFiles <= 0);
+}
+
+/**
+ * @brief Écrit le lot en cours, synchronise et ferme le fichier.
+ * @param sink Le journal
+ */
+void log_file_sink_close(log_file_sink_t *sink) {
+	if(!sink) return;
+
+	long nowMs = clock_monotonic_ms();
+	log_file_sink_commit(sink, nowMs);
+	if(sink->fd >= 0) {
+		if(sink->config.fsyncPolicy != LOG_FSYNC_NEVER) sync_current(sink, nowMs);
+		close(sink->fd);
+		sink->fd = -1;
+	}
+}
+
+/**
+ * @brief Convertit un nom de politique ("never", "batch", "interval") en politique.
+ * @param policyStr Le nom
+ * @param policy Politique correspondante
+ * @return 0 en cas de succès, -1 si le nom est inconnu
+ */
+int log_fsync_policy_from_string(const char *policyStr, log_fsync_policy_t *policy) {
+	if(!policyStr || !policy) return -1;
+
+	if(strcasecmp(policyStr, "never") == 0) *policy = LOG_FSYNC_NEVER;
+	else if(strcasecmp(policyStr, "batch") == 0) *policy = LOG_FSYNC_BATCH;
+	else if(strcasecmp(policyStr, "interval") == 0) *policy = LOG_FSYNC_INTERVAL;
+	else return -1;
+	return 0;
+}
@@ -0,0 +1,385 @@
+/**
+ * @file log_record.c
+ * @brief Enregistrements de log à formatage différé : formatage et fichiers binaires.
+ * @date 2026-10-19
+ */
+#include "core/log_record.h"
+
+#define LOG_SPEC_LENGTH 32 //!< Taille maximale d'une spécification de conversion reconstruite
+
+/**
+ * @brief Lit l'argument suivant d'un tampon.
+ * @param data Le tampon d'arguments
+ * @param length Taille du tampon
+ * @param offset Position de lecture (avancée)
+ * @param arg Argument à remplir
+ * @return true si un argument a été lu, false à la fin du tampon ou s'il est invalide
+ */
+bool log_args_next(const unsigned char *data, size_t length, size_t *offset, log_arg_t *arg) {
+	if(*offset >= length) return false;
+
+	arg->type = (log_arg_type_t) data[(*offset)++];
+	arg->string = NULL;
+	arg->stringLength = 0;
+
+	if(arg->type == LOG_ARG_STRING) {
+		if(*offset + sizeof(uint16_t) > length) return false;
+		memcpy(&arg->stringLength, data + *offset, sizeof(uint16_t));
+		*offset += sizeof(uint16_t);
+		if(*offset + arg->stringLength > length) return false;
+		arg->string = (const char *) data + *offset;
+		*offset += arg->stringLength;
+		return true;
+	}
+
+	if(arg->type < LOG_ARG_INT || arg->type > LOG_ARG_POINTER || *offset + sizeof(uint64_t) > length) return false;
+	memcpy(&arg->value, data + *offset, sizeof(uint64_t));
+	*offset += sizeof(uint64_t);
+	return true;
+}
+
+/**
+ * @brief Valeur entière signée d'un argument, quel que soit son type.
+ * @internal
+ */
+static long long arg_as_int(const log_arg_t *arg) {
+	switch(arg->type) {
+		case LOG_ARG_DOUBLE: return (long long) arg->value.d;
+		case LOG_ARG_STRING: return 0;
+		default: return (long long) arg->value.i;
+	}
+}
+
+/**
+ * @brief Valeur flottante d'un argument, quel que soit son type.
+ * @internal
+ */
+static double arg_as_double(const log_arg_t *arg) {
+	switch(arg->type) {
+		case LOG_ARG_DOUBLE: return arg->value.d;
+		case LOG_ARG_INT: return (double) arg->value.i;
+		case LOG_ARG_STRING: return 0.0;
+		default: return (double) arg->value.u;
+	}
+}
+
+/**
+ * @brief Applique une conversion entière en respectant le modificateur de longueur d'origine.
+ * @internal
+ */
+static int format_integer(char *out, size_t outSize, char *spec, size_t specLength, const char *lengthModifier, char conversion, const log_arg_t *arg) {
+	long long value = arg_as_int(arg);
+	bool isSigned = conversion == 'd' || conversion == 'i';
+
+	// Même troncature que printf avec le modificateur d'origine
+	if(strcmp(lengthModifier, "hh") == 0) value = isSigned ? (long long) (signed char) value : (long long) (unsigned char) value;
+	else if(strcmp(lengthModifier, "h") == 0) value = isSigned ? (long long) (short) value : (long long) (unsigned short) value;
+	else if(lengthModifier[0] == '\0') value = isSigned ? (long long) (int) value : (long long) (unsigned int) value;
+
+	spec[specLength++] = 'l';
+	spec[specLength++] = 'l';
+	spec[specLength++] = conversion;
+	spec[specLength] = '\0';
+
+	if(isSigned) return snprintf(out, outSize, spec, value);
+	return snprintf(out, outSize, spec, (unsigned long long) value);
+}
+
+/**
+ * @brief Formate un enregistrement comme printf l'aurait fait.
+ * @details Les modificateurs de longueur (hh, h, l, ll, z, ...) sont respectés ; un argument
+ * manquant est remplacé par "<?>". %n n'est pas supporté.
+ * @param format La chaîne de format du site
+ * @param args Tampon d'arguments
+ * @param argsLength Taille du tampon
+ * @param out Chaîne résultat (tronquée si nécessaire)
+ * @param outSize Taille de out
+ * @return La longueur écrite dans out
+ */
+size_t log_record_format(const char *format, const unsigned char *args, size_t argsLength, char *out, size_t outSize) {
+	if(!out || outSize == 0) return 0;
+
+	size_t written = 0;
+	size_t offset = 0;
+	const char *cursor = format ? format : "";
+	out[0] = '\0';
+
+	#define APPEND_CHAR(c) do { if(written + 1 < outSize) { out[written++] = (c); out[written] = '\0'; } } while(0)
+
+	while(*cursor && written + 1 < outSize) {
+		if(*cursor != '%') {
+			APPEND_CHAR(*cursor++);
+			continue;
+		}
+		if(cursor[1] == '%') {
+			APPEND_CHAR('%');
+			cursor += 2;
+			continue;
+		}
+
+		// Spécification : %[drapeaux][largeur][.précision][longueur]conversion
+		// Une largeur ou précision '*' est remplacée par la valeur de l'argument correspondant
+		char spec[LOG_SPEC_LENGTH];
+		size_t specLength = 0;
+		bool missing = false;
+		log_arg_t arg;
+
+		spec[specLength++] = *cursor++;
+		while(*cursor && strchr("-+ #0'", *cursor) && specLength < LOG_SPEC_LENGTH - 8) spec[specLength++] = *cursor++;
+		for(int part = 0; part < 2; part++) {
+			if(part == 1) {
+				if(*cursor != '.') break;
+				spec[specLength++] = *cursor++;
+			}
+			if(*cursor == '*') {
+				cursor++;
+				if(!log_args_next(args, argsLength, &offset, &arg)) {
+					missing = true;
+					continue;
+				}
+				int value = (int) arg_as_int(&arg);
+				if(part == 1 && value < 0) specLength--; // Précision négative : ignorée
+				else {
+					int digits = snprintf(spec + specLength, LOG_SPEC_LENGTH - 8 - specLength, "%d", value);
+					if(digits > 0) specLength += (size_t) digits < LOG_SPEC_LENGTH - 9 - specLength ? (size_t) digits : LOG_SPEC_LENGTH - 9 - specLength;
+				}
+			}
+			while(*cursor >= '0' && *cursor <= '9' && specLength < LOG_SPEC_LENGTH - 8) spec[specLength++] = *cursor++;
+		}
+
+		char lengthModifier[3] = {0};
+		size_t modifierLength = 0;
+		while(*cursor && strchr("hlLqjzt", *cursor) && modifierLength < 2) lengthModifier[modifierLength++] = *cursor++;
+
+		char conversion = *cursor;
+		if(!conversion) break;
+		cursor++;
+
+		if(conversion == 'n') continue;
+		if(missing || !log_args_next(args, argsLength, &offset, &arg)) {
+			const char *placeholder = "<?>";
+			while(*placeholder) APPEND_CHAR(*placeholder++);
+			continue;
+		}
+
+		char piece[LOG_MESSAGE_LENGTH];
+		int length = 0;
+		switch(conversion) {
+			case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+				length = format_integer(piece, sizeof(piece), spec, specLength, lengthModifier, conversion, &arg);
+				break;
+			case 'c':
+				spec[specLength++] = 'c';
+				spec[specLength] = '\0';
+				length = snprintf(piece, sizeof(piece), spec, (int) arg_as_int(&arg));
+				break;
+			case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case 'a': case 'A':
+				spec[specLength++] = conversion;
+				spec[specLength] = '\0';
+				length = snprintf(piece, sizeof(piece), spec, arg_as_double(&arg));
+				break;
+			case 's': {
+				char string[LOG_MESSAGE_LENGTH];
+				if(arg.type == LOG_ARG_STRING) {
+					size_t copyLength = arg.stringLength < sizeof(string) - 1 ? arg.stringLength : sizeof(string) - 1;
+					memcpy(string, arg.string, copyLength);
+					string[copyLength] = '\0';
+				} else {
+					snprintf(string, sizeof(string), "<not a string>");
+				}
+				spec[specLength++] = 's';
+				spec[specLength] = '\0';
+				length = snprintf(piece, sizeof(piece), spec, string);
+				break;
+			}
+			case 'p':
+				length = snprintf(piece, sizeof(piece), "%p", (void *) (uintptr_t) arg.value.u);
+				break;
+			default:
+				length = snprintf(piece, sizeof(piece), "<%%%c?>", conversion);
+				break;
+		}
+
+		for(int i = 0; i < length && piece[i]; i++) APPEND_CHAR(piece[i]);
+	}
+
+	#undef APPEND_CHAR
+	return written;
+}
+
+/**
+ * @brief Écrit une chaîne précédée de sa longueur (u16).
+ * @internal
+ */
+static int write_string(FILE *file, const char *value) {
+	size_t length = value ? strlen(value) : 0;
+	uint16_t length16 = (uint16_t) (length < UINT16_MAX ? length : UINT16_MAX);
+	if(fwrite(&length16, sizeof(length16), 1, file) != 1) return -1;
+	if(length16 > 0 && fwrite(value, 1, length16, file) != length16) return -1;
+	return 0;
+}
+
+/**
+ * @brief Écrit l'en-tête d'un fichier binaire.
+ * @return 0 en cas de succès, -1 en cas d'erreur
+ */
+int log_record_write_header(FILE *file) {
+	if(!file) return -1;
+	return fwrite(LOG_RECORD_FILE_MAGIC, 1, strlen(LOG_RECORD_FILE_MAGIC), file) == strlen(LOG_RECORD_FILE_MAGIC) ? 0 : -1;
+}
+
+/**
+ * @brief Écrit l'entrée de description d'un site.
+ * @return 0 en cas de succès, -1 en cas d'erreur
+ */
+int log_record_write_site(FILE *file, uint32_t id, const log_site_t *site) {
+	if(!file || !site) return -1;
+
+	uint8_t type = 'S';
+	uint8_t level = (uint8_t) site->level;
+	if(fwrite(&type, 1, 1, file) != 1) return -1;
+	if(fwrite(&id, sizeof(id), 1, file) != 1) return -1;
+	if(fwrite(&level, 1, 1, file) != 1) return -1;
+	if(fwrite(&site->line, sizeof(site->line), 1, file) != 1) return -1;
+	if(write_string(file, site->file) != 0) return -1;
+	return write_string(file, site->format);
+}
+
+/**
+ * @brief Écrit un enregistrement.
+ * @return 0 en cas de succès, -1 en cas d'erreur
+ */
+int log_record_write(FILE *file, uint32_t id, uint64_t timestampNs, const unsigned char *args, uint16_t argsLength) {
+	if(!file) return -1;
+
+	uint8_t type = 'R';
+	if(fwrite(&type, 1, 1, file) != 1) return -1;
+	if(fwrite(&id, sizeof(id), 1, file) != 1) return -1;
+	if(fwrite(&timestampNs, sizeof(timestampNs), 1, file) != 1) return -1;
+	if(fwrite(&argsLength, sizeof(argsLength), 1, file) != 1) return -1;
+	if(argsLength > 0 && fwrite(args, 1, argsLength, file) != argsLength) return -1;
+	return 0;
+}
+
+/**
+ * @brief Ouvre un lecteur sur un fichier binaire (vérifie l'en-tête).
+ * @return 0 en cas de succès, -1 si le fichier n'est pas un log binaire
+ */
+int log_record_reader_open(log_record_reader_t *reader, FILE *file) {
+	if(!reader || !file) return -1;
+	memset(reader, 0, sizeof(*reader));
+
+	char magic[sizeof(LOG_RECORD_FILE_MAGIC)] = {0};
+	size_t magicLength = strlen(LOG_RECORD_FILE_MAGIC);
+	if(fread(magic, 1, magicLength, file) != magicLength || memcmp(magic, LOG_RECORD_FILE_MAGIC, magicLength) != 0) return -1;
+
+	reader->file = file;
+	return 0;
+}
+
+/**
+ * @brief Lit une chaîne précédée de sa longueur et la conserve dans le lecteur.
+ * @internal
+ */
+static const char *read_string(log_record_reader_t *reader) {
+	uint16_t length;
+	if(fread(&length, sizeof(length), 1, reader->file) != 1) return NULL;
+
+	char *value = (char *) malloc(length + 1);
+	if(!value) return NULL;
+	if(length > 0 && fread(value, 1, length, reader->file) != length) {
+		free(value);
+		return NULL;
+	}
+	value[length] = '\0';
+
+	char **strings = (char **) realloc(reader->strings, sizeof(char *) * (reader->stringCount + 1));
+	if(!strings) {
+		free(value);
+		return NULL;
+	}
+	reader->strings = strings;
+	reader->strings[reader->stringCount++] = value;
+	return value;
+}
+
+/**
+ * @brief Lit une entrée de description de site.
+ * @internal
+ */
+static int read_site(log_record_reader_t *reader) {
+	uint32_t id;
+	uint8_t level;
+	log_site_t site = {0};
+	if(fread(&id, sizeof(id), 1, reader->file) != 1) return -1;
+	if(fread(&level, 1, 1, reader->file) != 1) return -1;
+	if(fread(&site.line, sizeof(site.line), 1, reader->file) != 1) return -1;
+	site.level = (log_level_t) level;
+	site.file = read_string(reader);
+	if(!site.file) return -1;
+	site.format = read_string(reader);
+	if(!site.format) return -1;
+
+	// Les identifiants sont attribués dans l'ordre d'écriture : un identifiant très au-delà
+	// des sites déjà lus indique un fichier corrompu (et forcerait une allocation démesurée)
+	if(id > reader->siteCount + LOG_RECORD_SITE_ID_MARGIN) return -1;
+	if(id >= reader->siteCount) {
+		log_site_t *sites = (log_site_t *) realloc(reader->sites, sizeof(log_site_t) * (id + 1));
+		if(!sites) return -1;
+		memset(sites + reader->siteCount, 0, sizeof(log_site_t) * (id + 1 - reader->siteCount));
+		reader->sites = sites;
+		reader->siteCount = id + 1;
+	}
+	reader->sites[id] = site;
+	return 0;
+}
+
+/**
+ * @brief Lit et formate l'enregistrement suivant.
+ * @param reader Le lecteur
+ * @param entry Enregistrement à remplir
+ * @return 1 si un enregistrement a été lu, 0 en fin de fichier, -1 si le fichier est corrompu
+ */
+int log_record_reader_next(log_record_reader_t *reader, log_record_entry_t *entry) {
+	if(!reader || !reader->file || !entry) return -1;
+
+	uint8_t type;
+	while(fread(&type, 1, 1, reader->file) == 1) {
+		if(type == 'S') {
+			if(read_site(reader) != 0) return -1;
+			continue;
+		}
+		if(type != 'R') return -1;
+
+		uint32_t id;
+		uint16_t argsLength;
+		unsigned char args[UINT16_MAX];
+		if(fread(&id, sizeof(id), 1, reader->file) != 1) return -1;
+		if(fread(&entry->timestampNs, sizeof(entry->timestampNs), 1, reader->file) != 1) return -1;
+		if(fread(&argsLength, sizeof(argsLength), 1, reader->file) != 1) return -1;
+		if(argsLength > 0 && fread(args, 1, argsLength, reader->file) != argsLength) return -1;
+		if(id >= reader->siteCount || !reader->sites[id].format) return -1;
+
+		const log_site_t *site = &reader->sites[id];
+		entry->level = site->level;
+		entry->file = site->file;
+		entry->line = site->line;
+		log_record_format(site->format, args, argsLength, entry->message, sizeof(entry->message));
+		return 1;
+	}
+	return feof(reader->file) ? 0 : -1;
+}
+
+/**
+ * @brief Libère les ressources du lecteur (ne ferme pas le fichier).
+ */
+void log_record_reader_close(log_record_reader_t *reader) {
+	if(!reader) return;
+
+	for(uint32_t i = 0; i < reader->stringCount; i++) {
+		free(reader->strings[i]);
+	}
+	free(reader->strings);
+	free(reader->sites);
+	memset(reader, 0, sizeof(*reader));
+}
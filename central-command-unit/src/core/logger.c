@@ -5,28 +5,189 @@
  * @date 2025-10-18
  */
 #include "core/logger.h"
+#include "core/log_record.h"
+#include "core/log_file_sink.h"
+#include "core/clock.h"
 #include <pthread.h>
-#include <semaphore.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 #include <stdarg.h>
+#include <time.h>
 
 typedef struct {
-	char *msg;
 	log_level_t level;
-} log_node_t;
+	const log_site_t *site; // Site d'un appel différé (NULL : message déjà formaté)
+	uint64_t timestampNs; // Horodatage d'un appel différé
+	uint16_t argsLength; // Taille des arguments bruts d'un appel différé
+	char msg[LOG_SLOT_MESSAGE_LENGTH]; // Message formaté en place par le producteur, ou arguments bruts
+} log_slot_t;
 
 // Etat du logger
 log_level_t currentLogLevel = LOG_LEVEL_INFO;
+int logModuleLevels[LOG_MODULE_COUNT] = { [0 ... LOG_MODULE_COUNT - 1] = LOG_MODULE_INHERIT };
 static log_callback_t logCallback = NULL;
 bool loggerInitialized = false; // Utile pour les macros de vérification
 
 // Gestion du mode asynchrone
-static sem_t logSem; // Sémaphore pour signaler la présence de nouveaux messages
-static fifo_t logFifo; // File d'attente FIFO pour les messages de log
+static ring_buffer_t logRing; // Cases préallouées des messages de log (MPSC)
 static pthread_t loggerThread; // Thread de journalisation
-static int loggerThreadRunning = 0; // Indicateur d'exécution du thread
+static int loggerThreadRunning = 0; // Indicateur d'exécution du thread (accès atomique)
+static log_overflow_policy_t overflowPolicy = LOG_OVERFLOW_DROP; // Comportement lorsque toutes les cases sont occupées
+static uint64_t droppedLogs = 0; // Messages perdus depuis le dernier signalement (accès atomique)
+static logger_stats_t loggerStats; // Compteurs cumulés (accès atomique)
+static log_flush_callback_t flushCallback = NULL; // Vidage périodique du callback (accès atomique)
+static int flushIntervalMs = -1; // Période maximale entre deux appels de flushCallback (accès atomique)
 
+// Sorties fichier (binaire des appels différés, texte du journal local)
+static pthread_mutex_t fileLock = PTHREAD_MUTEX_INITIALIZER; // Protège les deux fichiers
+static FILE *binaryFile = NULL; // Fichier binaire courant (NULL : les appels différés sont formatés)
+static uint32_t binaryGeneration = 0; // Incrémenté à chaque ouverture de fichier
+static uint32_t binaryNextSiteId = 0; // Prochain identifiant de site du fichier courant
+static log_file_sink_t fileSink; // Journal local (écrit par lots avec writev)
+static bool fileSinkActive = false;
+static char formattedMessages[LOG_BATCH_SIZE][LOG_MESSAGE_LENGTH]; // Appels différés formatés du lot en cours (thread de journalisation)
+static __thread bool inCallback = false; // Callback en cours sur ce thread : ses propres messages sont ignorés
+
+
+/**
+ * @private
+ * @brief Transmet un message au callback (ou à la sortie d'erreur).
+ * @details Appelé sans verrou. Les messages journalisés par le callback lui-même (par exemple
+ * par mqtt.c lors de la publication du log) sont ignorés : ils reboucleraient sur le callback.
+ */
+static void logger_dispatch(log_level_t level, const char *message) {
+	if(logCallback) {
+		inCallback = true;
+		logCallback(level, message);
+		inCallback = false;
+	} else {
+		fprintf(stderr, "[%d] %s\n", level, message);
+	}
+}
+
+/**
+ * @private
+ * @brief Écrit un appel différé dans le fichier binaire (fileLock verrouillé).
+ * @details Le site est décrit dans le fichier avant son premier enregistrement.
+ * @return 0 en cas de succès, -1 en cas d'erreur d'écriture
+ */
+static int logger_write_binary(const log_slot_t *slot) {
+	log_site_t *site = (log_site_t *) slot->site;
+	if(site->fileGeneration != binaryGeneration) {
+		site->fileId = binaryNextSiteId++;
+		site->fileGeneration = binaryGeneration;
+		if(log_record_write_site(binaryFile, site->fileId, site) != 0) return -1;
+	}
+	return log_record_write(binaryFile, site->fileId, slot->timestampNs, (const unsigned char *) slot->msg, slot->argsLength);
+}
+
+/**
+ * @private
+ * @brief Horodatage temps réel en nanosecondes.
+ */
+static uint64_t logger_now_ns(void) {
+	struct timespec now;
+	clock_gettime(CLOCK_REALTIME, &now);
+	return (uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec;
+}
+
+/**
+ * @private
+ * @brief Appelle la fonction de vidage du callback, s'il y en a une.
+ */
+static void logger_flush_callback(bool force) {
+	log_flush_callback_t flush = __atomic_load_n(&flushCallback, __ATOMIC_ACQUIRE);
+	if(!flush) return;
+
+	inCallback = true;
+	flush(force);
+	inCallback = false;
+}
+
+/**
+ * @private
+ * @brief Traite une case : appel différé écrit en binaire ou formaté, ou message déjà formaté.
+ * @param slot La case
+ * @param buffer Tampon de formatage d'un appel différé (LOG_MESSAGE_LENGTH octets)
+ * @return Le texte du message, ou NULL s'il a été écrit dans le fichier binaire
+ */
+static const char *logger_process_slot(const log_slot_t *slot, char *buffer) {
+	if(!slot->site) return slot->msg;
+
+	if(binaryFile) {
+		if(logger_write_binary(slot) == 0) return NULL;
+		fprintf(stderr, "[LOGGER] Binary log write failed, falling back to text output\n");
+		fclose(binaryFile);
+		binaryFile = NULL;
+	}
+
+	log_record_format(slot->site->format, (const unsigned char *) slot->msg, slot->argsLength, buffer, LOG_MESSAGE_LENGTH);
+	return buffer;
+}
+
+/**
+ * @private
+ * @brief Traite un lot de messages publiés, directement depuis leurs cases.
+ * @details Les cases ne sont libérées qu'après l'écriture du lot dans le journal local et
+ * sa transmission au callback : writev() et le callback lisent les messages dans les cases,
+ * sans copie. Le callback est appelé après la libération de fileLock.
+ * @return Le nombre de messages traités
+ */
+static size_t logger_drain_batch(void) {
+	size_t count = 0;
+	log_slot_t *slot;
+	const char *messages[LOG_BATCH_SIZE];
+	log_level_t levels[LOG_BATCH_SIZE];
+
+	pthread_mutex_lock(&fileLock);
+	while(count < LOG_BATCH_SIZE && (slot = ring_buffer_peek_at(&logRing, count)) != NULL) {
+		messages[count] = logger_process_slot(slot, formattedMessages[count]);
+		levels[count] = slot->level;
+		if(messages[count] && fileSinkActive) log_file_sink_add(&fileSink, slot->level, slot->timestampNs, messages[count]);
+		count++;
+	}
+	if(fileSinkActive && count > 0) log_file_sink_commit(&fileSink, clock_monotonic_ms());
+	if(binaryFile && count > 0) fflush(binaryFile);
+	pthread_mutex_unlock(&fileLock);
+
+	for(size_t i = 0; i < count; i++) {
+		if(messages[i]) logger_dispatch(levels[i], messages[i]);
+	}
+	ring_buffer_release_n(&logRing, count);
+	__atomic_fetch_add(&loggerStats.written, count, __ATOMIC_RELAXED);
+
+	uint64_t dropped = __atomic_exchange_n(&droppedLogs, 0, __ATOMIC_RELAXED);
+	if(dropped > 0) {
+		char message[128];
+		snprintf(message, sizeof(message), "%llu log messages dropped (async queue full)", (unsigned long long) dropped);
+		pthread_mutex_lock(&fileLock);
+		if(fileSinkActive) {
+			log_file_sink_add(&fileSink, LOG_LEVEL_WARNING, logger_now_ns(), message);
+			log_file_sink_commit(&fileSink, clock_monotonic_ms());
+		}
+		pthread_mutex_unlock(&fileLock);
+		logger_dispatch(LOG_LEVEL_WARNING, message);
+	}
+	return count;
+}
+
+/**
+ * @private
+ * @brief Délai d'attente du thread : période du callback de vidage et échéances du journal local.
+ */
+static int logger_wait_timeout(void) {
+	int timeout = __atomic_load_n(&flushIntervalMs, __ATOMIC_RELAXED);
+
+	pthread_mutex_lock(&fileLock);
+	if(fileSinkActive) {
+		log_file_sink_tick(&fileSink, clock_monotonic_ms());
+		int sinkTimeout = log_file_sink_next_timeout(&fileSink, clock_monotonic_ms());
+		if(sinkTimeout >= 0 && (timeout < 0 || sinkTimeout < timeout)) timeout = sinkTimeout;
+	}
+	pthread_mutex_unlock(&fileLock);
+	return timeout;
+}
 
 /**
  * @private
@@ -37,33 +198,44 @@ static int loggerThreadRunning = 0; // Indicateur d'exécution du thread
 static void *logger_thread_function(void *arg) {
 	UNUSED(arg);
 	while(1) {
-		sem_wait(&logSem);
-		if(!loggerThreadRunning) break;
-		log_node_t *node = fifo_pop(&logFifo);
-		if(node) {
-			if(logCallback) {
-				logCallback(node->level, node->msg);
-			} else {
-				fprintf(stderr, "[%d] %s\n", node->level, node->msg);
-			}
-			free(node->msg);
-			free(node);
-		}
+		size_t count = logger_drain_batch();
+		logger_flush_callback(false);
+		if(count > 0) continue;
+		if(!__atomic_load_n(&loggerThreadRunning, __ATOMIC_ACQUIRE)) break;
+		ring_buffer_wait(&logRing, logger_wait_timeout());
 	}
 
 	// Nettoyage des messages restants
-	while(!fifo_is_empty(&logFifo)) {
-		log_node_t *node = fifo_pop(&logFifo);
-		if(node) {
-			if(logCallback) {
-				logCallback(node->level, node->msg);
-			} else {
-				fprintf(stderr, "[%d] %s\n", node->level, node->msg);
-			}
-			free(node->msg);
-			free(node);
+	while(logger_drain_batch() > 0);
+	logger_flush_callback(true);
+	return NULL;
+}
+
+/**
+ * @private
+ * @brief Réserve une case pour un message, en appliquant la politique de débordement.
+ * @return La case réservée, ou NULL si le message doit être perdu
+ */
+static log_slot_t *logger_claim_slot(log_level_t level) {
+	log_slot_t *slot = ring_buffer_claim(&logRing);
+	if(slot) return slot;
+
+	// Les erreurs ne sont jamais perdues : on attend que le thread libère une case,
+	// sauf depuis le thread de journalisation lui-même, qui attendrait indéfiniment
+	bool wait = (overflowPolicy == LOG_OVERFLOW_BLOCK || level >= LOG_LEVEL_ERROR)
+		&& !pthread_equal(pthread_self(), loggerThread);
+	if(wait) {
+		__atomic_fetch_add(&loggerStats.blocked, 1, __ATOMIC_RELAXED);
+		struct timespec pause = { 0, LOG_BLOCK_SLEEP_NS };
+		while(__atomic_load_n(&loggerThreadRunning, __ATOMIC_ACQUIRE)) {
+			slot = ring_buffer_claim(&logRing);
+			if(slot) return slot;
+			nanosleep(&pause, NULL);
 		}
 	}
+
+	__atomic_fetch_add(&loggerStats.dropped[level], 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&droppedLogs, 1, __ATOMIC_RELAXED);
 	return NULL;
 }
 
@@ -71,18 +243,129 @@ static void *logger_thread_function(void *arg) {
  * @brief  Initialise le système de log global (callback + thread async prêt)
  * @param level Niveau de journalisation global.
  * @param callback Fonction de rappel pour traiter les messages.
- * @note Les messages sont stockés dans une queue et traités par un thread dédié.
+ * @note Les messages sont stockés dans une file circulaire et traités par un thread dédié.
  */
 void logger_init(log_level_t level, log_callback_t callback) {
-	currentLogLevel = level;
+	logger_set_level(level);
 	logCallback = callback;
-	loggerInitialized = true;
 
-	fifo_init(&logFifo);
-	CHECK_SEM_RAW(sem_init(&logSem, 0, 0));
+	CHECK_CRITICAL_RAW(ring_buffer_init_slots(&logRing, LOG_QUEUE_CAPACITY, sizeof(log_slot_t), true) == 0, "Log queue initialization failed");
 
 	loggerThreadRunning = 1;
 	CHECK_PTHREAD_RAW(pthread_create(&loggerThread, NULL, logger_thread_function, NULL));
+	loggerInitialized = true;
+}
+
+/**
+ * @brief Définit le comportement des appels asynchrones lorsque toutes les cases sont occupées.
+ * @param policy LOG_OVERFLOW_DROP (défaut) ou LOG_OVERFLOW_BLOCK
+ */
+void logger_set_overflow_policy(log_overflow_policy_t policy) {
+	overflowPolicy = policy;
+}
+
+/**
+ * @brief Définit la fonction de vidage appelée par le thread de journalisation.
+ * @details La fonction est appelée avec force = false après chaque lot traité et au moins
+ * toutes les intervalMs millisecondes, puis avec force = true à l'arrêt du logger.
+ * Elle permet à un callback qui regroupe les messages de publier un lot en attente.
+ * @param callback La fonction (NULL : aucune)
+ * @param intervalMs Période maximale entre deux appels (ms, -1 : uniquement après un lot)
+ */
+void logger_set_flush_callback(log_flush_callback_t callback, int intervalMs) {
+	__atomic_store_n(&flushIntervalMs, callback ? intervalMs : -1, __ATOMIC_RELAXED);
+	__atomic_store_n(&flushCallback, callback, __ATOMIC_RELEASE);
+	if(loggerInitialized) ring_buffer_wake(&logRing); // Prise en compte de la nouvelle période
+}
+
+/**
+ * @brief Écrit les appels LOG_*_DEFERRED dans un fichier binaire au lieu de les formater.
+ * @details Le fichier est tronqué puis décodable avec l'outil log-decoder. Les autres
+ * messages continuent d'être transmis au callback.
+ * @param path Chemin du fichier, ou NULL pour fermer le fichier courant et revenir au formatage
+ * @return 0 en cas de succès, -1 si le fichier ne peut pas être ouvert
+ */
+int logger_set_binary_file(const char *path) {
+	FILE *file = NULL;
+	if(path) {
+		file = fopen(path, "wb");
+		if(!file) return -1;
+		if(log_record_write_header(file) != 0) {
+			fclose(file);
+			return -1;
+		}
+	}
+
+	pthread_mutex_lock(&fileLock);
+	if(binaryFile) fclose(binaryFile);
+	binaryFile = file;
+	binaryGeneration++;
+	if(binaryGeneration == 0) binaryGeneration = 1; // 0 est réservé aux sites jamais écrits
+	binaryNextSiteId = 0;
+	pthread_mutex_unlock(&fileLock);
+	return 0;
+}
+
+/**
+ * @brief Écrit aussi tous les messages dans un fichier local, par lots, avec rotation.
+ * @details Le fichier est alimenté par le thread de journalisation (un writev() par lot) et par
+ * les appels synchrones, indépendamment du callback : il reste écrit lorsque MQTT est déconnecté.
+ * @param config Configuration du journal local, ou NULL pour fermer le fichier courant
+ * @return 0 en cas de succès, -1 si le fichier ne peut pas être ouvert
+ */
+int logger_set_file_sink(const log_file_sink_config_t *config) {
+	pthread_mutex_lock(&fileLock);
+	if(fileSinkActive) {
+		log_file_sink_close(&fileSink);
+		fileSinkActive = false;
+	}
+
+	int result = 0;
+	if(config) {
+		result = log_file_sink_open(&fileSink, config);
+		fileSinkActive = result == 0;
+	}
+	pthread_mutex_unlock(&fileLock);
+
+	// Réveil du thread pour qu'il tienne compte des nouvelles échéances
+	if(loggerInitialized) ring_buffer_wake(&logRing);
+	return result;
+}
+
+/**
+ * @private
+ * @brief Formate et transmet un message immédiatement (filtrage déjà effectué).
+ */
+static void logger_vlog_sync(log_level_t level, const char *format, va_list args) {
+	char message[LOG_MESSAGE_LENGTH];
+	vsnprintf(message, LOG_MESSAGE_LENGTH, format, args);
+
+	logger_dispatch(level, message);
+
+	// Le callback est appelé hors verrou : il peut publier le message (MQTT)
+	pthread_mutex_lock(&fileLock);
+	if(fileSinkActive) {
+		log_file_sink_add(&fileSink, level, logger_now_ns(), message);
+		log_file_sink_commit(&fileSink, clock_monotonic_ms());
+	}
+	pthread_mutex_unlock(&fileLock);
+}
+
+/**
+ * @private
+ * @brief Formate un message dans une case de la file (filtrage déjà effectué).
+ */
+static void logger_vlog_async(log_level_t level, const char *format, va_list args) {
+	log_slot_t *slot = logger_claim_slot(level);
+	if(!slot) return;
+
+	// Formatage directement dans la case réservée : aucune allocation ni copie
+	slot->level = level;
+	slot->site = NULL;
+	slot->timestampNs = logger_now_ns();
+	if(vsnprintf(slot->msg, LOG_SLOT_MESSAGE_LENGTH, format, args) < 0) slot->msg[0] = '\0';
+
+	ring_buffer_publish(&logRing, slot);
 }
 
 /**
@@ -93,21 +376,32 @@ void logger_init(log_level_t level, log_callback_t callback) {
  * @note Si le niveau du message est inférieur au niveau configuré, il est ignoré.
  */
 void logger_log_sync(log_level_t level, const char *format, ...) {
-	if(!loggerInitialized || level < currentLogLevel) {
+	if(!loggerInitialized || inCallback || !logger_module_enabled(LOG_MODULE_GENERAL, level)) {
 		return;
 	}
 
-	char message[LOG_MESSAGE_LENGTH];
 	va_list args;
 	va_start(args, format);
-	vsnprintf(message, LOG_MESSAGE_LENGTH, format, args);
+	logger_vlog_sync(level, format, args);
 	va_end(args);
+}
 
-	if(logCallback) {
-		logCallback(level, message);
-	} else {
-		fprintf(stderr, "[%d] %s\n", level, message);
+/**
+ * @brief Journalise un message d'un module en mode synchrone.
+ * @param module Module émetteur (filtré selon son propre niveau, voir logger_set_module_level()).
+ * @param level Niveau de criticité du message.
+ * @param format Chaîne de format (comme le printf).
+ * @param ... Arguments pour le format.
+ */
+void logger_log_module_sync(log_module_t module, log_level_t level, const char *format, ...) {
+	if(!loggerInitialized || inCallback || !logger_module_enabled(module, level)) {
+		return;
 	}
+
+	va_list args;
+	va_start(args, format);
+	logger_vlog_sync(level, format, args);
+	va_end(args);
 }
 
 /**
@@ -116,44 +410,147 @@ void logger_log_sync(log_level_t level, const char *format, ...) {
  * @param format Chaîne de format (comme le printf).
  * @param ... Arguments pour le format.
  * @note Cette fonction retourne immédiatement, le message sera traité par le thread de logging.
+ * @note Ignoré si le logger n'est pas initialisé.
  */
 void logger_log_async(log_level_t level, const char *format, ...) {
-	if(level < currentLogLevel) {
+	if(!loggerInitialized || inCallback || !logger_module_enabled(LOG_MODULE_GENERAL, level)) {
 		return;
 	}
-	char *message = malloc(LOG_MESSAGE_LENGTH);
-	CHECK_ALLOC_RAW(message);
 
 	va_list args;
 	va_start(args, format);
-	vsnprintf(message, LOG_MESSAGE_LENGTH, format, args);
+	logger_vlog_async(level, format, args);
 	va_end(args);
+}
+
+/**
+ * @brief Journalise un message d'un module en mode asynchrone.
+ * @param module Module émetteur (filtré selon son propre niveau, voir logger_set_module_level()).
+ * @param level Niveau de criticité du message.
+ * @param format Chaîne de format (comme le printf).
+ * @param ... Arguments pour le format.
+ */
+void logger_log_module_async(log_module_t module, log_level_t level, const char *format, ...) {
+	if(!loggerInitialized || inCallback || !logger_module_enabled(module, level)) {
+		return;
+	}
+
+	va_list args;
+	va_start(args, format);
+	logger_vlog_async(level, format, args);
+	va_end(args);
+}
+
+/**
+ * @brief Change le niveau global de journalisation sans réinitialiser le logger.
+ * @param level Le nouveau niveau (les modules qui en héritent le suivent)
+ */
+void logger_set_level(log_level_t level) {
+	__atomic_store_n(&currentLogLevel, level, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Change le niveau de journalisation d'un module.
+ * @param module Le module
+ * @param level Le niveau (log_level_t), ou LOG_MODULE_INHERIT pour suivre le niveau global
+ * @return 0 en cas de succès, -1 si le module ou le niveau est invalide
+ */
+int logger_set_module_level(log_module_t module, int level) {
+	if((int) module < 0 || module >= LOG_MODULE_COUNT) return -1;
+	if(level != LOG_MODULE_INHERIT && (level < LOG_LEVEL_DEBUG || level > LOG_LEVEL_FATAL)) return -1;
+
+	__atomic_store_n(&logModuleLevels[module], level, __ATOMIC_RELAXED);
+	return 0;
+}
+
+/**
+ * @brief Retourne le niveau effectif d'un module.
+ * @param module Le module
+ * @return Le niveau propre au module, ou le niveau global s'il en hérite
+ */
+log_level_t logger_get_module_level(log_module_t module) {
+	int level = __atomic_load_n(&logModuleLevels[module], __ATOMIC_RELAXED);
+	return level == LOG_MODULE_INHERIT ? __atomic_load_n(&currentLogLevel, __ATOMIC_RELAXED) : (log_level_t) level;
+}
+
+/**
+ * @brief Réserve une case pour un appel différé (voir LOG_DEFERRED).
+ * @param site Le site d'appel
+ * @param writer Tampon d'arguments à initialiser
+ * @return true si les arguments doivent être écrits puis logger_deferred_commit() appelé
+ */
+bool logger_deferred_begin(log_site_t *site, log_args_writer_t *writer) {
+	if(!loggerInitialized || inCallback || !logger_module_enabled(site->module, site->level)) {
+		return false;
+	}
+
+	log_slot_t *slot = logger_claim_slot(site->level);
+	if(!slot) return false;
+
+	slot->level = site->level;
+	slot->site = site;
+	slot->timestampNs = logger_now_ns();
+
+	writer->data = (unsigned char *) slot->msg;
+	writer->length = 0;
+	writer->capacity = LOG_SLOT_MESSAGE_LENGTH;
+	writer->slot = slot;
+	return true;
+}
+
+/**
+ * @brief Publie un appel différé réservé avec logger_deferred_begin().
+ * @param writer Le tampon d'arguments rempli
+ */
+void logger_deferred_commit(log_args_writer_t *writer) {
+	log_slot_t *slot = (log_slot_t *) writer->slot;
+	slot->argsLength = (uint16_t) writer->length;
+	ring_buffer_publish(&logRing, slot);
+}
+
+/**
+ * @brief Retourne le nombre total de messages asynchrones perdus car la file était pleine.
+ */
+uint64_t logger_dropped_count(void) {
+	uint64_t total = 0;
+	for(int i = 0; i < LOG_LEVEL_COUNT; i++) {
+		total += __atomic_load_n(&loggerStats.dropped[i], __ATOMIC_RELAXED);
+	}
+	return total;
+}
 
-	log_node_t *node = malloc(sizeof(log_node_t));
-	CHECK_ALLOC_RAW(node);
-	node->msg = message;
-	node->level = level;
+/**
+ * @brief Copie les compteurs cumulés du mode asynchrone.
+ * @param stats Structure à remplir
+ */
+void logger_get_stats(logger_stats_t *stats) {
+	if(!stats) return;
 
-	fifo_push(&logFifo, node);
-	sem_post(&logSem);
+	stats->written = __atomic_load_n(&loggerStats.written, __ATOMIC_RELAXED);
+	stats->blocked = __atomic_load_n(&loggerStats.blocked, __ATOMIC_RELAXED);
+	for(int i = 0; i < LOG_LEVEL_COUNT; i++) {
+		stats->dropped[i] = __atomic_load_n(&loggerStats.dropped[i], __ATOMIC_RELAXED);
+	}
 }
 
 /**
  * @brief Libère les ressources du système de journalisation.
- * @note Cette fonction doit être appelée pour nettoyer le thread et les sémaphores.
+ * @note Cette fonction doit être appelée pour nettoyer le thread et la file.
  */
 void logger_destroy(void) {
 	if(!loggerInitialized) {
 		return;
 	}
+	loggerInitialized = false;
 
-	loggerThreadRunning = 0;
-	sem_post(&logSem);
+	__atomic_store_n(&loggerThreadRunning, 0, __ATOMIC_RELEASE);
+	ring_buffer_wake(&logRing);
 	pthread_join(loggerThread, NULL);
 
-	CHECK_SEM_RAW(sem_destroy(&logSem));
-	fifo_destroy(&logFifo);
-	loggerInitialized = false;
+	ring_buffer_destroy(&logRing);
+	logger_set_binary_file(NULL);
+	logger_set_file_sink(NULL);
+	logger_set_flush_callback(NULL, -1);
 }
 
 /**
@@ -192,3 +589,38 @@ log_level_t logger_string_to_level(const char* levelStr) {
 		return LOG_LEVEL_INFO; // Valeur par défaut
 	}
 }
+
+/**
+ * @brief Convertit un module en chaîne de caractères.
+ * @param module Le module.
+ * @return Le nom du module (ex : "MQTT").
+ */
+const char* logger_module_to_string(log_module_t module) {
+	switch (module) {
+		case LOG_MODULE_GENERAL:    return "GENERAL";
+		case LOG_MODULE_MQTT:       return "MQTT";
+		case LOG_MODULE_CAMERA:     return "CAMERA";
+		case LOG_MODULE_UART:       return "UART";
+		case LOG_MODULE_MARVELMIND: return "MARVELMIND";
+		case LOG_MODULE_PLANNER:    return "PLANNER";
+		default:                    return "UNKNOWN";
+	}
+}
+
+/**
+ * @brief Convertit un nom de module (insensible à la casse) en module.
+ * @param moduleStr Le nom du module (ex : "MQTT", "camera").
+ * @param module Module correspondant.
+ * @return 0 en cas de succès, -1 si le nom est inconnu.
+ */
+int logger_string_to_module(const char* moduleStr, log_module_t *module) {
+	if(!moduleStr || !module) return -1;
+
+	for(int i = 0; i < LOG_MODULE_COUNT; i++) {
+		if(strcasecmp(moduleStr, logger_module_to_string((log_module_t) i)) == 0) {
+			*module = (log_module_t) i;
+			return 0;
+		}
+	}
+	return -1;
+}
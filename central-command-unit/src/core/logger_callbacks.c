@@ -1,8 +1,81 @@
 
 #include "core/logger_callbacks.h"
+#include "core/clock.h"
 
 static char gLogTopic[128];
 static char gClientId[64];
+static log_batcher_t gLogBatcher; // Lot en attente de publication sur MQTT
+static pthread_mutex_t gLogBatcherLock = PTHREAD_MUTEX_INITIALIZER; // Les appels synchrones partagent le lot
+static bool gLogBatcherReady = false;
+static bool gConsoleEnabled = true; // Affichage console de mqtt_log_callback (accès atomique)
+static const mqtt_publish_options_t logPublishOptions = { .priority = MQTT_PRIORITY_TELEMETRY };
+
+// Lots sérialisés sous gLogBatcherLock, publiés après sa libération (mqtt.c journalise lui-même)
+typedef struct pending_log_batch {
+	struct pending_log_batch *next;
+	char topic[sizeof(gLogTopic)]; // Topic au moment de la sérialisation
+	char *json;
+} pending_log_batch_t;
+static pending_log_batch_t *gPendingHead = NULL; // Protégé par gLogBatcherLock
+static pending_log_batch_t *gPendingTail = NULL;
+
+/**
+ * @brief Sérialise un lot de messages de log en tableau JSON et le met en attente de publication.
+ * @details Appelé sous gLogBatcherLock : la publication est faite par mqtt_log_publish_pending().
+ * @internal
+ */
+static void mqtt_log_queue_batch(const log_batch_entry_t *entries, int count, void *context) {
+	UNUSED(context);
+
+	telemetry_message_t messages[LOG_BATCHER_MAX_ENTRIES];
+	for(int i = 0; i < count; i++) {
+		messages[i] = (telemetry_message_t) {
+			.timestamp = entries[i].firstTimestamp,
+			.level = entries[i].level,
+			.origin = gClientId,
+			.message = (char *) entries[i].message,
+			.count = entries[i].count,
+			.lastTimestamp = entries[i].lastTimestamp
+		};
+	}
+
+	char *json = telemetry_message_array_serialize_json(messages, count);
+	if (!json) return;
+
+	pending_log_batch_t *pending = malloc(sizeof(*pending));
+	if (!pending) {
+		free(json);
+		return;
+	}
+	pending->next = NULL;
+	memcpy(pending->topic, gLogTopic, sizeof(pending->topic));
+	pending->json = json;
+	if (gPendingTail) gPendingTail->next = pending;
+	else gPendingHead = pending;
+	gPendingTail = pending;
+}
+
+/**
+ * @brief Publie les lots en attente, hors de gLogBatcherLock.
+ * @internal
+ */
+static void mqtt_log_publish_pending(void) {
+	while (1) {
+		pthread_mutex_lock(&gLogBatcherLock);
+		pending_log_batch_t *pending = gPendingHead;
+		if (pending) {
+			gPendingHead = pending->next;
+			if (!gPendingHead) gPendingTail = NULL;
+		}
+		pthread_mutex_unlock(&gLogBatcherLock);
+		if (!pending) return;
+
+		// Conservés pendant une coupure, derrière les commandes
+		mqtt_publish_with_options(pending->topic, pending->json, strlen(pending->json), MQTT_QOS_AT_LEAST_ONCE, false, &logPublishOptions);
+		free(pending->json);
+		free(pending);
+	}
+}
 
 /**
  * @brief Callback de log qui écrit sur la console avec couleurs.
@@ -28,30 +101,45 @@ void console_log_callback(log_level_t level, const char *message) {
  * @warning l'appel de mqtt_log_callback_init doit être fait avant d'utiliser ce callback.
  */
 void mqtt_log_callback(log_level_t level, const char *message) {
-	console_log_callback(level, message);
+	if (__atomic_load_n(&gConsoleEnabled, __ATOMIC_RELAXED)) console_log_callback(level, message);
 	
-	// 2. Log sur MQTT
-	if (gLogTopic[0] != '\0' && gClientId[0] != '\0' && mqtt_is_connected()) {
-		telemetry_message_t telemetryMsg = {
-			.timestamp = time(NULL),
-			.level = level,
-			.origin = gClientId,
-			.message = (char *) message
-		};
-		char *json = telemetry_message_serialize_json(&telemetryMsg);
-		if (json) {
-			mqtt_publish(gLogTopic, json, MQTT_QOS_AT_LEAST_ONCE, false);
-			free(json);
-		}
+	// 2. Log sur MQTT, regroupé par lots (les erreurs sont publiées immédiatement)
+	if (gLogTopic[0] != '\0' && gClientId[0] != '\0' && gLogBatcherReady) {
+		pthread_mutex_lock(&gLogBatcherLock);
+		log_batcher_add(&gLogBatcher, level, message, clock_monotonic_ms(), time(NULL));
+		pthread_mutex_unlock(&gLogBatcherLock);
+		mqtt_log_publish_pending();
 	}
 }
 
+/**
+ * @brief Publie le lot de logs MQTT en attente si sa fenêtre est écoulée (ou immédiatement si force).
+ * @param force Publie le lot quelle que soit sa fenêtre.
+ * @note À enregistrer avec logger_set_flush_callback().
+ */
+void mqtt_log_flush(bool force) {
+	if (!gLogBatcherReady) return;
+
+	pthread_mutex_lock(&gLogBatcherLock);
+	if (force) log_batcher_flush(&gLogBatcher);
+	else log_batcher_tick(&gLogBatcher, clock_monotonic_ms());
+	pthread_mutex_unlock(&gLogBatcherLock);
+	mqtt_log_publish_pending();
+}
+
 /**
  * @brief Initialise les informations nécessaires pour le callback de log MQTT.
  * @param topic Topic MQTT pour les logs.
  * @param clientId ID client MQTT.
+ * @param batchSize Nombre maximal de messages par publication (0 : défaut, 1 : pas de regroupement).
+ * @param batchWindowMs Attente maximale d'un lot en millisecondes (-1 : défaut).
  */
-void mqtt_log_callback_init(const char* topic, const char* clientId) {
+void mqtt_log_callback_init(const char* topic, const char* clientId, int batchSize, int batchWindowMs) {
+	pthread_mutex_lock(&gLogBatcherLock);
+
+	// Publication du lot en attente avec l'ancienne configuration
+	if (gLogBatcherReady) log_batcher_flush(&gLogBatcher);
+
 	// Copie des informations nécessaires
 	if (topic) {
 		strncpy(gLogTopic, topic, sizeof(gLogTopic) - 1);
@@ -66,4 +154,21 @@ void mqtt_log_callback_init(const char* topic, const char* clientId) {
 	} else {
 		gClientId[0] = '\0';
 	}
+
+	log_batcher_init(&gLogBatcher, batchSize > 0 ? batchSize : LOG_BATCHER_DEFAULT_ENTRIES,
+		batchWindowMs >= 0 ? batchWindowMs : LOG_BATCHER_DEFAULT_WINDOW_MS, mqtt_log_queue_batch, NULL);
+	gLogBatcherReady = true;
+
+	pthread_mutex_unlock(&gLogBatcherLock);
+	mqtt_log_publish_pending();
+}
+
+/**
+ * @brief Active ou désactive l'affichage console de mqtt_log_callback().
+ * @details Avec un journal local (log_file), la console peut être coupée pour éviter un
+ * printf par ligne (coûteux lorsque la sortie est reprise par journald).
+ * @param enabled true pour afficher les messages sur la console (défaut).
+ */
+void mqtt_log_callback_set_console(bool enabled) {
+	__atomic_store_n(&gConsoleEnabled, enabled, __ATOMIC_RELAXED);
 }
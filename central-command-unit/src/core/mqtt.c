@@ -3,9 +3,14 @@
  * @brief Implémentation d'un client MQTT simple avec support du LWT.
  */
 
+#define LOG_MODULE LOG_MODULE_MQTT
+
 #include "core/check.h"
 #include "core/logger.h"
 #include "core/mqtt.h"
+#include "core/event_loop.h"
+#include "core/backoff.h"
+#include "core/timer_wheel.h"
 
 #include <mosquitto.h>
 #include <pthread.h>
@@ -18,6 +23,10 @@
 		} \
 		mosquitto_lib_cleanup(); \
 		sem_destroy(&connectSemaphore); \
+		if (mqttQueueReady) { \
+			mqttQueueReady = false; \
+			mqtt_queue_destroy(&mqttQueue); \
+		} \
 		return -1; \
 	} while(0)
 
@@ -36,21 +45,190 @@ static pthread_t mqttThread;
  */
 static mqtt_message_callback_t mqttOnMessageCallback = NULL;
 
-static bool isConnected = false;
+/**
+ * @brief pointeur vers le gestionnaire des messages de contrôle du core
+ */
+static mqtt_control_handler_t mqttControlHandler = NULL;
+
+/**
+ * @brief callback du service appelé sans copie du payload
+ */
+static mqtt_payload_callback_t mqttOnPayloadCallback = NULL;
+
+/**
+ * @brief routeur des messages reçus vers les handlers des services (voir mqtt_router.h)
+ */
+static mqtt_router_t *mqttRouter = NULL;
+
+static bool isConnected = false; // Accès atomique (thread réseau, publieurs)
 static sem_t connectSemaphore; // <-- NOTRE SÉMAPHORE DE NOTIFICATION
 
+/**
+ * @brief Boucle d'événements pilotant le client (NULL : thread réseau dédié)
+ */
+static event_loop_t *mqttEventLoop = NULL;
+static int mqttSocketFd = -1; //!< Socket surveillée par la boucle (-1 : déconnecté)
+static event_loop_timer_t *mqttMiscTimer = NULL;
+static bool mqttStopping = false; //!< Déconnexion volontaire en cours : pas de reconnexion
+static pthread_mutex_t mqttStopLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t mqttStopCond = PTHREAD_COND_INITIALIZER; //!< Interrompt l'attente avant reconnexion
+
+/**
+ * @brief Publications en attente pendant une coupure (voir mqtt_queue.h)
+ */
+static mqtt_queue_config_t mqttQueueConfig = {0};
+static mqtt_queue_t mqttQueue;
+static bool mqttQueueReady = false;
+static bool mqttQueueLossLogged = false; //!< Une seule alerte par coupure en cas de perte (accès atomique)
+
+/**
+ * @brief Délais de reconnexion (exponentiels, avec gigue)
+ */
+static uint32_t reconnectMinMs = MQTT_RECONNECT_DEFAULT_MIN_MS;
+static uint32_t reconnectMaxMs = MQTT_RECONNECT_DEFAULT_MAX_MS;
+static backoff_t reconnectBackoff;
+static long nextReconnectMs = 0; //!< Prochaine tentative en mode boucle d'événements (ms, horloge monotone)
+
+/**
+ * @brief Protocole MQTT v5 : alias de topic de la connexion courante et propriétés du message reçu
+ */
+static mqtt_version_t protocolVersion = MQTT_VERSION_3_1_1;
+static pthread_mutex_t topicAliasLock = PTHREAD_MUTEX_INITIALIZER;
+static char *topicAliases[MQTT_TOPIC_ALIAS_MAX]; //!< Topic associé à l'alias i + 1 (NULL : libre)
+static uint16_t topicAliasMaximum = 0;           //!< Alias acceptés par le broker sur la connexion courante
+static __thread const mqtt_properties_t *currentProperties = NULL;
+
+/**
+ * @brief Oublie les alias de topic : ils ne valent que pour une connexion.
+ * @param maximum Alias acceptés par le broker sur la nouvelle connexion
+ */
+static void reset_topic_aliases(uint16_t maximum) {
+	pthread_mutex_lock(&topicAliasLock);
+	for(int i = 0; i < MQTT_TOPIC_ALIAS_MAX; i++) {
+		free(topicAliases[i]);
+		topicAliases[i] = NULL;
+	}
+	topicAliasMaximum = maximum < MQTT_TOPIC_ALIAS_MAX ? maximum : MQTT_TOPIC_ALIAS_MAX;
+	pthread_mutex_unlock(&topicAliasLock);
+}
+
+/**
+ * @brief Cherche l'alias d'un topic, ou lui en attribue un.
+ * @note Appelée avec topicAliasLock pris.
+ * @param known true si l'alias a déjà été déclaré au broker (le topic peut alors être omis)
+ * @return L'alias, ou 0 si la table est pleine
+ */
+static uint16_t topic_alias_locked(const char *topic, bool *known) {
+	for(uint16_t i = 0; i < topicAliasMaximum; i++) {
+		if(!topicAliases[i]) {
+			topicAliases[i] = strdup(topic);
+			*known = false;
+			return topicAliases[i] ? i + 1 : 0;
+		}
+		if(strcmp(topicAliases[i], topic) == 0) {
+			*known = true;
+			return i + 1;
+		}
+	}
+	return 0;
+}
+
+/**
+ * @brief Publie avec un alias de topic.
+ * @details Réservé à QoS 0 : un message QoS 1/2 peut être retransmis par mosquitto sur une
+ * nouvelle connexion, dont la table d'alias est vide.
+ * @return Le code d'erreur de mosquitto
+ */
+static int publish_with_alias(const char *topic, const void *payload, size_t length, bool retain, mosquitto_property **props) {
+	pthread_mutex_lock(&topicAliasLock);
+	bool known = false;
+	uint16_t alias = topic_alias_locked(topic, &known);
+	int rc = alias > 0 ? mosquitto_property_add_int16(props, MQTT_PROP_TOPIC_ALIAS, alias) : MOSQ_ERR_SUCCESS;
+	// Sous le verrou : la déclaration de l'alias part avant les publications qui l'omettent
+	if(rc == MOSQ_ERR_SUCCESS) rc = mosquitto_publish_v5(mosq, NULL, alias > 0 && known ? NULL : topic, (int) length, payload, 0, retain, *props);
+	if(rc != MOSQ_ERR_SUCCESS && alias > 0 && !known) {
+		free(topicAliases[alias - 1]);
+		topicAliases[alias - 1] = NULL;
+	}
+	pthread_mutex_unlock(&topicAliasLock);
+	return rc;
+}
+
+/**
+ * @brief Transmet un message à mosquitto, avec ses propriétés en MQTT v5.
+ * @param properties Propriétés du message (NULL : aucune)
+ * @return Le code d'erreur de mosquitto
+ */
+static int publish_message(const char *topic, const void *payload, size_t length, int qos, bool retain, const mqtt_properties_t *properties) {
+	if(protocolVersion != MQTT_VERSION_5 || !properties) return mosquitto_publish(mosq, NULL, topic, (int) length, payload, qos, retain);
+
+	mosquitto_property *props = NULL;
+	int rc = MOSQ_ERR_SUCCESS;
+	if(properties->responseTopic) rc = mosquitto_property_add_string(&props, MQTT_PROP_RESPONSE_TOPIC, properties->responseTopic);
+	if(rc == MOSQ_ERR_SUCCESS && properties->correlationData && properties->correlationLength > 0) {
+		rc = properties->correlationLength > MQTT_CORRELATION_DATA_MAX_LENGTH ? MOSQ_ERR_INVAL
+			: mosquitto_property_add_binary(&props, MQTT_PROP_CORRELATION_DATA, properties->correlationData, (uint16_t) properties->correlationLength);
+	}
+	if(rc == MOSQ_ERR_SUCCESS && properties->messageExpirySec > 0) {
+		rc = mosquitto_property_add_int32(&props, MQTT_PROP_MESSAGE_EXPIRY_INTERVAL, properties->messageExpirySec);
+	}
+
+	if(rc == MOSQ_ERR_SUCCESS) {
+		if(properties->topicAlias && qos == 0) rc = publish_with_alias(topic, payload, length, retain, &props);
+		else rc = mosquitto_publish_v5(mosq, NULL, topic, (int) length, payload, qos, retain, props);
+	}
+	mosquitto_property_free_all(&props);
+	return rc;
+}
+
+/**
+ * @brief Transmet à mosquitto un message sorti de la file d'attente.
+ */
+static int send_queued_message(const mqtt_queued_message_t *message, void *context) {
+	UNUSED(context);
+	if(!__atomic_load_n(&isConnected, __ATOMIC_ACQUIRE)) return -1;
+	int rc = publish_message(message->topic, message->payload, message->length, message->qos, message->retain, &message->properties);
+	return rc == MOSQ_ERR_SUCCESS ? 0 : -1;
+}
+
+/**
+ * @brief Renvoie dans l'ordre les messages publiés pendant la coupure.
+ */
+static void drain_queue(void) {
+	if(!mqttQueueReady) return;
+	size_t sent = mqtt_queue_drain(&mqttQueue, send_queued_message, NULL);
+	if(sent == 0) return;
+
+	__atomic_store_n(&mqttQueueLossLogged, false, __ATOMIC_RELAXED);
+	if(mqttEventLoop && !event_loop_in_loop_thread(mqttEventLoop)) event_loop_wake(mqttEventLoop);
+	LOG_INFO_ASYNC("MQTT: %zu queued message(s) sent after reconnection.", sent);
+}
+
 static void on_connect_callback(struct mosquitto *mosq, void *data, int rc) {
     UNUSED(data); UNUSED(mosq);
 	if (rc == MOSQ_ERR_SUCCESS) {
         LOG_INFO_SYNC("MQTT: Connected to broker successfully.");
-        isConnected = true;
+        __atomic_store_n(&isConnected, true, __ATOMIC_RELEASE);
+        backoff_reset(&reconnectBackoff);
+        drain_queue();
     } else {
         LOG_ERROR_SYNC("MQTT: Connection failed: %s", mosquitto_connack_string(rc));
-        isConnected = false;
+        __atomic_store_n(&isConnected, false, __ATOMIC_RELEASE);
     }
 	sem_post(&connectSemaphore);
 }
 
+/**
+ * @brief Connexion en MQTT v5 : la table d'alias repart de zéro, bornée par le broker.
+ */
+static void on_connect_v5_callback(struct mosquitto *m, void *data, int rc, int flags, const mosquitto_property *props) {
+	UNUSED(flags);
+	uint16_t maximum = 0;
+	if(rc == MOSQ_ERR_SUCCESS) mosquitto_property_read_int16(props, MQTT_PROP_TOPIC_ALIAS_MAXIMUM, &maximum, false);
+	reset_topic_aliases(maximum);
+	on_connect_callback(m, data, rc);
+}
+
 static void on_disconnect_callback(struct mosquitto *m, void *data, int rc) {
 	UNUSED(m); UNUSED(data);
     if (rc == MOSQ_ERR_SUCCESS) {
@@ -58,46 +236,310 @@ static void on_disconnect_callback(struct mosquitto *m, void *data, int rc) {
     } else {
         LOG_WARNING_ASYNC("MQTT: Disconnected unexpectedly (rc: %d).", rc);
     }
-    isConnected = false;
+    __atomic_store_n(&isConnected, false, __ATOMIC_RELEASE);
 }
 
+/**
+ * @brief Transmet un message reçu au core puis au service.
+ * @details Le payload est transmis directement depuis le buffer de mosquitto ; un handler peut le
+ * détacher avec mqtt_payload_retain() (le buffer n'est alors plus libéré par mosquitto). Seul le
+ * callback historique (mqtt_set_message_callback()) reçoit une copie terminée par '\0'.
+ */
 static void on_message_callback(struct mosquitto *m, void *data, const struct mosquitto_message *message) {
 	UNUSED(m); UNUSED(data);
-    if (mqttOnMessageCallback && message->payloadlen > 0) {
-        char* payload_copy = (char *) malloc(message->payloadlen + 1);
-
-        if (payload_copy) {
-            memcpy(payload_copy, message->payload, message->payloadlen);
-            payload_copy[message->payloadlen] = '\0';
-            mqttOnMessageCallback(message->topic, payload_copy);
-            free(payload_copy);
-        } else {
-            LOG_ERROR_ASYNC("MQTT: Failed to allocate memory for message payload copy.");
-        }
-    }
+	if(message->payloadlen <= 0) return;
+	if(!mqttOnMessageCallback && !mqttOnPayloadCallback && !mqttControlHandler && !mqttRouter) return;
+
+	const void *payload = message->payload;
+	size_t length = (size_t) message->payloadlen;
+	// mosquitto libère message->payload après le retour du callback, sauf s'il a été détaché
+	mqtt_payload_delivery_begin(&((struct mosquitto_message *) message)->payload, length);
+
+	bool handled = mqttControlHandler && mqttControlHandler(message->topic, payload, length);
+	if(!handled && mqttRouter) mqtt_router_dispatch(mqttRouter, message->topic, payload, length);
+	if(!handled && mqttOnPayloadCallback) mqttOnPayloadCallback(message->topic, payload, length);
+	if(!handled && mqttOnMessageCallback) {
+		char *payloadCopy = (char *) malloc(length + 1);
+		if(payloadCopy) {
+			memcpy(payloadCopy, payload, length);
+			payloadCopy[length] = '\0';
+			mqttOnMessageCallback(message->topic, payloadCopy);
+			free(payloadCopy);
+		} else {
+			LOG_ERROR_ASYNC("MQTT: Failed to allocate memory for message payload copy.");
+		}
+	}
+
+	mqtt_payload_delivery_end();
+}
+
+/**
+ * @brief Réception en MQTT v5 : les propriétés du message sont exposées aux handlers le temps de
+ * la livraison (voir mqtt_message_properties()).
+ */
+static void on_message_v5_callback(struct mosquitto *m, void *data, const struct mosquitto_message *message, const mosquitto_property *props) {
+	char *responseTopic = NULL;
+	void *correlationData = NULL;
+	uint16_t correlationLength = 0;
+	uint32_t messageExpirySec = 0;
+	mosquitto_property_read_string(props, MQTT_PROP_RESPONSE_TOPIC, &responseTopic, false);
+	mosquitto_property_read_binary(props, MQTT_PROP_CORRELATION_DATA, &correlationData, &correlationLength, false);
+	mosquitto_property_read_int32(props, MQTT_PROP_MESSAGE_EXPIRY_INTERVAL, &messageExpirySec, false);
+
+	mqtt_properties_t properties = {
+		.responseTopic = responseTopic,
+		.correlationData = correlationData,
+		.correlationLength = correlationData ? correlationLength : 0,
+		.messageExpirySec = messageExpirySec
+	};
+	currentProperties = &properties;
+	on_message_callback(m, data, message);
+	currentProperties = NULL;
+
+	free(responseTopic);
+	free(correlationData);
+}
+
+/**
+ * @brief Attend avant une tentative de reconnexion.
+ * @return true si la déconnexion volontaire a été demandée pendant l'attente
+ */
+static bool wait_before_reconnect(uint32_t delayMs) {
+	struct timespec deadline;
+	clock_gettime(CLOCK_REALTIME, &deadline);
+	deadline.tv_sec += delayMs / 1000;
+	deadline.tv_nsec += (long) (delayMs % 1000) * 1000000L;
+	if(deadline.tv_nsec >= 1000000000L) {
+		deadline.tv_sec++;
+		deadline.tv_nsec -= 1000000000L;
+	}
+
+	pthread_mutex_lock(&mqttStopLock);
+	while(!mqttStopping && pthread_cond_timedwait(&mqttStopCond, &mqttStopLock, &deadline) == 0);
+	bool stopping = mqttStopping;
+	pthread_mutex_unlock(&mqttStopLock);
+	return stopping;
 }
 
+/**
+ * @brief Boucle réseau du thread dédié.
+ * @details Équivalent de mosquitto_loop_forever(), dont le délai de reconnexion est remplacé par
+ * un backoff exponentiel avec gigue : après un redémarrage du broker, les services ne se
+ * reconnectent pas tous au même instant.
+ */
 static void *mqtt_loop(void *arg) {
 	UNUSED(arg);
 	LOG_DEBUG_SYNC("MQTT: Network thread started.");
-	mosquitto_loop_forever(mosq, -1, 1);
+	while(!mqttStopping) {
+		int rc = mosquitto_loop(mosq, MQTT_LOOP_TIMEOUT_MS, 1);
+		if(rc == MOSQ_ERR_SUCCESS || mqttStopping) continue;
+
+		uint32_t delayMs = backoff_next(&reconnectBackoff);
+		LOG_WARNING_ASYNC("MQTT: Connection lost (%s), reconnecting in %u ms.", mosquitto_strerror(rc), delayMs);
+		if(wait_before_reconnect(delayMs)) break;
+		// En cas d'échec, le prochain mosquitto_loop() échoue aussi et allonge le délai
+		mosquitto_reconnect(mosq);
+	}
 
 	LOG_DEBUG_SYNC("MQTT: Network thread exiting.");
 	return NULL;
 }
 
+/**
+ * @brief Programme la prochaine tentative de reconnexion en mode boucle d'événements.
+ * @note La tentative est faite par le timer de maintenance : le délai est arrondi à sa période.
+ */
+static void schedule_reconnect(void) {
+	if(mqttStopping) return;
+	uint32_t delayMs = backoff_next(&reconnectBackoff);
+	nextReconnectMs = timer_wheel_now_ms() + delayMs;
+	LOG_WARNING_ASYNC("MQTT: Connection lost, reconnecting in %u ms.", delayMs);
+}
+
+/**
+ * @brief Traite l'activité de la socket du client dans la boucle d'événements.
+ * @details En cas d'erreur, mosquitto ferme la socket et appelle on_disconnect_callback() :
+ * la socket est retirée de la boucle et le timer de maintenance tente la reconnexion.
+ */
+static void on_socket_event(event_loop_t *loop, int fd, uint32_t events, void *context) {
+	UNUSED(context);
+	int rc = MOSQ_ERR_SUCCESS;
+	if(events & (EVENT_LOOP_READ | EVENT_LOOP_ERROR)) rc = mosquitto_loop_read(mosq, 1);
+	if(rc == MOSQ_ERR_SUCCESS && (events & EVENT_LOOP_WRITE)) rc = mosquitto_loop_write(mosq, 1);
+
+	if(rc != MOSQ_ERR_SUCCESS || mosquitto_socket(mosq) != fd) {
+		event_loop_remove_fd(loop, fd);
+		mqttSocketFd = -1;
+		schedule_reconnect();
+	}
+}
+
+/**
+ * @brief Enregistre la socket courante du client dans la boucle d'événements.
+ * @return 0 en cas de succès, -1 si le client n'a pas de socket
+ */
+static int attach_socket(void) {
+	int fd = mosquitto_socket(mosq);
+	if(fd < 0) return -1;
+
+	uint32_t events = EVENT_LOOP_READ | (mosquitto_want_write(mosq) ? EVENT_LOOP_WRITE : 0);
+	if(event_loop_add_fd(mqttEventLoop, fd, events, on_socket_event, NULL) != 0) return -1;
+	mqttSocketFd = fd;
+	return 0;
+}
+
+/**
+ * @brief Avant chaque attente : surveille la socket en écriture uniquement si des paquets sont en attente.
+ */
+static void prepare_socket(event_loop_t *loop, void *context) {
+	UNUSED(context);
+	if(mqttSocketFd < 0) return;
+	event_loop_modify_fd(loop, mqttSocketFd, EVENT_LOOP_READ | (mosquitto_want_write(mosq) ? EVENT_LOOP_WRITE : 0));
+}
+
+/**
+ * @brief Maintenance périodique : keep-alive, retransmissions QoS et reconnexion.
+ */
+static void on_misc_timer(event_loop_t *loop, event_loop_timer_t *timer, void *context) {
+	UNUSED(loop); UNUSED(timer); UNUSED(context);
+	if(mqttStopping) return;
+
+	if(mqttSocketFd >= 0) {
+		mosquitto_loop_misc(mosq);
+		return;
+	}
+
+	if(timer_wheel_now_ms() < nextReconnectMs) return;
+
+	// Reconnexion (bloquante le temps de la connexion TCP, comme dans mosquitto_loop_forever())
+	if(mosquitto_reconnect(mosq) == MOSQ_ERR_SUCCESS && attach_socket() == 0) {
+		LOG_INFO_ASYNC("MQTT: Reconnecting to broker...");
+		return;
+	}
+	schedule_reconnect();
+}
+
+/**
+ * @brief Démarre le pilotage du client par la boucle d'événements.
+ * @return 0 en cas de succès, -1 en cas d'échec
+ */
+static int start_event_loop_mode(void) {
+	if(attach_socket() != 0) return -1;
+
+	mqttMiscTimer = event_loop_add_timer(mqttEventLoop, MQTT_LOOP_MISC_INTERVAL_MS, MQTT_LOOP_MISC_INTERVAL_MS, on_misc_timer, NULL);
+	if(!mqttMiscTimer || event_loop_add_prepare(mqttEventLoop, prepare_socket, NULL) != 0) {
+		event_loop_cancel_timer(mqttEventLoop, mqttMiscTimer);
+		mqttMiscTimer = NULL;
+		event_loop_remove_fd(mqttEventLoop, mqttSocketFd);
+		mqttSocketFd = -1;
+		return -1;
+	}
+	return 0;
+}
+
+/**
+ * @brief Arrête le pilotage par la boucle après avoir transmis les paquets en attente (DISCONNECT compris).
+ */
+static void stop_event_loop_mode(void) {
+	for(int i = 0; i < MQTT_LOOP_FLUSH_ATTEMPTS && mosquitto_socket(mosq) >= 0 && mosquitto_want_write(mosq); i++) {
+		if(mosquitto_loop_write(mosq, 1) != MOSQ_ERR_SUCCESS) break;
+	}
+
+	event_loop_remove_prepare(mqttEventLoop, prepare_socket, NULL);
+	event_loop_cancel_timer(mqttEventLoop, mqttMiscTimer);
+	mqttMiscTimer = NULL;
+	if(mqttSocketFd >= 0) event_loop_remove_fd(mqttEventLoop, mqttSocketFd);
+	mqttSocketFd = -1;
+}
+
+/**
+ * @brief Fait piloter le client par une boucle d'événements au lieu d'un thread réseau dédié.
+ * @details Doit être appelé avant mqtt_connect(). La socket du client est surveillée par la boucle
+ * (mosquitto_loop_read() / mosquitto_loop_write()) et un timer appelle mosquitto_loop_misc() et
+ * gère la reconnexion : les callbacks de message sont alors appelés dans le thread de la boucle.
+ * mqtt_publish() reste appelable depuis n'importe quel thread.
+ * @param loop La boucle (NULL : thread réseau dédié, comportement par défaut)
+ */
+void mqtt_use_event_loop(event_loop_t *loop) {
+	mqttEventLoop = loop;
+}
+
 /**
  * @brief Définit le callback à appeler lors de la réception d'un message.
- * @details Doit être appelé avant mqtt_connect().
+ * @details Doit être appelé avant mqtt_connect(). Le payload est copié pour être terminé par '\0'.
  * @param callback La fonction à appeler.
  */
 void mqtt_set_message_callback(mqtt_message_callback_t callback) {
 	mqttOnMessageCallback = callback;
 }
 
+/**
+ * @brief Définit le gestionnaire appelé avant le callback du service pour chaque message reçu.
+ * @details Utilisé par le core pour traiter son topic de contrôle (voir service_control.h)
+ * indépendamment du callback défini par le service.
+ * @param handler La fonction à appeler (NULL : aucun).
+ */
+void mqtt_set_control_handler(mqtt_control_handler_t handler) {
+	mqttControlHandler = handler;
+}
+
+/**
+ * @brief Définit le callback à appeler lors de la réception d'un message, sans copie du payload.
+ * @details Doit être appelé avant mqtt_connect(). Préférable à mqtt_set_message_callback(), qui
+ * copie chaque payload pour le terminer par '\0'.
+ * @param callback La fonction à appeler.
+ */
+void mqtt_set_payload_callback(mqtt_payload_callback_t callback) {
+	mqttOnPayloadCallback = callback;
+}
+
+/**
+ * @brief Définit le routeur auquel les messages reçus sont transmis.
+ * @details Les messages non traités par le gestionnaire de contrôle sont routés, puis transmis
+ * aux callbacks du service s'ils sont définis.
+ * @param router Le routeur (NULL : aucun)
+ */
+void mqtt_set_router(mqtt_router_t *router) {
+	mqttRouter = router;
+}
+
+/**
+ * @brief Choisit la version du protocole MQTT.
+ * @details Doit être appelé avant mqtt_connect(). En MQTT v5, les propriétés des publications
+ * (topic de réponse, corrélation, expiration, alias de topic) sont transmises au broker et celles
+ * des messages reçus sont accessibles avec mqtt_message_properties().
+ * @param version La version (défaut : MQTT_VERSION_3_1_1)
+ */
+void mqtt_set_protocol_version(mqtt_version_t version) {
+	protocolVersion = version == MQTT_VERSION_5 ? MQTT_VERSION_5 : MQTT_VERSION_3_1_1;
+}
+
+/**
+ * @brief Configure la file des publications faites pendant une coupure de connexion.
+ * @details Doit être appelé avant mqtt_connect(). Sans appel, la file est créée avec les valeurs
+ * par défaut (voir mqtt_queue.h), sans fichier de débordement.
+ * @param config La configuration (copiée)
+ */
+void mqtt_set_offline_queue(const mqtt_queue_config_t *config) {
+	if(config) mqttQueueConfig = *config;
+}
+
+/**
+ * @brief Configure les délais de reconnexion après une perte de connexion.
+ * @details Doit être appelé avant mqtt_connect(). Le délai double à chaque échec, de minMs à maxMs,
+ * avec une gigue aléatoire (voir backoff.h), et revient à minMs à chaque connexion réussie.
+ * @param minMs Délai avant la première tentative (0 : MQTT_RECONNECT_DEFAULT_MIN_MS)
+ * @param maxMs Délai maximal (0 : MQTT_RECONNECT_DEFAULT_MAX_MS)
+ */
+void mqtt_set_reconnect_delay(uint32_t minMs, uint32_t maxMs) {
+	reconnectMinMs = minMs > 0 ? minMs : MQTT_RECONNECT_DEFAULT_MIN_MS;
+	reconnectMaxMs = maxMs > 0 ? maxMs : MQTT_RECONNECT_DEFAULT_MAX_MS;
+}
+
 /**
  * @brief Initialise et connecte le client MQTT, avec support du LWT.
- * @details Lance la boucle réseau dans un thread séparé.
+ * @details Lance la boucle réseau dans un thread séparé, ou l'enregistre dans la boucle
+ * d'événements fournie à mqtt_use_event_loop().
  * @param brokerIp IP du broker.
  * @param port Port du broker.
  * @param clientId ID unique pour ce client.
@@ -129,9 +571,21 @@ int mqtt_connect(const char* brokerIp, int port, const char* clientId, const cha
 		LOG_INFO_SYNC("MQTT: LWT set on topic '%s'.", lwtTopic);
 	}
 
-	mosquitto_connect_callback_set(mosq, on_connect_callback);
 	mosquitto_disconnect_callback_set(mosq, on_disconnect_callback);
-	mosquitto_message_callback_set(mosq, on_message_callback);
+	if(protocolVersion == MQTT_VERSION_5) {
+		mosquitto_int_option(mosq, MOSQ_OPT_PROTOCOL_VERSION, MQTT_PROTOCOL_V5);
+		mosquitto_connect_v5_callback_set(mosq, on_connect_v5_callback);
+		mosquitto_message_v5_callback_set(mosq, on_message_v5_callback);
+	} else {
+		mosquitto_connect_callback_set(mosq, on_connect_callback);
+		mosquitto_message_callback_set(mosq, on_message_callback);
+	}
+
+	// Les paquets publiés depuis d'autres threads sont mis en file et écrits par la boucle
+	if(mqttEventLoop) mosquitto_threaded_set(mosq, true);
+	mqttStopping = false;
+	backoff_init(&reconnectBackoff, reconnectMinMs, reconnectMaxMs);
+	nextReconnectMs = 0;
 
 	rc = mosquitto_connect(mosq, brokerIp, port, MQTT_KEEP_ALIVE_INTERVAL_SEC);
 	if(rc != MOSQ_ERR_SUCCESS) {
@@ -139,6 +593,23 @@ int mqtt_connect(const char* brokerIp, int port, const char* clientId, const cha
 		MQTT_FAILED_CLEANUP(mosq);
 	}
 
+	// Avant le démarrage de la boucle réseau : on_connect_callback() vide la file
+	if(mqtt_queue_init(&mqttQueue, &mqttQueueConfig) != 0) {
+		LOG_WARNING_SYNC("MQTT: Unable to open spool file '%s', offline messages are kept in memory only.", mqttQueueConfig.spoolPath);
+	}
+	mqttQueueReady = true;
+	__atomic_store_n(&mqttQueueLossLogged, false, __ATOMIC_RELAXED);
+
+	if(mqttEventLoop) {
+		if(start_event_loop_mode() != 0) {
+			LOG_ERROR_SYNC("MQTT: Failed to register the client in the event loop.");
+			mosquitto_disconnect(mosq);
+			MQTT_FAILED_CLEANUP(mosq);
+		}
+		LOG_INFO_SYNC("MQTT: Client initialized and connecting to %s:%d (event loop)", brokerIp, port);
+		return 0;
+	}
+
 	rc = pthread_create(&mqttThread, NULL, mqtt_loop, NULL);
 	if(rc != 0) {
 		LOG_ERROR_SYNC("MQTT: Failed to create network thread.");
@@ -146,7 +617,7 @@ int mqtt_connect(const char* brokerIp, int port, const char* clientId, const cha
 		MQTT_FAILED_CLEANUP(mosq);
 	}
 
-	LOG_INFO_SYNC("MQTT: Client initialized and connecting to %s:%d", brokerIp, port);
+	LOG_INFO_SYNC("MQTT: Client initialized and connecting to %s:%d (MQTT %s)", brokerIp, port, protocolVersion == MQTT_VERSION_5 ? "v5" : "3.1.1");
 	return 0;
 }
 
@@ -154,15 +625,28 @@ int mqtt_connect(const char* brokerIp, int port, const char* clientId, const cha
  * @brief Attend que la tentative de connexion initiale soit terminée.
  * @details Attend la notification du thread réseau (via sémaphore)
  * que la connexion a réussi, échoué, ou que le timeout est atteint.
+ * En mode boucle d'événements, la boucle est exécutée pendant l'attente.
  * @param timeout_sec Le temps maximum d'attente en secondes.
  * @return 0 si la connexion est établie avec succès, -1 si échec ou timeout.
  */
 int mqtt_wait_for_connection(int timeout_sec) {
-	struct timespec ts;
-	clock_gettime(CLOCK_REALTIME, &ts);
-	ts.tv_sec += timeout_sec;
+	int semResult;
+	if(mqttEventLoop) {
+		struct timespec start, now;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		while((semResult = sem_trywait(&connectSemaphore)) != 0) {
+			clock_gettime(CLOCK_MONOTONIC, &now);
+			long elapsedMs = (now.tv_sec - start.tv_sec) * 1000L + (now.tv_nsec - start.tv_nsec) / 1000000L;
+			if(elapsedMs >= timeout_sec * 1000L) break;
+			event_loop_run_once(mqttEventLoop, (int) (timeout_sec * 1000L - elapsedMs));
+		}
+	} else {
+		struct timespec ts;
+		clock_gettime(CLOCK_REALTIME, &ts);
+		ts.tv_sec += timeout_sec;
+		semResult = sem_timedwait(&connectSemaphore, &ts);
+	}
 
-	int semResult = sem_timedwait(&connectSemaphore, &ts);
 	if (semResult != 0) {
 		LOG_ERROR_SYNC("MQTT: Connection timed out after %d seconds.", timeout_sec);
 		return -1;
@@ -174,6 +658,7 @@ int mqtt_wait_for_connection(int timeout_sec) {
 
 /**
  * @brief Déconnecte proprement le client MQTT et arrête le thread réseau.
+ * @note En mode boucle d'événements, doit être appelée avant event_loop_destroy().
  */
 void mqtt_disconnect(void) {
 	if(!mosq) {
@@ -181,8 +666,19 @@ void mqtt_disconnect(void) {
 		return;
 	}
 
+	pthread_mutex_lock(&mqttStopLock);
+	mqttStopping = true;
+	pthread_cond_broadcast(&mqttStopCond);
+	pthread_mutex_unlock(&mqttStopLock);
 	mosquitto_disconnect(mosq);
-	pthread_join(mqttThread, NULL);
+	if(mqttEventLoop) stop_event_loop_mode();
+	else pthread_join(mqttThread, NULL);
+
+	size_t pending = mqtt_queue_count(&mqttQueue);
+	if(pending > 0) LOG_WARNING_SYNC("MQTT: %zu queued message(s) discarded at shutdown.", pending);
+	mqttQueueReady = false;
+	mqtt_queue_destroy(&mqttQueue);
+	reset_topic_aliases(0);
 	mosquitto_destroy(mosq);
 	mosq = NULL;
 	mosquitto_lib_cleanup();
@@ -193,23 +689,138 @@ void mqtt_disconnect(void) {
 
 /**
  * @brief Publie un message sur un topic.
+ * @details Message de priorité commande (voir mqtt_publish_with_options()).
  * @param topic Le topic.
  * @param payload Le message.
  * @param qos Le niveau de QoS à utiliser.
  * @param retain Flag de rétention du message.
- * @return 0 en cas de succès, -1 en cas d'échec.
+ * @return 0 si le message a été publié ou mis en file, -1 s'il est perdu.
  */
 int mqtt_publish(const char* topic, const char* payload, mqtt_qos_enum_t qos, bool retain) {
-	if(!mosq) {
+	return mqtt_publish_with_options(topic, payload, payload ? strlen(payload) : 0, qos, retain, NULL);
+}
+
+/**
+ * @brief Met en file un message qui ne peut pas être publié immédiatement.
+ * @return 0 si le message est conservé, -1 s'il est perdu
+ */
+static int queue_message(const char* topic, const void* payload, size_t length, mqtt_qos_enum_t qos, bool retain, const mqtt_publish_options_t *options) {
+	mqtt_queue_result_t result = mqtt_queue_push(&mqttQueue, topic, payload, length, (int) qos, retain, options->priority, &options->properties);
+	// Une alerte par coupure : les logs publiés pendant la coupure passent aussi par la file
+	if((result == MQTT_QUEUE_DROPPED || result == MQTT_QUEUE_EVICTED) && !__atomic_exchange_n(&mqttQueueLossLogged, true, __ATOMIC_RELAXED)) {
+		LOG_WARNING_ASYNC("MQTT: Offline queue full, messages are being dropped (%zu so far).", mqtt_queue_dropped(&mqttQueue));
+	}
+	// Reconnecté entre temps : les messages en attente partent sans attendre
+	if(__atomic_load_n(&isConnected, __ATOMIC_ACQUIRE)) drain_queue();
+	return result == MQTT_QUEUE_DROPPED ? -1 : 0;
+}
+
+/**
+ * @brief Publie un message sur un topic, avec options.
+ * @details Si le client est déconnecté, ou si des messages publiés pendant une coupure attendent
+ * encore, le message est mis en file (voir mqtt_queue.h) et renvoyé dans l'ordre à la
+ * reconnexion.
+ * @param topic Le topic.
+ * @param payload Le message.
+ * @param length Taille du message en octets.
+ * @param qos Le niveau de QoS à utiliser.
+ * @param retain Flag de rétention du message.
+ * @param options Options de publication (NULL : valeurs par défaut, priorité commande, sans propriétés).
+ * @return 0 si le message a été publié ou mis en file, -1 s'il est perdu.
+ */
+int mqtt_publish_with_options(const char* topic, const void* payload, size_t length, mqtt_qos_enum_t qos, bool retain, const mqtt_publish_options_t *options) {
+	if(!mosq || !mqttQueueReady) {
 		LOG_ERROR_ASYNC("MQTT: Client not initialized.");
 		return -1;
 	}
+	static const mqtt_publish_options_t defaultOptions = { .priority = MQTT_PRIORITY_COMMAND };
+	if(!options) options = &defaultOptions;
+
+	// Tant que des messages attendent, les nouveaux passent derrière eux pour conserver l'ordre
+	if(!__atomic_load_n(&isConnected, __ATOMIC_ACQUIRE) || mqtt_queue_count(&mqttQueue) > 0) return queue_message(topic, payload, length, qos, retain, options);
 
-	int rc = mosquitto_publish(mosq, NULL, topic, strlen(payload), payload, (int)qos, retain);
+	int rc = publish_message(topic, payload, length, (int) qos, retain, &options->properties);
+	if(rc == MOSQ_ERR_NO_CONN || rc == MOSQ_ERR_CONN_LOST) return queue_message(topic, payload, length, qos, retain, options);
 	if(rc != MOSQ_ERR_SUCCESS) {
 		LOG_ERROR_ASYNC("MQTT: Failed to publish message: %s", mosquitto_strerror(rc));
 		return -1;
 	}
+
+	// Depuis un autre thread, la boucle doit réévaluer son intérêt en écriture
+	if(mqttEventLoop && !event_loop_in_loop_thread(mqttEventLoop)) event_loop_wake(mqttEventLoop);
+	return 0;
+}
+
+/**
+ * @brief Publie une commande.
+ * @details En MQTT v5, le topic de réponse et l'ID de la commande sont aussi transmis en
+ * propriétés (Response Topic, Correlation Data) et, en QoS 0, le topic est remplacé par un alias.
+ * @param topic Le topic de requête du service destinataire.
+ * @param header L'en-tête de la commande sérialisée dans payload.
+ * @param payload La commande.
+ * @param qos Le niveau de QoS à utiliser.
+ * @return 0 si la commande a été publiée ou mise en file, -1 sinon.
+ */
+int mqtt_publish_command(const char *topic, const command_header_t *header, const char *payload, mqtt_qos_enum_t qos) {
+	if(!header) return -1;
+	mqtt_publish_options_t options = {
+		.priority = MQTT_PRIORITY_COMMAND,
+		.properties = {
+			.responseTopic = header->replyTopic[0] != '\0' ? header->replyTopic : NULL,
+			.correlationData = header->commandId,
+			.correlationLength = strlen(header->commandId),
+			.topicAlias = true
+		}
+	};
+	return mqtt_publish_with_options(topic, payload, payload ? strlen(payload) : 0, qos, false, &options);
+}
+
+/**
+ * @brief Publie la réponse à une commande sur son topic de réponse.
+ * @details En MQTT v5, l'ID de la commande est transmis en données de corrélation.
+ * @param request L'en-tête de la commande reçue.
+ * @param payload La réponse.
+ * @param qos Le niveau de QoS à utiliser.
+ * @return 0 si la réponse a été publiée ou mise en file, -1 sinon (y compris sans topic de réponse).
+ */
+int mqtt_publish_reply(const command_header_t *request, const char *payload, mqtt_qos_enum_t qos) {
+	if(!request || request->replyTopic[0] == '\0') return -1;
+	mqtt_publish_options_t options = {
+		.priority = MQTT_PRIORITY_COMMAND,
+		.properties = {
+			.correlationData = request->commandId,
+			.correlationLength = strlen(request->commandId)
+		}
+	};
+	return mqtt_publish_with_options(request->replyTopic, payload, payload ? strlen(payload) : 0, qos, false, &options);
+}
+
+/**
+ * @brief Retourne les propriétés MQTT v5 du message en cours de livraison dans ce thread.
+ * @details Appelable depuis les handlers de réception (routeur, callbacks, gestionnaire de
+ * contrôle) ; les pointeurs sont valides jusqu'au retour du handler.
+ * @return Les propriétés, ou NULL hors livraison ou en MQTT 3.1.1
+ */
+const mqtt_properties_t *mqtt_message_properties(void) {
+	return currentProperties;
+}
+
+/**
+ * @brief Copie en chaîne les données de corrélation du message en cours de livraison.
+ * @details Utilisé par les en-têtes de commande pour retrouver l'ID d'une commande ou d'une
+ * réponse publiée en MQTT v5 sans champ commandId dans son JSON.
+ * @param buffer Destination, terminée par '\0'
+ * @param size Taille de la destination
+ * @return 0 en cas de succès, -1 si le message n'a pas de données de corrélation ou si elles ne
+ * tiennent pas dans buffer
+ */
+int mqtt_message_correlation_string(char *buffer, size_t size) {
+	const mqtt_properties_t *properties = currentProperties;
+	if(!properties || !properties->correlationData || properties->correlationLength == 0) return -1;
+	if(properties->correlationLength >= size || memchr(properties->correlationData, '\0', properties->correlationLength)) return -1;
+
+	memcpy(buffer, properties->correlationData, properties->correlationLength);
+	buffer[properties->correlationLength] = '\0';
 	return 0;
 }
 
@@ -241,7 +852,7 @@ int mqtt_subscribe(const char* topic, mqtt_qos_enum_t qos) {
  * @return true si connecté, false sinon.
  */
 bool mqtt_is_connected(void) {
-	return isConnected;
+	return __atomic_load_n(&isConnected, __ATOMIC_ACQUIRE);
 }
 
 
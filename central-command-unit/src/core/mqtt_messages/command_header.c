@@ -11,20 +11,22 @@
  */
 
 #include "core/mqtt_messages/command_header.h"
+#include "core/mqtt.h"
 
 /**
  * @brief Crée et initialise une structure d'en-tête de commande.
  * @param action Chaîne représentant l'action de la commande.
  * @param replyTopic Chaîne représentant le topic de réponse.
  * @return Structure d'en-tête de commande initialisée.
- * @note la fonction génère un ID pour commandId et initialise le timestamp courant.
+ * @note la fonction génère un ID unique pour commandId ("<action>-<16 hex>", voir command_id.h)
+ * et initialise le timestamp courant.
  */
 command_header_t create_command_header(const char *action, const char *replyTopic) {
 	command_header_t header = {0};
 	struct timespec ts;
 
 	clock_gettime(CLOCK_REALTIME, &ts);
-	snprintf(header.commandId, COMMAND_ID_LENGTH, "%s-%ld%09ld", action, ts.tv_sec, ts.tv_nsec);
+	command_id_format(header.commandId, COMMAND_ID_LENGTH, action, command_id_next());
 	strncpy(header.action, action, ACTION_LENGTH - 1);
 	strncpy(header.replyTopic, replyTopic, REPLY_TOPIC_LENGTH - 1);
 	header.timestamp = ts;
@@ -50,16 +52,22 @@ int command_header_serialize(const command_header_t *header, cJSON *root) {
 /**
  * @brief Remplit une structure d'en-tête à partir d'un objet cJSON.
  * @details Lit les clés "command_id", "action", "timestamp" depuis l'objet JSON racine.
+ * Pendant la livraison d'un message MQTT v5, "commandId" et "replyTopic" peuvent être omis :
+ * les propriétés Correlation Data et Response Topic du message sont alors utilisées.
  * @param root Pointeur vers l'objet cJSON racine contenant les données de l'en-tête.
  * @param header Pointeur vers la structure d'en-tête à remplir.
  * @return 0 en cas de succès, -1 si un champ est manquant ou du mauvais type.
  */
 int command_header_deserialize(const cJSON *root, command_header_t *header) {
-	const cJSON *commandItem = cJSON_GetObjectItemCaseSensitive(root, "commandId");
-	if (!cJSON_IsString(commandItem) || (commandItem->valuestring == NULL)) return -1;
+	const mqtt_properties_t *properties = mqtt_message_properties();
 
-	strncpy(header->commandId, commandItem->valuestring, COMMAND_ID_LENGTH - 1);
-	header->commandId[COMMAND_ID_LENGTH - 1] = '\0';
+	const cJSON *commandItem = cJSON_GetObjectItemCaseSensitive(root, "commandId");
+	if (cJSON_IsString(commandItem) && (commandItem->valuestring != NULL)) {
+		strncpy(header->commandId, commandItem->valuestring, COMMAND_ID_LENGTH - 1);
+		header->commandId[COMMAND_ID_LENGTH - 1] = '\0';
+	} else if (commandItem || mqtt_message_correlation_string(header->commandId, COMMAND_ID_LENGTH) != 0) {
+		return -1;
+	}
 
 	const cJSON *actionItem = cJSON_GetObjectItemCaseSensitive(root, "action");
 	if (!cJSON_IsString(actionItem) || (actionItem->valuestring == NULL)) return -1;
@@ -68,9 +76,12 @@ int command_header_deserialize(const cJSON *root, command_header_t *header) {
 	header->action[ACTION_LENGTH - 1] = '\0';
 
 	const cJSON *replyTopicItem = cJSON_GetObjectItemCaseSensitive(root, "replyTopic");
-	if (!cJSON_IsString(replyTopicItem) || (replyTopicItem->valuestring == NULL)) return -1;
+	const char *replyTopic = NULL;
+	if (cJSON_IsString(replyTopicItem) && (replyTopicItem->valuestring != NULL)) replyTopic = replyTopicItem->valuestring;
+	else if (!replyTopicItem && properties) replyTopic = properties->responseTopic;
+	if (!replyTopic) return -1;
 
-	strncpy(header->replyTopic, replyTopicItem->valuestring, REPLY_TOPIC_LENGTH - 1);
+	strncpy(header->replyTopic, replyTopic, REPLY_TOPIC_LENGTH - 1);
 	header->replyTopic[REPLY_TOPIC_LENGTH - 1] = '\0';
 
 	return 0;
@@ -10,6 +10,7 @@
  * @date 2025-10-28
  */
 #include "core/mqtt_messages/command_response_header.h"
+#include "core/mqtt.h"
 
 
 /**
@@ -55,7 +56,7 @@ int command_response_header_to_json(const command_response_header_t *header, cJS
 	if(!cJSON_AddStringToObject(root, "commandId", header->commandId)) {
 		return -1;
 	}
-	if(!cJSON_AddBoolToObject(root, "success", header->success ? cJSON_True : cJSON_False)) {
+	if(!cJSON_AddBoolToObject(root, "success", header->success)) {
 		return -1;
 	}
 	if(!cJSON_AddNumberToObject(root, "timestampSec", (double) header->timestamp.tv_sec)) {
@@ -94,21 +95,23 @@ char *command_response_header_serialize(const command_response_header_t *header)
 /**
  * @brief Remplit une structure d'en-tête de réponse à partir d'un objet cJSON.
  * @details Lit les clés "command_id", "success", "error_message" (si échec),
- * "timestamp_s", "timestamp_ns".
+ * "timestamp_s", "timestamp_ns". Pendant la livraison d'un message MQTT v5, "commandId" peut
+ * être omis : les données de corrélation du message sont alors utilisées.
  * @param root Pointeur vers l'objet cJSON racine.
  * @param header Pointeur vers la structure d'en-tête de réponse à remplir.
  * @return 0 en cas de succès, -1 si un champ est manquant/mauvais type.
  */
 int command_response_header_deserialize(const cJSON *root, command_response_header_t *header) {
 	const cJSON *commandItem = cJSON_GetObjectItemCaseSensitive(root, "commandId");
-	if (!cJSON_IsString(commandItem) || (commandItem->valuestring == NULL)) {
+	if (cJSON_IsString(commandItem) && (commandItem->valuestring != NULL)) {
+		strncpy(header->commandId, commandItem->valuestring, COMMAND_ID_LENGTH - 1);
+		header->commandId[COMMAND_ID_LENGTH - 1] = '\0';
+	} else if (commandItem || mqtt_message_correlation_string(header->commandId, COMMAND_ID_LENGTH) != 0) {
+		// Sans champ commandId, une réponse MQTT v5 est corrélée par ses données de corrélation
 		LOG_DEBUG_ASYNC("command_response_header_deserialize: commandId missing or not a string");
 		return -1;
 	}
 
-	strncpy(header->commandId, commandItem->valuestring, COMMAND_ID_LENGTH - 1);
-	header->commandId[COMMAND_ID_LENGTH - 1] = '\0';
-
 	const cJSON *successItem = cJSON_GetObjectItemCaseSensitive(root, "success");
 	if (!cJSON_IsBool(successItem)) {
 		LOG_DEBUG_ASYNC("command_response_header_deserialize: success missing or not a boolean");
@@ -0,0 +1,145 @@
+/**
+ * @file plan_route_batch_request.c
+ * @brief Définitions du modèle de données pour les requêtes de planification de trajets par lot.
+ * @date 2026-10-19
+ */
+
+#include "core/mqtt_messages/plan_route_batch_request.h"
+
+/**
+ * @brief Sérialise une requête de planification par lot en JSON.
+ * @param msg Pointeur vers la requête à sérialiser.
+ * @return Chaîne JSON représentant la requête, ou NULL en cas d'erreur.
+ * @warning La mémoire allouée pour la chaîne JSON doit être libérée par l'appelant.
+ */
+char *plan_route_batch_request_serialize(const plan_route_batch_request_t *msg) {
+	cJSON *root = NULL;
+	char *jsonString = NULL;
+
+	if (!msg) return NULL;
+
+	root = cJSON_CreateObject();
+	if (!root) return NULL;
+
+	if (command_header_serialize(&msg->header, root) != 0) goto cleanup;
+	if (!cJSON_AddBoolToObject(root, "includePath", msg->includePath)) goto cleanup;
+
+	cJSON *entriesArray = cJSON_AddArrayToObject(root, "entries");
+	if (!entriesArray) goto cleanup;
+
+	for (int i = 0; i < msg->entryCount; i++) {
+		const plan_route_batch_entry_t *entry = &msg->entries[i];
+		cJSON *entryObject = cJSON_CreateObject();
+		if (!entryObject) goto cleanup;
+		cJSON_AddItemToArray(entriesArray, entryObject);
+
+		if (!cJSON_AddNumberToObject(entryObject, "carId", entry->carId)) goto cleanup;
+
+		cJSON *nodeArray = cJSON_CreateIntArray(entry->nodeIds, entry->nodeCount);
+		if (!nodeArray) goto cleanup;
+		cJSON_AddItemToObject(entryObject, "nodeList", nodeArray);
+
+		if (!cJSON_AddBoolToObject(entryObject, "optimizeOrder", entry->optimizeOrder)) goto cleanup;
+		if (!cJSON_AddBoolToObject(entryObject, "keepLastStop", entry->keepLastStop)) goto cleanup;
+	}
+
+	jsonString = CJSON_PRINT(root);
+
+	cleanup:
+		cJSON_Delete(root);
+
+	return jsonString;
+}
+
+/**
+ * @brief Désérialise une entrée du lot.
+ * @return 0 en cas de succès, -1 en cas d'erreur.
+ * @internal
+ */
+static int entry_deserialize(const cJSON *entryObject, plan_route_batch_entry_t *entry) {
+	const cJSON *carIdItem = cJSON_GetObjectItemCaseSensitive(entryObject, "carId");
+	if (!cJSON_IsNumber(carIdItem)) return -1;
+	entry->carId = carIdItem->valueint;
+
+	const cJSON *nodeArray = cJSON_GetObjectItemCaseSensitive(entryObject, "nodeList");
+	if (!cJSON_IsArray(nodeArray)) return -1;
+
+	entry->nodeCount = cJSON_GetArraySize(nodeArray);
+	entry->nodeIds = NULL;
+	if (entry->nodeCount > 0) {
+		entry->nodeIds = malloc(sizeof(int) * entry->nodeCount);
+		if (!entry->nodeIds) return -1;
+	}
+
+	int i = 0;
+	const cJSON *nodeItem = NULL;
+	cJSON_ArrayForEach(nodeItem, nodeArray) {
+		if (!cJSON_IsNumber(nodeItem)) {
+			free(entry->nodeIds);
+			entry->nodeIds = NULL;
+			return -1;
+		}
+		entry->nodeIds[i++] = nodeItem->valueint;
+	}
+
+	// Champs optionnels : absents = ordre de passage conservé
+	const cJSON *optimizeItem = cJSON_GetObjectItemCaseSensitive(entryObject, "optimizeOrder");
+	entry->optimizeOrder = cJSON_IsBool(optimizeItem) && cJSON_IsTrue(optimizeItem);
+
+	const cJSON *keepLastItem = cJSON_GetObjectItemCaseSensitive(entryObject, "keepLastStop");
+	entry->keepLastStop = cJSON_IsBool(keepLastItem) && cJSON_IsTrue(keepLastItem);
+	return 0;
+}
+
+/**
+ * @brief Désérialise les données d'une requête de planification par lot.
+ * @details Alloue msg->entries et le tableau nodeIds de chaque entrée.
+ * @param root Pointeur vers l'objet cJSON racine.
+ * @param msg Pointeur vers la structure à remplir.
+ * @warning Cette fonction s'occupe uniquement de désérialiser les données. Le header doit être désérialisé séparément.
+ * @return 0 en cas de succès, -1 en cas d'erreur (rien n'est alloué dans ce cas).
+ */
+int plan_route_batch_request_data_deserialize(cJSON *root, plan_route_batch_request_t *msg) {
+	if (!root || !msg) return -1;
+
+	msg->entries = NULL;
+	msg->entryCount = 0;
+
+	const cJSON *includePathItem = cJSON_GetObjectItemCaseSensitive(root, "includePath");
+	msg->includePath = !cJSON_IsBool(includePathItem) || cJSON_IsTrue(includePathItem);
+
+	const cJSON *entriesArray = cJSON_GetObjectItemCaseSensitive(root, "entries");
+	if (!cJSON_IsArray(entriesArray)) return -1;
+
+	int entryCount = cJSON_GetArraySize(entriesArray);
+	if (entryCount > PLAN_ROUTE_BATCH_MAX_ENTRIES) return -1;
+	if (entryCount == 0) return 0;
+
+	msg->entries = calloc(entryCount, sizeof(plan_route_batch_entry_t));
+	if (!msg->entries) return -1;
+
+	const cJSON *entryObject = NULL;
+	cJSON_ArrayForEach(entryObject, entriesArray) {
+		if (entry_deserialize(entryObject, &msg->entries[msg->entryCount]) != 0) {
+			plan_route_batch_request_destroy(msg);
+			return -1;
+		}
+		msg->entryCount++;
+	}
+	return 0;
+}
+
+/**
+ * @brief Libère la mémoire allouée pour une requête de planification par lot.
+ * @param msg Pointeur vers la requête à libérer
+ */
+void plan_route_batch_request_destroy(plan_route_batch_request_t *msg) {
+	if (!msg) return;
+
+	for (int i = 0; i < msg->entryCount; i++) {
+		free(msg->entries[i].nodeIds);
+	}
+	free(msg->entries);
+	msg->entries = NULL;
+	msg->entryCount = 0;
+}
@@ -0,0 +1,157 @@
+/**
+ * @file plan_route_batch_response.c
+ * @brief Définitions du modèle de données pour les réponses de planification de trajets par lot.
+ * @date 2026-10-19
+ */
+
+#include "core/mqtt_messages/plan_route_batch_response.h"
+
+/**
+ * @brief Sérialise une réponse de planification par lot en JSON.
+ * @details Ajoute "failedCount", le nombre d'entrées en échec.
+ * @param msg Pointeur vers la structure à sérialiser.
+ * @return Chaîne JSON allouée (à libérer par l'appelant), ou NULL en cas d'erreur.
+ */
+char *plan_route_batch_response_serialize(const plan_route_batch_response_t *msg) {
+	if (!msg) return NULL;
+
+	cJSON *root = cJSON_CreateObject();
+	if (!root) return NULL;
+
+	if (command_response_header_to_json(&msg->header, root) != 0) goto error;
+
+	cJSON *resultsArray = cJSON_AddArrayToObject(root, "results");
+	if (!resultsArray) goto error;
+
+	int failedCount = 0;
+	for (int i = 0; i < msg->resultCount; i++) {
+		const plan_route_batch_result_t *result = &msg->results[i];
+		cJSON *resultObject = cJSON_CreateObject();
+		if (!resultObject) goto error;
+		cJSON_AddItemToArray(resultsArray, resultObject);
+
+		cJSON_AddNumberToObject(resultObject, "carId", result->carId);
+		cJSON_AddBoolToObject(resultObject, "success", result->success);
+
+		if (!result->success) {
+			failedCount++;
+			cJSON_AddStringToObject(resultObject, "error_message", result->errorMessage);
+			continue;
+		}
+
+		cJSON_AddNumberToObject(resultObject, "cost", result->cost);
+		cJSON_AddNumberToObject(resultObject, "savedDistance", result->savedDistance);
+		if (result->nodeCount > 0 && result->nodeIds) {
+			cJSON *nodesArray = cJSON_CreateIntArray(result->nodeIds, result->nodeCount);
+			if (!nodesArray) goto error;
+			cJSON_AddItemToObject(resultObject, "nodeIds", nodesArray);
+		}
+	}
+	cJSON_AddNumberToObject(root, "failedCount", failedCount);
+
+	char *jsonString = CJSON_PRINT(root);
+	cJSON_Delete(root);
+	return jsonString;
+
+	error:
+		cJSON_Delete(root);
+		return NULL;
+}
+
+/**
+ * @brief Désérialise un résultat du lot.
+ * @return 0 en cas de succès, -1 en cas d'erreur.
+ * @internal
+ */
+static int result_deserialize(const cJSON *resultObject, plan_route_batch_result_t *result) {
+	const cJSON *carIdItem = cJSON_GetObjectItemCaseSensitive(resultObject, "carId");
+	const cJSON *successItem = cJSON_GetObjectItemCaseSensitive(resultObject, "success");
+	if (!cJSON_IsNumber(carIdItem) || !cJSON_IsBool(successItem)) return -1;
+
+	result->carId = carIdItem->valueint;
+	result->success = cJSON_IsTrue(successItem);
+
+	if (!result->success) {
+		const cJSON *errorItem = cJSON_GetObjectItemCaseSensitive(resultObject, "error_message");
+		if (cJSON_IsString(errorItem)) {
+			strncpy(result->errorMessage, errorItem->valuestring, MAX_ERROR_MSG_LEN - 1);
+			result->errorMessage[MAX_ERROR_MSG_LEN - 1] = '\0';
+		}
+		return 0;
+	}
+
+	const cJSON *costItem = cJSON_GetObjectItemCaseSensitive(resultObject, "cost");
+	const cJSON *savedItem = cJSON_GetObjectItemCaseSensitive(resultObject, "savedDistance");
+	result->cost = cJSON_IsNumber(costItem) ? costItem->valuedouble : 0.0;
+	result->savedDistance = cJSON_IsNumber(savedItem) ? savedItem->valuedouble : 0.0;
+
+	const cJSON *nodesArray = cJSON_GetObjectItemCaseSensitive(resultObject, "nodeIds");
+	if (!cJSON_IsArray(nodesArray) || cJSON_GetArraySize(nodesArray) == 0) return 0;
+
+	int nodeCount = cJSON_GetArraySize(nodesArray);
+	result->nodeIds = (int *) malloc(sizeof(int) * nodeCount);
+	if (!result->nodeIds) return -1;
+
+	const cJSON *item = NULL;
+	cJSON_ArrayForEach(item, nodesArray) {
+		if (!cJSON_IsNumber(item)) {
+			free(result->nodeIds);
+			result->nodeIds = NULL;
+			result->nodeCount = 0;
+			return -1;
+		}
+		result->nodeIds[result->nodeCount++] = item->valueint;
+	}
+	return 0;
+}
+
+/**
+ * @brief Désérialise les résultats d'une réponse de planification par lot.
+ * @details Alloue msg->results et le tableau nodeIds de chaque résultat.
+ * @param root L'objet cJSON racine (déjà parsé).
+ * @param msg Pointeur vers la structure à remplir.
+ * @return 0 en cas de succès, -1 en cas d'erreur (rien n'est alloué dans ce cas).
+ */
+int plan_route_batch_response_data_deserialize(const cJSON *root, plan_route_batch_response_t *msg) {
+	if (!root || !msg) return -1;
+
+	msg->results = NULL;
+	msg->resultCount = 0;
+
+	const cJSON *resultsArray = cJSON_GetObjectItemCaseSensitive(root, "results");
+	if (!cJSON_IsArray(resultsArray)) {
+		// Réponse d'erreur globale : pas de résultats
+		return msg->header.success ? -1 : 0;
+	}
+
+	int resultCount = cJSON_GetArraySize(resultsArray);
+	if (resultCount == 0) return 0;
+
+	msg->results = calloc(resultCount, sizeof(plan_route_batch_result_t));
+	if (!msg->results) return -1;
+
+	const cJSON *resultObject = NULL;
+	cJSON_ArrayForEach(resultObject, resultsArray) {
+		if (result_deserialize(resultObject, &msg->results[msg->resultCount]) != 0) {
+			plan_route_batch_response_destroy(msg);
+			return -1;
+		}
+		msg->resultCount++;
+	}
+	return 0;
+}
+
+/**
+ * @brief Libère la mémoire allouée pour une réponse de planification par lot.
+ * @param msg Pointeur vers la réponse à libérer
+ */
+void plan_route_batch_response_destroy(plan_route_batch_response_t *msg) {
+	if (!msg) return;
+
+	for (int i = 0; i < msg->resultCount; i++) {
+		free(msg->results[i].nodeIds);
+	}
+	free(msg->results);
+	msg->results = NULL;
+	msg->resultCount = 0;
+}
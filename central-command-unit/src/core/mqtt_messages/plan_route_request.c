@@ -40,6 +40,9 @@ char *plan_route_request_serialize(const plan_route_request_t *msg) {
 		cJSON_AddItemToArray(nodeArray, nodeIdNum);
 	}
 
+	if (!cJSON_AddBoolToObject(root, "optimizeOrder", msg->optimizeOrder)) goto cleanup;
+	if (!cJSON_AddBoolToObject(root, "keepLastStop", msg->keepLastStop)) goto cleanup;
+
 	jsonString = CJSON_PRINT(root);
 	if (!jsonString) goto cleanup;
 
@@ -79,5 +82,12 @@ int plan_route_request_data_deserialize(cJSON *root, plan_route_request_t *msg)
 		
 		msg->nodeIds[i] = nodeNumberItem->valueint;
 	}
+
+	// Champs optionnels : absents = ordre de passage conservé
+	const cJSON *optimizeItem = cJSON_GetObjectItemCaseSensitive(root, "optimizeOrder");
+	msg->optimizeOrder = cJSON_IsBool(optimizeItem) && cJSON_IsTrue(optimizeItem);
+
+	const cJSON *keepLastItem = cJSON_GetObjectItemCaseSensitive(root, "keepLastStop");
+	msg->keepLastStop = cJSON_IsBool(keepLastItem) && cJSON_IsTrue(keepLastItem);
 	return 0;
 }
\ No newline at end of file
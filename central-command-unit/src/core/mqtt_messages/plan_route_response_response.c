@@ -21,6 +21,7 @@ char *plan_route_response_serialize(const plan_route_response_t *msg) {
     if (command_response_header_to_json(&msg->header, root) != 0) goto error;
 
     cJSON_AddNumberToObject(root, "carId", msg->carId);
+    cJSON_AddNumberToObject(root, "savedDistance", msg->savedDistance);
 
     if (msg->header.success && msg->nodeCount > 0 && msg->nodeIds) {
         cJSON *nodesArray = cJSON_CreateIntArray(msg->nodeIds, msg->nodeCount);
@@ -60,6 +61,9 @@ int plan_route_response_data_deserialize(const cJSON *root, plan_route_response_
 	} else {
 		// For error responses, carId may be absent; do not set msg->carId
 	}
+
+	const cJSON *savedItem = cJSON_GetObjectItemCaseSensitive(root, "savedDistance");
+	msg->savedDistance = cJSON_IsNumber(savedItem) ? savedItem->valuedouble : 0.0;
     
     if (!cJSON_IsArray(nodesArray)) {
         msg->nodeCount = 0;
@@ -0,0 +1,72 @@
+/**
+ * @file set_log_level_request.c
+ * @brief Définitions du modèle de données pour la commande SET_LOG_LEVEL.
+ * @details
+ * Adressé à : tous les services (topic services/<client_id>/control)
+ * La commande est envoyée pour changer à chaud le niveau de journalisation du service,
+ * globalement ou pour un seul module (MQTT, CAMERA, UART, MARVELMIND, PLANNER, GENERAL).
+ */
+
+#include "core/mqtt_messages/set_log_level_request.h"
+
+/**
+ * @brief Sérialise un message de changement de niveau de journalisation en JSON.
+ * @param msg Pointeur vers le message à sérialiser.
+ * @return Chaîne JSON représentant le message
+ * @warning La mémoire allouée pour la chaîne JSON doit être libérée par l'appelant.
+ */
+char *set_log_level_request_serialize(const set_log_level_request_t *msg) {
+	cJSON *root = cJSON_CreateObject();
+	if(!root) return NULL;
+
+	const char *level = msg->level == LOG_MODULE_INHERIT ? SET_LOG_LEVEL_INHERIT : logger_level_to_string((log_level_t) msg->level);
+
+	if(command_header_serialize(&msg->header, root) != 0) goto error_cleanup;
+	if(msg->hasModule && !cJSON_AddStringToObject(root, "module", logger_module_to_string(msg->module))) goto error_cleanup;
+	if(!cJSON_AddStringToObject(root, "level", level)) goto error_cleanup;
+
+	char *json = CJSON_PRINT(root);
+
+	cJSON_Delete(root);
+	return json;
+
+	error_cleanup:
+		cJSON_Delete(root);
+		return NULL;
+}
+
+/**
+ * @brief Désérialise un message de changement de niveau de journalisation à partir d'une chaîne JSON.
+ * @details Champs : "level" (DEBUG, INFO, WARNING, ERROR, FATAL ou INHERIT) et "module" (optionnel).
+ * @param root Pointeur vers l'objet cJSON représentant le message.
+ * @param msg Pointeur vers la structure de message à remplir.
+ * @return 0 en cas de succès, -1 en cas d'erreur (champ manquant, module ou niveau inconnu).
+ * @warning Cette fonction s'occupe uniquement de désérialiser les données. Le header doit être désérialisé séparément.
+ */
+int set_log_level_request_data_deserialize(cJSON *root, set_log_level_request_t *msg) {
+	if (!root || !msg) return -1;
+
+	const cJSON *moduleItem = cJSON_GetObjectItemCaseSensitive(root, "module");
+	msg->hasModule = cJSON_IsString(moduleItem) && moduleItem->valuestring[0] != '\0';
+	if (msg->hasModule && logger_string_to_module(moduleItem->valuestring, &msg->module) != 0) goto error_cleanup;
+
+	const cJSON *levelItem = cJSON_GetObjectItemCaseSensitive(root, "level");
+	if (!cJSON_IsString(levelItem)) goto error_cleanup;
+
+	// logger_string_to_level() retombe sur INFO pour un nom inconnu : on vérifie le nom
+	if (strcmp(levelItem->valuestring, SET_LOG_LEVEL_INHERIT) == 0) {
+		if (!msg->hasModule) goto error_cleanup;
+		msg->level = LOG_MODULE_INHERIT;
+	} else {
+		log_level_t level = logger_string_to_level(levelItem->valuestring);
+		if (strcmp(levelItem->valuestring, logger_level_to_string(level)) != 0) goto error_cleanup;
+		msg->level = (int) level;
+	}
+
+	cJSON_Delete(root);
+	return 0;
+
+	error_cleanup:
+		cJSON_Delete(root);
+		return -1;
+}
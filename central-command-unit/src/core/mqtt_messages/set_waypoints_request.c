@@ -141,6 +141,7 @@ int set_waypoints_request_data_deserialize(cJSON *root, set_waypoints_request_t
  * @internal
  */
 int convert_path_to_waypoints(const path_t *path, waypoint_t **waypoints, int *waypointCount, graph_t *map) {
+	UNUSED(map); // Les arcs sont retrouvés directement depuis les nœuds du chemin
 	// FIXTURE
 	if(path->length == 1) {
 		*waypoints = (waypoint_t*)malloc(sizeof(waypoint_t));
@@ -179,9 +180,9 @@ int convert_path_to_waypoints(const path_t *path, waypoint_t **waypoints, int *w
         node_t* currentNode = path->nodes[i];
         node_t* nextNode = path->nodes[i + 1];
 
-        edge_t* foundEdge = graph_get_edge(map, currentNode->index, nextNode->index);
+        edge_t* foundEdge = node_get_edge_to(currentNode, nextNode);
         if (!foundEdge) {
-            LOG_ERROR_SYNC("Path/Graph mismatch: No edge from node %d to %d.", currentNode->index, nextNode->index);
+            LOG_ERROR_SYNC("Path/Graph mismatch: No edge from node %d to %d.", currentNode->id, nextNode->id);
             free(newWaypoints);
             return -1;
         }
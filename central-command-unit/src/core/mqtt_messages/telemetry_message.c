@@ -11,6 +11,23 @@
 
 #include "core/mqtt_messages/telemetry_message.h"
 
+/**
+ * @brief Remplit un objet JSON avec les champs d'un message de télémétrie.
+ * @return 0 en cas de succès, -1 en cas d'erreur.
+ * @internal
+ */
+static int telemetry_message_to_json(const telemetry_message_t *msg, cJSON *object) {
+	if(!cJSON_AddStringToObject(object, "origin", msg->origin)) return -1;
+	if(!cJSON_AddNumberToObject(object, "timestamp", (double) msg->timestamp)) return -1;
+	if(!cJSON_AddStringToObject(object, "level", logger_level_to_string(msg->level))) return -1;
+	if(!cJSON_AddStringToObject(object, "message", msg->message)) return -1;
+	if(msg->count > 1) {
+		if(!cJSON_AddNumberToObject(object, "count", msg->count)) return -1;
+		if(!cJSON_AddNumberToObject(object, "lastTimestamp", (double) msg->lastTimestamp)) return -1;
+	}
+	return 0;
+}
+
 /**
  * @brief Sérialise un message de télémétrie en JSON.
  * @param msg Pointeur vers le message de télémétrie à sérialiser.
@@ -21,10 +38,7 @@ char *telemetry_message_serialize_json(const telemetry_message_t *msg) {
 	cJSON *root = cJSON_CreateObject();
 	if(!root) return NULL;
 
-	if(!cJSON_AddStringToObject(root, "origin", msg->origin)) goto error_cleanup;
-	if(!cJSON_AddNumberToObject(root, "timestamp", (double) msg->timestamp)) goto error_cleanup;
-	if(!cJSON_AddStringToObject(root, "level", logger_level_to_string(msg->level))) goto error_cleanup;
-	if(!cJSON_AddStringToObject(root, "message", msg->message)) goto error_cleanup;
+	if(telemetry_message_to_json(msg, root) != 0) goto error_cleanup;
 
 	char *json = CJSON_PRINT(root);
 	cJSON_Delete(root);
@@ -36,6 +50,38 @@ char *telemetry_message_serialize_json(const telemetry_message_t *msg) {
 		return NULL;
 }
 
+/**
+ * @brief Sérialise un lot de messages de télémétrie en un tableau JSON.
+ * @details Les champs "count" et "lastTimestamp" sont ajoutés aux messages regroupés (count > 1).
+ * @param msgs Tableau des messages.
+ * @param count Nombre de messages.
+ * @return Chaîne JSON représentant le tableau
+ * @warning La mémoire allouée pour la chaîne JSON doit être libérée par l'appelant.
+ */
+char *telemetry_message_array_serialize_json(const telemetry_message_t *msgs, int count) {
+	if(!msgs && count > 0) return NULL;
+
+	cJSON *root = cJSON_CreateArray();
+	if(!root) return NULL;
+
+	for(int i = 0; i < count; i++) {
+		cJSON *object = cJSON_CreateObject();
+		if(!object) goto error_cleanup;
+		cJSON_AddItemToArray(root, object);
+		if(telemetry_message_to_json(&msgs[i], object) != 0) goto error_cleanup;
+	}
+
+	// Tableau compact : un lot peut contenir plusieurs dizaines de messages
+	char *json = cJSON_PrintUnformatted(root);
+	cJSON_Delete(root);
+
+	return json;
+
+	error_cleanup:
+		cJSON_Delete(root);
+		return NULL;
+}
+
 /**
  * @brief Désérialise un message de télémétrie à partir d'une chaîne JSON.
  * @param json Chaîne JSON représentant le message de télémétrie.
@@ -69,6 +115,11 @@ int telemetry_message_deserialize_json(const char *json, telemetry_message_t *ms
 	msg->level = logger_string_to_level(levelItem->valuestring);
 	msg->message = strdup(messageItem->valuestring);
 
+	cJSON *countItem = cJSON_GetObjectItemCaseSensitive(root, "count");
+	cJSON *lastTimestampItem = cJSON_GetObjectItemCaseSensitive(root, "lastTimestamp");
+	msg->count = cJSON_IsNumber(countItem) ? countItem->valueint : 1;
+	msg->lastTimestamp = cJSON_IsNumber(lastTimestampItem) ? (long)lastTimestampItem->valuedouble : msg->timestamp;
+
 
 	cJSON_Delete(root);
 	return 0;
@@ -0,0 +1,144 @@
+/**
+ * @file mqtt_payload.c
+ * @brief Conservation des payloads MQTT reçus au-delà de leur callback, sans copie.
+ * @details
+ * Le message en cours de livraison est mémorisé par thread : seul le thread qui appelle les
+ * handlers peut détacher le buffer de la bibliothèque MQTT. Le buffer détaché a été alloué par
+ * libmosquitto avec malloc() et se libère donc avec free().
+ * @date 2026-10-19
+ */
+#include "core/mqtt_payload.h"
+
+/**
+ * @brief Message en cours de livraison dans le thread courant.
+ * @internal
+ */
+typedef struct {
+	void **slot;             //!< Emplacement du buffer dans le message de la bibliothèque
+	const void *data;        //!< Buffer livré (reste valide après détachement)
+	size_t length;
+	mqtt_payload_t *retained; //!< Payload détaché, NULL tant que personne ne l'a retenu
+} payload_delivery_t;
+
+static __thread payload_delivery_t currentDelivery = {0};
+
+/**
+ * @brief Crée un payload à une référence autour d'un buffer.
+ * @internal
+ */
+static mqtt_payload_t *wrap(void *data, size_t length) {
+	mqtt_payload_t *payload = (mqtt_payload_t *) malloc(sizeof(mqtt_payload_t));
+	if(!payload) return NULL;
+	payload->data = data;
+	payload->length = length;
+	payload->refs = 1;
+	return payload;
+}
+
+/**
+ * @brief Copie un contenu (terminé par '\0' en plus de length).
+ * @internal
+ */
+static void *copy(const void *data, size_t length) {
+	char *buffer = (char *) malloc(length + 1);
+	if(!buffer) return NULL;
+	if(length > 0) memcpy(buffer, data, length);
+	buffer[length] = '\0';
+	return buffer;
+}
+
+/**
+ * @brief Retient un payload reçu au-delà du retour de son handler.
+ * @details Si payload est le buffer du message en cours de livraison dans ce thread, il est
+ * détaché de la bibliothèque MQTT sans copie (les appels suivants pour le même message partagent
+ * le même mqtt_payload_t). Sinon, le contenu est copié.
+ * @param payload Le payload reçu par le handler
+ * @param length Sa taille en octets
+ * @return Le payload retenu (à libérer avec mqtt_payload_release()), ou NULL en cas d'erreur d'allocation
+ */
+mqtt_payload_t *mqtt_payload_retain(const void *payload, size_t length) {
+	payload_delivery_t *delivery = &currentDelivery;
+	if(delivery->slot && payload == delivery->data && length <= delivery->length) {
+		if(!delivery->retained) {
+			// Première retenue : la livraison garde sa propre référence jusqu'à delivery_end()
+			delivery->retained = wrap(*delivery->slot, delivery->length);
+			if(!delivery->retained) return NULL;
+			*delivery->slot = NULL;
+		}
+		return mqtt_payload_ref(delivery->retained);
+	}
+
+	void *buffer = copy(payload, length);
+	if(!buffer) return NULL;
+	mqtt_payload_t *retained = wrap(buffer, length);
+	if(!retained) free(buffer);
+	return retained;
+}
+
+/**
+ * @brief Ajoute une référence à un payload retenu (ex : avant de le confier à un second thread).
+ * @param payload Le payload
+ * @return Le payload
+ */
+mqtt_payload_t *mqtt_payload_ref(mqtt_payload_t *payload) {
+	if(payload) __atomic_add_fetch(&payload->refs, 1, __ATOMIC_RELAXED);
+	return payload;
+}
+
+/**
+ * @brief Libère une référence ; le payload est libéré avec la dernière.
+ * @param payload Le payload (NULL accepté)
+ */
+void mqtt_payload_release(mqtt_payload_t *payload) {
+	if(!payload) return;
+	if(__atomic_sub_fetch(&payload->refs, 1, __ATOMIC_ACQ_REL) != 0) return;
+	free(payload->data);
+	free(payload);
+}
+
+/**
+ * @brief Récupère le buffer d'un payload retenu et libère la référence de l'appelant.
+ * @details Sans copie si l'appelant détient la dernière référence ; sinon le contenu est copié.
+ * @param payload Le payload
+ * @param length Taille du buffer retourné (NULL accepté)
+ * @return Le buffer (à libérer avec free()), ou NULL en cas d'erreur d'allocation
+ */
+void *mqtt_payload_steal(mqtt_payload_t *payload, size_t *length) {
+	if(!payload) return NULL;
+	if(length) *length = payload->length;
+
+	void *buffer;
+	if(__atomic_load_n(&payload->refs, __ATOMIC_ACQUIRE) == 1) {
+		buffer = payload->data;
+		free(payload);
+		return buffer;
+	}
+	buffer = copy(payload->data, payload->length);
+	mqtt_payload_release(payload);
+	return buffer;
+}
+
+/**
+ * @brief Déclare le message dont les handlers sont en cours d'appel dans ce thread.
+ * @details Réservé au client MQTT. Le buffer pointé par slot peut être détaché (*slot passe à
+ * NULL) par un mqtt_payload_retain() avant mqtt_payload_delivery_end().
+ * @param slot Emplacement du buffer dans le message de la bibliothèque MQTT
+ * @param length Taille du buffer
+ */
+void mqtt_payload_delivery_begin(void **slot, size_t length) {
+	currentDelivery = (payload_delivery_t) {
+		.slot = slot,
+		.data = slot ? *slot : NULL,
+		.length = length
+	};
+}
+
+/**
+ * @brief Termine la livraison déclarée par mqtt_payload_delivery_begin().
+ * @details Libère la référence de la livraison si le buffer a été retenu.
+ */
+void mqtt_payload_delivery_end(void) {
+	mqtt_payload_t *retained = currentDelivery.retained;
+	currentDelivery = (payload_delivery_t) {0};
+	mqtt_payload_release(retained);
+}
@@ -0,0 +1,408 @@
+/**
+ * @file mqtt_queue.c
+ * @brief File des publications MQTT en attente pendant une coupure de connexion.
+ * @details
+ * Chaque message est alloué en un seul bloc (structure, topic, propriétés puis payload). Le
+ * fichier de débordement est une suite d'enregistrements "en-tête, topic, propriétés, payload"
+ * relus séquentiellement au vidage, puis tronqué lorsqu'il a été entièrement renvoyé.
+ * @date 2026-10-19
+ */
+#include "core/mqtt_queue.h"
+#include "core/timer_wheel.h"
+#include <fcntl.h>
+#include <sys/uio.h>
+
+/**
+ * @brief En-tête d'un enregistrement du fichier de débordement.
+ * @internal
+ * @note Suivi du topic, du topic de réponse, des données de corrélation puis du payload.
+ */
+typedef struct {
+	int64_t expiresAtMs;
+	uint32_t topicLength;
+	uint32_t payloadLength;
+	uint32_t responseTopicLength; //!< 0 : aucun topic de réponse
+	uint32_t correlationLength;   //!< 0 : aucune donnée de corrélation
+	uint8_t qos;
+	uint8_t retain;
+	uint8_t topicAlias;
+} spool_record_t;
+
+/**
+ * @brief Alloue un message en un seul bloc et y place ses pointeurs (contenus non copiés).
+ * @internal
+ * @param responseTopicLength Longueur du topic de réponse (0 : aucun)
+ * @param correlationLength Taille des données de corrélation (0 : aucune)
+ */
+static mqtt_queued_message_t *allocate_message(size_t topicLength, size_t responseTopicLength, size_t correlationLength, size_t length) {
+	size_t size = sizeof(mqtt_queued_message_t) + topicLength + 1 + (responseTopicLength > 0 ? responseTopicLength + 1 : 0) + correlationLength + length;
+	mqtt_queued_message_t *message = (mqtt_queued_message_t *) malloc(size);
+	if(!message) return NULL;
+	memset(message, 0, sizeof(mqtt_queued_message_t));
+
+	char *cursor = (char *) (message + 1);
+	message->topic = cursor;
+	message->topic[topicLength] = '\0';
+	cursor += topicLength + 1;
+	if(responseTopicLength > 0) {
+		cursor[responseTopicLength] = '\0';
+		message->properties.responseTopic = cursor;
+		cursor += responseTopicLength + 1;
+	}
+	if(correlationLength > 0) {
+		message->properties.correlationData = cursor;
+		message->properties.correlationLength = correlationLength;
+		cursor += correlationLength;
+	}
+	message->payload = cursor;
+	message->length = length;
+	return message;
+}
+
+/**
+ * @brief Alloue un message (topic, payload et propriétés copiés dans le même bloc).
+ * @internal
+ */
+static mqtt_queued_message_t *create_message(const char *topic, const void *payload, size_t length, int qos, bool retain,
+	mqtt_priority_t priority, const mqtt_properties_t *properties) {
+	mqtt_properties_t none = {0};
+	if(!properties) properties = &none;
+	size_t topicLength = strlen(topic);
+	size_t responseTopicLength = properties->responseTopic ? strlen(properties->responseTopic) : 0;
+	size_t correlationLength = properties->correlationData ? properties->correlationLength : 0;
+
+	mqtt_queued_message_t *message = allocate_message(topicLength, responseTopicLength, correlationLength, length);
+	if(!message) return NULL;
+
+	memcpy(message->topic, topic, topicLength);
+	if(responseTopicLength > 0) memcpy((char *) message->properties.responseTopic, properties->responseTopic, responseTopicLength);
+	if(correlationLength > 0) memcpy((void *) message->properties.correlationData, properties->correlationData, correlationLength);
+	if(length > 0) memcpy(message->payload, payload, length);
+	message->qos = qos;
+	message->retain = retain;
+	message->priority = priority;
+	message->properties.messageExpirySec = properties->messageExpirySec;
+	message->properties.topicAlias = properties->topicAlias;
+	message->expiresAtMs = properties->messageExpirySec > 0 ? timer_wheel_now_ms() + (long) properties->messageExpirySec * 1000L : 0;
+	return message;
+}
+
+/**
+ * @brief Met à jour la validité restante d'un message avant son envoi.
+ * @internal
+ * @return false si le message a expiré
+ */
+static bool refresh_expiry(mqtt_queued_message_t *message, long nowMs) {
+	if(message->expiresAtMs == 0) return true;
+	long remainingMs = message->expiresAtMs - nowMs;
+	if(remainingMs <= 0) return false;
+	message->properties.messageExpirySec = (uint32_t) ((remainingMs + 999) / 1000);
+	return true;
+}
+
+/**
+ * @brief Retire et libère le premier message d'une file de priorité.
+ * @internal
+ */
+static void drop_head(mqtt_queue_t *queue, mqtt_priority_t priority) {
+	mqtt_queued_message_t *message = queue->head[priority];
+	queue->head[priority] = message->next;
+	if(!queue->head[priority]) queue->tail[priority] = NULL;
+	queue->count--;
+	queue->bytes -= message->length;
+	free(message);
+}
+
+/**
+ * @brief Supprime la commande QoS 0 la plus ancienne.
+ * @internal
+ * @return true si une commande a été supprimée
+ */
+static bool drop_oldest_qos0_command(mqtt_queue_t *queue) {
+	mqtt_queued_message_t *previous = NULL;
+	for(mqtt_queued_message_t *message = queue->head[MQTT_PRIORITY_COMMAND]; message; previous = message, message = message->next) {
+		if(message->qos != 0) continue;
+		if(previous) previous->next = message->next;
+		else queue->head[MQTT_PRIORITY_COMMAND] = message->next;
+		if(queue->tail[MQTT_PRIORITY_COMMAND] == message) queue->tail[MQTT_PRIORITY_COMMAND] = previous;
+		queue->count--;
+		queue->bytes -= message->length;
+		free(message);
+		return true;
+	}
+	return false;
+}
+
+/**
+ * @brief Ajoute un message au fichier de débordement.
+ * @internal
+ * @return 0 en cas de succès, -1 en cas d'erreur d'écriture
+ */
+static int spool_append(mqtt_queue_t *queue, const mqtt_queued_message_t *message) {
+	size_t topicLength = strlen(message->topic);
+	size_t responseTopicLength = message->properties.responseTopic ? strlen(message->properties.responseTopic) : 0;
+	size_t correlationLength = message->properties.correlationLength;
+	if(topicLength > UINT32_MAX || message->length > UINT32_MAX || responseTopicLength > UINT32_MAX || correlationLength > UINT32_MAX) return -1;
+
+	spool_record_t record = {
+		.expiresAtMs = message->expiresAtMs,
+		.topicLength = (uint32_t) topicLength,
+		.payloadLength = (uint32_t) message->length,
+		.responseTopicLength = (uint32_t) responseTopicLength,
+		.correlationLength = (uint32_t) correlationLength,
+		.qos = (uint8_t) message->qos,
+		.retain = message->retain,
+		.topicAlias = message->properties.topicAlias
+	};
+	struct iovec iov[5] = {
+		{ .iov_base = &record, .iov_len = sizeof(record) },
+		{ .iov_base = message->topic, .iov_len = topicLength },
+		{ .iov_base = (void *) message->properties.responseTopic, .iov_len = responseTopicLength },
+		{ .iov_base = (void *) message->properties.correlationData, .iov_len = correlationLength },
+		{ .iov_base = message->payload, .iov_len = message->length }
+	};
+	size_t total = sizeof(record) + topicLength + responseTopicLength + correlationLength + message->length;
+	if(pwritev(queue->spoolFd, iov, 5, queue->spoolWrite) != (ssize_t) total) return -1;
+
+	queue->spoolWrite += (off_t) total;
+	queue->spoolCount++;
+	return 0;
+}
+
+/**
+ * @brief Relit le prochain message du fichier de débordement.
+ * @internal
+ * @param size Taille de l'enregistrement lu
+ * @return Le message (à libérer), ou NULL si le fichier est illisible
+ */
+static mqtt_queued_message_t *spool_read(mqtt_queue_t *queue, off_t *size) {
+	spool_record_t record;
+	if(pread(queue->spoolFd, &record, sizeof(record), queue->spoolRead) != (ssize_t) sizeof(record)) return NULL;
+
+	mqtt_queued_message_t *message = allocate_message(record.topicLength, record.responseTopicLength, record.correlationLength, record.payloadLength);
+	if(!message) return NULL;
+
+	struct iovec iov[4] = {
+		{ .iov_base = message->topic, .iov_len = record.topicLength },
+		{ .iov_base = (void *) message->properties.responseTopic, .iov_len = record.responseTopicLength },
+		{ .iov_base = (void *) message->properties.correlationData, .iov_len = record.correlationLength },
+		{ .iov_base = message->payload, .iov_len = record.payloadLength }
+	};
+	ssize_t expected = (ssize_t) record.topicLength + (ssize_t) record.responseTopicLength + (ssize_t) record.correlationLength + (ssize_t) record.payloadLength;
+	if(preadv(queue->spoolFd, iov, 4, queue->spoolRead + (off_t) sizeof(record)) != expected) {
+		free(message);
+		return NULL;
+	}
+	message->qos = record.qos;
+	message->retain = record.retain;
+	message->priority = MQTT_PRIORITY_COMMAND;
+	message->properties.topicAlias = record.topicAlias;
+	message->expiresAtMs = (long) record.expiresAtMs;
+	*size = (off_t) sizeof(record) + expected;
+	return message;
+}
+
+/**
+ * @brief Vide le fichier de débordement.
+ * @internal
+ */
+static void spool_reset(mqtt_queue_t *queue) {
+	// En cas d'échec de la troncature, les écritures reprennent simplement au début du fichier
+	int rc = ftruncate(queue->spoolFd, 0);
+	UNUSED(rc);
+	queue->spoolRead = 0;
+	queue->spoolWrite = 0;
+	queue->spoolCount = 0;
+}
+
+/**
+ * @brief Initialise une file.
+ * @param queue La file
+ * @param config Configuration (NULL : valeurs par défaut, sans fichier de débordement)
+ * @return 0 en cas de succès, -1 si le fichier de débordement ne peut pas être ouvert (la file
+ * reste utilisable, en mémoire seulement)
+ */
+int mqtt_queue_init(mqtt_queue_t *queue, const mqtt_queue_config_t *config) {
+	memset(queue, 0, sizeof(mqtt_queue_t));
+	if(config) queue->config = *config;
+	if(queue->config.maxMessages == 0) queue->config.maxMessages = MQTT_QUEUE_DEFAULT_MAX_MESSAGES;
+	if(queue->config.maxBytes == 0) queue->config.maxBytes = MQTT_QUEUE_DEFAULT_MAX_BYTES;
+	queue->spoolFd = -1;
+	pthread_mutex_init(&queue->lock, NULL);
+
+	if(queue->config.spoolPath[0] == '\0') return 0;
+	queue->spoolFd = open(queue->config.spoolPath, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+	return queue->spoolFd >= 0 ? 0 : -1;
+}
+
+/**
+ * @brief Libère les messages en attente et ferme le fichier de débordement.
+ * @param queue La file
+ */
+void mqtt_queue_destroy(mqtt_queue_t *queue) {
+	for(int priority = 0; priority < MQTT_PRIORITY_COUNT; priority++) {
+		while(queue->head[priority]) drop_head(queue, (mqtt_priority_t) priority);
+	}
+	if(queue->spoolFd >= 0) {
+		spool_reset(queue);
+		close(queue->spoolFd);
+		queue->spoolFd = -1;
+	}
+	pthread_mutex_destroy(&queue->lock);
+}
+
+/**
+ * @brief Met un message en attente (topic, payload et propriétés sont copiés).
+ * @param queue La file
+ * @param topic Topic du message
+ * @param payload Payload du message
+ * @param length Taille du payload en octets
+ * @param qos QoS du message
+ * @param retain Flag de rétention
+ * @param priority Priorité du message
+ * @param properties Propriétés MQTT v5 (NULL : aucune)
+ * @return Le sort du message (voir mqtt_queue_result_t)
+ */
+mqtt_queue_result_t mqtt_queue_push(mqtt_queue_t *queue, const char *topic, const void *payload, size_t length, int qos, bool retain,
+	mqtt_priority_t priority, const mqtt_properties_t *properties) {
+	if(!queue || !topic || (!payload && length > 0) || priority >= MQTT_PRIORITY_COUNT) return MQTT_QUEUE_DROPPED;
+	bool command = priority == MQTT_PRIORITY_COMMAND;
+	bool spoolable = command && qos > 0 && queue->spoolFd >= 0;
+	mqtt_queue_result_t result = MQTT_QUEUE_QUEUED;
+
+	// Copie hors verrou : un message débordé ou refusé est libéré ensuite
+	mqtt_queued_message_t *message = create_message(topic, payload, length, qos, retain, priority, properties);
+
+	pthread_mutex_lock(&queue->lock);
+	if(!message) {
+		result = MQTT_QUEUE_DROPPED;
+		goto done;
+	}
+
+	// Les commandes suivent celles déjà débordées pour conserver leur ordre
+	if(command && queue->spoolCount > 0) {
+		result = spool_append(queue, message) == 0 ? MQTT_QUEUE_SPOOLED : MQTT_QUEUE_DROPPED;
+		goto done;
+	}
+
+	// Plus gros que la file : inutile de supprimer d'autres messages
+	if(length > queue->config.maxBytes) {
+		result = spoolable && spool_append(queue, message) == 0 ? MQTT_QUEUE_SPOOLED : MQTT_QUEUE_DROPPED;
+		goto done;
+	}
+
+	while(queue->count >= queue->config.maxMessages || queue->bytes + length > queue->config.maxBytes) {
+		if(queue->head[MQTT_PRIORITY_TELEMETRY]) {
+			drop_head(queue, MQTT_PRIORITY_TELEMETRY);
+			queue->dropped++;
+			result = MQTT_QUEUE_EVICTED;
+		} else if(!command || qos == 0) {
+			result = MQTT_QUEUE_DROPPED;
+			goto done;
+		} else if(spoolable) {
+			result = spool_append(queue, message) == 0 ? MQTT_QUEUE_SPOOLED : MQTT_QUEUE_DROPPED;
+			goto done;
+		} else if(drop_oldest_qos0_command(queue)) {
+			queue->dropped++;
+			result = MQTT_QUEUE_EVICTED;
+		} else {
+			result = MQTT_QUEUE_DROPPED;
+			goto done;
+		}
+	}
+
+	if(queue->tail[priority]) queue->tail[priority]->next = message;
+	else queue->head[priority] = message;
+	queue->tail[priority] = message;
+	queue->count++;
+	queue->bytes += length;
+	message = NULL;
+
+done:
+	if(result == MQTT_QUEUE_DROPPED) queue->dropped++;
+	pthread_mutex_unlock(&queue->lock);
+	free(message);
+	return result;
+}
+
+/**
+ * @brief Renvoie les messages en attente d'une file de priorité en mémoire.
+ * @internal
+ * @return false si le vidage a été interrompu par un échec d'envoi
+ */
+static bool drain_lane(mqtt_queue_t *queue, mqtt_priority_t priority, mqtt_queue_send_t send, void *context, long nowMs, size_t *sent) {
+	while(queue->head[priority]) {
+		if(!refresh_expiry(queue->head[priority], nowMs)) {
+			drop_head(queue, priority);
+			queue->dropped++;
+			continue;
+		}
+		if(send(queue->head[priority], context) != 0) return false;
+		drop_head(queue, priority);
+		(*sent)++;
+	}
+	return true;
+}
+
+/**
+ * @brief Renvoie les messages en attente dans l'ordre : commandes en mémoire, commandes du fichier
+ * de débordement, puis télémétrie. Les messages expirés sont supprimés sans être transmis.
+ * @param queue La file
+ * @param send Callback d'envoi ; le vidage s'arrête au premier échec
+ * @param context Contexte transmis au callback
+ * @return Le nombre de messages transmis
+ */
+size_t mqtt_queue_drain(mqtt_queue_t *queue, mqtt_queue_send_t send, void *context) {
+	if(!queue || !send) return 0;
+	size_t sent = 0;
+	long nowMs = timer_wheel_now_ms();
+
+	pthread_mutex_lock(&queue->lock);
+	if(!drain_lane(queue, MQTT_PRIORITY_COMMAND, send, context, nowMs, &sent)) goto done;
+
+	while(queue->spoolCount > 0) {
+		off_t size = 0;
+		mqtt_queued_message_t *message = spool_read(queue, &size);
+		if(!message) {
+			// Fichier illisible : les commandes restantes sont perdues
+			queue->dropped += queue->spoolCount;
+			spool_reset(queue);
+			break;
+		}
+		bool valid = refresh_expiry(message, nowMs);
+		int rc = valid ? send(message, context) : 0;
+		free(message);
+		if(rc != 0) goto done;
+		queue->spoolRead += size;
+		queue->spoolCount--;
+		if(valid) sent++;
+		else queue->dropped++;
+	}
+	if(queue->spoolFd >= 0 && queue->spoolWrite > 0) spool_reset(queue);
+
+	drain_lane(queue, MQTT_PRIORITY_TELEMETRY, send, context, nowMs, &sent);
+
+done:
+	pthread_mutex_unlock(&queue->lock);
+	return sent;
+}
+
+/**
+ * @brief Retourne le nombre de messages en attente (fichier de débordement compris).
+ */
+size_t mqtt_queue_count(mqtt_queue_t *queue) {
+	pthread_mutex_lock(&queue->lock);
+	size_t count = queue->count + queue->spoolCount;
+	pthread_mutex_unlock(&queue->lock);
+	return count;
+}
+
+/**
+ * @brief Retourne le nombre de messages supprimés ou refusés depuis l'initialisation.
+ */
+size_t mqtt_queue_dropped(mqtt_queue_t *queue) {
+	pthread_mutex_lock(&queue->lock);
+	size_t dropped = queue->dropped;
+	pthread_mutex_unlock(&queue->lock);
+	return dropped;
+}
@@ -0,0 +1,342 @@
+/**
+ * @file mqtt_router.c
+ * @brief Routage des messages MQTT reçus vers des handlers enregistrés au démarrage.
+ * @details
+ * Les filtres de topic sont compilés dans un arbre : un noeud par niveau, dont les fils exacts sont
+ * indexés par une table de hachage (uthash) et les jokers '+' et '#' rangés à part. Les routes
+ * d'action d'un noeud sont indexées par nom d'action. Le routage parcourt l'arbre niveau par
+ * niveau sans allocation ; le JSON n'est parsé que si une route d'action correspond.
+ * @date 2026-10-19
+ */
+#include "core/mqtt_router.h"
+#include "core/logger.h"
+#include <uthash.h>
+
+typedef struct topic_route {
+	mqtt_route_handler_t handler;
+	void *context;
+	struct topic_route *next;
+} topic_route_t;
+
+typedef struct action_route {
+	char action[ACTION_LENGTH]; //!< Clé de la table des actions
+	mqtt_action_handler_t handler;
+	void *context;
+	UT_hash_handle hh;
+} action_route_t;
+
+typedef struct router_node {
+	char *level;                  //!< Niveau du filtre (clé dans la table du parent)
+	struct router_node *children; //!< Fils exacts, indexés par niveau
+	struct router_node *plus;     //!< Fils '+'
+	struct router_node *hash;     //!< Fils '#'
+	topic_route_t *routes;        //!< Routes de topic se terminant à ce noeud
+	action_route_t *actions;      //!< Routes d'action se terminant à ce noeud
+	UT_hash_handle hh;
+} router_node_t;
+
+struct mqtt_router {
+	router_node_t root;
+	mqtt_route_handler_t defaultHandler;
+	void *defaultContext;
+	size_t routeCount;
+};
+
+/**
+ * @brief Message en cours de routage (JSON parsé à la demande, une seule fois).
+ * @internal
+ */
+typedef struct {
+	const char *topic;
+	const void *payload;
+	size_t length;
+	cJSON *root;
+	command_header_t header;
+	bool parsed;
+	bool valid;
+	int called;
+} routed_message_t;
+
+/**
+ * @brief Libère récursivement un noeud et ses routes (sans libérer le noeud lui-même).
+ * @internal
+ */
+static void free_node_content(router_node_t *node) {
+	router_node_t *child, *tmp;
+	HASH_ITER(hh, node->children, child, tmp) {
+		HASH_DEL(node->children, child);
+		free_node_content(child);
+		free(child);
+	}
+	if(node->plus) {
+		free_node_content(node->plus);
+		free(node->plus);
+	}
+	if(node->hash) {
+		free_node_content(node->hash);
+		free(node->hash);
+	}
+
+	topic_route_t *route = node->routes;
+	while(route) {
+		topic_route_t *next = route->next;
+		free(route);
+		route = next;
+	}
+
+	action_route_t *action, *tmpAction;
+	HASH_ITER(hh, node->actions, action, tmpAction) {
+		HASH_DEL(node->actions, action);
+		free(action);
+	}
+	free(node->level);
+}
+
+/**
+ * @brief Crée un noeud pour un niveau.
+ * @internal
+ */
+static router_node_t *create_node(const char *level, size_t length) {
+	router_node_t *node = (router_node_t *) calloc(1, sizeof(router_node_t));
+	if(!node) return NULL;
+	node->level = strndup(level, length);
+	if(!node->level) {
+		free(node);
+		return NULL;
+	}
+	return node;
+}
+
+/**
+ * @brief Retourne le noeud terminal d'un filtre, en créant les noeuds manquants.
+ * @internal
+ * @return Le noeud, ou NULL si le filtre est invalide ou en cas d'erreur d'allocation
+ */
+static router_node_t *compile_filter(mqtt_router_t *router, const char *filter) {
+	if(!filter || filter[0] == '\0') return NULL;
+
+	router_node_t *node = &router->root;
+	const char *level = filter;
+	while(level) {
+		const char *end = strchrnul(level, '/');
+		size_t length = (size_t) (end - level);
+		const char *next = *end ? end + 1 : NULL;
+
+		router_node_t **slot = NULL;
+		if(length == 1 && level[0] == '#') {
+			if(next) return NULL; // '#' doit être le dernier niveau
+			slot = &node->hash;
+		} else if(length == 1 && level[0] == '+') {
+			slot = &node->plus;
+		} else {
+			if(memchr(level, '+', length) || memchr(level, '#', length)) return NULL; // Joker au milieu d'un niveau
+			router_node_t *child = NULL;
+			HASH_FIND(hh, node->children, level, length, child);
+			if(!child) {
+				child = create_node(level, length);
+				if(!child) return NULL;
+				HASH_ADD_KEYPTR(hh, node->children, child->level, length, child);
+			}
+			node = child;
+			level = next;
+			continue;
+		}
+
+		if(!*slot) {
+			*slot = create_node(level, length);
+			if(!*slot) return NULL;
+		}
+		node = *slot;
+		level = next;
+	}
+	return node;
+}
+
+/**
+ * @brief Crée un routeur vide.
+ * @return Le routeur, ou NULL en cas d'erreur d'allocation
+ */
+mqtt_router_t *mqtt_router_create(void) {
+	return (mqtt_router_t *) calloc(1, sizeof(mqtt_router_t));
+}
+
+/**
+ * @brief Libère un routeur et ses routes.
+ * @param router Le routeur (NULL accepté)
+ */
+void mqtt_router_destroy(mqtt_router_t *router) {
+	if(!router) return;
+	free_node_content(&router->root);
+	free(router);
+}
+
+/**
+ * @brief Associe un handler à un filtre de topic.
+ * @param router Le routeur
+ * @param filter Filtre de topic MQTT (ex : "vehicles/+/status", "services/#")
+ * @param handler Le handler
+ * @param context Contexte transmis au handler
+ * @return 0 en cas de succès, -1 si le filtre est invalide ou en cas d'erreur d'allocation
+ */
+int mqtt_router_add_topic(mqtt_router_t *router, const char *filter, mqtt_route_handler_t handler, void *context) {
+	if(!router || !handler) return -1;
+
+	router_node_t *node = compile_filter(router, filter);
+	if(!node) {
+		LOG_ERROR_ASYNC("MQTT router: invalid topic filter '%s'", filter ? filter : "(null)");
+		return -1;
+	}
+
+	topic_route_t *route = (topic_route_t *) calloc(1, sizeof(topic_route_t));
+	if(!route) return -1;
+	route->handler = handler;
+	route->context = context;
+
+	// Ajout en fin de liste : les handlers sont appelés dans l'ordre d'enregistrement
+	topic_route_t **last = &node->routes;
+	while(*last) last = &(*last)->next;
+	*last = route;
+	router->routeCount++;
+	return 0;
+}
+
+/**
+ * @brief Associe un handler à une action reçue sur un filtre de topic.
+ * @param router Le routeur
+ * @param filter Filtre de topic MQTT
+ * @param action Action de la commande (header.action)
+ * @param handler Le handler
+ * @param context Contexte transmis au handler
+ * @return 0 en cas de succès, -1 si le filtre est invalide, si l'action est déjà enregistrée sur
+ * ce filtre ou en cas d'erreur d'allocation
+ */
+int mqtt_router_add_action(mqtt_router_t *router, const char *filter, const char *action, mqtt_action_handler_t handler, void *context) {
+	if(!router || !action || !handler || strlen(action) >= ACTION_LENGTH) return -1;
+
+	router_node_t *node = compile_filter(router, filter);
+	if(!node) {
+		LOG_ERROR_ASYNC("MQTT router: invalid topic filter '%s'", filter ? filter : "(null)");
+		return -1;
+	}
+
+	action_route_t *route = NULL;
+	HASH_FIND_STR(node->actions, action, route);
+	if(route) {
+		LOG_ERROR_ASYNC("MQTT router: action %s already registered on '%s'", action, filter);
+		return -1;
+	}
+
+	route = (action_route_t *) calloc(1, sizeof(action_route_t));
+	if(!route) return -1;
+	strcpy(route->action, action);
+	route->handler = handler;
+	route->context = context;
+	HASH_ADD_STR(node->actions, action, route);
+	router->routeCount++;
+	return 0;
+}
+
+/**
+ * @brief Définit le handler appelé pour les messages qu'aucune route ne capte.
+ * @param router Le routeur
+ * @param handler Le handler (NULL : message ignoré)
+ * @param context Contexte transmis au handler
+ */
+void mqtt_router_set_default(mqtt_router_t *router, mqtt_route_handler_t handler, void *context) {
+	if(!router) return;
+	router->defaultHandler = handler;
+	router->defaultContext = context;
+}
+
+/**
+ * @brief Indique si le routeur n'a aucune route ni handler par défaut.
+ */
+bool mqtt_router_is_empty(const mqtt_router_t *router) {
+	return !router || (router->routeCount == 0 && !router->defaultHandler);
+}
+
+/**
+ * @brief Appelle les routes se terminant à un noeud.
+ * @internal
+ */
+static void call_routes(router_node_t *node, routed_message_t *message) {
+	for(topic_route_t *route = node->routes; route; route = route->next) {
+		route->handler(message->topic, message->payload, message->length, route->context);
+		message->called++;
+	}
+
+	if(!node->actions) return;
+
+	// Parsing unique, partagé par toutes les routes d'action correspondantes
+	if(!message->parsed) {
+		message->parsed = true;
+		message->root = cJSON_ParseWithLength((const char *) message->payload, message->length);
+		if(!message->root) {
+			LOG_ERROR_ASYNC("MQTT router: payload on %s is not valid JSON.", message->topic);
+		} else if(command_header_deserialize(message->root, &message->header) != 0) {
+			LOG_ERROR_ASYNC("MQTT router: failed to deserialize command header on %s.", message->topic);
+		} else {
+			message->valid = true;
+			LOG_DEBUG_ASYNC("Processing command: %s, action: %s, replyTopic: %s", message->header.commandId, message->header.action, message->header.replyTopic);
+		}
+	}
+	if(!message->valid) return;
+
+	action_route_t *action = NULL;
+	HASH_FIND_STR(node->actions, message->header.action, action);
+	if(!action) {
+		LOG_ERROR_ASYNC("Unknown action received on %s: %s", message->topic, message->header.action);
+		return;
+	}
+	action->handler(message->topic, &message->header, message->root, action->context);
+	message->called++;
+}
+
+/**
+ * @brief Parcourt l'arbre pour les niveaux restants du topic.
+ * @internal
+ * @param level Début du niveau courant, NULL si tous les niveaux ont été consommés
+ */
+static void match_level(router_node_t *node, const char *level, bool firstLevel, routed_message_t *message) {
+	if(!level) {
+		call_routes(node, message);
+		// "a/#" capte aussi "a"
+		if(node->hash) call_routes(node->hash, message);
+		return;
+	}
+
+	const char *end = strchrnul(level, '/');
+	size_t length = (size_t) (end - level);
+	const char *next = *end ? end + 1 : NULL;
+
+	router_node_t *child = NULL;
+	HASH_FIND(hh, node->children, level, length, child);
+	if(child) match_level(child, next, false, message);
+
+	// Les topics système ('$SYS/...') ne sont pas captés par un joker au premier niveau
+	if(firstLevel && level[0] == '$') return;
+	if(node->plus) match_level(node->plus, next, false, message);
+	if(node->hash) call_routes(node->hash, message);
+}
+
+/**
+ * @brief Route un message.
+ * @param router Le routeur
+ * @param topic Topic du message
+ * @param payload Payload du message (non terminé par '\0' garanti)
+ * @param length Taille du payload en octets
+ * @return Le nombre de handlers appelés (handler par défaut compris)
+ */
+int mqtt_router_dispatch(mqtt_router_t *router, const char *topic, const void *payload, size_t length) {
+	if(!router || !topic || !payload) return 0;
+
+	routed_message_t message = { .topic = topic, .payload = payload, .length = length };
+	match_level(&router->root, topic, true, &message);
+	cJSON_Delete(message.root);
+
+	if(message.called == 0 && router->defaultHandler) {
+		router->defaultHandler(topic, payload, length, router->defaultContext);
+		message.called++;
+	}
+	return message.called;
+}
@@ -145,4 +145,14 @@ void* pq_pop(priority_queue_t* pq) {
  */
 bool pq_is_empty(priority_queue_t* pq) {
 	return pq->size == 0;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Vide la file de priorité en conservant sa capacité (réutilisation sans allocation).
+ * @param pq La file de priorité.
+ */
+void pq_clear(priority_queue_t* pq) {
+	if(pq != NULL) {
+		pq->size = 0;
+	}
+}
@@ -0,0 +1,250 @@
+/**
+ * @file request_future.c
+ * @brief Requêtes/réponses MQTT sous forme de futures.
+ * @details
+ * Surcouche du gestionnaire de requêtes : request_manager_call() publie une requête et retourne
+ * une future résolue par la réponse corrélée (commandId) ou par l'expiration de la requête.
+ * La future est partagée entre l'appelant et le gestionnaire (compteur de références) : elle
+ * n'est libérée qu'une fois résolue et relâchée par l'appelant.
+ * @date 2026-10-19
+ */
+#include "core/request_future.h"
+#include "core/core.h"
+#include <errno.h>
+
+struct request_future {
+	pthread_mutex_t lock;
+	pthread_cond_t resolved;
+	request_future_state_t state;
+	cJSON *response; //!< Copie de la réponse (le JSON reçu est libéré après le callback)
+	command_response_header_t header;
+	request_future_callback_t then;
+	void *thenContext;
+	int refCount; //!< Appelant + gestionnaire de requêtes tant que la future n'est pas résolue
+};
+
+/**
+ * @brief Relâche une référence et libère la future à la dernière.
+ * @internal
+ */
+static void future_unref(request_future_t *future) {
+	pthread_mutex_lock(&future->lock);
+	bool last = --future->refCount == 0;
+	pthread_mutex_unlock(&future->lock);
+	if(!last) return;
+
+	cJSON_Delete(future->response);
+	pthread_cond_destroy(&future->resolved);
+	pthread_mutex_destroy(&future->lock);
+	free(future);
+}
+
+/**
+ * @brief Callback du gestionnaire de requêtes : résout la future.
+ * @internal
+ */
+static void on_future_response(const cJSON *root, const command_response_header_t *header, void *context) {
+	request_future_t *future = (request_future_t *) context;
+	cJSON *response = root ? cJSON_Duplicate(root, true) : NULL;
+
+	pthread_mutex_lock(&future->lock);
+	future->response = response;
+	future->header = *header;
+	if(!root) future->state = REQUEST_FUTURE_TIMEOUT;
+	else future->state = header->success ? REQUEST_FUTURE_SUCCESS : REQUEST_FUTURE_ERROR;
+	request_future_callback_t then = future->then;
+	void *thenContext = future->thenContext;
+	pthread_cond_broadcast(&future->resolved);
+	pthread_mutex_unlock(&future->lock);
+
+	if(then) then(future, thenContext);
+	future_unref(future);
+}
+
+/**
+ * @brief Publie une requête et retourne la future de sa réponse.
+ * @param topic Topic de la requête.
+ * @param requestId L'ID de la requête (command_id de son en-tête).
+ * @param payload Le payload JSON de la requête.
+ * @param qos Le niveau de QoS à utiliser.
+ * @param options Options d'attente et de renvoi (NULL : échéance par défaut, sans renvoi).
+ * @return La future, à libérer avec request_future_release(), ou NULL en cas d'erreur.
+ */
+request_future_t *request_manager_call(const char *topic, const char *requestId, const char *payload, mqtt_qos_enum_t qos,
+	const request_options_t *options) {
+	request_future_t *future = (request_future_t *) calloc(1, sizeof(request_future_t));
+	if(!future) {
+		LOG_ERROR_ASYNC("Memory allocation failed in request_manager_call");
+		return NULL;
+	}
+
+	pthread_condattr_t attr;
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	int result = pthread_cond_init(&future->resolved, &attr);
+	pthread_condattr_destroy(&attr);
+	if(result != 0 || pthread_mutex_init(&future->lock, NULL) != 0) {
+		if(result == 0) pthread_cond_destroy(&future->resolved);
+		free(future);
+		return NULL;
+	}
+	future->state = REQUEST_FUTURE_PENDING;
+	future->refCount = 2;
+
+	if(request_manager_send(topic, requestId, payload, qos, false, on_future_response, future, options) != 0) {
+		pthread_cond_destroy(&future->resolved);
+		pthread_mutex_destroy(&future->lock);
+		free(future);
+		return NULL;
+	}
+	return future;
+}
+
+/**
+ * @brief Retourne l'état d'une future sans bloquer.
+ */
+request_future_state_t request_future_poll(request_future_t *future) {
+	if(!future) return REQUEST_FUTURE_PENDING;
+	pthread_mutex_lock(&future->lock);
+	request_future_state_t state = future->state;
+	pthread_mutex_unlock(&future->lock);
+	return state;
+}
+
+/**
+ * @brief Attend la résolution d'une future jusqu'à une échéance absolue.
+ * @internal
+ */
+static request_future_state_t wait_until(request_future_t *future, const struct timespec *deadline) {
+	pthread_mutex_lock(&future->lock);
+	while(future->state == REQUEST_FUTURE_PENDING) {
+		int result = deadline ? pthread_cond_timedwait(&future->resolved, &future->lock, deadline)
+			: pthread_cond_wait(&future->resolved, &future->lock);
+		if(result == ETIMEDOUT) break;
+	}
+	request_future_state_t state = future->state;
+	pthread_mutex_unlock(&future->lock);
+	return state;
+}
+
+/**
+ * @brief Calcule l'échéance absolue (CLOCK_MONOTONIC) d'une attente.
+ * @internal
+ * @return false si l'attente est sans limite
+ */
+static bool wait_deadline(int timeoutMs, struct timespec *deadline) {
+	if(timeoutMs < 0) return false;
+	clock_gettime(CLOCK_MONOTONIC, deadline);
+	deadline->tv_sec += timeoutMs / 1000;
+	deadline->tv_nsec += (timeoutMs % 1000) * 1000000L;
+	if(deadline->tv_nsec >= 1000000000L) {
+		deadline->tv_sec++;
+		deadline->tv_nsec -= 1000000000L;
+	}
+	return true;
+}
+
+/**
+ * @brief Vérifie qu'une attente bloquante ne gèle pas la boucle d'événements du service.
+ * @internal
+ */
+static bool can_block(int timeoutMs) {
+	event_loop_t *loop = core_get_event_loop();
+	if(timeoutMs != 0 && loop && event_loop_in_loop_thread(loop)) {
+		LOG_ERROR_ASYNC("request_future: blocking wait from the event loop thread, use request_future_then() instead");
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Attend la résolution d'une future.
+ * @param future La future
+ * @param timeoutMs Attente maximale en millisecondes (0 : aucune, REQUEST_FUTURE_WAIT_FOREVER : sans limite)
+ * @return L'état de la future (REQUEST_FUTURE_PENDING si l'attente a expiré avant la résolution)
+ */
+request_future_state_t request_future_wait(request_future_t *future, int timeoutMs) {
+	if(!future) return REQUEST_FUTURE_PENDING;
+	if(timeoutMs == 0 || !can_block(timeoutMs)) return request_future_poll(future);
+
+	struct timespec deadline;
+	bool bounded = wait_deadline(timeoutMs, &deadline);
+	return wait_until(future, bounded ? &deadline : NULL);
+}
+
+/**
+ * @brief Attend la résolution de plusieurs futures.
+ * @param futures Les futures (les entrées NULL sont ignorées)
+ * @param count Nombre de futures
+ * @param timeoutMs Attente maximale pour l'ensemble (0 : aucune, REQUEST_FUTURE_WAIT_FOREVER : sans limite)
+ * @return 0 si toutes les futures sont résolues, -1 si l'attente a expiré avant
+ */
+int request_future_wait_all(request_future_t **futures, size_t count, int timeoutMs) {
+	if(!futures) return -1;
+	if(!can_block(timeoutMs)) timeoutMs = 0;
+
+	// Une échéance commune : attendre les futures l'une après l'autre ne dépasse pas le délai total
+	struct timespec deadline;
+	bool bounded = wait_deadline(timeoutMs, &deadline);
+	for(size_t i = 0; i < count; i++) {
+		if(!futures[i]) continue;
+		if(wait_until(futures[i], bounded ? &deadline : NULL) == REQUEST_FUTURE_PENDING) return -1;
+	}
+	return 0;
+}
+
+/**
+ * @brief Enregistre le callback appelé à la résolution de la future.
+ * @details Si la future est déjà résolue, le callback est appelé immédiatement.
+ * @param future La future
+ * @param callback Le callback
+ * @param context Contexte transmis au callback
+ * @return 0 en cas de succès, -1 si un callback est déjà enregistré
+ */
+int request_future_then(request_future_t *future, request_future_callback_t callback, void *context) {
+	if(!future || !callback) return -1;
+
+	pthread_mutex_lock(&future->lock);
+	if(future->then) {
+		pthread_mutex_unlock(&future->lock);
+		return -1;
+	}
+	future->then = callback;
+	future->thenContext = context;
+	bool resolved = future->state != REQUEST_FUTURE_PENDING;
+	pthread_mutex_unlock(&future->lock);
+
+	if(resolved) callback(future, context);
+	return 0;
+}
+
+/**
+ * @brief Retourne le JSON de la réponse.
+ * @return La réponse (propriété de la future), ou NULL si la future n'est pas résolue ou a expiré
+ */
+const cJSON *request_future_response(request_future_t *future) {
+	if(!future) return NULL;
+	pthread_mutex_lock(&future->lock);
+	const cJSON *response = future->response;
+	pthread_mutex_unlock(&future->lock);
+	return response;
+}
+
+/**
+ * @brief Retourne l'en-tête de la réponse (errorMessage renseigné en cas d'erreur ou d'expiration).
+ * @return L'en-tête, ou NULL si la future n'est pas résolue
+ */
+const command_response_header_t *request_future_header(request_future_t *future) {
+	if(!future) return NULL;
+	return request_future_poll(future) != REQUEST_FUTURE_PENDING ? &future->header : NULL;
+}
+
+/**
+ * @brief Libère la future.
+ * @details Une future non résolue reste valide pour le gestionnaire de requêtes jusqu'à sa
+ * résolution ; son callback request_future_then() est alors toujours appelé.
+ * @param future La future (NULL accepté)
+ */
+void request_future_release(request_future_t *future) {
+	if(future) future_unref(future);
+}
@@ -1,48 +1,328 @@
 /**
  * @file request_manager.c
  * @brief Gère le suivi des requêtes MQTT en attente de réponse.
- * @details Utilise une hashmap pour corréler les réponses
+ * @details Utilise une hashmap pour corréler les réponses, découpée en REQUEST_MANAGER_SHARDS
+ * partitions protégées chacune par un verrou lecteurs/rédacteur. Les entrées sont indexées par
+ * la valeur de 64 bits de l'ID de la requête (voir command_id.h).
+ * Chaque requête a une échéance : si aucune réponse n'arrive à temps, le payload est renvoyé
+ * (request_manager_send(), avec un délai doublé à chaque tentative) puis le callback est appelé
+ * avec un statut d'expiration. Les échéances sont des timers de la roue fournie à
+ * request_manager_init() ; sans roue, request_manager_sweep() doit être appelée périodiquement.
  * @note L'implémentation est thread-safe
  * @author Lukas Grando
  * @date 2025-11-11
  */
 #include "core/request_manager.h"
 
-typedef struct {
-    char requestId[COMMAND_ID_LENGTH]; // Clé de la HashMap
+typedef struct request_shard request_shard_t;
+
+typedef struct hash_entry {
+    uint64_t key;                      // Clé de la HashMap (empreinte de requestId)
+    char requestId[COMMAND_ID_LENGTH]; // ID complet, comparé en cas de collision d'empreinte
+    request_shard_t* shard;            // Partition contenant l'entrée
     response_callback_t callback;      // Pointeur vers la fonction de rappel
     void* context;                     // Pointeur de contexte (sac à dos)
+    request_options_t options;         // Échéance et renvois
+    char* topic;                       // Copie du topic pour les renvois (NULL : aucun renvoi)
+    char* payload;                     // Copie du payload pour les renvois
+    char* replyTopic;                  // Copie du topic de réponse (propriété MQTT v5 des envois, NULL : aucun)
+    mqtt_qos_enum_t qos;
+    bool retain;
+    int attempts;                      // Renvois déjà effectués
+    long deadlineMs;                   // Échéance courante (0 : aucune)
+    timer_wheel_timer_t timer;         // Timer de l'échéance dans la roue
+    bool timerArmed;                   // Timer programmé ou callback du timer en cours
+    bool completed;                    // Réponse traitée pendant le callback du timer : il libère l'entrée
+    struct hash_entry* nextExpired;    // Chaînage des entrées expirées par request_manager_sweep()
     UT_hash_handle hh;                 // Structure interne pour uthash
 } hash_entry_t;
 
-static sem_t g_rmAccessSem; // Semaphore pour l'accès thread-safe
-static hash_entry_t *g_requestMap = NULL; // Hashmap des requêtes en attente
+struct request_shard {
+	pthread_rwlock_t lock; // Verrou de la partition (lecture seule pour les réponses inattendues)
+	hash_entry_t *map;     // Hashmap des requêtes en attente de la partition
+};
+
+static request_shard_t g_shards[REQUEST_MANAGER_SHARDS]; // Partitions de la hashmap
+static size_t g_pendingCount = 0; // Requêtes en attente, toutes partitions confondues
+static timer_wheel_t *g_rmWheel = NULL; // Roue portant les échéances (NULL : request_manager_sweep())
+
+static const request_options_t defaultOptions = { .timeoutMs = REQUEST_MANAGER_DEFAULT_TIMEOUT_MS };
+
+/**
+ * @brief Clé de 64 bits d'un ID de requête.
+ * @details Les IDs générés par create_command_header() portent directement leur valeur de 64 bits
+ * (command_id_parse()) ; les IDs externes sont hachés (FNV-1a).
+ * @internal
+ */
+static uint64_t request_key(const char *requestId) {
+	uint64_t id;
+	if(command_id_parse(requestId, &id) == 0) return id;
+
+	uint64_t hash = 14695981039346656037ULL;
+	for(const unsigned char *c = (const unsigned char *) requestId; *c; c++) {
+		hash ^= *c;
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+/**
+ * @brief Partition d'une clé.
+ * @internal
+ */
+static request_shard_t *shard_of(uint64_t key) {
+	return &g_shards[(key ^ (key >> 32)) & (REQUEST_MANAGER_SHARDS - 1)];
+}
+
+/**
+ * @brief Cherche une requête dans sa partition.
+ * @internal
+ * @note Appelée avec le verrou de la partition pris (lecture ou écriture).
+ */
+static hash_entry_t *find_locked(request_shard_t *shard, uint64_t key, const char *requestId) {
+	hash_entry_t *found = NULL;
+	HASH_FIND(hh, shard->map, &key, sizeof(uint64_t), found);
+	if(found && strcmp(found->requestId, requestId) != 0) return NULL;
+	return found;
+}
+
+/**
+ * @brief Retire une entrée de sa partition.
+ * @internal
+ * @note Appelée avec le verrou de la partition pris en écriture.
+ */
+static void remove_locked(hash_entry_t *entry) {
+	HASH_DEL(entry->shard->map, entry);
+	__atomic_sub_fetch(&g_pendingCount, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Horloge des échéances (celle de la roue si elle est fournie).
+ * @internal
+ */
+static long now_ms(void) {
+	return g_rmWheel ? g_rmWheel->clock() : timer_wheel_now_ms();
+}
+
+/**
+ * @brief Délai de la tentative courante : timeoutMs doublé à chaque renvoi, plafonné à maxTimeoutMs.
+ * @internal
+ */
+static int attempt_timeout_ms(const hash_entry_t *entry) {
+	int timeoutMs = entry->options.timeoutMs;
+	for(int i = 0; i < entry->attempts && timeoutMs < INT32_MAX / 2; i++) timeoutMs *= 2;
+	if(entry->options.maxTimeoutMs > 0 && timeoutMs > entry->options.maxTimeoutMs) timeoutMs = entry->options.maxTimeoutMs;
+	return timeoutMs;
+}
+
+/**
+ * @brief Libère une entrée et ses copies.
+ * @internal
+ */
+static void free_entry(hash_entry_t *entry) {
+	free(entry->topic);
+	free(entry->payload);
+	free(entry->replyTopic);
+	free(entry);
+}
+
+/**
+ * @brief Publie le payload d'une requête, avec son ID en données de corrélation (MQTT v5).
+ * @internal
+ */
+static int publish_entry(const hash_entry_t *entry) {
+	mqtt_publish_options_t publishOptions = {
+		.priority = MQTT_PRIORITY_COMMAND,
+		.properties = {
+			.responseTopic = entry->replyTopic,
+			.correlationData = entry->requestId,
+			.correlationLength = strlen(entry->requestId)
+		}
+	};
+	return mqtt_publish_with_options(entry->topic, entry->payload, strlen(entry->payload), entry->qos, entry->retain, &publishOptions);
+}
+
+/**
+ * @brief Programme l'échéance de la tentative courante.
+ * @internal
+ * @note Appelée avec le verrou de la partition pris en écriture.
+ */
+static void arm_locked(hash_entry_t *entry) {
+	if(entry->options.timeoutMs <= 0) {
+		entry->deadlineMs = 0;
+		return;
+	}
+
+	int delayMs = attempt_timeout_ms(entry);
+	entry->deadlineMs = now_ms() + delayMs;
+	if(g_rmWheel && timer_wheel_schedule(g_rmWheel, &entry->timer, delayMs, 0) == 0) {
+		entry->timerArmed = true;
+	}
+}
+
+/**
+ * @brief Annule le timer d'une entrée retirée de la hashmap.
+ * @internal
+ * @note Appelée avec le verrou de la partition pris en écriture.
+ * @return true si l'appelant peut libérer l'entrée, false si le callback du timer est en cours (il la libérera).
+ */
+static bool disarm_locked(hash_entry_t *entry) {
+	if(!entry->timerArmed) return true;
+	if(timer_wheel_cancel(g_rmWheel, &entry->timer)) {
+		entry->timerArmed = false;
+		return true;
+	}
+	entry->completed = true;
+	return false;
+}
+
+/**
+ * @brief Traite une échéance dépassée : renvoie le payload ou retire l'entrée de la hashmap.
+ * @internal
+ * @note Appelée avec le verrou de la partition pris en écriture.
+ * @return true si la requête a expiré (l'appelant doit appeler notify_timeout() sans le verrou).
+ */
+static bool handle_deadline_locked(hash_entry_t *entry) {
+	if(entry->payload && entry->attempts < entry->options.maxRetries) {
+		entry->attempts++;
+		LOG_WARNING_ASYNC("No response to request %s, resending (attempt %d/%d)", entry->requestId, entry->attempts, entry->options.maxRetries);
+		publish_entry(entry);
+		arm_locked(entry);
+		return false;
+	}
+
+	remove_locked(entry);
+	return true;
+}
+
+/**
+ * @brief Appelle le callback d'une requête expirée puis libère son entrée.
+ * @internal
+ */
+static void notify_timeout(hash_entry_t *entry) {
+	LOG_WARNING_ASYNC("Request %s timed out after %d attempt(s)", entry->requestId, entry->attempts + 1);
+	command_response_header_t header = create_command_response_header(entry->requestId, false, REQUEST_MANAGER_TIMEOUT_MESSAGE);
+	if(entry->callback) entry->callback(NULL, &header, entry->context);
+	free_entry(entry);
+}
+
+/**
+ * @brief Callback de la roue à l'échéance d'une requête.
+ * @internal
+ */
+static void on_request_deadline(timer_wheel_timer_t *timer, void *context) {
+	UNUSED(timer);
+	hash_entry_t *entry = (hash_entry_t*) context;
+
+	request_shard_t *shard = entry->shard;
+
+	pthread_rwlock_wrlock(&shard->lock);
+	entry->timerArmed = false;
+	if(entry->completed) {
+		// La réponse est arrivée pendant l'expiration : elle a déjà été traitée
+		pthread_rwlock_unlock(&shard->lock);
+		free_entry(entry);
+		return;
+	}
+	bool expired = handle_deadline_locked(entry);
+	pthread_rwlock_unlock(&shard->lock);
+
+	if(expired) notify_timeout(entry);
+}
 
 /**
- * @brief Initialise le gestionnaire de requêtes. Hashmap + semaphore.
+ * @brief Initialise le gestionnaire de requêtes. Partitions de la hashmap + verrous.
  * @note Doit être appelé une fois au démarrage du service.
+ * @param wheel Roue de timers portant les échéances (NULL : appeler request_manager_sweep() périodiquement)
  */
-void request_manager_init(void) {
-	int res = sem_init(&g_rmAccessSem, 0, 1);
-	g_requestMap = NULL;
-	CHECK_SEM(res);
+void request_manager_init(timer_wheel_t *wheel) {
+	for(int i = 0; i < REQUEST_MANAGER_SHARDS; i++) {
+		int res = pthread_rwlock_init(&g_shards[i].lock, NULL);
+		g_shards[i].map = NULL;
+		CHECK_PTHREAD(res);
+	}
+	g_pendingCount = 0;
+	g_rmWheel = wheel;
 
 }
 
 /**
- * @brief Nettoie le gestionnaire de requêtes. Libère la Hashmap et le semaphore.
+ * @brief Nettoie le gestionnaire de requêtes. Libère les partitions de la hashmap et leurs verrous.
+ * @details Les requêtes en attente expirent : leur callback reçoit l'en-tête d'expiration
+ * (une future est résolue en REQUEST_FUTURE_TIMEOUT).
+ * @warning La roue de timers doit être arrêtée avant.
  */
 void request_manager_destroy(void) {
-	hash_entry_t *current_entry, *tmp;
-	sem_wait(&g_rmAccessSem);
-	HASH_ITER(hh, g_requestMap, current_entry, tmp) {
-		HASH_DEL(g_requestMap, current_entry);
-		free(current_entry);
+	for(int i = 0; i < REQUEST_MANAGER_SHARDS; i++) {
+		request_shard_t *shard = &g_shards[i];
+		pthread_rwlock_wrlock(&shard->lock);
+		hash_entry_t *entry;
+		while((entry = shard->map) != NULL) {
+			remove_locked(entry);
+			bool owned = disarm_locked(entry);
+			pthread_rwlock_unlock(&shard->lock);
+
+			// Le callback est appelé sans le verrou, comme à l'expiration (voir notify_timeout())
+			if(owned) {
+				command_response_header_t timeoutHeader = create_command_response_header(entry->requestId, false, REQUEST_MANAGER_TIMEOUT_MESSAGE);
+				if(entry->callback) entry->callback(NULL, &timeoutHeader, entry->context);
+				free_entry(entry);
+			}
+			pthread_rwlock_wrlock(&shard->lock);
+		}
+		pthread_rwlock_unlock(&shard->lock);
+
+		int res = pthread_rwlock_destroy(&shard->lock);
+		CHECK_PTHREAD(res);
+	}
+	g_rmWheel = NULL;
+}
+
+/**
+ * @brief Crée une entrée de requête.
+ * @internal
+ */
+static hash_entry_t *create_entry(const char* requestId, response_callback_t callback, void* context, const request_options_t *options) {
+	hash_entry_t *newEntry = (hash_entry_t*)calloc(1, sizeof(hash_entry_t));
+	if(newEntry == NULL) {
+		LOG_ERROR_ASYNC("Memory allocation failed in request_manager_register");
+		return NULL;
+	}
+
+	strncpy(newEntry->requestId, requestId, COMMAND_ID_LENGTH - 1);
+	newEntry->key = request_key(newEntry->requestId);
+	newEntry->shard = shard_of(newEntry->key);
+	newEntry->callback = callback;
+	newEntry->context = context;
+	newEntry->options = options ? *options : defaultOptions;
+	timer_wheel_timer_init(&newEntry->timer, on_request_deadline, newEntry);
+	return newEntry;
+}
+
+/**
+ * @brief Ajoute une entrée à la hashmap et programme sa première échéance.
+ * @internal
+ * @note Appelée avec le verrou de la partition pris en écriture.
+ * @return 0 en cas de succès, -1 si l'ID existe déjà ou si trop de requêtes sont en attente.
+ */
+static int add_entry_locked(hash_entry_t *newEntry) {
+	hash_entry_t *found = NULL;
+	HASH_FIND(hh, newEntry->shard->map, &newEntry->key, sizeof(uint64_t), found);
+	if(found != NULL) {
+		// Même ID, ou collision d'empreinte (improbable) : refusée dans les deux cas
+		LOG_ERROR_ASYNC("Request ID already registered: %s", newEntry->requestId);
+		return -1;
+	}
+
+	if(__atomic_add_fetch(&g_pendingCount, 1, __ATOMIC_RELAXED) > REQUEST_MANAGER_MAX_PENDING) {
+		__atomic_sub_fetch(&g_pendingCount, 1, __ATOMIC_RELAXED);
+		LOG_ERROR_ASYNC("Too many pending requests (%d), rejecting request ID: %s", REQUEST_MANAGER_MAX_PENDING, newEntry->requestId);
+		return -1;
 	}
-	sem_post(&g_rmAccessSem);
 
-	int res = sem_destroy(&g_rmAccessSem);
-	CHECK_SEM(res);
+	HASH_ADD(hh, newEntry->shard->map, key, sizeof(uint64_t), newEntry);
+	arm_locked(newEntry);
+	return 0;
 }
 
 /**
@@ -51,8 +331,21 @@ void request_manager_destroy(void) {
  * @param callback La fonction à appeler lorsque la réponse arrivera.
  * @param context le contexte à passer au callback lors de l'appel pouvant être utilisé pour stocker des données spécifiques.
  * @return 0 en cas de succès, -1 si l'ID existe déjà ou en cas d'erreur.
+ * @note La requête expire après REQUEST_MANAGER_DEFAULT_TIMEOUT_MS.
  */
 int request_manager_register(const char* requestId, response_callback_t callback, void* context) {
+	return request_manager_register_with_options(requestId, callback, context, NULL);
+}
+
+/**
+ * @brief Enregistre une requête en attente avec une échéance choisie.
+ * @param requestId L'ID de la requête qui sera envoyée.
+ * @param callback La fonction à appeler lorsque la réponse arrivera ou que la requête expirera.
+ * @param context Le contexte à passer au callback.
+ * @param options Options d'attente (NULL : échéance par défaut). maxRetries est ignoré : aucun payload n'est connu.
+ * @return 0 en cas de succès, -1 si l'ID existe déjà, si trop de requêtes sont en attente ou en cas d'erreur.
+ */
+int request_manager_register_with_options(const char* requestId, response_callback_t callback, void* context, const request_options_t *options) {
 	if(requestId == NULL) {
 		LOG_ERROR_ASYNC("Invalid parameters to request_manager_register");
 		return -1;
@@ -63,32 +356,81 @@ int request_manager_register(const char* requestId, response_callback_t callback
 		LOG_WARNING_ASYNC("Registering request with NULL callback: %s", requestId);
 	}
 
-	hash_entry_t *newEntry = (hash_entry_t*)malloc(sizeof(hash_entry_t));
-	if(newEntry == NULL) {
-		LOG_ERROR_ASYNC("Memory allocation failed in request_manager_register");
+	hash_entry_t *newEntry = create_entry(requestId, callback, context, options);
+	if(newEntry == NULL) return -1;
+
+	request_shard_t *shard = newEntry->shard;
+	pthread_rwlock_wrlock(&shard->lock);
+	if(add_entry_locked(newEntry) != 0) {
+		pthread_rwlock_unlock(&shard->lock);
+		free_entry(newEntry);
 		return -1;
 	}
+	pthread_rwlock_unlock(&shard->lock);
+	LOG_DEBUG_ASYNC("Registered request ID: %s", requestId);
+	return 0;
 
-	strncpy(newEntry->requestId, requestId, COMMAND_ID_LENGTH);
-	newEntry->callback = callback;
-	newEntry->context = context;
-	sem_wait(&g_rmAccessSem);
+}
 
-	hash_entry_t *found = NULL;
-	HASH_FIND_STR(g_requestMap, requestId, found);
-	
-	if(found != NULL) {
-		sem_post(&g_rmAccessSem);
-		free(newEntry);
-		LOG_ERROR_ASYNC("Request ID already registered: %s", requestId);
+/**
+ * @brief Enregistre une requête puis publie son payload.
+ * @details Le topic et le payload sont copiés : à chaque échéance sans réponse, le payload est
+ * republié tant que options->maxRetries n'est pas atteint, puis le callback est appelé avec
+ * un statut d'expiration. En MQTT v5, requestId est transmis en données de corrélation et
+ * options->replyTopic en topic de réponse.
+ * @param topic Topic de la requête.
+ * @param requestId L'ID de la requête (command_id de son en-tête).
+ * @param payload Le payload JSON de la requête.
+ * @param qos Le niveau de QoS à utiliser.
+ * @param retain Flag de rétention du message.
+ * @param callback La fonction à appeler lorsque la réponse arrivera ou que la requête expirera.
+ * @param context Le contexte à passer au callback.
+ * @param options Options d'attente (NULL : échéance par défaut, sans renvoi).
+ * @return 0 en cas de succès, -1 en cas d'erreur (la requête n'est alors pas enregistrée).
+ * @note Si la première publication échoue alors que des renvois sont prévus, la requête reste
+ * enregistrée : le prochain renvoi la publiera.
+ */
+int request_manager_send(const char* topic, const char* requestId, const char* payload, mqtt_qos_enum_t qos, bool retain,
+	response_callback_t callback, void* context, const request_options_t *options) {
+	if(topic == NULL || requestId == NULL || payload == NULL) {
+		LOG_ERROR_ASYNC("Invalid parameters to request_manager_send");
 		return -1;
 	}
 
-	HASH_ADD_STR(g_requestMap, requestId, newEntry);
-	sem_post(&g_rmAccessSem);
-	LOG_DEBUG_ASYNC("Registered request ID: %s", requestId);
-	return 0;
+	hash_entry_t *newEntry = create_entry(requestId, callback, context, options);
+	if(newEntry == NULL) return -1;
+	newEntry->qos = qos;
+	newEntry->retain = retain;
+	newEntry->topic = strdup(topic);
+	newEntry->payload = strdup(payload);
+	if(newEntry->options.replyTopic) newEntry->replyTopic = strdup(newEntry->options.replyTopic);
+	newEntry->options.replyTopic = newEntry->replyTopic; // La copie de l'appelant peut être libérée
+	if(!newEntry->topic || !newEntry->payload || (options && options->replyTopic && !newEntry->replyTopic)) {
+		LOG_ERROR_ASYNC("Memory allocation failed in request_manager_send");
+		free_entry(newEntry);
+		return -1;
+	}
+
+	// Publication sous le verrou : la réponse ne peut pas être traitée avant l'enregistrement complet
+	request_shard_t *shard = newEntry->shard;
+	pthread_rwlock_wrlock(&shard->lock);
+	if(add_entry_locked(newEntry) != 0) {
+		pthread_rwlock_unlock(&shard->lock);
+		free_entry(newEntry);
+		return -1;
+	}
 
+	if(publish_entry(newEntry) != 0 && newEntry->options.maxRetries <= 0) {
+		remove_locked(newEntry);
+		bool owned = disarm_locked(newEntry);
+		pthread_rwlock_unlock(&shard->lock);
+		if(owned) free_entry(newEntry);
+		LOG_ERROR_ASYNC("Failed to send request ID: %s", requestId);
+		return -1;
+	}
+	pthread_rwlock_unlock(&shard->lock);
+	LOG_DEBUG_ASYNC("Sent request ID: %s", requestId);
+	return 0;
 }
 
 /**
@@ -103,10 +445,26 @@ int request_manager_process_response(const char* payload) {
 		LOG_ERROR_ASYNC("Invalid payload in request_manager_process_response");
 		return -1;
 	}
+	return request_manager_process_payload(payload, strlen(payload));
+}
+
+/**
+ * @brief Traite un payload de réponse entrant, sans le recopier.
+ * @details Variante de request_manager_process_response() pour un payload délimité par sa taille
+ * (ex : buffer reçu par un handler du routeur MQTT).
+ * @param payload Le payload JSON brut reçu (non terminé par '\0' garanti).
+ * @param length Taille du payload en octets.
+ * @return 0 si la réponse a été trouvée et traitée, -1 si elle était inattendue ou invalide.
+ */
+int request_manager_process_payload(const void* payload, size_t length) {
+	if(!payload) {
+		LOG_ERROR_ASYNC("Invalid payload in request_manager_process_payload");
+		return -1;
+	}
 	// command_response_header_deserialize
-	cJSON *json = cJSON_Parse(payload);
+	cJSON *json = cJSON_ParseWithLength((const char *) payload, length);
 	if(!json) {
-		LOG_ERROR_ASYNC("Failed to parse JSON payload in request_manager_process_response");
+		LOG_ERROR_ASYNC("Failed to parse JSON payload in request_manager_process_payload");
 		return -1;
 	}
 
@@ -117,23 +475,77 @@ int request_manager_process_response(const char* payload) {
 		return -1;
 	}
 
-	sem_wait(&g_rmAccessSem);
+	uint64_t key = request_key(responseHeader.commandId);
+	request_shard_t *shard = shard_of(key);
+
+	// Réponses inattendues (doublons après un renvoi, autre instance) : lecture seule
+	pthread_rwlock_rdlock(&shard->lock);
+	bool known = find_locked(shard, key, responseHeader.commandId) != NULL;
+	pthread_rwlock_unlock(&shard->lock);
+
 	hash_entry_t *found = NULL;
-	HASH_FIND_STR(g_requestMap, responseHeader.commandId, found);
+	if(known) {
+		pthread_rwlock_wrlock(&shard->lock);
+		found = find_locked(shard, key, responseHeader.commandId);
+		if(!found) pthread_rwlock_unlock(&shard->lock); // Expirée entre temps
+	}
 	if(!found) {
-		sem_post(&g_rmAccessSem);
 		cJSON_Delete(json);
 		return -1;
 	}
 
 	// Retirer de la hashmap avant d'appeler le callback pour éviter les récursions
-	HASH_DEL(g_requestMap, found);
-	sem_post(&g_rmAccessSem);
+	remove_locked(found);
+	bool owned = disarm_locked(found);
+	response_callback_t callback = found->callback;
+	void *context = found->context;
+	pthread_rwlock_unlock(&shard->lock);
 	// Appeler le callback
-	if(found->callback) found->callback(json, &responseHeader, found->context);
-	
-	free(found);
+	if(callback) callback(json, &responseHeader, context);
+
+	if(owned) free_entry(found);
 	cJSON_Delete(json);
 	LOG_DEBUG_ASYNC("Processed response for request ID: %s", responseHeader.commandId);
 	return 0;
 }
+
+/**
+ * @brief Traite les requêtes dont l'échéance est dépassée (renvoi ou expiration).
+ * @details Inutile si une roue de timers a été fournie à request_manager_init(), mais sans effet
+ * de bord dans ce cas.
+ * @return Le nombre de requêtes expirées.
+ */
+int request_manager_sweep(void) {
+	hash_entry_t *current_entry, *tmp, *expired = NULL;
+	int count = 0;
+
+	long nowMs = now_ms();
+	for(int i = 0; i < REQUEST_MANAGER_SHARDS; i++) {
+		request_shard_t *shard = &g_shards[i];
+		pthread_rwlock_wrlock(&shard->lock);
+		HASH_ITER(hh, shard->map, current_entry, tmp) {
+			// Les échéances portées par la roue lui sont laissées
+			if(current_entry->timerArmed || current_entry->deadlineMs == 0 || current_entry->deadlineMs > nowMs) continue;
+			if(handle_deadline_locked(current_entry)) {
+				current_entry->nextExpired = expired;
+				expired = current_entry;
+			}
+		}
+		pthread_rwlock_unlock(&shard->lock);
+	}
+
+	while(expired) {
+		hash_entry_t *next = expired->nextExpired;
+		notify_timeout(expired);
+		expired = next;
+		count++;
+	}
+	return count;
+}
+
+/**
+ * @brief Retourne le nombre de requêtes en attente de réponse.
+ */
+size_t request_manager_pending_count(void) {
+	return __atomic_load_n(&g_pendingCount, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,284 @@
+/**
+ * @file ring_buffer.c
+ * @brief File circulaire bornée multi-producteurs / consommateur unique (MPSC), sans verrou.
+ * @details
+ * Chaque case porte un numéro de séquence :
+ * - sequence == position : la case est libre pour le producteur qui réserve cette position ;
+ * - sequence == position + 1 : la case est publiée et peut être lue ;
+ * - après lecture, sequence = position + capacité (libre pour le tour suivant).
+ * @date 2026-10-19
+ */
+#include "core/ring_buffer.h"
+#include <sys/eventfd.h>
+#include <poll.h>
+
+/**
+ * @brief Retourne l'en-tête de la case d'une position.
+ * @internal
+ */
+static inline ring_buffer_cell_t *cell_at(const ring_buffer_t *rb, size_t position) {
+	return (ring_buffer_cell_t *) (rb->cells + (position & rb->mask) * rb->stride);
+}
+
+/**
+ * @brief Retourne l'en-tête d'une case à partir de son contenu.
+ * @internal
+ */
+static inline ring_buffer_cell_t *cell_of(void *slot) {
+	return (ring_buffer_cell_t *) ((unsigned char *) slot - offsetof(ring_buffer_cell_t, payload));
+}
+
+/**
+ * @brief Initialise une file circulaire de pointeurs.
+ * @param rb La file
+ * @param capacity Capacité minimale (arrondie à la puissance de 2 supérieure)
+ * @param blocking Crée l'eventfd permettant au consommateur d'attendre (ring_buffer_wait())
+ * @return 0 en cas de succès, -1 en cas d'erreur
+ */
+int ring_buffer_init(ring_buffer_t *rb, size_t capacity, bool blocking) {
+	return ring_buffer_init_slots(rb, capacity, sizeof(void *), blocking);
+}
+
+/**
+ * @brief Initialise une file circulaire de cases de taille fixe.
+ * @param rb La file
+ * @param capacity Capacité minimale (arrondie à la puissance de 2 supérieure)
+ * @param slotSize Taille du contenu d'une case en octets
+ * @param blocking Crée l'eventfd permettant au consommateur d'attendre (ring_buffer_wait())
+ * @return 0 en cas de succès, -1 en cas d'erreur
+ */
+int ring_buffer_init_slots(ring_buffer_t *rb, size_t capacity, size_t slotSize, bool blocking) {
+	if (!rb || capacity == 0 || slotSize == 0) return -1;
+
+	size_t size = 2;
+	while (size < capacity) size <<= 1;
+
+	memset(rb, 0, sizeof(*rb));
+	rb->eventFd = -1;
+	rb->stride = sizeof(ring_buffer_cell_t) + ((slotSize + sizeof(max_align_t) - 1) / sizeof(max_align_t)) * sizeof(max_align_t);
+	rb->mask = size - 1;
+	rb->cells = (unsigned char *) malloc(rb->stride * size);
+	if (!rb->cells) return -1;
+
+	for (size_t i = 0; i < size; i++) {
+		cell_at(rb, i)->sequence = i;
+	}
+
+	if (blocking) {
+		rb->eventFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+		if (rb->eventFd < 0) {
+			free(rb->cells);
+			rb->cells = NULL;
+			return -1;
+		}
+	}
+	return 0;
+}
+
+/**
+ * @brief Réserve une case à remplir (appelable depuis plusieurs threads).
+ * @details La case doit ensuite être publiée avec ring_buffer_publish(). Le consommateur
+ * lit dans l'ordre de réservation : une case réservée bloque la lecture des suivantes
+ * jusqu'à sa publication, elle doit donc être remplie sans attendre.
+ * @param rb La file
+ * @return Le contenu de la case réservée, ou NULL si la file est pleine
+ */
+void *ring_buffer_claim(ring_buffer_t *rb) {
+	size_t position = __atomic_load_n(&rb->tail, __ATOMIC_RELAXED);
+	for (;;) {
+		ring_buffer_cell_t *cell = cell_at(rb, position);
+		size_t sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+		intptr_t diff = (intptr_t) sequence - (intptr_t) position;
+
+		if (diff == 0) {
+			// Case libre : on tente de la réserver (position est mise à jour en cas d'échec)
+			if (__atomic_compare_exchange_n(&rb->tail, &position, position + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+				return cell->payload;
+			}
+		} else if (diff < 0) {
+			return NULL; // Case pas encore lue depuis le tour précédent : file pleine
+		} else {
+			position = __atomic_load_n(&rb->tail, __ATOMIC_RELAXED);
+		}
+	}
+}
+
+/**
+ * @brief Publie une case réservée avec ring_buffer_claim().
+ * @param rb La file
+ * @param slot Le contenu retourné par ring_buffer_claim()
+ */
+void ring_buffer_publish(ring_buffer_t *rb, void *slot) {
+	// Tant qu'elle est réservée, la séquence de la case vaut sa position
+	ring_buffer_cell_t *cell = cell_of(slot);
+	__atomic_store_n(&cell->sequence, __atomic_load_n(&cell->sequence, __ATOMIC_RELAXED) + 1, __ATOMIC_RELEASE);
+
+	// Réveil du consommateur uniquement s'il dort (voir ring_buffer_wait())
+	if (rb->eventFd >= 0) {
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+		if (__atomic_load_n(&rb->consumerSleeping, __ATOMIC_RELAXED)) {
+			ring_buffer_wake(rb);
+		}
+	}
+}
+
+/**
+ * @brief Retourne la prochaine case publiée sans la retirer (consommateur uniquement).
+ * @param rb La file
+ * @return Le contenu de la case, ou NULL si la file est vide
+ */
+void *ring_buffer_peek(ring_buffer_t *rb) {
+	ring_buffer_cell_t *cell = cell_at(rb, rb->head);
+	if (__atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE) != rb->head + 1) return NULL;
+	return cell->payload;
+}
+
+/**
+ * @brief Libère la case retournée par ring_buffer_peek() (consommateur uniquement).
+ * @param rb La file
+ */
+void ring_buffer_release(ring_buffer_t *rb) {
+	ring_buffer_cell_t *cell = cell_at(rb, rb->head);
+	__atomic_store_n(&cell->sequence, rb->head + rb->mask + 1, __ATOMIC_RELEASE);
+	rb->head++;
+}
+
+/**
+ * @brief Retourne la case publiée située offset positions après la prochaine case à lire (consommateur uniquement).
+ * @details Permet de traiter plusieurs cases avant de les libérer ensemble avec ring_buffer_release_n().
+ * @param rb La file
+ * @param offset Décalage depuis la prochaine case à lire (0 : équivalent à ring_buffer_peek())
+ * @return Le contenu de la case, ou NULL si elle n'est pas (encore) publiée
+ */
+void *ring_buffer_peek_at(ring_buffer_t *rb, size_t offset) {
+	if(offset > rb->mask) return NULL;
+
+	size_t position = rb->head + offset;
+	ring_buffer_cell_t *cell = cell_at(rb, position);
+	if (__atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE) != position + 1) return NULL;
+	return cell->payload;
+}
+
+/**
+ * @brief Libère les count prochaines cases, lues avec ring_buffer_peek_at() (consommateur uniquement).
+ * @param rb La file
+ * @param count Nombre de cases à libérer
+ */
+void ring_buffer_release_n(ring_buffer_t *rb, size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		ring_buffer_release(rb);
+	}
+}
+
+/**
+ * @brief Ajoute un pointeur sans bloquer (appelable depuis plusieurs threads).
+ * @param rb La file (initialisée avec ring_buffer_init())
+ * @param data Le pointeur à ajouter (non NULL)
+ * @return true si l'élément a été ajouté, false si la file est pleine ou data est NULL
+ */
+bool ring_buffer_try_push(ring_buffer_t *rb, void *data) {
+	if (!data) return false;
+
+	void **slot = (void **) ring_buffer_claim(rb);
+	if (!slot) return false;
+
+	*slot = data;
+	ring_buffer_publish(rb, slot);
+	return true;
+}
+
+/**
+ * @brief Retire un pointeur (consommateur uniquement).
+ * @param rb La file (initialisée avec ring_buffer_init())
+ * @return L'élément retiré, ou NULL si la file est vide
+ */
+void *ring_buffer_pop(ring_buffer_t *rb) {
+	void *data = NULL;
+	return ring_buffer_pop_batch(rb, &data, 1) == 1 ? data : NULL;
+}
+
+/**
+ * @brief Retire jusqu'à maxCount pointeurs (consommateur uniquement).
+ * @param rb La file (initialisée avec ring_buffer_init())
+ * @param out Tableau recevant les éléments, dans l'ordre de publication
+ * @param maxCount Taille du tableau out
+ * @return Le nombre d'éléments retirés
+ */
+size_t ring_buffer_pop_batch(ring_buffer_t *rb, void **out, size_t maxCount) {
+	size_t count = 0;
+	void **slot;
+	while (count < maxCount && (slot = (void **) ring_buffer_peek(rb)) != NULL) {
+		out[count++] = *slot;
+		ring_buffer_release(rb);
+	}
+	return count;
+}
+
+/**
+ * @brief Indique si la file est vide (exact du point de vue du consommateur).
+ */
+bool ring_buffer_is_empty(ring_buffer_t *rb) {
+	return ring_buffer_peek(rb) == NULL;
+}
+
+/**
+ * @brief Retourne la capacité de la file.
+ */
+size_t ring_buffer_capacity(const ring_buffer_t *rb) {
+	return rb->mask + 1;
+}
+
+/**
+ * @brief Attend qu'un élément soit disponible (consommateur uniquement, mode bloquant).
+ * @param rb La file
+ * @param timeoutMs Délai maximal en millisecondes (-1 : infini)
+ * @return 0 si la file n'est pas vide ou si ring_buffer_wake() a été appelé, -1 en cas de délai dépassé ou d'erreur
+ */
+int ring_buffer_wait(ring_buffer_t *rb, int timeoutMs) {
+	if (!ring_buffer_is_empty(rb)) return 0;
+	if (rb->eventFd < 0) return -1;
+
+	// Annonce le sommeil puis revérifie : un producteur qui publie après ce point verra le drapeau
+	__atomic_store_n(&rb->consumerSleeping, 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	if (!ring_buffer_is_empty(rb)) {
+		__atomic_store_n(&rb->consumerSleeping, 0, __ATOMIC_RELAXED);
+		return 0;
+	}
+
+	struct pollfd pfd = { .fd = rb->eventFd, .events = POLLIN };
+	int rc = poll(&pfd, 1, timeoutMs);
+	__atomic_store_n(&rb->consumerSleeping, 0, __ATOMIC_RELAXED);
+
+	if (rc > 0) {
+		uint64_t value;
+		if (read(rb->eventFd, &value, sizeof(value)) < 0) { /* déjà consommé */ }
+		return 0;
+	}
+	return ring_buffer_is_empty(rb) ? -1 : 0;
+}
+
+/**
+ * @brief Réveille le consommateur en attente (ex : arrêt du thread consommateur).
+ * @param rb La file
+ */
+void ring_buffer_wake(ring_buffer_t *rb) {
+	if (rb->eventFd < 0) return;
+
+	uint64_t one = 1;
+	if (write(rb->eventFd, &one, sizeof(one)) < 0) { /* compteur saturé : un réveil est déjà en attente */ }
+}
+
+/**
+ * @brief Libère les ressources de la file (les éléments restants ne sont pas libérés).
+ * @param rb La file
+ */
+void ring_buffer_destroy(ring_buffer_t *rb) {
+	if (!rb) return;
+
+	if (rb->eventFd >= 0) close(rb->eventFd);
+	free(rb->cells);
+	rb->cells = NULL;
+	rb->eventFd = -1;
+	rb->mask = 0;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file service_control.c
+ * @brief Topic de contrôle commun à tous les services.
+ * @date 2026-10-19
+ */
+
+#include "core/service_control.h"
+#include "core/action_codes.h"
+#include "core/mqtt.h"
+#include "core/mqtt_messages/command_response_header.h"
+
+static char controlTopic[SERVICE_CONTROL_TOPIC_LENGTH] = ""; // Topic de contrôle du service
+
+/**
+ * @private
+ * @brief Publie la réponse à une commande de contrôle si un topic de réponse est fourni.
+ */
+static void service_control_reply(const command_header_t *header, bool success, const char *errorMessage) {
+	if(header->replyTopic[0] == '\0') return;
+
+	command_response_header_t response = create_command_response_header(header->commandId, success, errorMessage);
+	char *jsonResponse = command_response_header_serialize(&response);
+	if(jsonResponse) {
+		mqtt_publish_reply(header, jsonResponse, MQTT_QOS_AT_MOST_ONCE);
+		free(jsonResponse);
+	}
+}
+
+/**
+ * @brief Installe le gestionnaire de contrôle et s'abonne au topic de contrôle du service.
+ * @param clientId Identifiant MQTT du service.
+ * @return 0 en cas de succès, -1 en cas d'erreur.
+ * @note Le client MQTT doit être connecté.
+ */
+int service_control_init(const char *clientId) {
+	if(!clientId) return -1;
+
+	int length = snprintf(controlTopic, sizeof(controlTopic), SERVICE_CONTROL_TOPIC_FORMAT, clientId);
+	if(length < 0 || (size_t) length >= sizeof(controlTopic)) {
+		controlTopic[0] = '\0';
+		return -1;
+	}
+
+	mqtt_set_control_handler(service_control_handle_message);
+	return mqtt_subscribe(controlTopic, MQTT_QOS_AT_LEAST_ONCE);
+}
+
+/**
+ * @brief Applique une commande SET_LOG_LEVEL.
+ * @param request La commande désérialisée.
+ * @return 0 en cas de succès, -1 si le niveau ne peut pas être appliqué.
+ */
+int service_control_apply_log_level(const set_log_level_request_t *request) {
+	if(!request) return -1;
+
+	if(!request->hasModule) {
+		if(request->level == LOG_MODULE_INHERIT) return -1;
+		logger_set_level((log_level_t) request->level);
+		LOG_INFO_ASYNC("CORE: Log level set to %s.", logger_level_to_string((log_level_t) request->level));
+		return 0;
+	}
+
+	if(logger_set_module_level(request->module, request->level) != 0) return -1;
+	LOG_INFO_ASYNC("CORE: Log level of module %s set to %s%s.", logger_module_to_string(request->module),
+		logger_level_to_string(logger_get_module_level(request->module)),
+		request->level == LOG_MODULE_INHERIT ? " (inherited)" : "");
+	return 0;
+}
+
+/**
+ * @brief Traite un message reçu s'il est adressé au topic de contrôle.
+ * @param topic Le topic du message.
+ * @param payload Le contenu du message (non terminé par '\0' garanti).
+ * @param length Taille du contenu en octets.
+ * @return true si le message était un message de contrôle (traité ou rejeté), false sinon.
+ */
+bool service_control_handle_message(const char *topic, const void *payload, size_t length) {
+	if(controlTopic[0] == '\0' || strcmp(topic, controlTopic) != 0) return false;
+
+	command_header_t header = {0};
+	cJSON *root = cJSON_ParseWithLength((const char *) payload, length);
+	if(!root) {
+		LOG_ERROR_ASYNC("CORE: Control payload is not valid JSON.");
+		return true;
+	}
+	if(command_header_deserialize(root, &header) != 0) {
+		LOG_ERROR_ASYNC("CORE: Failed to deserialize control command header.");
+		cJSON_Delete(root);
+		return true;
+	}
+
+	if(strcmp(header.action, ACTION_SET_LOG_LEVEL) == 0) {
+		set_log_level_request_t request = { .header = header };
+		if(set_log_level_request_data_deserialize(root, &request) != 0) {
+			LOG_ERROR_ASYNC("CORE: Invalid SET_LOG_LEVEL command.");
+			service_control_reply(&header, false, "Invalid module or level");
+		} else if(service_control_apply_log_level(&request) != 0) {
+			service_control_reply(&header, false, "Unable to apply log level");
+		} else {
+			service_control_reply(&header, true, NULL);
+		}
+	} else {
+		LOG_WARNING_ASYNC("CORE: Unknown control action '%s'.", header.action);
+		service_control_reply(&header, false, "Unknown action");
+		cJSON_Delete(root);
+	}
+	return true;
+}
@@ -10,11 +10,13 @@
 #include <signal.h>
 
 static sem_t shutdownSem;
+static event_loop_t *shutdownLoop = NULL;
 
 static void handle_signal(int signum) {
 	UNUSED(signum);
 	// ici on ne passe pas par send_shutdown pour éviter une récursion potentielle
 	CHECK_SEM_RAW(sem_post(&shutdownSem)); 
+	event_loop_stop(__atomic_load_n(&shutdownLoop, __ATOMIC_ACQUIRE)); // async-signal-safe
 }
 
 /**
@@ -54,6 +56,18 @@ void signal_wait_for_shutdown(void) {
  */
 void signal_send_shutdown(void) {
 	CHECK_SEM_RAW(sem_post(&shutdownSem));
+	event_loop_stop(__atomic_load_n(&shutdownLoop, __ATOMIC_ACQUIRE));
+}
+
+/**
+ * @brief Arrête aussi une boucle d'événements à la réception d'un signal d'arrêt.
+ * @details Utilisé par les services dont le thread principal exécute une boucle d'événements
+ * au lieu d'attendre sur signal_wait_for_shutdown().
+ * @param loop La boucle à arrêter (NULL : aucune)
+ * @return void
+ */
+void signal_set_event_loop(event_loop_t *loop) {
+	__atomic_store_n(&shutdownLoop, loop, __ATOMIC_RELEASE);
 }
 
 /**
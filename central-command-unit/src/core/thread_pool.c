@@ -0,0 +1,182 @@
+/**
+ * @file thread_pool.c
+ * @brief Pool de threads de calcul (fork-join).
+ * @date 2026-10-19
+ */
+#include "core/thread_pool.h"
+
+/**
+ * @brief Traite les indices de la boucle en cours jusqu'à épuisement.
+ * @internal
+ */
+static void run_loop(thread_pool_t *pool, int workerIndex) {
+	for (;;) {
+		int index = __atomic_fetch_add(&pool->nextIndex, 1, __ATOMIC_RELAXED);
+		if (index >= pool->count) break;
+		pool->task(index, workerIndex, pool->context);
+	}
+}
+
+/**
+ * @brief Indique la fin de la boucle en cours pour un worker.
+ * @internal
+ */
+static void worker_finished(thread_pool_t *pool) {
+	pthread_mutex_lock(&pool->lock);
+	if (--pool->activeWorkers == 0) {
+		pthread_cond_signal(&pool->workDone);
+	}
+	pthread_mutex_unlock(&pool->lock);
+}
+
+typedef struct {
+	thread_pool_t *pool;
+	int workerIndex;
+} worker_args_t;
+
+/**
+ * @brief Boucle principale d'un worker : attend une boucle publiée, la traite, recommence.
+ * @internal
+ */
+static void *worker_main(void *arg) {
+	worker_args_t *args = (worker_args_t *) arg;
+	thread_pool_t *pool = args->pool;
+	int workerIndex = args->workerIndex;
+	free(args);
+
+	unsigned long seenGeneration = 0;
+	for (;;) {
+		pthread_mutex_lock(&pool->lock);
+		while (!pool->stopping && pool->generation == seenGeneration) {
+			pthread_cond_wait(&pool->workAvailable, &pool->lock);
+		}
+		if (pool->stopping) {
+			pthread_mutex_unlock(&pool->lock);
+			break;
+		}
+		seenGeneration = pool->generation;
+		pthread_mutex_unlock(&pool->lock);
+
+		run_loop(pool, workerIndex);
+		worker_finished(pool);
+	}
+	return NULL;
+}
+
+/**
+ * @brief Crée un pool de threads.
+ * @param workerCount Nombre de workers, thread appelant compris (0 : nombre de coeurs en ligne)
+ * @return Le pool créé, ou NULL en cas d'erreur
+ * @warning Le pool doit être libéré avec thread_pool_destroy()
+ */
+thread_pool_t *thread_pool_create(int workerCount) {
+	if (workerCount <= 0) {
+		long online = sysconf(_SC_NPROCESSORS_ONLN);
+		workerCount = online > 0 ? (int) online : 1;
+	}
+	if (workerCount > THREAD_POOL_MAX_WORKERS) {
+		workerCount = THREAD_POOL_MAX_WORKERS;
+	}
+
+	thread_pool_t *pool = (thread_pool_t *) calloc(1, sizeof(thread_pool_t));
+	if (!pool) return NULL;
+
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_mutex_init(&pool->callLock, NULL);
+	pthread_cond_init(&pool->workAvailable, NULL);
+	pthread_cond_init(&pool->workDone, NULL);
+	pool->workerCount = 1;
+
+	// Le worker 0 est le thread appelant de thread_pool_parallel_for()
+	for (int i = 1; i < workerCount; i++) {
+		worker_args_t *args = (worker_args_t *) malloc(sizeof(worker_args_t));
+		if (!args) break;
+		args->pool = pool;
+		args->workerIndex = i;
+
+		if (pthread_create(&pool->threads[i], NULL, worker_main, args) != 0) {
+			free(args);
+			break;
+		}
+		pool->workerCount++;
+	}
+
+	if (pool->workerCount < workerCount) {
+		LOG_WARNING_ASYNC("Thread pool started with %d of %d requested workers", pool->workerCount, workerCount);
+	}
+	return pool;
+}
+
+/**
+ * @brief Retourne le nombre de workers du pool (thread appelant compris).
+ */
+int thread_pool_size(const thread_pool_t *pool) {
+	return pool ? pool->workerCount : 0;
+}
+
+/**
+ * @brief Exécute task(i) pour chaque i de [0, count) en parallèle et attend la fin.
+ * @param pool Le pool
+ * @param count Nombre d'itérations
+ * @param task La tâche à exécuter
+ * @param context Contexte transmis à chaque appel de la tâche
+ * @return 0 en cas de succès, -1 en cas d'erreur (paramètres invalides)
+ */
+int thread_pool_parallel_for(thread_pool_t *pool, int count, thread_pool_task_t task, void *context) {
+	if (!pool || !task || count < 0) return -1;
+	if (count == 0) return 0;
+
+	pthread_mutex_lock(&pool->callLock);
+
+	// Boucle trop petite ou pool sans worker : exécution directe sur le thread appelant
+	if (pool->workerCount == 1 || count == 1) {
+		for (int i = 0; i < count; i++) task(i, 0, context);
+		pthread_mutex_unlock(&pool->callLock);
+		return 0;
+	}
+
+	pthread_mutex_lock(&pool->lock);
+	pool->task = task;
+	pool->context = context;
+	pool->count = count;
+	pool->nextIndex = 0;
+	pool->activeWorkers = pool->workerCount;
+	pool->generation++;
+	pthread_cond_broadcast(&pool->workAvailable);
+	pthread_mutex_unlock(&pool->lock);
+
+	run_loop(pool, 0);
+	worker_finished(pool);
+
+	pthread_mutex_lock(&pool->lock);
+	while (pool->activeWorkers > 0) {
+		pthread_cond_wait(&pool->workDone, &pool->lock);
+	}
+	pthread_mutex_unlock(&pool->lock);
+
+	pthread_mutex_unlock(&pool->callLock);
+	return 0;
+}
+
+/**
+ * @brief Arrête les workers et libère le pool.
+ * @param pool Le pool (NULL accepté)
+ */
+void thread_pool_destroy(thread_pool_t *pool) {
+	if (!pool) return;
+
+	pthread_mutex_lock(&pool->lock);
+	pool->stopping = true;
+	pthread_cond_broadcast(&pool->workAvailable);
+	pthread_mutex_unlock(&pool->lock);
+
+	for (int i = 1; i < pool->workerCount; i++) {
+		pthread_join(pool->threads[i], NULL);
+	}
+
+	pthread_cond_destroy(&pool->workAvailable);
+	pthread_cond_destroy(&pool->workDone);
+	pthread_mutex_destroy(&pool->lock);
+	pthread_mutex_destroy(&pool->callLock);
+	free(pool);
+}
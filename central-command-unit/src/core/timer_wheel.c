@@ -0,0 +1,484 @@
+/**
+ * @file timer_wheel.c
+ * @brief Service de timers basé sur une roue hiérarchique (hierarchical timing wheel).
+ * @details
+ * Un timer d'échéance E inséré lorsque le prochain tick à traiter vaut C est placé au niveau L
+ * tel que E - C < SLOTS^(L+1), dans la case (E >> (L * SLOT_BITS)) % SLOTS. Cette case est
+ * redistribuée au premier tick multiple de SLOTS^L qui l'atteint, toujours compris entre C et E :
+ * le timer descend ainsi de niveau en niveau jusqu'au niveau 0, dont la case expire au tick E.
+ * @date 2026-10-19
+ */
+#include "core/timer_wheel.h"
+#include "core/clock.h"
+#include <errno.h>
+
+#define SLOT_MASK ((uint64_t) TIMER_WHEEL_SLOTS - 1)
+#define LEVEL_SHIFT(level) ((level) * TIMER_WHEEL_SLOT_BITS)
+#define WHEEL_SPAN (1ULL << LEVEL_SHIFT(TIMER_WHEEL_LEVELS)) //!< Délai maximal représentable, en ticks
+#define NO_TICK UINT64_MAX
+
+/**
+ * @brief Horloge par défaut des roues : clock_monotonic_ms().
+ */
+long timer_wheel_now_ms(void) {
+	return clock_monotonic_ms();
+}
+
+/**
+ * @brief Millisecondes écoulées depuis l'initialisation de la roue.
+ * @internal
+ */
+static uint64_t elapsed_ms(const timer_wheel_t *wheel) {
+	long elapsed = wheel->clock() - wheel->startMs;
+	return elapsed > 0 ? (uint64_t) elapsed : 0;
+}
+
+/**
+ * @brief Chaîne un timer en tête d'une liste.
+ * @internal
+ */
+static void link_timer(timer_wheel_timer_t **head, timer_wheel_timer_t *timer) {
+	timer->next = *head;
+	if(timer->next) timer->next->pprev = &timer->next;
+	*head = timer;
+	timer->pprev = head;
+}
+
+/**
+ * @brief Retire un timer de sa liste et met à jour le bitmap de sa case.
+ * @internal
+ */
+static void unlink_timer(timer_wheel_t *wheel, timer_wheel_timer_t *timer) {
+	*timer->pprev = timer->next;
+	if(timer->next) timer->next->pprev = timer->pprev;
+	timer->next = NULL;
+	timer->pprev = NULL;
+
+	if(timer->level >= 0 && !wheel->slots[timer->level][timer->slot]) {
+		wheel->occupied[timer->level] &= ~(1ULL << timer->slot);
+	}
+}
+
+/**
+ * @brief Place un timer dans la case correspondant à son échéance.
+ * @internal
+ */
+static void insert_timer(timer_wheel_t *wheel, timer_wheel_timer_t *timer) {
+	if(timer->expiresTick < wheel->currentTick) timer->expiresTick = wheel->currentTick;
+
+	uint64_t expires = timer->expiresTick;
+	uint64_t delta = expires - wheel->currentTick;
+	int level = 0;
+	while(level < TIMER_WHEEL_LEVELS - 1 && delta >= (1ULL << LEVEL_SHIFT(level + 1))) level++;
+
+	// Au-delà de la roue : placé dans la dernière case atteignable, il sera redistribué plus tard
+	if(delta >= WHEEL_SPAN) expires = wheel->currentTick + WHEEL_SPAN - 1;
+
+	int slot = (int) ((expires >> LEVEL_SHIFT(level)) & SLOT_MASK);
+	timer->level = level;
+	timer->slot = slot;
+	link_timer(&wheel->slots[level][slot], timer);
+	wheel->occupied[level] |= 1ULL << slot;
+}
+
+/**
+ * @brief Premier tick, à partir du prochain tick à traiter, où une case occupée expire ou est redistribuée.
+ * @internal
+ */
+static uint64_t next_event_tick(const timer_wheel_t *wheel) {
+	uint64_t best = NO_TICK;
+	for(int level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+		uint64_t occupied = wheel->occupied[level];
+		if(!occupied) continue;
+
+		// Indice de la première case du niveau atteinte à partir de currentTick
+		uint64_t unit = 1ULL << LEVEL_SHIFT(level);
+		uint64_t base = (wheel->currentTick + unit - 1) >> LEVEL_SHIFT(level);
+		int index = (int) (base & SLOT_MASK);
+		uint64_t rotated = index ? (occupied >> index) | (occupied << (TIMER_WHEEL_SLOTS - index)) : occupied;
+
+		uint64_t tick = (base + (uint64_t) __builtin_ctzll(rotated)) << LEVEL_SHIFT(level);
+		if(tick < best) best = tick;
+	}
+	return best;
+}
+
+/**
+ * @brief Redistribue les cases des niveaux supérieurs atteintes au tick courant.
+ * @internal
+ */
+static void cascade(timer_wheel_t *wheel, uint64_t tick) {
+	for(int level = 1; level < TIMER_WHEEL_LEVELS; level++) {
+		if(tick & ((1ULL << LEVEL_SHIFT(level)) - 1)) break;
+
+		int slot = (int) ((tick >> LEVEL_SHIFT(level)) & SLOT_MASK);
+		timer_wheel_timer_t *timer = wheel->slots[level][slot];
+		wheel->slots[level][slot] = NULL;
+		wheel->occupied[level] &= ~(1ULL << slot);
+
+		while(timer) {
+			timer_wheel_timer_t *next = timer->next;
+			insert_timer(wheel, timer);
+			timer = next;
+		}
+	}
+}
+
+/**
+ * @brief Signale au thread ou à la boucle qu'un timer expire avant leur prochain réveil.
+ * @internal
+ */
+static void notify_earlier(timer_wheel_t *wheel, uint64_t expiresTick) {
+	if(expiresTick >= wheel->armedTick) return;
+
+	if(wheel->threadRunning) pthread_cond_signal(&wheel->changed);
+	else if(wheel->loop && !event_loop_in_loop_thread(wheel->loop)) event_loop_wake(wheel->loop);
+}
+
+/**
+ * @brief Traite les ticks écoulés (verrou tenu, relâché pendant les callbacks).
+ * @details Les ticks sans échéance sont sautés. Les périodes manquées d'un timer périodique
+ * (roue en retard) ne sont pas rattrapées.
+ * @internal
+ */
+static int advance_locked(timer_wheel_t *wheel) {
+	uint64_t target = elapsed_ms(wheel) / (uint64_t) wheel->tickMs;
+	int fired = 0;
+
+	while(wheel->currentTick <= target) {
+		uint64_t tick = next_event_tick(wheel);
+		if(tick > target) {
+			wheel->currentTick = target + 1;
+			break;
+		}
+
+		wheel->currentTick = tick;
+		cascade(wheel, tick);
+
+		// La case est détachée : les timers reprogrammés par les callbacks ne peuvent pas y revenir
+		int slot = (int) (tick & SLOT_MASK);
+		wheel->expiring = wheel->slots[0][slot];
+		if(wheel->expiring) wheel->expiring->pprev = &wheel->expiring;
+		wheel->slots[0][slot] = NULL;
+		wheel->occupied[0] &= ~(1ULL << slot);
+		for(timer_wheel_timer_t *timer = wheel->expiring; timer; timer = timer->next) timer->level = -1;
+		wheel->currentTick = tick + 1;
+
+		timer_wheel_timer_t *timer;
+		while((timer = wheel->expiring) != NULL) {
+			unlink_timer(wheel, timer);
+			timer->pending = false;
+			wheel->pendingCount--;
+
+			if(timer->intervalTicks > 0) {
+				timer->expiresTick = tick + timer->intervalTicks;
+				if(timer->expiresTick <= target) timer->expiresTick = target + 1;
+				insert_timer(wheel, timer);
+				timer->pending = true;
+				wheel->pendingCount++;
+			}
+
+			timer_wheel_callback_t callback = timer->callback;
+			void *context = timer->context;
+			pthread_mutex_unlock(&wheel->lock);
+			callback(timer, context);
+			pthread_mutex_lock(&wheel->lock);
+			fired++;
+		}
+	}
+	return fired;
+}
+
+/**
+ * @brief Délai en millisecondes jusqu'à un tick (0 s'il est atteint).
+ * @internal
+ */
+static int timeout_until(const timer_wheel_t *wheel, uint64_t tick) {
+	uint64_t dueMs = tick * (uint64_t) wheel->tickMs;
+	uint64_t nowMs = elapsed_ms(wheel);
+	if(dueMs <= nowMs) return 0;
+	return dueMs - nowMs > INT32_MAX ? INT32_MAX : (int) (dueMs - nowMs);
+}
+
+/**
+ * @brief Thread dédié : avance la roue puis dort jusqu'à la prochaine échéance.
+ * @internal
+ */
+static void *wheel_thread(void *arg) {
+	timer_wheel_t *wheel = (timer_wheel_t *) arg;
+
+	pthread_mutex_lock(&wheel->lock);
+	while(!wheel->stopping) {
+		advance_locked(wheel);
+		if(wheel->stopping) break;
+
+		uint64_t next = next_event_tick(wheel);
+		wheel->armedTick = next;
+		if(next == NO_TICK) {
+			pthread_cond_wait(&wheel->changed, &wheel->lock);
+		} else {
+			int timeoutMs = timeout_until(wheel, next);
+			struct timespec deadline;
+			clock_gettime(CLOCK_MONOTONIC, &deadline);
+			deadline.tv_sec += timeoutMs / 1000;
+			deadline.tv_nsec += (timeoutMs % 1000) * 1000000L;
+			if(deadline.tv_nsec >= 1000000000L) {
+				deadline.tv_sec++;
+				deadline.tv_nsec -= 1000000000L;
+			}
+			pthread_cond_timedwait(&wheel->changed, &wheel->lock, &deadline);
+		}
+		wheel->armedTick = NO_TICK;
+	}
+	pthread_mutex_unlock(&wheel->lock);
+	return NULL;
+}
+
+/**
+ * @brief Boucle d'événements : arme le timerfd sur la prochaine échéance avant chaque attente.
+ * @internal
+ */
+static void prepare_loop_timer(event_loop_t *loop, void *context) {
+	UNUSED(loop);
+	timer_wheel_t *wheel = (timer_wheel_t *) context;
+
+	pthread_mutex_lock(&wheel->lock);
+	uint64_t next = next_event_tick(wheel);
+	if(next != wheel->armedTick) {
+		wheel->armedTick = next;
+		if(next == NO_TICK) {
+			event_loop_timer_set(wheel->loopTimer, 0, 0);
+		} else {
+			int timeoutMs = timeout_until(wheel, next);
+			event_loop_timer_set(wheel->loopTimer, timeoutMs > 0 ? timeoutMs : 1, 0);
+		}
+	}
+	pthread_mutex_unlock(&wheel->lock);
+}
+
+/**
+ * @brief Boucle d'événements : expiration du timerfd.
+ * @internal
+ */
+static void on_loop_timer(event_loop_t *loop, event_loop_timer_t *timer, void *context) {
+	UNUSED(loop); UNUSED(timer);
+	timer_wheel_t *wheel = (timer_wheel_t *) context;
+
+	pthread_mutex_lock(&wheel->lock);
+	advance_locked(wheel);
+	wheel->armedTick = NO_TICK; // Réarmé par prepare_loop_timer()
+	pthread_mutex_unlock(&wheel->lock);
+}
+
+/**
+ * @brief Initialise une roue.
+ * @param wheel La roue
+ * @param tickMs Résolution en millisecondes (0 : TIMER_WHEEL_DEFAULT_TICK_MS)
+ * @param clock Horloge en millisecondes (NULL : timer_wheel_now_ms())
+ * @return 0 en cas de succès, -1 en cas d'erreur
+ */
+int timer_wheel_init(timer_wheel_t *wheel, int tickMs, timer_wheel_clock_t clock) {
+	if(!wheel || tickMs < 0) return -1;
+
+	memset(wheel, 0, sizeof(*wheel));
+	wheel->tickMs = tickMs > 0 ? tickMs : TIMER_WHEEL_DEFAULT_TICK_MS;
+	wheel->clock = clock ? clock : timer_wheel_now_ms;
+	wheel->startMs = wheel->clock();
+	wheel->armedTick = NO_TICK;
+
+	pthread_condattr_t attr;
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	int result = pthread_cond_init(&wheel->changed, &attr);
+	pthread_condattr_destroy(&attr);
+	if(result != 0) return -1;
+
+	if(pthread_mutex_init(&wheel->lock, NULL) != 0) {
+		pthread_cond_destroy(&wheel->changed);
+		return -1;
+	}
+	return 0;
+}
+
+/**
+ * @brief Arrête le thread ou détache la roue de sa boucle, puis libère ses ressources.
+ * @details Les timers en attente sont abandonnés sans être appelés.
+ * @param wheel La roue (NULL accepté)
+ */
+void timer_wheel_destroy(timer_wheel_t *wheel) {
+	if(!wheel) return;
+
+	if(wheel->threadRunning) {
+		pthread_mutex_lock(&wheel->lock);
+		wheel->stopping = true;
+		pthread_cond_signal(&wheel->changed);
+		pthread_mutex_unlock(&wheel->lock);
+		pthread_join(wheel->thread, NULL);
+		wheel->threadRunning = false;
+	}
+	if(wheel->loop) {
+		event_loop_remove_prepare(wheel->loop, prepare_loop_timer, wheel);
+		event_loop_cancel_timer(wheel->loop, wheel->loopTimer);
+		wheel->loopTimer = NULL;
+		wheel->loop = NULL;
+	}
+
+	pthread_mutex_destroy(&wheel->lock);
+	pthread_cond_destroy(&wheel->changed);
+}
+
+/**
+ * @brief Fait avancer la roue dans une boucle d'événements (un seul timerfd, réarmé à la prochaine échéance).
+ * @details Les callbacks sont appelés dans le thread de la boucle.
+ * @param wheel La roue
+ * @param loop La boucle
+ * @return 0 en cas de succès, -1 en cas d'erreur (roue déjà démarrée, ...)
+ */
+int timer_wheel_attach(timer_wheel_t *wheel, event_loop_t *loop) {
+	if(!wheel || !loop || wheel->loop || wheel->threadRunning) return -1;
+
+	wheel->loopTimer = event_loop_add_timer(loop, 0, 0, on_loop_timer, wheel);
+	if(!wheel->loopTimer) return -1;
+	if(event_loop_add_prepare(loop, prepare_loop_timer, wheel) != 0) {
+		event_loop_cancel_timer(loop, wheel->loopTimer);
+		wheel->loopTimer = NULL;
+		return -1;
+	}
+
+	pthread_mutex_lock(&wheel->lock);
+	wheel->loop = loop;
+	wheel->armedTick = NO_TICK;
+	pthread_mutex_unlock(&wheel->lock);
+	return 0;
+}
+
+/**
+ * @brief Fait avancer la roue dans un thread dédié, endormi jusqu'à la prochaine échéance.
+ * @param wheel La roue
+ * @return 0 en cas de succès, -1 en cas d'erreur (roue déjà démarrée, ...)
+ */
+int timer_wheel_start_thread(timer_wheel_t *wheel) {
+	if(!wheel || wheel->loop || wheel->threadRunning) return -1;
+
+	wheel->stopping = false;
+	if(pthread_create(&wheel->thread, NULL, wheel_thread, wheel) != 0) return -1;
+	wheel->threadRunning = true;
+	return 0;
+}
+
+/**
+ * @brief Initialise un timer.
+ * @param timer Le timer
+ * @param callback Fonction appelée à l'expiration
+ * @param context Contexte transmis au callback
+ */
+void timer_wheel_timer_init(timer_wheel_timer_t *timer, timer_wheel_callback_t callback, void *context) {
+	if(!timer) return;
+
+	memset(timer, 0, sizeof(*timer));
+	timer->callback = callback;
+	timer->context = context;
+}
+
+/**
+ * @brief Programme (ou reprogramme) un timer, en O(1).
+ * @param wheel La roue
+ * @param timer Le timer, initialisé avec timer_wheel_timer_init()
+ * @param delayMs Délai avant la première expiration
+ * @param intervalMs Période des expirations suivantes (0 : ponctuel)
+ * @return 0 en cas de succès, -1 en cas de paramètres invalides
+ */
+int timer_wheel_schedule(timer_wheel_t *wheel, timer_wheel_timer_t *timer, int delayMs, int intervalMs) {
+	if(!wheel || !timer || !timer->callback || delayMs < 0 || intervalMs < 0) return -1;
+
+	uint64_t tickMs = (uint64_t) wheel->tickMs;
+	pthread_mutex_lock(&wheel->lock);
+	if(timer->pending) {
+		unlink_timer(wheel, timer);
+		wheel->pendingCount--;
+	}
+
+	// Arrondi au tick supérieur : le timer n'expire jamais avant son délai
+	timer->expiresTick = (elapsed_ms(wheel) + (uint64_t) delayMs + tickMs - 1) / tickMs;
+	timer->intervalTicks = intervalMs > 0 ? ((uint64_t) intervalMs + tickMs - 1) / tickMs : 0;
+	insert_timer(wheel, timer);
+	timer->pending = true;
+	wheel->pendingCount++;
+
+	notify_earlier(wheel, timer->expiresTick);
+	pthread_mutex_unlock(&wheel->lock);
+	return 0;
+}
+
+/**
+ * @brief Annule un timer, en O(1).
+ * @param wheel La roue
+ * @param timer Le timer (NULL accepté)
+ * @return true si le timer était en attente
+ */
+bool timer_wheel_cancel(timer_wheel_t *wheel, timer_wheel_timer_t *timer) {
+	if(!wheel || !timer) return false;
+
+	pthread_mutex_lock(&wheel->lock);
+	bool wasPending = timer->pending;
+	if(wasPending) {
+		unlink_timer(wheel, timer);
+		timer->pending = false;
+		wheel->pendingCount--;
+	}
+	pthread_mutex_unlock(&wheel->lock);
+	return wasPending;
+}
+
+/**
+ * @brief Indique si un timer est en attente d'expiration.
+ */
+bool timer_wheel_is_pending(timer_wheel_t *wheel, const timer_wheel_timer_t *timer) {
+	if(!wheel || !timer) return false;
+
+	pthread_mutex_lock(&wheel->lock);
+	bool pending = timer->pending;
+	pthread_mutex_unlock(&wheel->lock);
+	return pending;
+}
+
+/**
+ * @brief Traite les ticks écoulés selon l'horloge de la roue et appelle les callbacks expirés.
+ * @param wheel La roue
+ * @return Le nombre de callbacks appelés
+ */
+int timer_wheel_advance(timer_wheel_t *wheel) {
+	if(!wheel) return 0;
+
+	pthread_mutex_lock(&wheel->lock);
+	int fired = advance_locked(wheel);
+	pthread_mutex_unlock(&wheel->lock);
+	return fired;
+}
+
+/**
+ * @brief Délai avant la prochaine échéance de la roue (expiration ou redistribution d'une case).
+ * @param wheel La roue
+ * @return Délai en millisecondes, ou -1 si aucun timer n'est en attente
+ */
+int timer_wheel_next_timeout(timer_wheel_t *wheel) {
+	if(!wheel) return -1;
+
+	pthread_mutex_lock(&wheel->lock);
+	uint64_t next = next_event_tick(wheel);
+	int timeoutMs = next == NO_TICK ? -1 : timeout_until(wheel, next);
+	pthread_mutex_unlock(&wheel->lock);
+	return timeoutMs;
+}
+
+/**
+ * @brief Retourne le nombre de timers en attente.
+ */
+size_t timer_wheel_pending_count(timer_wheel_t *wheel) {
+	if(!wheel) return 0;
+
+	pthread_mutex_lock(&wheel->lock);
+	size_t count = wheel->pendingCount;
+	pthread_mutex_unlock(&wheel->lock);
+	return count;
+}
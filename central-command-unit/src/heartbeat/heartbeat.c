@@ -21,12 +21,15 @@ int main(int argc, char **argv) {
 	}
 	LOG_INFO_ASYNC("Heartbeat Service started successfully.");
 
+	if(heartbeat_register_routes(core_get_router()) != 0) {
+		LOG_FATAL_SYNC("Failed to register MQTT routes. Exiting.");
+		core_shutdown();
+		return EXIT_FAILURE;
+	}
 	mqtt_subscribe("services/+/status", MQTT_QOS_AT_LEAST_ONCE);
+	mqtt_subscribe("services/route-planner/+/status", MQTT_QOS_AT_LEAST_ONCE); // Une instance par status
 	mqtt_subscribe("vehicles/+/status", MQTT_QOS_AT_LEAST_ONCE);
 	
-	mqtt_set_message_callback(heartbeat_message_callback);
-
-	
 	signal_wait_for_shutdown();
 
 	LOG_INFO_ASYNC("Shutdown signal received. Stopping Heartbeat Service...");
@@ -8,8 +8,6 @@
 
 #include "heartbeat/heartbeat_message_callback.h"
 
-#define MATCH_SERVICE(topic, service) (strncmp(topic, "services/", 9) == 0 && strstr(topic, "/status") != NULL && strstr(topic, service) != NULL)
-
 static int extract_car_id_int(const char *topic, int *carId, const char *prefix) {
     const char *start = strstr(topic, prefix);
     if (!start) return -1;
@@ -30,102 +28,188 @@ static int extract_car_id_int(const char *topic, int *carId, const char *prefix)
 }
 
 /**
- * @brief Callback pour les messages de heartbeat reçus.
- * @param topic Topic MQTT du message reçu.
- * @param payload Payload du message reçu.
+ * @brief Indique si un message de status annonce un service ou un véhicule hors ligne.
  */
-void heartbeat_message_callback(const char* topic, const char* payload) {
-	if(!strstr(payload, "offline")) {
+static bool is_offline(const void* payload, size_t length) {
+	return memmem(payload, length, "offline", strlen("offline")) != NULL;
+}
+
+static void on_vehicle_status(const char* topic, const void* payload, size_t length, void* context) {
+	UNUSED(context);
+	if(!is_offline(payload, length)) {
 		return;
 	}
 
-	if(strncmp(topic, "vehicles/", 9) == 0 && strstr(topic, "/status") != NULL) {
-		int carId;
-		if(extract_car_id_int(topic, &carId, "vehicles/") != 0) {
-			LOG_WARNING_ASYNC("Failed to extract carId from topic: %s", topic);
-			return;
-		}
-		LOG_WARNING_ASYNC("Vehicle ID %d is down.", carId);
+	int carId;
+	if(extract_car_id_int(topic, &carId, "vehicles/") != 0) {
+		LOG_WARNING_ASYNC("Failed to extract carId from topic: %s", topic);
+		return;
+	}
+	LOG_WARNING_ASYNC("Vehicle ID %d is down.", carId);
 
-		cancel_vehicle_route_request_t cancelRequest = {
-			.header = create_command_header(ACTION_CANCEL_VEHICLE_ROUTE, HEARTBEAT_REPLY_TOPIC),
-			.carId = carId
-		};
-		char *jsonPayload = cancel_vehicle_route_request_serialize(&cancelRequest);
+	cancel_vehicle_route_request_t cancelRequest = {
+		.header = create_command_header(ACTION_CANCEL_VEHICLE_ROUTE, HEARTBEAT_REPLY_TOPIC),
+		.carId = carId
+	};
+	char *jsonPayload = cancel_vehicle_route_request_serialize(&cancelRequest);
 
-		if(!jsonPayload) {
-			LOG_ERROR_ASYNC("Unable to serialize CANCEL_VEHICLE_ROUTE_REQUEST for vehicle ID %d", carId);
-			return;
-		}
-		
-		mqtt_publish("services/route-planner/request", jsonPayload, MQTT_QOS_AT_MOST_ONCE, false);
-		LOG_INFO_ASYNC("Sent CANCEL_VEHICLE_ROUTE_REQUEST for vehicle ID %d to route-planner.", carId);
-		free(jsonPayload);
-
-		revoke_vehicle_access_t revokeAccess = {
-			.header = create_command_header(ACTION_REVOKE_VEHICLE_ACCESS, HEARTBEAT_REPLY_TOPIC),
-			.carId = carId
-		};
-		jsonPayload = revoke_vehicle_access_serialize_json(&revokeAccess);
-
-		if(!jsonPayload) {
-			LOG_ERROR_ASYNC("Unable to serialize REVOKE_VEHICLE_ACCESS for vehicle ID %d", carId);
+	if(!jsonPayload) {
+		LOG_ERROR_ASYNC("Unable to serialize CANCEL_VEHICLE_ROUTE_REQUEST for vehicle ID %d", carId);
+		return;
+	}
+	
+	mqtt_publish_command("services/route-planner/request", &cancelRequest.header, jsonPayload, MQTT_QOS_AT_MOST_ONCE);
+	LOG_INFO_ASYNC("Sent CANCEL_VEHICLE_ROUTE_REQUEST for vehicle ID %d to route-planner.", carId);
+	free(jsonPayload);
+
+	revoke_vehicle_access_t revokeAccess = {
+		.header = create_command_header(ACTION_REVOKE_VEHICLE_ACCESS, HEARTBEAT_REPLY_TOPIC),
+		.carId = carId
+	};
+	jsonPayload = revoke_vehicle_access_serialize_json(&revokeAccess);
+
+	if(!jsonPayload) {
+		LOG_ERROR_ASYNC("Unable to serialize REVOKE_VEHICLE_ACCESS for vehicle ID %d", carId);
+		return;
+	}
+
+	mqtt_publish_command("services/conflict-manager/request", &revokeAccess.header, jsonPayload, MQTT_QOS_AT_MOST_ONCE);
+	LOG_INFO_ASYNC("Sent REVOKE_VEHICLE_ACCESS for vehicle ID %d to conflict-manager.", carId);
+	free(jsonPayload);
+}
+
+static void on_route_planner_status(const char* topic, const void* payload, size_t length, void* context) {
+	UNUSED(topic);
+	UNUSED(context);
+	if(!is_offline(payload, length)) {
+		return;
+	}
+
+	LOG_WARNING_ASYNC("Route Planner service is down.");
+	// Réfléchir pour une future version un traitement plus avancé
+}
+
+/**
+ * @brief Instances du route planner connues (status par instance), mises à jour par le seul
+ * thread de réception MQTT.
+ * @internal
+ */
+static struct {
+	char name[32];
+	bool online;
+} routePlannerReplicas[HEARTBEAT_MAX_ROUTE_PLANNER_REPLICAS];
+static size_t routePlannerReplicaCount = 0;
+
+static void on_route_planner_replica_status(const char* topic, const void* payload, size_t length, void* context) {
+	UNUSED(context);
+	const char *name = topic + strlen("services/route-planner/");
+	size_t nameLength = strcspn(name, "/");
+	bool online = !is_offline(payload, length);
+
+	size_t index = 0;
+	while(index < routePlannerReplicaCount
+		&& (strlen(routePlannerReplicas[index].name) != nameLength || strncmp(routePlannerReplicas[index].name, name, nameLength) != 0)) {
+		index++;
+	}
+	if(index == routePlannerReplicaCount) {
+		if(index == HEARTBEAT_MAX_ROUTE_PLANNER_REPLICAS || nameLength >= sizeof(routePlannerReplicas[index].name)) {
+			LOG_WARNING_ASYNC("Untracked route-planner replica status: %s", topic);
 			return;
 		}
+		memcpy(routePlannerReplicas[index].name, name, nameLength);
+		routePlannerReplicas[index].name[nameLength] = '\0';
+		routePlannerReplicaCount++;
+	}
+	routePlannerReplicas[index].online = online;
+
+	size_t onlineCount = 0;
+	for(size_t i = 0; i < routePlannerReplicaCount; i++) {
+		if(routePlannerReplicas[i].online) onlineCount++;
+	}
 
-		mqtt_publish("services/conflict-manager/request", jsonPayload, MQTT_QOS_AT_MOST_ONCE, false);
-		LOG_INFO_ASYNC("Sent REVOKE_VEHICLE_ACCESS for vehicle ID %d to conflict-manager.", carId);
-		free(jsonPayload);
+	if(online) {
+		LOG_INFO_ASYNC("Route Planner replica '%s' is up (%zu/%zu online).", routePlannerReplicas[index].name, onlineCount, routePlannerReplicaCount);
 		return;
 	}
+	LOG_WARNING_ASYNC("Route Planner replica '%s' is down (%zu/%zu online).", routePlannerReplicas[index].name, onlineCount, routePlannerReplicaCount);
+	if(onlineCount == 0) {
+		LOG_WARNING_ASYNC("Route Planner service is down: no replica left.");
+	}
+}
 
-	if(MATCH_SERVICE(topic, "route-planner")) {
-		LOG_WARNING_ASYNC("Route Planner service is down.");
-		// Réfléchir pour une future version un traitement plus avancé :
+static void on_conflict_manager_status(const char* topic, const void* payload, size_t length, void* context) {
+	UNUSED(topic);
+	UNUSED(context);
+	if(!is_offline(payload, length)) {
 		return;
+	}
 
-	} 
+	LOG_WARNING_ASYNC("Conflict Manager service is down.");
 
-	if(MATCH_SERVICE(topic, "conflict-manager")) {
-		LOG_WARNING_ASYNC("Conflict Manager service is down.");
+	// Prévenir le route planner pour qu'il planifie des routes "safe" sans zone de conflit
+	set_safe_route_mode_request_t safeRouteModeRequest = {
+		.header = create_command_header(ACTION_SET_SAFE_ROUTE_MODE, HEARTBEAT_REPLY_TOPIC),
+		.enabled = true
+	};
+	char *jsonPayload = set_safe_route_mode_request_serialize(&safeRouteModeRequest);
 
-		// Prévenir le route planner pour qu'il planifie des routes "safe" sans zone de conflit
-		set_safe_route_mode_request_t safeRouteModeRequest = {
-			.header = create_command_header(ACTION_SET_SAFE_ROUTE_MODE, HEARTBEAT_REPLY_TOPIC),
-			.enabled = true
-		};
-		char *jsonPayload = set_safe_route_mode_request_serialize(&safeRouteModeRequest);
+	if(!jsonPayload) {
+		LOG_ERROR_ASYNC("Unable to serialize SET_SAFE_ROUTE_MODE");
+		return;
+	}
 
-		if(!jsonPayload) {
-			LOG_ERROR_ASYNC("Unable to serialize SET_SAFE_ROUTE_MODE");
-			return;
-		}
+	mqtt_publish_command(HEARTBEAT_ROUTE_PLANNER_BROADCAST_TOPIC, &safeRouteModeRequest.header, jsonPayload, MQTT_QOS_AT_MOST_ONCE);
+	LOG_INFO_ASYNC("Sent SET_SAFE_ROUTE_MODE to all route-planner instances.");
+	free(jsonPayload);
+}
+
+static void on_railway_sync_status(const char* topic, const void* payload, size_t length, void* context) {
+	UNUSED(topic);
+	UNUSED(context);
+	if(!is_offline(payload, length)) {
+		return;
+	}
 
-		mqtt_publish("services/route-planner/request", jsonPayload, MQTT_QOS_AT_MOST_ONCE, false);
-		LOG_INFO_ASYNC("Sent SET_SAFE_ROUTE_MODE to route-planner.");
-		free(jsonPayload);
+	LOG_WARNING_ASYNC("Railway synchronizer service is down.");
 
+	// Prévenir le route-planner pour qu'il désactive le mode ferroviaire si nécessaire
+	set_railway_mode_request_t railwayModeRequest = {
+		.header = create_command_header(ACTION_SET_RAILWAY_MODE, HEARTBEAT_REPLY_TOPIC),
+		.enabled = false
+	};
+	char *jsonPayload = set_railway_mode_request_serialize(&railwayModeRequest);
+	if(!jsonPayload) {
+		LOG_ERROR_ASYNC("Unable to serialize SET_RAILWAY_MODE");
 		return;
 	}
 
-	if(MATCH_SERVICE(topic, "railway-sync")) {
-		LOG_WARNING_ASYNC("Railway synchronizer service is down.");
-
-		// Prévenir le route-planner pour qu'il désactive le mode ferroviaire si nécessaire
-		set_railway_mode_request_t railwayModeRequest = {
-			.header = create_command_header(ACTION_SET_RAILWAY_MODE, HEARTBEAT_REPLY_TOPIC),
-			.enabled = false
-		};
-		char *jsonPayload = set_railway_mode_request_serialize(&railwayModeRequest);
-		if(!jsonPayload) {
-			LOG_ERROR_ASYNC("Unable to serialize SET_RAILWAY_MODE");
-			return;
-		}
+	mqtt_publish_command(HEARTBEAT_ROUTE_PLANNER_BROADCAST_TOPIC, &railwayModeRequest.header, jsonPayload, MQTT_QOS_AT_MOST_ONCE);
+	LOG_INFO_ASYNC("Sent SET_RAILWAY_MODE to all route-planner instances.");
+	free(jsonPayload);
+}
 
-		mqtt_publish("services/route-planner/request", jsonPayload, MQTT_QOS_AT_MOST_ONCE, false);
-		LOG_INFO_ASYNC("Sent SET_RAILWAY_MODE to route-planner.");
-		free(jsonPayload);
+static void on_unknown_status(const char* topic, const void* payload, size_t length, void* context) {
+	UNUSED(context);
+	if(!is_offline(payload, length)) {
 		return;
 	}
 	LOG_WARNING_ASYNC("Received heartbeat message for unknown topic: %s", topic);
 }
+
+/**
+ * @brief Enregistre les routes MQTT du heartbeat.
+ * @details Chaque topic de status surveillé a son handler ; les autres messages reçus sont
+ * signalés par le handler par défaut.
+ * @param router Le routeur du service
+ * @return 0 en cas de succès, -1 en cas d'erreur
+ */
+int heartbeat_register_routes(mqtt_router_t* router) {
+	int result = 0;
+	result |= mqtt_router_add_topic(router, "vehicles/+/status", on_vehicle_status, NULL);
+	result |= mqtt_router_add_topic(router, "services/route-planner/status", on_route_planner_status, NULL);
+	result |= mqtt_router_add_topic(router, "services/route-planner/+/status", on_route_planner_replica_status, NULL);
+	result |= mqtt_router_add_topic(router, "services/conflict-manager/status", on_conflict_manager_status, NULL);
+	result |= mqtt_router_add_topic(router, "services/railway-sync/status", on_railway_sync_status, NULL);
+	mqtt_router_set_default(router, on_unknown_status, NULL);
+	return result ? -1 : 0;
+}
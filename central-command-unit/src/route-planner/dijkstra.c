@@ -9,44 +9,144 @@
 
 
 /**
- * @brief Reconstruit le chemin (une fois la destination atteinte).
- * @details Remonte la chaîne des 'parent' depuis la fin.
+ * @brief Prépare un espace de travail pour une nouvelle recherche sur un graphe.
+ * @details Agrandit le tableau si le graphe a grossi, passe à la génération suivante
+ * et vide la file de priorité.
+ * @return 0 en cas de succès, -1 en cas d'erreur d'allocation.
  * @internal
  */
-static path_t reconstruct_path(node_t* endNode, dijkstra_node_t* data) {
-    path_t path = { .nodes = NULL, .length = 0 };
-    node_t* current = endNode;
-    int count = 0;
-
-    while (current) {
-        count++;
-        current = data[current->id].previous;
-    }
+static int workspace_prepare(dijkstra_workspace_t *ws, graph_t *graph) {
+	if(ws->capacity < graph->numNodes || ws->data == NULL) {
+		int capacity = graph->numNodes > 0 ? graph->numNodes : 1;
+		dijkstra_node_t *data = (dijkstra_node_t *) calloc(capacity, sizeof(dijkstra_node_t));
+		if(data == NULL) {
+			return -1;
+		}
+		free(ws->data);
+		ws->data = data;
+		ws->capacity = capacity;
+		ws->generation = 0;
+	}
 
-	// Aucun chemin trouvé
-    if (count == 0) {
-        return path;
-    }
+	if(ws->pq == NULL) {
+		ws->pq = pq_create(graph->numNodes > 0 ? graph->numNodes : 1);
+		if(ws->pq == NULL) {
+			return -1;
+		}
+	}
+	pq_clear(ws->pq);
 
-    // 2. Allouer le tableau de pointeurs de noeuds
-    path.nodes = (node_t**)malloc(sizeof(node_t*) * count);
-	if (path.nodes == NULL) {
-		return ERROR_PATH;
+	// Rebouclage du compteur : les anciennes générations pourraient redevenir valides
+	if(++ws->generation == 0) {
+		for(int i = 0; i < ws->capacity; i++) {
+			ws->data[i].generation = 0;
+		}
+		ws->generation = 1;
+	}
+	return 0;
+}
+
+/**
+ * @brief Libère les ressources de recherche d'un espace de travail (hors arène).
+ * @internal
+ */
+static void workspace_release(dijkstra_workspace_t *ws) {
+	pq_destroy(ws->pq);
+	free(ws->data);
+	ws->pq = NULL;
+	ws->data = NULL;
+	ws->capacity = 0;
+}
+
+/**
+ * @brief Retourne les données d'un noeud pour la recherche en cours (initialisées au premier accès).
+ * @internal
+ */
+static inline dijkstra_node_t *node_data(dijkstra_workspace_t *ws, const node_t *node) {
+	dijkstra_node_t *entry = &ws->data[node->index];
+	if(entry->generation != ws->generation) {
+		entry->generation = ws->generation;
+		entry->gCost = DIJKSTRA_INFINITY;
+		entry->previous = NULL;
+		entry->visited = false;
 	}
+	return entry;
+}
 
-    path.length = count;
-    current = endNode;
-    for (int i = count - 1; i >= 0; i--) {
-        path.nodes[i] = current;
-        current = data[current->id].previous;
+/**
+ * @brief Reconstruit le chemin (une fois la destination atteinte).
+ * @details Remonte une seule fois la chaîne des 'parent' depuis la fin,
+ * puis inverse le chemin en place.
+ * @internal
+ */
+static path_t reconstruct_path(node_t* endNode, dijkstra_workspace_t* ws, arena_t* arena) {
+    path_t path = EMPTY_PATH_IN(arena);
+
+    for (node_t* current = endNode; current; current = ws->data[current->index].previous) {
+        if (!path_push(&path, current)) {
+            path_destroy(&path);
+            return ERROR_PATH;
+        }
     }
-    
+
+    path_reverse(&path);
     return path;
 }
 
+/**
+ * @brief Explore le graphe depuis start jusqu'à atteindre 'end' ou toutes les cibles marquées.
+ * @param isTarget Marqueurs de cibles (indexés par node->index), ou NULL pour une seule cible 'end'
+ * @param remaining Nombre de cibles distinctes restant à atteindre (avec isTarget)
+ * @return true si la cible 'end' a été atteinte (recherche point à point)
+ * @internal
+ */
+static bool run_search(dijkstra_workspace_t *ws, node_t *start, node_t *end, const bool *isTarget, int remaining, dijkstra_stats_t *stats) {
+	node_data(ws, start)->gCost = 0.0;
+	pq_push(ws->pq, start, 0);
+	stats->queuePushes++;
+
+	while(!pq_is_empty(ws->pq)) {
+		node_t *current = (node_t *) pq_pop(ws->pq);
+		dijkstra_node_t *currentData = node_data(ws, current);
+
+		if(currentData->visited) {
+			continue;
+		}
+		currentData->visited = true;
+		stats->settledNodes++;
+
+		if(isTarget == NULL && current == end) {
+			return true;
+		}
+		if(isTarget != NULL && isTarget[current->index] && --remaining == 0) {
+			return false;
+		}
+
+		edge_t *edge = current->edges;
+		while(edge != NULL) {
+			node_t *neighbor = edge->targetNode;
+			dijkstra_node_t *neighborData = node_data(ws, neighbor);
+
+			if(!neighborData->visited) {
+				double newCost = currentData->gCost + edge->weight;
+
+				if(newCost < neighborData->gCost) {
+					neighborData->gCost = newCost;
+					neighborData->previous = current;
+					pq_push(ws->pq, neighbor, (int)newCost);
+					stats->relaxedEdges++;
+					stats->queuePushes++;
+				}
+			}
+			edge = edge->nextEdge;
+		}
+	}
+	return false;
+}
+
  /**
  * @brief Calcule le plus court chemin entre deux noeud dans un graphe pondéré orienté
- * 
+ *
  * @param graph Le graphe pondéré orienté
  * @param start Le noeud de départ
  * @param end Le noeud d'arrivée
@@ -56,60 +156,173 @@ static path_t reconstruct_path(node_t* endNode, dijkstra_node_t* data) {
  * @see path_destroy()
  */
 path_t dijkstra_find_path(graph_t *graph, node_t *start, node_t *end) {
-	if(graph == NULL || start == NULL || end == NULL) {
-		return ERROR_PATH;
+	return dijkstra_find_path_ex(graph, start, end, NULL, NULL);
+}
+
+/**
+ * @brief Variante de dijkstra_find_path() avec arène et compteurs d'exploration.
+ * @param graph Le graphe pondéré orienté
+ * @param start Le noeud de départ
+ * @param end Le noeud d'arrivée
+ * @param arena Arène dans laquelle allouer le chemin (NULL : tas, à libérer avec path_destroy())
+ * @param stats Compteurs remis à zéro puis renseignés (peut être NULL)
+ * @return Voir dijkstra_find_path()
+ */
+path_t dijkstra_find_path_ex(graph_t *graph, node_t *start, node_t *end, arena_t *arena, dijkstra_stats_t *stats) {
+	dijkstra_workspace_t ws = {0};
+	path_t path = dijkstra_find_path_ws(&ws, graph, start, end, arena, stats);
+	workspace_release(&ws);
+	return path;
+}
+
+/**
+ * @brief Crée un espace de travail réutilisable.
+ * @param numNodes Nombre de noeuds anticipé (l'espace s'agrandit si nécessaire)
+ * @param withArena Crée aussi une arène à disposition de l'appelant (ws->arena)
+ * @return L'espace de travail, ou NULL en cas d'erreur
+ * @warning Doit être libéré avec dijkstra_workspace_destroy()
+ */
+dijkstra_workspace_t *dijkstra_workspace_create(int numNodes, bool withArena) {
+	dijkstra_workspace_t *ws = (dijkstra_workspace_t *) calloc(1, sizeof(dijkstra_workspace_t));
+	if(ws == NULL) {
+		return NULL;
 	}
 
-	dijkstra_node_t *data = (dijkstra_node_t *) calloc(graph->numNodes, sizeof(dijkstra_node_t));
-	if(data == NULL) {
+	graph_t sizing = { .nodes = NULL, .numNodes = numNodes, .arena = NULL };
+	if(workspace_prepare(ws, &sizing) != 0) {
+		dijkstra_workspace_destroy(ws);
+		return NULL;
+	}
+
+	if(withArena) {
+		ws->arena = arena_create(0);
+		if(ws->arena == NULL) {
+			dijkstra_workspace_destroy(ws);
+			return NULL;
+		}
+	}
+	return ws;
+}
+
+/**
+ * @brief Libère un espace de travail.
+ * @param ws L'espace de travail (NULL accepté)
+ */
+void dijkstra_workspace_destroy(dijkstra_workspace_t *ws) {
+	if(ws == NULL) {
+		return;
+	}
+	workspace_release(ws);
+	arena_destroy(ws->arena);
+	free(ws);
+}
+
+/**
+ * @brief Variante de dijkstra_find_path_ex() sans allocation de travail.
+ * @param ws L'espace de travail (propre au thread appelant)
+ * @param graph Le graphe pondéré orienté
+ * @param start Le noeud de départ
+ * @param end Le noeud d'arrivée
+ * @param arena Arène dans laquelle allouer le chemin (NULL : tas, à libérer avec path_destroy())
+ * @param stats Compteurs remis à zéro puis renseignés (peut être NULL)
+ * @return Voir dijkstra_find_path()
+ */
+path_t dijkstra_find_path_ws(dijkstra_workspace_t *ws, graph_t *graph, node_t *start, node_t *end, arena_t *arena, dijkstra_stats_t *stats) {
+	dijkstra_stats_t localStats = {0};
+	if(stats == NULL) {
+		stats = &localStats;
+	}
+	*stats = (dijkstra_stats_t) { .pathCost = DIJKSTRA_INFINITY };
+
+	if(ws == NULL || graph == NULL || start == NULL || end == NULL) {
 		return ERROR_PATH;
 	}
 
-	priority_queue_t *pq = pq_create(graph->numNodes);
-	if(pq == NULL) {
-		free(data);
+	if(workspace_prepare(ws, graph) != 0) {
 		return ERROR_PATH;
 	}
 
-	for(int i = 0; i < graph->numNodes; i++) {
-		data[i].gCost = DIJKSTRA_INFINITY;
+	if(!run_search(ws, start, end, NULL, 0, stats)) {
+		return EMPTY_PATH_IN(arena);
 	}
-	data[start->index].gCost = 0.0;
-	pq_push(pq, start, 0);
 
-	while(!pq_is_empty(pq)) {
-		node_t *current = (node_t *) pq_pop(pq);
+	stats->pathCost = ws->data[end->index].gCost;
+	return reconstruct_path(end, ws, arena);
+}
 
-		if(data[current->index].visited) {
-			continue;
-		}
-		data[current->index].visited = true;
 
-		if(current == end) {
-			path_t path = reconstruct_path(end, data);
-			pq_destroy(pq);
-			free(data);
-			return path;
-		}
+/**
+ * @brief Calcule le coût du plus court chemin d'un noeud vers plusieurs cibles (one-to-many).
+ * @details Une seule exploration est effectuée depuis le noeud de départ. Elle s'arrête
+ * dès que toutes les cibles ont été atteintes, ou lorsque le graphe a été entièrement parcouru.
+ * @param graph Le graphe pondéré orienté
+ * @param start Le noeud de départ
+ * @param targets Tableau des noeuds cibles (les doublons sont autorisés)
+ * @param targetCount Nombre de cibles
+ * @param costs Tableau de sortie (taille targetCount) recevant le coût vers chaque cible,
+ * ou DIJKSTRA_INFINITY si la cible est inaccessible
+ * @return 0 en cas de succès, -1 en cas d'erreur
+ */
+int dijkstra_compute_costs(graph_t *graph, node_t *start, node_t **targets, int targetCount, double *costs) {
+	dijkstra_workspace_t ws = {0};
+	int result = dijkstra_compute_costs_ws(&ws, graph, start, targets, targetCount, costs);
+	workspace_release(&ws);
+	return result;
+}
 
-		edge_t *edge = current->edges;
-		while(edge != NULL) {
-			node_t *neighbor = edge->targetNode;
+/**
+ * @brief Variante de dijkstra_compute_costs() sans allocation de travail.
+ * @details Le marquage des cibles est alloué dans l'arène de l'espace de travail (ws->arena),
+ * sur le tas si l'espace n'en a pas.
+ * @param ws L'espace de travail (propre au thread appelant)
+ * @param graph Le graphe pondéré orienté
+ * @param start Le noeud de départ
+ * @param targets Tableau des noeuds cibles (les doublons sont autorisés)
+ * @param targetCount Nombre de cibles
+ * @param costs Tableau de sortie (taille targetCount), voir dijkstra_compute_costs()
+ * @return 0 en cas de succès, -1 en cas d'erreur
+ */
+int dijkstra_compute_costs_ws(dijkstra_workspace_t *ws, graph_t *graph, node_t *start, node_t **targets, int targetCount, double *costs) {
+	if(ws == NULL || graph == NULL || start == NULL || targets == NULL || costs == NULL || targetCount < 0) {
+		return -1;
+	}
 
-			if(!data[neighbor->index].visited) {
-				double newCost = data[current->index].gCost + edge->weight;
+	// Marque les cibles pour savoir quand l'exploration peut s'arrêter
+	bool *isTarget = ws->arena
+		? (bool *) arena_calloc(ws->arena, graph->numNodes, sizeof(bool))
+		: (bool *) calloc(graph->numNodes, sizeof(bool));
+	if(isTarget == NULL) {
+		return -1;
+	}
 
-				if(newCost < data[neighbor->index].gCost) {
-					data[neighbor->index].gCost = newCost;
-					data[neighbor->index].previous = current;
-					pq_push(pq, neighbor, (int)newCost);
-				}
-			}
-			edge = edge->nextEdge;
+	int result = -1;
+	int remaining = 0;
+	for(int i = 0; i < targetCount; i++) {
+		if(targets[i] == NULL) {
+			goto cleanup;
+		}
+		if(!isTarget[targets[i]->index]) {
+			isTarget[targets[i]->index] = true;
+			remaining++;
 		}
 	}
 
-	pq_destroy(pq);
-	free(data);
-	return (path_t) { .nodes = NULL, .length = 0 };
-}
\ No newline at end of file
+	if(workspace_prepare(ws, graph) != 0) {
+		goto cleanup;
+	}
+
+	dijkstra_stats_t stats = {0};
+	if(remaining > 0) {
+		run_search(ws, start, NULL, isTarget, remaining, &stats);
+	}
+
+	for(int i = 0; i < targetCount; i++) {
+		dijkstra_node_t *entry = node_data(ws, targets[i]);
+		costs[i] = entry->visited ? entry->gCost : DIJKSTRA_INFINITY;
+	}
+	result = 0;
+
+	cleanup:
+		if(!ws->arena) free(isTarget);
+	return result;
+}
@@ -5,39 +5,82 @@
  * Ce fichier contient la fonction main du service.
  * Ce service reste à l'écoute du topics MQTT du status des autres services
  * Lorsqu'un service ne répond plus, le broker publie le message (LWT)
+ * Plusieurs instances peuvent tourner en parallèle (mqtt_instance_id + shared_subscription_group) :
+ * chacune charge sa carte, a son propre topic de status et de réponse, et le broker répartit les
+ * requêtes entre elles.
  */
 
 #include "route-planner/route-planner.h"
 
+/**
+ * @brief Construit le LWT de l'instance : status sur "services/route-planner/<instance>/status".
+ * @internal
+ */
+static int build_lwt(const config_common_t *commonConfig, const void *serviceConfig, char *topic, size_t topicSize, char *payload, size_t payloadSize) {
+	UNUSED(serviceConfig);
+	const char *instanceId = commonConfig->network.instanceId;
+	if(route_planner_instance_topic(instanceId, "status", topic, topicSize) != 0) return -1;
+	return route_planner_status_message(instanceId, false, payload, payloadSize);
+}
+
 int main(int argc, char **argv) {
 	config_common_t common_config;
+	route_planner_config_t route_planner_config = {0};
 
 	core_set_service_version(ROUTE_PLANNER_SERVICE_VERSION);
+	core_set_lwt_builder(build_lwt);
 	signal_init();
 
-	if(core_bootstrap(argc, argv, &common_config, NULL, NULL, LWT_MESSAGE_OFFLINE, LWT_TOPIC) != 0) {
+	if(core_bootstrap(argc, argv, &common_config, (void *) &route_planner_config, route_planner_service_config_parser, LWT_MESSAGE_OFFLINE, LWT_TOPIC) != 0) {
 		LOG_FATAL_SYNC("Failed to bootstrap core systems. Exiting.");
 		return EXIT_FAILURE;
 	}
 	LOG_INFO_ASYNC("Route Planner Service started successfully.");
+	route_planner_set_batch_workers(route_planner_config.workerThreads);
+
+	const char *instanceId = common_config.network.instanceId;
+	char replyTopic[ROUTE_PLANNER_TOPIC_LENGTH];
+	char statusTopic[ROUTE_PLANNER_TOPIC_LENGTH];
+	char requestSubscription[ROUTE_PLANNER_TOPIC_LENGTH];
+	char onlineMessage[CORE_LWT_PAYLOAD_LENGTH];
+	if(route_planner_instance_topic(instanceId, "response", replyTopic, sizeof(replyTopic)) != 0
+		|| route_planner_instance_topic(instanceId, "status", statusTopic, sizeof(statusTopic)) != 0
+		|| route_planner_request_subscription(route_planner_config.sharedGroup, requestSubscription, sizeof(requestSubscription)) != 0
+		|| route_planner_status_message(instanceId, true, onlineMessage, sizeof(onlineMessage)) != 0) {
+		LOG_FATAL_SYNC("Failed to build MQTT topics for instance '%s'. Exiting.", instanceId);
+		core_shutdown();
+		return EXIT_FAILURE;
+	}
 
-	mqtt_subscribe(ROUTE_PLANNER_REQUEST_TOPIC, MQTT_QOS_EXACTLY_ONCE);
-	mqtt_subscribe(ROUTE_PLANNER_REPLY_TOPIC, MQTT_QOS_EXACTLY_ONCE);
+	if(route_planner_register_routes(core_get_router(), replyTopic) != 0) {
+		LOG_FATAL_SYNC("Failed to register MQTT routes. Exiting.");
+		core_shutdown();
+		return EXIT_FAILURE;
+	}
+	mqtt_subscribe(requestSubscription, MQTT_QOS_EXACTLY_ONCE);
+	mqtt_subscribe(ROUTE_PLANNER_BROADCAST_TOPIC, MQTT_QOS_EXACTLY_ONCE);
+	mqtt_subscribe(replyTopic, MQTT_QOS_EXACTLY_ONCE);
 
-	mqtt_set_message_callback(route_planner_message_callback);
-	mqtt_publish(LWT_TOPIC, LWT_MESSAGE_ONLINE, MQTT_QOS_EXACTLY_ONCE, true);
+	mqtt_publish(statusTopic, onlineMessage, MQTT_QOS_EXACTLY_ONCE, true);
 
+	// Chaque instance demande sa propre carte et la reçoit sur son topic de réponse
 	get_map_request_t mapRequest = {
-		.header = create_command_header(ACTION_GET_MAP_REQUEST, ROUTE_PLANNER_REPLY_TOPIC)
+		.header = create_command_header(ACTION_GET_MAP_REQUEST, replyTopic)
 	};
-	request_manager_register(mapRequest.header.commandId, on_get_map_response, NULL);
-
 	char *jsonPayload = get_map_request_serialize_json(&mapRequest);
 
 	if(!jsonPayload) {
 		LOG_ERROR_ASYNC("Could not serialize get_map_request message to JSON.");
 	} else {
-		mqtt_publish("services/api/request", jsonPayload, MQTT_QOS_EXACTLY_ONCE, true); // on retient le message au cas ou l'api est offline lors de l'envoi
+		// Renvoyée tant que l'API ne répond pas, sans carte le service ne peut rien planifier
+		request_options_t mapRequestOptions = {
+			.timeoutMs = ROUTE_PLANNER_MAP_REQUEST_TIMEOUT_MS,
+			.maxRetries = ROUTE_PLANNER_MAP_REQUEST_MAX_RETRIES,
+			.maxTimeoutMs = ROUTE_PLANNER_MAP_REQUEST_MAX_TIMEOUT_MS,
+			.replyTopic = replyTopic
+		};
+		request_manager_send("services/api/request", mapRequest.header.commandId, jsonPayload, MQTT_QOS_EXACTLY_ONCE, false,
+			on_get_map_response, NULL, &mapRequestOptions);
 		free(jsonPayload);
 	}
 
@@ -45,6 +88,7 @@ int main(int argc, char **argv) {
 
 	LOG_INFO_ASYNC("Shutdown signal received. Stopping Route Planner Service...");
 	core_shutdown();
+	route_planner_cleanup(); // Après l'arrêt de MQTT : plus aucun callback en cours
 	signal_cleanup();
 	
 	return 0;
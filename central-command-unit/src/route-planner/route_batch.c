@@ -0,0 +1,184 @@
+/**
+ * @file route_batch.c
+ * @brief Planification de trajets par lot, répartie sur un pool de threads.
+ * @date 2026-10-19
+ */
+
+#include "route-planner/route_batch.h"
+
+/**
+ * @brief Contexte d'un lot partagé par les workers.
+ * @internal
+ */
+typedef struct {
+	route_batch_planner_t *planner;
+	graph_t *map;
+	const plan_route_batch_request_t *request;
+	plan_route_batch_result_t *results;
+} batch_context_t;
+
+/**
+ * @brief Marque un résultat en échec.
+ * @internal
+ */
+static void result_fail(plan_route_batch_result_t *result, const char *errorMessage) {
+	result->success = false;
+	strncpy(result->errorMessage, errorMessage, MAX_ERROR_MSG_LEN - 1);
+	result->errorMessage[MAX_ERROR_MSG_LEN - 1] = '\0';
+}
+
+/**
+ * @brief Calcule une entrée du lot avec l'espace de travail du worker.
+ * @details Les chemins intermédiaires sont alloués dans l'arène du worker, remise à zéro
+ * à chaque entrée ; seuls les IDs du trajet final sont copiés sur le tas.
+ * @internal
+ */
+static void plan_entry(dijkstra_workspace_t *ws, graph_t *map, const plan_route_batch_entry_t *entry, bool includePath, plan_route_batch_result_t *result) {
+	*result = (plan_route_batch_result_t) { .carId = entry->carId, .success = true };
+	arena_reset(ws->arena);
+
+	if (entry->nodeCount < 1) {
+		result_fail(result, "Empty stop list");
+		return;
+	}
+	for (int i = 0; i < entry->nodeCount; i++) {
+		if (!graph_get_node_by_id(map, entry->nodeIds[i])) {
+			result_fail(result, "Invalid node IDs in request");
+			return;
+		}
+	}
+
+	// Optimisation optionnelle de l'ordre de passage des arrêts
+	const int *stopIds = entry->nodeIds;
+	if (entry->optimizeOrder && entry->nodeCount > 2) {
+		int *orderedIds = (int *) arena_alloc(ws->arena, sizeof(int) * entry->nodeCount);
+		if (orderedIds && tsp_optimize_stops_ws(ws, map, entry->nodeIds, entry->nodeCount, entry->keepLastStop, orderedIds, &result->savedDistance) == 0) {
+			stopIds = orderedIds;
+		} else {
+			result->savedDistance = 0.0;
+		}
+	}
+
+	path_t totalPath = EMPTY_PATH_IN(ws->arena);
+	if (entry->nodeCount == 1 && includePath) {
+		path_push(&totalPath, graph_get_node_by_id(map, stopIds[0]));
+	}
+
+	for (int i = 0; i < entry->nodeCount - 1; i++) {
+		node_t *startNode = graph_get_node_by_id(map, stopIds[i]);
+		node_t *endNode = graph_get_node_by_id(map, stopIds[i + 1]);
+
+		dijkstra_stats_t stats;
+		path_t segment = dijkstra_find_path_ws(ws, map, startNode, endNode, ws->arena, &stats);
+		if (segment.length < 0) {
+			result_fail(result, "Out of memory");
+			return;
+		}
+		if (segment.length == 0) {
+			result_fail(result, "No path found between specified nodes");
+			return;
+		}
+
+		result->cost += stats.pathCost;
+		if (includePath) path_append(&totalPath, &segment);
+	}
+
+	if (includePath && totalPath.length > 0) {
+		result->nodeIds = path_emit_ids(&totalPath, NULL);
+		if (!result->nodeIds) {
+			result_fail(result, "Out of memory");
+			return;
+		}
+		result->nodeCount = totalPath.length;
+	}
+}
+
+/**
+ * @brief Tâche du pool : une entrée du lot.
+ * @internal
+ */
+static void batch_task(int index, int workerIndex, void *context) {
+	batch_context_t *batch = (batch_context_t *) context;
+	plan_entry(batch->planner->workspaces[workerIndex], batch->map, &batch->request->entries[index],
+		batch->request->includePath, &batch->results[index]);
+}
+
+/**
+ * @brief Crée un planificateur de lots.
+ * @param workerThreads Nombre de workers (0 : nombre de coeurs en ligne)
+ * @return Le planificateur, ou NULL en cas d'erreur
+ * @warning Doit être libéré avec route_batch_planner_destroy()
+ */
+route_batch_planner_t *route_batch_planner_create(int workerThreads) {
+	route_batch_planner_t *planner = (route_batch_planner_t *) calloc(1, sizeof(route_batch_planner_t));
+	if (!planner) return NULL;
+
+	planner->pool = thread_pool_create(workerThreads);
+	if (!planner->pool) {
+		free(planner);
+		return NULL;
+	}
+
+	int workerCount = thread_pool_size(planner->pool);
+	planner->workspaces = (dijkstra_workspace_t **) calloc(workerCount, sizeof(dijkstra_workspace_t *));
+	if (!planner->workspaces) {
+		route_batch_planner_destroy(planner);
+		return NULL;
+	}
+
+	// Les espaces de travail s'agrandissent à la taille de la carte lors du premier lot
+	for (int i = 0; i < workerCount; i++) {
+		planner->workspaces[i] = dijkstra_workspace_create(0, true);
+		if (!planner->workspaces[i]) {
+			route_batch_planner_destroy(planner);
+			return NULL;
+		}
+		planner->workerCount++;
+	}
+
+	return planner;
+}
+
+/**
+ * @brief Arrête les workers et libère le planificateur.
+ * @param planner Le planificateur (NULL accepté)
+ */
+void route_batch_planner_destroy(route_batch_planner_t *planner) {
+	if (!planner) return;
+
+	thread_pool_destroy(planner->pool);
+	for (int i = 0; i < planner->workerCount; i++) {
+		dijkstra_workspace_destroy(planner->workspaces[i]);
+	}
+	free(planner->workspaces);
+	free(planner);
+}
+
+/**
+ * @brief Calcule toutes les entrées d'un lot en parallèle.
+ * @details results[i] correspond à request->entries[i]. Une entrée en échec (noeud inconnu,
+ * aucun chemin, ...) n'interrompt pas le lot : son résultat porte success = false et un message.
+ * @param planner Le planificateur
+ * @param map La carte
+ * @param request La requête de lot
+ * @param results Tableau de request->entryCount résultats à remplir (nodeIds alloués sur le tas,
+ * à libérer avec plan_route_batch_response_destroy())
+ * @return Le nombre d'entrées en échec, ou -1 en cas d'erreur (paramètres invalides)
+ */
+int route_batch_planner_run(route_batch_planner_t *planner, graph_t *map, const plan_route_batch_request_t *request, plan_route_batch_result_t *results) {
+	if (!planner || !map || !request || (request->entryCount > 0 && !results)) return -1;
+
+	batch_context_t batch = {
+		.planner = planner,
+		.map = map,
+		.request = request,
+		.results = results
+	};
+	if (thread_pool_parallel_for(planner->pool, request->entryCount, batch_task, &batch) != 0) return -1;
+
+	int failedCount = 0;
+	for (int i = 0; i < request->entryCount; i++) {
+		if (!results[i].success) failedCount++;
+	}
+	return failedCount;
+}
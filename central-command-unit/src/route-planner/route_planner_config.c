@@ -0,0 +1,39 @@
+/**
+ * @file route_planner_config.c
+ * @brief Configuration du service route planner.
+ * @date 2026-10-19
+ */
+
+#include "route-planner/route_planner_config.h"
+
+/*
+[Service]
+; Nombre de threads de calcul des requêtes par lot (0 : nombre de coeurs)
+worker_threads = 0
+; Groupe d'abonnement partagé : les requêtes sont réparties entre les instances du groupe (vide : aucun)
+shared_subscription_group = planners
+*/
+/***
+ * @brief Parse la section spécifique de la configuration du service route planner.
+ * @param key Nom du paramètre
+ * @param value Valeur du paramètre
+ * @param serviceConfig Pointeur vers la structure spécifique du service
+ */
+void route_planner_service_config_parser(const char *key, const char *value, void *serviceConfig) {
+	route_planner_config_t *config = (route_planner_config_t *) serviceConfig;
+
+	if (strcmp(key, "worker_threads") == 0) {
+		config->workerThreads = atoi(value);
+	}
+	else if (strcmp(key, "shared_subscription_group") == 0) {
+		// Le groupe est un niveau du topic d'abonnement : pas de séparateur ni de joker MQTT
+		if (strpbrk(value, "/+#") || strlen(value) >= sizeof(config->sharedGroup)) {
+			LOG_ERROR_ASYNC("Invalid shared_subscription_group '%s' in [Service].", value);
+		} else {
+			strcpy(config->sharedGroup, value);
+		}
+	}
+	else {
+		LOG_WARNING_ASYNC("Unknown key in [Service]: %s", key);
+	}
+}
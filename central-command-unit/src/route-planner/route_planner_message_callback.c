@@ -2,12 +2,18 @@
  * @file route_planner_message_callback.c
  * @brief Implémentation de la logique métier du route-planner.
  */
+
+#define LOG_MODULE LOG_MODULE_PLANNER
+
 #include "route-planner/route_planner_message_callback.h"
 
 // Variables globales
 static graph_t* g_map = NULL;
 static bool g_safeMode = false;
 static bool g_railwayMode = false;
+static arena_t* g_requestArena = NULL; // Chemins d'une requête de planification, recyclés à la requête suivante
+static route_batch_planner_t* g_batchPlanner = NULL; // Créé à la première requête par lot
+static int g_batchWorkers = 0; // 0 : nombre de coeurs en ligne
 
 /**
  * @brief Initialise le callback du route planner avec la carte et les modes par défaut.
@@ -19,15 +25,28 @@ void route_planner_callback_init(graph_t* map) {
 	g_railwayMode = false;
 }
 
+/**
+ * @brief Définit le nombre de workers utilisés pour les requêtes par lot.
+ * @details Le pool est créé à la première requête par lot reçue.
+ * @param workerThreads Nombre de workers (0 : nombre de coeurs en ligne)
+ */
+void route_planner_set_batch_workers(int workerThreads) {
+	g_batchWorkers = workerThreads;
+}
+
 /**
  * @brief Nettoie les ressources utilisées par le route planner.
- * Actuellement, cette fonction réinitialise simplement les variables globales.
  */
 void route_planner_cleanup(void) {
 	g_map = NULL;
 	g_safeMode = false;
 	g_railwayMode = false;
 
+	arena_destroy(g_requestArena);
+	g_requestArena = NULL;
+
+	route_batch_planner_destroy(g_batchPlanner);
+	g_batchPlanner = NULL;
 }
 
 
@@ -62,17 +81,35 @@ static void on_plan_route_request(const plan_route_request_t* request) {
 		command_response_header_t response = create_command_response_header(request->header.commandId, false, "Map not initialized");
 		char *jsonResponse = command_response_header_serialize(&response);
 		if(jsonResponse) {
-			mqtt_publish(request->header.replyTopic, jsonResponse, MQTT_QOS_AT_MOST_ONCE, false);
+			mqtt_publish_reply(&request->header, jsonResponse, MQTT_QOS_AT_MOST_ONCE);
 			free(jsonResponse);
 		}
 		else LOG_ERROR_ASYNC("Failed to serialize error response for PLAN_ROUTE_REQUEST");
 		return;
 	}
 
-	path_t totalPath = EMPTY_PATH;
+	// Optimisation optionnelle de l'ordre de passage des arrêts
+	const int *stopIds = request->nodeIds;
+	int *orderedIds = NULL;
+	double savedDistance = 0.0;
+	if(request->optimizeOrder && request->nodeCount > 2) {
+		orderedIds = (int *) malloc(sizeof(int) * request->nodeCount);
+		if(orderedIds && tsp_optimize_stops(g_map, request->nodeIds, request->nodeCount, request->keepLastStop, orderedIds, &savedDistance) == 0) {
+			stopIds = orderedIds;
+			LOG_INFO_ASYNC("Stop order optimized for carId %d, saved distance: %.2f", request->carId, savedDistance);
+		} else {
+			LOG_WARNING_ASYNC("Stop order optimization failed for carId %d, keeping requested order", request->carId);
+		}
+	}
+
+	// Les segments et le chemin complet sont alloués dans l'arène de requête (tas si indisponible)
+	if(g_requestArena) arena_reset(g_requestArena);
+	else g_requestArena = arena_create(0);
+
+	path_t totalPath = EMPTY_PATH_IN(g_requestArena);
 	for(int i = 0; i < request->nodeCount - 1; i++) {
-		int startNodeId = request->nodeIds[i];
-		int endNodeId = request->nodeIds[i + 1];
+		int startNodeId = stopIds[i];
+		int endNodeId = stopIds[i + 1];
 
 		node_t *startNode = graph_get_node_by_id(g_map, startNodeId);
 		node_t *endNode = graph_get_node_by_id(g_map, endNodeId);
@@ -81,23 +118,28 @@ static void on_plan_route_request(const plan_route_request_t* request) {
 			command_response_header_t response = create_command_response_header(request->header.commandId, false, "Invalid node IDs in request");
 			char *jsonResponse = command_response_header_serialize(&response);
 			if(jsonResponse) {
-				mqtt_publish(request->header.replyTopic, jsonResponse, MQTT_QOS_AT_MOST_ONCE, false);
+				mqtt_publish_reply(&request->header, jsonResponse, MQTT_QOS_AT_MOST_ONCE);
 				free(jsonResponse);
 			}
 			else LOG_ERROR_ASYNC("Failed to serialize error response for PLAN_ROUTE_REQUEST with invalid node IDs");
 			path_destroy(&totalPath);
+			free(orderedIds);
 			return;
 		}
 
-		path_t segment = dijkstra_find_path(g_map, startNode, endNode);
+		path_t segment = dijkstra_find_path_ex(g_map, startNode, endNode, g_requestArena, NULL);
 		if(segment.length == 0) {
 			LOG_ERROR_ASYNC("No path found from node %d to node %d", startNodeId, endNodeId);
 			command_response_header_t response = create_command_response_header(request->header.commandId, false, "No path found between specified nodes");
 			char *jsonResponse = command_response_header_serialize(&response);
 			if(jsonResponse) {
-				mqtt_publish(request->header.replyTopic, jsonResponse, MQTT_QOS_AT_MOST_ONCE, false);
+				mqtt_publish_reply(&request->header, jsonResponse, MQTT_QOS_AT_MOST_ONCE);
 				free(jsonResponse);
 			} else LOG_ERROR_ASYNC("Failed to serialize error response for PLAN_ROUTE_REQUEST with no path found");
+			path_destroy(&segment);
+			path_destroy(&totalPath);
+			free(orderedIds);
+			return;
 		}
 
 		path_append(&totalPath, &segment);
@@ -118,10 +160,11 @@ static void on_plan_route_request(const plan_route_request_t* request) {
 		command_response_header_t response = create_command_response_header(request->header.commandId, false, "Failed to convert path to waypoints");
 		char *jsonResponse = command_response_header_serialize(&response);
 		if(jsonResponse) {
-			mqtt_publish(request->header.replyTopic, jsonResponse, MQTT_QOS_AT_MOST_ONCE, false);
+			mqtt_publish_reply(&request->header, jsonResponse, MQTT_QOS_AT_MOST_ONCE);
 			free(jsonResponse);
 		} else LOG_ERROR_ASYNC("Failed to serialize error response for PLAN_ROUTE_REQUEST waypoint conversion failure");
 		path_destroy(&totalPath);
+		free(orderedIds);
 		return;
 	}
 
@@ -131,7 +174,7 @@ static void on_plan_route_request(const plan_route_request_t* request) {
 	if(!jsonPayload) {
 		LOG_ERROR_ASYNC("Could not serialize set_waypoints_request message to JSON for carId %d", request->carId);
 	} else {
-		mqtt_publish(carTopic, jsonPayload, MQTT_QOS_EXACTLY_ONCE, false);
+		mqtt_publish_command(carTopic, &waypointRequest.header, jsonPayload, MQTT_QOS_EXACTLY_ONCE);
 		free(jsonPayload);
 		LOG_DEBUG_ASYNC("Planned route for carId %d with %d waypoints", request->carId, waypointRequest.waypointCount);
 	}
@@ -140,20 +183,23 @@ static void on_plan_route_request(const plan_route_request_t* request) {
 		.header = create_command_response_header(request->header.commandId, true, NULL),
 		.nodeIds = NULL,
 		.nodeCount = 0,
-		.carId = request->carId
+		.carId = request->carId,
+		.savedDistance = savedDistance
 	};
 	response.header.success = true;
 
-	int pathNodeIds[totalPath.length];    
-	for(int i = 0; i < totalPath.length; i++) {
-		pathNodeIds[i] = totalPath.nodes[i]->id;
+	// IDs émis dans l'arène de requête (tas si indisponible) plutôt que sur la pile
+	int *pathNodeIds = path_emit_ids(&totalPath, g_requestArena);
+	if(pathNodeIds) {
+		response.nodeIds = pathNodeIds;
+		response.nodeCount = totalPath.length;
+	} else if(totalPath.length > 0) {
+		LOG_ERROR_ASYNC("Failed to allocate node IDs for PLAN_ROUTE_REQUEST response for carId %d", request->carId);
 	}
-	response.nodeIds = pathNodeIds;
-	response.nodeCount = totalPath.length;
 
 	char *jsonResponse = plan_route_response_serialize(&response);
 	if(jsonResponse) {
-		mqtt_publish(request->header.replyTopic, jsonResponse, MQTT_QOS_AT_MOST_ONCE, false);
+		mqtt_publish_reply(&request->header, jsonResponse, MQTT_QOS_AT_MOST_ONCE);
 		free(jsonResponse);
 	} else {
 		LOG_ERROR_ASYNC("Failed to serialize success response for PLAN_ROUTE_REQUEST for carId %d", request->carId);
@@ -161,11 +207,75 @@ static void on_plan_route_request(const plan_route_request_t* request) {
 
 	set_waypoints_request_destroy(&waypointRequest);
 	path_destroy(&totalPath);
+	if(!g_requestArena) free(pathNodeIds);
+	free(orderedIds);
+}
+
+static void on_plan_route_batch_request(const plan_route_batch_request_t* request) {
+	LOG_DEBUG_ASYNC("Received PLAN_ROUTE_BATCH_REQUEST with %d entries", request->entryCount);
+
+	const char *errorMessage = NULL;
+	if(!g_map) {
+		errorMessage = "Map not initialized";
+	} else if(!g_batchPlanner) {
+		g_batchPlanner = route_batch_planner_create(g_batchWorkers);
+		if(g_batchPlanner) LOG_INFO_ASYNC("Route batch planner started with %d workers", g_batchPlanner->workerCount);
+		else errorMessage = "Batch planner unavailable";
+	}
+
+	plan_route_batch_response_t response = {
+		.header = create_command_response_header(request->header.commandId, true, NULL),
+		.results = NULL,
+		.resultCount = 0
+	};
+
+	if(!errorMessage && request->entryCount > 0) {
+		response.results = calloc(request->entryCount, sizeof(plan_route_batch_result_t));
+		if(!response.results) errorMessage = "Out of memory";
+	}
+
+	if(!errorMessage) {
+		struct timespec begin, end;
+		clock_gettime(CLOCK_MONOTONIC, &begin);
+		int failedCount = route_batch_planner_run(g_batchPlanner, g_map, request, response.results);
+		clock_gettime(CLOCK_MONOTONIC, &end);
+
+		if(failedCount < 0) {
+			errorMessage = "Batch planning failed";
+		} else {
+			response.resultCount = request->entryCount;
+			double elapsedMs = (end.tv_sec - begin.tv_sec) * 1e3 + (end.tv_nsec - begin.tv_nsec) / 1e6;
+			LOG_INFO_ASYNC("Planned batch of %d entries (%d failed) in %.2f ms", request->entryCount, failedCount, elapsedMs);
+		}
+	}
+
+	if(errorMessage) {
+		LOG_ERROR_ASYNC("PLAN_ROUTE_BATCH_REQUEST failed: %s", errorMessage);
+		plan_route_batch_response_destroy(&response);
+		response.header = create_command_response_header(request->header.commandId, false, errorMessage);
+	}
+
+	char *jsonResponse = plan_route_batch_response_serialize(&response);
+	if(jsonResponse) {
+		mqtt_publish_reply(&request->header, jsonResponse, MQTT_QOS_AT_MOST_ONCE);
+		free(jsonResponse);
+	} else {
+		LOG_ERROR_ASYNC("Failed to serialize response for PLAN_ROUTE_BATCH_REQUEST");
+	}
+
+	plan_route_batch_response_destroy(&response);
 }
 
 void on_get_map_response(const cJSON *root, const command_response_header_t *header, void *context) {
 	UNUSED(context);
 
+	if(!root) {
+		// Tous les renvois ont expiré : arrêt du service pour qu'il soit relancé
+		LOG_FATAL_ASYNC("No map received from the API (%s), stopping the service.", header->errorMessage);
+		signal_send_shutdown();
+		return;
+	}
+
 	get_map_response_t mapResponse = {
 		.header = *header,
 		.map = NULL
@@ -183,58 +293,138 @@ void on_get_map_response(const cJSON *root, const command_response_header_t *hea
 
 }
 
-void route_planner_message_callback(const char* topic, const char* payload) {
-	LOG_DEBUG_SYNC("Received message on topic: %s", topic);
+/**
+ * @brief Transmet une réponse reçue au request_manager.
+ * @internal
+ */
+static void on_reply(const char* topic, const void* payload, size_t length, void* context) {
+	UNUSED(topic);
+	UNUSED(context);
+	request_manager_process_payload(payload, length);
+}
 
-	// Gestion des réponses à nos requêtes
-	if (strcmp(topic, "services/route-planner/response") == 0) {
-		request_manager_process_response(payload);
+static void on_set_safe_route_mode_action(const char* topic, const command_header_t* header, cJSON* root, void* context) {
+	UNUSED(topic);
+	UNUSED(context);
+	set_safe_route_mode_request_t request = { .header = *header };
+	if(set_safe_route_mode_request_data_deserialize(root, &request) != 0) {
+		LOG_ERROR_ASYNC("Failed to deserialize set safe route mode request.");
 		return;
 	}
+	on_set_safe_route_mode(&request);
+}
 
-	// Gestion des commandes reçues
-	if(strcmp(topic, "services/route-planner/request") == 0) {
-		command_header_t header = {0};
-		cJSON *root = cJSON_Parse(payload);
-		if (!root) {
-			LOG_ERROR_ASYNC("The payload is not valid JSON.");
-			return;
-		}
-		if(command_header_deserialize(root, &header) != 0) {
-			LOG_ERROR_ASYNC("Failed to deserialize command header.");
-			cJSON_Delete(root);
-			return;
-		}
-		LOG_DEBUG_ASYNC("Processing command: %s, action: %s, replyTopic: %s", header.commandId, header.action, header.replyTopic);
+static void on_set_railway_mode_action(const char* topic, const command_header_t* header, cJSON* root, void* context) {
+	UNUSED(topic);
+	UNUSED(context);
+	set_railway_mode_request_t request = { .header = *header };
+	if(set_railway_mode_request_data_deserialize(root, &request) != 0) {
+		LOG_ERROR_ASYNC("Failed to deserialize set railway mode request.");
+		return;
+	}
+	on_set_railway_mode(&request);
+}
 
-		if(strcmp(header.action, ACTION_SET_SAFE_ROUTE_MODE) == 0) {
-			set_safe_route_mode_request_t request = { .header = header };
-			if(set_safe_route_mode_request_data_deserialize(root, &request) != 0) {
-				LOG_ERROR_ASYNC("Failed to deserialize set safe route mode request.");
-				return;
-			}
-			else on_set_safe_route_mode(&request);
-			
-		} else if(strcmp(header.action, ACTION_SET_RAILWAY_MODE) == 0) {
-			set_railway_mode_request_t request = { .header = header };
-			if(set_railway_mode_request_data_deserialize(root, &request) != 0) {
-				LOG_ERROR_ASYNC("Failed to deserialize set railway mode request.");
-				return;
-			}
-			else on_set_railway_mode(&request);
-
-		} else if(strcmp(header.action, ACTION_PLAN_ROUTE_REQUEST) == 0) {
-			plan_route_request_t request = {0};
-			request.header = header;
-			
-			if(plan_route_request_data_deserialize(root, &request) != 0) {
-				LOG_ERROR_ASYNC("Failed to deserialize plan route request.");
-				return;
-			}
-			else on_plan_route_request(&request);
-		}
+static void on_plan_route_action(const char* topic, const command_header_t* header, cJSON* root, void* context) {
+	UNUSED(topic);
+	UNUSED(context);
+	plan_route_request_t request = {0};
+	request.header = *header;
+	if(plan_route_request_data_deserialize(root, &request) != 0) {
+		LOG_ERROR_ASYNC("Failed to deserialize plan route request.");
+		return;
+	}
+	on_plan_route_request(&request);
+	free(request.nodeIds);
+}
 
-		cJSON_Delete(root);
+static void on_plan_route_batch_action(const char* topic, const command_header_t* header, cJSON* root, void* context) {
+	UNUSED(topic);
+	UNUSED(context);
+	plan_route_batch_request_t request = { .header = *header };
+	if(plan_route_batch_request_data_deserialize(root, &request) != 0) {
+		LOG_ERROR_ASYNC("Failed to deserialize plan route batch request.");
 		return;
 	}
-}
\ No newline at end of file
+	on_plan_route_batch_request(&request);
+	plan_route_batch_request_destroy(&request);
+}
+
+/**
+ * @brief Enregistre les routes MQTT du route planner.
+ * @details Les réponses à nos requêtes sont transmises au request_manager, les commandes reçues
+ * sont routées d'après leur action. Les commandes de mode sont acceptées sur le topic de requête
+ * et sur ROUTE_PLANNER_BROADCAST_TOPIC.
+ * @param router Le routeur du service
+ * @param replyTopic Topic de réponse de cette instance (voir route_planner_instance_topic())
+ * @return 0 en cas de succès, -1 en cas d'erreur
+ */
+int route_planner_register_routes(mqtt_router_t* router, const char* replyTopic) {
+	int result = 0;
+	result |= mqtt_router_add_topic(router, replyTopic, on_reply, NULL);
+	result |= mqtt_router_add_action(router, ROUTE_PLANNER_REQUEST_TOPIC, ACTION_SET_SAFE_ROUTE_MODE, on_set_safe_route_mode_action, NULL);
+	result |= mqtt_router_add_action(router, ROUTE_PLANNER_REQUEST_TOPIC, ACTION_SET_RAILWAY_MODE, on_set_railway_mode_action, NULL);
+	result |= mqtt_router_add_action(router, ROUTE_PLANNER_BROADCAST_TOPIC, ACTION_SET_SAFE_ROUTE_MODE, on_set_safe_route_mode_action, NULL);
+	result |= mqtt_router_add_action(router, ROUTE_PLANNER_BROADCAST_TOPIC, ACTION_SET_RAILWAY_MODE, on_set_railway_mode_action, NULL);
+	result |= mqtt_router_add_action(router, ROUTE_PLANNER_REQUEST_TOPIC, ACTION_PLAN_ROUTE_REQUEST, on_plan_route_action, NULL);
+	result |= mqtt_router_add_action(router, ROUTE_PLANNER_REQUEST_TOPIC, ACTION_PLAN_ROUTE_BATCH_REQUEST, on_plan_route_batch_action, NULL);
+	return result ? -1 : 0;
+}
+
+/**
+ * @brief Construit un topic propre à une instance du route planner.
+ * @details "services/route-planner/<instance>/<suffix>", ou "services/route-planner/<suffix>" pour
+ * une instance unique (instanceId vide).
+ * @param instanceId Identifiant de l'instance (mqtt_instance_id, NULL ou vide : instance unique)
+ * @param suffix Fin du topic (ex : "status", "response")
+ * @param topic Buffer de destination
+ * @param size Taille du buffer
+ * @return 0 en cas de succès, -1 si le buffer est trop petit
+ */
+int route_planner_instance_topic(const char* instanceId, const char* suffix, char* topic, size_t size) {
+	int written;
+	if(instanceId && instanceId[0] != '\0') {
+		written = snprintf(topic, size, ROUTE_PLANNER_TOPIC_PREFIX "%s/%s", instanceId, suffix);
+	} else {
+		written = snprintf(topic, size, ROUTE_PLANNER_TOPIC_PREFIX "%s", suffix);
+	}
+	return (written < 0 || (size_t) written >= size) ? -1 : 0;
+}
+
+/**
+ * @brief Construit le message de status d'une instance du route planner.
+ * @param instanceId Identifiant de l'instance (NULL ou vide : instance unique, sans champ "instance")
+ * @param online Status annoncé
+ * @param payload Buffer de destination
+ * @param size Taille du buffer
+ * @return 0 en cas de succès, -1 si le buffer est trop petit
+ */
+int route_planner_status_message(const char* instanceId, bool online, char* payload, size_t size) {
+	int written;
+	if(instanceId && instanceId[0] != '\0') {
+		written = snprintf(payload, size, "{\"service\":\"route_planner\",\"instance\":\"%s\",\"status\":\"%s\"}",
+			instanceId, online ? "online" : "offline");
+	} else {
+		written = snprintf(payload, size, "%s", online ? LWT_MESSAGE_ONLINE : LWT_MESSAGE_OFFLINE);
+	}
+	return (written < 0 || (size_t) written >= size) ? -1 : 0;
+}
+
+/**
+ * @brief Construit le topic d'abonnement aux requêtes.
+ * @details "$share/<group>/services/route-planner/request" si un groupe est configuré : le broker
+ * répartit alors chaque requête sur une seule des instances du groupe.
+ * @param sharedGroup Groupe d'abonnement partagé (NULL ou vide : abonnement classique)
+ * @param topic Buffer de destination
+ * @param size Taille du buffer
+ * @return 0 en cas de succès, -1 si le buffer est trop petit
+ */
+int route_planner_request_subscription(const char* sharedGroup, char* topic, size_t size) {
+	int written;
+	if(sharedGroup && sharedGroup[0] != '\0') {
+		written = snprintf(topic, size, "$share/%s/" ROUTE_PLANNER_REQUEST_TOPIC, sharedGroup);
+	} else {
+		written = snprintf(topic, size, ROUTE_PLANNER_REQUEST_TOPIC);
+	}
+	return (written < 0 || (size_t) written >= size) ? -1 : 0;
+}
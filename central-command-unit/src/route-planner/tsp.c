@@ -0,0 +1,376 @@
+/**
+ * @file tsp.c
+ * @brief Optimisation de l'ordre de passage des étapes d'un trajet multi-arrêts.
+ * @details
+ * Résout une variante "chemin ouvert" du problème du voyageur de commerce :
+ * le premier arrêt est toujours le point de départ et, optionnellement, le dernier
+ * arrêt reste le point d'arrivée. Les coûts sont asymétriques (graphe orienté).
+ * @date 2026-10-19
+ */
+
+#include "route-planner/tsp.h"
+
+/** Gain minimal pour qu'une amélioration locale soit acceptée (évite les cycles sur les égalités) */
+#define TSP_EPSILON 1e-9
+
+/**
+ * @brief Calcule le coût d'un ordre de passage dans une matrice de distances.
+ * @param costs Matrice des coûts (count x count, ligne = origine)
+ * @param count Nombre d'arrêts
+ * @param order Ordre de passage (indices dans la matrice)
+ * @return Le coût total, ou DIJKSTRA_INFINITY si un tronçon est inaccessible
+ */
+double tsp_order_cost(const double *costs, int count, const int *order) {
+	double total = 0.0;
+	for(int i = 0; i < count - 1; i++) {
+		total += costs[order[i] * count + order[i + 1]];
+	}
+	return total;
+}
+
+/**
+ * @brief Résout l'ordre exact par programmation dynamique (Held-Karp).
+ * @details dp[mask][k] = coût minimal depuis l'arrêt 0 en visitant les arrêts libres de 'mask'
+ * et en terminant sur l'arrêt libre k.
+ * @internal
+ */
+static int solve_exact(const double *costs, int count, bool fixedEnd, int *order) {
+	int last = fixedEnd ? count - 1 : -1;
+	int freeCount = fixedEnd ? count - 2 : count - 1;
+	int maskCount = 1 << freeCount;
+
+	// Les arrêts libres sont les indices 1 .. freeCount de la matrice
+	double *dp = (double *) malloc(sizeof(double) * maskCount * freeCount);
+	int *parent = (int *) malloc(sizeof(int) * maskCount * freeCount);
+	if(dp == NULL || parent == NULL) {
+		free(dp);
+		free(parent);
+		return -1;
+	}
+
+	for(int i = 0; i < maskCount * freeCount; i++) {
+		dp[i] = DIJKSTRA_INFINITY;
+		parent[i] = -1;
+	}
+	for(int k = 0; k < freeCount; k++) {
+		dp[(1 << k) * freeCount + k] = costs[0 * count + (k + 1)];
+	}
+
+	for(int mask = 1; mask < maskCount; mask++) {
+		for(int k = 0; k < freeCount; k++) {
+			double current = dp[mask * freeCount + k];
+			if(!(mask & (1 << k)) || isinf(current)) continue;
+
+			for(int j = 0; j < freeCount; j++) {
+				if(mask & (1 << j)) continue;
+
+				int nextMask = mask | (1 << j);
+				double candidate = current + costs[(k + 1) * count + (j + 1)];
+				if(candidate < dp[nextMask * freeCount + j]) {
+					dp[nextMask * freeCount + j] = candidate;
+					parent[nextMask * freeCount + j] = k;
+				}
+			}
+		}
+	}
+
+	int fullMask = maskCount - 1;
+	int bestLast = -1;
+	double bestCost = DIJKSTRA_INFINITY;
+	for(int k = 0; k < freeCount; k++) {
+		double candidate = dp[fullMask * freeCount + k];
+		if(fixedEnd) candidate += costs[(k + 1) * count + last];
+		if(candidate < bestCost) {
+			bestCost = candidate;
+			bestLast = k;
+		}
+	}
+
+	// Aucun ordre réalisable : on conserve l'ordre d'origine
+	if(bestLast < 0) {
+		for(int i = 0; i < count; i++) order[i] = i;
+		free(dp);
+		free(parent);
+		return 0;
+	}
+
+	order[0] = 0;
+	if(fixedEnd) order[count - 1] = last;
+
+	int mask = fullMask;
+	int k = bestLast;
+	for(int position = freeCount; position >= 1; position--) {
+		order[position] = k + 1;
+		int previous = parent[mask * freeCount + k];
+		mask &= ~(1 << k);
+		k = previous;
+	}
+
+	free(dp);
+	free(parent);
+	return 0;
+}
+
+/**
+ * @brief Construit un ordre initial par la méthode du plus proche voisin.
+ * @internal
+ */
+static void build_nearest_neighbor(const double *costs, int count, int lo, int hi, int *order, bool *used) {
+	for(int position = lo; position <= hi; position++) {
+		int from = order[position - 1];
+		int best = -1;
+		double bestCost = DIJKSTRA_INFINITY;
+
+		for(int candidate = lo; candidate <= hi; candidate++) {
+			if(used[candidate]) continue;
+			if(best < 0 || costs[from * count + candidate] < bestCost) {
+				best = candidate;
+				bestCost = costs[from * count + candidate];
+			}
+		}
+
+		used[best] = true;
+		order[position] = best;
+	}
+}
+
+/**
+ * @brief Passe 2-opt : inverse un segment de l'ordre si le coût total diminue.
+ * @details Le coût complet est réévalué car les coûts sont asymétriques
+ * (inverser un segment change le sens de tous ses tronçons).
+ * @return true si au moins une amélioration a été appliquée.
+ * @internal
+ */
+static bool improve_two_opt(const double *costs, int count, int lo, int hi, int *order, double *currentCost) {
+	bool improved = false;
+
+	for(int i = lo; i < hi; i++) {
+		for(int j = i + 1; j <= hi; j++) {
+			for(int a = i, b = j; a < b; a++, b--) {
+				int tmp = order[a]; order[a] = order[b]; order[b] = tmp;
+			}
+
+			double candidate = tsp_order_cost(costs, count, order);
+			if(candidate < *currentCost - TSP_EPSILON) {
+				*currentCost = candidate;
+				improved = true;
+			} else {
+				for(int a = i, b = j; a < b; a++, b--) {
+					int tmp = order[a]; order[a] = order[b]; order[b] = tmp;
+				}
+			}
+		}
+	}
+	return improved;
+}
+
+/**
+ * @brief Passe Or-opt : déplace un segment de 1 à TSP_OR_OPT_MAX_SEGMENT arrêts à une autre position.
+ * @return true si au moins une amélioration a été appliquée.
+ * @internal
+ */
+static bool improve_or_opt(const double *costs, int count, int lo, int hi, int *order, int *scratch, double *currentCost) {
+	bool improved = false;
+
+	for(int length = 1; length <= TSP_OR_OPT_MAX_SEGMENT; length++) {
+		for(int i = lo; i + length - 1 <= hi; i++) {
+			// Positions d'insertion dans l'ordre privé du segment
+			int remaining = (hi - lo + 1) - length;
+			for(int insert = 0; insert <= remaining; insert++) {
+				if(insert == i - lo) continue;
+
+				// Construction du candidat : [0, lo) + reste avec le segment inséré + (hi, count)
+				int out = 0;
+				for(int p = 0; p < lo; p++) scratch[out++] = order[p];
+				int seen = 0;
+				for(int p = lo; p <= hi; p++) {
+					if(p >= i && p < i + length) continue;
+					if(seen == insert) {
+						for(int s = 0; s < length; s++) scratch[out++] = order[i + s];
+					}
+					scratch[out++] = order[p];
+					seen++;
+				}
+				if(seen == insert) {
+					for(int s = 0; s < length; s++) scratch[out++] = order[i + s];
+				}
+				for(int p = hi + 1; p < count; p++) scratch[out++] = order[p];
+
+				double candidate = tsp_order_cost(costs, count, scratch);
+				if(candidate < *currentCost - TSP_EPSILON) {
+					memcpy(order, scratch, sizeof(int) * count);
+					*currentCost = candidate;
+					improved = true;
+				}
+			}
+		}
+	}
+	return improved;
+}
+
+/**
+ * @brief Résout l'ordre de manière heuristique (plus proche voisin + 2-opt + Or-opt).
+ * @internal
+ */
+static int solve_heuristic(const double *costs, int count, bool fixedEnd, int *order) {
+	int lo = 1;
+	int hi = fixedEnd ? count - 2 : count - 1;
+
+	bool *used = (bool *) calloc(count, sizeof(bool));
+	int *scratch = (int *) malloc(sizeof(int) * count);
+	if(used == NULL || scratch == NULL) {
+		free(used);
+		free(scratch);
+		return -1;
+	}
+
+	order[0] = 0;
+	if(fixedEnd) order[count - 1] = count - 1;
+	build_nearest_neighbor(costs, count, lo, hi, order, used);
+
+	double currentCost = tsp_order_cost(costs, count, order);
+	for(int pass = 0; pass < TSP_MAX_IMPROVE_PASSES; pass++) {
+		bool improved = improve_two_opt(costs, count, lo, hi, order, &currentCost);
+		improved |= improve_or_opt(costs, count, lo, hi, order, scratch, &currentCost);
+		if(!improved) break;
+	}
+
+	free(used);
+	free(scratch);
+	return 0;
+}
+
+/**
+ * @brief Calcule l'ordre de passage de coût minimal à partir d'une matrice de distances.
+ * @details L'arrêt 0 reste toujours en tête. Si fixedEnd est vrai, l'arrêt count - 1 reste en queue.
+ * Exact jusqu'à TSP_EXACT_MAX_STOPS arrêts, heuristique au-delà.
+ * @param costs Matrice des coûts (count x count, ligne = origine)
+ * @param count Nombre d'arrêts
+ * @param fixedEnd Conserve le dernier arrêt en dernière position
+ * @param order Tableau de sortie (taille count) recevant l'ordre de passage
+ * @return 0 en cas de succès, -1 en cas d'erreur
+ */
+int tsp_solve_order(const double *costs, int count, bool fixedEnd, int *order) {
+	if(costs == NULL || order == NULL || count <= 0) {
+		return -1;
+	}
+
+	// Rien à réordonner
+	int freeCount = fixedEnd ? count - 2 : count - 1;
+	if(freeCount <= 1) {
+		for(int i = 0; i < count; i++) order[i] = i;
+		return 0;
+	}
+
+	if(count <= TSP_EXACT_MAX_STOPS) {
+		return solve_exact(costs, count, fixedEnd, order);
+	}
+	return solve_heuristic(costs, count, fixedEnd, order);
+}
+
+/**
+ * @brief Réordonne les arrêts d'un trajet pour minimiser la distance totale.
+ * @details Construit la matrice des distances par des recherches one-to-many puis résout l'ordre.
+ * Si aucun ordre plus court n'est trouvé (ou si un arrêt est inaccessible),
+ * l'ordre d'origine est conservé.
+ * @param graph La carte
+ * @param nodeIds Les IDs des arrêts dans l'ordre demandé
+ * @param count Nombre d'arrêts
+ * @param fixedEnd Conserve le dernier arrêt en dernière position
+ * @param orderedIds Tableau de sortie (taille count) recevant les IDs réordonnés
+ * @param savedDistance Sortie : distance économisée par rapport à l'ordre d'origine (peut être NULL)
+ * @return 0 en cas de succès, -1 en cas d'erreur (ID inconnu, allocation, etc.)
+ */
+int tsp_optimize_stops(graph_t *graph, const int *nodeIds, int count, bool fixedEnd, int *orderedIds, double *savedDistance) {
+	dijkstra_workspace_t *ws = dijkstra_workspace_create(graph ? graph->numNodes : 0, false);
+	if(ws == NULL) {
+		return -1;
+	}
+	int result = tsp_optimize_stops_ws(ws, graph, nodeIds, count, fixedEnd, orderedIds, savedDistance);
+	dijkstra_workspace_destroy(ws);
+	return result;
+}
+
+/**
+ * @brief Alloue un tableau dans l'arène de l'espace de travail, ou sur le tas s'il n'en a pas.
+ * @internal
+ */
+static void *workspace_alloc(dijkstra_workspace_t *ws, size_t size) {
+	return ws->arena ? arena_alloc(ws->arena, size) : malloc(size);
+}
+
+/**
+ * @brief Variante de tsp_optimize_stops() qui réutilise un espace de travail Dijkstra.
+ * @details Les recherches one-to-many utilisent l'espace de travail ; la matrice des distances et
+ * les tableaux intermédiaires sont alloués dans son arène (ws->arena), sur le tas si l'espace n'en a pas.
+ * @param ws L'espace de travail (propre au thread appelant)
+ * @param graph La carte
+ * @param nodeIds Les IDs des arrêts dans l'ordre demandé
+ * @param count Nombre d'arrêts
+ * @param fixedEnd Conserve le dernier arrêt en dernière position
+ * @param orderedIds Tableau de sortie (taille count) recevant les IDs réordonnés
+ * @param savedDistance Sortie : distance économisée par rapport à l'ordre d'origine (peut être NULL)
+ * @return 0 en cas de succès, -1 en cas d'erreur (ID inconnu, allocation, etc.)
+ */
+int tsp_optimize_stops_ws(dijkstra_workspace_t *ws, graph_t *graph, const int *nodeIds, int count, bool fixedEnd, int *orderedIds, double *savedDistance) {
+	if(ws == NULL || graph == NULL || nodeIds == NULL || orderedIds == NULL || count <= 0) {
+		return -1;
+	}
+
+	if(savedDistance) *savedDistance = 0.0;
+	memcpy(orderedIds, nodeIds, sizeof(int) * count);
+
+	int freeCount = fixedEnd ? count - 2 : count - 1;
+	if(freeCount <= 1) {
+		return 0;
+	}
+
+	node_t **stops = (node_t **) workspace_alloc(ws, sizeof(node_t *) * count);
+	double *costs = (double *) workspace_alloc(ws, sizeof(double) * count * count);
+	int *order = (int *) workspace_alloc(ws, sizeof(int) * count);
+	int *identity = (int *) workspace_alloc(ws, sizeof(int) * count);
+	int result = -1;
+
+	if(stops == NULL || costs == NULL || order == NULL || identity == NULL) {
+		goto cleanup;
+	}
+
+	for(int i = 0; i < count; i++) {
+		stops[i] = graph_get_node_by_id(graph, nodeIds[i]);
+		if(stops[i] == NULL) goto cleanup;
+		identity[i] = i;
+	}
+
+	// Une recherche one-to-many par arrêt remplit une ligne de la matrice
+	for(int i = 0; i < count; i++) {
+		if(dijkstra_compute_costs_ws(ws, graph, stops[i], stops, count, &costs[i * count]) != 0) {
+			goto cleanup;
+		}
+	}
+
+	if(tsp_solve_order(costs, count, fixedEnd, order) != 0) {
+		goto cleanup;
+	}
+
+	double initialCost = tsp_order_cost(costs, count, identity);
+	double optimizedCost = tsp_order_cost(costs, count, order);
+
+	if(!isinf(optimizedCost) && optimizedCost < initialCost) {
+		for(int i = 0; i < count; i++) {
+			orderedIds[i] = nodeIds[order[i]];
+		}
+		if(savedDistance && !isinf(initialCost)) {
+			*savedDistance = initialCost - optimizedCost;
+		}
+	}
+	result = 0;
+
+	cleanup:
+		if(ws->arena == NULL) {
+			free(stops);
+			free(costs);
+			free(order);
+			free(identity);
+		}
+	return result;
+}
@@ -5,6 +5,8 @@
  * @date 2025-12-05
  */
 
+#define LOG_MODULE LOG_MODULE_MARVELMIND
+
 #include "vehicle/marvelmind_wrapper.h"
 
 static struct MarvelmindHedge *g_hedge = NULL;
@@ -39,7 +41,7 @@ static void* marvelmind_worker_thread(void* arg) {
 		if (s == 0 && g_threadRunning && g_hedge != NULL) {
 			havePosition = getPositionFromMarvelmindHedge(g_hedge, &pos);
 			if (havePosition && g_user_callback) {
-				LOG_DEBUG_ASYNC("Marvelmind: Received position: x=%d, y=%d, angle=%.2f", pos.x, pos.y, pos.angle);
+				LOG_DEBUG_DEFERRED("Marvelmind: Received position: x=%d, y=%d, angle=%.2f", pos.x, pos.y, pos.angle);
 				g_user_callback(pos.x, pos.y, pos.angle, g_context);
 			}
 		}
@@ -1,3 +1,5 @@
+#define LOG_MODULE LOG_MODULE_CAMERA
+
 #include "vehicle/socket_data_camera.h"
 #include "core/logger.h"
 
@@ -91,6 +93,97 @@ static void process_json_payload(camera_socket_t *sock, const char *jsonStr) {
 	cJSON_Delete(root);
 }
 
+/**
+ * @brief Ajoute des octets reçus au buffer dynamique.
+ * @param sock Pointeur vers la structure de la socket caméra.
+ * @return 0 en cas de succès, -1 si le buffer ne peut pas être agrandi.
+ */
+static int buffer_append(camera_socket_t *sock, const char *data, size_t length) {
+	sem_wait(&sock->dataSem);
+
+	if (sock->bufferLen + length + 1 > sock->bufferCapacity) {
+		size_t newCap = sock->bufferCapacity * 2;
+		if (newCap < sock->bufferLen + length + 1) {
+			newCap = sock->bufferLen + length + 1024;
+		}
+
+		char *newPtr = realloc(sock->recvBuffer, newCap);
+		if (!newPtr) {
+			sem_post(&sock->dataSem);
+			LOG_FATAL_ASYNC("Camera: Failed to reallocate receive buffer.");
+			return -1;
+		}
+		sock->recvBuffer = newPtr;
+		sock->bufferCapacity = newCap;
+	}
+
+	memcpy(sock->recvBuffer + sock->bufferLen, data, length);
+	sock->bufferLen += length;
+	sock->recvBuffer[sock->bufferLen] = '\0';
+
+	sem_post(&sock->dataSem);
+	return 0;
+}
+
+/**
+ * @brief Traite les documents JSON complets du buffer et conserve le reste.
+ * @param sock Pointeur vers la structure de la socket caméra.
+ */
+static void buffer_process_messages(camera_socket_t *sock) {
+	const char *parseEnd = NULL;
+	
+	while (1) {
+		sem_wait(&sock->dataSem);
+		if (sock->bufferLen == 0) {
+			sem_post(&sock->dataSem);
+			break;
+		}
+		
+		const char *jsonStart = sock->recvBuffer;
+		cJSON *testJson = cJSON_ParseWithOpts(jsonStart, &parseEnd, 0);
+		
+		if (testJson) {
+			size_t jsonLen = parseEnd - jsonStart;
+			char *validJsonStr = malloc(jsonLen + 1);
+			if(validJsonStr) {
+				memcpy(validJsonStr, jsonStart, jsonLen);
+				validJsonStr[jsonLen] = '\0';
+			}
+			
+			size_t remaining = sock->bufferLen - jsonLen;
+			if (remaining > 0) {
+				memmove(sock->recvBuffer, parseEnd, remaining);
+			}
+			sock->bufferLen = remaining;
+			sock->recvBuffer[sock->bufferLen] = '\0';
+			
+			sem_post(&sock->dataSem);
+
+			if (validJsonStr) {
+				process_json_payload(sock, validJsonStr);
+				free(validJsonStr);
+			}
+			cJSON_Delete(testJson);
+		} 
+		else {
+			cJSON_Delete(testJson);
+			sem_post(&sock->dataSem);
+			break;
+		}
+	}
+}
+
+/**
+ * @brief Vide le buffer de réception (nouveau client).
+ * @param sock Pointeur vers la structure de la socket caméra.
+ */
+static void buffer_reset(camera_socket_t *sock) {
+	sem_wait(&sock->dataSem);
+	sock->bufferLen = 0;
+	if(sock->recvBuffer) sock->recvBuffer[0] = '\0';
+	sem_post(&sock->dataSem);
+}
+
 /**
  * @brief Gère la lecture du flux TCP client avec buffer dynamique.
  * @param sock Pointeur vers la structure de la socket caméra.
@@ -111,90 +204,35 @@ static void handle_client_connection(camera_socket_t *sock) {
 			break;
 		}
 
-		sem_wait(&sock->dataSem);
-
-		if (sock->bufferLen + bytesRead + 1 > sock->bufferCapacity) {
-			size_t newCap = sock->bufferCapacity * 2;
-			if (newCap < sock->bufferLen + bytesRead + 1) {
-				newCap = sock->bufferLen + bytesRead + 1024;
-			}
-
-			char *newPtr = realloc(sock->recvBuffer, newCap);
-			if (!newPtr) {
-				sem_post(&sock->dataSem);
-				LOG_FATAL_ASYNC("Camera: Failed to reallocate receive buffer.");
-				break;
-			}
-			sock->recvBuffer = newPtr;
-			sock->bufferCapacity = newCap;
-		}
-
-		memcpy(sock->recvBuffer + sock->bufferLen, tempBuffer, bytesRead);
-		sock->bufferLen += bytesRead;
-		sock->recvBuffer[sock->bufferLen] = '\0';
-
-		sem_post(&sock->dataSem);
-		const char *parseEnd = NULL;
-		
-		while (1) {
-			sem_wait(&sock->dataSem);
-			if (sock->bufferLen == 0) {
-				sem_post(&sock->dataSem);
-				break;
-			}
-			
-			const char *jsonStart = sock->recvBuffer;
-			cJSON *testJson = cJSON_ParseWithOpts(jsonStart, &parseEnd, 0);
-			
-			if (testJson) {
-				size_t jsonLen = parseEnd - jsonStart;
-				char *validJsonStr = malloc(jsonLen + 1);
-				if(validJsonStr) {
-					memcpy(validJsonStr, jsonStart, jsonLen);
-					validJsonStr[jsonLen] = '\0';
-				}
-				
-				size_t remaining = sock->bufferLen - jsonLen;
-				if (remaining > 0) {
-					memmove(sock->recvBuffer, parseEnd, remaining);
-				}
-				sock->bufferLen = remaining;
-				sock->recvBuffer[sock->bufferLen] = '\0';
-				
-				sem_post(&sock->dataSem);
-
-				if (validJsonStr) {
-					process_json_payload(sock, validJsonStr);
-					free(validJsonStr);
-				}
-				cJSON_Delete(testJson);
-			} 
-			else {
-				cJSON_Delete(testJson);
-				sem_post(&sock->dataSem);
-				break;
-			}
-		}
+		if (buffer_append(sock, tempBuffer, (size_t) bytesRead) != 0) break;
+		buffer_process_messages(sock);
 	}
 }
 
-static void* camera_thread_func(void* arg) {
-	camera_socket_t *sock = (camera_socket_t*)arg;
+/**
+ * @brief Crée la socket d'écoute du serveur (sock->serverFd).
+ * @param sock Pointeur vers la structure de la socket caméra.
+ * @param nonBlocking Crée une socket non bloquante (boucle d'événements).
+ * @return 0 en cas de succès, -1 en cas d'erreur.
+ */
+static int open_listen_socket(camera_socket_t *sock, bool nonBlocking) {
 	struct sockaddr_in address;
-	int addrlen = sizeof(address);
 	int opt = 1;
 
-	if ((sock->serverFd = socket(AF_INET, SOCK_STREAM, 0)) == 0) {
+	if ((sock->serverFd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC | (nonBlocking ? SOCK_NONBLOCK : 0), 0)) < 0) {
 		LOG_ERROR_ASYNC("Camera: Socket failed");
-		return NULL;
+		sock->serverFd = -1;
+		return -1;
 	}
 
 	if (setsockopt(sock->serverFd, SOL_SOCKET, SO_REUSEADDR | SO_REUSEPORT, &opt, sizeof(opt))) {
 		LOG_ERROR_ASYNC("Camera: setsockopt failed");
 		close(sock->serverFd);
-		return NULL;
+		sock->serverFd = -1;
+		return -1;
 	}
 
+	memset(&address, 0, sizeof(address));
 	address.sin_family = AF_INET;
 	address.sin_port = htons(sock->port);
 
@@ -205,7 +243,8 @@ static void* camera_thread_func(void* arg) {
 		if (inet_pton(AF_INET, sock->bindIp, &address.sin_addr) <= 0) {
 			LOG_ERROR_ASYNC("Camera: Invalid IP address %s", sock->bindIp);
 			close(sock->serverFd);
-			return NULL;
+			sock->serverFd = -1;
+			return -1;
 		}
 		LOG_DEBUG_ASYNC("Camera: Binding to IP %s", sock->bindIp);
 	}
@@ -213,16 +252,27 @@ static void* camera_thread_func(void* arg) {
 	if (bind(sock->serverFd, (struct sockaddr *)&address, sizeof(address)) < 0) {
 		LOG_ERROR_ASYNC("Camera: Bind failed on port %d", sock->port);
 		close(sock->serverFd);
-		return NULL;
+		sock->serverFd = -1;
+		return -1;
 	}
 
 	if (listen(sock->serverFd, 1) < 0) {
 		LOG_ERROR_ASYNC("Camera: Listen failed");
 		close(sock->serverFd);
-		return NULL;
+		sock->serverFd = -1;
+		return -1;
 	}
 
 	LOG_INFO_ASYNC("Camera: Server listening on port %d", sock->port);
+	return 0;
+}
+
+static void* camera_thread_func(void* arg) {
+	camera_socket_t *sock = (camera_socket_t*)arg;
+	struct sockaddr_in address;
+	int addrlen = sizeof(address);
+
+	if (open_listen_socket(sock, false) != 0) return NULL;
 
 	while (sock->running) {
 		sock->clientFd = accept(sock->serverFd, (struct sockaddr *)&address, (socklen_t*)&addrlen);
@@ -233,11 +283,7 @@ static void* camera_thread_func(void* arg) {
 		}
 
 		LOG_INFO_ASYNC("Camera: Client connected.");
-		
-		sem_wait(&sock->dataSem);
-		sock->bufferLen = 0;
-		if(sock->recvBuffer) sock->recvBuffer[0] = '\0';
-		sem_post(&sock->dataSem);
+		buffer_reset(sock);
 
 		handle_client_connection(sock);
 
@@ -249,6 +295,79 @@ static void* camera_thread_func(void* arg) {
 	return NULL;
 }
 
+/**
+ * @brief Ferme le client courant en mode boucle d'événements.
+ * @param sock Pointeur vers la structure de la socket caméra.
+ */
+static void close_loop_client(camera_socket_t *sock) {
+	if (sock->clientFd < 0) return;
+
+	event_loop_remove_fd(sock->loop, sock->clientFd);
+	close(sock->clientFd);
+	sock->clientFd = -1;
+}
+
+/**
+ * @brief Lit les données disponibles du client (mode boucle d'événements).
+ */
+static void on_client_event(event_loop_t *loop, int fd, uint32_t events, void *context) {
+	UNUSED(loop); UNUSED(events);
+	camera_socket_t *sock = (camera_socket_t *)context;
+	char tempBuffer[4096];
+
+	// Socket non bloquante : on lit tout ce qui est disponible puis on rend la main
+	while (1) {
+		ssize_t bytesRead = recv(fd, tempBuffer, sizeof(tempBuffer), 0);
+		if (bytesRead < 0) {
+			if (errno == EINTR) continue;
+			if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+			LOG_ERROR_ASYNC("Camera: Recv error: %s", strerror(errno));
+			close_loop_client(sock);
+			return;
+		}
+		if (bytesRead == 0) {
+			LOG_INFO_ASYNC("Camera: Client disconnected.");
+			close_loop_client(sock);
+			break;
+		}
+		if (buffer_append(sock, tempBuffer, (size_t) bytesRead) != 0) {
+			close_loop_client(sock);
+			return;
+		}
+	}
+
+	buffer_process_messages(sock);
+}
+
+/**
+ * @brief Accepte un client (mode boucle d'événements).
+ */
+static void on_accept_event(event_loop_t *loop, int fd, uint32_t events, void *context) {
+	UNUSED(events);
+	camera_socket_t *sock = (camera_socket_t *)context;
+
+	int clientFd = accept4(fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+	if (clientFd < 0) {
+		if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) LOG_ERROR_ASYNC("Camera: Accept failed");
+		return;
+	}
+
+	if (sock->clientFd >= 0) {
+		LOG_WARNING_ASYNC("Camera: New client connected, closing the previous one.");
+		close_loop_client(sock);
+	}
+
+	if (event_loop_add_fd(loop, clientFd, EVENT_LOOP_READ, on_client_event, sock) != 0) {
+		LOG_ERROR_ASYNC("Camera: Failed to register client in the event loop.");
+		close(clientFd);
+		return;
+	}
+
+	sock->clientFd = clientFd;
+	buffer_reset(sock);
+	LOG_INFO_ASYNC("Camera: Client connected.");
+}
+
 int camera_server_init(camera_socket_t* cameraSocket, const char* ip, int port, on_objects_received_callback_t cb, void* context) {
 	if (!cameraSocket) return -1;
 
@@ -294,10 +413,46 @@ int camera_server_start(camera_socket_t* cameraSocket) {
 	return 0;
 }
 
+/**
+ * @brief Démarre le serveur socket de la caméra dans une boucle d'événements (sans thread).
+ * @details Les sockets d'écoute et du client sont non bloquantes et surveillées par la boucle :
+ * le callback de réception est appelé dans le thread de la boucle. Un nouveau client remplace
+ * le client courant (ex : reconnexion de la caméra après une coupure non détectée).
+ * @param cameraSocket Pointeur vers la structure de la socket caméra.
+ * @param loop La boucle d'événements.
+ * @return 0 en cas de succès, -1 en cas d'erreur.
+ */
+int camera_server_attach(camera_socket_t* cameraSocket, event_loop_t* loop) {
+	if (!cameraSocket || !loop || cameraSocket->running) return -1;
+
+	if (open_listen_socket(cameraSocket, true) != 0) return -1;
+
+	if (event_loop_add_fd(loop, cameraSocket->serverFd, EVENT_LOOP_READ, on_accept_event, cameraSocket) != 0) {
+		LOG_ERROR_ASYNC("Camera: Failed to register server in the event loop.");
+		close(cameraSocket->serverFd);
+		cameraSocket->serverFd = -1;
+		return -1;
+	}
+
+	cameraSocket->loop = loop;
+	cameraSocket->running = true;
+	return 0;
+}
+
 void camera_server_stop(camera_socket_t* cameraSocket) {
 	if (!cameraSocket || !cameraSocket->running) return;
 	cameraSocket->running = false;
 
+	if (cameraSocket->loop) {
+		close_loop_client(cameraSocket);
+		event_loop_remove_fd(cameraSocket->loop, cameraSocket->serverFd);
+		close(cameraSocket->serverFd);
+		cameraSocket->serverFd = -1;
+		cameraSocket->loop = NULL;
+		LOG_INFO_ASYNC("Camera: Server stopped.");
+		return;
+	}
+
 	if (cameraSocket->clientFd >= 0) {
 		shutdown(cameraSocket->clientFd, SHUT_RDWR);
 		close(cameraSocket->clientFd);
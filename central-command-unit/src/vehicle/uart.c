@@ -7,6 +7,9 @@
  * @author Lukas Grando
  * @date 2025-11-25
  */
+
+#define LOG_MODULE LOG_MODULE_UART
+
 #include "vehicle/uart.h"
 
 static speed_t get_baud(int baudrate) {
@@ -1,3 +1,5 @@
+#define LOG_MODULE LOG_MODULE_UART
+
 #include "vehicle/uart.h"
 #include "vehicle/uart_proto.h"
 #include <stdio.h>
@@ -5,10 +5,21 @@
  * Ce fichier contient la fonction main du service.
  * Ce service reste à l'écoute du topics MQTT du status des autres services
  * Lorsqu'un service ne répond plus, le broker publie le message (LWT)
+ * Le service s'exécute dans la boucle d'événements du core : messages MQTT, caméra et positions
+ * Marvelmind sont traités dans le thread principal, sans verrou sur l'état du véhicule.
  */
 
 #include "vehicle/vehicle.h"
 
+/**
+ * @brief Position Marvelmind transmise du thread d'acquisition à la boucle d'événements.
+ */
+typedef struct {
+	int32_t x;
+	int32_t y;
+	double angle;
+} vehicle_position_event_t;
+
 static void on_camera_objects_received(const camera_detected_object_t* objects, int count, void* context) {
 	UNUSED(context);
 	//LOG_DEBUG_ASYNC("Camera: Received %d objects.", count);
@@ -26,8 +37,13 @@ static void on_camera_objects_received(const camera_detected_object_t* objects,
 	on_camera_objects_logic(objects, count);
 }
 
-static void on_position_received(int32_t x, int32_t y, double angle, void* context) {
+static void handle_position(event_loop_t *loop, void *data, void *context) {
+	UNUSED(loop);
+	const vehicle_position_event_t *position = (const vehicle_position_event_t *) data;
 	int fd = *((int*)context);
+	int32_t x = position->x;
+	int32_t y = position->y;
+	double angle = position->angle;
     while (angle > 180.0) angle -= 360.0;
     while (angle < -180.0) angle += 360.0;
 
@@ -38,6 +54,16 @@ static void on_position_received(int32_t x, int32_t y, double angle, void* conte
 	on_vehicle_telemetry_logic((int16_t)x, (int16_t)y, angle_int, 0);
 }
 
+/**
+ * @brief Callback du thread d'acquisition Marvelmind : la position est traitée dans la boucle d'événements.
+ */
+static void on_position_received(int32_t x, int32_t y, double angle, void* context) {
+	vehicle_position_event_t position = { .x = x, .y = y, .angle = angle };
+	if (event_loop_post(core_get_event_loop(), handle_position, context, &position, sizeof(position)) != 0) {
+		LOG_WARNING_ASYNC("Vehicle: Event loop queue full, position dropped.");
+	}
+}
+
 int main(int argc, char **argv) {
 	config_common_t common_config;
 	vehicle_config_t vehicle_config;
@@ -45,6 +71,7 @@ int main(int argc, char **argv) {
 	char lwtTopic[255];
 
 	core_set_service_version(VEHICLE_VERSION);
+	core_use_event_loop();
 	signal_init();
 
 	if(core_bootstrap(argc, argv, &common_config, (void *) &vehicle_config, vehicle_service_config_parser, NULL, NULL) != 0) {
@@ -65,13 +92,6 @@ int main(int argc, char **argv) {
 	}
 	LOG_INFO_ASYNC("Vehicle started successfully.");
 
-	char vehicleTopic[255];
-	snprintf(vehicleTopic, sizeof(vehicleTopic), "vehicles/%d/request", vehicle_config.vehicleId);
-	mqtt_subscribe(vehicleTopic, MQTT_QOS_EXACTLY_ONCE);
-	
-	snprintf(vehicleTopic, sizeof(vehicleTopic), "vehicles/%d/response", vehicle_config.vehicleId);
-	mqtt_subscribe(vehicleTopic, MQTT_QOS_EXACTLY_ONCE);
-
 	uart_config_t uart_conf = {
 		.baudrate = vehicle_config.bauderate,
 		.timeoutMs = vehicle_config.timeoutMs,
@@ -94,7 +114,9 @@ int main(int argc, char **argv) {
     }
 
 	vehicle_init_state(uartFd, vehicle_config.vehicleId);
-    marvelmind_start_acquisition();
+	if (vehicle_local_decision_start(core_get_timer_wheel()) != 0) {
+		LOG_WARNING_ASYNC("Vehicle: Failed to start local decision timers, state will not be published.");
+	}
 
 	camera_socket_t cam_socket;
 	if (camera_server_init(&cam_socket, vehicle_config.cameraSocketBindIp, vehicle_config.cameraSocketPort, on_camera_objects_received, NULL) != 0) {
@@ -104,7 +126,7 @@ int main(int argc, char **argv) {
 		return EXIT_FAILURE;
 	}
 
-	if (camera_server_start(&cam_socket) != 0) {
+	if (camera_server_attach(&cam_socket, core_get_event_loop()) != 0) {
 		LOG_FATAL_SYNC("Échec du démarrage du serveur caméra.");
 		camera_server_cleanup(&cam_socket);
 		core_shutdown();
@@ -112,15 +134,33 @@ int main(int argc, char **argv) {
 		return EXIT_FAILURE;
 	}
 
-	mqtt_set_message_callback(vehicle_message_callback);
-	signal_wait_for_shutdown();
+	if (vehicle_register_routes(core_get_router(), vehicle_config.vehicleId) != 0) {
+		LOG_FATAL_SYNC("Failed to register MQTT routes.");
+		camera_server_cleanup(&cam_socket);
+		core_shutdown();
+		signal_cleanup();
+		return EXIT_FAILURE;
+	}
+	// Abonnements une fois l'état du véhicule initialisé et les routes enregistrées
+	char vehicleTopic[255];
+	snprintf(vehicleTopic, sizeof(vehicleTopic), "vehicles/%d/request", vehicle_config.vehicleId);
+	mqtt_subscribe(vehicleTopic, MQTT_QOS_EXACTLY_ONCE);
+	
+	snprintf(vehicleTopic, sizeof(vehicleTopic), "vehicles/%d/response", vehicle_config.vehicleId);
+	mqtt_subscribe(vehicleTopic, MQTT_QOS_EXACTLY_ONCE);
+
+	// Les positions sont postées dans la boucle : l'acquisition démarre une fois le service prêt
+    marvelmind_start_acquisition();
+	core_run();
 
 	LOG_INFO_ASYNC("Shutdown signal received. Stopping Vehicle Service...");
-	core_shutdown();
-	signal_cleanup();	
+	// Les sources de la boucle sont arrêtées avant sa libération par core_shutdown()
     marvelmind_stop_acquisition();
     marvelmind_cleanup();
+	vehicle_local_decision_stop();
 	camera_server_stop(&cam_socket);
 	camera_server_cleanup(&cam_socket);
+	core_shutdown();
+	signal_cleanup();
 	return 0;
 }
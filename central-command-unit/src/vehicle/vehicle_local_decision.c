@@ -1,5 +1,89 @@
 #include "vehicle/vehicle_local_decision.h"
 
+static timer_wheel_t *decisionWheel = NULL;
+static timer_wheel_timer_t statePublishTimer; //!< Publication périodique de l'état
+static timer_wheel_timer_t resumeTimer; //!< Reprise de la vitesse après un changement de waypoint
+static bool stateChanged = false; //!< Télémétrie reçue depuis la dernière publication
+static const mqtt_publish_options_t statePublishOptions = {
+	.priority = MQTT_PRIORITY_TELEMETRY,
+	.properties = { .messageExpirySec = VEHICLE_STATE_EXPIRY_SEC } // MQTT v5 : un état périmé n'est plus livré
+};
+
+/**
+ * @brief Publie l'état du véhicule sur vehicles/<id>/state.
+ */
+static void publish_state(const vehicle_state_t *state) {
+	vehicle_state_message_t stateMessage = {
+		.carId = state->carId,
+		.timestamp = core_get_current_timestamp_ms(),
+		.x = state->x,
+		.y = state->y,
+		.angle = (float)state->angle / 100.0f,
+		.speed = state->realSpeed,
+		.isNavigating = state->isNavigating,
+		.obstacleDetected = state->obstacleDetected
+	};
+
+	char *jsonPayload = vehicle_state_message_serialize_json(&stateMessage);
+	if (jsonPayload) {
+		char topic[255];
+		snprintf(topic, sizeof(topic), "vehicles/%d/state", state->carId);
+		// Télémétrie : pendant une coupure, les états les plus anciens cèdent la place aux commandes
+		mqtt_publish_with_options(topic, jsonPayload, strlen(jsonPayload), MQTT_QOS_EXACTLY_ONCE, false, &statePublishOptions);
+		free(jsonPayload);
+	} else {
+		LOG_ERROR_ASYNC("Vehicle: Failed to serialize vehicle state message to JSON.");	
+	}
+}
+
+/**
+ * @brief Timer de publication : publie l'état s'il a changé depuis la dernière publication.
+ */
+static void on_state_publish_timer(timer_wheel_timer_t *timer, void *context) {
+	UNUSED(timer); UNUSED(context);
+	if (!stateChanged) return;
+	stateChanged = false;
+	publish_state(vehicle_get_state());
+}
+
+/**
+ * @brief Timer de reprise : rétablit la vitesse cible après l'arrêt marqué à un waypoint.
+ */
+static void on_resume_timer(timer_wheel_timer_t *timer, void *context) {
+	UNUSED(timer); UNUSED(context);
+	vehicle_state_t *state = vehicle_get_state();
+	if (state->isNavigating && !state->obstacleDetected) {
+		protocol_send_set_speed(state->uartFd, state->targetSpeedLimit);
+	}
+}
+
+/**
+ * @brief Démarre les timers de la prise de décision locale.
+ * @details Les callbacks sont appelés dans le thread qui fait avancer la roue : celui de la
+ * boucle d'événements pour le service Vehicle, comme les autres traitements de l'état.
+ * @param wheel La roue de timers du service.
+ * @return 0 en cas de succès, -1 en cas d'erreur.
+ */
+int vehicle_local_decision_start(timer_wheel_t *wheel) {
+	if (!wheel) return -1;
+
+	decisionWheel = wheel;
+	timer_wheel_timer_init(&statePublishTimer, on_state_publish_timer, NULL);
+	timer_wheel_timer_init(&resumeTimer, on_resume_timer, NULL);
+	return timer_wheel_schedule(wheel, &statePublishTimer, 0, VEHICLE_STATE_PUBLISH_INTERVAL_MS);
+}
+
+/**
+ * @brief Arrête les timers de la prise de décision locale.
+ */
+void vehicle_local_decision_stop(void) {
+	if (!decisionWheel) return;
+
+	timer_wheel_cancel(decisionWheel, &statePublishTimer);
+	timer_wheel_cancel(decisionWheel, &resumeTimer);
+	decisionWheel = NULL;
+}
+
 /**
  * @brief Traite les objets détectés par la caméra pour la prise de décision locale.
  * @param objects Tableau des objets détectés par la caméra.
@@ -116,7 +200,7 @@ void on_vehicle_telemetry_logic(int16_t x, int16_t y, int16_t angle, int16_t spe
     state->angle = angle;
     state->realSpeed = speed;
 
-    if (!state->isNavigating || !state->route) goto publish_state;
+    if (!state->isNavigating || !state->route) goto state_updated;
 
     waypoint_t *target = &state->route[state->currentWpIndex];
     
@@ -133,8 +217,10 @@ void on_vehicle_telemetry_logic(int16_t x, int16_t y, int16_t angle, int16_t spe
             LOG_INFO_ASYNC("Vehicle: Moving to next waypoint %d (%d, %d) distance: %.2f", state->currentWpIndex, (int)next->x, (int)next->y, distance);
             protocol_send_set_position_command(state->uartFd, (int16_t)next->x, (int16_t)next->y, 0);
 			protocol_send_set_speed(state->uartFd, 0);
-			usleep(500000);
-			protocol_send_set_speed(state->uartFd, state->targetSpeedLimit);
+			// Reprise différée sans bloquer le thread (messages MQTT, caméra et positions continuent d'être traités)
+			if (!decisionWheel || timer_wheel_schedule(decisionWheel, &resumeTimer, WAYPOINT_RESUME_DELAY_MS, 0) != 0) {
+				protocol_send_set_speed(state->uartFd, state->targetSpeedLimit);
+			}
         } else {
             LOG_INFO_ASYNC("Vehicle: Destination reached");
             protocol_send_stop(state->uartFd);
@@ -142,35 +228,10 @@ void on_vehicle_telemetry_logic(int16_t x, int16_t y, int16_t angle, int16_t spe
         }
     }
 	else {
-		LOG_INFO_ASYNC("Vehicle: Current position (%d, %d), target waypoint (%d, %d), distance: %.2f", x, y, (int)target->x, (int)target->y, distance);
-	}
-
-	publish_state:
-
-	static long lastPublishTime = 0;
-	long currentTime = core_get_current_timestamp_ms();
-	if (currentTime - lastPublishTime < 3000) {
-		return;
+		LOG_DEBUG_DEFERRED("Vehicle: Current position (%d, %d), target waypoint (%d, %d), distance: %.2f", x, y, (int)target->x, (int)target->y, distance);
 	}
-	lastPublishTime = currentTime;
-	vehicle_state_message_t stateMessage = {
-		.carId = state->carId,
-		.timestamp = core_get_current_timestamp_ms(),
-		.x = state->x,
-		.y = state->y,
-		.angle = (float)state->angle / 100.0f,
-		.speed = state->realSpeed,
-		.isNavigating = state->isNavigating,
-		.obstacleDetected = state->obstacleDetected
-	};
 
-	char *jsonPayload = vehicle_state_message_serialize_json(&stateMessage);
-	if (jsonPayload) {
-		char topic[255];
-		snprintf(topic, sizeof(topic), "vehicles/%d/state", state->carId);
-		mqtt_publish(topic, jsonPayload, MQTT_QOS_EXACTLY_ONCE, false);
-		free(jsonPayload);
-	} else {
-		LOG_ERROR_ASYNC("Vehicle: Failed to serialize vehicle state message to JSON.");	
-	}
-}
\ No newline at end of file
+	state_updated:
+	// Publication limitée à une toutes les VEHICLE_STATE_PUBLISH_INTERVAL_MS par statePublishTimer
+	stateChanged = true;
+}
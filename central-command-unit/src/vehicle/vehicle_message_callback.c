@@ -24,7 +24,7 @@ static void on_start_route_request(command_header_t header) {
 	command_response_header_t responseHeader = create_command_response_header(header.commandId, true, NULL);
 	char *json = command_response_header_serialize(&responseHeader);
 	if (json) {
-		mqtt_publish(header.replyTopic, json, MQTT_QOS_AT_LEAST_ONCE, false);
+		mqtt_publish_reply(&header, json, MQTT_QOS_AT_LEAST_ONCE);
 		free(json);
 	} else {
 		LOG_ERROR_ASYNC("Vehicle: Failed to serialize command response header.");
@@ -52,73 +52,64 @@ static void on_set_waypoints_request(const set_waypoints_request_t* request) {
 }
 
 /**
- * @brief Callback pour les messages de vehicle reçus.
- * @param topic Topic MQTT du message reçu.
- * @param payload Payload du message reçu.
+ * @brief Transmet une réponse reçue au request_manager.
+ * @internal
  */
-void vehicle_message_callback(const char* topic, const char* payload) {
-	// pas très smart de ma part ici ça aurait été mieux de passer en paramètre du callback un void* context
-	// pour avoir accès à des info comme l'id du véhicule
-	// pour l'instant je peux le récupérer depuis le vehicle context global
-	LOG_DEBUG_SYNC("Received message on topic: %s", topic);
+static void on_reply(const char* topic, const void* payload, size_t length, void* context) {
+	UNUSED(topic);
+	UNUSED(context);
+	request_manager_process_payload(payload, length);
+}
 
-	vehicle_state_t* vehicleState = vehicle_get_state();
-	if (!vehicleState) {
-		LOG_ERROR_ASYNC("Vehicle state is not initialized.");
+static void on_set_waypoints_action(const char* topic, const command_header_t* header, cJSON* root, void* context) {
+	UNUSED(topic);
+	UNUSED(context);
+	set_waypoints_request_t request = { .header = *header };
+	if(set_waypoints_request_data_deserialize(root, &request) != 0) {
+		LOG_ERROR_ASYNC("Failed to deserialize set waypoints request.");
 		return;
 	}
+	on_set_waypoints_request(&request);
+}
 
-	// Gestion des réponses à nos requêtes
-	char vehicleResponseTopic[255];
-	snprintf(vehicleResponseTopic, sizeof(vehicleResponseTopic), "vehicles/%d/response", vehicleState->carId);
-	if (strcmp(topic, vehicleResponseTopic) == 0) {
-		request_manager_process_response(payload);
-		return;
-	}
+static void on_start_route_action(const char* topic, const command_header_t* header, cJSON* root, void* context) {
+	UNUSED(topic);
+	UNUSED(root);
+	UNUSED(context);
+	on_start_route_request(*header);
+}
 
-	// Gestion des commandes reçues
-	char vehicleRequestTopic[255];
-	snprintf(vehicleRequestTopic, sizeof(vehicleRequestTopic), "vehicles/%d/request", vehicleState->carId);
-	if (strcmp(topic, vehicleRequestTopic) == 0) {
-		command_header_t header = {0};
-		cJSON *root = cJSON_Parse(payload);
-		if (!root) {
-			LOG_ERROR_ASYNC("The payload is not valid JSON.");
-			return;
-		}
-		if(command_header_deserialize(root, &header) != 0) {
-			LOG_ERROR_ASYNC("Failed to deserialize command header.");
-			cJSON_Delete(root);
-			return;
-		}
-		LOG_DEBUG_ASYNC("Processing command: %s, action: %s, replyTopic: %s", header.commandId, header.action, header.replyTopic);
+static void on_stop_route_action(const char* topic, const command_header_t* header, cJSON* root, void* context) {
+	UNUSED(topic);
+	UNUSED(header);
+	UNUSED(root);
+	UNUSED(context);
+	vehicle_state_t* vehicleState = vehicle_get_state();
+	vehicleState->isNavigating = false;
+	protocol_send_set_speed(vehicleState->uartFd, 0);
+	LOG_INFO_ASYNC("Vehicle: Stopping navigation as per request.");
+}
 
-		if(strcmp(header.action, ACTION_SET_WAYPOINTS_REQUEST) == 0) {
-			set_waypoints_request_t request = { .header = header };
-			if(set_waypoints_request_data_deserialize(root, &request) != 0) {
-				LOG_ERROR_ASYNC("Failed to deserialize set waypoints request.");
-				cJSON_Delete(root);
-				return;
-			}
-			else {
-				on_set_waypoints_request(&request);
-			}
-		}
-		else if(strcmp(header.action, ACTION_START_ROUTE) == 0) {
-			on_start_route_request(header);
-		}
-		else if(strcmp(header.action, "ACTION_STOP_ROUTE") == 0) {
-			vehicleState->isNavigating = false;
-			protocol_send_set_speed(vehicleState->uartFd, 0);
-			LOG_INFO_ASYNC("Vehicle: Stopping navigation as per request.");
-		}
-		else {
-			LOG_ERROR_ASYNC("Unknown action received: %s", header.action);
-		}
+/**
+ * @brief Enregistre les routes MQTT du véhicule.
+ * @details Les topics "vehicles/<carId>/response" et "vehicles/<carId>/request" sont construits une
+ * seule fois ici, plutôt qu'à chaque message reçu.
+ * @param router Le routeur du service
+ * @param carId L'identifiant du véhicule
+ * @return 0 en cas de succès, -1 en cas d'erreur
+ */
+int vehicle_register_routes(mqtt_router_t* router, int carId) {
+	char responseTopic[255];
+	char requestTopic[255];
+	snprintf(responseTopic, sizeof(responseTopic), "vehicles/%d/response", carId);
+	snprintf(requestTopic, sizeof(requestTopic), "vehicles/%d/request", carId);
 
-		cJSON_Delete(root);
-		return;
-	}
+	int result = 0;
+	result |= mqtt_router_add_topic(router, responseTopic, on_reply, NULL);
+	result |= mqtt_router_add_action(router, requestTopic, ACTION_SET_WAYPOINTS_REQUEST, on_set_waypoints_action, NULL);
+	result |= mqtt_router_add_action(router, requestTopic, ACTION_START_ROUTE, on_start_route_action, NULL);
+	result |= mqtt_router_add_action(router, requestTopic, "ACTION_STOP_ROUTE", on_stop_route_action, NULL);
+	return result ? -1 : 0;
 }
 
 /**
@@ -0,0 +1,81 @@
+/**
+ * @file test_arena.c
+ * @brief Tests unitaires pour l'allocateur par arène et son utilisation par le graphe.
+ */
+
+#include "tests/runner.h"
+#include "core/arena.h"
+#include "core/graph.h"
+
+TEST_REGISTER(test_arena_alloc_alignment, "Test arène : allocations alignées et distinctes") {
+    arena_t* arena = arena_create(128);
+    TEST_ASSERT(arena != NULL, "La création de l'arène ne doit pas échouer");
+
+    char* a = arena_alloc(arena, 3);
+    double* b = arena_alloc(arena, sizeof(double));
+    TEST_ASSERT(a != NULL && b != NULL, "Les allocations doivent réussir");
+    TEST_ASSERT(((uintptr_t)b % ARENA_ALIGNMENT) == 0, "Les allocations doivent être alignées");
+    TEST_ASSERT((char*)b >= a + 3, "Les zones ne doivent pas se chevaucher");
+
+    int* zeros = arena_calloc(arena, 16, sizeof(int));
+    bool allZero = zeros != NULL;
+    for (int i = 0; allZero && i < 16; i++) allZero = zeros[i] == 0;
+    TEST_ASSERT(allZero, "arena_calloc doit initialiser la zone à zéro");
+
+    TEST_ASSERT(arena_calloc(arena, SIZE_MAX, 2) == NULL, "Un dépassement de taille doit être refusé");
+
+    arena_destroy(arena);
+}
+
+TEST_REGISTER(test_arena_growth_and_reset, "Test arène : croissance des blocs et réutilisation après reset") {
+    arena_t* arena = arena_create(256);
+
+    // Plus que le premier bloc : l'arène doit chaîner de nouveaux blocs
+    for (int i = 0; i < 100; i++) {
+        TEST_ASSERT(arena_alloc(arena, 64) != NULL, "Les allocations successives doivent réussir");
+    }
+    size_t blocks = arena->blockCount;
+    TEST_ASSERT(blocks > 1, "Plusieurs blocs doivent avoir été alloués");
+    TEST_ASSERT(arena_used(arena) >= 100 * 64, "Les octets distribués doivent être comptabilisés");
+
+    // Une demande plus grande que les blocs obtient un bloc dédié
+    TEST_ASSERT(arena_alloc(arena, 1024 * 1024) != NULL, "Une grosse allocation doit réussir");
+
+    arena_reset(arena);
+    TEST_ASSERT(arena_used(arena) == 0, "Le reset doit invalider toutes les allocations");
+
+    blocks = arena->blockCount;
+    for (int i = 0; i < 100; i++) {
+        arena_alloc(arena, 64);
+    }
+    TEST_ASSERT(arena->blockCount == blocks, "Après un reset, les blocs existants doivent être réutilisés");
+
+    arena_destroy(arena);
+    arena_destroy(NULL);
+}
+
+TEST_REGISTER(test_graph_arena_backed, "Test arène : le graphe et ses arcs sont alloués dans une arène") {
+    graph_t* g = graph_create(1000);
+    TEST_ASSERT(g != NULL && g->arena != NULL, "Le graphe doit posséder son arène");
+
+    for (int i = 0; i < 999; i++) {
+        graph_add_edge(g, i, i + 1, 1.0, LANE_RULE_DRIVE_RIGHT);
+        graph_add_edge(g, i + 1, i, 1.0, LANE_RULE_DRIVE_RIGHT);
+    }
+    TEST_ASSERT(g->arena->blockCount == 1, "Les arcs doivent tenir dans le bloc pré-dimensionné");
+    TEST_ASSERT(graph_get_edge(g, 500, 501) != NULL, "Les arcs doivent être accessibles");
+
+    // Chemin alloué dans une arène
+    arena_t* arena = arena_create(0);
+    path_t path = EMPTY_PATH_IN(arena);
+    path_t segment = { .nodes = (node_t*[]){ &g->nodes[0], &g->nodes[1] }, .length = 2 };
+    path_t segment2 = { .nodes = (node_t*[]){ &g->nodes[1], &g->nodes[2] }, .length = 2 };
+    path_append(&path, &segment);
+    path_append(&path, &segment2);
+    TEST_ASSERT(path.length == 3, "Le doublon de jonction doit être supprimé");
+    TEST_ASSERT(path.nodes[2] == &g->nodes[2], "Le chemin doit se terminer sur le noeud 2");
+    path_destroy(&path); // Sans effet : libéré avec l'arène
+
+    arena_destroy(arena);
+    graph_destroy(g);
+}
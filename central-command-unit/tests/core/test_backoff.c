@@ -0,0 +1,31 @@
+/**
+ * @file test_backoff.c
+ * @brief Tests unitaires pour les délais de nouvelle tentative.
+ */
+
+#include "tests/runner.h"
+#include "core/backoff.h"
+
+TEST_REGISTER(test_backoff_growth, "Test backoff : croissance exponentielle, plafond et gigue") {
+    backoff_t backoff;
+    backoff_init(&backoff, 100, 1000);
+
+    uint32_t expected[] = { 100, 200, 400, 800, 1000, 1000 };
+    bool inRange = true;
+    for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        uint32_t delay = backoff_next(&backoff);
+        if (delay < expected[i] / 2 || delay > expected[i]) inRange = false;
+    }
+    TEST_ASSERT(inRange, "Chaque délai doit être dans [d/2, d], d doublant jusqu'au plafond");
+
+    backoff_reset(&backoff);
+    uint32_t delay = backoff_next(&backoff);
+    TEST_ASSERT(delay >= 50 && delay <= 100, "Après un succès, le délai doit revenir au minimum");
+
+    // La gigue doit étaler les délais d'un même palier
+    backoff_init(&backoff, 10000, 10000);
+    uint32_t first = backoff_next(&backoff);
+    bool spread = false;
+    for (int i = 0; i < 32 && !spread; i++) spread = backoff_next(&backoff) != first;
+    TEST_ASSERT(spread, "Les délais doivent varier d'une tentative à l'autre");
+}
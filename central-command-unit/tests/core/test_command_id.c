@@ -0,0 +1,60 @@
+/**
+ * @file test_command_id.c
+ * @brief Tests unitaires pour le générateur d'identifiants de commande.
+ */
+
+#include "tests/runner.h"
+#include "core/command_id.h"
+#include "core/mqtt_messages/command_header.h"
+
+enum { ID_THREADS = 4, IDS_PER_THREAD = 50000 };
+
+static uint64_t generatedIds[ID_THREADS * IDS_PER_THREAD];
+
+static void* generate_ids(void* arg) {
+    uint64_t* ids = (uint64_t*)arg;
+    for (int i = 0; i < IDS_PER_THREAD; i++) ids[i] = command_id_next();
+    return NULL;
+}
+
+static int compare_ids(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+TEST_REGISTER(test_command_id_unique, "Test command id : unicité entre threads") {
+    pthread_t threads[ID_THREADS];
+    for (int i = 0; i < ID_THREADS; i++) {
+        pthread_create(&threads[i], NULL, generate_ids, &generatedIds[i * IDS_PER_THREAD]);
+    }
+    for (int i = 0; i < ID_THREADS; i++) pthread_join(threads[i], NULL);
+
+    qsort(generatedIds, ID_THREADS * IDS_PER_THREAD, sizeof(uint64_t), compare_ids);
+    bool unique = true;
+    for (int i = 1; i < ID_THREADS * IDS_PER_THREAD; i++) {
+        if (generatedIds[i] == generatedIds[i - 1]) unique = false;
+    }
+    TEST_ASSERT(unique && generatedIds[0] != 0, "Les identifiants générés en parallèle doivent être uniques et non nuls");
+}
+
+TEST_REGISTER(test_command_id_format, "Test command id : forme texte, relecture et IDs externes") {
+    char buffer[COMMAND_ID_LENGTH];
+    uint64_t id = 0;
+    TEST_ASSERT(command_id_format(buffer, sizeof(buffer), "GET_MAP_REQUEST", 0x00ab0000000012efULL) == 32, "La longueur écrite doit être retournée");
+    TEST_ASSERT(strcmp(buffer, "GET_MAP_REQUEST-00ab0000000012ef") == 0, "L'ID doit être encodé sur 16 chiffres hexadécimaux derrière l'action");
+    TEST_ASSERT(command_id_parse(buffer, &id) == 0 && id == 0x00ab0000000012efULL, "La forme texte doit se relire");
+
+    // Action trop longue : la partie hexadécimale est conservée
+    char longAction[100];
+    memset(longAction, 'A', sizeof(longAction) - 1);
+    longAction[sizeof(longAction) - 1] = '\0';
+    command_id_format(buffer, sizeof(buffer), longAction, 42);
+    TEST_ASSERT(strlen(buffer) == COMMAND_ID_LENGTH - 1 && command_id_parse(buffer, &id) == 0 && id == 42, "Le préfixe doit être tronqué");
+
+    TEST_ASSERT(command_id_parse("REQ_PLAN_1700000000000", &id) == -1, "Un ID de l'API ne doit pas être relu");
+    TEST_ASSERT(command_id_parse("PLAN-00AB0000000012EF", &id) == -1, "Seuls les chiffres hexadécimaux minuscules sont produits");
+
+    command_header_t header = create_command_header("PLAN_ROUTE_REQUEST", "services/test/response");
+    TEST_ASSERT(strncmp(header.commandId, "PLAN_ROUTE_REQUEST-", 19) == 0, "L'ID doit garder l'action en préfixe");
+    TEST_ASSERT(command_id_parse(header.commandId, &id) == 0, "L'ID d'un en-tête doit se relire");
+}
@@ -0,0 +1,166 @@
+/**
+ * @file test_event_loop.c
+ * @brief Tests unitaires pour la boucle d'événements (epoll, timerfd, eventfd).
+ */
+
+#include "tests/runner.h"
+#include "core/event_loop.h"
+
+typedef struct {
+    int calls;
+    uint32_t lastEvents;
+    char received[32];
+    int otherFd; //!< Descripteur retiré par le callback (-1 : aucun)
+} fd_test_context_t;
+
+static void on_readable(event_loop_t* loop, int fd, uint32_t events, void* context) {
+    fd_test_context_t* ctx = (fd_test_context_t*)context;
+    ctx->calls++;
+    ctx->lastEvents = events;
+    ssize_t n = read(fd, ctx->received, sizeof(ctx->received) - 1);
+    if (n > 0) ctx->received[n] = '\0';
+    if (ctx->otherFd >= 0) {
+        event_loop_remove_fd(loop, ctx->otherFd);
+        ctx->otherFd = -1;
+    }
+}
+
+TEST_REGISTER(test_event_loop_fd, "Test boucle d'événements : descripteurs prêts, modification et retrait") {
+    event_loop_t* loop = event_loop_create();
+    TEST_ASSERT(loop != NULL, "La création de la boucle ne doit pas échouer");
+
+    int first[2], second[2];
+    TEST_ASSERT(pipe(first) == 0 && pipe(second) == 0, "La création des pipes doit réussir");
+
+    fd_test_context_t ctxFirst = { .otherFd = second[0] };
+    fd_test_context_t ctxSecond = { .otherFd = -1 };
+    TEST_ASSERT(event_loop_add_fd(loop, first[0], EVENT_LOOP_READ, on_readable, &ctxFirst) == 0, "L'ajout d'un descripteur doit réussir");
+    TEST_ASSERT(event_loop_add_fd(loop, second[0], EVENT_LOOP_READ, on_readable, &ctxSecond) == 0, "L'ajout d'un second descripteur doit réussir");
+    TEST_ASSERT(event_loop_add_fd(loop, first[0], EVENT_LOOP_READ, on_readable, &ctxFirst) == -1, "Un descripteur déjà surveillé doit être refusé");
+
+    TEST_ASSERT(event_loop_run_once(loop, 0) == 0, "Aucun événement ne doit être signalé sans données");
+
+    // Le premier callback retire le second descripteur, prêt dans la même itération : il ne doit pas être appelé
+    TEST_ASSERT(write(first[1], "hello", 5) == 5 && write(second[1], "x", 1) == 1, "L'écriture dans les pipes doit réussir");
+    event_loop_run_once(loop, 100);
+    TEST_ASSERT(ctxFirst.calls == 1 && (ctxFirst.lastEvents & EVENT_LOOP_READ), "Le callback doit être appelé une fois en lecture");
+    TEST_ASSERT(strcmp(ctxFirst.received, "hello") == 0, "Le callback doit lire les données écrites");
+    if (ctxSecond.calls == 0) {
+        event_loop_run_once(loop, 0);
+        TEST_ASSERT(ctxSecond.calls == 0, "Un descripteur retiré ne doit plus être signalé");
+    }
+    TEST_ASSERT(event_loop_remove_fd(loop, second[0]) == -1, "Retirer un descripteur absent doit échouer");
+
+    // Intérêt en écriture : l'extrémité d'écriture d'un pipe vide est toujours prête
+    fd_test_context_t ctxWrite = { .otherFd = -1 };
+    TEST_ASSERT(event_loop_add_fd(loop, first[1], 0, on_readable, &ctxWrite) == 0, "L'ajout sans intérêt doit réussir");
+    event_loop_run_once(loop, 0);
+    TEST_ASSERT(ctxWrite.calls == 0, "Un descripteur sans intérêt ne doit pas être signalé");
+    TEST_ASSERT(event_loop_modify_fd(loop, first[1], EVENT_LOOP_WRITE) == 0, "La modification de l'intérêt doit réussir");
+    event_loop_run_once(loop, 100);
+    TEST_ASSERT(ctxWrite.calls >= 1 && (ctxWrite.lastEvents & EVENT_LOOP_WRITE), "Le descripteur doit être signalé prêt en écriture");
+
+    event_loop_destroy(loop);
+    close(first[0]); close(first[1]); close(second[0]); close(second[1]);
+}
+
+typedef struct {
+    int periodic;
+    int oneShot;
+} timer_test_context_t;
+
+static void on_periodic(event_loop_t* loop, event_loop_timer_t* timer, void* context) {
+    timer_test_context_t* ctx = (timer_test_context_t*)context;
+    if (++ctx->periodic == 3) event_loop_cancel_timer(loop, timer);
+}
+
+static void on_one_shot(event_loop_t* loop, event_loop_timer_t* timer, void* context) {
+    UNUSED(loop); UNUSED(timer);
+    ((timer_test_context_t*)context)->oneShot++;
+}
+
+TEST_REGISTER(test_event_loop_timers, "Test boucle d'événements : timers périodiques et ponctuels") {
+    event_loop_t* loop = event_loop_create();
+    timer_test_context_t ctx = { 0 };
+
+    event_loop_timer_t* periodic = event_loop_add_timer(loop, 5, 5, on_periodic, &ctx);
+    event_loop_timer_t* oneShot = event_loop_add_timer(loop, 20, 0, on_one_shot, &ctx);
+    TEST_ASSERT(periodic != NULL && oneShot != NULL, "La création des timers doit réussir");
+    TEST_ASSERT(event_loop_add_timer(loop, -1, 0, on_one_shot, &ctx) == NULL, "Un délai négatif doit être refusé");
+
+    for (int i = 0; i < 50 && (ctx.periodic < 3 || ctx.oneShot < 1); i++) {
+        event_loop_run_once(loop, 50);
+    }
+    TEST_ASSERT(ctx.periodic == 3, "Le timer périodique doit expirer trois fois puis être annulé par son callback");
+    TEST_ASSERT(ctx.oneShot == 1, "Le timer ponctuel doit expirer une fois");
+
+    event_loop_run_once(loop, 30);
+    TEST_ASSERT(ctx.periodic == 3 && ctx.oneShot == 1, "Aucune expiration ne doit suivre l'annulation ou le timer ponctuel");
+
+    // Réarmement du timer ponctuel
+    TEST_ASSERT(event_loop_timer_set(oneShot, 1, 0) == 0, "Le réarmement doit réussir");
+    for (int i = 0; i < 20 && ctx.oneShot < 2; i++) event_loop_run_once(loop, 50);
+    TEST_ASSERT(ctx.oneShot == 2, "Le timer réarmé doit expirer de nouveau");
+
+    event_loop_cancel_timer(loop, oneShot);
+    event_loop_destroy(loop);
+}
+
+typedef struct {
+    event_loop_t* loop;
+    int posts;
+} post_thread_context_t;
+
+typedef struct {
+    int sum;
+    int count;
+    pthread_t executor;
+    bool wrongThread;
+} post_test_context_t;
+
+static void on_posted(event_loop_t* loop, void* data, void* context) {
+    UNUSED(loop);
+    post_test_context_t* ctx = (post_test_context_t*)context;
+    ctx->sum += *(int*)data;
+    ctx->count++;
+    if (!pthread_equal(ctx->executor, pthread_self())) ctx->wrongThread = true;
+}
+
+static post_test_context_t postCtx;
+
+static void* post_thread(void* arg) {
+    post_thread_context_t* ctx = (post_thread_context_t*)arg;
+    for (int i = 1; i <= ctx->posts; i++) {
+        while (event_loop_post(ctx->loop, on_posted, &postCtx, &i, sizeof(i)) != 0) usleep(100);
+    }
+    event_loop_stop(ctx->loop);
+    return NULL;
+}
+
+TEST_REGISTER(test_event_loop_post_and_stop, "Test boucle d'événements : tâches postées depuis un autre thread et arrêt") {
+    event_loop_t* loop = event_loop_create();
+    memset(&postCtx, 0, sizeof(postCtx));
+    postCtx.executor = pthread_self();
+
+    char tooLarge[EVENT_LOOP_POST_DATA_SIZE + 1] = { 0 };
+    TEST_ASSERT(event_loop_post(loop, on_posted, &postCtx, tooLarge, sizeof(tooLarge)) == -1, "Des données trop grandes doivent être refusées");
+
+    // 1000 tâches pour une file de 256 : le producteur attend que la boucle libère des cases
+    post_thread_context_t threadCtx = { loop, 1000 };
+    pthread_t thread;
+    pthread_create(&thread, NULL, post_thread, &threadCtx);
+    TEST_ASSERT(event_loop_run(loop) == 0, "La boucle doit s'arrêter sur demande");
+    pthread_join(thread, NULL);
+
+    // Les tâches postées avant l'arrêt mais pas encore traitées
+    while (postCtx.count < 1000 && event_loop_run_once(loop, 100) > 0) {}
+    TEST_ASSERT(postCtx.count == 1000, "Toutes les tâches doivent être exécutées");
+    TEST_ASSERT(postCtx.sum == 1000 * 1001 / 2, "Chaque tâche doit recevoir sa copie des données");
+    TEST_ASSERT(!postCtx.wrongThread, "Les tâches doivent être exécutées dans le thread de la boucle");
+
+    // Un arrêt demandé avant event_loop_run() est pris en compte immédiatement
+    event_loop_stop(loop);
+    TEST_ASSERT(event_loop_run(loop) == 0, "Un arrêt en attente doit terminer la boucle immédiatement");
+
+    event_loop_destroy(loop);
+}
@@ -65,4 +65,21 @@ TEST_REGISTER(test_fifo_order, "Vérifie que FIFO conserve l'ordre d'insertion")
     int *p3 = (int*)fifo_pop(&f);
 
     TEST_ASSERT(*p1 == 100 && *p2 == 200 && *p3 == 300, "FIFO doit renvoyer les éléments dans l'ordre d'insertion");
-}
\ No newline at end of file
+}
+// Test FIFO utilisable après un pop sur file vide (le verrou doit être relâché)
+TEST_REGISTER(test_fifo_pop_empty_releases_lock, "Vérifie qu'un pop sur FIFO vide ne bloque pas les opérations suivantes") {
+    fifo_t f, other;
+    fifo_init(&f);
+    fifo_init(&other);
+
+    TEST_ASSERT(fifo_pop(&f) == NULL, "Pop sur FIFO vide doit renvoyer NULL");
+
+    int v = 42;
+    fifo_push(&f, &v);
+    fifo_push(&other, &v);
+    TEST_ASSERT(fifo_pop(&f) == &v, "La FIFO doit rester utilisable après un pop vide");
+    TEST_ASSERT(fifo_pop(&other) == &v, "Chaque FIFO doit avoir son propre verrou");
+
+    fifo_destroy(&f);
+    fifo_destroy(&other);
+}
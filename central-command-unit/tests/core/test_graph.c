@@ -52,4 +52,47 @@ TEST_REGISTER(test_graph_api_basic, "Test de l'API de base du graphe (création,
     // 6. Tester la destruction
     graph_destroy(g);
     // Note : On ne peut pas ASSERT la destruction, mais valgrind confirmera qu'il n'y a pas de fuite.
-}
\ No newline at end of file
+}
+
+TEST_REGISTER(test_path_builder, "Test du constructeur de chemin (push, doublement, inversion, IDs)") {
+    graph_t* g = graph_create(100);
+    path_t path = EMPTY_PATH;
+
+    for (int i = 0; i < 100; i++) {
+        TEST_ASSERT(path_push(&path, graph_get_node(g, i)), "path_push doit réussir");
+    }
+    TEST_ASSERT(path.length == 100, "Le chemin doit contenir 100 nœuds");
+    TEST_ASSERT(path.capacity >= 100 && path.capacity < 200, "La capacité doit croître par doublement");
+
+    path_reverse(&path);
+    TEST_ASSERT(path.nodes[0]->id == 99 && path.nodes[99]->id == 0, "Le chemin doit être inversé en place");
+
+    int* ids = path_emit_ids(&path, NULL);
+    TEST_ASSERT(ids != NULL && ids[0] == 99 && ids[50] == 49, "Les IDs émis doivent suivre l'ordre du chemin");
+    free(ids);
+
+    // Concaténation : le doublon de jonction est supprimé
+    path_t tail = EMPTY_PATH;
+    path_push(&tail, graph_get_node(g, 0));
+    path_push(&tail, graph_get_node(g, 42));
+    path_append(&path, &tail);
+    TEST_ASSERT(path.length == 101, "La jonction commune ne doit pas être dupliquée");
+    TEST_ASSERT(path.nodes[100]->id == 42, "Le dernier nœud doit être 42");
+
+    TEST_ASSERT(path_emit_ids(&EMPTY_PATH, NULL) == NULL, "Un chemin vide ne produit aucun ID");
+
+    path_destroy(&tail);
+    path_destroy(&path);
+    graph_destroy(g);
+}
+
+TEST_REGISTER(test_node_get_edge_to, "Test de la recherche d'arête par nœuds") {
+    graph_t* g = graph_create(3);
+    graph_add_edge(g, 0, 1, 2.0, LANE_RULE_DRIVE_LEFT);
+
+    edge_t* edge = node_get_edge_to(graph_get_node(g, 0), graph_get_node(g, 1));
+    TEST_ASSERT(edge != NULL && edge->drivingRule == LANE_RULE_DRIVE_LEFT, "L'arête 0 -> 1 doit être trouvée");
+    TEST_ASSERT(node_get_edge_to(graph_get_node(g, 1), graph_get_node(g, 0)) == NULL, "L'arête 1 -> 0 n'existe pas");
+
+    graph_destroy(g);
+}
@@ -0,0 +1,69 @@
+/**
+ * @file test_log_batcher.c
+ * @brief Tests unitaires du regroupement des messages de log avant publication.
+ */
+
+#include "tests/runner.h"
+#include "core/log_batcher.h"
+
+typedef struct {
+    int batches;
+    int lastCount;
+    int lastTotal; // Somme des compteurs du dernier lot
+    log_level_t lastLevel;
+    char firstMessage[LOG_MESSAGE_LENGTH];
+} batch_capture_t;
+
+static void capture_publish(const log_batch_entry_t* entries, int count, void* context) {
+    batch_capture_t* capture = (batch_capture_t*)context;
+    capture->batches++;
+    capture->lastCount = count;
+    capture->lastTotal = 0;
+    for (int i = 0; i < count; i++) capture->lastTotal += entries[i].count;
+    capture->lastLevel = entries[count - 1].level;
+    snprintf(capture->firstMessage, sizeof(capture->firstMessage), "%s", entries[0].message);
+}
+
+TEST_REGISTER(test_log_batcher_coalesce, "Test regroupement : messages identiques et taille maximale") {
+    batch_capture_t capture = {0};
+    log_batcher_t batcher;
+    log_batcher_init(&batcher, 4, 1000, capture_publish, &capture);
+
+    for (int i = 0; i < 10; i++) log_batcher_add(&batcher, LOG_LEVEL_DEBUG, "Polling", 0, 100);
+    log_batcher_add(&batcher, LOG_LEVEL_INFO, "Polling", 0, 100);
+    TEST_ASSERT(capture.batches == 0, "Aucune publication avant la fin de la fenêtre");
+    TEST_ASSERT(batcher.count == 2, "Messages identiques regroupés, niveau différent séparé");
+    TEST_ASSERT(batcher.entries[0].count == 10, "Le compteur doit valoir 10");
+
+    log_batcher_add(&batcher, LOG_LEVEL_DEBUG, "A", 0, 100);
+    log_batcher_add(&batcher, LOG_LEVEL_DEBUG, "B", 0, 101);
+    TEST_ASSERT(capture.batches == 1 && capture.lastCount == 4, "Le lot plein doit être publié");
+    TEST_ASSERT(capture.lastTotal == 13, "Le lot doit représenter les 13 messages");
+    TEST_ASSERT(strcmp(capture.firstMessage, "Polling") == 0, "Ordre de première occurrence conservé");
+    TEST_ASSERT(batcher.count == 0, "Le lot doit être vide après publication");
+}
+
+TEST_REGISTER(test_log_batcher_window_and_errors, "Test regroupement : fenêtre temporelle et erreurs immédiates") {
+    batch_capture_t capture = {0};
+    log_batcher_t batcher;
+    log_batcher_init(&batcher, 64, 500, capture_publish, &capture);
+
+    log_batcher_add(&batcher, LOG_LEVEL_INFO, "Start", 1000, 1);
+    log_batcher_tick(&batcher, 1400);
+    TEST_ASSERT(capture.batches == 0, "La fenêtre n'est pas écoulée");
+    log_batcher_tick(&batcher, 1500);
+    TEST_ASSERT(capture.batches == 1 && capture.lastCount == 1, "La fenêtre écoulée doit publier le lot");
+
+    log_batcher_add(&batcher, LOG_LEVEL_INFO, "Before error", 2000, 2);
+    log_batcher_add(&batcher, LOG_LEVEL_ERROR, "Failure", 2001, 2);
+    TEST_ASSERT(capture.batches == 2 && capture.lastCount == 2, "Une erreur doit publier le lot immédiatement");
+    TEST_ASSERT(capture.lastLevel == LOG_LEVEL_ERROR, "L'erreur doit être la dernière entrée du lot");
+
+    log_batcher_flush(&batcher);
+    TEST_ASSERT(capture.batches == 2, "Un lot vide ne doit pas être publié");
+
+    log_batcher_t single;
+    log_batcher_init(&single, 1, 500, capture_publish, &capture);
+    log_batcher_add(&single, LOG_LEVEL_DEBUG, "Unbatched", 3000, 3);
+    TEST_ASSERT(capture.batches == 3, "Une taille de lot de 1 désactive le regroupement");
+}
@@ -0,0 +1,41 @@
+/**
+ * @file test_log_compile_level.c
+ * @brief Tests unitaires de l'élimination des logs à la compilation (LOG_COMPILE_LEVEL).
+ */
+
+// Compilation au niveau WARNING : DEBUG et INFO sont éliminés
+#undef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL 2
+
+#include "tests/runner.h"
+#include "core/logger.h"
+
+static int compileLevelCalls = 0;
+
+static void testCompileLevelCallback(log_level_t level, const char *msg) {
+    UNUSED(level);
+    UNUSED(msg);
+    compileLevelCalls++;
+}
+
+static int side_effect(int* counter) {
+    return ++(*counter);
+}
+
+TEST_REGISTER(test_log_compile_level, "Test que les logs sous LOG_COMPILE_LEVEL ne sont ni appelés ni évalués") {
+    logger_init(LOG_LEVEL_DEBUG, testCompileLevelCallback);
+    compileLevelCalls = 0;
+    int evaluated = 0;
+
+    LOG_DEBUG_SYNC("%d", side_effect(&evaluated));
+    LOG_INFO_SYNC("%d", side_effect(&evaluated));
+    LOG_DEBUG_ASYNC("%d", side_effect(&evaluated));
+    LOG_DEBUG_DEFERRED("%d", side_effect(&evaluated));
+    TEST_ASSERT(evaluated == 0, "Les arguments des appels éliminés ne doivent pas être évalués");
+    TEST_ASSERT(compileLevelCalls == 0, "Les appels éliminés ne doivent pas atteindre le callback");
+
+    LOG_WARNING_SYNC("%d", side_effect(&evaluated));
+    TEST_ASSERT(evaluated == 1 && compileLevelCalls == 1, "Les niveaux au-dessus du seuil restent actifs");
+
+    logger_destroy();
+}
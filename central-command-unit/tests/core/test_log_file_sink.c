@@ -0,0 +1,152 @@
+/**
+ * @file test_log_file_sink.c
+ * @brief Tests unitaires du journal local (écriture par lots, rotation).
+ */
+
+#undef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL 0
+
+#include "tests/runner.h"
+#include "core/logger.h"
+#include "core/log_file_sink.h"
+#include <sys/stat.h>
+
+#define TEST_LOG_PATH "/tmp/ccu_test_file_sink.log"
+
+static void remove_test_files(void) {
+    char path[LOG_FILE_SINK_PATH_LENGTH + 16];
+    unlink(TEST_LOG_PATH);
+    for (int i = 1; i <= 3; i++) {
+        snprintf(path, sizeof(path), "%s.%d", TEST_LOG_PATH, i);
+        unlink(path);
+    }
+}
+
+static long file_size(const char *path) {
+    struct stat st;
+    return stat(path, &st) == 0 ? (long) st.st_size : -1;
+}
+
+static int read_file(const char *path, char *buffer, size_t size) {
+    FILE *file = fopen(path, "r");
+    if (!file) return -1;
+    size_t length = fread(buffer, 1, size - 1, file);
+    buffer[length] = '\0';
+    fclose(file);
+    return (int) length;
+}
+
+static void silent_callback(log_level_t level, const char *msg) {
+    UNUSED(level);
+    UNUSED(msg);
+}
+
+static int count_lines(const char *text) {
+    int lines = 0;
+    for (const char *c = text; *c; c++) {
+        if (*c == '\n') lines++;
+    }
+    return lines;
+}
+
+TEST_REGISTER(test_log_file_sink_batch, "Test journal local : lot écrit en un writev, en-têtes et ajout") {
+    remove_test_files();
+    log_file_sink_config_t config = { .path = TEST_LOG_PATH, .fsyncPolicy = LOG_FSYNC_BATCH };
+    log_file_sink_t sink;
+    TEST_ASSERT(log_file_sink_open(&sink, &config) == 0, "L'ouverture doit réussir");
+
+    uint64_t timestampNs = 1760000000ULL * 1000000000ULL + 123000000ULL;
+    log_file_sink_add(&sink, LOG_LEVEL_INFO, timestampNs, "first message");
+    log_file_sink_add(&sink, LOG_LEVEL_ERROR, timestampNs, "second message");
+    TEST_ASSERT(file_size(TEST_LOG_PATH) == 0, "Rien ne doit être écrit avant le commit");
+
+    TEST_ASSERT(log_file_sink_commit(&sink, 0) == 0, "Le commit doit réussir");
+    char content[1024];
+    read_file(TEST_LOG_PATH, content, sizeof(content));
+    TEST_ASSERT(count_lines(content) == 2, "Deux lignes doivent être écrites");
+    TEST_ASSERT(strstr(content, ".123 [INFO] first message\n") != NULL, "En-tête (millisecondes, niveau) et message");
+    TEST_ASSERT(strstr(content, "[ERROR] second message\n") != NULL, "Le second message doit suivre");
+    log_file_sink_close(&sink);
+
+    // Réouverture en ajout
+    TEST_ASSERT(log_file_sink_open(&sink, &config) == 0, "La réouverture doit réussir");
+    log_file_sink_add(&sink, LOG_LEVEL_WARNING, timestampNs, "third message");
+    log_file_sink_close(&sink);
+    read_file(TEST_LOG_PATH, content, sizeof(content));
+    TEST_ASSERT(count_lines(content) == 3, "Le fichier doit être complété, pas tronqué");
+
+    // Un lot plein est écrit automatiquement
+    TEST_ASSERT(log_file_sink_open(&sink, &config) == 0, "La réouverture doit réussir");
+    for (int i = 0; i < LOG_FILE_SINK_MAX_LINES + 1; i++) {
+        log_file_sink_add(&sink, LOG_LEVEL_DEBUG, timestampNs, "line");
+    }
+    TEST_ASSERT(sink.lineCount == 1 && sink.written == LOG_FILE_SINK_MAX_LINES, "Le lot plein doit être écrit avant la ligne suivante");
+    log_file_sink_close(&sink);
+
+    remove_test_files();
+}
+
+TEST_REGISTER(test_log_file_sink_rotation, "Test journal local : rotation par taille et par durée") {
+    remove_test_files();
+    log_file_sink_config_t config = { .path = TEST_LOG_PATH, .maxBytes = 200, .maxFiles = 2, .fsyncPolicy = LOG_FSYNC_NEVER };
+    log_file_sink_t sink;
+    TEST_ASSERT(log_file_sink_open(&sink, &config) == 0, "L'ouverture doit réussir");
+
+    char message[128];
+    memset(message, 'x', 100);
+    message[100] = '\0';
+    for (int i = 0; i < 6; i++) {
+        log_file_sink_add(&sink, LOG_LEVEL_INFO, 0, message);
+        log_file_sink_commit(&sink, 0);
+    }
+    // Chaque ligne dépasse 100 octets : rotation toutes les deux lignes
+    TEST_ASSERT(sink.rotations == 3, "Trois rotations attendues");
+    TEST_ASSERT(file_size(TEST_LOG_PATH ".1") > 200 && file_size(TEST_LOG_PATH ".2") > 200, "Deux archives conservées");
+    TEST_ASSERT(file_size(TEST_LOG_PATH ".3") == -1, "Pas plus de maxFiles archives");
+    TEST_ASSERT(file_size(TEST_LOG_PATH) == 0, "Le fichier courant est neuf");
+    log_file_sink_close(&sink);
+
+    // Rotation par durée, pilotée par l'horodatage fourni
+    remove_test_files();
+    config = (log_file_sink_config_t) { .path = TEST_LOG_PATH, .maxFiles = 1, .rotateIntervalSec = 60, .fsyncPolicy = LOG_FSYNC_INTERVAL, .fsyncIntervalMs = 1000 };
+    TEST_ASSERT(log_file_sink_open(&sink, &config) == 0, "L'ouverture doit réussir");
+    long now = sink.openedAtMs;
+    TEST_ASSERT(log_file_sink_next_timeout(&sink, now) == -1, "Aucune échéance tant que rien n'est écrit");
+
+    log_file_sink_add(&sink, LOG_LEVEL_INFO, 0, "timed");
+    log_file_sink_commit(&sink, now);
+    TEST_ASSERT(sink.dirty && log_file_sink_next_timeout(&sink, now) == 1000, "Prochaine échéance : synchronisation périodique");
+
+    log_file_sink_tick(&sink, now + 1000);
+    TEST_ASSERT(!sink.dirty && sink.rotations == 0, "Synchronisation sans rotation");
+    TEST_ASSERT(log_file_sink_next_timeout(&sink, now + 1000) == 59000, "Prochaine échéance : rotation");
+
+    log_file_sink_tick(&sink, now + 60000);
+    TEST_ASSERT(sink.rotations == 1 && file_size(TEST_LOG_PATH ".1") > 0, "Rotation après rotateIntervalSec");
+    log_file_sink_close(&sink);
+
+    remove_test_files();
+}
+
+TEST_REGISTER(test_logger_file_sink, "Test logger : journal local alimenté par le thread de journalisation") {
+    remove_test_files();
+    logger_init(LOG_LEVEL_INFO, silent_callback);
+    log_file_sink_config_t config = { .path = TEST_LOG_PATH, .fsyncPolicy = LOG_FSYNC_NEVER };
+    TEST_ASSERT(logger_set_file_sink(&config) == 0, "Le journal local doit s'ouvrir");
+
+    for (int i = 0; i < 100; i++) {
+        LOG_INFO_ASYNC("async %d", i);
+    }
+    LOG_DEBUG_ASYNC("filtered");
+    LOG_INFO_DEFERRED("deferred %d", 7);
+    LOG_WARNING_SYNC("sync");
+    logger_destroy();
+
+    static char content[16384];
+    read_file(TEST_LOG_PATH, content, sizeof(content));
+    TEST_ASSERT(count_lines(content) == 102, "Tous les messages non filtrés doivent être écrits");
+    TEST_ASSERT(strstr(content, "[INFO] async 99\n") && strstr(content, "[INFO] deferred 7\n"), "Messages asynchrones et différés");
+    TEST_ASSERT(strstr(content, "[WARNING] sync\n") && !strstr(content, "filtered"), "Message synchrone écrit, DEBUG filtré");
+
+    remove_test_files();
+}
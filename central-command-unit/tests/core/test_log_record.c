@@ -0,0 +1,127 @@
+/**
+ * @file test_log_record.c
+ * @brief Tests unitaires des enregistrements de log à formatage différé.
+ */
+
+#undef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL 0
+
+#include "tests/runner.h"
+#include "core/logger.h"
+#include <pthread.h>
+
+TEST_REGISTER(test_log_record_format, "Test formatage différé : types, modificateurs et largeurs") {
+    unsigned char buffer[256];
+    log_args_writer_t writer = { .data = buffer, .length = 0, .capacity = sizeof(buffer) };
+    char message[LOG_MESSAGE_LENGTH];
+
+    int16_t x = -120;
+    unsigned char byte = 0xAB;
+    float angle = 90.5f;
+    const char* name = "car-7";
+    size_t count = 42;
+
+    LOG_ARGS_PUT_7(&writer, x, byte, angle, name, count, 8, -1)
+    log_record_format("x=%d byte=%02hhx angle=%.2f name=%s count=%zu [%*d] 100%%", buffer, writer.length, message, sizeof(message));
+    TEST_ASSERT(strcmp(message, "x=-120 byte=ab angle=90.50 name=car-7 count=42 [      -1] 100%") == 0, "Le formatage doit correspondre à printf");
+
+    writer.length = 0;
+    LOG_ARGS_PUT_2(&writer, -1, (char*)NULL)
+    log_record_format("%u %s %d", buffer, writer.length, message, sizeof(message));
+    TEST_ASSERT(strcmp(message, "4294967295 (null) <?>") == 0, "Troncature int, chaîne NULL et argument manquant");
+
+    char small[8];
+    log_record_format("abcdefghijkl", NULL, 0, small, sizeof(small));
+    TEST_ASSERT(strcmp(small, "abcdefg") == 0, "Le résultat doit être tronqué à la taille du tampon");
+}
+
+#define MAX_DEFERRED_MSGS 4
+static char deferredMsgs[MAX_DEFERRED_MSGS][LOG_MESSAGE_LENGTH];
+static int deferredCount = 0;
+static pthread_mutex_t deferredMutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void testDeferredCallback(log_level_t level, const char *msg) {
+    UNUSED(level);
+    pthread_mutex_lock(&deferredMutex);
+    if(deferredCount < MAX_DEFERRED_MSGS) {
+        strncpy(deferredMsgs[deferredCount], msg, LOG_MESSAGE_LENGTH - 1);
+        deferredCount++;
+    }
+    pthread_mutex_unlock(&deferredMutex);
+}
+
+TEST_REGISTER(test_log_record_deferred_text, "Test des appels différés formatés par le thread de journalisation") {
+    deferredCount = 0;
+    logger_init(LOG_LEVEL_INFO, testDeferredCallback);
+
+    LOG_DEBUG_DEFERRED("Filtered %d", 1);
+    LOG_INFO_DEFERRED("Position (%d, %d) distance %.1f", 10, -20, 3.25);
+    LOG_WARNING_DEFERRED("No arguments");
+
+    logger_destroy();
+
+    TEST_ASSERT(deferredCount == 2, "Seuls les appels au-dessus du niveau doivent être traités");
+    TEST_ASSERT(strcmp(deferredMsgs[0], "Position (10, -20) distance 3.2") == 0, "Message différé formaté incorrect");
+    TEST_ASSERT(strcmp(deferredMsgs[1], "No arguments") == 0, "Message sans argument incorrect");
+}
+
+TEST_REGISTER(test_log_record_binary_file, "Test écriture d'un fichier binaire puis décodage") {
+    char path[] = "/tmp/test_log_record_XXXXXX";
+    int fd = mkstemp(path);
+    TEST_ASSERT(fd >= 0, "Création du fichier temporaire");
+    close(fd);
+
+    deferredCount = 0;
+    logger_init(LOG_LEVEL_DEBUG, testDeferredCallback);
+    TEST_ASSERT(logger_set_binary_file(path) == 0, "Ouverture du fichier binaire");
+
+    for(int i = 0; i < 3; i++) {
+        LOG_DEBUG_DEFERRED("Sample %d from %s", i, "marvelmind");
+    }
+    LOG_INFO_ASYNC("Text message");
+    logger_destroy();
+
+    TEST_ASSERT(deferredCount == 1, "Seul le message non différé doit être transmis au callback");
+
+    FILE* file = fopen(path, "rb");
+    TEST_ASSERT(file != NULL, "Réouverture du fichier binaire");
+
+    log_record_reader_t reader;
+    TEST_ASSERT(log_record_reader_open(&reader, file) == 0, "L'en-tête doit être valide");
+
+    log_record_entry_t entry;
+    int decoded = 0;
+    bool match = true;
+    while(log_record_reader_next(&reader, &entry) == 1) {
+        char expected[64];
+        snprintf(expected, sizeof(expected), "Sample %d from marvelmind", decoded);
+        if(strcmp(entry.message, expected) != 0 || entry.level != LOG_LEVEL_DEBUG || entry.timestampNs == 0) match = false;
+        decoded++;
+    }
+    TEST_ASSERT(decoded == 3, "Les 3 enregistrements doivent être décodés");
+    TEST_ASSERT(match, "Les enregistrements décodés doivent correspondre aux appels");
+    TEST_ASSERT(reader.siteCount == 1, "Un seul site doit être décrit");
+
+    log_record_reader_close(&reader);
+    fclose(file);
+    unlink(path);
+}
+
+TEST_REGISTER(test_log_record_corrupt_site, "Test rejet d'un identifiant de site hors limites") {
+    FILE* file = tmpfile();
+    TEST_ASSERT(file != NULL, "Création du fichier temporaire");
+
+    log_site_t site = { .level = LOG_LEVEL_INFO, .file = "corrupt.c", .line = 1, .format = "Corrupt %d" };
+    TEST_ASSERT(log_record_write_header(file) == 0, "Écriture de l'en-tête");
+    TEST_ASSERT(log_record_write_site(file, UINT32_MAX, &site) == 0, "Écriture d'un site corrompu");
+    rewind(file);
+
+    log_record_reader_t reader;
+    TEST_ASSERT(log_record_reader_open(&reader, file) == 0, "L'en-tête doit être valide");
+    log_record_entry_t entry;
+    TEST_ASSERT(log_record_reader_next(&reader, &entry) == -1, "Un identifiant de site démesuré doit être rejeté");
+    TEST_ASSERT(reader.siteCount == 0, "Aucun site ne doit être alloué");
+
+    log_record_reader_close(&reader);
+    fclose(file);
+}
@@ -5,9 +5,11 @@
  * @date 2025-10-18
  */
 
+#undef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL 0
+
 #include "tests/runner.h"
 #include "core/logger.h"
-#include "core/fifo.h"
 #include <string.h>
 #include <pthread.h>
 #include <semaphore.h>
@@ -85,6 +87,38 @@ TEST_REGISTER(test_logger_level_filter, "Test que le logger ignore les messages
     logger_destroy();
 }
 
+TEST_REGISTER(test_logger_module_level, "Test du niveau de journalisation propre à un module") {
+    logger_init(LOG_LEVEL_WARNING, testSyncCallback);
+
+    // Le module MQTT passe en DEBUG sans changer le niveau global
+    TEST_ASSERT(logger_set_module_level(LOG_MODULE_MQTT, LOG_LEVEL_DEBUG) == 0, "Le niveau du module doit être accepté");
+    TEST_ASSERT(logger_module_enabled(LOG_MODULE_MQTT, LOG_LEVEL_DEBUG), "DEBUG doit passer pour le module MQTT");
+    TEST_ASSERT(!logger_module_enabled(LOG_MODULE_CAMERA, LOG_LEVEL_INFO), "Les autres modules suivent le niveau global");
+
+    syncCalled = 0;
+    logger_log_module_sync(LOG_MODULE_MQTT, LOG_LEVEL_DEBUG, "Module %s", "MQTT");
+    TEST_ASSERT(syncCalled == 1 && strcmp(lastSyncMsg, "Module MQTT") == 0, "Le message DEBUG du module MQTT doit être transmis");
+
+    syncCalled = 0;
+    LOG_INFO_SYNC("General message");
+    TEST_ASSERT(syncCalled == 0, "Le module GENERAL reste filtré au niveau WARNING");
+
+    // Retour au niveau global
+    TEST_ASSERT(logger_set_module_level(LOG_MODULE_MQTT, LOG_MODULE_INHERIT) == 0, "INHERIT doit être accepté");
+    TEST_ASSERT(logger_get_module_level(LOG_MODULE_MQTT) == LOG_LEVEL_WARNING, "Le module doit suivre le niveau global");
+    logger_set_level(LOG_LEVEL_DEBUG);
+    TEST_ASSERT(logger_get_module_level(LOG_MODULE_MQTT) == LOG_LEVEL_DEBUG, "Le module doit suivre un changement du niveau global");
+
+    TEST_ASSERT(logger_set_module_level(LOG_MODULE_COUNT, LOG_LEVEL_DEBUG) == -1, "Un module invalide doit être refusé");
+    TEST_ASSERT(logger_set_module_level(LOG_MODULE_UART, 42) == -1, "Un niveau invalide doit être refusé");
+
+    log_module_t module;
+    TEST_ASSERT(logger_string_to_module("marvelmind", &module) == 0 && module == LOG_MODULE_MARVELMIND, "Nom de module insensible à la casse");
+    TEST_ASSERT(logger_string_to_module("GPS", &module) == -1, "Un nom inconnu doit être refusé");
+
+    logger_destroy();
+}
+
 TEST_REGISTER(test_logger_reinit, "Test réinit du logger après destruction") {
     // Init initiale
     logger_init(LOG_LEVEL_DEBUG, testSyncCallback);
@@ -117,4 +151,74 @@ TEST_REGISTER(test_logger_truncate, "Test que les messages trop longs sont tronq
     TEST_ASSERT(strlen(lastSyncMsg) < LOG_MESSAGE_LENGTH, "Message doit être tronqué correctement");
 
     logger_destroy();
-}
\ No newline at end of file
+}
+
+static pthread_mutex_t gateMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t gateCond = PTHREAD_COND_INITIALIZER;
+static bool gateOpen = false;
+
+static void testGatedCallback(log_level_t level, const char *msg) {
+    UNUSED(level);
+    UNUSED(msg);
+    pthread_mutex_lock(&gateMutex);
+    while(!gateOpen) pthread_cond_wait(&gateCond, &gateMutex);
+    pthread_mutex_unlock(&gateMutex);
+}
+
+TEST_REGISTER(test_logger_overflow_drop, "Test que le logger asynchrone compte les messages perdus quand la file est pleine") {
+    gateOpen = false;
+    logger_init(LOG_LEVEL_DEBUG, testGatedCallback);
+    logger_set_overflow_policy(LOG_OVERFLOW_DROP);
+
+    logger_stats_t before;
+    logger_get_stats(&before);
+
+    // Le premier message occupe le thread (bloqué dans le callback) sans libérer sa case
+    LOG_INFO_ASYNC("Blocking message");
+    struct timespec ts = {0, 50*1000*1000}; // 50 ms
+    nanosleep(&ts, NULL);
+
+    // Le thread est bloqué : les cases restantes se remplissent puis les messages sont perdus
+    for(int i = 0; i < LOG_QUEUE_CAPACITY + 9; i++) {
+        LOG_INFO_ASYNC("Message %d", i);
+    }
+
+    logger_stats_t after;
+    logger_get_stats(&after);
+    TEST_ASSERT(after.dropped[LOG_LEVEL_INFO] - before.dropped[LOG_LEVEL_INFO] == 10, "10 messages INFO doivent être perdus");
+    TEST_ASSERT(after.blocked == before.blocked, "Aucun appel ne doit attendre en mode drop");
+
+    pthread_mutex_lock(&gateMutex);
+    gateOpen = true;
+    pthread_cond_broadcast(&gateCond);
+    pthread_mutex_unlock(&gateMutex);
+
+    logger_destroy();
+
+    logger_get_stats(&after);
+    TEST_ASSERT(after.written - before.written == LOG_QUEUE_CAPACITY, "Tous les messages en file doivent être traités à la destruction");
+}
+
+static int reentrantCalls = 0;
+
+static void testReentrantCallback(log_level_t level, const char *msg) {
+    UNUSED(level);
+    UNUSED(msg);
+    __atomic_fetch_add(&reentrantCalls, 1, __ATOMIC_RELAXED);
+    // Comme mqtt.c pendant la publication d'un log : ces messages ne doivent pas reboucler
+    LOG_ERROR_ASYNC("Logged from the callback");
+    LOG_ERROR_SYNC("Logged from the callback");
+}
+
+TEST_REGISTER(test_logger_callback_reentry, "Test que les messages journalisés par le callback lui-même sont ignorés") {
+    reentrantCalls = 0;
+    logger_init(LOG_LEVEL_DEBUG, testReentrantCallback);
+    logger_set_overflow_policy(LOG_OVERFLOW_BLOCK);
+
+    LOG_INFO_ASYNC("Async message");
+    LOG_INFO_SYNC("Sync message");
+    logger_destroy();
+
+    TEST_ASSERT(reentrantCalls == 2, "Le callback ne doit être appelé que pour les 2 messages de l'application");
+    logger_set_overflow_policy(LOG_OVERFLOW_DROP);
+}
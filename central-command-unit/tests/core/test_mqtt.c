@@ -1,16 +1,16 @@
 /**
  * @file test_mqtt.c
  * @brief Tests unitaires pour le wrapper MQTT (mqtt.c)
- * @details Ces tests nécessitent un broker MQTT local tournant sur le port 1883.
+ * @details Chaque test démarre son propre broker embarqué (tests/loopback_broker.h) sur un port
+ * éphémère : aucun broker externe n'est nécessaire.
  */
 
 #include "tests/runner.h"
+#include "tests/loopback_broker.h"
 #include "core/mqtt.h"
 #include "core/logger.h"
 
 
-#define LOCAL_BROKER_IP "127.0.0.1"
-#define LOCAL_BROKER_PORT 1883
 #define CONNECTION_TIMEOUT_SEC 5
 #define MESSAGE_TIMEOUT_SEC 5
 
@@ -34,8 +34,10 @@ static void test_message_callback(const char* topic, const char* payload) {
 TEST_REGISTER(test_mqtt_connect_disconnect, "Test MQTT connexion et déconnexion") {
     logger_init(LOG_LEVEL_DEBUG, log_callback);
     mqtt_set_message_callback(NULL);
+    loopback_broker_t* broker = loopback_broker_start(0);
+    TEST_ASSERT(broker != NULL, "Le broker embarqué doit démarrer");
 
-    int connectResult = mqtt_connect(LOCAL_BROKER_IP, LOCAL_BROKER_PORT, "test-client-1", NULL, NULL);
+    int connectResult = mqtt_connect(LOOPBACK_BROKER_HOST, loopback_broker_port(broker), "test-client-1", NULL, NULL);
     TEST_ASSERT(connectResult == 0, "mqtt_connect doit retourner 0 (succès)");
 
     int waitResult = mqtt_wait_for_connection(CONNECTION_TIMEOUT_SEC);
@@ -45,6 +47,7 @@ TEST_REGISTER(test_mqtt_connect_disconnect, "Test MQTT connexion et déconnexion
     mqtt_disconnect();
     TEST_ASSERT(mqtt_is_connected() == false, "Le client doit être déconnecté");
     
+    loopback_broker_stop(broker);
     logger_destroy();
 }
 
@@ -53,6 +56,8 @@ TEST_REGISTER(test_mqtt_pub_sub, "Test MQTT publication et souscription (loopbac
     logger_init(LOG_LEVEL_DEBUG, log_callback);
     sem_init(&messageSemaphore, 0, 0);
     mqtt_set_message_callback(test_message_callback);
+    loopback_broker_t* broker = loopback_broker_start(0);
+    TEST_ASSERT(broker != NULL, "Le broker embarqué doit démarrer");
     
     memset(lastReceivedTopic, 0, sizeof(lastReceivedTopic));
     memset(lastReceivedPayload, 0, sizeof(lastReceivedPayload));
@@ -60,7 +65,7 @@ TEST_REGISTER(test_mqtt_pub_sub, "Test MQTT publication et souscription (loopbac
     const char* testTopic = "core/test/pubsub";
     const char* testPayload = "Hello MQTT!";
 
-    int connectResult = mqtt_connect(LOCAL_BROKER_IP, LOCAL_BROKER_PORT, "test-client-2", NULL, NULL);
+    int connectResult = mqtt_connect(LOOPBACK_BROKER_HOST, loopback_broker_port(broker), "test-client-2", NULL, NULL);
     TEST_ASSERT(connectResult == 0, "mqtt_connect doit réussir");
 
     int waitResult = mqtt_wait_for_connection(CONNECTION_TIMEOUT_SEC);
@@ -91,23 +96,26 @@ TEST_REGISTER(test_mqtt_pub_sub, "Test MQTT publication et souscription (loopbac
     }
 
     mqtt_disconnect();
+    loopback_broker_stop(broker);
     sem_destroy(&messageSemaphore);
     logger_destroy();
 }
 
 /**
- * @brief Test que la configuration du LWT ne fait pas échouer la connexion.
+ * @brief Test que le LWT configuré est publié par le broker à la perte de connexion.
  */
 TEST_REGISTER(test_mqtt_lwt_setup, "Test de la configuration du LWT") {
     logger_init(LOG_LEVEL_DEBUG, log_callback);
     mqtt_set_message_callback(NULL);
+    loopback_broker_t* broker = loopback_broker_start(0);
+    TEST_ASSERT(broker != NULL, "Le broker embarqué doit démarrer");
 
     const char* lwtTopic = "core/test/lwt";
     const char* lwtPayload = "client-mort";
 
     int connectResult = mqtt_connect(
-        LOCAL_BROKER_IP, 
-        LOCAL_BROKER_PORT, 
+        LOOPBACK_BROKER_HOST,
+        loopback_broker_port(broker),
         "test-client-lwt", 
         lwtTopic, 
         lwtPayload
@@ -118,6 +126,16 @@ TEST_REGISTER(test_mqtt_lwt_setup, "Test de la configuration du LWT") {
     TEST_ASSERT(waitResult == 0, "L'attente de connexion avec LWT doit réussir");
     TEST_ASSERT(mqtt_is_connected() == true, "Le client (avec LWT) doit être connecté");
 
+    // Coupure côté broker, comme une perte réseau
+    TEST_ASSERT(loopback_broker_drop_client(broker, "test-client-lwt") == 0, "Le broker doit couper le client");
+    loopback_broker_stats_t stats = {0};
+    for (int i = 0; i < 100 && stats.wills == 0; i++) {
+        usleep(10 * 1000);
+        loopback_broker_get_stats(broker, &stats);
+    }
+    TEST_ASSERT(stats.wills == 1, "Le broker doit publier le LWT du client coupé");
+
     mqtt_disconnect();
+    loopback_broker_stop(broker);
     logger_destroy();
 }
\ No newline at end of file
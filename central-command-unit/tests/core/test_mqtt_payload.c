@@ -0,0 +1,67 @@
+/**
+ * @file test_mqtt_payload.c
+ * @brief Tests unitaires pour la conservation des payloads MQTT reçus.
+ */
+
+#include "tests/runner.h"
+#include "core/mqtt_payload.h"
+#include "core/mqtt_router.h"
+
+static mqtt_payload_t* retainedPayloads[2];
+
+static void retain_twice(const char* topic, const void* payload, size_t length, void* context) {
+    UNUSED(topic);
+    UNUSED(context);
+    retainedPayloads[0] = mqtt_payload_retain(payload, length);
+    retainedPayloads[1] = mqtt_payload_retain(payload, length);
+}
+
+TEST_REGISTER(test_mqtt_payload_retain_delivery, "Test mqtt payload : buffer livré détaché sans copie") {
+    const char* text = "{\"status\":\"offline\"}";
+    size_t length = strlen(text);
+    void* buffer = malloc(length);
+    memcpy(buffer, text, length); // Comme mosquitto : rien ne garantit un '\0' final
+    void* libraryBuffer = buffer;
+
+    mqtt_router_t* router = mqtt_router_create();
+    mqtt_router_add_topic(router, "vehicles/+/status", retain_twice, NULL);
+
+    mqtt_payload_delivery_begin(&libraryBuffer, length);
+    mqtt_router_dispatch(router, "vehicles/1/status", buffer, length);
+    mqtt_payload_delivery_end();
+
+    TEST_ASSERT(libraryBuffer == NULL, "Le buffer retenu doit être détaché du message");
+    TEST_ASSERT(retainedPayloads[0] && retainedPayloads[0] == retainedPayloads[1], "Les retenues d'un même message doivent partager le payload");
+    TEST_ASSERT(retainedPayloads[0]->data == buffer && retainedPayloads[0]->length == length, "Le payload retenu doit être le buffer livré");
+
+    mqtt_payload_release(retainedPayloads[1]);
+    size_t stolenLength = 0;
+    void* stolen = mqtt_payload_steal(retainedPayloads[0], &stolenLength);
+    TEST_ASSERT(stolen == buffer && stolenLength == length, "La dernière référence doit récupérer le buffer sans copie");
+    free(stolen);
+
+    mqtt_router_destroy(router);
+}
+
+TEST_REGISTER(test_mqtt_payload_retain_copy, "Test mqtt payload : copie hors livraison et buffer partagé") {
+    const char* text = "hello";
+    void* libraryBuffer = (void*)text;
+
+    // Hors livraison, ou pour un autre buffer, le contenu est copié
+    mqtt_payload_t* copy = mqtt_payload_retain(text, 5);
+    TEST_ASSERT(copy && copy->data != text && memcmp(copy->data, "hello", 5) == 0, "Le contenu doit être copié hors livraison");
+
+    mqtt_payload_delivery_begin(&libraryBuffer, 5);
+    mqtt_payload_t* other = mqtt_payload_retain("other", 5);
+    mqtt_payload_delivery_end();
+    TEST_ASSERT(libraryBuffer == text && other && other->data != text, "Un autre buffer ne doit pas détacher le message livré");
+    mqtt_payload_release(other);
+
+    // Buffer encore partagé : steal copie et laisse l'autre propriétaire intact
+    mqtt_payload_ref(copy);
+    char* stolen = (char*)mqtt_payload_steal(copy, NULL);
+    TEST_ASSERT(stolen && stolen != copy->data && strcmp(stolen, "hello") == 0, "Un buffer partagé doit être copié (terminé par '\\0')");
+    TEST_ASSERT(copy->refs == 1 && memcmp(copy->data, "hello", 5) == 0, "L'autre référence doit rester valide");
+    free(stolen);
+    mqtt_payload_release(copy);
+}
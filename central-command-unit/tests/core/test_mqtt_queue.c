@@ -0,0 +1,139 @@
+/**
+ * @file test_mqtt_queue.c
+ * @brief Tests unitaires pour la file des publications MQTT en attente.
+ */
+
+#include "tests/runner.h"
+#include "core/mqtt_queue.h"
+
+#define TEST_SPOOL_PATH "/tmp/ccu_test_mqtt_queue.spool"
+
+typedef struct {
+    char topics[16][32];
+    int count;
+    int failAfter; //!< Nombre d'envois acceptés avant un échec (-1 : aucun échec)
+} sent_messages_t;
+
+static int record_message(const mqtt_queued_message_t* message, void* context) {
+    sent_messages_t* sent = (sent_messages_t*)context;
+    if (sent->failAfter >= 0 && sent->count >= sent->failAfter) return -1;
+    snprintf(sent->topics[sent->count++], sizeof(sent->topics[0]), "%s", message->topic);
+    return 0;
+}
+
+TEST_REGISTER(test_mqtt_queue_priority_order, "Test mqtt queue : ordre de renvoi et priorité des commandes") {
+    mqtt_queue_t queue;
+    mqtt_queue_config_t config = { .maxMessages = 8, .maxBytes = 1024 };
+    mqtt_queue_init(&queue, &config);
+
+    mqtt_queue_push(&queue, "t/1", "a", 1, 0, false, MQTT_PRIORITY_TELEMETRY, NULL);
+    mqtt_queue_push(&queue, "c/1", "b", 1, 1, false, MQTT_PRIORITY_COMMAND, NULL);
+    mqtt_queue_push(&queue, "t/2", "c", 1, 0, false, MQTT_PRIORITY_TELEMETRY, NULL);
+    mqtt_queue_push(&queue, "c/2", "d", 1, 0, false, MQTT_PRIORITY_COMMAND, NULL);
+    TEST_ASSERT(mqtt_queue_count(&queue) == 4, "Les messages doivent être conservés");
+
+    // Échec au troisième envoi : le vidage reprend là où il s'est arrêté
+    sent_messages_t sent = { .failAfter = 3 };
+    TEST_ASSERT(mqtt_queue_drain(&queue, record_message, &sent) == 3, "Le vidage doit s'arrêter au premier échec");
+    TEST_ASSERT(strcmp(sent.topics[0], "c/1") == 0 && strcmp(sent.topics[1], "c/2") == 0 && strcmp(sent.topics[2], "t/1") == 0,
+        "Les commandes doivent partir avant la télémétrie, chacune dans son ordre");
+    sent.failAfter = -1;
+    TEST_ASSERT(mqtt_queue_drain(&queue, record_message, &sent) == 1 && strcmp(sent.topics[3], "t/2") == 0, "Le message non transmis doit être renvoyé");
+    TEST_ASSERT(mqtt_queue_count(&queue) == 0, "La file doit être vide");
+
+    mqtt_queue_destroy(&queue);
+}
+
+TEST_REGISTER(test_mqtt_queue_full_policy, "Test mqtt queue : file pleine, télémétrie supprimée en premier") {
+    mqtt_queue_t queue;
+    mqtt_queue_config_t config = { .maxMessages = 3, .maxBytes = 1024 };
+    mqtt_queue_init(&queue, &config);
+
+    mqtt_queue_push(&queue, "t/1", "a", 1, 0, false, MQTT_PRIORITY_TELEMETRY, NULL);
+    mqtt_queue_push(&queue, "c/1", "b", 1, 0, false, MQTT_PRIORITY_COMMAND, NULL);
+    mqtt_queue_push(&queue, "t/2", "c", 1, 0, false, MQTT_PRIORITY_TELEMETRY, NULL);
+
+    TEST_ASSERT(mqtt_queue_push(&queue, "c/2", "d", 1, 1, false, MQTT_PRIORITY_COMMAND, NULL) == MQTT_QUEUE_EVICTED, "La télémétrie la plus ancienne doit céder sa place");
+    TEST_ASSERT(mqtt_queue_push(&queue, "t/3", "e", 1, 0, false, MQTT_PRIORITY_TELEMETRY, NULL) == MQTT_QUEUE_EVICTED, "La nouvelle télémétrie remplace l'ancienne");
+    TEST_ASSERT(mqtt_queue_push(&queue, "c/3", "f", 1, 1, false, MQTT_PRIORITY_COMMAND, NULL) == MQTT_QUEUE_EVICTED, "Une commande QoS 1 doit remplacer la télémétrie");
+    TEST_ASSERT(mqtt_queue_push(&queue, "c/4", "g", 1, 0, false, MQTT_PRIORITY_COMMAND, NULL) == MQTT_QUEUE_DROPPED, "Une commande QoS 0 doit être refusée");
+    TEST_ASSERT(mqtt_queue_push(&queue, "c/5", "h", 1, 2, false, MQTT_PRIORITY_COMMAND, NULL) == MQTT_QUEUE_EVICTED, "Une commande QoS 2 doit remplacer la commande QoS 0");
+    TEST_ASSERT(mqtt_queue_push(&queue, "c/6", "i", 1, 1, false, MQTT_PRIORITY_COMMAND, NULL) == MQTT_QUEUE_DROPPED, "Sans fichier de débordement, une file de commandes QoS 1/2 pleine refuse");
+    TEST_ASSERT(mqtt_queue_push(&queue, "c/7", "0123456789", 10, 1, false, MQTT_PRIORITY_COMMAND, NULL) == MQTT_QUEUE_DROPPED, "La file doit rester pleine");
+
+    sent_messages_t sent = { .failAfter = -1 };
+    mqtt_queue_drain(&queue, record_message, &sent);
+    TEST_ASSERT(sent.count == 3 && strcmp(sent.topics[0], "c/2") == 0 && strcmp(sent.topics[1], "c/3") == 0 && strcmp(sent.topics[2], "c/5") == 0,
+        "Seules les commandes QoS 1/2 doivent rester, dans leur ordre");
+    TEST_ASSERT(mqtt_queue_dropped(&queue) == 7, "Chaque message supprimé ou refusé doit être compté");
+
+    mqtt_queue_destroy(&queue);
+}
+
+TEST_REGISTER(test_mqtt_queue_spool, "Test mqtt queue : débordement des commandes sur disque") {
+    mqtt_queue_t queue;
+    mqtt_queue_config_t config = { .maxMessages = 2, .maxBytes = 1024, .spoolPath = TEST_SPOOL_PATH };
+    TEST_ASSERT(mqtt_queue_init(&queue, &config) == 0, "Le fichier de débordement doit s'ouvrir");
+
+    mqtt_queue_push(&queue, "c/1", "one", 3, 1, false, MQTT_PRIORITY_COMMAND, NULL);
+    mqtt_queue_push(&queue, "c/2", "two", 3, 1, false, MQTT_PRIORITY_COMMAND, NULL);
+    TEST_ASSERT(mqtt_queue_push(&queue, "c/3", "three", 5, 1, true, MQTT_PRIORITY_COMMAND, NULL) == MQTT_QUEUE_SPOOLED, "Une commande QoS 1 doit déborder sur disque");
+    TEST_ASSERT(mqtt_queue_push(&queue, "c/4", "four", 4, 0, false, MQTT_PRIORITY_COMMAND, NULL) == MQTT_QUEUE_SPOOLED, "Les commandes suivantes doivent suivre sur disque");
+    TEST_ASSERT(mqtt_queue_push(&queue, "t/1", "tel", 3, 0, false, MQTT_PRIORITY_TELEMETRY, NULL) == MQTT_QUEUE_DROPPED, "La télémétrie ne déborde pas");
+    TEST_ASSERT(mqtt_queue_count(&queue) == 4, "Le fichier doit être compté dans la file");
+
+    sent_messages_t sent = { .failAfter = 3 };
+    mqtt_queue_drain(&queue, record_message, &sent);
+    sent.failAfter = -1;
+    mqtt_queue_drain(&queue, record_message, &sent);
+    TEST_ASSERT(sent.count == 4 && strcmp(sent.topics[2], "c/3") == 0 && strcmp(sent.topics[3], "c/4") == 0, "Les commandes débordées doivent être relues dans l'ordre");
+    TEST_ASSERT(mqtt_queue_count(&queue) == 0 && queue.spoolWrite == 0, "Le fichier doit être vidé après renvoi");
+
+    mqtt_queue_destroy(&queue);
+    unlink(TEST_SPOOL_PATH);
+}
+
+static mqtt_properties_t lastProperties;
+static char lastResponseTopic[64];
+static char lastCorrelation[64];
+
+static int record_properties(const mqtt_queued_message_t* message, void* context) {
+    sent_messages_t* sent = (sent_messages_t*)context;
+    snprintf(sent->topics[sent->count++], sizeof(sent->topics[0]), "%s", message->topic);
+    lastProperties = message->properties;
+    snprintf(lastResponseTopic, sizeof(lastResponseTopic), "%s", message->properties.responseTopic ? message->properties.responseTopic : "");
+    snprintf(lastCorrelation, sizeof(lastCorrelation), "%.*s", (int)message->properties.correlationLength,
+        message->properties.correlationData ? (const char*)message->properties.correlationData : "");
+    return 0;
+}
+
+TEST_REGISTER(test_mqtt_queue_properties, "Test mqtt queue : propriétés MQTT v5 conservées et messages expirés supprimés") {
+    mqtt_queue_t queue;
+    mqtt_queue_config_t config = { .maxMessages = 1, .maxBytes = 1024, .spoolPath = TEST_SPOOL_PATH };
+    mqtt_queue_init(&queue, &config);
+
+    mqtt_properties_t request = { .responseTopic = "vehicles/1/reply", .correlationData = "PLAN-42", .correlationLength = 7, .messageExpirySec = 60 };
+    mqtt_queue_push(&queue, "c/1", "a", 1, 1, false, MQTT_PRIORITY_COMMAND, NULL);
+    TEST_ASSERT(mqtt_queue_push(&queue, "c/2", "b", 1, 1, false, MQTT_PRIORITY_COMMAND, &request) == MQTT_QUEUE_SPOOLED, "La seconde commande doit déborder sur disque");
+
+    sent_messages_t sent = { .failAfter = -1 };
+    TEST_ASSERT(mqtt_queue_drain(&queue, record_properties, &sent) == 2 && strcmp(sent.topics[1], "c/2") == 0, "La commande relue du disque doit être transmise");
+    TEST_ASSERT(strcmp(lastResponseTopic, "vehicles/1/reply") == 0 && strcmp(lastCorrelation, "PLAN-42") == 0,
+        "Topic de réponse et corrélation doivent survivre au fichier de débordement");
+    TEST_ASSERT(lastProperties.messageExpirySec > 0 && lastProperties.messageExpirySec <= 60, "La validité transmise doit être la validité restante");
+    mqtt_queue_destroy(&queue);
+    unlink(TEST_SPOOL_PATH);
+
+    mqtt_queue_init(&queue, NULL);
+    mqtt_properties_t state = { .messageExpirySec = 5, .topicAlias = true };
+    mqtt_queue_push(&queue, "t/1", "c", 1, 0, false, MQTT_PRIORITY_TELEMETRY, &state);
+    mqtt_queue_push(&queue, "t/2", "d", 1, 0, false, MQTT_PRIORITY_TELEMETRY, &state);
+    // Simule un état publié il y a plus de 5 s
+    queue.head[MQTT_PRIORITY_TELEMETRY]->expiresAtMs -= 6000;
+
+    sent.count = 0;
+    TEST_ASSERT(mqtt_queue_drain(&queue, record_properties, &sent) == 1 && strcmp(sent.topics[0], "t/2") == 0, "L'état expiré ne doit pas être transmis");
+    TEST_ASSERT(lastProperties.topicAlias, "La demande d'alias doit être conservée");
+    TEST_ASSERT(mqtt_queue_count(&queue) == 0 && mqtt_queue_dropped(&queue) == 1, "L'état expiré doit être supprimé et compté");
+    mqtt_queue_destroy(&queue);
+}
@@ -0,0 +1,92 @@
+/**
+ * @file test_mqtt_router.c
+ * @brief Tests unitaires pour le routeur des messages MQTT.
+ */
+
+#include "tests/runner.h"
+#include "core/mqtt_router.h"
+
+typedef struct {
+    int calls;
+    char lastTopic[128];
+    char lastAction[ACTION_LENGTH];
+} route_counter_t;
+
+static void count_topic(const char* topic, const void* payload, size_t length, void* context) {
+    UNUSED(payload);
+    UNUSED(length);
+    route_counter_t* counter = (route_counter_t*)context;
+    counter->calls++;
+    snprintf(counter->lastTopic, sizeof(counter->lastTopic), "%s", topic);
+}
+
+static void count_action(const char* topic, const command_header_t* header, cJSON* root, void* context) {
+    route_counter_t* counter = (route_counter_t*)context;
+    counter->calls++;
+    snprintf(counter->lastTopic, sizeof(counter->lastTopic), "%s", topic);
+    snprintf(counter->lastAction, sizeof(counter->lastAction), "%s", root ? header->action : "");
+}
+
+static int dispatch(mqtt_router_t* router, const char* topic, const char* payload) {
+    return mqtt_router_dispatch(router, topic, payload, strlen(payload));
+}
+
+TEST_REGISTER(test_mqtt_router_wildcards, "Test mqtt router : niveaux exacts et jokers") {
+    mqtt_router_t* router = mqtt_router_create();
+    route_counter_t exact = {0}, plus = {0}, hash = {0}, sys = {0};
+
+    TEST_ASSERT(mqtt_router_add_topic(router, "services/route-planner/status", count_topic, &exact) == 0, "Un filtre exact doit être accepté");
+    TEST_ASSERT(mqtt_router_add_topic(router, "vehicles/+/status", count_topic, &plus) == 0, "Un filtre '+' doit être accepté");
+    TEST_ASSERT(mqtt_router_add_topic(router, "services/#", count_topic, &hash) == 0, "Un filtre '#' doit être accepté");
+    TEST_ASSERT(mqtt_router_add_topic(router, "+/#", count_topic, &sys) == 0, "Un filtre '+/#' doit être accepté");
+
+    TEST_ASSERT(dispatch(router, "services/route-planner/status", "{}") == 3, "Le filtre exact, 'services/#' et '+/#' doivent être appelés");
+    TEST_ASSERT(exact.calls == 1 && hash.calls == 1 && plus.calls == 0, "Seules les routes correspondantes doivent être appelées");
+
+    TEST_ASSERT(dispatch(router, "vehicles/12/status", "{}") == 2, "'vehicles/+/status' et '+/#' doivent être appelés");
+    TEST_ASSERT(plus.calls == 1 && strcmp(plus.lastTopic, "vehicles/12/status") == 0, "Le topic reçu doit être transmis");
+    TEST_ASSERT(dispatch(router, "vehicles/12/status/extra", "{}") == 1, "'+' ne doit capter qu'un niveau");
+    TEST_ASSERT(dispatch(router, "services", "{}") == 2, "'services/#' doit aussi capter le niveau parent");
+
+    int sysCalls = sys.calls;
+    TEST_ASSERT(dispatch(router, "$SYS/broker/uptime", "{}") == 0, "Un topic '$' ne doit pas être capté par un joker au premier niveau");
+    TEST_ASSERT(sys.calls == sysCalls, "'+/#' ne doit pas capter '$SYS'");
+
+    mqtt_router_destroy(router);
+}
+
+TEST_REGISTER(test_mqtt_router_actions, "Test mqtt router : routage par action et handler par défaut") {
+    mqtt_router_t* router = mqtt_router_create();
+    route_counter_t plan = {0}, stop = {0}, fallback = {0};
+
+    TEST_ASSERT(mqtt_router_is_empty(router), "Un routeur neuf doit être vide");
+    TEST_ASSERT(mqtt_router_add_action(router, "vehicles/+/request", "PLAN", count_action, &plan) == 0, "Une action doit être acceptée");
+    TEST_ASSERT(mqtt_router_add_action(router, "vehicles/+/request", "STOP", count_action, &stop) == 0, "Plusieurs actions par filtre doivent être acceptées");
+    TEST_ASSERT(mqtt_router_add_action(router, "vehicles/+/request", "STOP", count_action, &stop) == -1, "Une action ne doit être enregistrée qu'une fois par filtre");
+    mqtt_router_set_default(router, count_topic, &fallback);
+    TEST_ASSERT(!mqtt_router_is_empty(router), "Le routeur ne doit plus être vide");
+
+    const char* stopPayload = "{\"commandId\":\"STOP-1\",\"action\":\"STOP\",\"replyTopic\":\"vehicles/3/response\"}";
+    TEST_ASSERT(dispatch(router, "vehicles/3/request", stopPayload) == 1, "Seule l'action reçue doit être appelée");
+    TEST_ASSERT(stop.calls == 1 && plan.calls == 0 && strcmp(stop.lastAction, "STOP") == 0, "Le handler de l'action doit recevoir l'en-tête et le JSON");
+
+    const char* unknownPayload = "{\"commandId\":\"X-1\",\"action\":\"UNKNOWN\",\"replyTopic\":\"vehicles/3/response\"}";
+    TEST_ASSERT(dispatch(router, "vehicles/3/request", unknownPayload) == 1 && fallback.calls == 1, "Une action inconnue doit finir dans le handler par défaut");
+    TEST_ASSERT(dispatch(router, "vehicles/3/request", "not json") == 1 && fallback.calls == 2, "Un payload invalide doit finir dans le handler par défaut");
+    TEST_ASSERT(dispatch(router, "other/topic", "{}") == 1 && fallback.calls == 3, "Un topic sans route doit finir dans le handler par défaut");
+
+    mqtt_router_destroy(router);
+}
+
+TEST_REGISTER(test_mqtt_router_invalid_filters, "Test mqtt router : filtres invalides") {
+    mqtt_router_t* router = mqtt_router_create();
+    route_counter_t counter = {0};
+
+    TEST_ASSERT(mqtt_router_add_topic(router, "", count_topic, &counter) == -1, "Un filtre vide doit être refusé");
+    TEST_ASSERT(mqtt_router_add_topic(router, "a/#/b", count_topic, &counter) == -1, "'#' doit être le dernier niveau");
+    TEST_ASSERT(mqtt_router_add_topic(router, "a/b+/c", count_topic, &counter) == -1, "Un joker doit occuper tout le niveau");
+    TEST_ASSERT(mqtt_router_add_topic(router, "a/b", NULL, &counter) == -1, "Un handler est requis");
+    TEST_ASSERT(mqtt_router_is_empty(router), "Aucune route invalide ne doit être enregistrée");
+
+    mqtt_router_destroy(router);
+}
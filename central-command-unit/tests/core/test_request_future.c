@@ -0,0 +1,124 @@
+/**
+ * @file test_request_future.c
+ * @brief Tests unitaires pour les futures de requêtes (wait, poll, then, wait_all).
+ */
+
+#include "tests/runner.h"
+#include "core/request_future.h"
+
+static long fakeNowMs = 0;
+
+static long fake_clock(void) {
+    return fakeNowMs;
+}
+
+static void respond(const char* requestId, bool success) {
+    command_response_header_t header = create_command_response_header(requestId, success, success ? NULL : "Refused");
+    char* payload = command_response_header_serialize(&header);
+    request_manager_process_response(payload);
+    free(payload);
+}
+
+static void on_resolved(request_future_t* future, void* context) {
+    int* calls = (int*)context;
+    if (request_future_poll(future) != REQUEST_FUTURE_PENDING) (*calls)++;
+}
+
+// Pas de broker dans les tests : un renvoi est prévu pour que l'échec de la publication soit toléré
+static const request_options_t testOptions = { .timeoutMs = 200, .maxRetries = 1, .maxTimeoutMs = 200 };
+
+TEST_REGISTER(test_request_future_fan_out, "Test futures : envoi parallèle, poll, then et wait_all") {
+    fakeNowMs = 0;
+    timer_wheel_t wheel;
+    timer_wheel_init(&wheel, 10, fake_clock);
+    request_manager_init(&wheel);
+
+    request_future_t* futures[3] = {
+        request_manager_call("services/a/request", "REQ_A", "{}", MQTT_QOS_AT_LEAST_ONCE, &testOptions),
+        request_manager_call("services/b/request", "REQ_B", "{}", MQTT_QOS_AT_LEAST_ONCE, &testOptions),
+        request_manager_call("services/c/request", "REQ_C", "{}", MQTT_QOS_AT_LEAST_ONCE, &testOptions)
+    };
+    TEST_ASSERT(futures[0] && futures[1] && futures[2], "Les appels doivent retourner une future");
+    TEST_ASSERT(request_future_poll(futures[0]) == REQUEST_FUTURE_PENDING, "Une future sans réponse doit être en attente");
+    TEST_ASSERT(request_future_header(futures[0]) == NULL, "Une future en attente n'a pas d'en-tête");
+
+    int thenCalls = 0, lateThenCalls = 0;
+    TEST_ASSERT(request_future_then(futures[2], on_resolved, &thenCalls) == 0, "L'enregistrement du callback doit réussir");
+    TEST_ASSERT(request_future_then(futures[2], on_resolved, &thenCalls) == -1, "Un seul callback par future");
+
+    respond("REQ_A", true);
+    respond("REQ_B", false);
+    TEST_ASSERT(request_future_wait_all(futures, 3, 0) == -1, "wait_all doit échouer tant qu'une future est en attente");
+    TEST_ASSERT(request_future_poll(futures[0]) == REQUEST_FUTURE_SUCCESS, "La réponse positive doit résoudre la future");
+    TEST_ASSERT(request_future_response(futures[0]) != NULL, "La réponse doit être conservée par la future");
+    TEST_ASSERT(request_future_wait(futures[1], 10) == REQUEST_FUTURE_ERROR, "La réponse négative doit être signalée");
+    TEST_ASSERT(strcmp(request_future_header(futures[1])->errorMessage, "Refused") == 0, "Le message d'erreur doit être transmis");
+
+    // La troisième requête n'a jamais de réponse : renvoi puis expiration
+    for (fakeNowMs = 0; fakeNowMs < 420; fakeNowMs += 10) timer_wheel_advance(&wheel);
+    TEST_ASSERT(request_future_wait_all(futures, 3, 0) == 0, "Toutes les futures doivent être résolues");
+    TEST_ASSERT(request_future_poll(futures[2]) == REQUEST_FUTURE_TIMEOUT, "La requête sans réponse doit expirer");
+    TEST_ASSERT(request_future_response(futures[2]) == NULL, "Une future expirée n'a pas de réponse");
+    TEST_ASSERT(thenCalls == 1, "Le callback doit être appelé à la résolution");
+    request_future_then(futures[0], on_resolved, &lateThenCalls);
+    TEST_ASSERT(lateThenCalls == 1, "Sur une future déjà résolue, le callback doit être appelé immédiatement");
+
+    for (int i = 0; i < 3; i++) request_future_release(futures[i]);
+    timer_wheel_destroy(&wheel);
+    request_manager_destroy();
+}
+
+static void* respond_later(void* arg) {
+    usleep(20000);
+    respond((const char*)arg, true);
+    return NULL;
+}
+
+TEST_REGISTER(test_request_future_wait, "Test futures : attente bloquante et libération avant résolution") {
+    request_manager_init(NULL);
+
+    request_future_t* future = request_manager_call("services/a/request", "REQ_WAIT", "{}", MQTT_QOS_AT_LEAST_ONCE, &testOptions);
+    TEST_ASSERT(request_future_wait(future, 5) == REQUEST_FUTURE_PENDING, "L'attente doit expirer sans réponse");
+
+    pthread_t responder;
+    pthread_create(&responder, NULL, respond_later, "REQ_WAIT");
+    TEST_ASSERT(request_future_wait(future, REQUEST_FUTURE_WAIT_FOREVER) == REQUEST_FUTURE_SUCCESS, "L'attente doit se terminer à la réponse");
+    pthread_join(responder, NULL);
+    request_future_release(future);
+
+    // Relâchée avant sa résolution, la future reste valide jusqu'à la réponse
+    int thenCalls = 0;
+    future = request_manager_call("services/a/request", "REQ_RELEASED", "{}", MQTT_QOS_AT_LEAST_ONCE, &testOptions);
+    request_future_then(future, on_resolved, &thenCalls);
+    request_future_release(future);
+    respond("REQ_RELEASED", true);
+    TEST_ASSERT(thenCalls == 1, "Le callback d'une future relâchée doit être appelé");
+    TEST_ASSERT(request_manager_pending_count() == 0, "Aucune requête ne doit rester en attente");
+
+    request_manager_destroy();
+}
+
+static void* wait_forever(void* arg) {
+    request_future_t* future = (request_future_t*)arg;
+    return (void*)(intptr_t)request_future_wait(future, REQUEST_FUTURE_WAIT_FOREVER);
+}
+
+TEST_REGISTER(test_request_future_destroy, "Test futures : arrêt du gestionnaire pendant une attente") {
+    request_manager_init(NULL);
+
+    request_future_t* future = request_manager_call("services/a/request", "REQ_SHUTDOWN", "{}", MQTT_QOS_AT_LEAST_ONCE, &testOptions);
+    TEST_ASSERT(future != NULL, "L'appel doit retourner une future");
+
+    pthread_t waiter;
+    pthread_create(&waiter, NULL, wait_forever, future);
+    usleep(20000);
+
+    // L'arrêt résout la future : l'attente sans limite se termine
+    request_manager_destroy();
+    void* state;
+    pthread_join(waiter, &state);
+    TEST_ASSERT((intptr_t)state == REQUEST_FUTURE_TIMEOUT, "La future doit expirer à l'arrêt du gestionnaire");
+    TEST_ASSERT(request_future_poll(future) == REQUEST_FUTURE_TIMEOUT, "La future doit rester expirée");
+
+    request_future_release(future);
+}
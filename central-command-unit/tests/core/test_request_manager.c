@@ -0,0 +1,165 @@
+/**
+ * @file test_request_manager.c
+ * @brief Tests unitaires pour le suivi des requêtes (échéances, renvois, expiration).
+ */
+
+#include "tests/runner.h"
+#include "core/request_manager.h"
+
+static long fakeNowMs = 0;
+
+static long fake_clock(void) {
+    return fakeNowMs;
+}
+
+typedef struct {
+    int calls;
+    bool timedOut;
+    long calledAtMs;
+} request_test_result_t;
+
+static void on_response(const cJSON* root, const command_response_header_t* header, void* context) {
+    request_test_result_t* result = (request_test_result_t*)context;
+    result->calls++;
+    result->timedOut = (root == NULL && !header->success
+        && strcmp(header->errorMessage, REQUEST_MANAGER_TIMEOUT_MESSAGE) == 0);
+    result->calledAtMs = fakeNowMs;
+}
+
+static void run_until(timer_wheel_t* wheel, long untilMs) {
+    while (fakeNowMs < untilMs) {
+        fakeNowMs += 10;
+        timer_wheel_advance(wheel);
+    }
+}
+
+static void process_success(const char* requestId) {
+    command_response_header_t header = create_command_response_header(requestId, true, NULL);
+    char* payload = command_response_header_serialize(&header);
+    request_manager_process_response(payload);
+    free(payload);
+}
+
+TEST_REGISTER(test_request_manager_timeout, "Test request manager : réponse, expiration et borne des requêtes en attente") {
+    fakeNowMs = 0;
+    timer_wheel_t wheel;
+    timer_wheel_init(&wheel, 10, fake_clock);
+    request_manager_init(&wheel);
+
+    request_options_t options = { .timeoutMs = 200 };
+    request_test_result_t answered = { 0 }, expired = { 0 };
+    TEST_ASSERT(request_manager_register_with_options("REQ_ANSWERED", on_response, &answered, &options) == 0, "L'enregistrement doit réussir");
+    TEST_ASSERT(request_manager_register_with_options("REQ_EXPIRED", on_response, &expired, &options) == 0, "L'enregistrement doit réussir");
+    TEST_ASSERT(request_manager_register("REQ_EXPIRED", on_response, &expired) == -1, "Un ID déjà enregistré doit être refusé");
+
+    process_success("REQ_ANSWERED");
+    TEST_ASSERT(answered.calls == 1 && !answered.timedOut, "La réponse doit appeler le callback avec succès");
+    TEST_ASSERT(request_manager_pending_count() == 1, "La requête traitée doit être retirée");
+
+    run_until(&wheel, 190);
+    TEST_ASSERT(expired.calls == 0, "La requête ne doit pas expirer avant son échéance");
+    run_until(&wheel, 220);
+    TEST_ASSERT(expired.calls == 1 && expired.timedOut, "La requête doit expirer avec un statut d'expiration");
+    TEST_ASSERT(request_manager_pending_count() == 0, "La requête expirée doit être retirée");
+
+    run_until(&wheel, 1000);
+    process_success("REQ_ANSWERED");
+    TEST_ASSERT(answered.calls == 1 && expired.calls == 1, "Chaque callback doit être appelé une seule fois");
+
+    // Sous perte de messages, le nombre de requêtes en attente reste borné
+    char requestId[COMMAND_ID_LENGTH];
+    int accepted = 0;
+    for (int i = 0; i < REQUEST_MANAGER_MAX_PENDING + 10; i++) {
+        snprintf(requestId, sizeof(requestId), "REQ_LOST_%d", i);
+        if (request_manager_register_with_options(requestId, NULL, NULL, &options) == 0) accepted++;
+    }
+    TEST_ASSERT(accepted == REQUEST_MANAGER_MAX_PENDING, "Les enregistrements au-delà de la borne doivent être refusés");
+    run_until(&wheel, fakeNowMs + 300);
+    TEST_ASSERT(request_manager_pending_count() == 0, "Toutes les requêtes perdues doivent expirer");
+
+    timer_wheel_destroy(&wheel);
+    request_manager_destroy();
+}
+
+TEST_REGISTER(test_request_manager_retry, "Test request manager : renvois avec délai doublé et balayage sans roue") {
+    fakeNowMs = 0;
+    timer_wheel_t wheel;
+    timer_wheel_init(&wheel, 10, fake_clock);
+    request_manager_init(&wheel);
+
+    // 100 ms, puis 200 ms, puis 300 ms (plafond) : expiration à 600 ms
+    request_options_t options = { .timeoutMs = 100, .maxRetries = 2, .maxTimeoutMs = 300 };
+    request_test_result_t retried = { 0 }, answered = { 0 };
+    TEST_ASSERT(request_manager_send("test/request", "REQ_RETRIED", "{}", MQTT_QOS_AT_LEAST_ONCE, false, on_response, &retried, &options) == 0,
+        "Une requête avec renvois doit rester enregistrée même si la publication échoue");
+    TEST_ASSERT(request_manager_send("test/request", "REQ_LATE", "{}", MQTT_QOS_AT_LEAST_ONCE, false, on_response, &answered, &options) == 0,
+        "L'envoi doit réussir");
+    options.maxRetries = 0;
+    TEST_ASSERT(request_manager_send("test/request", "REQ_NO_RETRY", "{}", MQTT_QOS_AT_LEAST_ONCE, false, on_response, &answered, &options) == -1,
+        "Sans renvoi prévu, un échec de publication doit être signalé");
+
+    run_until(&wheel, 250);
+    process_success("REQ_LATE");
+    TEST_ASSERT(answered.calls == 1 && !answered.timedOut, "Une réponse arrivée après un renvoi doit être traitée");
+
+    run_until(&wheel, 590);
+    TEST_ASSERT(retried.calls == 0, "La requête ne doit pas expirer avant la fin des renvois");
+    run_until(&wheel, 620);
+    TEST_ASSERT(retried.calls == 1 && retried.timedOut, "La requête doit expirer après le dernier renvoi");
+
+    timer_wheel_destroy(&wheel);
+    request_manager_destroy();
+
+    // Sans roue : les échéances sont traitées par request_manager_sweep()
+    request_manager_init(NULL);
+    request_test_result_t swept = { 0 };
+    options.timeoutMs = 1;
+    request_manager_register_with_options("REQ_SWEPT", on_response, &swept, &options);
+    TEST_ASSERT(request_manager_sweep() == 0, "Une requête dans les délais ne doit pas être balayée");
+    usleep(5000);
+    TEST_ASSERT(request_manager_sweep() == 1 && swept.timedOut, "Le balayage doit faire expirer la requête");
+    request_manager_destroy();
+}
+
+typedef struct {
+    int threadIndex;
+    int answered;
+} request_worker_t;
+
+static void on_parallel_response(const cJSON* root, const command_response_header_t* header, void* context) {
+    UNUSED(header);
+    if (root) ((request_worker_t*)context)->answered++;
+}
+
+static void* request_worker(void* arg) {
+    request_worker_t* worker = (request_worker_t*)arg;
+    char requestId[COMMAND_ID_LENGTH];
+    for (int i = 0; i < 2000; i++) {
+        snprintf(requestId, sizeof(requestId), "REQ_T%d_%d", worker->threadIndex, i);
+        if (request_manager_register(requestId, on_parallel_response, worker) != 0) continue;
+        process_success(requestId);
+        process_success(requestId); // Doublon : doit être ignoré
+    }
+    return NULL;
+}
+
+TEST_REGISTER(test_request_manager_parallel, "Test request manager : enregistrements et réponses concurrents sur les partitions") {
+    request_manager_init(NULL);
+
+    enum { WORKERS = 4 };
+    pthread_t threads[WORKERS];
+    request_worker_t workers[WORKERS];
+    for (int i = 0; i < WORKERS; i++) {
+        workers[i] = (request_worker_t){ i, 0 };
+        pthread_create(&threads[i], NULL, request_worker, &workers[i]);
+    }
+    int answered = 0;
+    for (int i = 0; i < WORKERS; i++) {
+        pthread_join(threads[i], NULL);
+        answered += workers[i].answered;
+    }
+
+    TEST_ASSERT(answered == WORKERS * 2000, "Chaque requête doit recevoir exactement une réponse");
+    TEST_ASSERT(request_manager_pending_count() == 0, "Aucune requête ne doit rester en attente");
+    request_manager_destroy();
+}
@@ -0,0 +1,145 @@
+/**
+ * @file test_ring_buffer.c
+ * @brief Tests unitaires pour la file circulaire MPSC.
+ */
+
+#include "tests/runner.h"
+#include "core/ring_buffer.h"
+
+TEST_REGISTER(test_ring_buffer_order_and_full, "Test file circulaire : ordre FIFO, file pleine et lots") {
+    ring_buffer_t rb;
+    TEST_ASSERT(ring_buffer_init(&rb, 5, false) == 0, "L'initialisation doit réussir");
+    TEST_ASSERT(ring_buffer_capacity(&rb) == 8, "La capacité doit être arrondie à 8");
+    TEST_ASSERT(ring_buffer_is_empty(&rb), "La file doit être vide");
+
+    intptr_t values[10];
+    for (int i = 0; i < 10; i++) values[i] = i;
+
+    for (int i = 0; i < 8; i++) {
+        TEST_ASSERT(ring_buffer_try_push(&rb, &values[i]), "Les 8 premiers ajouts doivent réussir");
+    }
+    TEST_ASSERT(!ring_buffer_try_push(&rb, &values[8]), "L'ajout dans une file pleine doit échouer");
+    TEST_ASSERT(!ring_buffer_try_push(&rb, NULL), "L'ajout de NULL doit être refusé");
+
+    TEST_ASSERT(ring_buffer_pop(&rb) == &values[0], "Le premier élément doit sortir en premier");
+
+    void *batch[16];
+    size_t count = ring_buffer_pop_batch(&rb, batch, 3);
+    TEST_ASSERT(count == 3 && batch[0] == &values[1] && batch[2] == &values[3], "Le lot doit suivre l'ordre d'insertion");
+
+    // Les cases libérées sont réutilisables au tour suivant
+    TEST_ASSERT(ring_buffer_try_push(&rb, &values[8]) && ring_buffer_try_push(&rb, &values[9]), "Les cases libérées doivent être réutilisées");
+    count = ring_buffer_pop_batch(&rb, batch, 16);
+    TEST_ASSERT(count == 6 && batch[5] == &values[9], "Le reste doit être retiré dans l'ordre");
+    TEST_ASSERT(ring_buffer_is_empty(&rb) && ring_buffer_pop(&rb) == NULL, "La file doit être vide");
+    TEST_ASSERT(ring_buffer_wait(&rb, 0) == -1, "L'attente sans eventfd doit échouer");
+
+    ring_buffer_destroy(&rb);
+}
+
+#define RB_PRODUCERS 4
+#define RB_ITEMS_PER_PRODUCER 20000
+
+typedef struct {
+    ring_buffer_t* rb;
+    intptr_t base;
+} rb_producer_args_t;
+
+static void* rb_producer(void* arg) {
+    rb_producer_args_t* args = (rb_producer_args_t*)arg;
+    for (intptr_t i = 1; i <= RB_ITEMS_PER_PRODUCER; i++) {
+        // Valeurs encodées : producteur * 1e6 + séquence (jamais NULL)
+        while (!ring_buffer_try_push(args->rb, (void*)(args->base + i))) sched_yield();
+    }
+    return NULL;
+}
+
+TEST_REGISTER(test_ring_buffer_multi_producers, "Test file circulaire : producteurs concurrents et consommateur bloquant") {
+    ring_buffer_t rb;
+    TEST_ASSERT(ring_buffer_init(&rb, 256, true) == 0, "L'initialisation en mode bloquant doit réussir");
+    TEST_ASSERT(ring_buffer_wait(&rb, 10) == -1, "L'attente sur une file vide doit expirer");
+
+    pthread_t threads[RB_PRODUCERS];
+    rb_producer_args_t args[RB_PRODUCERS];
+    for (int p = 0; p < RB_PRODUCERS; p++) {
+        args[p] = (rb_producer_args_t){ &rb, (intptr_t)(p + 1) * 1000000 };
+        pthread_create(&threads[p], NULL, rb_producer, &args[p]);
+    }
+
+    intptr_t lastSeen[RB_PRODUCERS] = {0};
+    int received = 0;
+    bool ordered = true;
+    void* batch[64];
+    while (received < RB_PRODUCERS * RB_ITEMS_PER_PRODUCER) {
+        size_t count = ring_buffer_pop_batch(&rb, batch, 64);
+        if (count == 0) {
+            ring_buffer_wait(&rb, 100);
+            continue;
+        }
+        for (size_t i = 0; i < count; i++) {
+            intptr_t value = (intptr_t)batch[i];
+            int producer = (int)(value / 1000000) - 1;
+            intptr_t sequence = value % 1000000;
+            if (producer < 0 || producer >= RB_PRODUCERS || sequence != lastSeen[producer] + 1) ordered = false;
+            else lastSeen[producer] = sequence;
+        }
+        received += (int)count;
+    }
+
+    for (int p = 0; p < RB_PRODUCERS; p++) pthread_join(threads[p], NULL);
+
+    TEST_ASSERT(ordered, "Chaque élément doit être reçu une fois, dans l'ordre de son producteur");
+    TEST_ASSERT(ring_buffer_is_empty(&rb), "La file doit être vide à la fin");
+
+    ring_buffer_wake(&rb);
+    TEST_ASSERT(ring_buffer_wait(&rb, 1000) == 0, "ring_buffer_wake doit réveiller le consommateur");
+
+    ring_buffer_destroy(&rb);
+}
+
+typedef struct {
+    int id;
+    char text[100];
+} rb_test_slot_t;
+
+TEST_REGISTER(test_ring_buffer_slots, "Test file circulaire : cases de taille fixe remplies en place") {
+    ring_buffer_t rb;
+    TEST_ASSERT(ring_buffer_init_slots(&rb, 4, sizeof(rb_test_slot_t), false) == 0, "L'initialisation doit réussir");
+
+    rb_test_slot_t* first = ring_buffer_claim(&rb);
+    rb_test_slot_t* second = ring_buffer_claim(&rb);
+    TEST_ASSERT(first && second && first != second, "Deux réservations doivent donner deux cases distinctes");
+
+    // La seconde case est publiée avant la première : la lecture doit attendre la première
+    second->id = 2;
+    snprintf(second->text, sizeof(second->text), "second");
+    ring_buffer_publish(&rb, second);
+    TEST_ASSERT(ring_buffer_peek(&rb) == NULL, "Une case réservée non publiée doit bloquer la lecture");
+
+    first->id = 1;
+    snprintf(first->text, sizeof(first->text), "first");
+    ring_buffer_publish(&rb, first);
+
+    rb_test_slot_t* slot = ring_buffer_peek(&rb);
+    TEST_ASSERT(slot && slot->id == 1 && strcmp(slot->text, "first") == 0, "La première case doit être lue en premier");
+    ring_buffer_release(&rb);
+    slot = ring_buffer_peek(&rb);
+    TEST_ASSERT(slot && slot->id == 2 && strcmp(slot->text, "second") == 0, "La seconde case doit suivre");
+    ring_buffer_release(&rb);
+    TEST_ASSERT(ring_buffer_is_empty(&rb), "La file doit être vide");
+
+    for (int i = 0; i < 4; i++) {
+        slot = ring_buffer_claim(&rb);
+        TEST_ASSERT(slot != NULL, "Les 4 cases doivent être réservables après libération");
+        ring_buffer_publish(&rb, slot);
+    }
+    TEST_ASSERT(ring_buffer_claim(&rb) == NULL, "La réservation dans une file pleine doit échouer");
+
+    // Lecture d'un lot sans libération, puis libération groupée
+    TEST_ASSERT(ring_buffer_peek_at(&rb, 3) != NULL && ring_buffer_peek_at(&rb, 4) == NULL, "peek_at doit s'arrêter à la dernière case publiée");
+    TEST_ASSERT(ring_buffer_peek_at(&rb, 0) == ring_buffer_peek(&rb), "peek_at(0) doit être équivalent à peek");
+    ring_buffer_release_n(&rb, 4);
+    TEST_ASSERT(ring_buffer_is_empty(&rb) && ring_buffer_claim(&rb) != NULL, "Les cases libérées en groupe doivent être réutilisables");
+
+    ring_buffer_destroy(&rb);
+}
@@ -0,0 +1,76 @@
+/**
+ * @file test_service_control.c
+ * @brief Tests unitaires pour le topic de contrôle des services (SET_LOG_LEVEL)
+ * @details Ces tests n'ont pas besoin de broker : les commandes sont passées directement
+ * au gestionnaire, sans topic de réponse.
+ */
+
+#include "tests/runner.h"
+#include "core/service_control.h"
+#include "core/logger.h"
+
+#define TEST_CLIENT_ID "test-control"
+#define TEST_CONTROL_TOPIC "services/" TEST_CLIENT_ID "/control"
+
+static void log_callback(log_level_t level, const char *msg) {
+    UNUSED(level);
+    UNUSED(msg);
+}
+
+static int parse_request(const char *json, set_log_level_request_t *request) {
+    *request = (set_log_level_request_t) {0};
+    cJSON *root = cJSON_Parse(json);
+    if (!root) return -1;
+    return set_log_level_request_data_deserialize(root, request);
+}
+
+TEST_REGISTER(test_set_log_level_request_deserialize, "Test de désérialisation de SET_LOG_LEVEL") {
+    set_log_level_request_t request;
+
+    TEST_ASSERT(parse_request("{\"module\": \"CAMERA\", \"level\": \"DEBUG\"}", &request) == 0, "Commande avec module valide");
+    TEST_ASSERT(request.hasModule && request.module == LOG_MODULE_CAMERA && request.level == LOG_LEVEL_DEBUG, "Module et niveau lus");
+
+    TEST_ASSERT(parse_request("{\"level\": \"ERROR\"}", &request) == 0, "Commande sans module (niveau global)");
+    TEST_ASSERT(!request.hasModule && request.level == LOG_LEVEL_ERROR, "Niveau global lu");
+
+    TEST_ASSERT(parse_request("{\"module\": \"uart\", \"level\": \"INHERIT\"}", &request) == 0, "INHERIT avec module");
+    TEST_ASSERT(request.module == LOG_MODULE_UART && request.level == LOG_MODULE_INHERIT, "INHERIT lu");
+
+    TEST_ASSERT(parse_request("{\"level\": \"INHERIT\"}", &request) == -1, "INHERIT sans module doit être refusé");
+    TEST_ASSERT(parse_request("{\"module\": \"MQTT\", \"level\": \"VERBOSE\"}", &request) == -1, "Niveau inconnu refusé");
+    TEST_ASSERT(parse_request("{\"module\": \"GPS\", \"level\": \"DEBUG\"}", &request) == -1, "Module inconnu refusé");
+    TEST_ASSERT(parse_request("{\"module\": \"MQTT\"}", &request) == -1, "Niveau manquant refusé");
+}
+
+static bool handle_control(const char* topic, const char* payload) {
+    return service_control_handle_message(topic, payload, strlen(payload));
+}
+
+TEST_REGISTER(test_service_control_set_log_level, "Test du traitement de SET_LOG_LEVEL sur le topic de contrôle") {
+    logger_init(LOG_LEVEL_INFO, log_callback);
+
+    // Sans client MQTT l'abonnement échoue, mais le topic de contrôle est connu du gestionnaire
+    service_control_init(TEST_CLIENT_ID);
+
+    TEST_ASSERT(!handle_control("services/other/control", "{}"), "Un autre topic n'est pas traité");
+
+    bool handled = handle_control(TEST_CONTROL_TOPIC,
+        "{\"commandId\": \"c1\", \"action\": \"SET_LOG_LEVEL\", \"replyTopic\": \"\", \"module\": \"PLANNER\", \"level\": \"DEBUG\"}");
+    TEST_ASSERT(handled, "Le message de contrôle doit être traité");
+    TEST_ASSERT(logger_get_module_level(LOG_MODULE_PLANNER) == LOG_LEVEL_DEBUG, "Le module PLANNER doit passer en DEBUG");
+    TEST_ASSERT(logger_get_module_level(LOG_MODULE_MQTT) == LOG_LEVEL_INFO, "Les autres modules ne changent pas");
+
+    handled = handle_control(TEST_CONTROL_TOPIC,
+        "{\"commandId\": \"c2\", \"action\": \"SET_LOG_LEVEL\", \"replyTopic\": \"\", \"level\": \"WARNING\"}");
+    TEST_ASSERT(handled && logger_get_module_level(LOG_MODULE_MQTT) == LOG_LEVEL_WARNING, "Le niveau global doit passer en WARNING");
+    TEST_ASSERT(logger_get_module_level(LOG_MODULE_PLANNER) == LOG_LEVEL_DEBUG, "Le niveau propre au module est conservé");
+
+    handled = handle_control(TEST_CONTROL_TOPIC,
+        "{\"commandId\": \"c3\", \"action\": \"SET_LOG_LEVEL\", \"replyTopic\": \"\", \"module\": \"PLANNER\", \"level\": \"INHERIT\"}");
+    TEST_ASSERT(handled && logger_get_module_level(LOG_MODULE_PLANNER) == LOG_LEVEL_WARNING, "Le module doit revenir au niveau global");
+
+    TEST_ASSERT(handle_control(TEST_CONTROL_TOPIC, "not json"), "Un message invalide reste consommé");
+
+    logger_set_level(LOG_LEVEL_INFO);
+    logger_destroy();
+}
@@ -0,0 +1,51 @@
+/**
+ * @file test_thread_pool.c
+ * @brief Tests unitaires pour le pool de threads de calcul.
+ */
+
+#include "tests/runner.h"
+#include "core/thread_pool.h"
+
+typedef struct {
+    int* hits;
+    int* workerOf;
+    int workerCount;
+} pool_test_context_t;
+
+static void count_task(int index, int workerIndex, void* context) {
+    pool_test_context_t* ctx = (pool_test_context_t*)context;
+    __atomic_fetch_add(&ctx->hits[index], 1, __ATOMIC_RELAXED);
+    ctx->workerOf[index] = workerIndex;
+}
+
+TEST_REGISTER(test_thread_pool_parallel_for, "Test pool de threads : chaque indice est traité une seule fois") {
+    const int count = 5000;
+    thread_pool_t* pool = thread_pool_create(4);
+    TEST_ASSERT(pool != NULL, "La création du pool ne doit pas échouer");
+    TEST_ASSERT(thread_pool_size(pool) == 4, "Le pool doit compter 4 workers");
+
+    int* hits = calloc(count, sizeof(int));
+    int* workerOf = calloc(count, sizeof(int));
+    pool_test_context_t ctx = { hits, workerOf, thread_pool_size(pool) };
+
+    // Plusieurs boucles successives : les workers doivent être réutilisés
+    for (int round = 0; round < 3; round++) {
+        TEST_ASSERT(thread_pool_parallel_for(pool, count, count_task, &ctx) == 0, "La boucle parallèle doit réussir");
+    }
+
+    bool allThree = true, validWorkers = true;
+    for (int i = 0; i < count; i++) {
+        if (hits[i] != 3) allThree = false;
+        if (workerOf[i] < 0 || workerOf[i] >= ctx.workerCount) validWorkers = false;
+    }
+    TEST_ASSERT(allThree, "Chaque indice doit être traité exactement une fois par boucle");
+    TEST_ASSERT(validWorkers, "Les indices de worker doivent être dans [0, taille du pool)");
+
+    TEST_ASSERT(thread_pool_parallel_for(pool, 0, count_task, &ctx) == 0, "Une boucle vide doit réussir");
+    TEST_ASSERT(thread_pool_parallel_for(pool, -1, count_task, &ctx) == -1, "Un nombre d'itérations négatif doit être refusé");
+    TEST_ASSERT(thread_pool_parallel_for(NULL, 1, count_task, &ctx) == -1, "Un pool NULL doit être refusé");
+
+    free(hits);
+    free(workerOf);
+    thread_pool_destroy(pool);
+}
@@ -0,0 +1,162 @@
+/**
+ * @file test_timer_wheel.c
+ * @brief Tests unitaires pour la roue de timers hiérarchique.
+ */
+
+#include "tests/runner.h"
+#include "core/timer_wheel.h"
+
+static long fakeNowMs = 0;
+
+static long fake_clock(void) {
+    return fakeNowMs;
+}
+
+typedef struct {
+    int fired;
+    long firedAtMs;
+} wheel_test_timer_t;
+
+static void on_expired(timer_wheel_timer_t* timer, void* context) {
+    UNUSED(timer);
+    wheel_test_timer_t* t = (wheel_test_timer_t*)context;
+    t->fired++;
+    t->firedAtMs = fakeNowMs;
+}
+
+/** Avance l'horloge simulée milliseconde par milliseconde jusqu'à untilMs. */
+static void run_until(timer_wheel_t* wheel, long untilMs, long stepMs) {
+    while (fakeNowMs < untilMs) {
+        fakeNowMs += stepMs;
+        timer_wheel_advance(wheel);
+    }
+}
+
+TEST_REGISTER(test_timer_wheel_expiry, "Test roue de timers : échéances sur tous les niveaux, jamais en avance") {
+    fakeNowMs = 1000;
+    timer_wheel_t wheel;
+    TEST_ASSERT(timer_wheel_init(&wheel, 10, fake_clock) == 0, "L'initialisation de la roue doit réussir");
+
+    // Niveau 0, niveau 1 (> 640 ms), niveau 2 (> 40,96 s) et niveau 3 (> 43 min)
+    const int delays[] = { 0, 15, 630, 700, 5000, 41000, 300000, 3000000 };
+    const int count = (int)(sizeof(delays) / sizeof(delays[0]));
+    timer_wheel_timer_t timers[8];
+    wheel_test_timer_t results[8] = { 0 };
+    for (int i = 0; i < count; i++) {
+        timer_wheel_timer_init(&timers[i], on_expired, &results[i]);
+        TEST_ASSERT(timer_wheel_schedule(&wheel, &timers[i], delays[i], 0) == 0, "La programmation doit réussir");
+    }
+    TEST_ASSERT(timer_wheel_pending_count(&wheel) == (size_t)count, "Tous les timers doivent être en attente");
+
+    long startMs = fakeNowMs;
+    run_until(&wheel, startMs + 3000000 + 20, 5);
+
+    bool allFiredOnce = true, neverEarly = true, onTime = true;
+    for (int i = 0; i < count; i++) {
+        if (results[i].fired != 1) allFiredOnce = false;
+        long latency = results[i].firedAtMs - (startMs + delays[i]);
+        if (latency < 0) neverEarly = false;
+        if (latency > 15) onTime = false; // Arrondi au tick + pas de la simulation
+    }
+    TEST_ASSERT(allFiredOnce, "Chaque timer doit expirer exactement une fois");
+    TEST_ASSERT(neverEarly, "Aucun timer ne doit expirer avant son délai");
+    TEST_ASSERT(onTime, "Chaque timer doit expirer au plus un tick et un pas après son délai");
+    TEST_ASSERT(timer_wheel_pending_count(&wheel) == 0, "Aucun timer ne doit rester en attente");
+    TEST_ASSERT(timer_wheel_next_timeout(&wheel) == -1, "Sans timer, aucune échéance ne doit être prévue");
+
+    timer_wheel_destroy(&wheel);
+}
+
+TEST_REGISTER(test_timer_wheel_periodic_cancel, "Test roue de timers : périodique, annulation, reprogrammation et saut des ticks vides") {
+    fakeNowMs = 0;
+    timer_wheel_t wheel;
+    timer_wheel_init(&wheel, 10, fake_clock);
+
+    timer_wheel_timer_t periodic, cancelled, moved;
+    wheel_test_timer_t rPeriodic = { 0 }, rCancelled = { 0 }, rMoved = { 0 };
+    timer_wheel_timer_init(&periodic, on_expired, &rPeriodic);
+    timer_wheel_timer_init(&cancelled, on_expired, &rCancelled);
+    timer_wheel_timer_init(&moved, on_expired, &rMoved);
+
+    timer_wheel_schedule(&wheel, &periodic, 100, 100);
+    timer_wheel_schedule(&wheel, &cancelled, 50, 0);
+    timer_wheel_schedule(&wheel, &moved, 5000, 0);
+    TEST_ASSERT(timer_wheel_next_timeout(&wheel) == 50, "La prochaine échéance doit être celle du timer le plus proche");
+
+    TEST_ASSERT(timer_wheel_cancel(&wheel, &cancelled), "L'annulation d'un timer en attente doit réussir");
+    TEST_ASSERT(!timer_wheel_cancel(&wheel, &cancelled), "Une seconde annulation doit indiquer que le timer n'était plus en attente");
+    TEST_ASSERT(!timer_wheel_is_pending(&wheel, &cancelled), "Le timer annulé ne doit plus être en attente");
+
+    // Reprogrammation plus proche d'un timer déjà placé au niveau 1
+    timer_wheel_schedule(&wheel, &moved, 250, 0);
+
+    run_until(&wheel, 1000, 1);
+    TEST_ASSERT(rPeriodic.fired == 10, "Le timer périodique doit expirer toutes les 100 ms");
+    TEST_ASSERT(rCancelled.fired == 0, "Le timer annulé ne doit pas expirer");
+    TEST_ASSERT(rMoved.fired == 1 && rMoved.firedAtMs == 250, "Le timer reprogrammé doit expirer à sa nouvelle échéance");
+
+    // Saut de 10 s d'un coup : une seule expiration, les périodes manquées ne sont pas rattrapées
+    fakeNowMs += 10000;
+    TEST_ASSERT(timer_wheel_advance(&wheel) == 1, "Une roue en retard ne doit pas rattraper les périodes manquées");
+    TEST_ASSERT(timer_wheel_cancel(&wheel, &periodic), "Le timer périodique doit rester en attente jusqu'à son annulation");
+
+    // Beaucoup de timers : insertion et annulation à coût constant
+    enum { MANY = 5000 };
+    timer_wheel_timer_t* many = calloc(MANY, sizeof(timer_wheel_timer_t));
+    wheel_test_timer_t manyResult = { 0 };
+    for (int i = 0; i < MANY; i++) {
+        timer_wheel_timer_init(&many[i], on_expired, &manyResult);
+        timer_wheel_schedule(&wheel, &many[i], 1000 + (i % 997) * 37, 0);
+    }
+    for (int i = 0; i < MANY; i += 2) timer_wheel_cancel(&wheel, &many[i]);
+    TEST_ASSERT(timer_wheel_pending_count(&wheel) == MANY / 2, "La moitié des timers doit rester en attente");
+    run_until(&wheel, fakeNowMs + 1000 + 997 * 37, 10);
+    TEST_ASSERT(manyResult.fired == MANY / 2, "Seuls les timers non annulés doivent expirer");
+    free(many);
+
+    timer_wheel_destroy(&wheel);
+}
+
+typedef struct {
+    int fired;
+    event_loop_t* loop;
+} wheel_real_timer_t;
+
+static void on_real_expired(timer_wheel_timer_t* timer, void* context) {
+    UNUSED(timer);
+    wheel_real_timer_t* t = (wheel_real_timer_t*)context;
+    __atomic_add_fetch(&t->fired, 1, __ATOMIC_RELAXED);
+    if (t->loop) event_loop_stop(t->loop);
+}
+
+TEST_REGISTER(test_timer_wheel_drivers, "Test roue de timers : thread dédié et boucle d'événements") {
+    // Thread dédié : programmé depuis un autre thread, le réveil est anticipé
+    timer_wheel_t wheel;
+    timer_wheel_init(&wheel, 5, NULL);
+    TEST_ASSERT(timer_wheel_start_thread(&wheel) == 0, "Le démarrage du thread doit réussir");
+    TEST_ASSERT(timer_wheel_start_thread(&wheel) == -1, "Un second démarrage doit être refusé");
+
+    timer_wheel_timer_t timer;
+    wheel_real_timer_t result = { 0 };
+    timer_wheel_timer_init(&timer, on_real_expired, &result);
+    timer_wheel_schedule(&wheel, &timer, 20, 0);
+    for (int i = 0; i < 100 && __atomic_load_n(&result.fired, __ATOMIC_RELAXED) == 0; i++) usleep(5000);
+    TEST_ASSERT(result.fired == 1, "Le thread dédié doit faire expirer le timer");
+    timer_wheel_destroy(&wheel);
+
+    // Boucle d'événements : le callback arrête la boucle
+    event_loop_t* loop = event_loop_create();
+    timer_wheel_init(&wheel, 5, NULL);
+    TEST_ASSERT(timer_wheel_attach(&wheel, loop) == 0, "L'attachement à la boucle doit réussir");
+
+    wheel_real_timer_t loopResult = { 0, loop };
+    timer_wheel_timer_init(&timer, on_real_expired, &loopResult);
+    timer_wheel_schedule(&wheel, &timer, 30, 0);
+    long startMs = timer_wheel_now_ms();
+    TEST_ASSERT(event_loop_run(loop) == 0, "La boucle doit s'arrêter depuis le callback du timer");
+    TEST_ASSERT(loopResult.fired == 1, "Le timer doit expirer dans la boucle");
+    TEST_ASSERT(timer_wheel_now_ms() - startMs >= 30, "Le timer ne doit pas expirer avant son délai");
+
+    timer_wheel_destroy(&wheel);
+    event_loop_destroy(loop);
+}
@@ -0,0 +1,122 @@
+/**
+ * @file test-batch.c
+ * @brief Tests unitaires pour la planification de trajets par lot.
+ * @details Teste l'espace de travail Dijkstra réutilisable et le calcul parallèle d'un lot.
+ */
+
+#include "tests/runner.h"
+#include "core/graph.h"
+#include "route-planner/dijkstra.h"
+#include "route-planner/route_batch.h"
+
+/**
+ * @brief Crée une route linéaire à double sens 0 <-> 1 <-> ... <-> n-1 (coût 1 par tronçon),
+ * plus un noeud isolé d'ID n.
+ */
+static graph_t* create_batch_graph(int numNodes) {
+    graph_t* g = graph_create(numNodes + 1);
+    for (int i = 0; i <= numNodes; i++) {
+        graph_init_node(g, i, i, 0, NODE_TYPE_WAYPOINT);
+    }
+    for (int i = 0; i < numNodes - 1; i++) {
+        graph_add_edge(g, i, i + 1, 1, LANE_RULE_DRIVE_RIGHT);
+        graph_add_edge(g, i + 1, i, 1, LANE_RULE_DRIVE_RIGHT);
+    }
+    return g;
+}
+
+// Test 1: Réutilisation de l'espace de travail
+TEST_REGISTER(test_dijkstra_workspace_reuse, "Test Dijkstra : espace de travail réutilisé entre recherches") {
+    graph_t* g = create_batch_graph(10);
+    dijkstra_workspace_t* ws = dijkstra_workspace_create(0, false);
+    TEST_ASSERT(ws != NULL, "La création de l'espace de travail ne doit pas échouer");
+
+    dijkstra_stats_t stats;
+    path_t first = dijkstra_find_path_ws(ws, g, graph_get_node(g, 0), graph_get_node(g, 9), NULL, &stats);
+    TEST_ASSERT(first.length == 10 && stats.pathCost == 9.0, "Chemin 0 -> 9 de coût 9");
+    TEST_ASSERT(ws->capacity >= g->numNodes, "L'espace de travail doit s'agrandir à la taille du graphe");
+
+    // Une seconde recherche ne doit pas voir les coûts de la première
+    path_t second = dijkstra_find_path_ws(ws, g, graph_get_node(g, 7), graph_get_node(g, 5), NULL, &stats);
+    TEST_ASSERT(second.length == 3 && stats.pathCost == 2.0, "Chemin 7 -> 5 de coût 2");
+
+    path_t none = dijkstra_find_path_ws(ws, g, graph_get_node(g, 0), graph_get_node(g, 10), NULL, &stats);
+    TEST_ASSERT(none.length == 0 && isinf(stats.pathCost), "Aucun chemin vers le noeud isolé");
+
+    path_destroy(&first);
+    path_destroy(&second);
+    dijkstra_workspace_destroy(ws);
+    graph_destroy(g);
+}
+
+// Test 2: Lot avec échecs partiels
+TEST_REGISTER(test_route_batch_partial_failures, "Test lot : résultats par entrée et échecs partiels") {
+    graph_t* g = create_batch_graph(10);
+    route_batch_planner_t* planner = route_batch_planner_create(3);
+    TEST_ASSERT(planner != NULL, "La création du planificateur ne doit pas échouer");
+
+    int route[3] = { 0, 9, 4 };
+    int optimized[4] = { 0, 7, 2, 9 };
+    int unknown[2] = { 0, 42 };
+    int isolated[2] = { 0, 10 };
+    plan_route_batch_entry_t entries[5] = {
+        { .carId = 1, .nodeIds = route, .nodeCount = 3 },
+        { .carId = 2, .nodeIds = optimized, .nodeCount = 4, .optimizeOrder = true },
+        { .carId = 3, .nodeIds = unknown, .nodeCount = 2 },
+        { .carId = 4, .nodeIds = isolated, .nodeCount = 2 },
+        { .carId = 5, .nodeIds = NULL, .nodeCount = 0 }
+    };
+    plan_route_batch_request_t request = { .entries = entries, .entryCount = 5, .includePath = true };
+    plan_route_batch_result_t results[5];
+
+    int failed = route_batch_planner_run(planner, g, &request, results);
+    TEST_ASSERT(failed == 3, "Trois entrées doivent être en échec");
+
+    TEST_ASSERT(results[0].success && results[0].carId == 1, "L'entrée 1 doit réussir");
+    TEST_ASSERT(results[0].cost == 14.0 && results[0].nodeCount == 15, "Trajet 0 -> 9 -> 4 : coût 14, 15 noeuds");
+    TEST_ASSERT(results[0].nodeIds[0] == 0 && results[0].nodeIds[9] == 9 && results[0].nodeIds[14] == 4, "Les noeuds du trajet doivent suivre les arrêts");
+
+    TEST_ASSERT(results[1].success && results[1].cost == 9.0, "L'ordre optimisé 0 -> 2 -> 7 -> 9 doit coûter 9");
+    TEST_ASSERT(results[1].savedDistance == 10.0, "La distance économisée doit être 19 - 9 = 10");
+
+    TEST_ASSERT(!results[2].success && results[2].nodeIds == NULL, "Un ID inconnu doit faire échouer l'entrée");
+    TEST_ASSERT(!results[3].success && strstr(results[3].errorMessage, "No path") != NULL, "Un noeud inaccessible doit être signalé");
+    TEST_ASSERT(!results[4].success && results[4].carId == 5, "Une liste d'arrêts vide doit être refusée");
+
+    for (int i = 0; i < 5; i++) free(results[i].nodeIds);
+
+    route_batch_planner_destroy(planner);
+    graph_destroy(g);
+}
+
+// Test 3: Grand lot, coûts seuls
+TEST_REGISTER(test_route_batch_many_entries, "Test lot : grand lot sans chemins, résultats dans l'ordre") {
+    const int numNodes = 200, entryCount = 300;
+    graph_t* g = create_batch_graph(numNodes);
+    route_batch_planner_t* planner = route_batch_planner_create(4);
+
+    plan_route_batch_entry_t* entries = calloc(entryCount, sizeof(plan_route_batch_entry_t));
+    int (*stops)[2] = calloc(entryCount, sizeof(*stops));
+    for (int i = 0; i < entryCount; i++) {
+        stops[i][0] = i % numNodes;
+        stops[i][1] = (i * 37) % numNodes;
+        entries[i] = (plan_route_batch_entry_t) { .carId = i, .nodeIds = stops[i], .nodeCount = 2 };
+    }
+    plan_route_batch_request_t request = { .entries = entries, .entryCount = entryCount, .includePath = false };
+    plan_route_batch_result_t* results = calloc(entryCount, sizeof(plan_route_batch_result_t));
+
+    TEST_ASSERT(route_batch_planner_run(planner, g, &request, results) == 0, "Aucune entrée ne doit échouer");
+
+    bool allMatch = true;
+    for (int i = 0; i < entryCount; i++) {
+        double expected = abs(stops[i][1] - stops[i][0]);
+        if (results[i].carId != i || results[i].cost != expected || results[i].nodeIds != NULL) allMatch = false;
+    }
+    TEST_ASSERT(allMatch, "Chaque résultat doit correspondre à son entrée (coût = distance sur la ligne)");
+
+    free(results);
+    free(stops);
+    free(entries);
+    route_batch_planner_destroy(planner);
+    graph_destroy(g);
+}
@@ -148,4 +148,23 @@ TEST_REGISTER(test_dijkstra_start_equals_end, "Test Dijkstra : nœud de départ
 
     path_destroy(&path);
     graph_destroy(g);
-}
\ No newline at end of file
+}
+// Test 6: Les IDs des noeuds ne correspondent pas à leur index (carte issue de la base de données)
+TEST_REGISTER(test_dijkstra_ids_differ_from_index, "Test Dijkstra : IDs de noeuds différents des index") {
+    graph_t* g = graph_create(3);
+    g->nodes[0].id = 10;
+    g->nodes[1].id = 20;
+    g->nodes[2].id = 30;
+    graph_add_edge(g, 10, 20, 1, LANE_RULE_DRIVE_RIGHT);
+    graph_add_edge(g, 20, 30, 1, LANE_RULE_DRIVE_RIGHT);
+
+    path_t path = dijkstra_find_path(g, graph_get_node_by_id(g, 10), graph_get_node_by_id(g, 30));
+
+    TEST_ASSERT(path.length == 3, "Le chemin doit contenir 3 nœuds");
+    if (path.length == 3) {
+        TEST_ASSERT(path.nodes[0]->id == 10 && path.nodes[1]->id == 20 && path.nodes[2]->id == 30, "Le chemin doit être 10 -> 20 -> 30");
+    }
+
+    path_destroy(&path);
+    graph_destroy(g);
+}
@@ -0,0 +1,48 @@
+/**
+ * @file test-instance.c
+ * @brief Tests unitaires pour les topics d'une instance du route planner.
+ * @details Teste les topics propres à chaque instance et l'abonnement partagé aux requêtes.
+ */
+
+#include "tests/runner.h"
+#include "route-planner/route_planner_message_callback.h"
+
+// Test 1: Topics d'une instance et d'une instance unique
+TEST_REGISTER(test_route_planner_instance_topics, "Test route planner : topics de status et de réponse par instance") {
+    char topic[ROUTE_PLANNER_TOPIC_LENGTH];
+
+    TEST_ASSERT(route_planner_instance_topic("2", "status", topic, sizeof(topic)) == 0, "Le topic doit tenir dans le buffer");
+    TEST_ASSERT(strcmp(topic, "services/route-planner/2/status") == 0, "L'instance doit être un niveau du topic de status");
+
+    TEST_ASSERT(route_planner_instance_topic("", "response", topic, sizeof(topic)) == 0, "Le topic doit tenir dans le buffer");
+    TEST_ASSERT(strcmp(topic, ROUTE_PLANNER_REPLY_TOPIC) == 0, "Sans instance, le topic de réponse historique doit être conservé");
+
+    TEST_ASSERT(route_planner_instance_topic(NULL, "status", topic, sizeof(topic)) == 0 && strcmp(topic, LWT_TOPIC) == 0,
+        "Sans instance, le topic de status historique doit être conservé");
+
+    char small[16];
+    TEST_ASSERT(route_planner_instance_topic("2", "status", small, sizeof(small)) == -1, "Un buffer trop petit doit être signalé");
+}
+
+// Test 2: Messages de status
+TEST_REGISTER(test_route_planner_status_message, "Test route planner : message de status avec l'instance") {
+    char payload[256];
+
+    TEST_ASSERT(route_planner_status_message("2", false, payload, sizeof(payload)) == 0, "Le message doit tenir dans le buffer");
+    TEST_ASSERT(strcmp(payload, "{\"service\":\"route_planner\",\"instance\":\"2\",\"status\":\"offline\"}") == 0,
+        "Le message doit porter l'instance et son status");
+
+    TEST_ASSERT(route_planner_status_message("", true, payload, sizeof(payload)) == 0 && strcmp(payload, LWT_MESSAGE_ONLINE) == 0,
+        "Sans instance, le message historique doit être conservé");
+}
+
+// Test 3: Abonnement partagé
+TEST_REGISTER(test_route_planner_request_subscription, "Test route planner : abonnement partagé aux requêtes") {
+    char topic[ROUTE_PLANNER_TOPIC_LENGTH];
+
+    TEST_ASSERT(route_planner_request_subscription("planners", topic, sizeof(topic)) == 0, "Le topic doit tenir dans le buffer");
+    TEST_ASSERT(strcmp(topic, "$share/planners/" ROUTE_PLANNER_REQUEST_TOPIC) == 0, "Le groupe doit préfixer le topic de requête");
+
+    TEST_ASSERT(route_planner_request_subscription("", topic, sizeof(topic)) == 0 && strcmp(topic, ROUTE_PLANNER_REQUEST_TOPIC) == 0,
+        "Sans groupe, l'abonnement doit rester classique");
+}
@@ -0,0 +1,157 @@
+/**
+ * @file test-tsp.c
+ * @brief Tests unitaires pour l'optimisation de l'ordre des arrêts.
+ * @details Teste la résolution exacte, l'heuristique et les cas dégradés.
+ */
+
+#include "tests/runner.h"
+#include "core/graph.h"
+#include "route-planner/dijkstra.h"
+#include "route-planner/tsp.h"
+
+/**
+ * @brief Crée une route linéaire à double sens 0 <-> 1 <-> ... <-> n-1 (coût 1 par tronçon).
+ */
+static graph_t* create_line_graph(int numNodes) {
+    graph_t* g = graph_create(numNodes);
+    for (int i = 0; i < numNodes; i++) {
+        graph_init_node(g, i, i, 0, NODE_TYPE_WAYPOINT);
+    }
+    for (int i = 0; i < numNodes - 1; i++) {
+        graph_add_edge(g, i, i + 1, 1, LANE_RULE_DRIVE_RIGHT);
+        graph_add_edge(g, i + 1, i, 1, LANE_RULE_DRIVE_RIGHT);
+    }
+    return g;
+}
+
+// Test 1: One-to-many
+TEST_REGISTER(test_dijkstra_compute_costs, "Test Dijkstra : coûts one-to-many") {
+    graph_t* g = create_line_graph(5);
+    node_t* targets[3] = { graph_get_node(g, 4), graph_get_node(g, 0), graph_get_node(g, 2) };
+    double costs[3];
+
+    int rc = dijkstra_compute_costs(g, graph_get_node(g, 1), targets, 3, costs);
+
+    TEST_ASSERT(rc == 0, "Le calcul one-to-many doit réussir");
+    TEST_ASSERT(costs[0] == 3.0, "Coût 1 -> 4 = 3");
+    TEST_ASSERT(costs[1] == 1.0, "Coût 1 -> 0 = 1");
+    TEST_ASSERT(costs[2] == 1.0, "Coût 1 -> 2 = 1");
+
+    graph_destroy(g);
+}
+
+// Test 2: Résolution exacte (petit ensemble)
+TEST_REGISTER(test_tsp_exact_order, "Test TSP : ordre optimal exact avec départ fixe") {
+    graph_t* g = create_line_graph(10);
+    int stops[5] = { 0, 7, 2, 9, 4 }; // Coût dans l'ordre donné : 7 + 5 + 7 + 5 = 24
+    int ordered[5];
+    double saved = -1.0;
+
+    int rc = tsp_optimize_stops(g, stops, 5, false, ordered, &saved);
+
+    TEST_ASSERT(rc == 0, "L'optimisation doit réussir");
+    TEST_ASSERT(ordered[0] == 0, "Le départ doit rester en tête");
+    TEST_ASSERT(ordered[1] == 2 && ordered[2] == 4 && ordered[3] == 7 && ordered[4] == 9, "Les arrêts doivent être visités dans l'ordre de la route");
+    TEST_ASSERT(saved == 15.0, "La distance économisée doit être 24 - 9 = 15");
+
+    graph_destroy(g);
+}
+
+// Test 3: Arrivée fixe
+TEST_REGISTER(test_tsp_fixed_end, "Test TSP : le dernier arrêt reste en dernière position") {
+    graph_t* g = create_line_graph(10);
+    int stops[4] = { 0, 8, 2, 5 }; // Coût dans l'ordre donné : 8 + 6 + 3 = 17
+    int ordered[4];
+    double saved = 0.0;
+
+    int rc = tsp_optimize_stops(g, stops, 4, true, ordered, &saved);
+
+    TEST_ASSERT(rc == 0, "L'optimisation doit réussir");
+    TEST_ASSERT(ordered[0] == 0 && ordered[3] == 5, "Le départ et l'arrivée doivent être conservés");
+    TEST_ASSERT(ordered[1] == 2 && ordered[2] == 8, "Les arrêts intermédiaires doivent être réordonnés (0 -> 2 -> 8 -> 5)");
+    TEST_ASSERT(saved == 6.0, "La distance économisée doit être 17 - 11 = 6");
+
+    graph_destroy(g);
+}
+
+// Test 4: Heuristique (au-delà de TSP_EXACT_MAX_STOPS)
+TEST_REGISTER(test_tsp_heuristic_order, "Test TSP : heuristique sur un grand nombre d'arrêts") {
+    const int numStops = 20;
+    graph_t* g = create_line_graph(numStops);
+    int stops[20];
+    int ordered[20];
+    double saved = 0.0;
+
+    // Départ en 0 puis les arrêts dans un ordre mélangé
+    stops[0] = 0;
+    for (int i = 1; i < numStops; i++) {
+        stops[i] = (i * 7) % (numStops - 1) + 1;
+    }
+
+    int rc = tsp_optimize_stops(g, stops, numStops, false, ordered, &saved);
+
+    TEST_ASSERT(rc == 0, "L'optimisation doit réussir");
+    bool sorted = true;
+    for (int i = 0; i < numStops; i++) {
+        if (ordered[i] != i) sorted = false;
+    }
+    TEST_ASSERT(sorted, "Les arrêts doivent être parcourus de manière monotone (ordre optimal)");
+    TEST_ASSERT(saved > 0.0, "Une distance doit être économisée");
+
+    graph_destroy(g);
+}
+
+// Test 5: Ordre déjà optimal ou arrêt inaccessible
+TEST_REGISTER(test_tsp_keeps_order, "Test TSP : l'ordre d'origine est conservé si rien n'est gagné") {
+    graph_t* g = create_line_graph(6);
+    graph_t* isolated = graph_create(3);
+    graph_init_node(isolated, 0, 0, 0, NODE_TYPE_WAYPOINT);
+    graph_init_node(isolated, 1, 1, 0, NODE_TYPE_WAYPOINT);
+    graph_init_node(isolated, 2, 2, 0, NODE_TYPE_WAYPOINT);
+
+    int stops[4] = { 0, 1, 3, 5 };
+    int ordered[4];
+    double saved = -1.0;
+
+    int rc = tsp_optimize_stops(g, stops, 4, false, ordered, &saved);
+    TEST_ASSERT(rc == 0, "L'optimisation doit réussir");
+    TEST_ASSERT(memcmp(stops, ordered, sizeof(stops)) == 0, "Un ordre déjà optimal ne doit pas changer");
+    TEST_ASSERT(saved == 0.0, "Aucune distance ne doit être économisée");
+
+    int isolatedStops[3] = { 0, 2, 1 };
+    int isolatedOrdered[3];
+    rc = tsp_optimize_stops(isolated, isolatedStops, 3, false, isolatedOrdered, &saved);
+    TEST_ASSERT(rc == 0, "L'optimisation doit réussir même sans chemin");
+    TEST_ASSERT(memcmp(isolatedStops, isolatedOrdered, sizeof(isolatedStops)) == 0, "Sans chemin, l'ordre d'origine est conservé");
+
+    int unknownStops[3] = { 0, 42, 1 };
+    rc = tsp_optimize_stops(g, unknownStops, 3, false, isolatedOrdered, &saved);
+    TEST_ASSERT(rc == -1, "Un ID de noeud inconnu doit être refusé");
+
+    graph_destroy(isolated);
+    graph_destroy(g);
+}
+
+// Test 6: Espace de travail réutilisé (lots de requêtes)
+TEST_REGISTER(test_tsp_workspace, "Test TSP : optimisation avec un espace de travail et son arène") {
+    graph_t* g = create_line_graph(10);
+    dijkstra_workspace_t* ws = dijkstra_workspace_create(0, true);
+    TEST_ASSERT(ws != NULL, "L'espace de travail doit être créé");
+
+    for (int round = 0; round < 2; round++) {
+        int stops[5] = { 0, 7, 2, 9, 4 };
+        int ordered[5];
+        double saved = -1.0;
+
+        arena_reset(ws->arena);
+        int rc = tsp_optimize_stops_ws(ws, g, stops, 5, false, ordered, &saved);
+
+        TEST_ASSERT(rc == 0, "L'optimisation doit réussir");
+        TEST_ASSERT(ordered[1] == 2 && ordered[2] == 4 && ordered[3] == 7 && ordered[4] == 9, "L'ordre doit être le même qu'avec tsp_optimize_stops()");
+        TEST_ASSERT(saved == 15.0, "La distance économisée doit être 24 - 9 = 15");
+        TEST_ASSERT(arena_used(ws->arena) > 0, "La matrice des distances doit être allouée dans l'arène");
+    }
+
+    dijkstra_workspace_destroy(ws);
+    graph_destroy(g);
+}
@@ -0,0 +1,1023 @@
+/**
+ * @file loopback_broker.c
+ * @brief Broker MQTT embarqué dans le processus, pour les tests et les benchmarks.
+ * @details
+ * Tous les clients sont servis par le thread de la boucle d'événements : les listes de clients,
+ * d'abonnements et de messages retenus ne sont pas protégées par un verrou. Les appels venant
+ * d'un autre thread (loopback_broker_drop_client()) sont postés dans la boucle.
+ * Un client fermé pendant la distribution d'un message est seulement marqué ; il est libéré, et son
+ * LWT publié, avant la prochaine attente de la boucle (fonction de préparation).
+ * @date 2026-10-19
+ */
+#include "tests/loopback_broker.h"
+#include "core/event_loop.h"
+#include "core/timer_wheel.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+#define BROKER_KEEP_ALIVE_CHECK_MS 500
+#define BROKER_READ_CHUNK 4096
+
+enum {
+	PACKET_CONNECT = 1,
+	PACKET_CONNACK = 2,
+	PACKET_PUBLISH = 3,
+	PACKET_PUBACK = 4,
+	PACKET_PUBREC = 5,
+	PACKET_PUBREL = 6,
+	PACKET_PUBCOMP = 7,
+	PACKET_SUBSCRIBE = 8,
+	PACKET_SUBACK = 9,
+	PACKET_UNSUBSCRIBE = 10,
+	PACKET_UNSUBACK = 11,
+	PACKET_PINGREQ = 12,
+	PACKET_PINGRESP = 13,
+	PACKET_DISCONNECT = 14
+};
+
+#define CONNACK_ACCEPTED 0
+#define CONNACK_BAD_PROTOCOL 1
+#define SUBACK_FAILURE 0x80
+
+typedef struct {
+	uint8_t *data;
+	size_t length;
+	size_t capacity;
+} byte_buffer_t;
+
+/**
+ * @brief Lecture bornée d'un paquet reçu.
+ * @internal
+ */
+typedef struct {
+	const uint8_t *data;
+	size_t length;
+	size_t position;
+} packet_reader_t;
+
+typedef struct broker_subscription {
+	char *filter; //!< Filtre, sans le préfixe $share/<groupe>/
+	char *group;  //!< Groupe d'abonnement partagé (NULL : abonnement classique)
+	uint8_t qos;
+	struct broker_subscription *next;
+} broker_subscription_t;
+
+typedef struct broker_client {
+	loopback_broker_t *broker;
+	int fd;
+	char *clientId;   //!< NULL tant que CONNECT n'est pas reçu
+	bool connected;
+	bool closing;     //!< Fermé, libéré avant la prochaine attente de la boucle
+	bool publishWill; //!< Fermeture anormale : le LWT sera publié
+	bool wantWrite;   //!< Intérêt en écriture enregistré dans la boucle
+	byte_buffer_t input;
+	byte_buffer_t output;
+	uint16_t keepAliveSec;
+	long lastActivityMs;
+	uint16_t nextPacketId;
+	char *willTopic;  //!< NULL : aucun LWT
+	uint8_t *willPayload;
+	size_t willLength;
+	uint8_t willQos;
+	bool willRetain;
+	broker_subscription_t *subscriptions;
+	struct broker_client *next;
+} broker_client_t;
+
+typedef struct broker_retained {
+	char *topic;
+	uint8_t *payload;
+	size_t length;
+	uint8_t qos;
+	struct broker_retained *next;
+} broker_retained_t;
+
+/**
+ * @brief Abonnement partagé connu : les messages sont confiés tour à tour à ses membres.
+ * @internal
+ */
+typedef struct broker_share {
+	char *group;
+	char *filter;
+	unsigned cursor; //!< Nombre de messages déjà répartis
+	struct broker_share *next;
+} broker_share_t;
+
+struct loopback_broker {
+	event_loop_t *loop;
+	pthread_t thread;
+	int listenFd;
+	uint16_t port;
+	event_loop_timer_t *keepAliveTimer;
+	broker_client_t *clients;
+	broker_retained_t *retained;
+	broker_share_t *shares;
+	unsigned long generatedIds; //!< Identifiants attribués aux clients sans client id
+	loopback_broker_stats_t stats; //!< Accès atomiques
+};
+
+/**
+ * @brief Demande de coupure d'un client postée dans la boucle.
+ * @internal
+ */
+typedef struct {
+	const char *clientId;
+	sem_t done;
+	int result;
+} drop_request_t;
+
+static void route_message(loopback_broker_t *broker, const char *topic, const uint8_t *payload, size_t length, uint8_t qos);
+
+
+// Buffers et lecture des paquets
+
+static int buffer_reserve(byte_buffer_t *buffer, size_t extra) {
+	if(buffer->length + extra <= buffer->capacity) return 0;
+	size_t capacity = buffer->capacity ? buffer->capacity : BROKER_READ_CHUNK;
+	while(capacity < buffer->length + extra) capacity *= 2;
+	uint8_t *data = (uint8_t *) realloc(buffer->data, capacity);
+	if(!data) return -1;
+	buffer->data = data;
+	buffer->capacity = capacity;
+	return 0;
+}
+
+static void buffer_consume(byte_buffer_t *buffer, size_t count) {
+	buffer->length -= count;
+	if(buffer->length > 0) memmove(buffer->data, buffer->data + count, buffer->length);
+}
+
+static void put_u8(byte_buffer_t *buffer, uint8_t value) {
+	buffer->data[buffer->length++] = value;
+}
+
+static void put_u16(byte_buffer_t *buffer, uint16_t value) {
+	put_u8(buffer, (uint8_t) (value >> 8));
+	put_u8(buffer, (uint8_t) value);
+}
+
+static void put_bytes(byte_buffer_t *buffer, const void *data, size_t length) {
+	if(length > 0) memcpy(buffer->data + buffer->length, data, length);
+	buffer->length += length;
+}
+
+static void put_string(byte_buffer_t *buffer, const char *value) {
+	size_t length = strlen(value);
+	put_u16(buffer, (uint16_t) length);
+	put_bytes(buffer, value, length);
+}
+
+/**
+ * @brief Réserve la place d'un paquet et écrit son en-tête fixe.
+ * @return 0 en cas de succès, -1 en cas d'erreur d'allocation
+ * @internal
+ */
+static int begin_packet(byte_buffer_t *buffer, uint8_t header, size_t remaining) {
+	if(buffer_reserve(buffer, remaining + 5) != 0) return -1;
+	put_u8(buffer, header);
+	do {
+		uint8_t digit = remaining % 128;
+		remaining /= 128;
+		put_u8(buffer, remaining > 0 ? (digit | 0x80) : digit);
+	} while(remaining > 0);
+	return 0;
+}
+
+static int read_u8(packet_reader_t *reader, uint8_t *value) {
+	if(reader->position + 1 > reader->length) return -1;
+	*value = reader->data[reader->position++];
+	return 0;
+}
+
+static int read_u16(packet_reader_t *reader, uint16_t *value) {
+	if(reader->position + 2 > reader->length) return -1;
+	*value = (uint16_t) ((reader->data[reader->position] << 8) | reader->data[reader->position + 1]);
+	reader->position += 2;
+	return 0;
+}
+
+/**
+ * @brief Lit un champ binaire préfixé par sa taille (sans copie).
+ * @internal
+ */
+static int read_binary(packet_reader_t *reader, const uint8_t **data, size_t *length) {
+	uint16_t size;
+	if(read_u16(reader, &size) != 0 || reader->position + size > reader->length) return -1;
+	*data = reader->data + reader->position;
+	*length = size;
+	reader->position += size;
+	return 0;
+}
+
+/**
+ * @brief Lit une chaîne et la copie (terminée par '\0').
+ * @return La copie (à libérer avec free()), ou NULL si le champ est invalide
+ * @internal
+ */
+static char *read_string(packet_reader_t *reader) {
+	const uint8_t *data;
+	size_t length;
+	if(read_binary(reader, &data, &length) != 0 || memchr(data, '\0', length)) return NULL;
+	char *value = (char *) malloc(length + 1);
+	if(!value) return NULL;
+	memcpy(value, data, length);
+	value[length] = '\0';
+	return value;
+}
+
+
+// Topics
+
+/**
+ * @brief Indique si un topic est couvert par un filtre (jokers + et #).
+ * @details Un filtre commençant par un joker ne couvre pas les topics commençant par '$'.
+ * @internal
+ */
+static bool topic_matches(const char *filter, const char *topic) {
+	if(topic[0] == '$' && (filter[0] == '+' || filter[0] == '#')) return false;
+
+	while(*filter) {
+		if(*filter == '#') return true;
+		if(*filter == '+') {
+			while(*topic && *topic != '/') topic++;
+			filter++;
+		} else {
+			while(*filter && *filter != '/') {
+				if(*filter != *topic) return false;
+				filter++;
+				topic++;
+			}
+			if(*topic && *topic != '/') return false;
+		}
+
+		if(*filter == '\0') return *topic == '\0';
+		if(*topic == '\0') return strcmp(filter, "/#") == 0; // "a/#" couvre aussi "a"
+		filter++;
+		topic++;
+	}
+	return *topic == '\0';
+}
+
+static bool is_valid_filter(const char *filter) {
+	if(filter[0] == '\0') return false;
+	for(const char *c = filter; *c; c++) {
+		bool levelStart = c == filter || c[-1] == '/';
+		bool levelEnd = c[1] == '\0' || c[1] == '/';
+		if(*c == '+' && !(levelStart && levelEnd)) return false;
+		if(*c == '#' && !(levelStart && c[1] == '\0')) return false;
+	}
+	return true;
+}
+
+static bool is_valid_topic(const char *topic) {
+	return topic[0] != '\0' && !strpbrk(topic, "+#");
+}
+
+/**
+ * @brief Sépare un filtre "$share/<groupe>/<filtre>" en groupe et filtre.
+ * @return 0 si le filtre est valide (group vaut NULL pour un abonnement classique), -1 sinon
+ * @internal
+ */
+static int parse_filter(const char *value, char **group, char **filter) {
+	*group = NULL;
+	*filter = NULL;
+	const char *sharePrefix = "$share/";
+	bool shared = strncmp(value, sharePrefix, strlen(sharePrefix)) == 0;
+	if(shared) {
+		const char *name = value + strlen(sharePrefix);
+		const char *end = strchr(name, '/');
+		if(!end || end == name || memchr(name, '+', end - name) || memchr(name, '#', end - name)) return -1;
+		if(!is_valid_filter(end + 1)) return -1;
+		*group = strndup(name, end - name);
+		*filter = strdup(end + 1);
+	} else {
+		if(!is_valid_filter(value)) return -1;
+		*filter = strdup(value);
+	}
+	if(!*filter || (shared && !*group)) {
+		free(*group);
+		free(*filter);
+		return -1;
+	}
+	return 0;
+}
+
+
+// Clients
+
+static void close_client(broker_client_t *client, bool publishWill) {
+	if(client->closing) return;
+	client->closing = true;
+	client->publishWill = publishWill && client->connected;
+}
+
+static void free_client(broker_client_t *client) {
+	broker_subscription_t *subscription = client->subscriptions;
+	while(subscription) {
+		broker_subscription_t *next = subscription->next;
+		free(subscription->filter);
+		free(subscription->group);
+		free(subscription);
+		subscription = next;
+	}
+	free(client->clientId);
+	free(client->willTopic);
+	free(client->willPayload);
+	free(client->input.data);
+	free(client->output.data);
+	free(client);
+}
+
+/**
+ * @brief Envoie autant que possible des octets en attente ; le reste attend que la socket soit
+ * prête en écriture.
+ * @internal
+ */
+static void flush_client(broker_client_t *client) {
+	size_t sent = 0;
+	while(sent < client->output.length) {
+		ssize_t written = send(client->fd, client->output.data + sent, client->output.length - sent, MSG_NOSIGNAL);
+		if(written < 0) {
+			if(errno == EINTR) continue;
+			if(errno == EAGAIN || errno == EWOULDBLOCK) break;
+			close_client(client, true);
+			return;
+		}
+		sent += (size_t) written;
+	}
+	buffer_consume(&client->output, sent);
+
+	if(client->output.length > LOOPBACK_BROKER_MAX_PENDING_BYTES) {
+		close_client(client, true); // Abonné trop lent
+		return;
+	}
+	bool wantWrite = client->output.length > 0;
+	if(wantWrite != client->wantWrite) {
+		event_loop_modify_fd(client->broker->loop, client->fd, EVENT_LOOP_READ | (wantWrite ? EVENT_LOOP_WRITE : 0));
+		client->wantWrite = wantWrite;
+	}
+}
+
+/**
+ * @brief Envoie un paquet sans payload variable (acquittements, CONNACK, PINGRESP).
+ * @internal
+ */
+static void send_ack(broker_client_t *client, uint8_t header, const uint8_t *body, size_t length) {
+	if(begin_packet(&client->output, header, length) != 0) {
+		close_client(client, true);
+		return;
+	}
+	put_bytes(&client->output, body, length);
+	flush_client(client);
+}
+
+static void send_packet_id(broker_client_t *client, uint8_t header, uint16_t packetId) {
+	uint8_t body[2] = { (uint8_t) (packetId >> 8), (uint8_t) packetId };
+	send_ack(client, header, body, sizeof(body));
+}
+
+static void send_publish(broker_client_t *client, const char *topic, const uint8_t *payload, size_t length, uint8_t qos, bool retain) {
+	if(client->closing || !client->connected) return;
+
+	size_t remaining = 2 + strlen(topic) + (qos > 0 ? 2 : 0) + length;
+	if(begin_packet(&client->output, (uint8_t) ((PACKET_PUBLISH << 4) | (qos << 1) | (retain ? 1 : 0)), remaining) != 0) {
+		close_client(client, true);
+		return;
+	}
+	put_string(&client->output, topic);
+	if(qos > 0) {
+		if(++client->nextPacketId == 0) client->nextPacketId = 1;
+		put_u16(&client->output, client->nextPacketId);
+	}
+	put_bytes(&client->output, payload, length);
+	__atomic_add_fetch(&client->broker->stats.delivered, 1, __ATOMIC_RELAXED);
+	flush_client(client);
+}
+
+
+// Distribution des messages
+
+static broker_share_t *find_share(loopback_broker_t *broker, const char *group, const char *filter) {
+	for(broker_share_t *share = broker->shares; share; share = share->next) {
+		if(strcmp(share->group, group) == 0 && strcmp(share->filter, filter) == 0) return share;
+	}
+	return NULL;
+}
+
+static broker_subscription_t *find_subscription(broker_client_t *client, const char *group, const char *filter) {
+	for(broker_subscription_t *subscription = client->subscriptions; subscription; subscription = subscription->next) {
+		bool sameGroup = (!group && !subscription->group) || (group && subscription->group && strcmp(group, subscription->group) == 0);
+		if(sameGroup && strcmp(subscription->filter, filter) == 0) return subscription;
+	}
+	return NULL;
+}
+
+/**
+ * @brief Transmet un message aux abonnés : une fois par client abonné (QoS la plus haute de ses
+ * abonnements), plus une fois par abonnement partagé, au membre suivant du groupe.
+ * @internal
+ */
+static void route_message(loopback_broker_t *broker, const char *topic, const uint8_t *payload, size_t length, uint8_t qos) {
+	for(broker_client_t *client = broker->clients; client; client = client->next) {
+		if(!client->connected || client->closing) continue;
+		int grantedQos = -1;
+		for(broker_subscription_t *subscription = client->subscriptions; subscription; subscription = subscription->next) {
+			if(!subscription->group && subscription->qos > grantedQos && topic_matches(subscription->filter, topic)) {
+				grantedQos = subscription->qos;
+			}
+		}
+		if(grantedQos >= 0) {
+			send_publish(client, topic, payload, length, qos < grantedQos ? qos : (uint8_t) grantedQos, false);
+		}
+	}
+
+	for(broker_share_t *share = broker->shares; share; share = share->next) {
+		if(!topic_matches(share->filter, topic)) continue;
+
+		unsigned members = 0;
+		for(broker_client_t *client = broker->clients; client; client = client->next) {
+			if(client->connected && !client->closing && find_subscription(client, share->group, share->filter)) members++;
+		}
+		if(members == 0) continue;
+
+		unsigned chosen = share->cursor++ % members;
+		for(broker_client_t *client = broker->clients; client; client = client->next) {
+			broker_subscription_t *subscription;
+			if(!client->connected || client->closing || !(subscription = find_subscription(client, share->group, share->filter))) continue;
+			if(chosen-- == 0) {
+				send_publish(client, topic, payload, length, qos < subscription->qos ? qos : subscription->qos, false);
+				break;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Remplace (ou supprime, payload vide) le message retenu d'un topic.
+ * @internal
+ */
+static void store_retained(loopback_broker_t *broker, const char *topic, const uint8_t *payload, size_t length, uint8_t qos) {
+	broker_retained_t **link = &broker->retained;
+	while(*link && strcmp((*link)->topic, topic) != 0) link = &(*link)->next;
+
+	broker_retained_t *retained = *link;
+	if(length == 0) {
+		if(retained) {
+			*link = retained->next;
+			free(retained->topic);
+			free(retained->payload);
+			free(retained);
+		}
+		return;
+	}
+
+	uint8_t *copy = (uint8_t *) malloc(length);
+	if(!copy) return;
+	memcpy(copy, payload, length);
+	if(!retained) {
+		retained = (broker_retained_t *) calloc(1, sizeof(broker_retained_t));
+		if(!retained || !(retained->topic = strdup(topic))) {
+			free(retained);
+			free(copy);
+			return;
+		}
+		*link = retained;
+	}
+	free(retained->payload);
+	retained->payload = copy;
+	retained->length = length;
+	retained->qos = qos;
+}
+
+static void publish(loopback_broker_t *broker, const char *topic, const uint8_t *payload, size_t length, uint8_t qos, bool retain) {
+	if(retain) store_retained(broker, topic, payload, length, qos);
+	route_message(broker, topic, payload, length, qos);
+}
+
+
+// Traitement des paquets
+
+static void handle_connect(broker_client_t *client, packet_reader_t *reader) {
+	loopback_broker_t *broker = client->broker;
+	char *protocol = read_string(reader);
+	uint8_t level = 0, flags = 0;
+	uint16_t keepAlive = 0;
+	if(!protocol || read_u8(reader, &level) != 0 || read_u8(reader, &flags) != 0 || read_u16(reader, &keepAlive) != 0) {
+		free(protocol);
+		close_client(client, false);
+		return;
+	}
+	bool supported = (level == 4 && strcmp(protocol, "MQTT") == 0) || (level == 3 && strcmp(protocol, "MQIsdp") == 0);
+	free(protocol);
+	if(!supported) {
+		uint8_t refused[2] = { 0, CONNACK_BAD_PROTOCOL };
+		send_ack(client, PACKET_CONNACK << 4, refused, sizeof(refused));
+		close_client(client, false);
+		return;
+	}
+
+	char *clientId = read_string(reader);
+	if(!clientId) {
+		close_client(client, false);
+		return;
+	}
+	if(flags & 0x04) {
+		const uint8_t *willPayload;
+		client->willTopic = read_string(reader);
+		if(!client->willTopic || !is_valid_topic(client->willTopic) || read_binary(reader, &willPayload, &client->willLength) != 0) {
+			free(clientId);
+			close_client(client, false);
+			return;
+		}
+		client->willPayload = (uint8_t *) malloc(client->willLength ? client->willLength : 1);
+		if(client->willPayload && client->willLength) memcpy(client->willPayload, willPayload, client->willLength);
+		client->willQos = (flags >> 3) & 0x03;
+		client->willRetain = (flags & 0x20) != 0;
+	}
+	// Nom d'utilisateur et mot de passe ignorés
+
+	if(clientId[0] == '\0') {
+		free(clientId);
+		clientId = (char *) malloc(32);
+		if(clientId) snprintf(clientId, 32, "loopback-%lu", ++broker->generatedIds);
+	}
+	if(!clientId || (client->willTopic && !client->willPayload)) {
+		free(clientId);
+		close_client(client, false);
+		return;
+	}
+
+	// Un nouveau client de même identifiant remplace l'ancien
+	for(broker_client_t *other = broker->clients; other; other = other->next) {
+		if(other != client && other->connected && !other->closing && strcmp(other->clientId, clientId) == 0) {
+			close_client(other, true);
+		}
+	}
+
+	client->clientId = clientId;
+	client->keepAliveSec = keepAlive;
+	client->connected = true;
+	__atomic_add_fetch(&broker->stats.clients, 1, __ATOMIC_RELAXED);
+
+	uint8_t accepted[2] = { 0, CONNACK_ACCEPTED };
+	send_ack(client, PACKET_CONNACK << 4, accepted, sizeof(accepted));
+}
+
+static void handle_publish(broker_client_t *client, uint8_t flags, packet_reader_t *reader) {
+	uint8_t qos = (flags >> 1) & 0x03;
+	bool retain = (flags & 0x01) != 0;
+	uint16_t packetId = 0;
+	char *topic = read_string(reader);
+	if(!topic || qos > 2 || !is_valid_topic(topic) || (qos > 0 && read_u16(reader, &packetId) != 0)) {
+		free(topic);
+		close_client(client, true);
+		return;
+	}
+
+	__atomic_add_fetch(&client->broker->stats.received, 1, __ATOMIC_RELAXED);
+	publish(client->broker, topic, reader->data + reader->position, reader->length - reader->position, qos, retain);
+	free(topic);
+
+	// QoS 2 : le message est distribué dès sa réception, PUBREL ne fait que clore l'échange
+	if(qos == 1) send_packet_id(client, PACKET_PUBACK << 4, packetId);
+	else if(qos == 2) send_packet_id(client, PACKET_PUBREC << 4, packetId);
+}
+
+static void handle_subscribe(broker_client_t *client, packet_reader_t *reader) {
+	uint16_t packetId;
+	if(read_u16(reader, &packetId) != 0 || reader->position == reader->length) {
+		close_client(client, true);
+		return;
+	}
+
+	size_t count = 0;
+	uint8_t codes[256];
+	broker_subscription_t *granted[256]; //!< Abonnement créé ou mis à jour par chaque filtre (NULL : refusé)
+	while(reader->position < reader->length && count < sizeof(codes)) {
+		char *value = read_string(reader);
+		uint8_t qos;
+		if(!value || read_u8(reader, &qos) != 0) {
+			free(value);
+			close_client(client, true);
+			return;
+		}
+
+		char *group, *filter;
+		if(qos > 2 || parse_filter(value, &group, &filter) != 0) {
+			granted[count] = NULL;
+			codes[count++] = SUBACK_FAILURE;
+			free(value);
+			continue;
+		}
+		free(value);
+
+		broker_subscription_t *subscription = find_subscription(client, group, filter);
+		if(!subscription) {
+			subscription = (broker_subscription_t *) calloc(1, sizeof(broker_subscription_t));
+			if(group && !find_share(client->broker, group, filter)) {
+				broker_share_t *share = (broker_share_t *) calloc(1, sizeof(broker_share_t));
+				if(share && (share->group = strdup(group)) && (share->filter = strdup(filter))) {
+					share->next = client->broker->shares;
+					client->broker->shares = share;
+				} else if(share) {
+					free(share->group);
+					free(share);
+					free(subscription);
+					subscription = NULL;
+				}
+			}
+			if(!subscription) {
+				free(group);
+				free(filter);
+				granted[count] = NULL;
+				codes[count++] = SUBACK_FAILURE;
+				continue;
+			}
+			subscription->filter = filter;
+			subscription->group = group;
+			subscription->next = client->subscriptions;
+			client->subscriptions = subscription;
+		} else {
+			free(group);
+			free(filter);
+		}
+		subscription->qos = qos;
+		granted[count] = subscription;
+		codes[count++] = qos;
+	}
+
+	if(begin_packet(&client->output, PACKET_SUBACK << 4, 2 + count) != 0) {
+		close_client(client, true);
+		return;
+	}
+	put_u16(&client->output, packetId);
+	put_bytes(&client->output, codes, count);
+	flush_client(client);
+
+	// Messages retenus, après le SUBACK (pas pour les abonnements partagés)
+	for(size_t i = 0; i < count; i++) {
+		broker_subscription_t *subscription = granted[i];
+		if(!subscription || subscription->group) continue;
+		for(broker_retained_t *retained = client->broker->retained; retained; retained = retained->next) {
+			if(topic_matches(subscription->filter, retained->topic)) {
+				uint8_t qos = retained->qos < subscription->qos ? retained->qos : subscription->qos;
+				send_publish(client, retained->topic, retained->payload, retained->length, qos, true);
+			}
+		}
+	}
+}
+
+static void handle_unsubscribe(broker_client_t *client, packet_reader_t *reader) {
+	uint16_t packetId;
+	if(read_u16(reader, &packetId) != 0) {
+		close_client(client, true);
+		return;
+	}
+	while(reader->position < reader->length) {
+		char *value = read_string(reader);
+		char *group, *filter;
+		if(!value) {
+			close_client(client, true);
+			return;
+		}
+		if(parse_filter(value, &group, &filter) == 0) {
+			broker_subscription_t **link = &client->subscriptions;
+			broker_subscription_t *subscription = find_subscription(client, group, filter);
+			while(*link && *link != subscription) link = &(*link)->next;
+			if(subscription) {
+				*link = subscription->next;
+				free(subscription->filter);
+				free(subscription->group);
+				free(subscription);
+			}
+			free(group);
+			free(filter);
+		}
+		free(value);
+	}
+	send_packet_id(client, PACKET_UNSUBACK << 4, packetId);
+}
+
+static void handle_packet(broker_client_t *client, uint8_t header, const uint8_t *body, size_t length) {
+	uint8_t type = header >> 4;
+	packet_reader_t reader = { .data = body, .length = length, .position = 0 };
+	uint16_t packetId;
+
+	if(!client->connected && type != PACKET_CONNECT) {
+		close_client(client, false);
+		return;
+	}
+
+	switch(type) {
+		case PACKET_CONNECT:
+			if(client->connected) close_client(client, true);
+			else handle_connect(client, &reader);
+			break;
+		case PACKET_PUBLISH:
+			handle_publish(client, header & 0x0F, &reader);
+			break;
+		case PACKET_PUBACK:
+		case PACKET_PUBCOMP:
+			break; // Aucune retransmission : rien à libérer
+		case PACKET_PUBREC:
+			if(read_u16(&reader, &packetId) == 0) send_packet_id(client, (PACKET_PUBREL << 4) | 0x02, packetId);
+			break;
+		case PACKET_PUBREL:
+			if(read_u16(&reader, &packetId) == 0) send_packet_id(client, PACKET_PUBCOMP << 4, packetId);
+			break;
+		case PACKET_SUBSCRIBE:
+			handle_subscribe(client, &reader);
+			break;
+		case PACKET_UNSUBSCRIBE:
+			handle_unsubscribe(client, &reader);
+			break;
+		case PACKET_PINGREQ:
+			send_ack(client, PACKET_PINGRESP << 4, NULL, 0);
+			break;
+		case PACKET_DISCONNECT:
+			close_client(client, false); // Déconnexion normale : pas de LWT
+			break;
+		default:
+			close_client(client, true);
+			break;
+	}
+}
+
+/**
+ * @brief Découpe les paquets complets du buffer de réception et les traite.
+ * @internal
+ */
+static void process_input(broker_client_t *client) {
+	size_t offset = 0;
+	while(!client->closing) {
+		const uint8_t *data = client->input.data + offset;
+		size_t available = client->input.length - offset;
+		if(available < 2) break;
+
+		size_t remaining = 0, headerLength = 1;
+		uint32_t multiplier = 1;
+		bool complete = false;
+		while(headerLength < available && headerLength <= 4) {
+			uint8_t digit = data[headerLength++];
+			remaining += (digit & 0x7F) * multiplier;
+			multiplier *= 128;
+			if(!(digit & 0x80)) {
+				complete = true;
+				break;
+			}
+		}
+		if(!complete) {
+			if(headerLength > 4) close_client(client, true); // Taille sur plus de 4 octets
+			break;
+		}
+		if(remaining > LOOPBACK_BROKER_MAX_PACKET_SIZE) {
+			close_client(client, true);
+			break;
+		}
+		if(available < headerLength + remaining) break;
+
+		handle_packet(client, data[0], data + headerLength, remaining);
+		offset += headerLength + remaining;
+	}
+	buffer_consume(&client->input, offset);
+}
+
+static void on_client_event(event_loop_t *loop, int fd, uint32_t events, void *context) {
+	UNUSED(loop);
+	broker_client_t *client = (broker_client_t *) context;
+	if(client->closing) return;
+
+	if(events & EVENT_LOOP_WRITE) flush_client(client);
+	if(!(events & (EVENT_LOOP_READ | EVENT_LOOP_ERROR))) return;
+
+	while(!client->closing) {
+		if(buffer_reserve(&client->input, BROKER_READ_CHUNK) != 0) {
+			close_client(client, true);
+			return;
+		}
+		ssize_t received = recv(fd, client->input.data + client->input.length, client->input.capacity - client->input.length, 0);
+		if(received > 0) {
+			client->input.length += (size_t) received;
+			client->lastActivityMs = timer_wheel_now_ms();
+			continue;
+		}
+		if(received < 0 && errno == EINTR) continue;
+		if(received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+		process_input(client); // Paquets reçus avant la fermeture (ex : DISCONNECT)
+		close_client(client, true);
+		return;
+	}
+	process_input(client);
+}
+
+static void on_accept(event_loop_t *loop, int fd, uint32_t events, void *context) {
+	UNUSED(events);
+	loopback_broker_t *broker = (loopback_broker_t *) context;
+
+	for(;;) {
+		int clientFd = accept4(fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if(clientFd < 0) {
+			if(errno == EINTR) continue;
+			return; // EAGAIN, ou trop de descripteurs : réessayé au prochain événement
+		}
+		int noDelay = 1;
+		setsockopt(clientFd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+		broker_client_t *client = (broker_client_t *) calloc(1, sizeof(broker_client_t));
+		if(!client || event_loop_add_fd(loop, clientFd, EVENT_LOOP_READ, on_client_event, client) != 0) {
+			free(client);
+			close(clientFd);
+			continue;
+		}
+		client->broker = broker;
+		client->fd = clientFd;
+		client->lastActivityMs = timer_wheel_now_ms();
+		client->next = broker->clients;
+		broker->clients = client;
+	}
+}
+
+/**
+ * @brief Libère les clients fermés et publie leur LWT (avant chaque attente de la boucle).
+ * @internal
+ */
+static void reap_clients(event_loop_t *loop, void *context) {
+	loopback_broker_t *broker = (loopback_broker_t *) context;
+	broker_client_t **link = &broker->clients;
+	while(*link) {
+		broker_client_t *client = *link;
+		if(!client->closing) {
+			link = &client->next;
+			continue;
+		}
+
+		*link = client->next;
+		event_loop_remove_fd(loop, client->fd);
+		close(client->fd);
+		if(client->connected) __atomic_sub_fetch(&broker->stats.clients, 1, __ATOMIC_RELAXED);
+		if(client->publishWill && client->willTopic) {
+			__atomic_add_fetch(&broker->stats.wills, 1, __ATOMIC_RELAXED);
+			publish(broker, client->willTopic, client->willPayload, client->willLength, client->willQos, client->willRetain);
+		}
+		free_client(client);
+		link = &broker->clients; // Le LWT a pu fermer d'autres clients
+	}
+}
+
+static void on_keep_alive_check(event_loop_t *loop, event_loop_timer_t *timer, void *context) {
+	UNUSED(loop);
+	UNUSED(timer);
+	loopback_broker_t *broker = (loopback_broker_t *) context;
+	long now = timer_wheel_now_ms();
+	for(broker_client_t *client = broker->clients; client; client = client->next) {
+		long idleMs = now - client->lastActivityMs;
+		if(!client->connected && idleMs > LOOPBACK_BROKER_CONNECT_TIMEOUT_MS) {
+			close_client(client, false);
+		} else if(client->connected && client->keepAliveSec > 0 && idleMs > client->keepAliveSec * 1500L) {
+			close_client(client, true);
+		}
+	}
+}
+
+static void drop_client_task(event_loop_t *loop, void *data, void *context) {
+	UNUSED(loop);
+	loopback_broker_t *broker = (loopback_broker_t *) context;
+	drop_request_t *request = *(drop_request_t **) data;
+	request->result = -1;
+	for(broker_client_t *client = broker->clients; client; client = client->next) {
+		if(client->connected && !client->closing && strcmp(client->clientId, request->clientId) == 0) {
+			close_client(client, true);
+			request->result = 0;
+			break;
+		}
+	}
+	sem_post(&request->done);
+}
+
+static void *broker_thread(void *arg) {
+	loopback_broker_t *broker = (loopback_broker_t *) arg;
+	event_loop_run(broker->loop);
+	return NULL;
+}
+
+
+/**
+ * @brief Démarre un broker sur 127.0.0.1.
+ * @param port Port d'écoute (0 : port éphémère choisi par le système, voir loopback_broker_port())
+ * @return Le broker, ou NULL en cas d'erreur (port occupé, ...)
+ * @warning Le broker doit être arrêté avec loopback_broker_stop()
+ */
+loopback_broker_t *loopback_broker_start(uint16_t port) {
+	loopback_broker_t *broker = (loopback_broker_t *) calloc(1, sizeof(loopback_broker_t));
+	if(!broker) return NULL;
+
+	broker->listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if(broker->listenFd < 0) {
+		free(broker);
+		return NULL;
+	}
+	int reuse = 1;
+	setsockopt(broker->listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+	struct sockaddr_in address = { .sin_family = AF_INET, .sin_port = htons(port) };
+	socklen_t addressLength = sizeof(address);
+	inet_pton(AF_INET, LOOPBACK_BROKER_HOST, &address.sin_addr);
+	if(bind(broker->listenFd, (struct sockaddr *) &address, sizeof(address)) != 0
+		|| listen(broker->listenFd, SOMAXCONN) != 0
+		|| getsockname(broker->listenFd, (struct sockaddr *) &address, &addressLength) != 0) {
+		close(broker->listenFd);
+		free(broker);
+		return NULL;
+	}
+	broker->port = ntohs(address.sin_port);
+
+	broker->loop = event_loop_create();
+	if(!broker->loop
+		|| event_loop_add_fd(broker->loop, broker->listenFd, EVENT_LOOP_READ, on_accept, broker) != 0
+		|| event_loop_add_prepare(broker->loop, reap_clients, broker) != 0
+		|| !(broker->keepAliveTimer = event_loop_add_timer(broker->loop, BROKER_KEEP_ALIVE_CHECK_MS, BROKER_KEEP_ALIVE_CHECK_MS, on_keep_alive_check, broker))
+		|| pthread_create(&broker->thread, NULL, broker_thread, broker) != 0) {
+		event_loop_destroy(broker->loop);
+		close(broker->listenFd);
+		free(broker);
+		return NULL;
+	}
+	return broker;
+}
+
+/**
+ * @brief Retourne le port d'écoute du broker.
+ */
+uint16_t loopback_broker_port(const loopback_broker_t *broker) {
+	return broker->port;
+}
+
+/**
+ * @brief Coupe la connexion d'un client comme une perte réseau : son LWT est publié.
+ * @param broker Le broker
+ * @param clientId Identifiant du client
+ * @return 0 si le client était connecté, -1 sinon
+ */
+int loopback_broker_drop_client(loopback_broker_t *broker, const char *clientId) {
+	drop_request_t request = { .clientId = clientId, .result = -1 };
+	drop_request_t *requestPointer = &request;
+	sem_init(&request.done, 0, 0);
+	if(event_loop_post(broker->loop, drop_client_task, broker, &requestPointer, sizeof(requestPointer)) != 0) {
+		sem_destroy(&request.done);
+		return -1;
+	}
+	sem_wait(&request.done);
+	sem_destroy(&request.done);
+	return request.result;
+}
+
+/**
+ * @brief Lit les compteurs du broker (tout thread).
+ * @param broker Le broker
+ * @param stats Compteurs à remplir
+ */
+void loopback_broker_get_stats(const loopback_broker_t *broker, loopback_broker_stats_t *stats) {
+	stats->received = __atomic_load_n(&broker->stats.received, __ATOMIC_RELAXED);
+	stats->delivered = __atomic_load_n(&broker->stats.delivered, __ATOMIC_RELAXED);
+	stats->wills = __atomic_load_n(&broker->stats.wills, __ATOMIC_RELAXED);
+	stats->clients = __atomic_load_n(&broker->stats.clients, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Arrête le broker, ferme les connexions (sans publier les LWT) et libère ses ressources.
+ * @param broker Le broker (NULL accepté)
+ */
+void loopback_broker_stop(loopback_broker_t *broker) {
+	if(!broker) return;
+	event_loop_stop(broker->loop);
+	pthread_join(broker->thread, NULL);
+
+	while(broker->clients) {
+		broker_client_t *client = broker->clients;
+		broker->clients = client->next;
+		close(client->fd);
+		free_client(client);
+	}
+	while(broker->retained) {
+		broker_retained_t *retained = broker->retained;
+		broker->retained = retained->next;
+		free(retained->topic);
+		free(retained->payload);
+		free(retained);
+	}
+	while(broker->shares) {
+		broker_share_t *share = broker->shares;
+		broker->shares = share->next;
+		free(share->group);
+		free(share->filter);
+		free(share);
+	}
+	event_loop_destroy(broker->loop);
+	close(broker->listenFd);
+	free(broker);
+}
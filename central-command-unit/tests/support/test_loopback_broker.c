@@ -0,0 +1,294 @@
+/**
+ * @file test_loopback_broker.c
+ * @brief Tests unitaires pour le broker MQTT embarqué des tests.
+ * @details Les clients de ces tests écrivent les paquets MQTT 3.1.1 à la main sur une socket, pour
+ * vérifier le broker indépendamment de libmosquitto.
+ */
+
+#include "tests/runner.h"
+#include "tests/loopback_broker.h"
+
+#include <poll.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+#define RAW_TIMEOUT_MS 2000
+#define RAW_SILENCE_MS 200 //!< Attente d'un message qui ne doit pas arriver
+
+/**
+ * @brief Message reçu par un client de test.
+ */
+typedef struct {
+    uint8_t header;
+    char topic[128];
+    char payload[256];
+} raw_message_t;
+
+static int raw_read_exact(int fd, void* buffer, size_t length, int timeoutMs) {
+    size_t done = 0;
+    while (done < length) {
+        struct pollfd pfd = { .fd = fd, .events = POLLIN };
+        if (poll(&pfd, 1, timeoutMs) <= 0) return -1;
+        ssize_t received = recv(fd, (uint8_t*)buffer + done, length - done, 0);
+        if (received <= 0) return -1;
+        done += (size_t)received;
+    }
+    return 0;
+}
+
+/**
+ * @brief Lit un paquet : retourne son en-tête, le corps est copié dans body (taille dans *length).
+ */
+static int raw_read_packet(int fd, uint8_t* body, size_t* length, int timeoutMs) {
+    uint8_t header, digit;
+    size_t remaining = 0, multiplier = 1;
+    if (raw_read_exact(fd, &header, 1, timeoutMs) != 0) return -1;
+    do {
+        if (raw_read_exact(fd, &digit, 1, timeoutMs) != 0) return -1;
+        remaining += (digit & 0x7F) * multiplier;
+        multiplier *= 128;
+    } while (digit & 0x80);
+    if (remaining > *length || raw_read_exact(fd, body, remaining, timeoutMs) != 0) return -1;
+    *length = remaining;
+    return header;
+}
+
+static void raw_send(int fd, uint8_t header, const uint8_t* body, size_t length) {
+    uint8_t packet[512];
+    size_t size = 0;
+    packet[size++] = header;
+    size_t remaining = length;
+    do {
+        uint8_t digit = remaining % 128;
+        remaining /= 128;
+        packet[size++] = remaining > 0 ? (digit | 0x80) : digit;
+    } while (remaining > 0);
+    if (length > 0) memcpy(packet + size, body, length);
+    send(fd, packet, size + length, MSG_NOSIGNAL);
+}
+
+static size_t put_string(uint8_t* body, size_t offset, const char* value) {
+    size_t length = strlen(value);
+    body[offset] = (uint8_t)(length >> 8);
+    body[offset + 1] = (uint8_t)length;
+    memcpy(body + offset + 2, value, length);
+    return offset + 2 + length;
+}
+
+/**
+ * @brief Connecte un client brut (LWT optionnel) et attend le CONNACK.
+ * @return La socket, ou -1 si la connexion est refusée
+ */
+static int raw_connect(uint16_t port, const char* clientId, const char* willTopic, const char* willPayload) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in address = { .sin_family = AF_INET, .sin_port = htons(port) };
+    inet_pton(AF_INET, LOOPBACK_BROKER_HOST, &address.sin_addr);
+    if (connect(fd, (struct sockaddr*)&address, sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    uint8_t body[256];
+    size_t length = put_string(body, 0, "MQTT");
+    body[length++] = 4;                                // MQTT 3.1.1
+    body[length++] = 0x02 | (willTopic ? 0x0C : 0x00); // Clean session, LWT en QoS 1
+    body[length++] = 0;
+    body[length++] = 60;                               // Keep-alive
+    length = put_string(body, length, clientId);
+    if (willTopic) {
+        length = put_string(body, length, willTopic);
+        length = put_string(body, length, willPayload);
+    }
+    raw_send(fd, 0x10, body, length);
+
+    uint8_t ack[8];
+    size_t ackLength = sizeof(ack);
+    if (raw_read_packet(fd, ack, &ackLength, RAW_TIMEOUT_MS) != 0x20 || ackLength != 2 || ack[1] != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static int raw_subscribe(int fd, const char* filter, uint8_t qos) {
+    uint8_t body[256] = { 0, 1 };
+    size_t length = put_string(body, 2, filter);
+    body[length++] = qos;
+    raw_send(fd, 0x82, body, length);
+
+    uint8_t ack[8];
+    size_t ackLength = sizeof(ack);
+    if (raw_read_packet(fd, ack, &ackLength, RAW_TIMEOUT_MS) != 0x90 || ackLength != 3) return -1;
+    return ack[2];
+}
+
+static void raw_publish(int fd, const char* topic, const char* payload, uint8_t qos, bool retain) {
+    uint8_t body[256];
+    size_t length = put_string(body, 0, topic);
+    if (qos > 0) {
+        body[length++] = 0;
+        body[length++] = 7;
+    }
+    memcpy(body + length, payload, strlen(payload));
+    raw_send(fd, (uint8_t)(0x30 | (qos << 1) | (retain ? 1 : 0)), body, length + strlen(payload));
+}
+
+/**
+ * @brief Attend le prochain PUBLISH (les acquittements reçus entre-temps sont ignorés).
+ * @return 0 si un message a été reçu, -1 après timeoutMs
+ */
+static int raw_receive(int fd, raw_message_t* message, int timeoutMs) {
+    uint8_t body[512];
+    for (;;) {
+        size_t length = sizeof(body);
+        int header = raw_read_packet(fd, body, &length, timeoutMs);
+        if (header < 0) return -1;
+        if ((header >> 4) != 3) continue;
+
+        size_t topicLength = ((size_t)body[0] << 8) | body[1];
+        size_t offset = 2 + topicLength + (((header >> 1) & 0x03) ? 2 : 0);
+        message->header = (uint8_t)header;
+        snprintf(message->topic, sizeof(message->topic), "%.*s", (int)topicLength, (const char*)body + 2);
+        snprintf(message->payload, sizeof(message->payload), "%.*s", (int)(length - offset), (const char*)body + offset);
+        return 0;
+    }
+}
+
+// Test 1: Publication, abonnement et jokers
+TEST_REGISTER(test_loopback_broker_pub_sub, "Test loopback broker : publication, abonnement et jokers") {
+    loopback_broker_t* broker = loopback_broker_start(0);
+    TEST_ASSERT(broker && loopback_broker_port(broker) != 0, "Le broker doit démarrer sur un port éphémère");
+    if (!broker) return;
+    uint16_t port = loopback_broker_port(broker);
+
+    int subscriber = raw_connect(port, "subscriber", NULL, NULL);
+    int publisher = raw_connect(port, "publisher", NULL, NULL);
+    TEST_ASSERT(subscriber >= 0 && publisher >= 0, "Les clients doivent être acceptés");
+    TEST_ASSERT(raw_subscribe(subscriber, "vehicles/+/status", 1) == 1, "La QoS demandée doit être accordée");
+    TEST_ASSERT(raw_subscribe(subscriber, "services/#", 0) == 0, "Le joker # doit être accepté");
+    TEST_ASSERT(raw_subscribe(subscriber, "bad/#/filter", 0) == 0x80, "Un joker # hors fin de filtre doit être refusé");
+
+    raw_message_t message;
+    raw_publish(publisher, "vehicles/2/position", "ignored", 0, false);
+    raw_publish(publisher, "vehicles/2/status", "online", 1, false);
+    TEST_ASSERT(raw_receive(subscriber, &message, RAW_TIMEOUT_MS) == 0, "Le message couvert par + doit être reçu");
+    TEST_ASSERT(strcmp(message.topic, "vehicles/2/status") == 0 && strcmp(message.payload, "online") == 0, "Seul le topic couvert doit être reçu");
+    TEST_ASSERT(((message.header >> 1) & 0x03) == 1, "Le message doit être transmis en QoS 1");
+
+    raw_publish(publisher, "services", "root", 0, false);
+    TEST_ASSERT(raw_receive(subscriber, &message, RAW_TIMEOUT_MS) == 0 && strcmp(message.topic, "services") == 0,
+        "Le joker # doit couvrir le niveau parent");
+    raw_publish(publisher, "services/api/request", "cmd", 2, false);
+    TEST_ASSERT(raw_receive(subscriber, &message, RAW_TIMEOUT_MS) == 0 && ((message.header >> 1) & 0x03) == 0,
+        "La QoS transmise doit être bornée par celle de l'abonnement");
+
+    loopback_broker_stats_t stats;
+    loopback_broker_get_stats(broker, &stats);
+    TEST_ASSERT(stats.clients == 2 && stats.received == 4 && stats.delivered == 3, "Les compteurs doivent refléter le trafic");
+
+    close(subscriber);
+    close(publisher);
+    loopback_broker_stop(broker);
+}
+
+// Test 2: Messages retenus
+TEST_REGISTER(test_loopback_broker_retained, "Test loopback broker : messages retenus") {
+    loopback_broker_t* broker = loopback_broker_start(0);
+    TEST_ASSERT(broker != NULL, "Le broker doit démarrer");
+    if (!broker) return;
+    uint16_t port = loopback_broker_port(broker);
+
+    int publisher = raw_connect(port, "publisher", NULL, NULL);
+    raw_publish(publisher, "services/api/status", "online", 1, true);
+    raw_publish(publisher, "services/planner/status", "online", 0, true);
+    raw_publish(publisher, "services/planner/status", "", 1, true); // Supprime le message retenu
+
+    // Les acquittements arrivent dans l'ordre : le second suit le traitement des trois publications
+    uint8_t ack[8];
+    for (int i = 0; i < 2; i++) {
+        size_t ackLength = sizeof(ack);
+        TEST_ASSERT(raw_read_packet(publisher, ack, &ackLength, RAW_TIMEOUT_MS) == 0x40, "La publication QoS 1 doit être acquittée");
+    }
+
+    int subscriber = raw_connect(port, "late-subscriber", NULL, NULL);
+    TEST_ASSERT(raw_subscribe(subscriber, "services/+/status", 1) == 1, "L'abonnement doit réussir");
+
+    raw_message_t message;
+    TEST_ASSERT(raw_receive(subscriber, &message, RAW_TIMEOUT_MS) == 0, "Le message retenu doit être reçu à l'abonnement");
+    TEST_ASSERT(strcmp(message.topic, "services/api/status") == 0 && (message.header & 0x01), "Le message doit porter le flag retain");
+    TEST_ASSERT(raw_receive(subscriber, &message, RAW_SILENCE_MS) == -1, "Un message retenu supprimé ne doit pas être reçu");
+
+    close(subscriber);
+    close(publisher);
+    loopback_broker_stop(broker);
+}
+
+// Test 3: LWT
+TEST_REGISTER(test_loopback_broker_lwt, "Test loopback broker : LWT sur perte de connexion uniquement") {
+    loopback_broker_t* broker = loopback_broker_start(0);
+    TEST_ASSERT(broker != NULL, "Le broker doit démarrer");
+    if (!broker) return;
+    uint16_t port = loopback_broker_port(broker);
+
+    int watcher = raw_connect(port, "heartbeat", NULL, NULL);
+    raw_subscribe(watcher, "vehicles/+/status", 1);
+    raw_message_t message;
+
+    // Déconnexion normale : pas de LWT
+    int vehicle = raw_connect(port, "vehicle-1", "vehicles/1/status", "offline");
+    raw_send(vehicle, 0xE0, NULL, 0);
+    close(vehicle);
+    TEST_ASSERT(raw_receive(watcher, &message, RAW_SILENCE_MS) == -1, "Un DISCONNECT ne doit pas publier le LWT");
+
+    // Socket fermée sans DISCONNECT
+    vehicle = raw_connect(port, "vehicle-1", "vehicles/1/status", "offline");
+    close(vehicle);
+    TEST_ASSERT(raw_receive(watcher, &message, RAW_TIMEOUT_MS) == 0, "La perte de connexion doit publier le LWT");
+    TEST_ASSERT(strcmp(message.topic, "vehicles/1/status") == 0 && strcmp(message.payload, "offline") == 0, "Le LWT doit être celui du client");
+
+    // Coupure demandée par le test
+    vehicle = raw_connect(port, "vehicle-2", "vehicles/2/status", "offline");
+    TEST_ASSERT(loopback_broker_drop_client(broker, "vehicle-2") == 0, "Le client connecté doit être coupé");
+    TEST_ASSERT(raw_receive(watcher, &message, RAW_TIMEOUT_MS) == 0 && strcmp(message.topic, "vehicles/2/status") == 0,
+        "La coupure doit publier le LWT");
+    TEST_ASSERT(loopback_broker_drop_client(broker, "unknown") == -1, "Un client inconnu doit être signalé");
+
+    loopback_broker_stats_t stats;
+    loopback_broker_get_stats(broker, &stats);
+    TEST_ASSERT(stats.wills == 2 && stats.clients == 1, "Seules les pertes de connexion doivent publier un LWT");
+
+    close(vehicle);
+    close(watcher);
+    loopback_broker_stop(broker);
+}
+
+// Test 4: Abonnements partagés
+TEST_REGISTER(test_loopback_broker_shared, "Test loopback broker : répartition d'un abonnement partagé") {
+    loopback_broker_t* broker = loopback_broker_start(0);
+    TEST_ASSERT(broker != NULL, "Le broker doit démarrer");
+    if (!broker) return;
+    uint16_t port = loopback_broker_port(broker);
+
+    int planners[2] = {
+        raw_connect(port, "planner-1", NULL, NULL),
+        raw_connect(port, "planner-2", NULL, NULL)
+    };
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT(raw_subscribe(planners[i], "$share/planners/services/route-planner/request", 1) == 1, "L'abonnement partagé doit être accepté");
+    }
+    int client = raw_connect(port, "api", NULL, NULL);
+    for (int i = 0; i < 4; i++) {
+        raw_publish(client, "services/route-planner/request", "plan", 0, false);
+    }
+
+    raw_message_t message;
+    for (int i = 0; i < 2; i++) {
+        int received = 0;
+        while (raw_receive(planners[i], &message, RAW_SILENCE_MS) == 0) received++;
+        TEST_ASSERT(received == 2, "Chaque instance du groupe doit recevoir la moitié des requêtes");
+        close(planners[i]);
+    }
+
+    close(client);
+    loopback_broker_stop(broker);
+}
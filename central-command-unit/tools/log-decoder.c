@@ -0,0 +1,79 @@
+/**
+ * @file log-decoder.c
+ * @brief Outil de décodage des fichiers de log binaires (appels LOG_*_DEFERRED).
+ * @details
+ * Lit un fichier écrit par le logger (voir logger_set_binary_file()) et affiche chaque
+ * enregistrement sous forme de texte :
+ *   2026-10-19 14:03:12.123456 [DEBUG] Marvelmind: Received position: x=120, y=-40, angle=90.00
+ *
+ * Usage : log-decoder [-s] [-l niveau] [fichier.blog]  (entrée standard par défaut)
+ * @date 2026-10-19
+ */
+#include "core/common.h"
+#include "core/logger.h"
+#include <getopt.h>
+
+static void print_usage(const char *program) {
+	fprintf(stderr, "Usage: %s [-s] [-l DEBUG|INFO|WARNING|ERROR|FATAL] [file.blog]\n", program);
+	fprintf(stderr, "  -s  Print the source location of each record\n");
+	fprintf(stderr, "  -l  Minimum level to print\n");
+}
+
+/**
+ * @brief Affiche un enregistrement décodé.
+ */
+static void print_entry(const log_record_entry_t *entry, bool withSource) {
+	time_t seconds = (time_t) (entry->timestampNs / 1000000000ULL);
+	unsigned long micros = (unsigned long) ((entry->timestampNs % 1000000000ULL) / 1000ULL);
+	struct tm tm;
+	char date[32];
+	localtime_r(&seconds, &tm);
+	strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S", &tm);
+
+	printf("%s.%06lu [%s] %s", date, micros, logger_level_to_string(entry->level), entry->message);
+	if(withSource) printf(" (%s:%u)", entry->file, entry->line);
+	printf("\n");
+}
+
+int main(int argc, char **argv) {
+	bool withSource = false;
+	log_level_t minLevel = LOG_LEVEL_DEBUG;
+	int opt;
+
+	while((opt = getopt(argc, argv, "sl:h")) != -1) {
+		switch(opt) {
+			case 's': withSource = true; break;
+			case 'l': minLevel = logger_string_to_level(optarg); break;
+			default:
+				print_usage(argv[0]);
+				return opt == 'h' ? 0 : 1;
+		}
+	}
+
+	FILE *file = stdin;
+	if(optind < argc) {
+		file = fopen(argv[optind], "rb");
+		if(!file) {
+			perror(argv[optind]);
+			return 1;
+		}
+	}
+
+	log_record_reader_t reader;
+	if(log_record_reader_open(&reader, file) != 0) {
+		fprintf(stderr, "Not a binary log file\n");
+		if(file != stdin) fclose(file);
+		return 1;
+	}
+
+	log_record_entry_t entry;
+	int rc;
+	while((rc = log_record_reader_next(&reader, &entry)) == 1) {
+		if(entry.level >= minLevel) print_entry(&entry, withSource);
+	}
+	if(rc < 0) fprintf(stderr, "Truncated or corrupted binary log file\n");
+
+	log_record_reader_close(&reader);
+	if(file != stdin) fclose(file);
+	return rc < 0 ? 1 : 0;
+}
@@ -59,6 +59,7 @@ export class TravelController {
 			action : `PLAN_ROUTE_REQUEST`,
 			carId : travel.vehicleId,
 			nodeList : nodeList,
+			optimizeOrder : true,
 			replyTopic : `services/api/response`
 		} 
 		mqttClientService.publish('services/route-planner/request', JSON.stringify(MqttRequest));
@@ -38,6 +38,8 @@ export interface MqttAlerts
   timestamp: number // Timestamp en seconde
   level: string // Niveau de log : DEBUG, INFO, WARNING, ERROR, FATAL
   message: string // Message du log
+  count?: number // Nombre d'occurrences regroupées dans la fenêtre (absent : 1)
+  lastTimestamp?: number // Timestamp de la dernière occurrence en seconde (si count > 1)
 }
 
 export interface MqttStateUpdate
@@ -138,16 +140,26 @@ export class MqttClientService {
                 this.setupVehicleStateSubscriptions(this).then(() => {
                     logger.info('Vehicle state subscriptions set up successfully.');
                     this.onMessage('system/alerts', async (topic, message) => {
-                        const alert: MqttAlerts = JSON.parse(message.toString());
-                        const type = await AppDataSource.getRepository(AlarmsTypes).findOneBy({ criticity : alert.level });
-                        const origin = await AppDataSource.getRepository(Origins).findOneBy({ label : alert.origin });
-                        const newAlarm = AppDataSource.getRepository(Alarms).create({
-                            description: alert.message,
-                            alarmTypeId: type?.id ?? null,
-                            originId: origin?.id ?? null,
-                            createdAt: new Date()
-                        });
-                        AppDataSource.getRepository(Alarms).save(newAlarm);
+                        // Les services publient leurs logs par lots (tableau), un objet seul reste accepté
+                        const payload: MqttAlerts | MqttAlerts[] = JSON.parse(message.toString());
+                        const alerts = Array.isArray(payload) ? payload : [payload];
+                        const newAlarms: Alarms[] = [];
+                        const types = new Map<string, AlarmsTypes | null>();
+                        const origins = new Map<string, Origins | null>();
+                        for (const alert of alerts) {
+                            if (!types.has(alert.level)) types.set(alert.level, await AppDataSource.getRepository(AlarmsTypes).findOneBy({ criticity : alert.level }));
+                            if (!origins.has(alert.origin)) origins.set(alert.origin, await AppDataSource.getRepository(Origins).findOneBy({ label : alert.origin }));
+                            const type = types.get(alert.level);
+                            const origin = origins.get(alert.origin);
+                            newAlarms.push(AppDataSource.getRepository(Alarms).create({
+                                description: alert.count && alert.count > 1 ? `${alert.message} (x${alert.count})` : alert.message,
+                                alarmTypeId: type?.id ?? null,
+                                originId: origin?.id ?? null,
+                                createdAt: new Date()
+                            }));
+                        }
+                        // Une seule insertion pour tout le lot
+                        AppDataSource.getRepository(Alarms).save(newAlarms);
                     });
         
                     this.onMessage('services/api/response', async (topic, message) => {